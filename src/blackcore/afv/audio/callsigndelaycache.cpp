@@ -7,6 +7,7 @@
  */
 
 #include "callsigndelaycache.h"
+#include "jitterbuffer.h"
 
 namespace BlackCore
 {
@@ -14,59 +15,15 @@ namespace BlackCore
     {
         namespace Audio
         {
-            void CallsignDelayCache::initialise(const QString &callsign)
+            double CallsignDelayCache::getJitterMs(const QString &callsign) const
             {
-                if (!m_delayCache.contains(callsign)) { m_delayCache[callsign] = delayDefault; }
-                if (!successfulTransmissionsCache.contains(callsign)) { successfulTransmissionsCache[callsign] = 0; }
+                return m_jitterCache.value(callsign, CJitterBuffer::DefaultJitterMs);
             }
 
-            int CallsignDelayCache::get(const QString &callsign)
+            void CallsignDelayCache::setJitterMs(const QString &callsign, double jitterMs)
             {
-                return m_delayCache[callsign];
-            }
-
-            void CallsignDelayCache::underflow(const QString &callsign)
-            {
-                if (!successfulTransmissionsCache.contains(callsign)) return;
-
-                successfulTransmissionsCache[callsign] = 0;
-                increaseDelayMs(callsign);
-            }
-
-            void CallsignDelayCache::success(const QString &callsign)
-            {
-                if (!successfulTransmissionsCache.contains(callsign)) return;
-
-                successfulTransmissionsCache[callsign]++;
-                if (successfulTransmissionsCache[callsign] > 5)
-                {
-                    decreaseDelayMs(callsign);
-                    successfulTransmissionsCache[callsign] = 0;
-                }
-            }
-
-            void CallsignDelayCache::increaseDelayMs(const QString &callsign)
-            {
-                if (!m_delayCache.contains(callsign))
-                    return;
-
-                m_delayCache[callsign] += delayIncrement;
-                if (m_delayCache[callsign] > delayMax)
-                {
-                    m_delayCache[callsign] = delayMax;
-                }
-            }
-
-            void CallsignDelayCache::decreaseDelayMs(const QString &callsign)
-            {
-                if (!m_delayCache.contains(callsign))
-                    return;
-
-                m_delayCache[callsign] -= delayIncrement;
-                if (m_delayCache[callsign] < delayMin)
-                {
-                    m_delayCache[callsign] = delayMin;
-                }
+                if (callsign.isEmpty()) { return; }
+                m_jitterCache.insert(callsign, jitterMs);
             }
 
             CallsignDelayCache &CallsignDelayCache::instance()
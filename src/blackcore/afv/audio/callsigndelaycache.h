@@ -20,27 +20,16 @@ namespace BlackCore
     {
         namespace Audio
         {
-            //! Callsign delay cache
+            //! Callsign delay cache, the jitter of the last transmission of a callsign
+            //! \remark start value of the jitter buffer for the next transmission
             class CallsignDelayCache
             {
             public:
-                //! Initialize
-                void initialise(const QString &callsign);
+                //! Jitter estimate, CJitterBuffer::DefaultJitterMs for an unknown callsign
+                double getJitterMs(const QString &callsign) const;
 
-                //! Callsign index
-                int get(const QString &callsign);
-
-                //! Underflow
-                void underflow(const QString &callsign);
-
-                //! Success
-                void success(const QString &callsign);
-
-                //! Delay plus/minus
-                //! @{
-                void increaseDelayMs(const QString &callsign);
-                void decreaseDelayMs(const QString &callsign);
-                //! @}
+                //! Remember the jitter estimate of a transmission
+                void setJitterMs(const QString &callsign, double jitterMs);
 
                 //! Singleton
                 static CallsignDelayCache &instance();
@@ -49,13 +38,7 @@ namespace BlackCore
                 //! Ctor
                 CallsignDelayCache() = default;
 
-                static constexpr int delayDefault = 60;
-                static constexpr int delayMin = 40;
-                static constexpr int delayIncrement = 20;
-                static constexpr int delayMax = 300;
-
-                QHash<QString, int> m_delayCache;
-                QHash<QString, int> successfulTransmissionsCache;
+                QHash<QString, double> m_jitterCache;
             };
 
         } // ns
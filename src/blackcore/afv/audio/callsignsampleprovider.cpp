@@ -73,31 +73,61 @@ namespace BlackCore
 
                 m_timer->setInterval(100);
                 connect(m_timer, &QTimer::timeout, this, &CCallsignSampleProvider::timerElapsed);
+
+                m_decodedPcm.fill(0, MaxDecodedSamples);
+                m_decodedSamples.fill(0, MaxDecodedSamples);
             }
 
-            int CCallsignSampleProvider::readSamples(QVector<float> &samples, qint64 count)
+            int CCallsignSampleProvider::readSamples(float *samples, int count)
             {
+                if (m_inUse) { this->takeFrames(count); }
                 const int noOfSamples = m_mixer->readSamples(samples, count);
 
-                if (m_inUse && m_lastPacketLatch && m_audioInput->getBufferedBytes() == 0)
+                if (m_inUse && (m_lastPacketLatch || m_jitterBuffer.isEndOfTransmission()) && m_audioInput->getBufferedBytes() == 0)
                 {
                     idle();
                     m_lastPacketLatch = false;
                 }
 
-                if (m_inUse && !m_underflow && m_audioInput->getBufferedBytes() == 0)
+                return noOfSamples;
+            }
+
+            void CCallsignSampleProvider::takeFrames(int count)
+            {
+                const qint64 nowMs = CJitterBuffer::currentTimeMs();
+                while (m_audioInput->getBufferedBytes() < count)
                 {
-                    if (verbose()) { CLogMessage(this).debug(u"[%1] [Delay++]") << m_callsign; }
-                    CallsignDelayCache::instance().underflow(m_callsign);
-                    m_underflow = true;
+                    const CJitterBuffer::FrameType frameType = m_jitterBuffer.takeFrame(nowMs, m_packet);
+                    if (frameType == CJitterBuffer::NoFrame) { break; }
+
+                    qint16 *pcm = m_decodedPcm.data();
+                    const int decoded = frameType == CJitterBuffer::PacketFrame ?
+                                        m_decoder.decode(m_packet, pcm, MaxDecodedSamples) :
+                                        m_decoder.decodeLost(pcm, m_frameCount);
+                    float *decodedSamples = m_decodedSamples.data();
+                    for (int i = 0; i < decoded; i++) { decodedSamples[i] = pcm[i] / 32768.0f; }
+                    m_audioInput->addSamples(decodedSamples, decoded);
                 }
+                this->publishStatistics();
+            }
 
-                return noOfSamples;
+            void CCallsignSampleProvider::publishStatistics()
+            {
+                // never wait in the audio path
+                if (!m_mutexStatistics.tryLock()) { return; }
+                m_statistics = m_jitterBuffer.getStatistics();
+                m_mutexStatistics.unlock();
+            }
+
+            JitterBufferStatistics CCallsignSampleProvider::getJitterBufferStatistics() const
+            {
+                QMutexLocker lock(&m_mutexStatistics);
+                return m_statistics;
             }
 
             void CCallsignSampleProvider::timerElapsed()
             {
-                if (m_inUse && m_audioInput->getBufferedBytes() == 0 && m_lastSamplesAddedUtc.msecsTo(QDateTime::currentDateTimeUtc()) > m_idleTimeoutMs)
+                if (m_inUse && m_audioInput->getBufferedBytes() == 0 && m_jitterBuffer.isEmpty() && m_lastSamplesAddedUtc.msecsTo(QDateTime::currentDateTimeUtc()) > m_idleTimeoutMs)
                 {
                     idle();
                 }
@@ -106,32 +136,27 @@ namespace BlackCore
             void CCallsignSampleProvider::active(const QString &callsign, const QString &aircraftType)
             {
                 m_callsign = callsign;
-                CallsignDelayCache::instance().initialise(callsign);
                 m_aircraftType = aircraftType;
                 m_decoder.resetState();
+                resetEffectsState();
                 m_inUse = true;
                 setEffects();
-                m_underflow = false;
 
-                const int delayMs = CallsignDelayCache::instance().get(callsign);
-                if (verbose()) { CLogMessage(this).debug(u"[%1] [Delay %2ms]") << m_callsign << delayMs; }
-                if (delayMs > 0)
-                {
-                    const int phaseDelayLength = (m_audioFormat.sampleRate() / 1000) * delayMs;
-                    const QVector<float> phaseDelay(phaseDelayLength * 2, 0);
-                    m_audioInput->addSamples(phaseDelay);
-                }
+                // the playout delay adapts to the jitter, starting with the one of the last transmission
+                const double jitterMs = CallsignDelayCache::instance().getJitterMs(callsign);
+                m_jitterBuffer.start(jitterMs);
+                if (verbose()) { CLogMessage(this).debug(u"[%1] [Jitter %2ms, target latency %3ms]") << m_callsign << jitterMs << m_jitterBuffer.getTargetLatencyMs(); }
             }
 
             void CCallsignSampleProvider::activeSilent(const QString &callsign, const QString &aircraftType)
             {
                 m_callsign = callsign;
-                CallsignDelayCache::instance().initialise(callsign);
                 m_aircraftType = aircraftType;
                 m_decoder.resetState();
+                resetEffectsState();
                 m_inUse = true;
                 setEffects(true);
-                m_underflow = true;
+                m_jitterBuffer.start(CallsignDelayCache::instance().getJitterMs(callsign));
             }
 
             void CCallsignSampleProvider::clear()
@@ -145,10 +170,8 @@ namespace BlackCore
                 m_distanceRatio = distanceRatio;
                 setEffects();
 
-                const QVector<qint16> audio = decodeOpus(audioDto.audio);
-                m_audioInput->addSamples(BlackSound::convertFromShortToFloat(audio));
-                m_lastPacketLatch = audioDto.lastPacket;
-                if (audioDto.lastPacket && !m_underflow) { CallsignDelayCache::instance().success(m_callsign); }
+                const qint64 receivedMs = audioDto.receivedMs >= 0 ? audioDto.receivedMs : CJitterBuffer::currentTimeMs();
+                m_jitterBuffer.addPacket(audioDto.sequenceCounter, audioDto.audio, audioDto.lastPacket, receivedMs);
                 m_lastSamplesAddedUtc = QDateTime::currentDateTimeUtc();
                 if (!m_timer->isActive()) { m_timer->start(); }
             }
@@ -168,17 +191,20 @@ namespace BlackCore
             void CCallsignSampleProvider::idle()
             {
                 m_timer->stop();
+                if (m_inUse) { CallsignDelayCache::instance().setJitterMs(m_callsign, m_jitterBuffer.getJitterMs()); }
+                m_jitterBuffer.clear();
+                this->publishStatistics();
                 m_inUse = false;
                 setEffects();
                 m_callsign.clear();
                 m_aircraftType.clear();
             }
 
-            QVector<qint16> CCallsignSampleProvider::decodeOpus(const QByteArray &opusData)
+            void CCallsignSampleProvider::resetEffectsState()
             {
-                int decodedLength = 0;
-                const QVector<qint16> decoded = m_decoder.decode(opusData, opusData.size(), &decodedLength);
-                return decoded;
+                // the effects were not run while silent, start as after a long silence
+                m_simpleCompressorEffect->reset();
+                m_voiceEqualizer->reset();
             }
 
             void CCallsignSampleProvider::setEffects(bool noEffects)
@@ -11,6 +11,7 @@
 #ifndef BLACKCORE_AFV_AUDIO_CALLSIGNSAMPLEPROVIDER_H
 #define BLACKCORE_AFV_AUDIO_CALLSIGNSAMPLEPROVIDER_H
 
+#include "blackcore/afv/audio/jitterbuffer.h"
 #include "blackcore/afv/dto.h"
 #include "blacksound/sampleprovider/pinknoisegenerator.h"
 #include "blacksound/sampleprovider/bufferedwaveprovider.h"
@@ -26,6 +27,7 @@
 #include <QSharedPointer>
 #include <QTimer>
 #include <QDateTime>
+#include <QMutex>
 
 namespace BlackCore
 {
@@ -45,7 +47,11 @@ namespace BlackCore
                 CCallsignSampleProvider(const QAudioFormat &audioFormat, const BlackCore::Afv::Audio::CReceiverSampleProvider *receiver, QObject *parent = nullptr);
 
                 //! Read samples
-                int readSamples(QVector<float> &samples, qint64 count) override;
+                int readSamples(float *samples, int count) override;
+
+                //! \copydoc BlackSound::SampleProvider::ISampleProvider::isSilent
+                //! \remark silent while not in use and nothing is buffered, the effects are not run then
+                virtual bool isSilent() const override { return !m_inUse && m_mixer->isSilent(); }
 
                 //! The callsign
                 const QString &callsign() const { return m_callsign; }
@@ -63,6 +69,7 @@ namespace BlackCore
                 void clear();
 
                 //! Add samples
+                //! \remark the OPUS packets are buffered by sequence number and decoded when played
                 //! @{
                 void addOpusSamples(const IAudioDto &audioDto, float distanceRatio);
                 void addSilentSamples(const IAudioDto &audioDto);
@@ -77,11 +84,21 @@ namespace BlackCore
                 //! Info
                 QString toQString() const;
 
+                //! Jitter buffer statistics
+                //! \threadsafe
+                JitterBufferStatistics getJitterBufferStatistics() const;
+
             private:
                 void timerElapsed();
                 void idle();
-                QVector<qint16> decodeOpus(const QByteArray &opusData);
                 void setEffects(bool noEffects = false);
+                void resetEffectsState();
+
+                //! Decode frames of the jitter buffer until count samples are buffered
+                void takeFrames(int count);
+
+                //! Statistics for other threads, skipped if they are just read
+                void publishStatistics();
 
                 QAudioFormat m_audioFormat;
 
@@ -90,6 +107,7 @@ namespace BlackCore
                 const double m_acBusGainMin        = 0.0028; //0.002;
                 const int m_frameCount    = 960;
                 const int m_idleTimeoutMs = 500;
+                static constexpr int MaxDecodedSamples = 5760; //!< 120ms, the longest OPUS packet
 
                 QString m_callsign;
                 QString m_aircraftType;
@@ -109,9 +127,15 @@ namespace BlackCore
                 QTimer *m_timer = nullptr;
 
                 BlackSound::Codecs::COpusDecoder m_decoder;
-                bool m_lastPacketLatch = false;
+                CJitterBuffer m_jitterBuffer;
+                QByteArray m_packet;             //!< packet taken from the jitter buffer
+                QVector<qint16> m_decodedPcm;    //!< preallocated, MaxDecodedSamples
+                QVector<float> m_decodedSamples; //!< preallocated, MaxDecodedSamples
+                bool m_lastPacketLatch = false;  //!< silent samples only, OPUS packets end with the jitter buffer
                 QDateTime m_lastSamplesAddedUtc;
-                bool m_underflow = false;
+
+                mutable QMutex m_mutexStatistics;
+                JitterBufferStatistics m_statistics;
             };
         } // ns
     } // ns
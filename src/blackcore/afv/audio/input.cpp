@@ -10,6 +10,7 @@
 
 #include "input.h"
 #include "blacksound/audioutilities.h"
+#include "blacksound/dsp/samplekernels.h"
 #include "blackmisc/logmessage.h"
 #include "blackmisc/verify.h"
 
@@ -176,17 +177,8 @@ namespace BlackCore
                     samples = convertFromStereoToMono(samples);
                 }
 
-                const double volume = m_gainRatio;
-                for (qint16 &sample : samples)
-                {
-                    int value = qRound(sample * volume);
-                    if (value > std::numeric_limits<qint16>::max()) value = std::numeric_limits<qint16>::max();
-                    if (value < std::numeric_limits<qint16>::min()) value = std::numeric_limits<qint16>::min();
-                    sample = static_cast<qint16>(value);
-
-                    qint16 sampleInput = qAbs(sample);
-                    m_maxSampleInput   = qMax(qAbs(sampleInput), m_maxSampleInput);
-                }
+                const int peak = Dsp::applyGainAndClip(samples.data(), samples.size(), m_gainRatio);
+                m_maxSampleInput = qMax(peak, m_maxSampleInput);
 
                 int length;
                 const QByteArray encodedBuffer = m_encoder.encode(samples, samples.size(), &length);
@@ -155,7 +155,7 @@ namespace BlackCore
                 int m_opusBytesEncoded  = 0;
                 int m_sampleCount       = 0;
                 double m_gainRatio         = 1.0;
-                qint16 m_maxSampleInput = 0.0;
+                int m_maxSampleInput       = 0; //!< 0..32768
 
                 const int SampleCountPerEvent = 4800;
                 const double maxDb =   0;
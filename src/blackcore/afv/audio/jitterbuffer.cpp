@@ -0,0 +1,267 @@
+/* Copyright (C) 2020
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+#include "jitterbuffer.h"
+
+#include <QElapsedTimer>
+#include <QtMath>
+
+namespace BlackCore
+{
+    namespace Afv
+    {
+        namespace Audio
+        {
+            double JitterBufferStatistics::averageLatencyMs() const
+            {
+                return playedFrames > 0 ? static_cast<double>(latencySumMs) / playedFrames : 0.0;
+            }
+
+            double JitterBufferStatistics::lossRatio() const
+            {
+                const int frames = playedFrames + lostFrames;
+                return frames > 0 ? static_cast<double>(lostFrames) / frames : 0.0;
+            }
+
+            JitterBufferStatistics &JitterBufferStatistics::operator +=(const JitterBufferStatistics &other)
+            {
+                receivedPackets  += other.receivedPackets;
+                reorderedPackets += other.reorderedPackets;
+                latePackets      += other.latePackets;
+                playedFrames     += other.playedFrames;
+                lostFrames       += other.lostFrames;
+                concealedFrames  += other.concealedFrames;
+                droppedFrames    += other.droppedFrames;
+                underflows       += other.underflows;
+                latencySumMs     += other.latencySumMs;
+                targetLatencyMs   = qMax(targetLatencyMs, other.targetLatencyMs);
+                jitterMs          = qMax(jitterMs, other.jitterMs);
+                return *this;
+            }
+
+            QString JitterBufferStatistics::toQString() const
+            {
+                return QStringLiteral("received: %1 reordered: %2 late: %3 played: %4 lost: %5 (%6%) concealed: %7 dropped: %8 underflows: %9 latency: %10ms target: %11ms jitter: %12ms").
+                       arg(receivedPackets).arg(reorderedPackets).arg(latePackets).arg(playedFrames).
+                       arg(lostFrames).arg(lossRatio() * 100.0, 0, 'f', 1).arg(concealedFrames).arg(droppedFrames).arg(underflows).
+                       arg(averageLatencyMs(), 0, 'f', 1).arg(targetLatencyMs).arg(jitterMs, 0, 'f', 1);
+            }
+
+            constexpr int CJitterBuffer::FrameMs;
+            constexpr int CJitterBuffer::MinTargetLatencyMs;
+            constexpr int CJitterBuffer::MaxTargetLatencyMs;
+            constexpr double CJitterBuffer::DefaultJitterMs;
+
+            CJitterBuffer::CJitterBuffer()
+            {
+                this->start();
+            }
+
+            void CJitterBuffer::start(double jitterMs)
+            {
+                this->clear();
+                m_hasTransit = false;
+                m_jitterMs = jitterMs;
+                m_targetLatencyMs = targetLatencyMs(jitterMs);
+                m_statistics.jitterMs = m_jitterMs;
+                m_statistics.targetLatencyMs = m_targetLatencyMs;
+            }
+
+            void CJitterBuffer::clear()
+            {
+                for (Slot &s : m_slots)
+                {
+                    s.used = false;
+                    s.audio = QByteArray();
+                }
+                m_bufferedPackets  = 0;
+                m_hasNext          = false;
+                m_started          = false;
+                m_playing          = false;
+                m_hasEnd           = false;
+                m_underflowFrames  = 0;
+                m_bufferingSinceMs = -1;
+            }
+
+            void CJitterBuffer::addPacket(uint sequence, const QByteArray &audio, bool lastPacket, qint64 nowMs)
+            {
+                m_statistics.receivedPackets++;
+                this->updateJitter(sequence, nowMs);
+                if (lastPacket)
+                {
+                    m_hasEnd = true;
+                    m_endSequence = sequence;
+                }
+
+                if (!m_hasNext)
+                {
+                    m_hasNext = true;
+                    m_nextSequence = sequence;
+                    m_newestSequence = sequence;
+                }
+                if (!m_playing && m_bufferingSinceMs < 0) { m_bufferingSinceMs = nowMs; }
+
+                const int offset = distance(m_nextSequence, sequence);
+                if (offset < 0)
+                {
+                    // before playout an earlier packet just moves the start
+                    if (m_started || distance(sequence, m_newestSequence) >= Capacity)
+                    {
+                        m_statistics.latePackets++;
+                        return;
+                    }
+                    m_nextSequence = sequence;
+                }
+                else if (offset >= Capacity)
+                {
+                    // gap longer than the buffer, start over with this packet
+                    m_statistics.droppedFrames += m_bufferedPackets;
+                    m_statistics.lostFrames += offset - m_bufferedPackets;
+                    const bool hasEnd = m_hasEnd;
+                    this->clear();
+                    m_hasEnd = hasEnd;
+                    m_hasNext = true;
+                    m_nextSequence = sequence;
+                    m_newestSequence = sequence;
+                    m_bufferingSinceMs = nowMs;
+                }
+
+                Slot &s = this->slot(sequence);
+                if (s.used) { return; } // duplicate, the window maps each slot to one sequence
+                if (distance(m_newestSequence, sequence) < 0) { m_statistics.reorderedPackets++; }
+                else { m_newestSequence = sequence; }
+
+                s.used = true;
+                s.arrivalMs = nowMs;
+                s.audio = audio;
+                m_bufferedPackets++;
+            }
+
+            CJitterBuffer::FrameType CJitterBuffer::takeFrame(qint64 nowMs, QByteArray &audio)
+            {
+                if (!m_hasNext || this->isEndOfTransmission()) { return NoFrame; }
+                if (!m_playing)
+                {
+                    if (!this->isReadyToPlay(nowMs)) { return NoFrame; }
+                    m_started = true;
+                    m_playing = true;
+                    m_underflowFrames = 0;
+                    m_targetLatencyMs = targetLatencyMs(m_jitterMs);
+                    m_statistics.targetLatencyMs = m_targetLatencyMs;
+                }
+
+                // too deep, e.g. after the burst following a delay spike
+                if (this->bufferedFrames() > m_targetLatencyMs / FrameMs + MaxExcessFrames)
+                {
+                    if (this->slot(m_nextSequence).used) { m_statistics.droppedFrames++; }
+                    else { m_statistics.lostFrames++; }
+                    this->advance();
+                }
+
+                const Slot &s = this->slot(m_nextSequence);
+                if (s.used)
+                {
+                    audio = s.audio;
+                    m_statistics.playedFrames++;
+                    m_statistics.latencySumMs += nowMs - s.arrivalMs;
+                    m_underflowFrames = 0;
+                    this->advance();
+                    return PacketFrame;
+                }
+
+                if (m_bufferedPackets > 0)
+                {
+                    // newer packets are there, this one is lost or too late
+                    m_statistics.lostFrames++;
+                    m_statistics.concealedFrames++;
+                    this->advance();
+                    return ConcealedFrame;
+                }
+
+                // underflow, bridge a short delay, then buffer again
+                if (m_underflowFrames == 0) { m_statistics.underflows++; }
+                if (m_underflowFrames < MaxConcealedUnderflow)
+                {
+                    m_underflowFrames++;
+                    m_statistics.concealedFrames++;
+                    this->advance();
+                    return ConcealedFrame;
+                }
+                m_playing = false;
+                m_bufferingSinceMs = -1;
+                return NoFrame;
+            }
+
+            bool CJitterBuffer::isEndOfTransmission() const
+            {
+                return m_hasEnd && m_hasNext && distance(m_nextSequence, m_endSequence) < 0;
+            }
+
+            int CJitterBuffer::targetLatencyMs(double jitterMs)
+            {
+                // most arrivals are within 4 times the mean deviation, rounded up to whole frames
+                const int frames = qCeil((FrameMs + 4.0 * jitterMs) / FrameMs);
+                return qBound(MinTargetLatencyMs, frames * FrameMs, MaxTargetLatencyMs);
+            }
+
+            qint64 CJitterBuffer::currentTimeMs()
+            {
+                static const QElapsedTimer clock = []
+                {
+                    QElapsedTimer t;
+                    t.start();
+                    return t;
+                }();
+                return clock.elapsed();
+            }
+
+            int CJitterBuffer::bufferedFrames() const
+            {
+                if (m_bufferedPackets < 1) { return 0; }
+                return qMax(0, distance(m_nextSequence, m_newestSequence) + 1);
+            }
+
+            bool CJitterBuffer::isReadyToPlay(qint64 nowMs) const
+            {
+                if (m_bufferedPackets < 1) { return false; }
+                if (m_hasEnd) { return true; }
+                if (this->bufferedFrames() * FrameMs >= m_targetLatencyMs) { return true; }
+                return m_bufferingSinceMs >= 0 && nowMs - m_bufferingSinceMs >= m_targetLatencyMs;
+            }
+
+            void CJitterBuffer::updateJitter(uint sequence, qint64 nowMs)
+            {
+                // RFC 3550: mean deviation of the transit time differences
+                if (!m_hasTransit)
+                {
+                    m_hasTransit = true;
+                    m_transitBase = sequence;
+                    m_lastTransitMs = nowMs;
+                    return;
+                }
+                const qint64 transitMs = nowMs - static_cast<qint64>(distance(m_transitBase, sequence)) * FrameMs;
+                const double d = static_cast<double>(qAbs(transitMs - m_lastTransitMs));
+                m_lastTransitMs = transitMs;
+                m_jitterMs += (d - m_jitterMs) / 16.0;
+                m_statistics.jitterMs = m_jitterMs;
+            }
+
+            void CJitterBuffer::advance()
+            {
+                Slot &s = this->slot(m_nextSequence);
+                if (s.used)
+                {
+                    s.used = false;
+                    s.audio = QByteArray();
+                    m_bufferedPackets--;
+                }
+                m_nextSequence++;
+            }
+        } // ns
+    } // ns
+} // ns
@@ -0,0 +1,181 @@
+/* Copyright (C) 2020
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \file
+
+#ifndef BLACKCORE_AFV_AUDIO_JITTERBUFFER_H
+#define BLACKCORE_AFV_AUDIO_JITTERBUFFER_H
+
+#include "blackcore/blackcoreexport.h"
+
+#include <QByteArray>
+#include <QString>
+#include <QtGlobal>
+#include <array>
+
+namespace BlackCore
+{
+    namespace Afv
+    {
+        namespace Audio
+        {
+            //! Jitter buffer statistics, counters since start
+            struct BLACKCORE_EXPORT JitterBufferStatistics
+            {
+                int receivedPackets  = 0; //!< packets received
+                int reorderedPackets = 0; //!< packets received out of order, but in time
+                int latePackets      = 0; //!< packets received after their frame was played or concealed
+                int playedFrames     = 0; //!< frames played from received packets
+                int lostFrames       = 0; //!< frames never received in time
+                int concealedFrames  = 0; //!< frames generated by the packet loss concealment, lost frames and underflows
+                int droppedFrames    = 0; //!< frames dropped as the buffer was too deep
+                int underflows       = 0; //!< buffer ran empty during a transmission
+                qint64 latencySumMs  = 0; //!< buffering time of all played frames
+                int targetLatencyMs  = 0; //!< current target latency
+                double jitterMs      = 0; //!< current inter-arrival jitter estimate
+
+                //! Average buffering time of the played frames
+                double averageLatencyMs() const;
+
+                //! Ratio of lost frames, 0..1
+                double lossRatio() const;
+
+                //! Add the counters, the current values are the ones of the worst buffer
+                JitterBufferStatistics &operator +=(const JitterBufferStatistics &other);
+
+                //! As string
+                QString toQString() const;
+            };
+
+            /*!
+             * Adaptive jitter buffer for the voice packets of one transmission.
+             *
+             * Packets are ordered by sequence number and played out after a target latency, derived from
+             * the inter-arrival jitter as in RFC 3550. Missing frames are concealed, packets arriving after
+             * their frame was due are dropped.
+             * \remark not thread safe, packets are added and frames are taken in the same thread
+             */
+            class BLACKCORE_EXPORT CJitterBuffer
+            {
+            public:
+                //! Frame as taken from the buffer
+                enum FrameType
+                {
+                    NoFrame,        //!< nothing to play, buffering or end of transmission
+                    PacketFrame,    //!< frame of a received packet
+                    ConcealedFrame  //!< frame is missing, to be concealed
+                };
+
+                //! Frame duration of the AFV voice packets
+                static constexpr int FrameMs = 20;
+
+                //! Target latency limits
+                //! @{
+                static constexpr int MinTargetLatencyMs = 40;
+                static constexpr int MaxTargetLatencyMs = 300;
+                //! @}
+
+                //! Jitter assumed for an unknown sender
+                static constexpr double DefaultJitterMs = 10.0;
+
+                //! Ctor
+                CJitterBuffer();
+
+                //! Start a new transmission
+                //! \param jitterMs jitter estimate to start with, e.g. the one of the last transmission of that sender
+                void start(double jitterMs = DefaultJitterMs);
+
+                //! Remove all packets, the statistics are kept
+                void clear();
+
+                //! Add a received packet
+                //! \param nowMs monotonic time in ms
+                void addPacket(uint sequence, const QByteArray &audio, bool lastPacket, qint64 nowMs);
+
+                //! Take the next frame to be played
+                //! \param nowMs monotonic time in ms
+                //! \param audio the packet audio for a PacketFrame, unchanged otherwise
+                FrameType takeFrame(qint64 nowMs, QByteArray &audio);
+
+                //! Last packet of the transmission played or concealed
+                bool isEndOfTransmission() const;
+
+                //! No packets buffered
+                bool isEmpty() const { return m_bufferedPackets == 0; }
+
+                //! Current jitter estimate
+                double getJitterMs() const { return m_jitterMs; }
+
+                //! Current target latency
+                int getTargetLatencyMs() const { return m_targetLatencyMs; }
+
+                //! Statistics
+                const JitterBufferStatistics &getStatistics() const { return m_statistics; }
+
+                //! Target latency for a jitter estimate
+                static int targetLatencyMs(double jitterMs);
+
+                //! Monotonic time in ms, the same clock for all threads
+                //! \threadsafe
+                static qint64 currentTimeMs();
+
+            private:
+                //! Buffered packet
+                struct Slot
+                {
+                    bool used = false;
+                    qint64 arrivalMs = 0;
+                    QByteArray audio;
+                };
+
+                static constexpr int Capacity = 32;            //!< frames, more than the max. target latency
+                static constexpr int MaxConcealedUnderflow = 2; //!< frames concealed on underflow before buffering again
+                static constexpr int MaxExcessFrames = 3;       //!< frames above the target latency before one is dropped
+
+                //! Sequence distance, wrap around safe
+                static int distance(uint from, uint to) { return static_cast<int>(to - from); }
+
+                Slot &slot(uint sequence) { return m_slots[sequence % Capacity]; }
+
+                //! Frames from the next one to the newest buffered one
+                int bufferedFrames() const;
+
+                //! Playout can start
+                bool isReadyToPlay(qint64 nowMs) const;
+
+                //! Update the jitter estimate with an arrival
+                void updateJitter(uint sequence, qint64 nowMs);
+
+                //! Release the slot of the next frame and advance
+                void advance();
+
+                std::array<Slot, Capacity> m_slots;
+                int m_bufferedPackets = 0;
+                bool m_hasNext = false;       //!< m_nextSequence valid
+                bool m_started = false;       //!< playout of the transmission started
+                bool m_playing = false;       //!< playing, false while buffering
+                bool m_hasEnd  = false;       //!< last packet received
+                uint m_nextSequence = 0;      //!< next frame to be played
+                uint m_newestSequence = 0;    //!< newest received sequence
+                uint m_endSequence = 0;       //!< sequence of the last packet
+                int m_underflowFrames = 0;    //!< frames concealed in the current underflow
+                qint64 m_bufferingSinceMs = -1;
+
+                bool m_hasTransit = false;
+                qint64 m_lastTransitMs = 0;
+                uint m_transitBase = 0;
+                double m_jitterMs = DefaultJitterMs;
+                int m_targetLatencyMs = 0;
+
+                JitterBufferStatistics m_statistics;
+            };
+        } // ns
+    } // ns
+} // ns
+
+#endif // guard
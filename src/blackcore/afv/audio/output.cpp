@@ -8,17 +8,20 @@
 
 #include "output.h"
 #include "blacksound/audioutilities.h"
+#include "blacksound/dsp/samplekernels.h"
 #include "blackmisc/metadatautils.h"
 #include "blackmisc/logmessage.h"
 #include "blackmisc/verify.h"
 
 #include <QDebug>
 #include <QStringBuilder>
+#include <algorithm>
 #include <cmath>
 
 using namespace BlackMisc;
 using namespace BlackMisc::Audio;
 using namespace BlackSound;
+using namespace BlackSound::Dsp;
 using namespace BlackSound::SampleProvider;
 
 namespace BlackCore
@@ -34,45 +37,59 @@ namespace BlackCore
                 Q_ASSERT_X(sampleProvider, Q_FUNC_INFO, "need sample provide");
                 const QString on = QStringLiteral("%1 for %2").arg(classNameShort(this), sampleProvider->objectName());
                 this->setObjectName(on);
+                m_buffer.fill(0, ISampleProvider::BlockSize);
             }
 
             qint64 CAudioOutputBuffer::readData(char *data, qint64 maxlen)
             {
                 const int sampleBytes  = m_outputFormat.sampleSize() / 8;
                 const int channelCount = m_outputFormat.channelCount();
-                const qint64 count     = maxlen / (sampleBytes * channelCount);
-                QVector<float> buffer;
-                m_sampleProvider->readSamples(buffer, count);
-
-                for (float sample : as_const(buffer))
+                const int frameBytes   = sampleBytes * channelCount;
+                if (frameBytes < 1 || sampleBytes != static_cast<int>(sizeof(float))) { return 0; }
+                const qint64 count = maxlen / frameBytes;
+
+                // blocks of the preallocated buffer, written straight into the device data
+                float *buffer = m_buffer.data();
+                float *output = reinterpret_cast<float *>(data);
+                for (qint64 offset = 0; offset < count; offset += ISampleProvider::BlockSize)
                 {
-                    const float absSample = qAbs(sample);
-                    if (absSample > m_maxSampleOutput) { m_maxSampleOutput = absSample; }
-                }
-
-                m_sampleCount += buffer.size();
-                if (m_sampleCount >= SampleCountPerEvent)
-                {
-                    OutputVolumeStreamArgs outputVolumeStreamArgs;
-                    outputVolumeStreamArgs.PeakRaw = m_maxSampleOutput / 1.0;
-                    outputVolumeStreamArgs.PeakDb  = static_cast<float>(20 * std::log10(outputVolumeStreamArgs.PeakRaw));
-                    const double db = qBound(m_minDb, outputVolumeStreamArgs.PeakDb, m_maxDb);
-                    double ratio = (db - m_minDb) / (m_maxDb - m_minDb);
-                    if (ratio < 0.30) { ratio = 0.0; }
-                    if (ratio > 1.0)  { ratio = 1.0; }
-                    outputVolumeStreamArgs.PeakVU = ratio;
-                    emit outputVolumeStream(outputVolumeStreamArgs);
-                    m_sampleCount     = 0;
-                    m_maxSampleOutput = 0;
-                }
-
-                if (channelCount == 2)
-                {
-                    buffer = convertFromMonoToStereo(buffer);
+                    const int blockCount = static_cast<int>(qMin(count - offset, static_cast<qint64>(ISampleProvider::BlockSize)));
+                    const int samplesRead = m_sampleProvider->readSamples(buffer, blockCount);
+                    std::fill(buffer + qMax(0, samplesRead), buffer + blockCount, 0.0f);
+
+                    m_maxSampleOutput = qMax(m_maxSampleOutput, peakAbs(buffer, blockCount));
+                    if (channelCount == 1)
+                    {
+                        output = std::copy(buffer, buffer + blockCount, output);
+                    }
+                    else
+                    {
+                        for (int n = 0; n < blockCount; n++)
+                        {
+                            for (int c = 0; c < channelCount; c++) { *output++ = buffer[n]; }
+                        }
+                    }
+                    this->updatePeak(blockCount);
                 }
+                return count * frameBytes;
+            }
 
-                memcpy(data, buffer.constData(), static_cast<size_t>(maxlen));
-                return maxlen;
+            void CAudioOutputBuffer::updatePeak(int sampleCount)
+            {
+                m_sampleCount += sampleCount;
+                if (m_sampleCount < SampleCountPerEvent) { return; }
+
+                OutputVolumeStreamArgs outputVolumeStreamArgs;
+                outputVolumeStreamArgs.PeakRaw = m_maxSampleOutput / 1.0;
+                outputVolumeStreamArgs.PeakDb  = static_cast<float>(20 * std::log10(outputVolumeStreamArgs.PeakRaw));
+                const double db = qBound(m_minDb, outputVolumeStreamArgs.PeakDb, m_maxDb);
+                double ratio = (db - m_minDb) / (m_maxDb - m_minDb);
+                if (ratio < 0.30) { ratio = 0.0; }
+                if (ratio > 1.0)  { ratio = 1.0; }
+                outputVolumeStreamArgs.PeakVU = ratio;
+                emit outputVolumeStream(outputVolumeStreamArgs);
+                m_sampleCount     = 0;
+                m_maxSampleOutput = 0;
             }
 
             qint64 CAudioOutputBuffer::writeData(const char *data, qint64 len)
@@ -55,7 +55,11 @@ namespace BlackCore
                 virtual qint64 writeData(const char *data, qint64 len) override;
 
             private:
+                //! Collect the peak of the samples and emit CAudioOutputBuffer::outputVolumeStream from time to time
+                void updatePeak(int sampleCount);
+
                 BlackSound::SampleProvider::ISampleProvider *m_sampleProvider = nullptr; //!< related provider
+                QVector<float> m_buffer; //!< mono samples, preallocated with ISampleProvider::BlockSize
 
                 static constexpr int SampleCountPerEvent = 4800;
                 QAudioFormat m_outputFormat;
@@ -111,4 +115,6 @@ namespace BlackCore
     } // ns
 } // ns
 
+Q_DECLARE_METATYPE(BlackCore::Afv::Audio::OutputVolumeStreamArgs)
+
 #endif // guard
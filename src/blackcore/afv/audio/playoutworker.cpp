@@ -0,0 +1,216 @@
+/* Copyright (C) 2020
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+#include "playoutworker.h"
+#include "blacksound/sampleprovider/volumesampleprovider.h"
+#include "blackmisc/logmessage.h"
+#include "blackmisc/metadatautils.h"
+#include "blackmisc/threadutils.h"
+
+#ifdef Q_OS_WIN
+#include "comdef.h"
+#endif
+
+#include <QPointer>
+
+using namespace BlackMisc;
+using namespace BlackMisc::Audio;
+using namespace BlackSound::SampleProvider;
+
+namespace BlackCore
+{
+    namespace Afv
+    {
+        namespace Audio
+        {
+            constexpr int CPlayoutWorker::SampleRate;
+            constexpr int CPlayoutWorker::QueueCapacity;
+
+            CPlayoutWorker::CPlayoutWorker(QObject *owner) : CContinuousWorker(owner, "CPlayoutWorker")
+            {
+                this->setObjectName(classNameShort(this));
+                m_updateTimer.stop(); // not used
+            }
+
+            void CPlayoutWorker::startOutput(const CAudioDeviceInfo &outputDevice, const QVector<quint16> &transceiverIDs, double gainRatio)
+            {
+                if (!CThreadUtils::isInThisThread(this))
+                {
+                    // the graph is created in the playout thread, so its timers and the audio callbacks run there
+                    QPointer<CPlayoutWorker> myself(this);
+                    QMetaObject::invokeMethod(this, [ = ]() { if (myself) { myself->startOutput(outputDevice, transceiverIDs, gainRatio); }});
+                    return;
+                }
+
+                this->releaseOutput();
+                this->clearReceivedAudio();
+                {
+                    QMutexLocker lock(&m_mutexSampleProviders);
+                    m_soundcardSampleProvider = new CSoundcardSampleProvider(SampleRate, transceiverIDs, this);
+                    m_soundcardSampleProvider->setReceivedAudioQueue(&m_receivedAudio);
+                    connect(m_soundcardSampleProvider, &CSoundcardSampleProvider::receivingCallsignsChanged, this, &CPlayoutWorker::receivingCallsignsChanged);
+                }
+
+                m_outputSampleProvider = new CVolumeSampleProvider(m_soundcardSampleProvider, this);
+                m_outputSampleProvider->setGainRatio(gainRatio);
+                m_output->start(outputDevice, m_outputSampleProvider);
+                m_outputStarted = true;
+            }
+
+            void CPlayoutWorker::stopOutput()
+            {
+                if (!CThreadUtils::isInThisThread(this))
+                {
+                    QPointer<CPlayoutWorker> myself(this);
+                    QMetaObject::invokeMethod(this, [ = ]() { if (myself) { myself->stopOutput(); }});
+                    return;
+                }
+                this->releaseOutput();
+            }
+
+            bool CPlayoutWorker::addReceivedAudio(const IAudioDto &audioDto, const QVector<RxTransceiverDto> &rxTransceivers)
+            {
+                if (!m_outputStarted) { return false; }
+
+                ReceivedAudioDto received { audioDto, rxTransceivers };
+                if (received.audio.receivedMs < 0) { received.audio.receivedMs = CJitterBuffer::currentTimeMs(); }
+                if (m_receivedAudio.push(std::move(received)))
+                {
+                    // one wake-up for all packets queued until the playout thread adds them
+                    if (!m_receivedAudioWakeUp.exchange(true))
+                    {
+                        QPointer<CPlayoutWorker> myself(this);
+                        QMetaObject::invokeMethod(this, [ = ]() { if (myself) { myself->addQueuedReceivedAudio(); }});
+                    }
+                    return true;
+                }
+
+                // audio thread stalled, e.g. the device is gone
+                m_droppedPackets++;
+                return false;
+            }
+
+            void CPlayoutWorker::setBypassEffects(bool value)
+            {
+                if (!CThreadUtils::isInThisThread(this))
+                {
+                    QPointer<CPlayoutWorker> myself(this);
+                    QMetaObject::invokeMethod(this, [ = ]() { if (myself) { myself->setBypassEffects(value); }});
+                    return;
+                }
+                if (m_soundcardSampleProvider) { m_soundcardSampleProvider->setBypassEffects(value); }
+            }
+
+            void CPlayoutWorker::updateRadioTransceivers(const QVector<TransceiverDto> &radioTransceivers)
+            {
+                if (!CThreadUtils::isInThisThread(this))
+                {
+                    QPointer<CPlayoutWorker> myself(this);
+                    QMetaObject::invokeMethod(this, [ = ]() { if (myself) { myself->updateRadioTransceivers(radioTransceivers); }});
+                    return;
+                }
+                if (m_soundcardSampleProvider) { m_soundcardSampleProvider->updateRadioTransceivers(radioTransceivers); }
+            }
+
+            void CPlayoutWorker::pttUpdate(bool active, const QVector<TxTransceiverDto> &txTransceivers)
+            {
+                if (!CThreadUtils::isInThisThread(this))
+                {
+                    QPointer<CPlayoutWorker> myself(this);
+                    QMetaObject::invokeMethod(this, [ = ]() { if (myself) { myself->pttUpdate(active, txTransceivers); }});
+                    return;
+                }
+                if (m_soundcardSampleProvider) { m_soundcardSampleProvider->pttUpdate(active, txTransceivers); }
+            }
+
+            void CPlayoutWorker::setGainRatio(double gainRatio)
+            {
+                if (!CThreadUtils::isInThisThread(this))
+                {
+                    QPointer<CPlayoutWorker> myself(this);
+                    QMetaObject::invokeMethod(this, [ = ]() { if (myself) { myself->setGainRatio(gainRatio); }});
+                    return;
+                }
+                if (m_outputSampleProvider) { m_outputSampleProvider->setGainRatio(gainRatio); }
+            }
+
+            JitterBufferStatistics CPlayoutWorker::getJitterBufferStatistics() const
+            {
+                QMutexLocker lock(&m_mutexSampleProviders);
+                if (!m_soundcardSampleProvider) { return {}; }
+                return m_soundcardSampleProvider->getJitterBufferStatistics();
+            }
+
+            void CPlayoutWorker::initialize()
+            {
+#ifdef Q_OS_WIN
+                if (!m_winCoInitialized)
+                {
+                    HRESULT hr = CoInitializeEx(nullptr,  COINIT_MULTITHREADED);
+
+                    // RPC_E_CHANGED_MODE: CoInitializeEx was already called by someone else in this thread with a different mode.
+                    if (hr == RPC_E_CHANGED_MODE)
+                    {
+                        hr = CoInitializeEx(nullptr,  COINIT_APARTMENTTHREADED);
+                    }
+                    if (hr == S_OK || hr == S_FALSE) { m_winCoInitialized = true; }
+                }
+#endif
+                m_output = new COutput(this);
+                connect(m_output, &COutput::outputVolumeStream, this, &CPlayoutWorker::outputVolumeStream);
+                CLogMessage(this).info(u"Initialize AFV playout in thread %1") << CThreadUtils::currentThreadInfo();
+            }
+
+            void CPlayoutWorker::cleanup()
+            {
+                this->releaseOutput();
+                this->clearReceivedAudio();
+#ifdef Q_OS_WIN
+                if (m_winCoInitialized)
+                {
+                    CoUninitialize();
+                    m_winCoInitialized = false;
+                }
+#endif
+            }
+
+            void CPlayoutWorker::releaseOutput()
+            {
+                m_outputStarted = false;
+                if (m_output) { m_output->stop(); }
+
+                if (m_outputSampleProvider)
+                {
+                    m_outputSampleProvider->deleteLater();
+                    m_outputSampleProvider = nullptr;
+                }
+
+                QMutexLocker lock(&m_mutexSampleProviders);
+                if (m_soundcardSampleProvider)
+                {
+                    m_soundcardSampleProvider->disconnect();
+                    m_soundcardSampleProvider->deleteLater();
+                    m_soundcardSampleProvider = nullptr;
+                }
+            }
+
+            void CPlayoutWorker::clearReceivedAudio()
+            {
+                ReceivedAudioDto received;
+                while (m_receivedAudio.pop(received)) {}
+            }
+
+            void CPlayoutWorker::addQueuedReceivedAudio()
+            {
+                // reset first, packets queued from now on wake up again
+                m_receivedAudioWakeUp = false;
+                if (m_soundcardSampleProvider) { m_soundcardSampleProvider->addReceivedAudio(); }
+            }
+        } // ns
+    } // ns
+} // ns
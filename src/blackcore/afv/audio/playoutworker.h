@@ -0,0 +1,128 @@
+/* Copyright (C) 2020
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \file
+
+#ifndef BLACKCORE_AFV_AUDIO_PLAYOUTWORKER_H
+#define BLACKCORE_AFV_AUDIO_PLAYOUTWORKER_H
+
+#include "blackcore/afv/audio/output.h"
+#include "blackcore/afv/audio/soundcardsampleprovider.h"
+#include "blackcore/afv/dto.h"
+#include "blackcore/blackcoreexport.h"
+#include "blackmisc/audio/audiodeviceinfo.h"
+#include "blackmisc/worker.h"
+
+#include <QMutex>
+#include <QVector>
+#include <atomic>
+
+namespace BlackSound { namespace SampleProvider { class CVolumeSampleProvider; }}
+
+namespace BlackCore
+{
+    namespace Afv
+    {
+        namespace Audio
+        {
+            /*!
+             * Real-time playout thread, owns the audio output and the receive graph (decoding and mixing).
+             *
+             * Received packets are handed over by a lock-free queue, so the network thread never waits for the audio thread
+             * and vice versa. A queued wake-up adds them to the graph in the playout thread between two callbacks,
+             * so the audio callback neither allocates nor locks. Settings are applied the same way.
+             */
+            class BLACKCORE_EXPORT CPlayoutWorker : public BlackMisc::CContinuousWorker
+            {
+                Q_OBJECT
+
+            public:
+                //! Sample rate of the receive graph and output
+                static constexpr int SampleRate = 48000;
+
+                //! Max. number of received packets waiting to be added to the receive graph
+                static constexpr int QueueCapacity = 256;
+
+                //! Ctor
+                CPlayoutWorker(QObject *owner);
+
+                //! Start the output with a new receive graph
+                //! \threadsafe
+                //! \remark runs in the playout thread and is ASYNC when called from another thread
+                void startOutput(const BlackMisc::Audio::CAudioDeviceInfo &outputDevice, const QVector<quint16> &transceiverIDs, double gainRatio);
+
+                //! Stop the output
+                //! \threadsafe
+                //! \remark runs in the playout thread and is ASYNC when called from another thread
+                void stopOutput();
+
+                //! Hand over a received packet to the playout thread
+                //! \remark single producer, to be always called from the same thread
+                //! \return false if the packet is dropped, output not started or queue full
+                bool addReceivedAudio(const IAudioDto &audioDto, const QVector<RxTransceiverDto> &rxTransceivers);
+
+                //! Receive graph settings
+                //! \threadsafe
+                //! \remark runs in the playout thread and is ASYNC when called from another thread
+                //! @{
+                void setBypassEffects(bool value);
+                void updateRadioTransceivers(const QVector<TransceiverDto> &radioTransceivers);
+                void pttUpdate(bool active, const QVector<TxTransceiverDto> &txTransceivers);
+                void setGainRatio(double gainRatio);
+                //! @}
+
+                //! \copydoc CSoundcardSampleProvider::getJitterBufferStatistics
+                JitterBufferStatistics getJitterBufferStatistics() const;
+
+                //! Packets dropped as the queue was full
+                //! \threadsafe
+                int getDroppedPackets() const { return m_droppedPackets; }
+
+            signals:
+                //! \copydoc COutput::outputVolumeStream
+                void outputVolumeStream(const BlackCore::Afv::Audio::OutputVolumeStreamArgs &args);
+
+                //! \copydoc CSoundcardSampleProvider::receivingCallsignsChanged
+                void receivingCallsignsChanged(const BlackCore::Afv::Audio::TransceiverReceivingCallsignsChangedArgs &args);
+
+            protected:
+                //! \copydoc BlackMisc::CContinuousWorker::initialize
+                virtual void initialize() override;
+
+                //! \copydoc BlackMisc::CContinuousWorker::cleanup
+                virtual void cleanup() override;
+
+            private:
+                //! Stop the output and release the receive graph
+                void releaseOutput();
+
+                //! Discard the packets not played
+                void clearReceivedAudio();
+
+                //! Add the queued packets to the receive graph, in the playout thread
+                void addQueuedReceivedAudio();
+
+                CReceivedAudioQueue m_receivedAudio { QueueCapacity };
+                std::atomic_bool m_outputStarted    { false };
+                std::atomic_bool m_receivedAudioWakeUp { false }; //!< adding the queued packets is pending
+                std::atomic_int  m_droppedPackets   { 0 };
+                std::atomic_bool m_winCoInitialized { false }; //!< Windows only CoInitializeEx
+
+                // playout thread only
+                COutput *m_output = nullptr;
+                BlackSound::SampleProvider::CVolumeSampleProvider *m_outputSampleProvider = nullptr;
+
+                // pointer changed in the playout thread only, protected for the getters
+                CSoundcardSampleProvider *m_soundcardSampleProvider = nullptr;
+                mutable QMutex m_mutexSampleProviders { QMutex::Recursive };
+            };
+        } // ns
+    } // ns
+} // ns
+
+#endif // guard
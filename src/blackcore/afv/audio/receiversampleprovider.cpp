@@ -51,7 +51,14 @@ namespace BlackCore
 
                 m_blockTone = new CSinusGenerator(180, this);
                 m_mixer->addMixerInput(m_blockTone);
+                m_click = new CResourceSoundSampleProvider(Samples::instance().click(), this);
                 m_volume = new CVolumeSampleProvider(m_mixer);
+
+                m_receivingCallsignsTimer = new QTimer(this);
+                m_receivingCallsignsTimer->setObjectName(this->objectName() + ":m_receivingCallsignsTimer");
+                m_receivingCallsignsTimer->setInterval(100);
+                connect(m_receivingCallsignsTimer, &QTimer::timeout, this, &CReceiverSampleProvider::updateReceivingCallsigns);
+                m_receivingCallsignsTimer->start();
             }
 
             void CReceiverSampleProvider::setBypassEffects(bool value)
@@ -95,7 +102,13 @@ namespace BlackCore
                 }
             }
 
-            int CReceiverSampleProvider::readSamples(QVector<float> &samples, qint64 count)
+            bool CReceiverSampleProvider::isSilent() const
+            {
+                if (m_doClickWhenAppropriate || m_lastNumberOfInUseInputs > 0) { return false; }
+                return activeCallsigns() == 0 && m_mixer->isSilent();
+            }
+
+            int CReceiverSampleProvider::readSamples(float *samples, int count)
             {
                 int numberOfInUseInputs = activeCallsigns();
                 if (numberOfInUseInputs > 1 && m_doBlockWhenAppropriate)
@@ -110,32 +123,39 @@ namespace BlackCore
 
                 if (m_doClickWhenAppropriate && numberOfInUseInputs == 0)
                 {
-                    CResourceSoundSampleProvider *resourceSound = new CResourceSoundSampleProvider(Samples::instance().click(), m_mixer);
-                    m_mixer->addMixerInput(resourceSound);
+                    // preallocated, nothing is created in the audio thread
+                    m_click->restart();
+                    m_mixer->addMixerInput(m_click);
                     m_doClickWhenAppropriate = false;
                     // CLogMessage(this).debug(u"AFV Click...");
                 }
 
                 //! \todo KB 2020-04 not entirely correct, as it can be the number is the same, but changed callsign
-                if (numberOfInUseInputs != m_lastNumberOfInUseInputs)
+                // only flagged here, the lists are built and signalled by the timer, not in the audio callback
+                if (numberOfInUseInputs != m_lastNumberOfInUseInputs) { m_receivingCallsignsChanged = true; }
+                m_lastNumberOfInUseInputs = numberOfInUseInputs;
+                return m_volume->readSamples(samples, count);
+            }
+
+            void CReceiverSampleProvider::updateReceivingCallsigns()
+            {
+                if (!m_receivingCallsignsChanged) { return; }
+                m_receivingCallsignsChanged = false;
+
+                QStringList receivingCallsigns;
+                for (const CCallsignSampleProvider *voiceInput : m_voiceInputs)
                 {
-                    QStringList receivingCallsigns;
-                    for (const CCallsignSampleProvider *voiceInput : m_voiceInputs)
+                    const QString callsign = voiceInput->callsign();
+                    if (!callsign.isEmpty())
                     {
-                        const QString callsign = voiceInput->callsign();
-                        if (!callsign.isEmpty())
-                        {
-                            receivingCallsigns.push_back(callsign);
-                        }
+                        receivingCallsigns.push_back(callsign);
                     }
-
-                    m_receivingCallsignsString = receivingCallsigns.join(',');
-                    m_receivingCallsigns = CCallsignSet(receivingCallsigns);
-                    const TransceiverReceivingCallsignsChangedArgs args = { m_id, receivingCallsigns };
-                    emit receivingCallsignsChanged(args);
                 }
-                m_lastNumberOfInUseInputs = numberOfInUseInputs;
-                return m_volume->readSamples(samples, count);
+
+                m_receivingCallsignsString = receivingCallsigns.join(',');
+                m_receivingCallsigns = CCallsignSet(receivingCallsigns);
+                const TransceiverReceivingCallsignsChangedArgs args = { m_id, receivingCallsigns };
+                emit receivingCallsignsChanged(args);
             }
 
             void CReceiverSampleProvider::addOpusSamples(const IAudioDto &audioDto, uint frequency, float distanceRatio)
@@ -210,6 +230,16 @@ namespace BlackCore
                 return m_frequencyHz;
             }
 
+            JitterBufferStatistics CReceiverSampleProvider::getJitterBufferStatistics() const
+            {
+                JitterBufferStatistics statistics;
+                for (const CCallsignSampleProvider *voiceInput : m_voiceInputs)
+                {
+                    statistics += voiceInput->getJitterBufferStatistics();
+                }
+                return statistics;
+            }
+
             void CReceiverSampleProvider::logVoiceInputs(const QString &prefix, qint64 timeCheckOffsetMs)
             {
                 if (timeCheckOffsetMs > 100)
@@ -14,6 +14,7 @@
 #include "blackcore/afv/audio/callsignsampleprovider.h"
 #include "blacksound/sampleprovider/sampleprovider.h"
 #include "blacksound/sampleprovider/mixingsampleprovider.h"
+#include "blacksound/sampleprovider/resourcesoundsampleprovider.h"
 #include "blacksound/sampleprovider/sinusgenerator.h"
 #include "blacksound/sampleprovider/volumesampleprovider.h"
 
@@ -21,6 +22,7 @@
 #include "blackmisc/aviation/callsignset.h"
 #include "blackmisc/audio/audiosettings.h"
 
+#include <QTimer>
 #include <QtGlobal>
 
 namespace BlackCore
@@ -67,7 +69,11 @@ namespace BlackCore
                 //! @}
 
                 //! \copydoc BlackSound::SampleProvider::ISampleProvider::readSamples
-                virtual int readSamples(QVector<float> &samples, qint64 count) override;
+                virtual int readSamples(float *samples, int count) override;
+
+                //! \copydoc BlackSound::SampleProvider::ISampleProvider::isSilent
+                //! \remark not silent while a change of the receiving callsigns or a click is pending
+                virtual bool isSilent() const override;
 
                 //! Add samples
                 //! @{
@@ -89,6 +95,10 @@ namespace BlackCore
                 //! Get frequency in Hz
                 uint getFrequencyHz() const;
 
+                //! Jitter buffer statistics of all voice inputs
+                //! \threadsafe
+                JitterBufferStatistics getJitterBufferStatistics() const;
+
                 //! Log all inputs
                 //! \private DEBUG only
                 void logVoiceInputs(const QString &prefix = {}, qint64 timeCheckOffsetMs = -1);
@@ -98,6 +108,9 @@ namespace BlackCore
                 void receivingCallsignsChanged(const TransceiverReceivingCallsignsChangedArgs &args);
 
             private:
+                //! Update the receiving callsigns after a change seen in readSamples, outside of the audio callback
+                void updateReceivingCallsigns();
+
                 uint m_frequencyHz = 122800000;
                 bool m_mute        = false;
                 const double m_clickGain     = 1.0;
@@ -109,11 +122,14 @@ namespace BlackCore
                 BlackSound::SampleProvider::CVolumeSampleProvider *m_volume    = nullptr;
                 BlackSound::SampleProvider::CMixingSampleProvider *m_mixer     = nullptr;
                 BlackSound::SampleProvider::CSinusGenerator       *m_blockTone = nullptr;
+                BlackSound::SampleProvider::CResourceSoundSampleProvider *m_click = nullptr; //!< mixed in again whenever needed
                 QVector<CCallsignSampleProvider *> m_voiceInputs;
                 qint64 m_lastLogMessage = -1;
 
                 QString m_receivingCallsignsString;
                 BlackMisc::Aviation::CCallsignSet m_receivingCallsigns;
+                QTimer *m_receivingCallsignsTimer = nullptr;
+                bool m_receivingCallsignsChanged = false; //!< set in readSamples, handled by m_receivingCallsignsTimer
 
                 bool m_doClickWhenAppropriate  = false;
                 bool m_doBlockWhenAppropriate  = false;
@@ -91,11 +91,24 @@ namespace BlackCore
                 }
             }
 
-            int CSoundcardSampleProvider::readSamples(QVector<float> &samples, qint64 count)
+            int CSoundcardSampleProvider::readSamples(float *samples, int count)
             {
                 return m_mixer->readSamples(samples, count);
             }
 
+            int CSoundcardSampleProvider::addReceivedAudio()
+            {
+                if (!m_receivedAudio) { return 0; }
+                int added = 0;
+                ReceivedAudioDto received;
+                while (m_receivedAudio->pop(received))
+                {
+                    this->addOpusSamples(received.audio, received.rxTransceivers);
+                    added++;
+                }
+                return added;
+            }
+
             void CSoundcardSampleProvider::addOpusSamples(const IAudioDto &audioDto, const QVector<RxTransceiverDto> &rxTransceivers)
             {
                 QVector<RxTransceiverDto> rxTransceiversFilteredAndSorted = rxTransceivers;
@@ -192,6 +205,16 @@ namespace BlackCore
                 return m_receiverInputs.at(transceiverID)->getReceivingCallsigns();
             }
 
+            JitterBufferStatistics CSoundcardSampleProvider::getJitterBufferStatistics() const
+            {
+                JitterBufferStatistics statistics;
+                for (const CReceiverSampleProvider *receiverInput : m_receiverInputs)
+                {
+                    statistics += receiverInput->getJitterBufferStatistics();
+                }
+                return statistics;
+            }
+
         } // ns
     } // ns
 } // ns
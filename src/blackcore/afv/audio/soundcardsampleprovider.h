@@ -15,6 +15,7 @@
 #include "blacksound/sampleprovider/mixingsampleprovider.h"
 #include "blackcore/afv/audio/receiversampleprovider.h"
 #include "blackmisc/aviation/callsignset.h"
+#include "blackmisc/spscqueue.h"
 
 #include <QAudioFormat>
 #include <QObject>
@@ -25,6 +26,16 @@ namespace BlackCore
     {
         namespace Audio
         {
+            //! Received packet and the transceivers receiving it
+            struct ReceivedAudioDto
+            {
+                IAudioDto audio;                          //!< packet
+                QVector<RxTransceiverDto> rxTransceivers; //!< receiving transceivers
+            };
+
+            //! Received packets handed over to the playout thread
+            using CReceivedAudioQueue = BlackMisc::CSpscQueue<ReceivedAudioDto>;
+
             //! Soundcard sample
             class CSoundcardSampleProvider : public BlackSound::SampleProvider::ISampleProvider
             {
@@ -44,11 +55,20 @@ namespace BlackCore
                 void pttUpdate(bool active, const QVector<TxTransceiverDto> &txTransceivers);
 
                 //! \copydoc BlackSound::SampleProvider::ISampleProvider::readSamples
-                virtual int readSamples(QVector<float> &samples, qint64 count) override;
+                virtual int readSamples(float *samples, int count) override;
 
                 //! Add OPUS samples
                 void addOpusSamples(const IAudioDto &audioDto, const QVector<RxTransceiverDto> &rxTransceivers);
 
+                //! Queue of received packets, added to the receive graph by addReceivedAudio
+                //! \remark the queue must outlive this provider
+                void setReceivedAudioQueue(CReceivedAudioQueue *receivedAudio) { m_receivedAudio = receivedAudio; }
+
+                //! Add the queued received packets to the receive graph
+                //! \remark called in the playout thread between two reads, never in the audio callback, as adding a packet allocates
+                //! \return number of packets added
+                int addReceivedAudio();
+
                 //! Update all tranceivers
                 void updateRadioTransceivers(const QVector<TransceiverDto> &radioTransceivers);
 
@@ -58,6 +78,10 @@ namespace BlackCore
                 //! Receiving callsign as single string
                 BlackMisc::Aviation::CCallsignSet getReceivingCallsigns(quint16 transceiverID) const;
 
+                //! Jitter buffer statistics of all receivers
+                //! \threadsafe
+                JitterBufferStatistics getJitterBufferStatistics() const;
+
             signals:
                 //! Changed callsigns
                 void receivingCallsignsChanged(const TransceiverReceivingCallsignsChangedArgs &args);
@@ -67,6 +91,7 @@ namespace BlackCore
                 BlackSound::SampleProvider::CMixingSampleProvider *m_mixer = nullptr;
                 QVector<CReceiverSampleProvider *> m_receiverInputs;
                 QVector<quint16> m_receiverIDs;
+                CReceivedAudioQueue *m_receivedAudio = nullptr;
             };
 
         } // ns
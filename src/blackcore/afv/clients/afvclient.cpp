@@ -60,7 +60,7 @@ namespace BlackCore
                 CIdentifiable("CAfvClient"),
                 m_connection(new CClientConnection(apiServer, this)),
                 m_input(new CInput(SampleRate, this)),
-                m_output(new COutput(this)),
+                m_playout(new CPlayoutWorker(this)),
                 m_voiceServerTimer(new QTimer(this))
             {
                 this->setObjectName("AFV client: " + apiServer);
@@ -69,11 +69,13 @@ namespace BlackCore
                 connect(m_input, &CInput::opusDataAvailable, this, &CAfvClient::opusDataAvailable);
                 connect(m_input, &CInput::inputVolumeStream, this, &CAfvClient::inputVolumeStream);
 
-                connect(m_output,     &COutput::outputVolumeStream,      this, &CAfvClient::outputVolumeStream);
+                connect(m_playout,    &CPlayoutWorker::outputVolumeStream,        this, &CAfvClient::outputVolumeStream,          Qt::QueuedConnection);
+                connect(m_playout,    &CPlayoutWorker::receivingCallsignsChanged, this, &CAfvClient::onReceivingCallsignsChanged, Qt::QueuedConnection);
                 connect(m_connection, &CClientConnection::audioReceived, this, &CAfvClient::audioOutDataAvailable);
                 connect(m_voiceServerTimer, &QTimer::timeout,            this, &CAfvClient::onTimerUpdate);
 
                 m_updateTimer.stop(); // not used
+                m_playout->start(QThread::TimeCriticalPriority);
 
                 // deferred init - use BlackMisc:: singleShot to call in correct thread, "myself" NOT needed
                 BlackMisc::singleShot(1000, this, [ = ]
@@ -259,11 +261,7 @@ namespace BlackCore
 
             void CAfvClient::setBypassEffects(bool value)
             {
-                QMutexLocker lock(&m_mutexSampleProviders);
-                if (m_soundcardSampleProvider)
-                {
-                    m_soundcardSampleProvider->setBypassEffects(value);
-                }
+                if (m_playout) { m_playout->setBypassEffects(value); }
             }
 
             bool CAfvClient::isMuted() const
@@ -318,27 +316,17 @@ namespace BlackCore
                 // threadsafe block
                 const double outputVolume = this->getOutputGainRatio();
                 {
-                    // lock block 1
+                    // receive graph and output are created in the playout thread
                     {
-                        QMutexLocker lock{&m_mutexSampleProviders};
-                        if (m_soundcardSampleProvider)
-                        {
-                            m_soundcardSampleProvider->disconnect();
-                            m_soundcardSampleProvider->deleteLater();
-                        }
-                        m_soundcardSampleProvider = new CSoundcardSampleProvider(SampleRate, allTransceiverIds(), this);
-                        connect(m_soundcardSampleProvider, &CSoundcardSampleProvider::receivingCallsignsChanged, this, &CAfvClient::onReceivingCallsignsChanged);
-
-                        if (m_outputSampleProvider) { m_outputSampleProvider->deleteLater(); }
-                        m_outputSampleProvider = new CVolumeSampleProvider(m_soundcardSampleProvider, this);
-                        m_outputSampleProvider->setGainRatio(outputVolume);
+                        QMutexLocker lock(&m_mutexReceivingCallsigns);
+                        m_receivingCallsigns.clear();
                     }
+                    m_playout->startOutput(useOutputDevice, allTransceiverIds(), outputVolume);
 
-                    // lock block 2
                     {
                         QMutexLocker lock(&m_mutex);
 
-                        m_output->start(useOutputDevice, m_outputSampleProvider);
+                        m_outputDevice = useOutputDevice;
                         m_input->start(useInputDevice);
                         m_startDateTimeUtc = QDateTime::currentDateTimeUtc();
 
@@ -395,7 +383,12 @@ namespace BlackCore
                 {
                     QMutexLocker lock{&m_mutex};
                     m_input->stop();
-                    m_output->stop();
+                    if (m_playout) { m_playout->stopOutput(); }
+                    m_outputDevice = CAudioDeviceInfo();
+                }
+                {
+                    QMutexLocker lock(&m_mutexReceivingCallsigns);
+                    m_receivingCallsigns.clear();
                 }
                 CLogMessage(this).info(u"AFV Client stopped");
 
@@ -580,10 +573,7 @@ namespace BlackCore
                     QMutexLocker lock(&m_mutexConnection);
                     if (m_connection) { m_connection->updateTransceivers(callsign, newEnabledTransceivers); }
                 }
-                {
-                    QMutexLocker lock(&m_mutexSampleProviders);
-                    if (m_soundcardSampleProvider) { m_soundcardSampleProvider->updateRadioTransceivers(newEnabledTransceivers); }
-                }
+                if (m_playout) { m_playout->updateRadioTransceivers(newEnabledTransceivers); }
             }
 
             void CAfvClient::setTransmittingTransceiver(quint16 transceiverID)
@@ -710,11 +700,7 @@ namespace BlackCore
 
                 // thread safe block
                 {
-                    QMutexLocker lock(&m_mutexSampleProviders);
-                    if (m_soundcardSampleProvider)
-                    {
-                        m_soundcardSampleProvider->pttUpdate(active, m_transmittingTransceivers);
-                    }
+                    if (m_playout) { m_playout->pttUpdate(active, this->getTransmittingTransceivers()); }
 
                     /** TODO: RR 2019-10 as discussed https://discordapp.com/channels/539048679160676382/623947987822837779/633320595978846208
                      *  disabled for the moment as not needed
@@ -849,6 +835,12 @@ namespace BlackCore
                 return m_outputVolumeStream.PeakVU;
             }
 
+            JitterBufferStatistics CAfvClient::getJitterBufferStatistics() const
+            {
+                if (!m_playout) { return {}; }
+                return m_playout->getJitterBufferStatistics();
+            }
+
             void CAfvClient::opusDataAvailable(const OpusDataAvailableArgs &args)
             {
                 const bool transmit = m_transmit;
@@ -862,13 +854,13 @@ namespace BlackCore
                     audioData.audio      = QByteArray(args.audio.data(), args.audio.size());
                     audioData.callsign   = QStringLiteral("loopback");
                     audioData.lastPacket = false;
-                    audioData.sequenceCounter = 0;
+                    audioData.sequenceCounter = args.sequenceCounter; // ordered by the jitter buffer
 
                     const RxTransceiverDto com1 = { 0, transceivers.size() > 0 ?  transceivers[0].frequencyHz : UniCom, 1.0 };
                     const RxTransceiverDto com2 = { 1, transceivers.size() > 1 ?  transceivers[1].frequencyHz : UniCom, 1.0 };
 
-                    QMutexLocker lock(&m_mutexSampleProviders);
-                    m_soundcardSampleProvider->addOpusSamples(audioData, { com1, com2 });
+                    audioData.receivedMs = CJitterBuffer::currentTimeMs();
+                    m_playout->addReceivedAudio(audioData, { com1, com2 });
                     return;
                 }
 
@@ -912,9 +904,10 @@ namespace BlackCore
                 audioData.callsign        = QString::fromStdString(dto.callsign);
                 audioData.lastPacket      = dto.lastPacket;
                 audioData.sequenceCounter = dto.sequenceCounter;
+                audioData.receivedMs      = CJitterBuffer::currentTimeMs();
 
-                QMutexLocker lock(&m_mutexSampleProviders);
-                m_soundcardSampleProvider->addOpusSamples(audioData, QVector<RxTransceiverDto>(dto.transceivers.begin(), dto.transceivers.end()));
+                // same thread as the loopback, the single producer of the playout queue
+                m_playout->addReceivedAudio(audioData, QVector<RxTransceiverDto>(dto.transceivers.begin(), dto.transceivers.end()));
             }
 
             void CAfvClient::inputVolumeStream(const InputVolumeStreamArgs &args)
@@ -939,39 +932,33 @@ namespace BlackCore
 
             QString CAfvClient::getReceivingCallsignsStringCom1() const
             {
-                QMutexLocker lock(&m_mutex);
-                if (!m_soundcardSampleProvider) return {};
-                return m_soundcardSampleProvider->getReceivingCallsignsString(comUnitToTransceiverId(CComSystem::Com1));
+                QMutexLocker lock(&m_mutexReceivingCallsigns);
+                return m_receivingCallsigns.value(comUnitToTransceiverId(CComSystem::Com1)).join(',');
             }
 
             QString CAfvClient::getReceivingCallsignsStringCom2() const
             {
-                QMutexLocker lock(&m_mutexSampleProviders);
-                if (!m_soundcardSampleProvider) return {};
-                return m_soundcardSampleProvider->getReceivingCallsignsString(comUnitToTransceiverId(CComSystem::Com2));
+                QMutexLocker lock(&m_mutexReceivingCallsigns);
+                return m_receivingCallsigns.value(comUnitToTransceiverId(CComSystem::Com2)).join(',');
             }
 
             CCallsignSet CAfvClient::getReceivingCallsignsCom1() const
             {
-                QMutexLocker lock(&m_mutexSampleProviders);
-                if (!m_soundcardSampleProvider) return {};
-                return m_soundcardSampleProvider->getReceivingCallsigns(comUnitToTransceiverId(CComSystem::Com1));
+                QMutexLocker lock(&m_mutexReceivingCallsigns);
+                return CCallsignSet(m_receivingCallsigns.value(comUnitToTransceiverId(CComSystem::Com1)));
             }
 
             CCallsignSet CAfvClient::getReceivingCallsignsCom2() const
             {
-                QMutexLocker lock(&m_mutexSampleProviders);
-                if (!m_soundcardSampleProvider) return {};
-                return m_soundcardSampleProvider->getReceivingCallsigns(comUnitToTransceiverId(CComSystem::Com2));
+                QMutexLocker lock(&m_mutexReceivingCallsigns);
+                return CCallsignSet(m_receivingCallsigns.value(comUnitToTransceiverId(CComSystem::Com2)));
             }
 
             QStringList CAfvClient::getReceivingCallsignsStringCom1Com2() const
             {
                 QStringList coms;
-                QMutexLocker lock(&m_mutexSampleProviders);
-                if (!m_soundcardSampleProvider) { return {{ QString(), QString() }}; }
-                coms << m_soundcardSampleProvider->getReceivingCallsignsString(comUnitToTransceiverId(CComSystem::Com1));
-                coms << m_soundcardSampleProvider->getReceivingCallsignsString(comUnitToTransceiverId(CComSystem::Com2));
+                coms << this->getReceivingCallsignsStringCom1();
+                coms << this->getReceivingCallsignsStringCom2();
                 return coms;
             }
 
@@ -986,6 +973,11 @@ namespace BlackCore
             {
                 this->stopAudio();
                 this->disconnectFrom();
+                if (m_playout)
+                {
+                    m_playout->quitAndWait(); // stops the output in the playout thread
+                    m_playout = nullptr;
+                }
                 this->quitAndWait();
                 Q_ASSERT_X(CThreadUtils::isInThisThread(this), Q_FUNC_INFO, "Needs to be back in current thread");
             }
@@ -1197,10 +1189,7 @@ namespace BlackCore
                         }
                     }
 
-                    {
-                        QMutexLocker lock(&m_mutexSampleProviders);
-                        if (m_soundcardSampleProvider) { m_soundcardSampleProvider->updateRadioTransceivers(newEnabledTransceivers); }
-                    }
+                    if (m_playout) { m_playout->updateRadioTransceivers(newEnabledTransceivers); }
                 }
 
                 if (withSignals) { emit this->updatedFromOwnAircraftCockpit(); }
@@ -1214,6 +1203,11 @@ namespace BlackCore
 
             void CAfvClient::onReceivingCallsignsChanged(const TransceiverReceivingCallsignsChangedArgs &args)
             {
+                {
+                    QMutexLocker lock(&m_mutexReceivingCallsigns);
+                    m_receivingCallsigns[args.transceiverID] = args.receivingCallsigns;
+                }
+
                 const CComSystem::ComUnit unit = transceiverIdToComUnit(args.transceiverID);
                 CCallsignSet callsignsCom1;
                 CCallsignSet callsignsCom2;
@@ -1426,44 +1420,31 @@ namespace BlackCore
                     }
                 }
 
-                // do NOT check on "changed", can be false, but "m_outputSampleProvider" is initialized
-                // HINT: I do this tryLock here because I had deadlocks here, and I need to further investigate
-                // As deadlocks mean (for the user) he needs to terminate the client I keep "trylock" that for now
-                if (!m_mutexSampleProviders.tryLock(1000))
-                {
-                    return false;
-                }
-
-                if (m_outputSampleProvider)
-                {
-                    changed = m_outputSampleProvider->setGainRatio(gainRatio);
-                }
-                m_mutexSampleProviders.unlock();
+                // do NOT check on "changed", can be false, but the output gain is not yet initialized
+                // applied in the playout thread, never waits for the audio callback
+                if (m_playout) { m_playout->setGainRatio(gainRatio); }
                 return changed;
             }
 
-            const CAudioDeviceInfo &CAfvClient::getInputDevice() const
+            CAudioDeviceInfo CAfvClient::getInputDevice() const
             {
                 QMutexLocker lock(&m_mutex);
                 if (m_input) { return m_input->device(); }
-                static const CAudioDeviceInfo nullDevice;
-                return nullDevice;
+                return {};
             }
 
-            const CAudioDeviceInfo &CAfvClient::getOutputDevice() const
+            CAudioDeviceInfo CAfvClient::getOutputDevice() const
             {
                 QMutexLocker lock(&m_mutex);
-                if (m_output) { return m_output->device(); }
-                static const CAudioDeviceInfo nullDevice;
-                return nullDevice;
+                return m_outputDevice;
             }
 
             bool CAfvClient::usesSameDevices(const CAudioDeviceInfo &inputDevice, const CAudioDeviceInfo &outputDevice)
             {
                 QMutexLocker lock(&m_mutex);
-                if (!m_output || !m_input) { return false; }
+                if (!m_input) { return false; }
                 const CAudioDeviceInfo i = m_input->device();
-                const CAudioDeviceInfo o = m_output->device();
+                const CAudioDeviceInfo o = m_outputDevice;
                 lock.unlock();
 
                 return i.matchesNameTypeMachineName(inputDevice) &&
@@ -14,12 +14,10 @@
 #include "blackcore/context/contextownaircraft.h"
 #include "blackcore/afv/connection/clientconnection.h"
 #include "blackcore/afv/audio/input.h"
-#include "blackcore/afv/audio/output.h"
-#include "blackcore/afv/audio/soundcardsampleprovider.h"
+#include "blackcore/afv/audio/playoutworker.h"
 #include "blackcore/afv/dto.h"
 #include "blackcore/blackcoreexport.h"
 
-#include "blacksound/sampleprovider/volumesampleprovider.h"
 #include "blackmisc/aviation/comsystem.h"
 #include "blackmisc/audio/audiosettings.h"
 #include "blackmisc/audio/ptt.h"
@@ -30,10 +28,12 @@
 #include "blackmisc/worker.h"
 
 #include <QDateTime>
+#include <QHash>
 #include <QAudioInput>
 #include <QAudioOutput>
 #include <QObject>
 #include <QString>
+#include <QStringList>
 #include <QVector>
 
 #include <atomic>
@@ -261,11 +261,15 @@ namespace BlackCore
                 double getOutputVolumePeakVU() const;
                 //! @}
 
+                //! Jitter buffer statistics of the received transmissions, latency, loss and concealed frames
+                //! \threadsafe
+                Audio::JitterBufferStatistics getJitterBufferStatistics() const;
+
                 //! Recently used device
                 //! \threadsafe
                 //! @{
-                const BlackMisc::Audio::CAudioDeviceInfo &getInputDevice()  const;
-                const BlackMisc::Audio::CAudioDeviceInfo &getOutputDevice() const;
+                BlackMisc::Audio::CAudioDeviceInfo getInputDevice()  const;
+                BlackMisc::Audio::CAudioDeviceInfo getOutputDevice() const;
                 bool usesSameDevices(const BlackMisc::Audio::CAudioDeviceInfo &inputDevice, const BlackMisc::Audio::CAudioDeviceInfo &outputDevice);
                 //! @}
 
@@ -387,11 +391,10 @@ namespace BlackCore
                 BlackMisc::CSetting<BlackMisc::Audio::TSettings> m_audioSettings { this, &CAfvClient::onSettingsChanged };
                 QString m_callsign;
 
-                Audio::CInput  *m_input  = nullptr;
-                Audio::COutput *m_output = nullptr;
-
-                Audio::CSoundcardSampleProvider *m_soundcardSampleProvider = nullptr;
-                BlackSound::SampleProvider::CVolumeSampleProvider *m_outputSampleProvider = nullptr;
+                Audio::CInput *m_input = nullptr;
+                BlackMisc::Audio::CAudioDeviceInfo m_outputDevice; //!< started output device
+                Audio::CPlayoutWorker *m_playout = nullptr; //!< output, decoding and mixing in its own real-time thread
+                QHash<quint16, QStringList> m_receivingCallsigns; //!< per transceiver, as reported by the playout thread
 
                 std::atomic_bool m_transmit        { false };
                 std::atomic_bool m_transmitHistory { false };
@@ -438,7 +441,7 @@ namespace BlackCore
                 mutable QMutex m_mutexCallsign        { QMutex::Recursive };
                 mutable QMutex m_mutexConnection      { QMutex::Recursive };
                 mutable QMutex m_mutexVolume          { QMutex::Recursive };
-                mutable QMutex m_mutexSampleProviders { QMutex::Recursive };
+                mutable QMutex m_mutexReceivingCallsigns { QMutex::Recursive };
 
             };
         } // ns
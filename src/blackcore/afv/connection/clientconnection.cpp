@@ -10,8 +10,6 @@
 #include "blackmisc/logmessage.h"
 #include "blackconfig/buildconfig.h"
 
-#include <QNetworkDatagram>
-
 using namespace BlackConfig;
 using namespace BlackMisc;
 using namespace BlackCore::Afv::Crypto;
@@ -34,6 +32,9 @@ namespace BlackCore
                 // connect(&m_apiServerConnection, &ApiServerConnection::addCallsignFinished,    this, &ClientConnection::addCallsignFinished);
                 // connect(&m_apiServerConnection, &ApiServerConnection::removeCallsignFinished, this, &ClientConnection::removeCallsignFinished);
 
+                m_sendPacket.reserve(CryptoDtoSerializer::MaxPacketSize);
+                m_receivedPacket.reserve(CryptoDtoSerializer::MaxPacketSize);
+
                 connect(m_voiceServerTimer, &QTimer::timeout, this, &CClientConnection::voiceServerHeartbeat); // sends heartbeat to server
                 connect(m_udpSocket, &QUdpSocket::readyRead,  this, &CClientConnection::readPendingDatagrams);
                 connect(m_udpSocket, qOverload<QAbstractSocket::SocketError>(&QUdpSocket::error), this, &CClientConnection::handleSocketError);
@@ -153,12 +154,18 @@ namespace BlackCore
             {
                 while (m_udpSocket->hasPendingDatagrams())
                 {
-                    const QNetworkDatagram datagram = m_udpSocket->receiveDatagram();
-                    this->processMessage(datagram.data());
+                    // read into the reused buffer, decrypted in place
+                    const qint64 size = m_udpSocket->pendingDatagramSize();
+                    if (size < 0) { break; }
+                    m_receivedPacket.resize(static_cast<int>(size));
+                    const qint64 read = m_udpSocket->readDatagram(m_receivedPacket.data(), size);
+                    if (read < 0) { continue; }
+                    m_receivedPacket.resize(static_cast<int>(read));
+                    this->processMessage(m_receivedPacket);
                 }
             }
 
-            void CClientConnection::processMessage(const QByteArray &messageDdata, bool loopback)
+            void CClientConnection::processMessage(QByteArray &messageDdata, bool loopback)
             {
                 if (!m_connection.m_voiceCryptoChannel)
                 {
@@ -206,8 +213,8 @@ namespace BlackCore
                 if (CBuildConfig::isLocalDeveloperDebugBuild()) { CLogMessage(this).debug(u"Sending voice server heartbeat to '%1'") << voiceServerUrl.host(); }
                 HeartbeatDto keepAlive;
                 keepAlive.callsign = m_connection.getCallsign().toStdString();
-                const QByteArray dataBytes = CryptoDtoSerializer::serialize(*m_connection.m_voiceCryptoChannel, CryptoDtoMode::AEAD_ChaCha20Poly1305, keepAlive);
-                m_udpSocket->writeDatagram(dataBytes, QHostAddress(voiceServerUrl.host()), static_cast<quint16>(voiceServerUrl.port()));
+                if (!CryptoDtoSerializer::serialize(m_sendPacket, *m_connection.m_voiceCryptoChannel, CryptoDtoMode::AEAD_ChaCha20Poly1305, keepAlive)) { return; }
+                m_udpSocket->writeDatagram(m_sendPacket, QHostAddress(voiceServerUrl.host()), static_cast<quint16>(voiceServerUrl.port()));
             }
         } // ns
     } // ns
@@ -79,8 +79,8 @@ namespace BlackCore
                         return;
                     }
                     const QUrl voiceServerUrl("udp://" + m_connection.getTokens().VoiceServer.addressIpV4);
-                    const QByteArray dataBytes = Crypto::CryptoDtoSerializer::serialize(*m_connection.m_voiceCryptoChannel, Crypto::CryptoDtoMode::AEAD_ChaCha20Poly1305, dto);
-                    m_udpSocket->writeDatagram(dataBytes, QHostAddress(voiceServerUrl.host()), static_cast<quint16>(voiceServerUrl.port()));
+                    if (!Crypto::CryptoDtoSerializer::serialize(m_sendPacket, *m_connection.m_voiceCryptoChannel, Crypto::CryptoDtoMode::AEAD_ChaCha20Poly1305, dto)) { return; }
+                    m_udpSocket->writeDatagram(m_sendPacket, QHostAddress(voiceServerUrl.host()), static_cast<quint16>(voiceServerUrl.port()));
                 }
 
                 //! Update transceivers
@@ -116,7 +116,7 @@ namespace BlackCore
                 void disconnectFromVoiceServer();
 
                 void readPendingDatagrams();
-                void processMessage(const QByteArray &messageDdata, bool loopback = false);
+                void processMessage(QByteArray &messageDdata, bool loopback = false); //!< decrypts messageDdata in place
                 void handleSocketError(QAbstractSocket::SocketError error);
 
                 void voiceServerHeartbeat();
@@ -129,6 +129,8 @@ namespace BlackCore
                 // Voice server
                 QUdpSocket *m_udpSocket        = nullptr;
                 QTimer     *m_voiceServerTimer = nullptr;
+                QByteArray  m_sendPacket;     //!< reused for every packet sent
+                QByteArray  m_receivedPacket; //!< reused for every datagram received
 
                 // API server
                 CApiServerConnection *m_apiServerConnection = nullptr;
@@ -12,6 +12,7 @@
 #define BLACKCORE_AFV_CRYPTO_CRYPTODTOCHANNEL_H
 
 #include "blackcore/afv/dto.h"
+#include "blackcore/blackcoreexport.h"
 #include "cryptodtomode.h"
 
 #include <QDateTime>
@@ -27,7 +28,7 @@ namespace BlackCore
         namespace Crypto
         {
             //! Crypto channel
-            class CCryptoDtoChannel
+            class BLACKCORE_EXPORT CCryptoDtoChannel
             {
             public:
                 //! Ctor
@@ -14,73 +14,107 @@ namespace BlackCore
     {
         namespace Crypto
         {
+            constexpr int CryptoDtoSerializer::MaxPacketSize;
+
             CryptoDtoSerializer::CryptoDtoSerializer() { }
 
-            CryptoDtoSerializer::Deserializer CryptoDtoSerializer::deserialize(CCryptoDtoChannel &channel, const QByteArray &bytes, bool loopback)
+            CryptoDtoSerializer::Deserializer CryptoDtoSerializer::deserialize(CCryptoDtoChannel &channel, QByteArray &bytes, bool loopback)
             {
                 return Deserializer(channel, bytes, loopback);
             }
 
-            CryptoDtoSerializer::Deserializer::Deserializer(CCryptoDtoChannel &channel, const QByteArray &bytes, bool loopback)
+            void CryptoDtoSerializer::makeNonce(uint64_t sequence, unsigned char *nonce)
             {
-                QByteArray data(bytes);
-                QBuffer buffer(&data);
-                buffer.open(QIODevice::ReadOnly);
+                // 32 bit id 0, 64 bit sequence
+                std::memset(nonce, 0, crypto_aead_chacha20poly1305_IETF_NPUBBYTES);
+                std::memcpy(nonce + sizeof(uint32_t), &sequence, sizeof(sequence));
+            }
 
-                buffer.read((char *)&m_headerLength, sizeof(m_headerLength));
+            bool CryptoDtoSerializer::encryptInPlace(QByteArray &packet, int payloadStart, uint64_t sequence, const QByteArray &key)
+            {
+                if (key.size() != crypto_aead_chacha20poly1305_IETF_KEYBYTES) { packet.resize(0); return false; }
+
+                const int payloadLength = packet.size() - payloadStart;
+                packet.resize(packet.size() + static_cast<int>(crypto_aead_chacha20poly1305_IETF_ABYTES));
+                unsigned char *data = reinterpret_cast<unsigned char *>(packet.data());
+
+                unsigned char nonce[crypto_aead_chacha20poly1305_IETF_NPUBBYTES];
+                makeNonce(sequence, nonce);
+
+                unsigned long long macLength = 0;
+                const int result = crypto_aead_chacha20poly1305_ietf_encrypt_detached(data + payloadStart, data + payloadStart + payloadLength, &macLength,
+                                   data + payloadStart, static_cast<unsigned long long>(payloadLength),
+                                   data, static_cast<unsigned long long>(payloadStart),
+                                   nullptr, nonce,
+                                   reinterpret_cast<const unsigned char *>(key.constData()));
+                if (result != 0)
+                {
+                    packet.resize(0);
+                    return false;
+                }
+                return true;
+            }
 
-                QByteArray headerBuffer = buffer.read(m_headerLength);
+            CryptoDtoSerializer::Deserializer::Deserializer(CCryptoDtoChannel &channel, QByteArray &bytes, bool loopback)
+            {
+                const int size = bytes.size();
+                if (size < static_cast<int>(sizeof(m_headerLength))) { return; }
+                std::memcpy(&m_headerLength, bytes.constData(), sizeof(m_headerLength));
 
-                msgpack::object_handle oh = msgpack::unpack(headerBuffer.data(), headerBuffer.size());
+                const int payloadStart = static_cast<int>(sizeof(m_headerLength)) + m_headerLength;
+                if (payloadStart > size) { return; }
+
+                msgpack::object_handle oh = msgpack::unpack(bytes.constData() + sizeof(m_headerLength), m_headerLength);
                 m_header = oh.get().as<CryptoDtoHeaderDto>();
 
                 if (m_header.Mode == CryptoDtoMode::AEAD_ChaCha20Poly1305)
                 {
-                    int aeLength = buffer.size() - (2 + m_headerLength);
-                    const QByteArray aePayloadBuffer = buffer.read(aeLength);
-
-                    const QByteArray adBuffer = data.left(2 + m_headerLength);
-
-                    QByteArray nonce;
-                    nonce.fill(0, crypto_aead_chacha20poly1305_IETF_NPUBBYTES);
-                    QBuffer nonceBuffer(&nonce);
-                    nonceBuffer.open(QIODevice::WriteOnly);
-                    uint32_t id = 0;
-                    nonceBuffer.write(reinterpret_cast<const char *>(&id), sizeof(id));
-                    nonceBuffer.write(reinterpret_cast<const char *>(&m_header.Sequence), sizeof(m_header.Sequence));
-                    nonceBuffer.close();
-
-                    QByteArray decryptedPayload;
-                    unsigned long long mlen = 500;
-                    decryptedPayload.fill(0, mlen);
-
-                    QByteArray key;
-                    if (loopback) { key = channel.getTransmitKey(CryptoDtoMode::AEAD_ChaCha20Poly1305); }
-                    else { key = channel.getReceiveKey(CryptoDtoMode::AEAD_ChaCha20Poly1305); }
-                    int result = crypto_aead_chacha20poly1305_ietf_decrypt(reinterpret_cast<unsigned char *>(decryptedPayload.data()), &mlen, nullptr,
-                                 reinterpret_cast<const unsigned char *>(aePayloadBuffer.constData()), aePayloadBuffer.size(),
-                                 reinterpret_cast<const unsigned char *>(adBuffer.constData()), adBuffer.size(),
-                                 reinterpret_cast<const unsigned char *>(nonce.constData()),
-                                 reinterpret_cast<const unsigned char *>(key.constData()));
+                    const int payloadLength = size - payloadStart - static_cast<int>(crypto_aead_chacha20poly1305_IETF_ABYTES);
+                    if (payloadLength < 0) { return; }
+
+                    const QByteArray key = loopback ?
+                                           channel.getTransmitKey(CryptoDtoMode::AEAD_ChaCha20Poly1305) :
+                                           channel.getReceiveKey(CryptoDtoMode::AEAD_ChaCha20Poly1305);
+                    if (key.size() != crypto_aead_chacha20poly1305_IETF_KEYBYTES) { return; }
+
+                    unsigned char nonce[crypto_aead_chacha20poly1305_IETF_NPUBBYTES];
+                    makeNonce(m_header.Sequence, nonce);
+
+                    // decrypted over the encrypted payload, the header is the additional data
+                    unsigned char *data = reinterpret_cast<unsigned char *>(bytes.data());
+                    const int result = crypto_aead_chacha20poly1305_ietf_decrypt_detached(data + payloadStart, nullptr,
+                                       data + payloadStart, static_cast<unsigned long long>(payloadLength),
+                                       data + payloadStart + payloadLength,
+                                       data, static_cast<unsigned long long>(payloadStart),
+                                       nonce,
+                                       reinterpret_cast<const unsigned char *>(key.constData()));
 
                     if (result == 0)
                     {
-                        decryptedPayload.resize(mlen);
-
                         // Fix this:
                         // if (! channel.checkReceivedSequence(header.Sequence)) { }
 
-                        QBuffer decryptedPayloadBuffer(&decryptedPayload);
-                        decryptedPayloadBuffer.open(QIODevice::ReadOnly);
-                        decryptedPayloadBuffer.read((char *)&m_dtoNameLength, sizeof(m_dtoNameLength));
-                        m_dtoNameBuffer = decryptedPayloadBuffer.read(m_dtoNameLength);
-
-                        decryptedPayloadBuffer.read((char *)&m_dataLength, sizeof(m_dataLength));
-                        m_dataBuffer = decryptedPayloadBuffer.read(m_dataLength);
+                        const char *payload = bytes.constData() + payloadStart;
+                        const char *payloadEnd = payload + payloadLength;
+                        if (!readBlock(payload, payloadEnd, m_dtoNameLength, m_dtoNameBuffer)) { return; }
+                        if (!readBlock(payload, payloadEnd, m_dataLength, m_dataBuffer)) { return; }
                         m_verified = true;
                     }
                 }
             }
+
+            bool CryptoDtoSerializer::Deserializer::readBlock(const char *&position, const char *end, quint16 &length, QByteArray &block)
+            {
+                if (end - position < static_cast<std::ptrdiff_t>(sizeof(length))) { return false; }
+                std::memcpy(&length, position, sizeof(length));
+                position += sizeof(length);
+                if (end - position < length) { return false; }
+
+                // no copy, refers to the packet
+                block = QByteArray::fromRawData(position, length);
+                position += length;
+                return true;
+            }
         } // ns
     } // ns
 } // ns
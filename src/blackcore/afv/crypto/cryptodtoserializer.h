@@ -14,11 +14,12 @@
 #include "cryptodtochannel.h"
 #include "cryptodtomode.h"
 #include "cryptodtoheaderdto.h"
+#include "blackcore/blackcoreexport.h"
 #include "sodium.h"
 
 #include <QByteArray>
-#include <QBuffer>
 #include <QtDebug>
+#include <cstring>
 
 #ifndef crypto_aead_chacha20poly1305_IETF_ABYTES
 //! Number of a bytes
@@ -35,96 +36,80 @@ namespace BlackCore
             extern QHash<QByteArray, QByteArray> gShortDtoNames;
 
             //! Crypto serializer
-            class CryptoDtoSerializer
+            //! \details A packet is the 16 bit header length and the msgpack header, followed by the encrypted
+            //!          payload: 16 bit name length, DTO short name, 16 bit DTO length and msgpack DTO, then the MAC.
+            class BLACKCORE_EXPORT CryptoDtoSerializer
             {
             public:
                 CryptoDtoSerializer();
 
-                //! Serialize a DTO
+                //! Max. size of a voice packet, capacity to be reserved for the reused packets
+                static constexpr int MaxPacketSize = 1500;
+
+                //! Serialize a DTO into a packet
+                //! \remark header and DTO are packed into packet and encrypted in place, the buffer is reused
+                //! \return false if not encrypted, packet is empty then
                 template<typename T>
-                static QByteArray serialize(const QString &channelTag, CryptoDtoMode mode, const QByteArray &transmitKey, uint sequenceToBeSent, T dto)
+                static bool serialize(QByteArray &packet, const QString &channelTag, CryptoDtoMode mode, const QByteArray &transmitKey, uint sequenceToBeSent, const T &dto)
                 {
-                    const CryptoDtoHeaderDto header = { channelTag.toStdString(), sequenceToBeSent, mode };
+                    packet.resize(0);
+                    if (mode != CryptoDtoMode::AEAD_ChaCha20Poly1305) { return false; }
 
-                    QBuffer headerBuffer;
-                    headerBuffer.open(QIODevice::WriteOnly);
-                    msgpack::pack(headerBuffer, header);
-                    headerBuffer.close();
-                    const quint16 headerLength = static_cast<quint16>(headerBuffer.buffer().size());
+                    const CryptoDtoHeaderDto header = { channelTag.toStdString(), sequenceToBeSent, mode };
+                    CPacketWriter writer(packet);
+                    const int headerLength = writer.beginBlock();
+                    msgpack::pack(writer, header);
+                    writer.endBlock(headerLength);
 
+                    // encrypted payload, the header is the additional data
+                    const int payloadStart = packet.size();
                     const QByteArray dtoShortName = T::getShortDtoName();
-                    const quint16 dtoNameLength = static_cast<quint16>(dtoShortName.size());
-
-                    QBuffer dtoBuffer;
-                    dtoBuffer.open(QIODevice::WriteOnly);
-                    msgpack::pack(dtoBuffer, dto);
-                    dtoBuffer.close();
-                    const quint16 dtoLength = static_cast<quint16>(dtoBuffer.buffer().size());
+                    const int dtoNameLength = writer.beginBlock();
+                    writer.write(dtoShortName.constData(), static_cast<std::size_t>(dtoShortName.size()));
+                    writer.endBlock(dtoNameLength);
+                    const int dtoLength = writer.beginBlock();
+                    msgpack::pack(writer, dto);
+                    writer.endBlock(dtoLength);
+
+                    return encryptInPlace(packet, payloadStart, header.Sequence, transmitKey);
+                }
 
-                    if (header.Mode == CryptoDtoMode::AEAD_ChaCha20Poly1305)
-                    {
-                        QBuffer aePayloadBuffer;
-                        aePayloadBuffer.open(QIODevice::WriteOnly);
-                        aePayloadBuffer.write(reinterpret_cast<const char *>(&dtoNameLength), sizeof(dtoNameLength));
-                        aePayloadBuffer.write(dtoShortName);
-                        aePayloadBuffer.write(reinterpret_cast<const char *>(&dtoLength), sizeof(dtoLength));
-                        aePayloadBuffer.write(dtoBuffer.buffer());
-                        aePayloadBuffer.close();
-
-                        QBuffer adPayloadBuffer;
-                        adPayloadBuffer.open(QIODevice::WriteOnly);
-                        adPayloadBuffer.write(reinterpret_cast<const char *>(&headerLength), sizeof(headerLength));
-                        adPayloadBuffer.write(headerBuffer.buffer());
-                        adPayloadBuffer.close();
-
-                        QByteArray nonce;
-                        nonce.fill(0, crypto_aead_chacha20poly1305_IETF_NPUBBYTES);
-                        QBuffer nonceBuffer(&nonce);
-                        nonceBuffer.open(QIODevice::WriteOnly);
-                        uint32_t id = 0;
-                        nonceBuffer.write(reinterpret_cast<const char *>(&id), sizeof(id));
-                        nonceBuffer.write(reinterpret_cast<const char *>(&header.Sequence), sizeof(header.Sequence));
-                        nonceBuffer.close();
-
-                        unsigned long long clen;
-                        QByteArray aeadPayload;
-                        aeadPayload.fill(0, static_cast<int>(aePayloadBuffer.size() + crypto_aead_chacha20poly1305_IETF_ABYTES));
-                        int result = crypto_aead_chacha20poly1305_ietf_encrypt(reinterpret_cast<unsigned char *>(aeadPayload.data()),
-                                     &clen,
-                                     reinterpret_cast<const unsigned char *>(aePayloadBuffer.buffer().constData()), aePayloadBuffer.size(),
-                                     reinterpret_cast<const unsigned char *>(adPayloadBuffer.buffer().constData()), adPayloadBuffer.size(),
-                                     nullptr,
-                                     reinterpret_cast<const unsigned char *>(nonce.constData()),
-                                     reinterpret_cast<const unsigned char *>(transmitKey.constData()));
-                        if (result != 0) { return {}; }
-
-                        QBuffer packetBuffer;
-                        packetBuffer.open(QIODevice::WriteOnly);
-                        packetBuffer.write(reinterpret_cast<const char *>(&headerLength), sizeof(headerLength));
-                        packetBuffer.write(headerBuffer.buffer());
-                        packetBuffer.write(aeadPayload);
-                        packetBuffer.close();
-
-                        return packetBuffer.buffer();
-                    }
+                //! Serialize a DTO
+                template<typename T>
+                static QByteArray serialize(const QString &channelTag, CryptoDtoMode mode, const QByteArray &transmitKey, uint sequenceToBeSent, const T &dto)
+                {
+                    QByteArray packet;
+                    packet.reserve(MaxPacketSize);
+                    serialize(packet, channelTag, mode, transmitKey, sequenceToBeSent, dto);
+                    return packet;
+                }
 
-                    return {};
+                //! Serialize a DTO into a packet, next sequence of the channel
+                //! \return false if not encrypted, packet is empty then
+                template<typename T>
+                static bool serialize(QByteArray &packet, CCryptoDtoChannel &channel, CryptoDtoMode mode, const T &dto)
+                {
+                    uint sequenceToSend = 0;
+                    const QByteArray transmitKey = channel.getTransmitKey(mode, sequenceToSend);
+                    return serialize(packet, channel.getChannelTag(), mode, transmitKey, sequenceToSend, dto);
                 }
 
                 //! Serialize a DTO
                 template<typename T>
-                static QByteArray serialize(CCryptoDtoChannel &channel, CryptoDtoMode mode, T dto)
+                static QByteArray serialize(CCryptoDtoChannel &channel, CryptoDtoMode mode, const T &dto)
                 {
-                    uint sequenceToSend = 0;
-                    QByteArray transmitKey = channel.getTransmitKey(mode, sequenceToSend);
-                    return serialize(channel.getChannelTag(), mode, transmitKey, sequenceToSend++, dto);
+                    QByteArray packet;
+                    packet.reserve(MaxPacketSize);
+                    serialize(packet, channel, mode, dto);
+                    return packet;
                 }
 
                 //! Deserializer
-                struct Deserializer
+                //! \remark the packet is decrypted in place, name and data buffer refer to it and are valid as long as the packet is unchanged
+                struct BLACKCORE_EXPORT Deserializer
                 {
                     //! Ctor
-                    Deserializer(CCryptoDtoChannel &channel, const QByteArray &bytes, bool loopback);
+                    Deserializer(CCryptoDtoChannel &channel, QByteArray &bytes, bool loopback);
 
                     //! Get DTO
                     template<typename T>
@@ -133,7 +118,7 @@ namespace BlackCore
                         if (! m_verified) return {};
                         if (m_dtoNameBuffer == T::getDtoName() || m_dtoNameBuffer == T::getShortDtoName())
                         {
-                            msgpack::object_handle oh2 = msgpack::unpack(m_dataBuffer.data(), static_cast<std::size_t>(m_dataBuffer.size()));
+                            msgpack::object_handle oh2 = msgpack::unpack(m_dataBuffer.constData(), static_cast<std::size_t>(m_dataBuffer.size()));
                             msgpack::object obj = oh2.get();
                             T dto = obj.as<T>();
                             return dto;
@@ -143,27 +128,68 @@ namespace BlackCore
 
                     //! Header data
                     //! @{
-                    quint16 m_headerLength;
+                    quint16 m_headerLength = 0;
                     CryptoDtoHeaderDto m_header;
                     //! @}
 
                     //! Name data
                     //! @{
-                    quint16 m_dtoNameLength;
+                    quint16 m_dtoNameLength = 0;
                     QByteArray m_dtoNameBuffer;
                     //! @}
 
                     //! Data
                     //! @{
-                    quint16 m_dataLength;
+                    quint16 m_dataLength = 0;
                     QByteArray m_dataBuffer;
                     //! @}
 
                     bool m_verified = false; //!< is verified
+
+                private:
+                    //! Read a block with a 16 bit length, block refers to the data
+                    static bool readBlock(const char *&position, const char *end, quint16 &length, QByteArray &block);
                 };
 
-                //! Deserialize
-                static Deserializer deserialize(CCryptoDtoChannel &channel, const QByteArray &bytes, bool loopback);
+                //! Deserialize, decrypts the packet in place
+                static Deserializer deserialize(CCryptoDtoChannel &channel, QByteArray &bytes, bool loopback);
+
+            private:
+                //! Appends to a packet, stream for msgpack
+                class CPacketWriter
+                {
+                public:
+                    //! Ctor
+                    explicit CPacketWriter(QByteArray &packet) : m_packet(packet) {}
+
+                    //! Append data
+                    void write(const char *data, std::size_t size) { m_packet.append(data, static_cast<int>(size)); }
+
+                    //! Start a block with a 16 bit length, returns its position
+                    int beginBlock()
+                    {
+                        const quint16 length = 0;
+                        const int position = m_packet.size();
+                        this->write(reinterpret_cast<const char *>(&length), sizeof(length));
+                        return position;
+                    }
+
+                    //! Set the length of the block started at position
+                    void endBlock(int position)
+                    {
+                        const quint16 length = static_cast<quint16>(m_packet.size() - position - static_cast<int>(sizeof(quint16)));
+                        std::memcpy(m_packet.data() + position, &length, sizeof(length));
+                    }
+
+                private:
+                    QByteArray &m_packet;
+                };
+
+                //! Nonce of a sequence
+                static void makeNonce(uint64_t sequence, unsigned char *nonce);
+
+                //! Encrypt the payload of a packet in place and append the MAC
+                static bool encryptInPlace(QByteArray &packet, int payloadStart, uint64_t sequence, const QByteArray &key);
             };
         } // ns
     } // ns
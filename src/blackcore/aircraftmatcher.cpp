@@ -31,6 +31,7 @@
 #include <QtGlobal>
 #include <QPair>
 #include <QStringBuilder>
+#include <QThreadPool>
 #include <QJSEngine>
 
 using namespace BlackMisc;
@@ -40,6 +41,15 @@ using namespace BlackMisc::Simulation;
 
 namespace BlackCore
 {
+    namespace
+    {
+        //! The set index if it indexes exactly the given models, otherwise nullptr
+        const CAircraftModelSetIndex *indexFor(const CAircraftModelSetIndex *setIndex, const CAircraftModelList &models)
+        {
+            return setIndex && setIndex->isIndexOf(models) ? setIndex : nullptr;
+        }
+    }
+
     const CLogCategoryList &CAircraftMatcher::getLogCategories()
     {
         static const CLogCategoryList cats { CLogCategory::matching() };
@@ -54,6 +64,7 @@ namespace BlackCore
             const CAircraftCategoryList categories = sApp->getWebDataServices()->getAircraftCategories();
             m_categoryMatcher.setCategories(categories);
         }
+        this->updateModelSetIndexes();
     }
 
     CAircraftMatcher::CAircraftMatcher(QObject *parent) : CAircraftMatcher(CAircraftMatcherSetup(), parent)
@@ -68,6 +79,7 @@ namespace BlackCore
     {
         if (m_setup == setup) { return false; }
         m_setup = setup;
+        this->updateModelSetIndexes();
         emit this->setupChanged();
         return true;
     }
@@ -257,6 +269,8 @@ namespace BlackCore
     {
         CAircraftModelList modelSet(m_modelSet); // Models for this matching
         const CAircraftMatcherSetup setup = m_setup;
+        const QSharedPointer<const CAircraftModelSetIndex> modelSetIndex = m_modelSetIndex;
+        const QSharedPointer<const MatchingSet> matchingSet = m_matchingSet;
 
         static const QString format("hh:mm:ss.zzz");
         static const QString m1("--- Start matching: UTC %1 ---");
@@ -310,7 +324,7 @@ namespace BlackCore
             // try to find in installed models by model string
             if (setup.getMatchingMode().testFlag(CAircraftMatcherSetup::ByModelString))
             {
-                matchedModel = matchByExactModelString(remoteAircraft, modelSet, whatToLog, log);
+                matchedModel = matchByExactModelString(remoteAircraft, modelSet, modelSetIndex.data(), whatToLog, log);
                 if (matchedModel.hasModelString())
                 {
                     CMatchingUtils::addLogDetailsToList(log, remoteAircraft, u"Exact match by model string '" % matchedModel.getModelStringAndDbKey() % "'", getLogCategories(), CStatusMessage::SeverityError);
@@ -325,25 +339,21 @@ namespace BlackCore
 
         if (!resolvedInPrephase)
         {
-            // sanity
-            const int noString = modelSet.removeAllWithoutModelString();
+            // sanity and exclusion, already done when the set or the setup changed
+            const int noString = matchingSet->withoutModelString;
             static const QString noModelStr("Excluded %1 models without model string");
             if (noString > 0 && log) { CMatchingUtils::addLogDetailsToList(log, remoteAircraft, noModelStr.arg(noString)); }
 
-            // exclusion
-            if (setup.getMatchingMode().testFlag(CAircraftMatcherSetup::ExcludeNoDbData))
-            {
-                const int noDbKey = modelSet.removeObjectsWithoutDbKey();
-                static const QString excludedStr("Excluded %1 models without DB key");
-                if (noDbKey > 0 && log) { CMatchingUtils::addLogDetailsToList(log, remoteAircraft, excludedStr.arg(noDbKey)); }
-            }
+            const int noDbKey = matchingSet->withoutDbKey;
+            static const QString noDbKeyStr("Excluded %1 models without DB key");
+            if (noDbKey > 0 && log) { CMatchingUtils::addLogDetailsToList(log, remoteAircraft, noDbKeyStr.arg(noDbKey)); }
 
-            if (setup.getMatchingMode().testFlag(CAircraftMatcherSetup::ExcludeNoExcluded))
-            {
-                const int excluded = modelSet.removeIfExcluded();
-                static const QString excludedStr("Excluded %1 models marked 'Excluded'");
-                if (excluded > 0 && log) { CMatchingUtils::addLogDetailsToList(log, remoteAircraft, excludedStr.arg(excluded)); }
-            }
+            const int excluded = matchingSet->excluded;
+            static const QString excludedStr("Excluded %1 models marked 'Excluded'");
+            if (excluded > 0 && log) { CMatchingUtils::addLogDetailsToList(log, remoteAircraft, excludedStr.arg(excluded)); }
+
+            const CAircraftModelSetIndex *setIndex = matchingSet->index.data();
+            modelSet = setIndex->getModels();
 
             // Reduce by ICAO if the flag is set
             static const QString msInfo("Using '%1' with model set with %2 models");
@@ -354,21 +364,21 @@ namespace BlackCore
             switch (setup.getMatchingAlgorithm())
             {
             case CAircraftMatcherSetup::MatchingStepwiseReduce:
-                candidates = CAircraftMatcher::getClosestMatchStepwiseReduceImplementation(modelSet, setup, m_categoryMatcher, remoteAircraft, whatToLog, log);
+                candidates = CAircraftMatcher::getClosestMatchStepwiseReduceImplementation(modelSet, setIndex, setup, m_categoryMatcher, remoteAircraft, whatToLog, log);
                 break;
             case CAircraftMatcherSetup::MatchingScoreBased:
-                candidates = CAircraftMatcher::getClosestMatchScoreImplementation(modelSet, setup, remoteAircraft, maxScore, whatToLog, log);
+                candidates = CAircraftMatcher::getClosestMatchScoreImplementation(modelSet, setIndex, setup, remoteAircraft, maxScore, whatToLog, log);
                 break;
             case CAircraftMatcherSetup::MatchingStepwiseReducePlusScoreBased:
             default:
-                candidates = CAircraftMatcher::getClosestMatchStepwiseReduceImplementation(modelSet, setup, m_categoryMatcher, remoteAircraft, whatToLog, log);
-                candidates = CAircraftMatcher::getClosestMatchScoreImplementation(candidates, setup, remoteAircraft, maxScore, whatToLog, log);
+                candidates = CAircraftMatcher::getClosestMatchStepwiseReduceImplementation(modelSet, setIndex, setup, m_categoryMatcher, remoteAircraft, whatToLog, log);
+                candidates = CAircraftMatcher::getClosestMatchScoreImplementation(candidates, indexFor(setIndex, candidates), setup, remoteAircraft, maxScore, whatToLog, log);
                 break;
             }
 
             if (candidates.isEmpty())
             {
-                matchedModel = CAircraftMatcher::getCombinedTypeDefaultModel(modelSet, remoteAircraft, this->getDefaultModel(), whatToLog, log);
+                matchedModel = CAircraftMatcher::getCombinedTypeDefaultModel(modelSet, setIndex, remoteAircraft, this->getDefaultModel(), whatToLog, log);
             }
             else
             {
@@ -1297,6 +1307,7 @@ namespace BlackCore
         m_modelSet  = modelsCleaned;
         m_simulator = simulator;
         m_modelSetInfo = QStringLiteral("Set: '%1' entries: %2").arg(simulator.toQString()).arg(modelsCleaned.size());
+        this->updateModelSetIndexes();
         return models.size();
     }
 
@@ -1309,15 +1320,34 @@ namespace BlackCore
         }
         else
         {
-            this->restoreDisabledModels();
+            m_modelSet.replaceOrAddModelsWithString(m_disabledModels, Qt::CaseInsensitive);
             m_disabledModels = removedModels;
             m_modelSet.removeModelsWithString(removedModels, Qt::CaseInsensitive);
         }
+        this->updateModelSetIndexes();
     }
 
     void CAircraftMatcher::restoreDisabledModels()
     {
         m_modelSet.replaceOrAddModelsWithString(m_disabledModels, Qt::CaseInsensitive);
+        this->updateModelSetIndexes();
+    }
+
+    void CAircraftMatcher::updateModelSetIndexes()
+    {
+        m_modelSetIndex.reset(new CAircraftModelSetIndex(m_modelSet));
+
+        // filter once here instead of for every matching
+        const CAircraftMatcherSetup::MatchingMode mode = m_setup.getMatchingMode();
+        CAircraftModelList models(m_modelSet);
+        QSharedPointer<MatchingSet> matchingSet(new MatchingSet);
+        matchingSet->withoutModelString = models.removeAllWithoutModelString();
+        if (mode.testFlag(CAircraftMatcherSetup::ExcludeNoDbData))   { matchingSet->withoutDbKey = models.removeObjectsWithoutDbKey(); }
+        if (mode.testFlag(CAircraftMatcherSetup::ExcludeNoExcluded)) { matchingSet->excluded = models.removeIfExcluded(); }
+
+        const bool removed = matchingSet->withoutModelString > 0 || matchingSet->withoutDbKey > 0 || matchingSet->excluded > 0;
+        matchingSet->index = removed ? QSharedPointer<const CAircraftModelSetIndex>(new CAircraftModelSetIndex(models)) : m_modelSetIndex;
+        m_matchingSet = matchingSet;
     }
 
     void CAircraftMatcher::setDefaultModel(const CAircraftModel &defaultModel)
@@ -1394,7 +1424,7 @@ namespace BlackCore
         return CFileUtils::writeStringToFile(json, CFileUtils::appendFilePathsAndFixUnc(CSwiftDirectories::logDirectory(), QStringLiteral("removed models %1.json").arg(ts)));
     }
 
-    CAircraftModelList CAircraftMatcher::getClosestMatchStepwiseReduceImplementation(const CAircraftModelList &modelSet, const CAircraftMatcherSetup &setup, const CCategoryMatcher &categoryMatcher, const CSimulatedAircraft &remoteAircraft, MatchingLog whatToLog, CStatusMessageList *log)
+    CAircraftModelList CAircraftMatcher::getClosestMatchStepwiseReduceImplementation(const CAircraftModelList &modelSet, const CAircraftModelSetIndex *setIndex, const CAircraftMatcherSetup &setup, const CCategoryMatcher &categoryMatcher, const CSimulatedAircraft &remoteAircraft, MatchingLog whatToLog, CStatusMessageList *log)
     {
         CAircraftModelList matchedModels(modelSet);
         CAircraftModel matchedModel(remoteAircraft.getModel());
@@ -1408,7 +1438,7 @@ namespace BlackCore
             // by livery, then by ICAO
             if (mode.testFlag(CAircraftMatcherSetup::ByLivery))
             {
-                matchedModels = ifPossibleReduceByLiveryAndAircraftIcaoCode(remoteAircraft, matchedModels, reduced, log);
+                matchedModels = ifPossibleReduceByLiveryAndAircraftIcaoCode(remoteAircraft, matchedModels, setIndex, reduced, log);
                 if (reduced) { break; } // almost perfect, we stop here (we have ICAO + livery match)
             }
             else if (reduceLog)
@@ -1420,7 +1450,7 @@ namespace BlackCore
             {
                 // by airline/aircraft or by aircraft/airline depending on setup
                 // family is also considered
-                matchedModels = ifPossibleReduceByIcaoData(remoteAircraft, matchedModels, setup, reduced, log);
+                matchedModels = ifPossibleReduceByIcaoData(remoteAircraft, matchedModels, setIndex, setup, reduced, log);
             }
             else if (reduceLog)
             {
@@ -1430,7 +1460,7 @@ namespace BlackCore
                 if (mode.testFlag(CAircraftMatcherSetup::ByFamily))
                 {
                     QString usedFamily;
-                    matchedModels = ifPossibleReduceByFamily(remoteAircraft, UsePseudoFamily, matchedModels, reduced, usedFamily, log);
+                    matchedModels = ifPossibleReduceByFamily(remoteAircraft, UsePseudoFamily, matchedModels, setIndex, reduced, usedFamily, log);
                     if (reduced) { break; }
                 }
                 else if (reduceLog)
@@ -1450,9 +1480,10 @@ namespace BlackCore
             }
 
             // if not yet reduced, reduce to VTOL
-            if (!reduced && remoteAircraft.isVtol() && matchedModels.containsVtol() && mode.testFlag(CAircraftMatcherSetup::ByVtol))
+            const CAircraftModelSetIndex *vtolIndex = indexFor(setIndex, matchedModels);
+            if (!reduced && remoteAircraft.isVtol() && (vtolIndex ? vtolIndex->containsVtol() : matchedModels.containsVtol()) && mode.testFlag(CAircraftMatcherSetup::ByVtol))
             {
-                matchedModels = matchedModels.findByVtolFlag(true);
+                matchedModels = vtolIndex ? vtolIndex->findByVtolFlag(true) : matchedModels.findByVtolFlag(true);
                 CMatchingUtils::addLogDetailsToList(log, remoteAircraft, QStringLiteral("Aircraft is VTOL, reduced to VTOL"), getLogCategories());
             }
 
@@ -1460,20 +1491,20 @@ namespace BlackCore
             bool milFlagReduced = false;
             if (mode.testFlag(CAircraftMatcherSetup::ByMilitary) && remoteAircraft.isMilitary())
             {
-                matchedModels = ifPossibleReduceByMilitaryFlag(remoteAircraft, matchedModels, reduced, reduceLog);
+                matchedModels = ifPossibleReduceByMilitaryFlag(remoteAircraft, matchedModels, setIndex, reduced, reduceLog);
                 milFlagReduced = true;
             }
 
             if (!milFlagReduced && mode.testFlag(CAircraftMatcherSetup::ByCivilian) && !remoteAircraft.isMilitary())
             {
-                matchedModels = ifPossibleReduceByMilitaryFlag(remoteAircraft, matchedModels, reduced, reduceLog);
+                matchedModels = ifPossibleReduceByMilitaryFlag(remoteAircraft, matchedModels, setIndex, reduced, reduceLog);
                 milFlagReduced = true;
             }
 
             // combined code
             if (mode.testFlag(CAircraftMatcherSetup::ByCombinedType))
             {
-                matchedModels = ifPossibleReduceByCombinedType(remoteAircraft, matchedModels, setup, reduced, reduceLog);
+                matchedModels = ifPossibleReduceByCombinedType(remoteAircraft, matchedModels, setIndex, setup, reduced, reduceLog);
                 if (reduced) { break; }
             }
             else if (log)
@@ -1486,34 +1517,34 @@ namespace BlackCore
         // here we have a list of possible models, we reduce/refine further
         if (matchedModels.size() > 1 && mode.testFlag(CAircraftMatcherSetup::ByManufacturer))
         {
-            matchedModels = ifPossibleReduceByManufacturer(remoteAircraft, matchedModels, QStringLiteral("2nd trial to reduce by manufacturer. "), reduced, reduceLog);
+            matchedModels = ifPossibleReduceByManufacturer(remoteAircraft, matchedModels, setIndex, QStringLiteral("2nd trial to reduce by manufacturer. "), reduced, reduceLog);
         }
 
         return matchedModels;
     }
 
-    CAircraftModelList CAircraftMatcher::getClosestMatchScoreImplementation(const CAircraftModelList &modelSet, const CAircraftMatcherSetup &setup, const CSimulatedAircraft &remoteAircraft, int &maxScore, MatchingLog whatToLog, CStatusMessageList *log)
+    CAircraftModelList CAircraftMatcher::getClosestMatchScoreImplementation(const CAircraftModelList &modelSet, const CAircraftModelSetIndex *setIndex, const CAircraftMatcherSetup &setup, const CSimulatedAircraft &remoteAircraft, int &maxScore, MatchingLog whatToLog, CStatusMessageList *log)
     {
         CAircraftMatcherSetup::MatchingMode mode = setup.getMatchingMode();
         const bool noZeroScores = mode.testFlag(CAircraftMatcherSetup::ScoreIgnoreZeros);
         const bool preferColorLiveries = mode.testFlag(CAircraftMatcherSetup::ScorePreferColorLiveries);
         CStatusMessageList *scoreLog = log && whatToLog.testFlag(MatchingLogScoring) ? log : nullptr;
 
-        // VTOL
-        ScoredModels map;
-        map = modelSet.scoreFull(remoteAircraft.getModel(), preferColorLiveries, noZeroScores, scoreLog);
-
-        CAircraftModel matchedModel;
-        if (map.isEmpty()) { return CAircraftModelList(); }
-
-        maxScore = map.lastKey();
-        const CAircraftModelList maxScoreAircraft(map.values(maxScore));
-        CMatchingUtils::addLogDetailsToList(scoreLog, remoteAircraft, QStringLiteral("Scores: %1").arg(scoresToString(map)), getLogCategories());
-        CMatchingUtils::addLogDetailsToList(log, remoteAircraft, QStringLiteral("Scoring with score %1 out of %2 models yielded %3 models").arg(maxScore).arg(map.size()).arg(maxScoreAircraft.size()), getLogCategories());
+        // only the best scores are kept, with the set index models which cannot win are skipped
+        CAircraftModelScoring scoring;
+        scoring.score(modelSet, indexFor(setIndex, modelSet), remoteAircraft.getModel(), preferColorLiveries, noZeroScores, QThreadPool::globalInstance(), scoreLog);
+        if (scoring.isEmpty()) { return CAircraftModelList(); }
+
+        maxScore = scoring.getMaxScore();
+        const CAircraftModelList maxScoreAircraft(scoring.getMaxScoreModels());
+        CMatchingUtils::addLogDetailsToList(scoreLog, remoteAircraft, QStringLiteral("Scores: %1").arg(scoresToString(scoring)), getLogCategories());
+        QString scored = QStringLiteral("Scoring with score %1 out of %2 models yielded %3 models").arg(maxScore).arg(scoring.getScoredCount()).arg(maxScoreAircraft.size());
+        if (scoring.getSkippedCount() > 0) { scored += QStringLiteral(", %1 models skipped").arg(scoring.getSkippedCount()); }
+        CMatchingUtils::addLogDetailsToList(log, remoteAircraft, scored, getLogCategories());
         return maxScoreAircraft;
     }
 
-    CAircraftModel CAircraftMatcher::getCombinedTypeDefaultModel(const CAircraftModelList &modelSet, const CSimulatedAircraft &remoteAircraft, const CAircraftModel &defaultModel, MatchingLog whatToLog, CStatusMessageList *log)
+    CAircraftModel CAircraftMatcher::getCombinedTypeDefaultModel(const CAircraftModelList &modelSet, const CAircraftModelSetIndex *setIndex, const CSimulatedAircraft &remoteAircraft, const CAircraftModel &defaultModel, MatchingLog whatToLog, CStatusMessageList *log)
     {
         const QString combinedType = remoteAircraft.getAircraftIcaoCombinedType();
         CStatusMessageList *combinedLog = log && whatToLog.testFlag(MatchingLogCombinedDefaultType) ? log : nullptr;
@@ -1530,7 +1561,8 @@ namespace BlackCore
         }
 
         CMatchingUtils::addLogDetailsToList(combinedLog, remoteAircraft, u"Searching by combined type with color livery '" % combinedType % "'", getLogCategories());
-        CAircraftModelList matchedModels = modelSet.findByCombinedTypeWithColorLivery(combinedType);
+        const CAircraftModelSetIndex *index = indexFor(setIndex, modelSet);
+        CAircraftModelList matchedModels = index ? index->findByCombinedTypeWithColorLivery(combinedType) : modelSet.findByCombinedTypeWithColorLivery(combinedType);
         if (!matchedModels.isEmpty())
         {
             CMatchingUtils::addLogDetailsToList(combinedLog, remoteAircraft, u"Found " % QString::number(matchedModels.size()) % u" by combined type w/color livery '" % combinedType % "'", getLogCategories());
@@ -1550,7 +1582,7 @@ namespace BlackCore
         return matchedModels.front();
     }
 
-    CAircraftModel CAircraftMatcher::matchByExactModelString(const CSimulatedAircraft &remoteAircraft, const CAircraftModelList &models, MatchingLog whatToLog, CStatusMessageList *log)
+    CAircraftModel CAircraftMatcher::matchByExactModelString(const CSimulatedAircraft &remoteAircraft, const CAircraftModelList &models, const CAircraftModelSetIndex *setIndex, MatchingLog whatToLog, CStatusMessageList *log)
     {
         CStatusMessageList *msLog = log && whatToLog.testFlag(MatchingLogModelstring) ? log : nullptr;
         if (remoteAircraft.getModelString().isEmpty())
@@ -1559,7 +1591,10 @@ namespace BlackCore
             return CAircraftModel();
         }
 
-        CAircraftModel model = models.findFirstByModelStringAliasOrDefault(remoteAircraft.getModelString());
+        const CAircraftModelSetIndex *index = indexFor(setIndex, models);
+        CAircraftModel model = index ?
+                               index->findFirstByModelStringAliasOrDefault(remoteAircraft.getModelString()) :
+                               models.findFirstByModelStringAliasOrDefault(remoteAircraft.getModelString());
         if (msLog)
         {
             if (model.hasModelString())
@@ -1576,7 +1611,7 @@ namespace BlackCore
         return model;
     }
 
-    CAircraftModelList CAircraftMatcher::ifPossibleReduceByLiveryAndAircraftIcaoCode(const CSimulatedAircraft &remoteAircraft, const CAircraftModelList &inList, bool &reduced, CStatusMessageList *log)
+    CAircraftModelList CAircraftMatcher::ifPossibleReduceByLiveryAndAircraftIcaoCode(const CSimulatedAircraft &remoteAircraft, const CAircraftModelList &inList, const CAircraftModelSetIndex *setIndex, bool &reduced, CStatusMessageList *log)
     {
         reduced = false;
         if (!remoteAircraft.getLivery().hasCombinedCode())
@@ -1585,11 +1620,15 @@ namespace BlackCore
             return inList;
         }
 
-        const CAircraftModelList byLivery(
-            inList.findByAircraftDesignatorAndLiveryCombinedCode(
-                remoteAircraft.getLivery().getCombinedCode(),
-                remoteAircraft.getAircraftIcaoCodeDesignator()
-            ));
+        const CAircraftModelSetIndex *index = indexFor(setIndex, inList);
+        const CAircraftModelList byLivery(index ?
+                                          index->findByAircraftDesignatorAndLiveryCombinedCode(
+                                              remoteAircraft.getLivery().getCombinedCode(),
+                                              remoteAircraft.getAircraftIcaoCodeDesignator()) :
+                                          inList.findByAircraftDesignatorAndLiveryCombinedCode(
+                                              remoteAircraft.getLivery().getCombinedCode(),
+                                              remoteAircraft.getAircraftIcaoCodeDesignator()
+                                          ));
 
         if (byLivery.isEmpty())
         {
@@ -1600,7 +1639,7 @@ namespace BlackCore
         return byLivery;
     }
 
-    CAircraftModelList CAircraftMatcher::ifPossibleReduceByIcaoData(const CSimulatedAircraft &remoteAircraft, const CAircraftModelList &inList, const CAircraftMatcherSetup &setup, bool &reduced, CStatusMessageList *log)
+    CAircraftModelList CAircraftMatcher::ifPossibleReduceByIcaoData(const CSimulatedAircraft &remoteAircraft, const CAircraftModelList &inList, const CAircraftModelSetIndex *setIndex, const CAircraftMatcherSetup &setup, bool &reduced, CStatusMessageList *log)
     {
         const CAircraftMatcherSetup::MatchingMode mode = setup.getMatchingMode();
         if (inList.isEmpty())
@@ -1614,8 +1653,8 @@ namespace BlackCore
         {
             bool r1 = false;
             bool r2 = false;
-            CAircraftModelList models = ifPossibleReduceByAirline(remoteAircraft, inList, setup, QStringLiteral("Reduce by airline first."), r1, log);
-            models = ifPossibleReduceByAircraftOrFamily(remoteAircraft, UsePseudoFamily, models, setup, QStringLiteral("Reduce by aircraft ICAO second."), r2, log);
+            CAircraftModelList models = ifPossibleReduceByAirline(remoteAircraft, inList, setIndex, setup, QStringLiteral("Reduce by airline first."), r1, log);
+            models = ifPossibleReduceByAircraftOrFamily(remoteAircraft, UsePseudoFamily, models, setIndex, setup, QStringLiteral("Reduce by aircraft ICAO second."), r2, log);
             reduced = r1 || r2;
             if (reduced) { return models; }
         }
@@ -1623,8 +1662,8 @@ namespace BlackCore
         {
             bool r1 = false;
             bool r2 = false;
-            CAircraftModelList models = ifPossibleReduceByAircraftOrFamily(remoteAircraft, UsePseudoFamily, inList, setup, QStringLiteral("Reduce by aircraft ICAO first."), r1, log);
-            models = ifPossibleReduceByAirline(remoteAircraft, models, setup, QStringLiteral("Reduce aircraft ICAO by airline second."), r2, log);
+            CAircraftModelList models = ifPossibleReduceByAircraftOrFamily(remoteAircraft, UsePseudoFamily, inList, setIndex, setup, QStringLiteral("Reduce by aircraft ICAO first."), r1, log);
+            models = ifPossibleReduceByAirline(remoteAircraft, models, setIndex, setup, QStringLiteral("Reduce aircraft ICAO by airline second."), r2, log);
 
             // not finding anything so far means we have no valid aircraft/airline ICAO combination
             // but it can happen we found B738, and for DLH there is no B738 but B737, so we search again
@@ -1638,8 +1677,8 @@ namespace BlackCore
 
                 bool r3 = false;
                 QString usedFamily;
-                CAircraftModelList models2nd = ifPossibleReduceByFamily(remoteAircraft, UsePseudoFamily, inList, r3, usedFamily, log);
-                models2nd = ifPossibleReduceByAirline(remoteAircraft, models2nd, setup, "Reduce family by airline second.", r3, log);
+                CAircraftModelList models2nd = ifPossibleReduceByFamily(remoteAircraft, UsePseudoFamily, inList, setIndex, r3, usedFamily, log);
+                models2nd = ifPossibleReduceByAirline(remoteAircraft, models2nd, setIndex, setup, "Reduce family by airline second.", r3, log);
                 if (r3)
                 {
                     // we found family / airline combination
@@ -1660,22 +1699,22 @@ namespace BlackCore
         return inList;
     }
 
-    CAircraftModelList CAircraftMatcher::ifPossibleReduceByFamily(const CSimulatedAircraft &remoteAircraft, bool allowPseudoFamily, const CAircraftModelList &inList, bool &reduced, QString &usedFamily, CStatusMessageList *log)
+    CAircraftModelList CAircraftMatcher::ifPossibleReduceByFamily(const CSimulatedAircraft &remoteAircraft, bool allowPseudoFamily, const CAircraftModelList &inList, const CAircraftModelSetIndex *setIndex, bool &reduced, QString &usedFamily, CStatusMessageList *log)
     {
         reduced = false;
         usedFamily = remoteAircraft.getAircraftIcaoCode().getFamily();
         if (!usedFamily.isEmpty())
         {
-            CAircraftModelList matchedModels = ifPossibleReduceByFamily(remoteAircraft, usedFamily, allowPseudoFamily, inList, QStringLiteral("real family from ICAO"), reduced, log);
+            CAircraftModelList matchedModels = ifPossibleReduceByFamily(remoteAircraft, usedFamily, allowPseudoFamily, inList, setIndex, QStringLiteral("real family from ICAO"), reduced, log);
             if (reduced) { return matchedModels; }
         }
 
         // scenario: the ICAO actually is the family
         usedFamily = remoteAircraft.getAircraftIcaoCodeDesignator();
-        return ifPossibleReduceByFamily(remoteAircraft, usedFamily, allowPseudoFamily, inList, QStringLiteral("ICAO treated as family"), reduced, log);
+        return ifPossibleReduceByFamily(remoteAircraft, usedFamily, allowPseudoFamily, inList, setIndex, QStringLiteral("ICAO treated as family"), reduced, log);
     }
 
-    CAircraftModelList CAircraftMatcher::ifPossibleReduceByFamily(const CSimulatedAircraft &remoteAircraft, const QString &family, bool allowPseudoFamily, const CAircraftModelList &inList, const QString &hint, bool &reduced, CStatusMessageList *log)
+    CAircraftModelList CAircraftMatcher::ifPossibleReduceByFamily(const CSimulatedAircraft &remoteAircraft, const QString &family, bool allowPseudoFamily, const CAircraftModelList &inList, const CAircraftModelSetIndex *setIndex, const QString &hint, bool &reduced, CStatusMessageList *log)
     {
         // Use an algorithm to find the best match
         reduced = false;
@@ -1691,7 +1730,8 @@ namespace BlackCore
             return inList;
         }
 
-        CAircraftModelList foundByFamily(inList.findByFamily(family));
+        const CAircraftModelSetIndex *index = indexFor(setIndex, inList);
+        CAircraftModelList foundByFamily(index ? index->findByFamily(family) : inList.findByFamily(family));
         if (foundByFamily.isEmpty())
         {
             if (log) { CMatchingUtils::addLogDetailsToList(log, remoteAircraft, u"Not found by family '" % family % u"' (" % hint % ")"); }
@@ -1706,7 +1746,9 @@ namespace BlackCore
         CAircraftModelList foundByCM;
         if (allowPseudoFamily)
         {
-            foundByCM = inList.findByCombinedAndManufacturer(remoteAircraft.getAircraftIcaoCode());
+            foundByCM = index ?
+                        index->findByCombinedAndManufacturer(remoteAircraft.getAircraftIcaoCode()) :
+                        inList.findByCombinedAndManufacturer(remoteAircraft.getAircraftIcaoCode());
             const QString pseudo = remoteAircraft.getAircraftIcaoCode().getCombinedType() % "/" % remoteAircraft.getAircraftIcaoCode().getManufacturer();
             if (foundByCM.isEmpty())
             {
@@ -1729,7 +1771,7 @@ namespace BlackCore
         return foundByFamily;
     }
 
-    CAircraftModelList CAircraftMatcher::ifPossibleReduceByManufacturer(const CSimulatedAircraft &remoteAircraft, const CAircraftModelList &inList, const QString &info, bool &reduced, CStatusMessageList *log)
+    CAircraftModelList CAircraftMatcher::ifPossibleReduceByManufacturer(const CSimulatedAircraft &remoteAircraft, const CAircraftModelList &inList, const CAircraftModelSetIndex *setIndex, const QString &info, bool &reduced, CStatusMessageList *log)
     {
         reduced = false;
         if (inList.isEmpty())
@@ -1745,7 +1787,8 @@ namespace BlackCore
             return inList;
         }
 
-        const CAircraftModelList outList(inList.findByManufacturer(m));
+        const CAircraftModelSetIndex *index = indexFor(setIndex, inList);
+        const CAircraftModelList outList(index ? index->findByManufacturer(m) : inList.findByManufacturer(m));
         if (outList.isEmpty())
         {
             if (log) { CMatchingUtils::addLogDetailsToList(log, remoteAircraft, info % u" Not found '" % m % u"', cannot reduce", getLogCategories()); }
@@ -1785,7 +1828,7 @@ namespace BlackCore
         return outList;
     }
 
-    CAircraftModelList CAircraftMatcher::ifPossibleReduceByAircraft(const CSimulatedAircraft &remoteAircraft, const CAircraftModelList &inList, const QString &info, bool &reduced, CStatusMessageList *log)
+    CAircraftModelList CAircraftMatcher::ifPossibleReduceByAircraft(const CSimulatedAircraft &remoteAircraft, const CAircraftModelList &inList, const CAircraftModelSetIndex *setIndex, const QString &info, bool &reduced, CStatusMessageList *log)
     {
         reduced = false;
         if (inList.isEmpty())
@@ -1800,7 +1843,10 @@ namespace BlackCore
             return inList;
         }
 
-        const CAircraftModelList outList(inList.findByIcaoDesignators(remoteAircraft.getAircraftIcaoCode(), CAirlineIcaoCode::null()));
+        const CAircraftModelSetIndex *index = indexFor(setIndex, inList);
+        const CAircraftModelList outList(index ?
+                                         index->findByIcaoDesignators(remoteAircraft.getAircraftIcaoCode(), CAirlineIcaoCode::null()) :
+                                         inList.findByIcaoDesignators(remoteAircraft.getAircraftIcaoCode(), CAirlineIcaoCode::null()));
         if (outList.isEmpty())
         {
             if (log) { CMatchingUtils::addLogDetailsToList(log, remoteAircraft, info % u" Cannot reduce by '" % remoteAircraft.getAircraftIcaoCodeDesignator() % u"' results: " % QString::number(outList.size()), getLogCategories()); }
@@ -1812,16 +1858,16 @@ namespace BlackCore
         return outList;
     }
 
-    CAircraftModelList CAircraftMatcher::ifPossibleReduceByAircraftOrFamily(const CSimulatedAircraft &remoteAircraft, bool allowPseudoFamily, const CAircraftModelList &inList,  const CAircraftMatcherSetup &setup, const QString &info, bool &reduced, CStatusMessageList *log)
+    CAircraftModelList CAircraftMatcher::ifPossibleReduceByAircraftOrFamily(const CSimulatedAircraft &remoteAircraft, bool allowPseudoFamily, const CAircraftModelList &inList, const CAircraftModelSetIndex *setIndex, const CAircraftMatcherSetup &setup, const QString &info, bool &reduced, CStatusMessageList *log)
     {
         reduced = false;
-        const CAircraftModelList outList = ifPossibleReduceByAircraft(remoteAircraft, inList, info, reduced, log);
+        const CAircraftModelList outList = ifPossibleReduceByAircraft(remoteAircraft, inList, setIndex, info, reduced, log);
         if (reduced || !setup.getMatchingMode().testFlag(CAircraftMatcherSetup::ByFamily)) { return outList; }
         QString family;
-        return ifPossibleReduceByFamily(remoteAircraft, allowPseudoFamily, inList, reduced, family, log);
+        return ifPossibleReduceByFamily(remoteAircraft, allowPseudoFamily, inList, setIndex, reduced, family, log);
     }
 
-    CAircraftModelList CAircraftMatcher::ifPossibleReduceByAirline(const CSimulatedAircraft &remoteAircraft, const CAircraftModelList &inList, const CAircraftMatcherSetup &setup, const QString &info, bool &reduced, CStatusMessageList *log)
+    CAircraftModelList CAircraftMatcher::ifPossibleReduceByAirline(const CSimulatedAircraft &remoteAircraft, const CAircraftModelList &inList, const CAircraftModelSetIndex *setIndex, const CAircraftMatcherSetup &setup, const QString &info, bool &reduced, CStatusMessageList *log)
     {
         reduced = false;
         if (inList.isEmpty())
@@ -1837,14 +1883,19 @@ namespace BlackCore
         }
 
         CAircraftMatcherSetup::MatchingMode mode = setup.getMatchingMode();
-        CAircraftModelList outList(inList.findByIcaoDesignators(CAircraftIcaoCode::null(), remoteAircraft.getAirlineIcaoCode()));
+        const CAircraftModelSetIndex *index = indexFor(setIndex, inList);
+        CAircraftModelList outList(index ?
+                                   index->findByIcaoDesignators(CAircraftIcaoCode::null(), remoteAircraft.getAirlineIcaoCode()) :
+                                   inList.findByIcaoDesignators(CAircraftIcaoCode::null(), remoteAircraft.getAirlineIcaoCode()));
         if (
             mode.testFlag(CAircraftMatcherSetup::ByAirlineGroupSameAsAirline) ||
             (outList.isEmpty() || mode.testFlag(CAircraftMatcherSetup::ByAirlineGroupIfNoAirline)))
         {
             if (remoteAircraft.getAirlineIcaoCode().hasGroupMembership())
             {
-                const CAircraftModelList groupModels = inList.findByAirlineGroup(remoteAircraft.getAirlineIcaoCode());
+                const CAircraftModelList groupModels = index ?
+                                                       index->findByAirlineGroup(remoteAircraft.getAirlineIcaoCode()) :
+                                                       inList.findByAirlineGroup(remoteAircraft.getAirlineIcaoCode());
                 outList.replaceOrAddModelsWithString(groupModels, Qt::CaseInsensitive);
                 if (log)
                 {
@@ -1922,7 +1973,7 @@ namespace BlackCore
         **/
     }
 
-    CAircraftModelList CAircraftMatcher::ifPossibleReduceByCombinedType(const CSimulatedAircraft &remoteAircraft, const CAircraftModelList &inList, const CAircraftMatcherSetup &setup, bool &reduced, CStatusMessageList *log)
+    CAircraftModelList CAircraftMatcher::ifPossibleReduceByCombinedType(const CSimulatedAircraft &remoteAircraft, const CAircraftModelList &inList, const CAircraftModelSetIndex *setIndex, const CAircraftMatcherSetup &setup, bool &reduced, CStatusMessageList *log)
     {
         reduced = false;
         if (!remoteAircraft.getAircraftIcaoCode().hasValidCombinedType())
@@ -1932,7 +1983,8 @@ namespace BlackCore
         }
 
         const QString cc = remoteAircraft.getAircraftIcaoCode().getCombinedType();
-        CAircraftModelList modelsByCombinedCode(inList.findByCombinedType(cc));
+        const CAircraftModelSetIndex *index = indexFor(setIndex, inList);
+        CAircraftModelList modelsByCombinedCode(index ? index->findByCombinedType(cc) : inList.findByCombinedType(cc));
         if (modelsByCombinedCode.isEmpty())
         {
             if (log) { CMatchingUtils::addLogDetailsToList(log, remoteAircraft, u"Not found by combined code " % cc, getLogCategories()); }
@@ -1942,18 +1994,19 @@ namespace BlackCore
         if (log) { CMatchingUtils::addLogDetailsToList(log, remoteAircraft, u"Found by combined code " % cc % u", possible " % QString::number(modelsByCombinedCode.size()), getLogCategories()); }
         if (modelsByCombinedCode.size() > 1)
         {
-            modelsByCombinedCode = ifPossibleReduceByAirline(remoteAircraft, modelsByCombinedCode, setup, QStringLiteral("Combined code airline reduction. "), reduced, log);
-            modelsByCombinedCode = ifPossibleReduceByManufacturer(remoteAircraft, modelsByCombinedCode, QStringLiteral("Combined code manufacturer reduction. "), reduced, log);
+            modelsByCombinedCode = ifPossibleReduceByAirline(remoteAircraft, modelsByCombinedCode, setIndex, setup, QStringLiteral("Combined code airline reduction. "), reduced, log);
+            modelsByCombinedCode = ifPossibleReduceByManufacturer(remoteAircraft, modelsByCombinedCode, setIndex, QStringLiteral("Combined code manufacturer reduction. "), reduced, log);
             reduced = true;
         }
         return modelsByCombinedCode;
     }
 
-    CAircraftModelList CAircraftMatcher::ifPossibleReduceByMilitaryFlag(const CSimulatedAircraft &remoteAircraft, const CAircraftModelList &inList, bool &reduced, CStatusMessageList *log)
+    CAircraftModelList CAircraftMatcher::ifPossibleReduceByMilitaryFlag(const CSimulatedAircraft &remoteAircraft, const CAircraftModelList &inList, const CAircraftModelSetIndex *setIndex, bool &reduced, CStatusMessageList *log)
     {
         reduced = false;
         const bool military = remoteAircraft.getModel().isMilitary();
-        const CAircraftModelList byMilitaryFlag(inList.findByMilitaryFlag(military));
+        const CAircraftModelSetIndex *index = indexFor(setIndex, inList);
+        const CAircraftModelList byMilitaryFlag(index ? index->findByMilitaryFlag(military) : inList.findByMilitaryFlag(military));
         const QString mil(military ? "military" : "civilian");
         if (byMilitaryFlag.isEmpty())
         {
@@ -1978,21 +2031,19 @@ namespace BlackCore
         return vtolModels;
     }
 
-    QString CAircraftMatcher::scoresToString(const ScoredModels &scores, int lastElements)
+    QString CAircraftMatcher::scoresToString(const CAircraftModelScoring &scoring, int lastElements)
     {
-        if (scores.isEmpty()) { return {}; }
-        QMapIterator<int, CAircraftModel> i(scores);
-        i.toBack();
+        if (scoring.isEmpty()) { return {}; }
         int c = 0;
         QString str;
-        while (i.hasPrevious() && c++ < lastElements)
+        for (const CAircraftModelScoring::ScoredPosition &scored : scoring.getTopScores())
         {
-            i.previous();
-            const CAircraftModel m(i.value());
+            if (c++ >= lastElements) { break; }
+            const CAircraftModel &m = scoring.getModel(scored.position);
             if (!str.isEmpty()) { str += '\n'; }
             str += QString::number(c) %
                    u": score: " %
-                   QString::number(i.key()) %
+                   QString::number(scored.score) %
                    u" model: '" %
                    m.getModelString() %
                    u"' aircraft: '" %
@@ -61,6 +61,8 @@ namespace BlackCore
         // network situations
         c = connect(fsdClient, &CFSDClient::pilotDataUpdateReceived, this, &CAirspaceAnalyzer::onNetworkPositionUpdate, Qt::QueuedConnection);
         Q_ASSERT(c);
+        c = connect(fsdClient, &CFSDClient::pilotDataUpdatesReceived, this, &CAirspaceAnalyzer::onNetworkPositionUpdates, Qt::QueuedConnection);
+        Q_ASSERT(c);
         c = connect(fsdClient, &CFSDClient::atcDataUpdateReceived, this, &CAirspaceAnalyzer::watchdogTouchAtcCallsign, Qt::QueuedConnection);
         Q_ASSERT(c);
 
@@ -103,6 +105,18 @@ namespace BlackCore
         this->watchdogTouchAircraftCallsign(situation);
     }
 
+    void CAirspaceAnalyzer::onNetworkPositionUpdates(const CAircraftSituationList &situations, const QVector<CTransponder> &transponders)
+    {
+        Q_UNUSED(transponders)
+        const qint64 now = QDateTime::currentMSecsSinceEpoch();
+        for (const CAircraftSituation &situation : situations)
+        {
+            const CCallsign cs = situation.getCallsign();
+            Q_ASSERT_X(!cs.isEmpty(), Q_FUNC_INFO, "No callsign in situaton");
+            m_aircraftCallsignTimestamps[cs] = now;
+        }
+    }
+
     void CAirspaceAnalyzer::onChangedAtcStationOnlineConnectionStatus(const CAtcStation &station, bool isConnected)
     {
         const CCallsign cs = station.getCallsign();
@@ -114,7 +114,10 @@ namespace BlackCore
         void onConnectionStatusChanged(BlackMisc::Network::CConnectionStatus oldStatus, BlackMisc::Network::CConnectionStatus newStatus);
 
         //! Network position update
+        //! @{
         void onNetworkPositionUpdate(const BlackMisc::Aviation::CAircraftSituation &situation, const BlackMisc::Aviation::CTransponder &transponder);
+        void onNetworkPositionUpdates(const BlackMisc::Aviation::CAircraftSituationList &situations, const QVector<BlackMisc::Aviation::CTransponder> &transponders);
+        //! @}
 
         //! ATC stations online
         void onChangedAtcStationOnlineConnectionStatus(const BlackMisc::Aviation::CAtcStation &station, bool isConnected);
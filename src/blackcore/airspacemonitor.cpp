@@ -17,6 +17,7 @@
 #include "blackcore/fsd/fsdclient.h"
 #include "blackmisc/aviation/aircraftparts.h"
 #include "blackmisc/aviation/aircraftsituation.h"
+#include "blackmisc/aviation/callsigninterner.h"
 #include "blackmisc/aviation/comsystem.h"
 #include "blackmisc/aviation/modulator.h"
 #include "blackmisc/aviation/transponder.h"
@@ -43,9 +44,11 @@
 #include <QDateTime>
 #include <QEventLoop>
 #include <QReadLocker>
+#include <QSet>
 #include <QThread>
 #include <QTime>
 #include <QVariant>
+#include <QVector>
 #include <QWriteLocker>
 #include <Qt>
 
@@ -86,6 +89,8 @@ namespace BlackCore
         connect(m_fsdClient, &CFSDClient::deleteAtcReceived,               this, &CAirspaceMonitor::onAtcControllerDisconnected);
         connect(m_fsdClient, &CFSDClient::pilotDataUpdateReceived,         this, &CAirspaceMonitor::onAircraftUpdateReceived);
         connect(m_fsdClient, &CFSDClient::interimPilotDataUpdatedReceived, this, &CAirspaceMonitor::onAircraftInterimUpdateReceived);
+        connect(m_fsdClient, &CFSDClient::pilotDataUpdatesReceived,        this, &CAirspaceMonitor::onAircraftUpdatesReceived);
+        connect(m_fsdClient, &CFSDClient::interimPilotDataUpdatesReceived, this, &CAirspaceMonitor::onAircraftInterimUpdatesReceived);
         connect(m_fsdClient, &CFSDClient::com1FrequencyResponseReceived,   this, &CAirspaceMonitor::onFrequencyReceived);
         connect(m_fsdClient, &CFSDClient::capabilityResponseReceived,      this, &CAirspaceMonitor::onCapabilitiesReplyReceived);
         connect(m_fsdClient, &CFSDClient::planeInformationFsinnReceived,   this, &CAirspaceMonitor::onCustomFSInnPacketReceived);
@@ -1216,98 +1221,162 @@ namespace BlackCore
     }
 
     void CAirspaceMonitor::onAircraftUpdateReceived(const CAircraftSituation &situation, const CTransponder &transponder)
+    {
+        CAircraftSituationList situations;
+        situations.push_back(situation);
+        this->onAircraftUpdatesReceived(situations, { transponder });
+    }
+
+    void CAirspaceMonitor::onAircraftUpdatesReceived(const CAircraftSituationList &situations, const QVector<CTransponder> &transponders)
     {
         Q_ASSERT_X(CThreadUtils::isInThisThread(this), Q_FUNC_INFO, "Called in different thread");
+        Q_ASSERT_X(situations.sizeInt() == transponders.size(), Q_FUNC_INFO, "Situations and transponders do not match");
         if (!this->isConnectedAndNotShuttingDown()) { return; }
 
-        const CCallsign callsign(situation.getCallsign());
-        Q_ASSERT_X(!callsign.isEmpty(), Q_FUNC_INFO, "Empty callsign");
+        const int count = situations.sizeInt();
+        for (int begin = 0; begin < count;)
+        {
+            // a NEW aircraft has to be added before its next situation is handled
+            const int end = endOfUniqueCallsigns(situations, begin);
 
-        if (this->isCopilotAircraft(callsign)) { return; }
+            CAircraftSituationList situationsToStore;
+            QVector<int> indexes;
+            QVector<bool> existsInRange;
+            for (int i = begin; i < end; ++i)
+            {
+                const CAircraftSituation &situation = situations[i];
+                const CCallsign callsign(situation.getCallsign());
+                Q_ASSERT_X(!callsign.isEmpty(), Q_FUNC_INFO, "Empty callsign");
 
-        // range (FSD overload issue)
-        const bool validMaxRange = this->handleMaxRange(situation);
-        const bool existsInRange = this->isAircraftInRange(callsign); // AFTER valid max.range check!
-        if (!validMaxRange && !existsInRange) { return; } // not valid at all
+                if (this->isCopilotAircraft(callsign)) { continue; }
 
-        // update client info
-        this->autoAdjustCientGndCapability(situation);
+                // range (FSD overload issue)
+                const bool validMaxRange = this->handleMaxRange(situation);
+                const bool exists = this->isAircraftInRange(callsign); // AFTER valid max.range check!
+                if (!validMaxRange && !exists) { continue; } // not valid at all
 
-        // store situation history
-        this->storeAircraftSituation(situation); // updates situation
+                // update client info
+                this->autoAdjustCientGndCapability(situation);
 
-        // in case we only have
-        if (!existsInRange && validMaxRange)
-        {
-            // NEW aircraft
-            const bool hasFsInnPacket = m_tempFsInnPackets.contains(callsign);
-
-            CSimulatedAircraft aircraft;
-            aircraft.setCallsign(callsign);
-            aircraft.setSituation(situation);
-            aircraft.setTransponder(transponder);
-            this->addNewAircraftInRange(aircraft);
-            this->sendInitialPilotQueries(callsign, true, !hasFsInnPacket);
-
-            // new client, there is a chance it has been already created by custom packet
-            const CClient client(callsign);
-            this->addNewClient(client);
-        }
-        else if (existsInRange)
-        {
-            // update, aircraft already exists
-            CPropertyIndexVariantMap vm;
-            vm.addValue(CSimulatedAircraft::IndexTransponder, transponder);
-            vm.addValue(CSimulatedAircraft::IndexSituation, situation);
-            vm.addValue(CSimulatedAircraft::IndexRelativeDistance, this->calculateDistanceToOwnAircraft(situation));
-            vm.addValue(CSimulatedAircraft::IndexRelativeBearing, this->calculateBearingToOwnAircraft(situation));
-            this->updateAircraftInRange(callsign, vm);
+                situationsToStore.push_back(situation);
+                indexes.push_back(i);
+                existsInRange.push_back(exists);
+            }
+            begin = end;
+            if (situationsToStore.isEmpty()) { continue; }
+
+            // store situation history, one lock for all situations
+            this->storeAircraftSituations(situationsToStore); // updates situations
+
+            for (int s = 0; s < indexes.size(); ++s)
+            {
+                const CAircraftSituation &situation = situations[indexes[s]];
+                const CTransponder &transponder = transponders[indexes[s]];
+                const CCallsign callsign(situation.getCallsign());
+
+                if (!existsInRange[s])
+                {
+                    // NEW aircraft
+                    const bool hasFsInnPacket = m_tempFsInnPackets.contains(callsign);
+
+                    CSimulatedAircraft aircraft;
+                    aircraft.setCallsign(callsign);
+                    aircraft.setSituation(situation);
+                    aircraft.setTransponder(transponder);
+                    this->addNewAircraftInRange(aircraft);
+                    this->sendInitialPilotQueries(callsign, true, !hasFsInnPacket);
+
+                    // new client, there is a chance it has been already created by custom packet
+                    const CClient client(callsign);
+                    this->addNewClient(client);
+                }
+                else
+                {
+                    // update, aircraft already exists
+                    CPropertyIndexVariantMap vm;
+                    vm.addValue(CSimulatedAircraft::IndexTransponder, transponder);
+                    vm.addValue(CSimulatedAircraft::IndexSituation, situation);
+                    vm.addValue(CSimulatedAircraft::IndexRelativeDistance, this->calculateDistanceToOwnAircraft(situation));
+                    vm.addValue(CSimulatedAircraft::IndexRelativeBearing, this->calculateBearingToOwnAircraft(situation));
+                    this->updateAircraftInRange(callsign, vm);
+                }
+            }
         }
     }
 
     void CAirspaceMonitor::onAircraftInterimUpdateReceived(const CAircraftSituation &situation)
+    {
+        CAircraftSituationList situations;
+        situations.push_back(situation);
+        this->onAircraftInterimUpdatesReceived(situations);
+    }
+
+    void CAirspaceMonitor::onAircraftInterimUpdatesReceived(const CAircraftSituationList &situations)
     {
         Q_ASSERT_X(CThreadUtils::isInThisThread(this), Q_FUNC_INFO, "Called in different thread");
         if (!this->isConnectedAndNotShuttingDown()) { return; }
 
-        const CCallsign callsign(situation.getCallsign());
+        const int count = situations.sizeInt();
+        for (int begin = 0; begin < count;)
+        {
+            // an interim situation uses the stored previous situation
+            const int end = endOfUniqueCallsigns(situations, begin);
 
-        // checks
-        Q_ASSERT_X(!callsign.isEmpty(), Q_FUNC_INFO, "Empty callsign");
+            CAircraftSituationList interimSituations;
+            CAircraftSituationList lastSituations;
+            for (int i = begin; i < end; ++i)
+            {
+                const CAircraftSituation &situation = situations[i];
+                const CCallsign callsign(situation.getCallsign());
 
-        if (isCopilotAircraft(callsign))        { return; }
-        if (!this->isAircraftInRange(callsign)) { return; }
+                // checks
+                Q_ASSERT_X(!callsign.isEmpty(), Q_FUNC_INFO, "Empty callsign");
 
-        if (CBuildConfig::isLocalDeveloperDebugBuild())
-        {
-            Q_ASSERT_X(!situation.isNaNVectorDouble(), Q_FUNC_INFO, "Detected NaN");
-            Q_ASSERT_X(!situation.isInfVectorDouble(), Q_FUNC_INFO, "Detected inf");
-            Q_ASSERT_X(situation.isValidVectorRange(), Q_FUNC_INFO, "out of range [-1,1]");
-        }
+                if (isCopilotAircraft(callsign))        { continue; }
+                if (!this->isAircraftInRange(callsign)) { continue; }
+
+                if (CBuildConfig::isLocalDeveloperDebugBuild())
+                {
+                    Q_ASSERT_X(!situation.isNaNVectorDouble(), Q_FUNC_INFO, "Detected NaN");
+                    Q_ASSERT_X(!situation.isInfVectorDouble(), Q_FUNC_INFO, "Detected inf");
+                    Q_ASSERT_X(situation.isValidVectorRange(), Q_FUNC_INFO, "out of range [-1,1]");
+                }
 
-        // Interim packets do not have groundspeed, hence set the last known value.
-        // If there is no full position available yet, throw this interim position away.
-        CAircraftSituation interimSituation(situation);
-        CAircraftSituationList history = this->remoteAircraftSituations(callsign);
-        if (history.empty()) { return; } // we need one full situation at least
-        const CAircraftSituation lastSituation = history.latestObject();
+                // Interim packets do not have groundspeed, hence set the last known value.
+                // If there is no full position available yet, throw this interim position away.
+                CAircraftSituation interimSituation(situation);
+                const CAircraftSituationList history = this->remoteAircraftSituations(callsign);
+                if (history.empty()) { continue; } // we need one full situation at least
+                const CAircraftSituation lastSituation = history.latestObject();
 
-        // changed position, continue and copy values
-        interimSituation.setCurrentUtcTime();
-        interimSituation.setGroundSpeed(lastSituation.getGroundSpeed());
+                // changed position, continue and copy values
+                interimSituation.setCurrentUtcTime();
+                interimSituation.setGroundSpeed(lastSituation.getGroundSpeed());
 
-        // store situation history
-        this->storeAircraftSituation(interimSituation);
+                interimSituations.push_back(interimSituation);
+                lastSituations.push_back(lastSituation);
+            }
+            begin = end;
+            if (interimSituations.isEmpty()) { continue; }
 
-        const bool samePosition = lastSituation.equalNormalVectorDouble(interimSituation);
-        if (samePosition) { return; } // nothing to update
+            // store situation history, one lock for all situations
+            this->storeAircraftSituations(interimSituations);
 
-        // update aircraft
-        this->updateAircraftInRangeDistanceBearing(
-            callsign, interimSituation,
-            this->calculateDistanceToOwnAircraft(interimSituation),
-            this->calculateBearingToOwnAircraft(interimSituation)
-        );
+            for (int s = 0; s < interimSituations.sizeInt(); ++s)
+            {
+                const CAircraftSituation &interimSituation = interimSituations[s];
+                const CCallsign callsign(interimSituation.getCallsign());
+                const bool samePosition = lastSituations[s].equalNormalVectorDouble(interimSituation);
+                if (samePosition) { continue; } // nothing to update
+
+                // update aircraft
+                this->updateAircraftInRangeDistanceBearing(
+                    callsign, interimSituation,
+                    this->calculateDistanceToOwnAircraft(interimSituation),
+                    this->calculateBearingToOwnAircraft(interimSituation)
+                );
+            }
+        }
     }
 
     void CAirspaceMonitor::onConnectionStatusChanged(CConnectionStatus oldStatus, CConnectionStatus newStatus)
@@ -1425,12 +1494,73 @@ namespace BlackCore
         this->setOtherClient(client);
     }
 
+    int CAirspaceMonitor::endOfUniqueCallsigns(const CAircraftSituationList &situations, int begin)
+    {
+        QSet<CCallsign> callsigns;
+        int end = begin;
+        for (; end < situations.sizeInt(); ++end)
+        {
+            const CCallsign &callsign = situations[end].getCallsign();
+            if (callsigns.contains(callsign)) { break; }
+            callsigns.insert(callsign);
+        }
+        return end;
+    }
+
     CAircraftSituation CAirspaceMonitor::storeAircraftSituation(const CAircraftSituation &situation, bool allowTestOffset)
     {
         const CCallsign callsign(situation.getCallsign());
         BLACK_VERIFY_X(!callsign.isEmpty(), Q_FUNC_INFO, "empty callsign");
         if (callsign.isEmpty()) { return situation; }
 
+        bool mustRequestElevation = false;
+        const CAircraftSituation correctedSituation = this->correctSituationBeforeStoring(situation, allowTestOffset, mustRequestElevation);
+
+        // store corrected situation
+        const CAircraftSituation storedSituation = CRemoteAircraftProvider::storeAircraftSituation(correctedSituation, false); // we already added offset if any
+        if (mustRequestElevation) { this->requestElevationForStoredSituation(storedSituation); }
+        return storedSituation;
+    }
+
+    CAircraftSituationList CAirspaceMonitor::storeAircraftSituations(const CAircraftSituationList &situations, bool allowTestOffset)
+    {
+        CAircraftSituationList storedSituations;
+        const int count = situations.sizeInt();
+        for (int begin = 0; begin < count;)
+        {
+            // corrections look at the history, so all previous situations of a callsign must be stored already
+            const int end = endOfUniqueCallsigns(situations, begin);
+
+            CAircraftSituationList correctedSituations;
+            QVector<bool> requestElevations;
+            for (int i = begin; i < end; ++i)
+            {
+                const CAircraftSituation &situation = situations[i];
+                BLACK_VERIFY_X(!situation.getCallsign().isEmpty(), Q_FUNC_INFO, "empty callsign");
+
+                bool mustRequestElevation = false;
+                correctedSituations.push_back(this->correctSituationBeforeStoring(situation, allowTestOffset, mustRequestElevation));
+                requestElevations.push_back(mustRequestElevation);
+            }
+            begin = end;
+
+            // store corrected situations
+            const CAircraftSituationList stored = CRemoteAircraftProvider::storeAircraftSituations(correctedSituations, false); // we already added offset if any
+            for (int s = 0; s < stored.sizeInt(); ++s)
+            {
+                if (requestElevations[s]) { this->requestElevationForStoredSituation(stored[s]); }
+            }
+            storedSituations.push_back(stored);
+        }
+        return storedSituations;
+    }
+
+    CAircraftSituation CAirspaceMonitor::correctSituationBeforeStoring(const CAircraftSituation &situation, bool allowTestOffset, bool &mustRequestElevation)
+    {
+        mustRequestElevation = false;
+        const CCallsign callsign(situation.getCallsign());
+        if (callsign.isEmpty()) { return situation; }
+
         CAircraftSituation correctedSituation(allowTestOffset ? this->addTestAltitudeOffsetToSituation(situation) : situation);
         bool needToRequestElevation  = false;
         bool canLikelySkipNearGround = correctedSituation.canLikelySkipNearGroundInterpolation();
@@ -1471,7 +1601,8 @@ namespace BlackCore
             }
 
             // fetch from cache or request
-            const CAircraftSituationChange changesBeforeStoring = this->remoteAircraftSituationChanges(callsign).frontOrDefault();
+            const int callsignId = CCallsignInterner::findId(callsign);
+            const CAircraftSituationChange changesBeforeStoring = this->remoteAircraftSituationChanges(callsignId).frontOrDefault();
 
             if (!changesBeforeStoring.isNull())
             {
@@ -1482,7 +1613,7 @@ namespace BlackCore
             // we NEED elevation
             // actually distance of 200k/h 100ms is just 6.1 meters
             const CLength dpt = correctedSituation.getDistancePerTime(100, CElevationPlane::singlePointRadius());
-            const CAircraftSituationList situationsBeforeStoring   = this->remoteAircraftSituations(callsign);
+            const CAircraftSituationList situationsBeforeStoring   = this->remoteAircraftSituations(callsignId);
             const CAircraftSituation situationWithElvBeforeStoring = situationsBeforeStoring.findClosestElevationWithinRange(correctedSituation, dpt);
             if (situationWithElvBeforeStoring.transferGroundElevationFromMe(correctedSituation, dpt))
             {
@@ -1592,22 +1723,19 @@ namespace BlackCore
         const CLength cg = this->getSimulatorOrDbCG(callsign, this->getCGFromDB(callsign)); // always x-check against simulator to override guessed values and reflect changed CGs
         if (!cg.isNull()) { correctedSituation.setCG(cg); }
 
-        // store corrected situation
-        correctedSituation = CRemoteAircraftProvider::storeAircraftSituation(correctedSituation, false); // we already added offset if any
+        // check if we need want to request, done after storing
+        mustRequestElevation = needToRequestElevation && !canLikelySkipNearGround;
+        return correctedSituation;
+    }
 
-        // check if we need want to request
-        if (needToRequestElevation && !canLikelySkipNearGround)
+    void CAirspaceMonitor::requestElevationForStoredSituation(const CAircraftSituation &situation)
+    {
+        // we have not requested so far, but we are NEAR ground
+        // we expect at least not transferred cache or we are moving and have no provider elevation yet
+        if (situation.isOtherElevationInfoBetter(CAircraftSituation::FromCache, false) || (situation.isMoving() && situation.isOtherElevationInfoBetter(CAircraftSituation::FromProvider, false)))
         {
-            // we have not requested so far, but we are NEAR ground
-            // we expect at least not transferred cache or we are moving and have no provider elevation yet
-            if (correctedSituation.isOtherElevationInfoBetter(CAircraftSituation::FromCache, false) || (correctedSituation.isMoving() && correctedSituation.isOtherElevationInfoBetter(CAircraftSituation::FromProvider, false)))
-            {
-                needToRequestElevation = this->requestElevation(correctedSituation);
-            }
+            this->requestElevation(situation);
         }
-
-        Q_UNUSED(needToRequestElevation)
-        return correctedSituation;
     }
 
     void CAirspaceMonitor::sendInitialAtcQueries(const CCallsign &callsign)
@@ -49,6 +49,7 @@
 #include <QTimer>
 #include <QtGlobal>
 #include <QQueue>
+#include <QVector>
 #include <functional>
 
 namespace BlackCore
@@ -371,6 +372,22 @@ namespace BlackCore
         //! \remark uses gnd.elevation if found
         virtual BlackMisc::Aviation::CAircraftSituation storeAircraftSituation(const BlackMisc::Aviation::CAircraftSituation &situation, bool allowTestOffset = true) override;
 
+        //! Store aircraft situations under consideration of gnd.flags/CG and elevation
+        //! \threadsafe
+        //! \remark situations are corrected like in storeAircraftSituation, but stored as batch
+        virtual BlackMisc::Aviation::CAircraftSituationList storeAircraftSituations(const BlackMisc::Aviation::CAircraftSituationList &situations, bool allowTestOffset = true) override;
+
+        //! Correct gnd.flag/CG and elevation of a situation before it is stored
+        //! \param mustRequestElevation set if elevation shall be requested for the stored situation
+        BlackMisc::Aviation::CAircraftSituation correctSituationBeforeStoring(const BlackMisc::Aviation::CAircraftSituation &situation, bool allowTestOffset, bool &mustRequestElevation);
+
+        //! Request elevation for a stored situation if we have no better elevation info yet
+        void requestElevationForStoredSituation(const BlackMisc::Aviation::CAircraftSituation &situation);
+
+        //! End index of the situations starting at begin without a repeated callsign
+        //! \remark situations are handled in such parts, as a situation depends on the stored previous situation of the same callsign
+        static int endOfUniqueCallsigns(const BlackMisc::Aviation::CAircraftSituationList &situations, int begin);
+
         //! Add or update aircraft
         BlackMisc::Simulation::CSimulatedAircraft addOrUpdateAircraftInRange(const BlackMisc::Aviation::CCallsign &callsign, const QString &aircraftIcao, const QString &airlineIcao, const QString &livery, const QString &modelString, BlackMisc::Simulation::CAircraftModel::ModelType modelType, BlackMisc::CStatusMessageList *log);
 
@@ -420,7 +437,10 @@ namespace BlackCore
         Readiness &addMatchingReadinessFlag(const BlackMisc::Aviation::CCallsign &callsign, MatchingReadinessFlag mrf);
 
         //! Create aircraft in range, this is the only place where a new aircraft should be added
+        //! @{
         void onAircraftUpdateReceived(const BlackMisc::Aviation::CAircraftSituation &situation, const BlackMisc::Aviation::CTransponder &transponder);
+        void onAircraftUpdatesReceived(const BlackMisc::Aviation::CAircraftSituationList &situations, const QVector<BlackMisc::Aviation::CTransponder> &transponders);
+        //! @}
 
         //! Create ATC station, this is the only place where an online ATC station should be added
         void onAtcPositionUpdate(const BlackMisc::Aviation::CCallsign &callsign, const BlackMisc::PhysicalQuantities::CFrequency &frequency, const BlackMisc::Geo::CCoordinateGeodetic &position, const BlackMisc::PhysicalQuantities::CLength &range);
@@ -444,6 +464,7 @@ namespace BlackCore
         void onReceivedVatsimDataFile();
         void onAircraftConfigReceived(const BlackMisc::Aviation::CCallsign &callsign, const QJsonObject &jsonObject, qint64 currentOffsetMs);
         void onAircraftInterimUpdateReceived(const BlackMisc::Aviation::CAircraftSituation &situation);
+        void onAircraftInterimUpdatesReceived(const BlackMisc::Aviation::CAircraftSituationList &situations);
         void onConnectionStatusChanged(BlackMisc::Network::CConnectionStatus oldStatus, BlackMisc::Network::CConnectionStatus newStatus);
         void onRevBAircraftConfigReceived(const BlackMisc::Aviation::CCallsign &callsign, const QString &config, qint64 currentOffsetMs);
 
@@ -141,6 +141,12 @@ namespace BlackCore
             return m_airspace->remoteAircraftSituations(callsign);
         }
 
+        CAircraftSituationList CContextNetwork::remoteAircraftSituations(int callsignId) const
+        {
+            if (!this->canUseAirspaceMonitor()) { return {}; }
+            return m_airspace->remoteAircraftSituations(callsignId);
+        }
+
         CAircraftSituation CContextNetwork::remoteAircraftSituation(const Aviation::CCallsign &callsign, int index) const
         {
             if (!this->canUseAirspaceMonitor()) { return {}; }
@@ -171,6 +177,12 @@ namespace BlackCore
             return m_airspace->remoteAircraftParts(callsign);
         }
 
+        CAircraftPartsList CContextNetwork::remoteAircraftParts(int callsignId) const
+        {
+            if (!this->canUseAirspaceMonitor()) { return {}; }
+            return m_airspace->remoteAircraftParts(callsignId);
+        }
+
         int CContextNetwork::remoteAircraftPartsCount(const CCallsign &callsign) const
         {
             if (!this->canUseAirspaceMonitor()) { return 0; }
@@ -201,6 +213,12 @@ namespace BlackCore
             return m_airspace->remoteAircraftSituationChanges(callsign);
         }
 
+        CAircraftSituationChangeList CContextNetwork::remoteAircraftSituationChanges(int callsignId) const
+        {
+            if (!this->canUseAirspaceMonitor()) { return {}; }
+            return m_airspace->remoteAircraftSituationChanges(callsignId);
+        }
+
         int CContextNetwork::remoteAircraftSituationChangesCount(const CCallsign &callsign) const
         {
             if (!this->canUseAirspaceMonitor()) { return {}; }
@@ -1016,6 +1034,12 @@ namespace BlackCore
             return m_airspace->situationsLastModified(callsign);
         }
 
+        qint64 CContextNetwork::situationsLastModified(int callsignId) const
+        {
+            if (this->isDebugEnabled()) { CLogMessage(this, CLogCategory::contextSlot()).debug() << Q_FUNC_INFO; }
+            return m_airspace->situationsLastModified(callsignId);
+        }
+
         qint64 CContextNetwork::partsLastModified(const CCallsign &callsign) const
         {
             if (this->isDebugEnabled()) { CLogMessage(this, CLogCategory::contextSlot()).debug() << Q_FUNC_INFO; }
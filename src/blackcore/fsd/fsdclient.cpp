@@ -1095,7 +1095,7 @@ namespace BlackCore
             }
         }
 
-        void CFSDClient::handlePilotDataUpdate(const QStringList &tokens)
+        void CFSDClient::handlePilotDataUpdate(const Tokenizer &tokens)
         {
             const PilotDataUpdate dataUpdate = PilotDataUpdate::fromTokens(tokens);
             const CCallsign callsign(dataUpdate.sender(), CCallsign::Aircraft);
@@ -1132,6 +1132,15 @@ namespace BlackCore
                 // I set a default: IFR standby is a reasonable default
                 transponder = CTransponder(2000, CTransponder::StateStandby);
             }
+
+            if (m_bufferPositionUpdates)
+            {
+                // keep order with interim positions of the same pass
+                if (!m_bufferedInterimSituations.isEmpty()) { this->emitBufferedPositionUpdates(); }
+                m_bufferedSituations.push_back(situation);
+                m_bufferedTransponders.push_back(transponder);
+                return;
+            }
             emit pilotDataUpdateReceived(situation, transponder);
         }
 
@@ -1482,27 +1491,7 @@ namespace BlackCore
             }
             else if (subType == "VI")
             {
-                // swift's updated interim pilot update.
-                if (!isInterimPositionReceivingEnabledForServer()) { return; }
-
-                const InterimPilotDataUpdate interimPilotDataUpdate = InterimPilotDataUpdate::fromTokens(tokens);
-                const CCallsign callsign(interimPilotDataUpdate.sender(), CCallsign::Aircraft);
-
-                CAircraftSituation situation(
-                    callsign,
-                    CCoordinateGeodetic(interimPilotDataUpdate.m_latitude, interimPilotDataUpdate.m_longitude, interimPilotDataUpdate.m_altitudeTrue),
-                    CHeading(interimPilotDataUpdate.m_heading, CHeading::True, CAngleUnit::deg()),
-                    CAngle(interimPilotDataUpdate.m_pitch, CAngleUnit::deg()),
-                    CAngle(interimPilotDataUpdate.m_bank, CAngleUnit::deg()),
-                    CSpeed(interimPilotDataUpdate.m_groundSpeed, CSpeedUnit::kts()));
-                situation.setOnGround(interimPilotDataUpdate.m_onGround);
-
-                // Ref T297, default offset time
-                situation.setCurrentUtcTime();
-                const qint64 offsetTimeMs = receivedPositionFixTsAndGetOffsetTime(situation.getCallsign(), situation.getMSecsSinceEpoch());
-                situation.setTimeOffsetMs(offsetTimeMs);
-
-                emit interimPilotDataUpdatedReceived(situation);
+                // swift's updated interim pilot update, parsed from the raw tokens in handleInterimPilotDataUpdate
             }
             else if (subType == "FSIPI")
             {
@@ -1532,6 +1521,38 @@ namespace BlackCore
             }
         }
 
+        void CFSDClient::handleInterimPilotDataUpdate(const Tokenizer &tokens)
+        {
+            // swift's updated interim pilot update.
+            if (!isInterimPositionReceivingEnabledForServer()) { return; }
+
+            const InterimPilotDataUpdate interimPilotDataUpdate = InterimPilotDataUpdate::fromTokens(tokens);
+            const CCallsign callsign(interimPilotDataUpdate.sender(), CCallsign::Aircraft);
+
+            CAircraftSituation situation(
+                callsign,
+                CCoordinateGeodetic(interimPilotDataUpdate.m_latitude, interimPilotDataUpdate.m_longitude, interimPilotDataUpdate.m_altitudeTrue),
+                CHeading(interimPilotDataUpdate.m_heading, CHeading::True, CAngleUnit::deg()),
+                CAngle(interimPilotDataUpdate.m_pitch, CAngleUnit::deg()),
+                CAngle(interimPilotDataUpdate.m_bank, CAngleUnit::deg()),
+                CSpeed(interimPilotDataUpdate.m_groundSpeed, CSpeedUnit::kts()));
+            situation.setOnGround(interimPilotDataUpdate.m_onGround);
+
+            // Ref T297, default offset time
+            situation.setCurrentUtcTime();
+            const qint64 offsetTimeMs = receivedPositionFixTsAndGetOffsetTime(situation.getCallsign(), situation.getMSecsSinceEpoch());
+            situation.setTimeOffsetMs(offsetTimeMs);
+
+            if (m_bufferPositionUpdates)
+            {
+                // keep order with full positions of the same pass
+                if (!m_bufferedSituations.isEmpty()) { this->emitBufferedPositionUpdates(); }
+                m_bufferedInterimSituations.push_back(situation);
+                return;
+            }
+            emit interimPilotDataUpdatedReceived(situation);
+        }
+
         void CFSDClient::handleFsdIdentification(const QStringList &tokens)
         {
             if (m_protocolRevision >= PROTOCOL_REVISION_VATSIM_AUTH)
@@ -1921,13 +1942,15 @@ namespace BlackCore
 
             int lines = 0;
 
+            // positions of this pass are emitted as one batch
+            m_bufferPositionUpdates = true;
+
             // reads at least one line if available
             while (m_socket.canReadLine())
             {
                 const QByteArray dataEncoded = m_socket.readLine();
                 if (dataEncoded.isEmpty()) { continue; }
-                const QString data = m_fsdTextCodec->toUnicode(dataEncoded);
-                this->parseMessage(data);
+                this->parseMessage(dataEncoded);
                 lines++;
 
                 static constexpr int MaxLines = 75 - 1;
@@ -1947,7 +1970,25 @@ namespace BlackCore
                     });
                     break;
                 }
+            }
+
+            m_bufferPositionUpdates = false;
+            this->emitBufferedPositionUpdates();
+        }
+
+        void CFSDClient::emitBufferedPositionUpdates()
+        {
+            if (!m_bufferedSituations.isEmpty())
+            {
+                emit pilotDataUpdatesReceived(m_bufferedSituations, m_bufferedTransponders);
+                m_bufferedSituations.clear();
+                m_bufferedTransponders.clear();
+            }
 
+            if (!m_bufferedInterimSituations.isEmpty())
+            {
+                emit interimPilotDataUpdatesReceived(m_bufferedInterimSituations);
+                m_bufferedInterimSituations.clear();
             }
         }
 
@@ -1969,83 +2010,112 @@ namespace BlackCore
 
         void CFSDClient::parseMessage(const QString &lineRaw)
         {
-            MessageType messageType = MessageType::Unknown;
-            QString cmd;
-            const QString line = lineRaw.trimmed();
+            const QByteArray lineEncoded = m_fsdTextCodec ? m_fsdTextCodec->fromUnicode(lineRaw) : lineRaw.toUtf8();
+            this->parseMessage(lineEncoded);
+        }
+
+        QString CFSDClient::decodeFsdBytes(const char *data, int size) const
+        {
+            return m_fsdTextCodec ? m_fsdTextCodec->toUnicode(data, size) : QString::fromUtf8(data, size);
+        }
 
-            if (m_printToConsole) { qDebug() << "FSD Recv=>" << line; }
-            emitRawFsdMessage(line, false);
+        void CFSDClient::parseMessage(const QByteArray &lineEncoded)
+        {
+            // trim without copying
+            const char *data = lineEncoded.constData();
+            int size = lineEncoded.size();
+            while (size > 0 && static_cast<unsigned char>(*data) <= ' ') { ++data; --size; }
+            while (size > 0 && static_cast<unsigned char>(data[size - 1]) <= ' ') { --size; }
 
-            for (const QString &str : makeKeysRange(as_const(m_messageTypeMapping)))
+            // only decode the whole line if really needed
+            if (m_printToConsole || m_unitTestMode || m_rawFsdMessagesEnabled)
             {
-                if (line.startsWith(str))
-                {
-                    cmd = str;
-                    messageType = m_messageTypeMapping.value(str, MessageType::Unknown);
-                    break;
-                }
+                const QString line = this->decodeFsdBytes(data, size);
+                if (m_printToConsole) { qDebug() << "FSD Recv=>" << line; }
+                emitRawFsdMessage(line, false);
             }
 
+            int prefixLength = 0;
+            const MessageType messageType = messageTypeFromPrefix(data, size, prefixLength);
+
             // statistics
             if (m_statistics)
             {
                 increaseStatisticsValue(QStringLiteral("parseMessage"), this->messageTypeToString(messageType));
             }
 
-            if (messageType != MessageType::Unknown)
+            if (messageType == MessageType::Unknown)
             {
-                // Cutoff the cmd from the beginning
-                const QString payload = line.mid(cmd.size()).trimmed();
+                if (m_bufferPositionUpdates) { this->emitBufferedPositionUpdates(); }
+                handleUnknownPacket(this->decodeFsdBytes(data, size));
+                return;
+            }
 
-                // We expected a payload, but there is nothing
-                if (payload.length() == 0) { return; }
+            // Cutoff the cmd from the beginning
+            const char *payload = data + prefixLength;
+            int payloadSize = size - prefixLength;
+            while (payloadSize > 0 && static_cast<unsigned char>(*payload) <= ' ') { ++payload; --payloadSize; }
 
-                const QStringList tokens = payload.split(':');
-                switch (messageType)
-                {
-                // ignored ones
-                case MessageType::AddAtc:
-                case MessageType::AddPilot:
-                case MessageType::ServerHeartbeat:
-                case MessageType::ProController:
-                case MessageType::ClientIdentification:
-                case MessageType::RegistrationInfo:
-                case MessageType::RevBPilotDescription:
+            // We expected a payload, but there is nothing
+            if (payloadSize < 1) { return; }
 
-                    break;
+            // hot path: positions are parsed directly from the bytes
+            if (messageType == MessageType::PilotDataUpdate)
+            {
+                m_tokenizer.tokenize(payload, payloadSize);
+                handlePilotDataUpdate(m_tokenizer);
+                return;
+            }
 
-                // handled ones
-                case MessageType::AtcDataUpdate:     handleAtcDataUpdate(tokens);     break;
-                case MessageType::AuthChallenge:     handleAuthChallenge(tokens);     break;
-                case MessageType::AuthResponse:      handleAuthResponse(tokens);      break;
-                case MessageType::ClientQuery:       handleClientQuery(tokens);       break;
-                case MessageType::ClientResponse:    handleClientReponse(tokens);     break;
-                case MessageType::DeleteATC:         handleDeleteATC(tokens);         break;
-                case MessageType::DeletePilot:       handleDeletePilot(tokens);       break;
-                case MessageType::FlightPlan:        handleFlightPlan(tokens);        break;
-                case MessageType::FsdIdentification: handleFsdIdentification(tokens); break;
-                case MessageType::KillRequest:       handleKillRequest(tokens);       break;
-                case MessageType::PilotDataUpdate:   handlePilotDataUpdate(tokens);   break;
-                case MessageType::Ping:              handlePing(tokens);              break;
-                case MessageType::Pong:              handlePong(tokens);              break;
-                case MessageType::ServerError:       handleServerError(tokens);       break;
-                case MessageType::TextMessage:       handleTextMessage(tokens);       break;
-                case MessageType::PilotClientCom:    handleCustomPilotPacket(tokens); break;
-                case MessageType::RevBClientParts:   handleRevBClientPartsPacket(tokens); break;
-
-
-
-
-                // normally we should not get here
-                default:
-                case MessageType::Unknown:
-                    handleUnknownPacket(tokens);
-                    break;
+            if (messageType == MessageType::PilotClientCom)
+            {
+                m_tokenizer.tokenize(payload, payloadSize);
+                if (m_tokenizer.equals(2, QLatin1String("VI")))
+                {
+                    handleInterimPilotDataUpdate(m_tokenizer);
+                    return;
                 }
             }
-            else
+
+            // other messages must not overtake positions read before
+            if (m_bufferPositionUpdates) { this->emitBufferedPositionUpdates(); }
+
+            const QStringList tokens = this->decodeFsdBytes(payload, payloadSize).split(':');
+            switch (messageType)
             {
-                handleUnknownPacket(line);
+            // ignored ones
+            case MessageType::AddAtc:
+            case MessageType::AddPilot:
+            case MessageType::ServerHeartbeat:
+            case MessageType::ProController:
+            case MessageType::ClientIdentification:
+            case MessageType::RegistrationInfo:
+            case MessageType::RevBPilotDescription:
+                break;
+
+            // handled ones
+            case MessageType::AtcDataUpdate:     handleAtcDataUpdate(tokens);     break;
+            case MessageType::AuthChallenge:     handleAuthChallenge(tokens);     break;
+            case MessageType::AuthResponse:      handleAuthResponse(tokens);      break;
+            case MessageType::ClientQuery:       handleClientQuery(tokens);       break;
+            case MessageType::ClientResponse:    handleClientReponse(tokens);     break;
+            case MessageType::DeleteATC:         handleDeleteATC(tokens);         break;
+            case MessageType::DeletePilot:       handleDeletePilot(tokens);       break;
+            case MessageType::FlightPlan:        handleFlightPlan(tokens);        break;
+            case MessageType::FsdIdentification: handleFsdIdentification(tokens); break;
+            case MessageType::KillRequest:       handleKillRequest(tokens);       break;
+            case MessageType::Ping:              handlePing(tokens);              break;
+            case MessageType::Pong:              handlePong(tokens);              break;
+            case MessageType::ServerError:       handleServerError(tokens);       break;
+            case MessageType::TextMessage:       handleTextMessage(tokens);       break;
+            case MessageType::PilotClientCom:    handleCustomPilotPacket(tokens); break;
+            case MessageType::RevBClientParts:   handleRevBClientPartsPacket(tokens); break;
+
+            // normally we should not get here
+            default:
+            case MessageType::Unknown:
+                handleUnknownPacket(tokens);
+                break;
             }
         }
 
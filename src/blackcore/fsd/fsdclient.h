@@ -15,6 +15,7 @@
 #include "blackcore/vatsim/vatsimsettings.h"
 #include "blackcore/fsd/enums.h"
 #include "blackcore/fsd/messagebase.h"
+#include "blackcore/fsd/tokenizer.h"
 
 #include "blackmisc/simulation/ownaircraftprovider.h"
 #include "blackmisc/simulation/remoteaircraftprovider.h"
@@ -22,6 +23,8 @@
 #include "blackmisc/aviation/callsign.h"
 #include "blackmisc/aviation/informationmessage.h"
 #include "blackmisc/aviation/aircrafticaocode.h"
+#include "blackmisc/aviation/aircraftsituationlist.h"
+#include "blackmisc/aviation/transponder.h"
 #include "blackmisc/network/connectionstatus.h"
 #include "blackmisc/network/loginmode.h"
 #include "blackmisc/network/server.h"
@@ -44,6 +47,7 @@
 #include <QTextCodec>
 #include <QReadWriteLock>
 #include <QQueue>
+#include <QVector>
 
 #include <atomic>
 
@@ -54,7 +58,7 @@
 #define PROTOCOL_REVISION_VATSIM_AUTH 100
 //! @}
 
-namespace BlackFsdTest { class CTestFSDClient; }
+namespace BlackFsdTest { class CTestFSDClient; class CTestFsdReplay; }
 namespace BlackCore
 {
     namespace Fsd
@@ -227,9 +231,17 @@ namespace BlackCore
             void rawFsdMessage(const BlackMisc::Network::CRawFsdMessage &rawFsdMessage);
             void planeInformationFsinnReceived(const BlackMisc::Aviation::CCallsign &callsign, const QString &airlineIcaoDesignator, const QString &aircraftDesignator, const QString &combinedAircraftType, const QString &modelString);
             void revbAircraftConfigReceived(const QString &sender, const QString &config, qint64 currentOffsetTimeMs);
-
             //! @}
 
+            //! All position updates read from the socket in one pass
+            //! \remark one signal per pass instead of one per position, replaces pilotDataUpdateReceived for socket data
+            //! \remark transponders[i] belongs to situations[i]
+            void pilotDataUpdatesReceived(const BlackMisc::Aviation::CAircraftSituationList &situations, const QVector<BlackMisc::Aviation::CTransponder> &transponders);
+
+            //! All interim position updates read from the socket in one pass
+            //! \remark one signal per pass instead of one per position, replaces interimPilotDataUpdatedReceived for socket data
+            void interimPilotDataUpdatesReceived(const BlackMisc::Aviation::CAircraftSituationList &situations);
+
             //! We received a reply to one of our ATIS queries.
             void atisReplyReceived(const BlackMisc::Aviation::CCallsign &callsign, const BlackMisc::Aviation::CInformationMessage &atis);
 
@@ -251,6 +263,7 @@ namespace BlackCore
         private:
             //! \cond
             friend BlackFsdTest::CTestFSDClient;
+            friend BlackFsdTest::CTestFsdReplay;
             //! \endcond
 
             //! Convenience functions for sendClientQuery
@@ -344,8 +357,18 @@ namespace BlackCore
 
             void readDataFromSocket() { this->readDataFromSocketMaxLines(); }
             void readDataFromSocketMaxLines(int maxLines = -1);
+
+            //! Parse an already decoded line
+            //! \remark used by UNIT tests, encodes and uses the raw parser
             void parseMessage(const QString &lineRaw);
 
+            //! Parse an encoded line as read from the socket
+            //! \remark position updates are parsed from the raw bytes, other messages are decoded into QString tokens
+            void parseMessage(const QByteArray &lineEncoded);
+
+            //! Decode with the FSD codec
+            QString decodeFsdBytes(const char *data, int size) const;
+
             QString socketErrorString(QAbstractSocket::SocketError error) const;
             static QString socketErrorToQString(QAbstractSocket::SocketError error);
 
@@ -363,7 +386,8 @@ namespace BlackCore
             void handleDeleteATC(const QStringList &tokens);
             void handleDeletePilot(const QStringList &tokens);
             void handleTextMessage(const QStringList &tokens);
-            void handlePilotDataUpdate(const QStringList &tokens);
+            void handlePilotDataUpdate(const Tokenizer &tokens);
+            void handleInterimPilotDataUpdate(const Tokenizer &tokens);
             void handlePing(const QStringList &tokens);
             void handlePong(const QStringList &tokens);
             void handleKillRequest(const QStringList &tokens);
@@ -393,6 +417,10 @@ namespace BlackCore
             //! Send the consolidatedTextMessages
             void emitConsolidatedTextMessages();
 
+            //! Emit the position updates buffered while reading from the socket
+            //! \remark called before any other message is handled, so the order of messages is kept
+            void emitBufferedPositionUpdates();
+
             //! Remember when last position was received
             qint64 receivedPositionFixTsAndGetOffsetTime(const BlackMisc::Aviation::CCallsign &callsign, qint64 markerTs = -1);
 
@@ -465,7 +493,14 @@ namespace BlackCore
             static constexpr qint64 PendingConnectionTimeoutMs = 7500;
 
             // Parser
-            QHash<QString, MessageType> m_messageTypeMapping;
+            QHash<QString, MessageType> m_messageTypeMapping; //!< used for statistics/type names, parsing uses messageTypeFromPrefix
+            Tokenizer m_tokenizer; //!< reused for every line, socket reading happens in one thread
+
+            // Batched position updates, only used in the socket reading thread
+            bool m_bufferPositionUpdates = false; //!< buffer positions while reading from socket
+            BlackMisc::Aviation::CAircraftSituationList m_bufferedSituations;        //!< full position updates of current pass
+            QVector<BlackMisc::Aviation::CTransponder>  m_bufferedTransponders;      //!< transponders for m_bufferedSituations
+            BlackMisc::Aviation::CAircraftSituationList m_bufferedInterimSituations; //!< interim position updates of current pass
 
             QTcpSocket m_socket { this }; //!< used TCP socket, parent needed as it runs in worker thread
 
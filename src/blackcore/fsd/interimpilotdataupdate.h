@@ -12,6 +12,7 @@
 #define BLACKCORE_FSD_INTERIMPILOTDATAUPDATE_H
 
 #include "messagebase.h"
+#include "tokenizer.h"
 
 namespace BlackCore
 {
@@ -32,6 +33,9 @@ namespace BlackCore
             //! Construct from tokens
             static InterimPilotDataUpdate fromTokens(const QStringList &tokens);
 
+            //! Construct from raw tokens, avoids decoding every token into a QString
+            static InterimPilotDataUpdate fromTokens(const Tokenizer &tokens);
+
             //! PDU identifier
             static QString pdu() { return "#SB"; }
 
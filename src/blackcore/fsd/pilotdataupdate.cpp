@@ -76,5 +76,36 @@ namespace BlackCore
                     tokens[4].toDouble(), tokens[5].toDouble(), tokens[6].toInt(), tokens[6].toInt() + tokens[9].toInt(), tokens[7].toInt(),
                     pitch, bank, heading, onGround);
         }
+
+        PilotDataUpdate PilotDataUpdate::fromTokens(const Tokenizer &tokens)
+        {
+            if (tokens.size() < 10)
+            {
+                CLogMessage(static_cast<PilotDataUpdate *>(nullptr)).debug(u"Wrong number of arguments.");
+                return {};
+            }
+
+            double pitch = 0.0;
+            double bank  = 0.0;
+            double heading = 0.0;
+            bool onGround = false;
+            unpackPBH(tokens.toUInt(8), pitch, bank, heading, onGround);
+
+            // transponder mode and rating are single characters, no need to decode them
+            CTransponder::TransponderMode transponderMode = CTransponder::StateStandby;
+            if (tokens.equals(0, QLatin1String("N")))      { transponderMode = CTransponder::ModeC; }
+            else if (tokens.equals(0, QLatin1String("Y"))) { transponderMode = CTransponder::StateIdent; }
+
+            const QLatin1String rating = tokens.at(3);
+            const char r = rating.size() == 1 ? rating.data()[0] : '\0';
+            const PilotRating pilotRating = (r >= '0' && r <= '5') ?
+                                            static_cast<PilotRating>(r - '0') :
+                                            fromQString<PilotRating>(tokens.toQString(3));
+
+            const int altitudeTrue = tokens.toInt(6);
+            return PilotDataUpdate(transponderMode, tokens.toQString(1), tokens.toInt(2), pilotRating,
+                                   tokens.toDouble(4), tokens.toDouble(5), altitudeTrue, altitudeTrue + tokens.toInt(9), tokens.toInt(7),
+                                   pitch, bank, heading, onGround);
+        }
     }
 }
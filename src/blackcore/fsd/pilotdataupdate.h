@@ -13,6 +13,7 @@
 
 #include "messagebase.h"
 #include "enums.h"
+#include "tokenizer.h"
 #include "blackmisc/aviation/transponder.h"
 
 namespace BlackCore
@@ -33,6 +34,9 @@ namespace BlackCore
             //! Construct from tokens
             static PilotDataUpdate fromTokens(const QStringList &tokens);
 
+            //! Construct from raw tokens, avoids decoding every token into a QString
+            static PilotDataUpdate fromTokens(const Tokenizer &tokens);
+
             //! PDU identifier
             static QString pdu() { return "@"; }
 
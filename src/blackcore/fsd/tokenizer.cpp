@@ -0,0 +1,231 @@
+/* Copyright (C) 2019
+ * swift project community / contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+#include "tokenizer.h"
+
+#include <limits>
+
+namespace BlackCore
+{
+    namespace Fsd
+    {
+        namespace
+        {
+            //! Trim spaces, as QString::toInt and friends ignore them as well
+            QLatin1String trimmedToken(QLatin1String token)
+            {
+                const char *b = token.data();
+                const char *e = b + token.size();
+                while (b < e && static_cast<unsigned char>(*b) <= ' ') { ++b; }
+                while (e > b && static_cast<unsigned char>(*(e - 1)) <= ' ') { --e; }
+                return QLatin1String(b, static_cast<int>(e - b));
+            }
+        }
+
+        void Tokenizer::tokenize(const char *data, int size)
+        {
+            m_tokens.clear();
+            if (!data || size < 1) { return; }
+
+            const char *start = data;
+            const char *end   = data + size;
+            for (const char *c = data; c < end; ++c)
+            {
+                if (*c != ':') { continue; }
+                m_tokens.append(QLatin1String(start, static_cast<int>(c - start)));
+                start = c + 1;
+            }
+            m_tokens.append(QLatin1String(start, static_cast<int>(end - start)));
+        }
+
+        QString Tokenizer::toQString(int index, QTextCodec *codec) const
+        {
+            const QLatin1String token = m_tokens.at(index);
+            if (!codec) { return QString(token); }
+            return codec->toUnicode(token.data(), token.size());
+        }
+
+        QStringList Tokenizer::toQStringList(QTextCodec *codec) const
+        {
+            QStringList tokens;
+            tokens.reserve(m_tokens.size());
+            for (int i = 0; i < m_tokens.size(); ++i) { tokens.push_back(this->toQString(i, codec)); }
+            return tokens;
+        }
+
+        int Tokenizer::toInt(int index) const
+        {
+            const qlonglong v = toLongLong(m_tokens.at(index));
+            if (v < std::numeric_limits<int>::min() || v > std::numeric_limits<int>::max()) { return 0; }
+            return static_cast<int>(v);
+        }
+
+        uint Tokenizer::toUInt(int index) const
+        {
+            const qulonglong v = toULongLong(m_tokens.at(index));
+            if (v > std::numeric_limits<uint>::max()) { return 0; }
+            return static_cast<uint>(v);
+        }
+
+        qlonglong Tokenizer::toLongLong(QLatin1String token)
+        {
+            token = trimmedToken(token);
+            if (token.isEmpty()) { return 0; }
+            const char *c = token.data();
+            const char *e = c + token.size();
+            bool negative = false;
+            if (*c == '-' || *c == '+') { negative = (*c == '-'); ++c; }
+            if (c == e) { return 0; }
+
+            qulonglong v = 0;
+            for (; c < e; ++c)
+            {
+                if (*c < '0' || *c > '9') { return 0; }
+                const qulonglong digit = static_cast<qulonglong>(*c - '0');
+                if (v > (std::numeric_limits<qulonglong>::max() - digit) / 10) { return 0; } // overflow
+                v = v * 10 + digit;
+            }
+            if (negative)
+            {
+                // the magnitude of the min. value is one more than the max. value
+                if (v > static_cast<qulonglong>(std::numeric_limits<qlonglong>::max()) + 1) { return 0; }
+                return static_cast<qlonglong>(0 - v);
+            }
+            if (v > static_cast<qulonglong>(std::numeric_limits<qlonglong>::max())) { return 0; }
+            return static_cast<qlonglong>(v);
+        }
+
+        qulonglong Tokenizer::toULongLong(QLatin1String token)
+        {
+            token = trimmedToken(token);
+            if (token.isEmpty() || token.at(0) == QLatin1Char('-')) { return 0; }
+            const char *c = token.data();
+            const char *e = c + token.size();
+            if (*c == '+') { ++c; }
+            if (c == e) { return 0; }
+
+            qulonglong v = 0;
+            for (; c < e; ++c)
+            {
+                if (*c < '0' || *c > '9') { return 0; }
+                const qulonglong digit = static_cast<qulonglong>(*c - '0');
+                if (v > (std::numeric_limits<qulonglong>::max() - digit) / 10) { return 0; } // overflow
+                v = v * 10 + digit;
+            }
+            return v;
+        }
+
+        double Tokenizer::toDouble(QLatin1String token)
+        {
+            static constexpr double Pow10[] =
+            {
+                1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+                1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+            };
+
+            token = trimmedToken(token);
+            if (token.isEmpty()) { return 0.0; }
+            const char *c = token.data();
+            const char *e = c + token.size();
+            bool negative = false;
+            if (*c == '-' || *c == '+') { negative = (*c == '-'); ++c; }
+
+            // fast path for the plain "ddd.ddddd" format FSD uses
+            // the mantissa is exact below 2^53, and division by an exact power of 10 is then correctly rounded
+            qulonglong mantissa = 0;
+            int digits = 0;
+            int fractionDigits = -1;
+            bool fast = (c < e);
+            for (; fast && c < e; ++c)
+            {
+                if (*c == '.')
+                {
+                    if (fractionDigits >= 0) { fast = false; break; }
+                    fractionDigits = 0;
+                    continue;
+                }
+                if (*c < '0' || *c > '9') { fast = false; break; }
+                mantissa = mantissa * 10 + static_cast<qulonglong>(*c - '0');
+                if (fractionDigits >= 0) { fractionDigits++; }
+                if (++digits > 15) { fast = false; break; }
+            }
+
+            if (fast && digits > 0)
+            {
+                const double v = static_cast<double>(mantissa) / Pow10[qMax(0, fractionDigits)];
+                return negative ? -v : v;
+            }
+
+            // exponents, "nan" etc. are rare, use the Qt conversion then
+            const QByteArray copy(token.data(), token.size());
+            bool ok = false;
+            const double v = copy.toDouble(&ok);
+            return ok ? v : 0.0;
+        }
+
+        MessageType messageTypeFromPrefix(const char *data, int size, int &prefixLength)
+        {
+            prefixLength = 0;
+            if (!data || size < 1) { return MessageType::Unknown; }
+
+            // 1 character PDUs
+            switch (data[0])
+            {
+            case '@': prefixLength = 1; return MessageType::PilotDataUpdate;
+            case '%': prefixLength = 1; return MessageType::AtcDataUpdate;
+            default: break;
+            }
+
+            if (size < 2) { return MessageType::Unknown; }
+            const char c1 = data[1];
+
+            // 2 character PDUs
+            if (data[0] == '!' && c1 == 'R') { prefixLength = 2; return MessageType::RegistrationInfo; }
+
+            if (size < 3) { return MessageType::Unknown; }
+            const char c2 = data[2];
+            MessageType mt = MessageType::Unknown;
+
+            switch (data[0])
+            {
+            case '#':
+                switch (c1)
+                {
+                case 'A': mt = (c2 == 'A') ? MessageType::AddAtc : (c2 == 'P') ? MessageType::AddPilot : MessageType::Unknown; break;
+                case 'D': mt = (c2 == 'A') ? MessageType::DeleteATC : (c2 == 'P') ? MessageType::DeletePilot : (c2 == 'L') ? MessageType::ServerHeartbeat : MessageType::Unknown; break;
+                case 'P': mt = (c2 == 'C') ? MessageType::ProController : MessageType::Unknown; break;
+                case 'T': mt = (c2 == 'M') ? MessageType::TextMessage : MessageType::Unknown; break;
+                case 'S': mt = (c2 == 'B') ? MessageType::PilotClientCom : MessageType::Unknown; break;
+                default: break;
+                }
+                break;
+            case '$':
+                switch (c1)
+                {
+                case 'Z': mt = (c2 == 'C') ? MessageType::AuthChallenge : (c2 == 'R') ? MessageType::AuthResponse : MessageType::Unknown; break;
+                case 'I': mt = (c2 == 'D') ? MessageType::ClientIdentification : MessageType::Unknown; break;
+                case 'C': mt = (c2 == 'Q') ? MessageType::ClientQuery : (c2 == 'R') ? MessageType::ClientResponse : MessageType::Unknown; break;
+                case 'F': mt = (c2 == 'P') ? MessageType::FlightPlan : MessageType::Unknown; break;
+                case 'D': mt = (c2 == 'I') ? MessageType::FsdIdentification : MessageType::Unknown; break;
+                case '!': mt = (c2 == '!') ? MessageType::KillRequest : MessageType::Unknown; break;
+                case 'P': mt = (c2 == 'I') ? MessageType::Ping : (c2 == 'O') ? MessageType::Pong : MessageType::Unknown; break;
+                case 'E': mt = (c2 == 'R') ? MessageType::ServerError : MessageType::Unknown; break;
+                default: break;
+                }
+                break;
+            case '-':
+                if (c2 == 'D') { mt = (c1 == 'M') ? MessageType::RevBClientParts : (c1 == 'P') ? MessageType::RevBPilotDescription : MessageType::Unknown; }
+                break;
+            default: break;
+            }
+
+            if (mt != MessageType::Unknown) { prefixLength = 3; }
+            return mt;
+        }
+    } // ns
+} // ns
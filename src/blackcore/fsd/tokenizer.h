@@ -0,0 +1,89 @@
+/* Copyright (C) 2019
+ * swift project community / contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \file
+
+#ifndef BLACKCORE_FSD_TOKENIZER_H
+#define BLACKCORE_FSD_TOKENIZER_H
+
+#include "blackcore/blackcoreexport.h"
+#include "blackcore/fsd/messagebase.h"
+
+#include <QByteArray>
+#include <QLatin1String>
+#include <QString>
+#include <QStringList>
+#include <QTextCodec>
+#include <QVarLengthArray>
+
+namespace BlackCore
+{
+    namespace Fsd
+    {
+        //! Zero-copy tokenizer for one encoded (raw) FSD line.
+        //! \remark tokens are views into the tokenized data, the data must outlive the tokenizer
+        //! \remark splitting at ':' on the encoded bytes is fine for all ASCII compatible codecs (Latin-1, UTF-8, Windows code pages) used by FSD
+        class BLACKCORE_EXPORT Tokenizer
+        {
+        public:
+            //! Default constructor
+            Tokenizer() {}
+
+            //! Split the payload (line without PDU) at ':'
+            void tokenize(const char *data, int size);
+
+            //! Split the payload (line without PDU) at ':'
+            void tokenize(const QByteArray &payload) { this->tokenize(payload.constData(), payload.size()); }
+
+            //! Number of tokens
+            int size() const { return m_tokens.size(); }
+
+            //! No tokens?
+            bool isEmpty() const { return m_tokens.isEmpty(); }
+
+            //! Token as byte view
+            QLatin1String at(int index) const { return m_tokens.at(index); }
+
+            //! Token equal to given ASCII string?
+            bool equals(int index, QLatin1String value) const { return index < m_tokens.size() && m_tokens.at(index) == value; }
+
+            //! Token as number, 0 if not convertible or out of range (like QString::toInt and friends)
+            //! @{
+            int toInt(int index) const;
+            uint toUInt(int index) const;
+            double toDouble(int index) const { return toDouble(m_tokens.at(index)); }
+            //! @}
+
+            //! Token decoded as string
+            //! \remark codec can be null, then Latin-1 is used (sufficient for callsigns and numbers)
+            QString toQString(int index, QTextCodec *codec = nullptr) const;
+
+            //! All tokens decoded as string list, as used by the QStringList based fromTokens
+            QStringList toQStringList(QTextCodec *codec = nullptr) const;
+
+            //! Number conversions on byte views
+            //! @{
+            static qlonglong toLongLong(QLatin1String token);
+            static qulonglong toULongLong(QLatin1String token);
+            static double toDouble(QLatin1String token);
+            //! @}
+
+        private:
+            QVarLengthArray<QLatin1String, 16> m_tokens;
+        };
+
+        //! Detect the message type from the PDU prefix of an encoded line
+        //! \param data line without leading whitespace
+        //! \param size line size
+        //! \param prefixLength length of the detected PDU, 0 if unknown
+        //! \remark switches on the first bytes, no lookup table or string comparison involved
+        BLACKCORE_EXPORT MessageType messageTypeFromPrefix(const char *data, int size, int &prefixLength);
+    } // ns
+} // ns
+
+#endif // guard
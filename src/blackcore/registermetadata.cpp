@@ -39,6 +39,8 @@ namespace BlackCore
         qRegisterMetaType<BlackCore::Afv::Clients::CAfvClient::ConnectionStatus>("ConnectionStatus");
         qRegisterMetaType<BlackCore::Afv::Audio::TransceiverReceivingCallsignsChangedArgs>();
         qRegisterMetaType<BlackCore::Afv::Audio::TransceiverReceivingCallsignsChangedArgs>("TransceiverReceivingCallsignsChangedArgs");
+        qRegisterMetaType<BlackCore::Afv::Audio::OutputVolumeStreamArgs>();
+        qRegisterMetaType<BlackCore::Afv::Audio::OutputVolumeStreamArgs>("OutputVolumeStreamArgs");
 
         qDBusRegisterMetaType<Context::CSettingsDictionary>();
         qDBusRegisterMetaType<BlackMisc::Network::CLoginMode>();
@@ -14,6 +14,7 @@
 #include "blackmisc/math/mathutils.h"
 #include "blackmisc/crashhandler.h"
 #include "blackmisc/directoryutils.h"
+#include "blackmisc/parallelfor.h"
 #include "blackmisc/threadutils.h"
 #include "blackmisc/logmessage.h"
 #include "blackmisc/verify.h"
@@ -23,6 +24,7 @@
 #include <QtGlobal>
 #include <QPointer>
 #include <QDateTime>
+#include <QElapsedTimer>
 #include <QString>
 #include <QStringBuilder>
 #include <QThread>
@@ -413,6 +415,7 @@ namespace BlackCore
     {
         m_statsUpdateAircraftRuns        = 0;
         m_statsUpdateAircraftTimeAvgMs   = 0;
+        m_statsUpdateAircraftSpeedup     = -1.0;
         m_statsUpdateAircraftTimeTotalMs = 0;
         m_statsMaxUpdateTimeMs           = 0;
         m_statsCurrentUpdateTimeMs       = 0;
@@ -421,6 +424,8 @@ namespace BlackCore
         m_statsUpdateAircraftLimited     = 0;
         m_statsLastUpdateAircraftRequestedMs  = 0;
         m_statsUpdateAircraftRequestedDeltaMs = 0;
+        m_statsUpdateAircraftTasksWallNs      = 0;
+        m_statsUpdateAircraftTasksWorkNs      = 0;
         ISimulationEnvironmentProvider::resetSimulationEnvironmentStatistics();
     }
 
@@ -535,6 +540,19 @@ namespace BlackCore
             }
         } // spline/linear
 
+        if (part1.startsWith("parallel"))
+        {
+            if (!parser.hasPart(2)) { return false; }
+            bool ok;
+            const int threads = parser.part(2).toInt(&ok);
+            if (!ok) { return false; }
+            CInterpolationAndRenderingSetupGlobal setup = this->getInterpolationSetupGlobal();
+            const bool changed = setup.setParallelUpdateThreads(threads);
+            if (changed) { this->setInterpolationSetupGlobal(setup); }
+            CLogMessage(this).info(u"Parallel update threads: %1") << setup.getParallelUpdateThreads();
+            return true;
+        } // parallel
+
         if (part1.startsWith("pos"))
         {
             CCallsign cs(parser.part(2).toUpper());
@@ -660,6 +678,7 @@ namespace BlackCore
         CSimpleCommandParser::registerCommand({".drv logint max number", "max. number of entries logged"});
         CSimpleCommandParser::registerCommand({".drv pos callsign", "show position for callsign"});
         CSimpleCommandParser::registerCommand({".drv spline|linear callsign", "set spline/linear interpolator for one/all callsign(s)"});
+        CSimpleCommandParser::registerCommand({".drv parallel number", "update aircraft with number threads (0..off)"});
         CSimpleCommandParser::registerCommand({".drv aircraft readd callsign", "add again (re-add) a given callsign"});
         CSimpleCommandParser::registerCommand({".drv aircraft readd all", "add again (re-add) all aircraft"});
         CSimpleCommandParser::registerCommand({".drv aircraft rm callsign", "remove a given callsign from simulator"});
@@ -1221,6 +1240,11 @@ namespace BlackCore
         m_statsUpdateAircraftTimeTotalMs += dt;
         m_statsUpdateAircraftRuns++;
         m_statsUpdateAircraftTimeAvgMs = static_cast<double>(m_statsUpdateAircraftTimeTotalMs) / static_cast<double>(m_statsUpdateAircraftRuns);
+        if (m_statsUpdateAircraftTasksWallNs > 0)
+        {
+            // summed task time vs. elapsed time, 1.0 when updating sequentially
+            m_statsUpdateAircraftSpeedup = static_cast<double>(m_statsUpdateAircraftTasksWorkNs) / static_cast<double>(m_statsUpdateAircraftTasksWallNs);
+        }
         m_updateRemoteAircraftInProgress = false;
         m_statsLastUpdateAircraftRequestedMs = startTime;
 
@@ -1231,6 +1255,38 @@ namespace BlackCore
         if (limited) { m_statsUpdateAircraftLimited++; }
     }
 
+    void ISimulator::runRemoteAircraftUpdateTasks(int count, const std::function<void(int)> &task)
+    {
+        if (count < 1) { return; }
+        const int threads = this->getInterpolationSetupGlobal().getParallelUpdateThreads();
+        QElapsedTimer wallTimer;
+        wallTimer.start();
+        if (threads < 2 || count < 2)
+        {
+            for (int i = 0; i < count; ++i) { task(i); }
+            const qint64 ns = wallTimer.nsecsElapsed();
+            m_statsUpdateAircraftTasksWallNs += ns;
+            m_statsUpdateAircraftTasksWorkNs += ns;
+            return;
+        }
+
+        // the calling thread works as well
+        if (m_updateAircraftPool.maxThreadCount() != threads - 1) { m_updateAircraftPool.setMaxThreadCount(threads - 1); }
+
+        // small chunks balance the load, tasks of aircraft with new situations are more expensive
+        const int chunkSize = qMax(1, count / (4 * threads));
+        std::atomic<qint64> workNs { 0 };
+        parallelFor(&m_updateAircraftPool, count, chunkSize, [&](int i)
+        {
+            QElapsedTimer taskTimer;
+            taskTimer.start();
+            task(i);
+            workNs += taskTimer.nsecsElapsed();
+        });
+        m_statsUpdateAircraftTasksWallNs += wallTimer.nsecsElapsed();
+        m_statsUpdateAircraftTasksWorkNs += workNs;
+    }
+
     void ISimulator::onOwnModelChanged(const CAircraftModel &newModel)
     {
         Q_UNUSED(newModel)
@@ -43,7 +43,9 @@
 #include <QFlags>
 #include <QObject>
 #include <QString>
+#include <QThreadPool>
 #include <atomic>
+#include <functional>
 
 namespace BlackMisc
 {
@@ -297,6 +299,7 @@ namespace BlackCore
         //! .drv logint clear                 clear current log                       BlackCore::ISimulator
         //! .drv pos callsign                 shows current position in simulator     BlackCore::ISimulator
         //! .drv spline|linear callsign       interpolator spline or linear           BlackCore::ISimulator
+        //! .drv parallel number              update aircraft with number threads     BlackCore::ISimulator
         //! .drv aircraft readd callsign      re-add (add again) aircraft             BlackCore::ISimulator
         //! .drv aircraft readd all           re-add all aircraft                     BlackCore::ISimulator
         //! .drv aircraft rm callsign         remove aircraft                         BlackCore::ISimulator
@@ -343,6 +346,10 @@ namespace BlackCore
         //! Time between two update requests
         qint64 getStatisticsAircraftUpdatedRequestedDeltaMs() const { return m_statsUpdateAircraftRequestedDeltaMs; }
 
+        //! Speedup of the parallel aircraft updates, summed time of all tasks divided by the elapsed time
+        //! \remark 1.0 for sequential updates, -1 if there were no updates yet
+        double getStatisticsUpdateSpeedup() const { return m_statsUpdateAircraftSpeedup; }
+
         //! The traced loopback situations
         BlackMisc::Aviation::CAircraftSituationList getLoopbackSituations(const BlackMisc::Aviation::CCallsign &callsign) const;
 
@@ -566,6 +573,13 @@ namespace BlackCore
         //! Update stats and flags
         void finishUpdateRemoteAircraftAndSetStatistics(qint64 startTime, bool limited = false);
 
+        //! Call task(i) for all remote aircraft 0..count-1 to be updated
+        //! \details runs in parallel on ISimulator::m_updateAircraftPool if enabled in the global setup, otherwise sequentially.
+        //!          The elapsed and the summed task times are recorded for the speedup statistics.
+        //! \remark tasks are called concurrently, they must only read shared data and write their own index,
+        //!         collect the results and pass them to the simulator afterwards in the calling thread
+        void runRemoteAircraftUpdateTasks(int count, const std::function<void(int)> &task);
+
         //! Own model has been changed
         virtual void onOwnModelChanged(const BlackMisc::Simulation::CAircraftModel &newModel);
 
@@ -594,6 +608,7 @@ namespace BlackCore
         int    m_statsUpdateAircraftRuns        = 0;      //!< statistics update count
         int    m_statsUpdateAircraftLimited     = 0;      //!< skipped because of max.update limitations
         double m_statsUpdateAircraftTimeAvgMs   = 0;      //!< statistics average update time
+        double m_statsUpdateAircraftSpeedup     = -1.0;   //!< statistics speedup of parallel updates
         double m_averageFps                     = -1.0;   //!< FPS
         double m_simTimeRatio                   = 1.0;    //!< ratio of simulation time to real time, due to low FPS (X-Plane)
         double m_trackMilesShort                = 0.0;    //!< difference between real and reported groundspeed, multiplied by time
@@ -605,6 +620,9 @@ namespace BlackCore
         qint64 m_lastRecordedGndElevationMs     = 0;      //!< when gnd.elevation was last modified
         qint64 m_statsLastUpdateAircraftRequestedMs  = 0; //!< when was the last aircraft update requested
         qint64 m_statsUpdateAircraftRequestedDeltaMs = 0; //!< delta time between 2 aircraft updates
+        qint64 m_statsUpdateAircraftTasksWallNs = 0;      //!< elapsed time of ISimulator::runRemoteAircraftUpdateTasks
+        qint64 m_statsUpdateAircraftTasksWorkNs = 0;      //!< summed time of all update tasks
+        QThreadPool m_updateAircraftPool;                 //!< threads for the parallel aircraft updates
 
         BlackMisc::Aviation::CAltitude              m_pseudoElevation { BlackMisc::Aviation::CAltitude::null() }; //!< pseudo elevation for testing purposes
         BlackMisc::Simulation::CSimulatorInternals  m_simulatorInternals;  //!< setup read from the sim
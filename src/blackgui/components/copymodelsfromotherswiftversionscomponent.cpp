@@ -14,6 +14,7 @@
 #include "blackmisc/fileutils.h"
 #include "blackmisc/swiftdirectories.h"
 #include "blackmisc/directoryutils.h"
+#include "blackmisc/valuecache.h"
 
 #include <QSet>
 #include <QPointer>
@@ -134,13 +135,35 @@ namespace BlackGui
             relativeModelFile = relativeModelFile.mid(relativeModelFile.indexOf('/', 1));
 
             const QString otherModelFile = CFileUtils::appendFilePathsAndFixUnc(otherVersion.getApplicationDataDirectory(), relativeModelFile);
-            const QFileInfo fiOtherModelFile(otherModelFile);
+            QFileInfo fiOtherModelFile(otherModelFile);
+            if (!fiOtherModelFile.exists() && fiOtherModelFile.suffix() == QLatin1String("bin"))
+            {
+                // older versions save the models in Json format
+                fiOtherModelFile.setFile(fiOtherModelFile.dir(), fiOtherModelFile.completeBaseName() + QStringLiteral(".json"));
+            }
             if (!fiOtherModelFile.exists())
             {
                 ui->le_Status->setText(QStringLiteral("No models here: '%1'").arg(fiOtherModelFile.absoluteFilePath()));
                 return false;
             }
 
+            // read other binary file
+            if (fiOtherModelFile.suffix() == QLatin1String("bin"))
+            {
+                QString key;
+                CVariant value;
+                const CStatusMessage msg = CValueCache::loadFromBinaryFile(fiOtherModelFile.absoluteFilePath(), key, &value);
+                if (msg.isFailure() || !value.canConvert<CAircraftModelList>())
+                {
+                    this->showOverlayMessage(msg);
+                    return false;
+                }
+                models = value.to<CAircraftModelList>();
+                ui->tvp_AircraftModels->updateContainerAsync(models);
+                ui->le_Status->setText(QStringLiteral("Imported %1 models '%2' for %3").arg(models.size()).arg(fiOtherModelFile.fileName(), sim.toQString()));
+                return true;
+            }
+
             // read other file
             const QString jsonString = CFileUtils::readFileToString(fiOtherModelFile.absoluteFilePath());
             if (jsonString.isEmpty()) { return false; }
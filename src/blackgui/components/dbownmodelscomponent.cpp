@@ -116,7 +116,7 @@ namespace BlackGui
         bool CDbOwnModelsComponent::requestModelsInBackground(const CSimulatorInfo &simulator, bool onlyIfNotEmpty)
         {
             this->setSimulator(simulator);
-            if (onlyIfNotEmpty && this->getOwnModelsCount() > 0) { return false; }
+            if (onlyIfNotEmpty && m_modelLoader && m_modelLoader->hasCachedModels(simulator)) { return false; }
             const IAircraftModelLoader::LoadMode mode = onlyIfNotEmpty ? IAircraftModelLoader::InBackgroundNoCache : IAircraftModelLoader::LoadInBackground;
             this->requestSimulatorModels(simulator, mode);
             return true;
@@ -90,6 +90,7 @@ namespace BlackGui
             void setSimulatorSelectorMode(CSimulatorSelector::Mode mode);
 
             //! Number of own models
+            //! \return -1 if the models are not loaded yet
             int getOwnModelsCount() const;
 
             //! \copydoc BlackMisc::Simulation::Data::CModelCaches::getInfoString
@@ -94,10 +94,11 @@ namespace BlackGui
             BlackMisc::Simulation::CAircraftModelList getModelSet() const { return this->getCachedModels(m_simulator); }
 
             //! Cached models count for current simulator
+            //! \return -1 if the model set is not loaded yet
             int getModelSetCount() const { return this->getCachedModelsCount(m_simulator); }
 
             //! Count and cache timestamp
-            QString getModelCacheCountAndTimestamp() const { return QString::number(getModelSetCount()); }
+            QString getModelCacheCountAndTimestamp() const { return this->getCachedModelsCountString(m_simulator); }
 
             //! Simulator
             void setSimulator(const BlackMisc::Simulation::CSimulatorInfo &simulator);
@@ -110,6 +110,12 @@ namespace BlackGui
             // models
             Q_ASSERT_X(m_simulatorInfo.isSingleSimulator(), Q_FUNC_INFO, "Need single simulator");
             const int c = this->getMappingComponent()->getOwnModelsCount();
+            if (c < 0)
+            {
+                const CStatusMessage m = CStatusMessage(this).error(u"Models for '%1' not loaded yet") << m_simulatorInfo.toQString(true);
+                ui->form_OwnModelSet->showOverlayMessage(m);
+                return false;
+            }
             if (c < 1)
             {
                 const CStatusMessage m = CStatusMessage(this).error(u"No models for '%1'") << m_simulatorInfo.toQString(true);
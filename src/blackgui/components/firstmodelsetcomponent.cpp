@@ -99,8 +99,13 @@ namespace BlackGui
             // we us the loader of the components directly,
             // avoid to fully init a loader logic here
             static const QString modelsNo("No models so far");
+            static const QString modelsNotLoaded("Models not loaded yet");
             const int modelsCount = this->modelLoader()->getCachedModelsCount(simulator);
-            if (modelsCount > 0)
+            if (modelsCount < 0)
+            {
+                ui->le_ModelsInfo->setText(modelsNotLoaded);
+            }
+            else if (modelsCount > 0)
             {
                 static const QString modelsInfo("%1 included %2 DB key %3");
                 const CAircraftModelList modelsInCache = this->modelLoader()->getCachedModels(simulator);
@@ -113,11 +118,11 @@ namespace BlackGui
                 ui->le_ModelsInfo->setText(modelsNo);
             }
 
-            ui->pb_CreateModelSet->setEnabled(modelsCount > 0);
+            ui->pb_CreateModelSet->setEnabled(modelsCount != 0); // not loaded models are loaded when creating the set
 
             static const QString modelsSetNo("Model set is empty");
             const int modelsSetCount = m_modelSetDialog->modelSetComponent()->getModelSetCount();
-            ui->le_ModelSetInfo->setText(modelsSetCount > 0 ? m_modelSetDialog->modelSetComponent()->getModelCacheCountAndTimestamp() : modelsSetNo);
+            ui->le_ModelSetInfo->setText(modelsSetCount != 0 ? m_modelSetDialog->modelSetComponent()->getModelCacheCountAndTimestamp() : modelsSetNo);
         }
 
         void CFirstModelSetComponent::onSettingsChanged(const CSimulatorInfo &simulator)
@@ -241,6 +246,8 @@ namespace BlackGui
         void CFirstModelSetComponent::createModelSet()
         {
             const CSimulatorInfo simulator = ui->comp_SimulatorSelector->getValue();
+            this->modelLoader()->admitCache(simulator);
+            this->modelLoader()->synchronizeCache(simulator); // the models are needed now
             const int modelsCount = this->modelLoader()->getCachedModelsCount(simulator);
             if (modelsCount < 1)
             {
@@ -286,7 +293,7 @@ namespace BlackGui
             }
 
             const int modelsSetCount = m_modelSetDialog->modelSetComponent()->getModelSetCount();
-            if (modelsSetCount > 0)
+            if (modelsSetCount != 0) // not loaded is also overridden
             {
                 QMessageBox::StandardButton override = QMessageBox::question(this, "Override", "Override existing model set?", QMessageBox::Yes | QMessageBox::No);
                 if (override != QMessageBox::Yes) { return; }
@@ -156,13 +156,15 @@ namespace BlackGui
                 ui->le_Parts->setText(boolToYesNo(m_airspaceMonitor->isRemoteAircraftSupportingParts(m_callsign)));
 
                 static const QString msTimeStr("%1ms");
-                static const QString updateTimes("%1ms avg: %2ms max: %3ms");
+                static const QString updateTimes("%1ms avg: %2ms max: %3ms speedup: %4");
                 const QString avgUpdateTimeRounded = QString::number(m_simulator->getStatisticsAverageUpdateTimeMs(), 'f', 2);
+                const double speedup = m_simulator->getStatisticsUpdateSpeedup();
 
                 ui->le_UpdateTimes->setText(updateTimes.
                                             arg(m_simulator->getStatisticsCurrentUpdateTimeMs()).
                                             arg(avgUpdateTimeRounded).
-                                            arg(m_simulator->getStatisticsMaxUpdateTimeMs()));
+                                            arg(m_simulator->getStatisticsMaxUpdateTimeMs()).
+                                            arg(speedup < 0 ? QStringLiteral("-") : QString::number(speedup, 'f', 2)));
                 ui->le_UpdateTimes->home(false);
                 ui->le_UpdateCount->setText(QString::number(m_simulator->getStatisticsUpdateRuns()));
                 ui->le_UpdateReqTime->setText(msTimeStr.arg(m_simulator->getStatisticsAircraftUpdatedRequestedDeltaMs()));
@@ -241,5 +241,10 @@ namespace BlackGui
         {
             return !m_highlightStrings.isEmpty();
         }
+
+        QString CAircraftModelListModel::objectKey(const CAircraftModel &model) const
+        {
+            return model.getModelString();
+        }
     } // namespace
 } // namespace
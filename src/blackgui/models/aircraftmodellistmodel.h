@@ -92,6 +92,11 @@ namespace BlackGui
             //! \copydoc BlackGui::Models::CListModelBaseNonTemplate::isOrderable
             virtual bool isOrderable() const override { return true; }
 
+        protected:
+            //! \copydoc CListModelBase::objectKey
+            //! \remark the model string, as models not (yet) in the DB have no DB key
+            virtual QString objectKey(const BlackMisc::Simulation::CAircraftModel &model) const override;
+
         private:
             AircraftModelMode m_mode = NotSet;              //!< current mode
             bool              m_highlightModels = false;    //!< highlight if in m_highlightStrings
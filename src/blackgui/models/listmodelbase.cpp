@@ -19,6 +19,11 @@
 #include <QJsonDocument>
 #include <QList>
 #include <QMimeData>
+#include <QMutexLocker>
+#include <QStringList>
+#include <algorithm>
+#include <memory>
+#include <numeric>
 
 using namespace BlackMisc;
 using namespace BlackMisc::Aviation;
@@ -166,36 +171,56 @@ namespace BlackGui
 
             // Keep sorting out of begin/end reset model
             ContainerType sortedContainer;
-            ContainerType selection;
-            if (m_selectionModel)
-            {
-                selection = m_selectionModel->selectedObjects();
-            }
-            const int oldSize = m_container.size();
             const bool performSort = sort && container.size() > 1 && this->hasValidSortColumn();
             if (performSort)
             {
                 const int sortColumn = this->getSortColumn();
                 sortedContainer = this->sortContainerByColumn(container, sortColumn, m_sortOrder);
             }
+            const ContainerType &newContainer = performSort ? sortedContainer : container;
+
+            // diff of the displayed rows, if not already computed in the background
+            const bool filtered = this->hasFilter();
+            const ContainerType rows = filtered ? m_filter->filter(newContainer) : newContainer;
+            const bool prepared = !filtered && isSameData(m_preparedDiffContainer, newContainer) && isSameData(m_preparedDiffBase, m_container);
+            const CListModelDiff diff = prepared ? m_preparedDiff : this->diffRows(this->containerOrFilteredContainer(), rows);
+            m_preparedDiffBase.clear();
+            m_preparedDiffContainer.clear();
+            m_preparedDiff = {};
+
+            if (diff.isValid())
+            {
+                // selection and scroll position are kept by the views
+                this->updateByDiff(rows, diff);
+                m_container = newContainer;
+            }
+            else
+            {
+                ContainerType selection;
+                if (m_selectionModel)
+                {
+                    selection = m_selectionModel->selectedObjects();
+                }
 
-            this->beginResetModel();
-            m_container = performSort ? sortedContainer : container;
-            this->updateFilteredContainer(); // use sorted container for filtered if applicable
-            this->endResetModel();
+                this->beginResetModel();
+                m_container = newContainer;
+                if (filtered) { m_containerFiltered = rows; } // use sorted container for filtered if applicable
+                else { m_containerFiltered.clear(); }
+                this->endResetModel();
 
-            // reselect if implemented in specialized view
-            if (!selection.isEmpty())
-            {
-                m_selectionModel->selectObjects(selection);
+                // reselect if implemented in specialized view
+                if (!selection.isEmpty())
+                {
+                    m_selectionModel->selectObjects(selection);
+                }
             }
 
-            const int newSize = m_container.size();
-            Q_UNUSED(oldSize)
+            // sort keys are kept only for the displayed data
+            this->releaseSortKeys(m_container);
 
-            // I have to update even with same size because I cannot tell what/if data are changed
+            // without diff I have to update even with same size because I cannot tell what/if data are changed
             this->emitModelDataChanged();
-            return newSize;
+            return m_container.size();
         }
 
         template <typename T, bool UseCompare>
@@ -223,19 +248,118 @@ namespace BlackGui
             if (m_modelDestroyed) { return nullptr; }
             const auto sortColumn = this->getSortColumn();
             const auto sortOrder  = this->getSortOrder();
-            CWorker *worker = CWorker::fromTask(this, "ModelSort", [this, container, sortColumn, sortOrder]()
+
+            // with a filter the diff of the filtered rows is computed when updating
+            const ContainerType base = this->hasFilter() ? ContainerType() : m_container;
+            const auto diff = std::make_shared<CListModelDiff>();
+            CWorker *worker = CWorker::fromTask(this, "ModelSort", [this, container, sortColumn, sortOrder, base, diff]()
             {
-                return this->sortContainerByColumn(container, sortColumn, sortOrder);
+                const ContainerType sortedContainer = this->sortContainerByColumn(container, sortColumn, sortOrder);
+                *diff = this->diffRows(base, sortedContainer);
+                return sortedContainer;
             });
-            worker->thenWithResult<ContainerType>(this, [this](const ContainerType & sortedContainer)
+            worker->thenWithResult<ContainerType>(this, [this, base, diff](const ContainerType & sortedContainer)
             {
                 if (m_modelDestroyed) { return;  }
+                this->setPreparedDiff(base, sortedContainer, *diff);
                 this->update(sortedContainer, false);
             });
             worker->then(this, &CListModelBase::asyncUpdateFinished);
             return worker;
         }
 
+        template <typename T, bool UseCompare>
+        CListModelDiff CListModelBase<T, UseCompare>::diffRows(const ContainerType &oldRows, const ContainerType &newRows) const
+        {
+            if (oldRows.isEmpty() || newRows.isEmpty()) { return {}; }
+            if (this->objectKey(newRows.front()).isEmpty()) { return {}; } // no keys for this model
+
+            QStringList oldKeys;
+            oldKeys.reserve(oldRows.size());
+            for (const ObjectType &object : oldRows) { oldKeys.push_back(this->objectKey(object)); }
+            QStringList newKeys;
+            newKeys.reserve(newRows.size());
+            for (const ObjectType &object : newRows) { newKeys.push_back(this->objectKey(object)); }
+
+            CListModelDiff diff(oldKeys, newKeys);
+            if (!diff.isValid()) { return diff; }
+
+            QVector<int> changedRows;
+            const QVector<int> &oldRowsOfNewRows = diff.getOldRows();
+            for (int row = 0; row < newRows.size(); ++row)
+            {
+                const int oldRow = oldRowsOfNewRows.at(row);
+                if (oldRow >= 0 && newRows[row] != oldRows[oldRow]) { changedRows.push_back(row); }
+            }
+            diff.setChangedRows(changedRows);
+            return diff;
+        }
+
+        template <typename T, bool UseCompare>
+        void CListModelBase<T, UseCompare>::setPreparedDiff(const ContainerType &base, const ContainerType &container, const CListModelDiff &diff)
+        {
+            m_preparedDiffBase = base;
+            m_preparedDiffContainer = container;
+            m_preparedDiff = diff;
+        }
+
+        template <typename T, bool UseCompare>
+        void CListModelBase<T, UseCompare>::updateByDiff(const ContainerType &rows, const CListModelDiff &diff)
+        {
+            ContainerType &displayed = this->hasFilter() ? m_containerFiltered : m_container;
+
+            // backwards, so the rows of the remaining ranges do not change
+            const QVector<CListModelDiff::RowRange> &removed = diff.getRemovedRanges();
+            for (auto range = removed.crbegin(); range != removed.crend(); ++range)
+            {
+                this->beginRemoveRows(QModelIndex(), range->first, range->second);
+                displayed.erase(displayed.begin() + range->first, displayed.begin() + range->second + 1);
+                this->endRemoveRows();
+            }
+
+            // kept rows in the new order, persistent indexes (selection, current index) move with them
+            if (diff.isReordered())
+            {
+                emit this->layoutAboutToBeChanged({}, QAbstractItemModel::VerticalSortHint);
+                const QVector<int> &order = diff.getKeptRowsOrder();
+                const ContainerType kept(displayed);
+                ContainerType reordered(kept);
+                for (int row = 0; row < kept.size(); ++row) { reordered[order.at(row)] = kept[row]; }
+                const QModelIndexList from = this->persistentIndexList();
+                QModelIndexList to;
+                to.reserve(from.size());
+                for (const QModelIndex &index : from) { to.push_back(this->index(order.at(index.row()), index.column())); }
+                this->changePersistentIndexList(from, to);
+                displayed = reordered;
+                emit this->layoutChanged({}, QAbstractItemModel::VerticalSortHint);
+            }
+
+            // ascending, the rows before a range are already the new rows
+            for (const CListModelDiff::RowRange &range : diff.getInsertedRanges())
+            {
+                this->beginInsertRows(QModelIndex(), range.first, range.second);
+                for (int row = range.first; row <= range.second; ++row) { displayed.insert(displayed.begin() + row, rows[row]); }
+                this->endInsertRows();
+            }
+
+            // same rows now, but with the changed objects
+            displayed = rows;
+            const int lastColumn = this->columnCount() - 1;
+            m_updatingByDiff = true; // model data changed is signaled once by update
+            for (const CListModelDiff::RowRange &range : diff.getChangedRanges())
+            {
+                emit this->dataChanged(this->index(range.first, 0), this->index(range.second, lastColumn));
+            }
+            m_updatingByDiff = false;
+        }
+
+        template <typename T, bool UseCompare>
+        bool CListModelBase<T, UseCompare>::isSameData(const ContainerType &c1, const ContainerType &c2)
+        {
+            if (c1.size() != c2.size()) { return false; }
+            return c1.isEmpty() || &*c1.cbegin() == &*c2.cbegin();
+        }
+
         template <typename T, bool UseCompare>
         void CListModelBase<T, UseCompare>::updateContainerMaybeAsync(const ContainerType &container, bool sort)
         {
@@ -441,6 +565,7 @@ namespace BlackGui
             m_container.clear();
             m_containerFiltered.clear();
             endResetModel();
+            this->releaseSortKeys(m_container);
             this->emitModelDataChanged();
         }
 
@@ -478,9 +603,23 @@ namespace BlackGui
             Q_UNUSED(topLeft)
             Q_UNUSED(bottomRight)
             Q_UNUSED(roles)
+            if (m_updatingByDiff) { return; }
             this->emitModelDataChanged();
         }
 
+        template <typename T, bool UseCompare>
+        QString CListModelBase<T, UseCompare>::objectKey(const ObjectType &object) const
+        {
+            Q_UNUSED(object)
+            return {};
+        }
+
+        template <typename T, bool UseCompare>
+        CVariant CListModelBase<T, UseCompare>::sortValue(const ObjectType &object, const CPropertyIndex &propertyIndex) const
+        {
+            return object.propertyByIndex(propertyIndex);
+        }
+
         template <typename T, bool UseCompare>
         void CListModelBase<T, UseCompare>::onChangedDigest()
         {
@@ -564,8 +703,77 @@ namespace BlackGui
             {
                 return Private::compareForModelSort<ObjectType>(a, b, order, propertyIndex, tieBreakersCopy, marker);
             };
+            const CListModelSortKeys keys = this->sortKeys(container, propertyIndex);
+            if (!keys.isValid())
+            {
+                // no keys, compare the objects
+                return container.sorted(p);
+            }
+
+            // sort the rows by their keys, like compareForModelSort, the tie breakers still compare the objects
+            const bool hasTieBreakers = !tieBreakersCopy.isEmpty();
+            const CPropertyIndex tieBreaker = hasTieBreakers ? tieBreakersCopy.front() : CPropertyIndex();
+            const CPropertyIndexList nextTieBreakers = hasTieBreakers ? tieBreakersCopy.copyFrontRemoved() : CPropertyIndexList();
+            QVector<int> rows(container.size());
+            std::iota(rows.begin(), rows.end(), 0);
+            std::sort(rows.begin(), rows.end(), [&](int row1, int row2) -> bool
+            {
+                if (keys.isEqual(row1, row2))
+                {
+                    if (!hasTieBreakers) { return false; }
+                    return Private::compareForModelSort<ObjectType>(container[row1], container[row2], order, tieBreaker, nextTieBreakers, marker);
+                }
+                return (order == Qt::AscendingOrder) ? keys.isLess(row1, row2) : keys.isLess(row2, row1);
+            });
+
+            ContainerType sorted;
+            for (int row : rows) { sorted.push_back(container[row]); }
+            const CListModelSortKeys sortedKeys = keys.permuted(rows);
+
+            // the values only replace comparePropertyByIndex if they sort alike
+            if (!Private::isSortedLikeCompare(sorted, sortedKeys, order, propertyIndex, marker))
+            {
+                QMutexLocker lock(&m_sortKeysMutex);
+                m_sortKeysUnlikeCompare.push_back(propertyIndex);
+                return container.sorted(p);
+            }
+
+            this->cacheSortKeys(sorted, propertyIndex, sortedKeys);
+            return sorted;
+        }
+
+        template <typename T, bool UseCompare>
+        CListModelSortKeys CListModelBase<T, UseCompare>::sortKeys(const ContainerType &container, const CPropertyIndex &propertyIndex) const
+        {
+            {
+                QMutexLocker lock(&m_sortKeysMutex);
+                if (m_sortKeysUnlikeCompare.contains(propertyIndex)) { return {}; }
+                if (m_sortKeysIndex == propertyIndex && isSameData(m_sortKeysContainer, container)) { return m_sortKeys; }
+            }
 
-            return container.sorted(p);
+            QVector<CVariant> values;
+            values.reserve(container.size());
+            for (const ObjectType &object : container) { values.push_back(this->sortValue(object, propertyIndex)); }
+            return CListModelSortKeys(values);
+        }
+
+        template <typename T, bool UseCompare>
+        void CListModelBase<T, UseCompare>::cacheSortKeys(const ContainerType &container, const CPropertyIndex &propertyIndex, const CListModelSortKeys &keys) const
+        {
+            QMutexLocker lock(&m_sortKeysMutex);
+            m_sortKeysContainer = container;
+            m_sortKeysIndex = propertyIndex;
+            m_sortKeys = keys;
+        }
+
+        template <typename T, bool UseCompare>
+        void CListModelBase<T, UseCompare>::releaseSortKeys(const ContainerType &container)
+        {
+            QMutexLocker lock(&m_sortKeysMutex);
+            if (isSameData(m_sortKeysContainer, container)) { return; }
+            m_sortKeysContainer.clear();
+            m_sortKeysIndex = CPropertyIndex();
+            m_sortKeys = CListModelSortKeys();
         }
 
         template <typename T, bool UseCompare>
@@ -12,6 +12,8 @@
 #define BLACKGUI_MODELS_LISTMODELBASE_H
 
 #include "blackgui/models/listmodelbasenontemplate.h"
+#include "blackgui/models/listmodeldiff.h"
+#include "blackgui/models/listmodelsortkeys.h"
 #include "blackgui/models/modelfilter.h"
 #include "blackgui/models/selectionmodel.h"
 
@@ -19,6 +21,7 @@
 #include <QJsonObject>
 #include <QModelIndex>
 #include <QModelIndexList>
+#include <QMutex>
 #include <QString>
 #include <QVariant>
 #include <QVector>
@@ -83,9 +86,10 @@ namespace BlackGui
             //! Update by new container
             //! \return int size after update
             //! \remarks a sorting is performed only if a valid sort column is set
+            //! \remarks if the rows have keys (\sa objectKey), only inserted, removed and changed rows are updated, otherwise the model is reset
             virtual int update(const ContainerType &container, bool sort = true);
 
-            //! Asynchronous update
+            //! Asynchronous update, sorting and the rows diff are computed in the background
             virtual BlackMisc::CWorker *updateAsync(const ContainerType &container, bool sort = true);
 
             //! Update by new container
@@ -120,8 +124,23 @@ namespace BlackGui
             //! \param column    column inder
             //! \param order     sort order (ascending / descending)
             //! \threadsafe under normal conditions thread safe as long as the column metadata are not changed
+            //! \remark the values of the sorted column are extracted once per row and kept for the sorted container,
+            //!         so sorting the same data again, e.g. in the other order, does not read them again
+            //! \remark with UseCompare the rows sorted by the values are checked to be sorted like comparePropertyByIndex,
+            //!         one comparison per row, otherwise the column is sorted by comparePropertyByIndex from then on
             ContainerType sortContainerByColumn(const ContainerType &container, int column, Qt::SortOrder order) const;
 
+            //! Diff of the rows, matched by their keys
+            //! \sa objectKey
+            //! \threadsafe as long as objectKey is
+            CListModelDiff diffRows(const ContainerType &oldRows, const ContainerType &newRows) const;
+
+            //! Use a diff computed in the background by the next update with exactly this container
+            //! \param base      the container the diff is based on, used if it is still the current container
+            //! \param container the updated container
+            //! \param diff      \sa diffRows
+            void setPreparedDiff(const ContainerType &base, const ContainerType &container, const CListModelDiff &diff);
+
             //! Similar to ContainerType::push_back
             virtual void push_back(const ObjectType &object);
 
@@ -181,10 +200,51 @@ namespace BlackGui
             //! Model changed
             void emitModelDataChanged();
 
+            //! Key identifying the object of a row across updates, e.g. the callsign
+            //! \remark an empty key means rows can not be matched, the default, and the model is reset on update
+            //! \threadsafe must be, as called in the background by updateAsync
+            virtual QString objectKey(const ObjectType &object) const;
+
+            //! Value of the object sorted by, the property value by default
+            //! \remark overridden where comparePropertyByIndex does not compare the property values, e.g. a level shown as string,
+            //!         so the column is sorted by the values
+            //! \threadsafe must be, as called in the background by sortContainerByColumn
+            virtual BlackMisc::CVariant sortValue(const ObjectType &object, const BlackMisc::CPropertyIndex &propertyIndex) const;
+
             ContainerType m_container;         //!< used container
             ContainerType m_containerFiltered; //!< cache for filtered container data
             std::unique_ptr<IModelFilter<ContainerType> > m_filter;     //!< used filter
             ISelectionModel<ContainerType> *m_selectionModel = nullptr; //!< selection model
+
+        private:
+            //! Apply the diff of the displayed rows
+            void updateByDiff(const ContainerType &rows, const CListModelDiff &diff);
+
+            //! Same data, not only same values
+            static bool isSameData(const ContainerType &c1, const ContainerType &c2);
+
+            //! Sort keys of the property for the rows of the container, cached if sorted before
+            //! \threadsafe
+            CListModelSortKeys sortKeys(const ContainerType &container, const BlackMisc::CPropertyIndex &propertyIndex) const;
+
+            //! Keep the sort keys for the sorted container
+            //! \threadsafe
+            void cacheSortKeys(const ContainerType &container, const BlackMisc::CPropertyIndex &propertyIndex, const CListModelSortKeys &keys) const;
+
+            //! Drop the cached sort keys unless they belong to the container
+            //! \threadsafe
+            void releaseSortKeys(const ContainerType &container);
+
+            ContainerType  m_preparedDiffBase;       //!< container the prepared diff is based on
+            ContainerType  m_preparedDiffContainer;  //!< container the prepared diff leads to
+            CListModelDiff m_preparedDiff;           //!< diff computed in the background
+            bool           m_updatingByDiff = false; //!< emitting the changed rows of a diff
+
+            mutable QMutex                    m_sortKeysMutex;     //!< sorting runs in the background
+            mutable ContainerType             m_sortKeysContainer; //!< sorted container of the cached keys
+            mutable BlackMisc::CPropertyIndex m_sortKeysIndex;     //!< property of the cached keys
+            mutable CListModelSortKeys        m_sortKeys;          //!< cached keys, in the order of the sorted container
+            mutable BlackMisc::CPropertyIndexList m_sortKeysUnlikeCompare; //!< properties whose values do not sort like comparePropertyByIndex
         };
 
         namespace Private
@@ -206,6 +266,31 @@ namespace BlackGui
                 return (order == Qt::AscendingOrder) ? (c < 0) : (c > 0);
             }
 
+            //! Rows sorted by their keys are also sorted like comparePropertyByIndex, checked for neighbouring rows only
+            //! \remark rows with different keys must not compare equal, as then the tie breakers would order them
+            template <class ContainerType>
+            bool isSortedLikeCompare(const ContainerType &sorted, const CListModelSortKeys &keys, Qt::SortOrder order, const BlackMisc::CPropertyIndex &index, std::true_type)
+            {
+                for (int row = 1; row < sorted.size(); ++row)
+                {
+                    const int c = sorted[row - 1].comparePropertyByIndex(index, sorted[row]);
+                    if (keys.isEqual(row - 1, row)) { if (c != 0) { return false; } }
+                    else if ((order == Qt::AscendingOrder) ? (c >= 0) : (c <= 0)) { return false; }
+                }
+                return true;
+            }
+
+            //! Without compare function the keys sort like the values
+            template <class ContainerType>
+            bool isSortedLikeCompare(const ContainerType &sorted, const CListModelSortKeys &keys, Qt::SortOrder order, const BlackMisc::CPropertyIndex &index, std::false_type)
+            {
+                Q_UNUSED(sorted)
+                Q_UNUSED(keys)
+                Q_UNUSED(order)
+                Q_UNUSED(index)
+                return true;
+            }
+
             //! Sort without compare function
             template <typename ObjectType>
             bool compareForModelSort(const ObjectType &a, const ObjectType &b, Qt::SortOrder order, const BlackMisc::CPropertyIndex &index, const BlackMisc::CPropertyIndexList &tieBreakers, std::false_type)
@@ -49,6 +49,12 @@ namespace BlackGui
             return m_highlightCallsigns.contains(callsignForIndex(index));
         }
 
+        template <typename T, bool UseCompare>
+        QString CListModelCallsignObjects<T, UseCompare>::objectKey(const ObjectType &object) const
+        {
+            return object.getCallsign().asString();
+        }
+
         // see here for the reason of thess forward instantiations
         // https://isocpp.org/wiki/faq/templates#separate-template-fn-defn-from-decl
         template class CListModelCallsignObjects<BlackMisc::Aviation::CAtcStationList, true>;
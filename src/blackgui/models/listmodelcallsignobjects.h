@@ -70,6 +70,10 @@ namespace BlackGui
             //! Constructor
             CListModelCallsignObjects(const QString &translationContext, QObject *parent = nullptr);
 
+            //! \copydoc CListModelBase::objectKey
+            //! \remark the callsign
+            virtual QString objectKey(const ObjectType &object) const override;
+
         private:
             BlackMisc::Aviation::CCallsignSet m_highlightCallsigns; //!< callsigns to be highlighted
             QColor m_highlightColor = Qt::green;
@@ -71,6 +71,12 @@ namespace BlackGui
             return m_highlightKeys.contains(dbKeyForIndex(index));
         }
 
+        template <typename T, typename K, bool UseCompare>
+        QString CListModelDbObjects<T, K, UseCompare>::objectKey(const ObjectType &object) const
+        {
+            return object.hasValidDbKey() ? object.getDbKeyAsString() : QString();
+        }
+
         template <typename T, typename K, bool UseCompare>
         COrderableListModelDbObjects<T, K, UseCompare>::COrderableListModelDbObjects(const QString &translationContext, QObject *parent)
             : CListModelDbObjects<ContainerType, KeyType, UseCompare>(translationContext, parent)
@@ -78,6 +78,10 @@ namespace BlackGui
             //! Constructor
             CListModelDbObjects(const QString &translationContext, QObject *parent = nullptr);
 
+            //! \copydoc CListModelBase::objectKey
+            //! \remark the DB key, objects without DB key can not be matched
+            virtual QString objectKey(const ObjectType &object) const override;
+
         private:
             QList<KeyType> m_highlightKeys; //!< keys to be highlighted
             QColor         m_highlightColor = Qt::green;
@@ -0,0 +1,109 @@
+/* Copyright (C) 2020
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+#include "blackgui/models/listmodeldiff.h"
+
+#include <QHash>
+#include <QSet>
+
+namespace BlackGui
+{
+    namespace Models
+    {
+        constexpr int CListModelDiff::MaxRowMoves;
+
+        CListModelDiff::CListModelDiff(const QStringList &oldKeys, const QStringList &newKeys)
+        {
+            if (oldKeys.isEmpty() || newKeys.isEmpty()) { return; }
+
+            QHash<QString, int> oldRowByKey;
+            oldRowByKey.reserve(oldKeys.size());
+            for (int row = 0; row < oldKeys.size(); ++row)
+            {
+                const QString &key = oldKeys.at(row);
+                if (key.isEmpty() || oldRowByKey.contains(key)) { return; }
+                oldRowByKey.insert(key, row);
+            }
+
+            QVector<bool> kept(oldKeys.size(), false);
+            QSet<QString> insertedKeys;
+            QVector<int> insertedRows;
+            int lastKeptRow = -1;
+            m_oldRows.reserve(newKeys.size());
+            for (int row = 0; row < newKeys.size(); ++row)
+            {
+                const QString &key = newKeys.at(row);
+                if (key.isEmpty()) { return; }
+                const int oldRow = oldRowByKey.value(key, -1);
+                if (oldRow >= 0)
+                {
+                    if (kept.at(oldRow)) { return; } // duplicate key
+                    kept[oldRow] = true;
+                    if (oldRow < lastKeptRow) { m_reordered = true; }
+                    lastKeptRow = oldRow;
+                }
+                else
+                {
+                    if (insertedKeys.contains(key)) { return; } // duplicate key
+                    insertedKeys.insert(key);
+                    insertedRows.push_back(row);
+                }
+                m_oldRows.push_back(oldRow);
+            }
+
+            QVector<int> removedRows;
+            QVector<int> keptRowAfterRemoval(oldKeys.size(), -1);
+            int keptRows = 0;
+            for (int row = 0; row < oldKeys.size(); ++row)
+            {
+                if (kept.at(row)) { keptRowAfterRemoval[row] = keptRows++; }
+                else { removedRows.push_back(row); }
+            }
+            m_removedRanges = toRanges(removedRows);
+            m_insertedRanges = toRanges(insertedRows);
+
+            // every removed range and every inserted row shifts the rows behind it
+            const qint64 rowMoves = static_cast<qint64>(m_removedRanges.size()) * oldKeys.size() + static_cast<qint64>(insertedRows.size()) * newKeys.size();
+            if (rowMoves > MaxRowMoves) { return; }
+
+            if (m_reordered)
+            {
+                m_keptRowsOrder.resize(keptRows);
+                int position = 0;
+                for (int oldRow : m_oldRows)
+                {
+                    if (oldRow >= 0) { m_keptRowsOrder[keptRowAfterRemoval.at(oldRow)] = position++; }
+                }
+            }
+            m_valid = true;
+        }
+
+        int CListModelDiff::getChangedRowsCount() const
+        {
+            return rowsCount(m_removedRanges) + rowsCount(m_insertedRanges) + rowsCount(m_changedRanges);
+        }
+
+        QVector<CListModelDiff::RowRange> CListModelDiff::toRanges(const QVector<int> &rows)
+        {
+            QVector<RowRange> ranges;
+            for (int row : rows)
+            {
+                if (!ranges.isEmpty() && ranges.last().second + 1 == row) { ranges.last().second = row; }
+                else { ranges.push_back({ row, row }); }
+            }
+            return ranges;
+        }
+
+        int CListModelDiff::rowsCount(const QVector<RowRange> &ranges)
+        {
+            int count = 0;
+            for (const RowRange &range : ranges) { count += range.second - range.first + 1; }
+            return count;
+        }
+    } // namespace
+} // namespace
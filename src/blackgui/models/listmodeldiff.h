@@ -0,0 +1,93 @@
+/* Copyright (C) 2020
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \file
+
+#ifndef BLACKGUI_MODELS_LISTMODELDIFF_H
+#define BLACKGUI_MODELS_LISTMODELDIFF_H
+
+#include "blackgui/blackguiexport.h"
+
+#include <QPair>
+#include <QStringList>
+#include <QVector>
+
+namespace BlackGui
+{
+    namespace Models
+    {
+        /*!
+         * Differences between the rows of a list model and the rows of an update, matched by a unique key per row.
+         * Used to update a model by inserted, removed and changed rows instead of a model reset,
+         * so views keep selection and scroll position and only redraw what has changed.
+         */
+        class BLACKGUI_EXPORT CListModelDiff
+        {
+        public:
+            //! Range of rows, first and last row
+            using RowRange = QPair<int, int>;
+
+            //! Max. number of row moves (shifted by removals and insertions) before a model reset is cheaper
+            static constexpr int MaxRowMoves = 1000000;
+
+            //! Default constructor, invalid diff
+            CListModelDiff() {}
+
+            //! Diff of rows identified by their keys
+            //! \remark invalid if a key is empty or not unique, or if the update would move too many rows
+            CListModelDiff(const QStringList &oldKeys, const QStringList &newKeys);
+
+            //! Can be used for an incremental update?
+            bool isValid() const { return m_valid; }
+
+            //! Nothing inserted, removed, moved or changed
+            bool isEmpty() const { return m_removedRanges.isEmpty() && m_insertedRanges.isEmpty() && !m_reordered && m_changedRanges.isEmpty(); }
+
+            //! Old rows which are not in the new rows, ascending
+            const QVector<RowRange> &getRemovedRanges() const { return m_removedRanges; }
+
+            //! New rows which are not in the old rows, ascending
+            const QVector<RowRange> &getInsertedRanges() const { return m_insertedRanges; }
+
+            //! The old row of each new row, -1 for inserted rows
+            const QVector<int> &getOldRows() const { return m_oldRows; }
+
+            //! Kept rows are in another order than before
+            bool isReordered() const { return m_reordered; }
+
+            //! If reordered, for each kept row after the removal its position among the kept rows in the new order
+            const QVector<int> &getKeptRowsOrder() const { return m_keptRowsOrder; }
+
+            //! New rows whose objects have changed, ascending
+            const QVector<RowRange> &getChangedRanges() const { return m_changedRanges; }
+
+            //! Set the new rows whose objects have changed
+            //! \param rows ascending rows
+            void setChangedRows(const QVector<int> &rows) { m_changedRanges = toRanges(rows); }
+
+            //! Number of rows inserted, removed and changed
+            int getChangedRowsCount() const;
+
+        private:
+            //! Ascending rows to ranges
+            static QVector<RowRange> toRanges(const QVector<int> &rows);
+
+            //! Number of rows in ranges
+            static int rowsCount(const QVector<RowRange> &ranges);
+
+            bool m_valid = false;
+            bool m_reordered = false;
+            QVector<int> m_oldRows;
+            QVector<int> m_keptRowsOrder;
+            QVector<RowRange> m_removedRanges;
+            QVector<RowRange> m_insertedRanges;
+            QVector<RowRange> m_changedRanges;
+        };
+    } // namespace
+} // namespace
+#endif // guard
@@ -0,0 +1,129 @@
+/* Copyright (C) 2020
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+#include "blackgui/models/listmodelsortkeys.h"
+
+#include <QDateTime>
+#include <QMetaType>
+
+using namespace BlackMisc;
+
+namespace BlackGui
+{
+    namespace Models
+    {
+        CListModelSortKeys::CListModelSortKeys(const QVector<CVariant> &values)
+        {
+            if (values.isEmpty()) { return; }
+
+            // typed keys only if all values are of the same type
+            const int type = values.front().userType();
+            bool sameType = true;
+            bool validTimestamps = true;
+            for (const CVariant &value : values)
+            {
+                if (value.userType() != type) { sameType = false; break; }
+                if (type == QMetaType::QDateTime && !value.value<QDateTime>().isValid()) { validTimestamps = false; }
+            }
+
+            if (sameType && type == QMetaType::QString)
+            {
+                m_type = StringKeys;
+                m_strings.reserve(values.size());
+                for (const CVariant &value : values) { m_strings.push_back(value.value<QString>()); }
+            }
+            else if (sameType && (isInteger(type) || (type == QMetaType::QDateTime && validTimestamps)))
+            {
+                // invalid timestamps do not compare by their msecs, they are compared as variants
+                m_type = IntegerKeys;
+                m_integers.reserve(values.size());
+                const bool timestamps = type == QMetaType::QDateTime;
+                for (const CVariant &value : values)
+                {
+                    m_integers.push_back(timestamps ? value.value<QDateTime>().toMSecsSinceEpoch() : value.toLongLong());
+                }
+            }
+            else if (sameType && isNumber(type))
+            {
+                m_type = NumberKeys;
+                m_numbers.reserve(values.size());
+                for (const CVariant &value : values) { m_numbers.push_back(value.toDouble()); }
+            }
+            else
+            {
+                m_type = VariantKeys;
+                m_variants = values;
+            }
+        }
+
+        int CListModelSortKeys::size() const
+        {
+            switch (m_type)
+            {
+            case StringKeys:  return m_strings.size();
+            case IntegerKeys: return m_integers.size();
+            case NumberKeys:  return m_numbers.size();
+            case VariantKeys: return m_variants.size();
+            default: return 0;
+            }
+        }
+
+        CListModelSortKeys CListModelSortKeys::permuted(const QVector<int> &rows) const
+        {
+            CListModelSortKeys keys;
+            if (rows.size() != this->size()) { return keys; }
+            keys.m_type = m_type;
+            switch (m_type)
+            {
+            case StringKeys:
+                keys.m_strings.reserve(rows.size());
+                for (int row : rows) { keys.m_strings.push_back(m_strings[row]); }
+                break;
+            case IntegerKeys:
+                keys.m_integers.reserve(rows.size());
+                for (int row : rows) { keys.m_integers.push_back(m_integers[row]); }
+                break;
+            case NumberKeys:
+                keys.m_numbers.reserve(rows.size());
+                for (int row : rows) { keys.m_numbers.push_back(m_numbers[row]); }
+                break;
+            case VariantKeys:
+                keys.m_variants.reserve(rows.size());
+                for (int row : rows) { keys.m_variants.push_back(m_variants[row]); }
+                break;
+            default: break;
+            }
+            return keys;
+        }
+
+        bool CListModelSortKeys::isInteger(int type)
+        {
+            switch (type)
+            {
+            case QMetaType::Bool:
+            case QMetaType::Char:
+            case QMetaType::SChar:
+            case QMetaType::UChar:
+            case QMetaType::Short:
+            case QMetaType::UShort:
+            case QMetaType::Int:
+            case QMetaType::UInt:
+            case QMetaType::Long:
+            case QMetaType::LongLong:
+                return true;
+            default:
+                return false;
+            }
+        }
+
+        bool CListModelSortKeys::isNumber(int type)
+        {
+            return type == QMetaType::Double || type == QMetaType::Float;
+        }
+    } // namespace
+} // namespace
@@ -0,0 +1,102 @@
+/* Copyright (C) 2020
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \file
+
+#ifndef BLACKGUI_MODELS_LISTMODELSORTKEYS_H
+#define BLACKGUI_MODELS_LISTMODELSORTKEYS_H
+
+#include "blackgui/blackguiexport.h"
+#include "blackmisc/variant.h"
+
+#include <QString>
+#include <QVector>
+#include <QtGlobal>
+
+namespace BlackGui
+{
+    namespace Models
+    {
+        /*!
+         * Values of the sorted column of a list model, extracted once per row,
+         * so sorting compares typed values instead of reading the property of both objects in every comparison.
+         */
+        class BLACKGUI_EXPORT CListModelSortKeys
+        {
+        public:
+            //! Default constructor, no keys
+            CListModelSortKeys() {}
+
+            //! Keys from the values of the sorted property, one per row
+            //! \param values property values of the rows
+            //! \remark the keys compare like the values as BlackMisc::CVariant, i.e. strings case sensitive,
+            //!         not like comparePropertyByIndex
+            explicit CListModelSortKeys(const QVector<BlackMisc::CVariant> &values);
+
+            //! Any keys?
+            bool isValid() const { return m_type != NoKeys; }
+
+            //! Number of keys
+            int size() const;
+
+            //! Key of row1 is less than key of row2
+            bool isLess(int row1, int row2) const
+            {
+                switch (m_type)
+                {
+                case StringKeys:  return m_strings[row1] < m_strings[row2];
+                case IntegerKeys: return m_integers[row1] < m_integers[row2];
+                case NumberKeys:  return m_numbers[row1] < m_numbers[row2];
+                case VariantKeys: return m_variants[row1] < m_variants[row2];
+                default: return false;
+                }
+            }
+
+            //! Keys are equal
+            bool isEqual(int row1, int row2) const
+            {
+                switch (m_type)
+                {
+                case StringKeys:  return m_strings[row1] == m_strings[row2];
+                case IntegerKeys: return m_integers[row1] == m_integers[row2];
+                case NumberKeys:  return m_numbers[row1] == m_numbers[row2];
+                case VariantKeys: return m_variants[row1] == m_variants[row2];
+                default: return false;
+                }
+            }
+
+            //! The keys in another order
+            //! \param rows for each row of the result, the row of this
+            CListModelSortKeys permuted(const QVector<int> &rows) const;
+
+        private:
+            //! Kind of keys
+            enum KeyType
+            {
+                NoKeys,
+                StringKeys,  //!< strings
+                IntegerKeys, //!< integers, booleans, timestamps
+                NumberKeys,  //!< floating point numbers
+                VariantKeys  //!< any other value
+            };
+
+            //! Sorted by the values as integer?
+            static bool isInteger(int type);
+
+            //! Sorted by the values as floating point number?
+            static bool isNumber(int type);
+
+            KeyType m_type = NoKeys;
+            QVector<QString> m_strings;
+            QVector<qint64> m_integers;
+            QVector<double> m_numbers;
+            QVector<BlackMisc::CVariant> m_variants;
+        };
+    } // namespace
+} // namespace
+#endif // guard
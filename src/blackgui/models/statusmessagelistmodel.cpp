@@ -136,5 +136,19 @@ namespace BlackGui
             }
             return CListModelTimestampObjects::data(index, role);
         }
+
+        CVariant CStatusMessageListModel::sortValue(const CStatusMessage &message, const CPropertyIndex &propertyIndex) const
+        {
+            if (propertyIndex.isMyself()) { return CVariant::from(static_cast<int>(message.getSeverity())); }
+            switch (propertyIndex.frontCasted<CStatusMessage::ColumnIndex>())
+            {
+            case CStatusMessage::IndexSeverity:
+            case CStatusMessage::IndexSeverityAsString:
+            case CStatusMessage::IndexSeverityAsIcon:
+                return CVariant::from(static_cast<int>(message.getSeverity()));
+            default: break;
+            }
+            return CListModelTimestampObjects::sortValue(message, propertyIndex);
+        }
     } // namespace
 } // namespace
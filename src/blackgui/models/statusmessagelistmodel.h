@@ -61,6 +61,11 @@ namespace BlackGui
             //! Sorted by timestamp or order
             static bool sortedByTimestampOrOrder(const BlackMisc::CPropertyIndex &p);
 
+        protected:
+            //! \copydoc CListModelBase::sortValue
+            //! \remark the severity is sorted by its level, not by its string
+            virtual BlackMisc::CVariant sortValue(const BlackMisc::CStatusMessage &message, const BlackMisc::CPropertyIndex &propertyIndex) const override;
+
         private:
             Mode m_mode; //!< used mode
         };
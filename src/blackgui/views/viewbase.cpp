@@ -20,6 +20,7 @@
 #include <QFileDialog>
 #include <QTextEdit>
 #include <QStringBuilder>
+#include <memory>
 
 using namespace BlackMisc;
 using namespace BlackGui;
@@ -110,12 +111,19 @@ namespace BlackGui
             const auto sortColumn = model->getSortColumn();
             const auto sortOrder  = model->getSortOrder();
             this->showLoadIndicator(container.size());
-            CWorker *worker = CWorker::fromTask(this, "ViewSort", [model, container, sortColumn, sortOrder]()
+
+            // rows diff for the model update, with a filter it is computed when updating
+            const ContainerType base = model->hasFilter() ? ContainerType() : model->container();
+            const auto diff = std::make_shared<CListModelDiff>();
+            CWorker *worker = CWorker::fromTask(this, "ViewSort", [model, container, sortColumn, sortOrder, base, diff]()
             {
-                return model->sortContainerByColumn(container, sortColumn, sortOrder);
+                const ContainerType sortedContainer = model->sortContainerByColumn(container, sortColumn, sortOrder);
+                *diff = model->diffRows(base, sortedContainer);
+                return sortedContainer;
             });
-            worker->thenWithResult<ContainerType>(this, [this, resize](const ContainerType & sortedContainer)
+            worker->thenWithResult<ContainerType>(this, [this, resize, base, diff](const ContainerType & sortedContainer)
             {
+                this->derivedModel()->setPreparedDiff(base, sortedContainer, *diff);
                 this->updateContainer(sortedContainer, false, resize);
             });
             worker->then(this, &CViewBase::asyncUpdateFinished);
@@ -0,0 +1,167 @@
+/* Copyright (C) 2020
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \file
+
+#ifndef BLACKMISC_AVIATION_CALLSIGNIDMAP_H
+#define BLACKMISC_AVIATION_CALLSIGNIDMAP_H
+
+#include "blackmisc/aviation/callsigninterner.h"
+#include "blackmisc/aviation/callsign.h"
+
+#include <QList>
+#include <QVector>
+#include <QtGlobal>
+#include <algorithm>
+#include <utility>
+
+namespace BlackMisc
+{
+    namespace Aviation
+    {
+        /*!
+         * Per callsign values keyed by the interned callsign id, a drop-in for the QHash<CCallsign, T> used per callsign
+         * \details Values are stored densely in a vector, a second vector maps the id to the value position.
+         *          A lookup by id is two array accesses, no string is hashed or compared.
+         *          Lookups by CCallsign resolve the id via CCallsignInterner once.
+         * \remark like QVector, references are invalidated by inserting or removing values
+         * \remark not thread safe, guard with the same lock as the QHash it replaces
+         */
+        template <class T>
+        class CCallsignIdMap
+        {
+        public:
+            //! STL compatibility
+            //! @{
+            using value_type     = T;
+            using iterator       = typename QVector<T>::iterator;
+            using const_iterator = typename QVector<T>::const_iterator;
+            //! @}
+
+            //! Value exists?
+            //! @{
+            bool contains(int id) const { return this->valueIndex(id) >= 0; }
+            bool contains(const CCallsign &callsign) const { return this->contains(CCallsignInterner::findId(callsign)); }
+            //! @}
+
+            //! Value, inserted as default constructed value if not existing
+            //! @{
+            T &operator [](int id)
+            {
+                Q_ASSERT_X(id >= 0, Q_FUNC_INFO, "invalid id");
+                int index = this->valueIndex(id);
+                if (index < 0)
+                {
+                    if (id >= m_valueIndexes.size())
+                    {
+                        // new positions have no value
+                        const int oldSize = m_valueIndexes.size();
+                        m_valueIndexes.resize(id + 1);
+                        std::fill(m_valueIndexes.begin() + oldSize, m_valueIndexes.end(), -1);
+                    }
+                    index = m_values.size();
+                    m_values.push_back(T());
+                    m_ids.push_back(id);
+                    m_valueIndexes[id] = index;
+                }
+                return m_values[index];
+            }
+            T &operator [](const CCallsign &callsign) { return (*this)[CCallsignInterner::id(callsign)]; }
+            //! @}
+
+            //! Value or default constructed value, like the const QHash::operator[]
+            //! @{
+            const T operator [](int id) const { return this->value(id); }
+            const T operator [](const CCallsign &callsign) const { return this->value(callsign); }
+            //! @}
+
+            //! Value or default value
+            //! @{
+            T value(int id, const T &defaultValue = T()) const
+            {
+                const int index = this->valueIndex(id);
+                return index < 0 ? defaultValue : m_values.at(index);
+            }
+            T value(const CCallsign &callsign, const T &defaultValue = T()) const { return this->value(CCallsignInterner::findId(callsign), defaultValue); }
+            //! @}
+
+            //! Insert or replace value
+            //! @{
+            void insert(int id, const T &value) { (*this)[id] = value; }
+            void insert(const CCallsign &callsign, const T &value) { (*this)[callsign] = value; }
+            //! @}
+
+            //! Remove value, returns number of removed values like QHash::remove
+            //! @{
+            int remove(int id)
+            {
+                const int index = this->valueIndex(id);
+                if (index < 0) { return 0; }
+
+                // move the last value into the gap
+                const int last = m_values.size() - 1;
+                if (index != last)
+                {
+                    m_values[index] = std::move(m_values[last]);
+                    m_ids[index] = m_ids.at(last);
+                    m_valueIndexes[m_ids.at(index)] = index;
+                }
+                m_values.removeLast();
+                m_ids.removeLast();
+                m_valueIndexes[id] = -1;
+                return 1;
+            }
+            int remove(const CCallsign &callsign) { return this->remove(CCallsignInterner::findId(callsign)); }
+            //! @}
+
+            //! Remove all values
+            void clear() { m_values.clear(); m_ids.clear(); m_valueIndexes.clear(); }
+
+            //! Number of values
+            int size() const { return m_values.size(); }
+
+            //! No values?
+            bool isEmpty() const { return m_values.isEmpty(); }
+
+            //! All values, in no particular order
+            QList<T> values() const { return m_values.toList(); }
+
+            //! All callsigns with values, in the order of values()
+            QList<CCallsign> keys() const
+            {
+                QList<CCallsign> callsigns;
+                callsigns.reserve(m_ids.size());
+                for (int id : m_ids) { callsigns.push_back(CCallsignInterner::callsign(id)); }
+                return callsigns;
+            }
+
+            //! All ids with values, in the order of values()
+            const QVector<int> &ids() const { return m_ids; }
+
+            //! Iterate the values
+            //! @{
+            iterator begin() { return m_values.begin(); }
+            iterator end() { return m_values.end(); }
+            const_iterator begin() const { return m_values.cbegin(); }
+            const_iterator end() const { return m_values.cend(); }
+            const_iterator cbegin() const { return m_values.cbegin(); }
+            const_iterator cend() const { return m_values.cend(); }
+            //! @}
+
+        private:
+            //! Position of the value, -1 if none
+            int valueIndex(int id) const { return (id >= 0 && id < m_valueIndexes.size()) ? m_valueIndexes.at(id) : -1; }
+
+            QVector<T>   m_values;       //!< dense values
+            QVector<int> m_ids;          //!< id per value
+            QVector<int> m_valueIndexes; //!< value position per id, -1 if no value
+        };
+    } // namespace
+} // namespace
+
+#endif // guard
@@ -0,0 +1,67 @@
+/* Copyright (C) 2020
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+#include "blackmisc/aviation/callsigninterner.h"
+
+#include <QReadLocker>
+#include <QWriteLocker>
+
+namespace BlackMisc
+{
+    namespace Aviation
+    {
+        constexpr int CCallsignInterner::InvalidId;
+
+        int CCallsignInterner::id(const CCallsign &callsign)
+        {
+            CCallsignInterner &interner = instance();
+            const QString &key = callsign.asString();
+            {
+                QReadLocker l(&interner.m_lock);
+                const auto it = interner.m_ids.constFind(key);
+                if (it != interner.m_ids.constEnd()) { return it.value(); }
+            }
+
+            QWriteLocker l(&interner.m_lock);
+            const auto it = interner.m_ids.constFind(key); // might have been added meanwhile
+            if (it != interner.m_ids.constEnd()) { return it.value(); }
+            const int id = interner.m_callsigns.size();
+            interner.m_callsigns.push_back(callsign);
+            interner.m_ids.insert(key, id);
+            return id;
+        }
+
+        int CCallsignInterner::findId(const CCallsign &callsign)
+        {
+            const CCallsignInterner &interner = instance();
+            QReadLocker l(&interner.m_lock);
+            return interner.m_ids.value(callsign.asString(), InvalidId);
+        }
+
+        CCallsign CCallsignInterner::callsign(int id)
+        {
+            const CCallsignInterner &interner = instance();
+            QReadLocker l(&interner.m_lock);
+            if (id < 0 || id >= interner.m_callsigns.size()) { return {}; }
+            return interner.m_callsigns.at(id);
+        }
+
+        int CCallsignInterner::size()
+        {
+            const CCallsignInterner &interner = instance();
+            QReadLocker l(&interner.m_lock);
+            return interner.m_callsigns.size();
+        }
+
+        CCallsignInterner &CCallsignInterner::instance()
+        {
+            static CCallsignInterner interner;
+            return interner;
+        }
+    } // namespace
+} // namespace
@@ -0,0 +1,66 @@
+/* Copyright (C) 2020
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \file
+
+#ifndef BLACKMISC_AVIATION_CALLSIGNINTERNER_H
+#define BLACKMISC_AVIATION_CALLSIGNINTERNER_H
+
+#include "blackmisc/aviation/callsign.h"
+#include "blackmisc/blackmiscexport.h"
+
+#include <QHash>
+#include <QReadWriteLock>
+#include <QString>
+#include <QVector>
+
+namespace BlackMisc
+{
+    namespace Aviation
+    {
+        /*!
+         * Interning table for callsigns, each callsign gets a small integer id
+         * \details Ids are handed out in ascending order starting with 0 and stay valid for the lifetime of the process,
+         *          an id is never reused for another callsign. So an id can be cached (e.g. by an interpolator) and
+         *          used to access per callsign data without hashing any string, see CCallsignIdMap.
+         * \remark ids are process wide, the same callsign has the same id in all providers
+         */
+        class BLACKMISC_EXPORT CCallsignInterner
+        {
+        public:
+            //! Id of an unknown callsign
+            static constexpr int InvalidId = -1;
+
+            //! Id of the callsign, the callsign is interned if not yet known
+            //! \threadsafe
+            static int id(const CCallsign &callsign);
+
+            //! Id of the callsign, InvalidId if the callsign was never interned
+            //! \threadsafe
+            static int findId(const CCallsign &callsign);
+
+            //! Callsign for id, empty callsign for an invalid id
+            //! \threadsafe
+            static CCallsign callsign(int id);
+
+            //! Number of interned callsigns, also the upper bound of all ids
+            //! \threadsafe
+            static int size();
+
+        private:
+            //! The process wide table
+            static CCallsignInterner &instance();
+
+            QHash<QString, int> m_ids;        //!< unified callsign string to id
+            QVector<CCallsign>  m_callsigns;  //!< callsign per id
+            mutable QReadWriteLock m_lock;    //!< lock for the table
+        };
+    } // namespace
+} // namespace
+
+#endif // guard
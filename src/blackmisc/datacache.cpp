@@ -68,7 +68,7 @@ namespace BlackMisc
         CDataCacheRevision *m_rev = nullptr;
     };
 
-    CDataCache::CDataCache() : CValueCache(1), m_serializer(new CDataCacheSerializer { this, revisionFileName() })
+    CDataCache::CDataCache() : CValueCache(0), m_serializer(new CDataCacheSerializer { this, revisionFileName() })
     {
         if (! QDir::root().mkpath(persistentStore()))
         {
@@ -185,6 +185,16 @@ namespace BlackMisc
         if (triggerLoad) { loadFromStoreAsync(); }
     }
 
+    void CDataCache::useValue(const QString &key)
+    {
+        if (m_revision.admitValueOnce(key)) { loadFromStoreAsync(); }
+    }
+
+    bool CDataCache::isAdmitted(const QString &key) const
+    {
+        return m_revision.isAdmitted(key);
+    }
+
     void CDataCache::sessionValue(const QString &key)
     {
         singleShot(0, m_serializer, [this, key] { m_revision.sessionValue(key); });
@@ -424,14 +434,17 @@ namespace BlackMisc
                     }
                 }
 
-                auto deferrals = fromJson(json.value("deferrals").toArray());
                 m_admittedValues.unite(m_admittedQueue);
                 if (updateUuid) { m_admittedQueue.clear(); }
                 else if (! m_admittedQueue.isEmpty()) { m_admittedQueue.intersect(QSet<QString>(m_timestamps.keyBegin(), m_timestamps.keyEnd())); }
 
-                for (const auto &key : m_timestamps.keys()) // clazy:exclude=container-anti-pattern,range-loop
+                // besides the pins, only values used in this process are loaded, deferred values only once admitted
+                if (! pinsOnly)
                 {
-                    if (deferrals.contains(key) && ! m_admittedValues.contains(key)) { m_timestamps.remove(key); }
+                    for (const auto &key : m_timestamps.keys()) // clazy:exclude=container-anti-pattern,range-loop
+                    {
+                        if (! m_admittedValues.contains(key)) { m_timestamps.remove(key); }
+                    }
                 }
 
                 m_session->updateSession();
@@ -729,6 +742,22 @@ namespace BlackMisc
         m_admittedQueue.insert(key);
     }
 
+    bool CDataCacheRevision::admitValueOnce(const QString &key)
+    {
+        QMutexLocker lock(&m_mutex);
+
+        if (m_admittedValues.contains(key) || m_admittedQueue.contains(key)) { return false; }
+        m_admittedQueue.insert(key);
+        return true;
+    }
+
+    bool CDataCacheRevision::isAdmitted(const QString &key) const
+    {
+        QMutexLocker lock(&m_mutex);
+
+        return m_admittedValues.contains(key) || m_admittedQueue.contains(key);
+    }
+
     void CDataCacheRevision::sessionValue(const QString &key)
     {
         QMutexLocker lock(&m_mutex);
@@ -166,6 +166,13 @@ namespace BlackMisc
         //! Set the flag which will cause a deferred-load value to be loaded.
         void admitValue(const QString &key);
 
+        //! Set the flag which will cause a value to be loaded, unless it was already set.
+        //! \return True if the value was not yet admitted, i.e. a load must be triggered.
+        bool admitValueOnce(const QString &key);
+
+        //! True if the value was admitted to be loaded.
+        bool isAdmitted(const QString &key) const;
+
         //! Set the flag which will cause a value to be reset when starting a new session.
         void sessionValue(const QString &key);
 
@@ -244,6 +251,9 @@ namespace BlackMisc
      * Singleton derived class of CValueCache, for core dynamic data.
      *
      * File-based distribution between processes is built-in to the class.
+     * Every value is saved in its own file, so saving a value does not rewrite any other value.
+     * Apart from pinned values, only values used by a CData in this process are loaded,
+     * so a process does not pay for loading the caches it never reads.
      */
     class BLACKMISC_EXPORT CDataCache : public BlackMisc::CValueCache
     {
@@ -289,6 +299,12 @@ namespace BlackMisc
         //! Method used for implementing deferring values.
         void admitValue(const QString &key, bool triggerLoad);
 
+        //! Method used for implementing loading values on first use.
+        void useValue(const QString &key);
+
+        //! Method used for implementing CData::isAdmitted.
+        bool isAdmitted(const QString &key) const;
+
         //! Method used for implementing session values.
         void sessionValue(const QString &key);
 
@@ -333,6 +349,8 @@ namespace BlackMisc
             if (Trait::isPinned())   { CDataCache::instance()->pinValue(this->getKey()); }
             if (Trait::isDeferred()) { CDataCache::instance()->deferValue(this->getKey()); }
             if (Trait::isSession())  { CDataCache::instance()->sessionValue(this->getKey()); }
+            if (Trait::isBinary())   { CDataCache::instance()->setBinaryFormat(this->getKey()); }
+            if (! Trait::isDeferred()) { CDataCache::instance()->useValue(this->getKey()); }
             static_assert(!(Trait::isPinned() && Trait::isDeferred()), "trait can not be both pinned and deferred");
         }
 
@@ -382,6 +400,10 @@ namespace BlackMisc
         //! If the value is load-deferred, trigger the deferred load (async).
         void admit() { if (Trait::isDeferred()) { CDataCache::instance()->admitValue(this->getKey(), true); } }
 
+        //! True if the value is loaded in this process, false if it is load-deferred and was not admitted yet.
+        //! \remark reading a deferred value does not admit it, get() returns the default value until admit() or synchronize()
+        bool isAdmitted() const { return CDataCache::instance()->isAdmitted(this->getKey()); }
+
         //! If the value is currently being loaded, wait for it to finish loading, and call the notification slot, if any.
         void synchronize()
         {
@@ -477,6 +499,10 @@ namespace BlackMisc
         //! is retained only while there are applications using the cache.
         static constexpr bool isSession() { return false; }
 
+        //! If true, then value will be saved in its own binary file instead of Json.
+        //! Good for large values, which load much faster; Json import/export is still available by CValueCache::saveToJson.
+        static constexpr bool isBinary() { return false; }
+
         //! Deleted default constructor.
         TDataTrait() = delete;
 
@@ -0,0 +1,87 @@
+/* Copyright (C) 2020
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+#include "blackmisc/parallelfor.h"
+
+#include <QRunnable>
+#include <QSemaphore>
+#include <QThreadPool>
+#include <QtGlobal>
+#include <atomic>
+#include <memory>
+
+namespace BlackMisc
+{
+    namespace
+    {
+        //! State shared by all threads of one parallelFor call
+        struct ParallelForState
+        {
+            ParallelForState(int count, int chunkSize, const std::function<void(int)> &task) :
+                m_count(count), m_chunkSize(chunkSize), m_task(&task)
+            {}
+
+            //! Take and run chunks until all indexes are taken
+            void work()
+            {
+                while (true)
+                {
+                    const int begin = m_next.fetch_add(m_chunkSize);
+                    if (begin >= m_count) { return; } // late helpers end here and never touch the task
+                    const int end = qMin(begin + m_chunkSize, m_count);
+                    for (int i = begin; i < end; ++i) { (*m_task)(i); }
+                    m_done.release(end - begin);
+                }
+            }
+
+            const int m_count;
+            const int m_chunkSize;
+            const std::function<void(int)> *m_task; //!< only valid while indexes are left
+            std::atomic_int m_next { 0 };           //!< next index to be taken
+            QSemaphore m_done;                      //!< one per finished index
+        };
+
+        //! Helper running in the pool
+        class CParallelForRunnable : public QRunnable
+        {
+        public:
+            //! Constructor
+            explicit CParallelForRunnable(const std::shared_ptr<ParallelForState> &state) : m_state(state) {}
+
+            //! QRunnable::run
+            virtual void run() override { m_state->work(); }
+
+        private:
+            std::shared_ptr<ParallelForState> m_state; //!< kept alive until the helper ends
+        };
+    }
+
+    void parallelFor(QThreadPool *pool, int count, int chunkSize, const std::function<void(int)> &task)
+    {
+        if (count < 1) { return; }
+        chunkSize = qMax(1, chunkSize);
+        const int chunks = (count + chunkSize - 1) / chunkSize;
+        const int helpers = pool ? qMin(pool->maxThreadCount(), chunks - 1) : 0;
+        if (helpers < 1)
+        {
+            for (int i = 0; i < count; ++i) { task(i); }
+            return;
+        }
+
+        const auto state = std::make_shared<ParallelForState>(count, chunkSize, task);
+        for (int h = 0; h < helpers; ++h)
+        {
+            CParallelForRunnable *runnable = new CParallelForRunnable(state);
+            runnable->setAutoDelete(true);
+            pool->start(runnable);
+        }
+
+        state->work(); // the calling thread works too
+        state->m_done.acquire(count);
+    }
+} // ns
@@ -0,0 +1,37 @@
+/* Copyright (C) 2020
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \file
+
+#ifndef BLACKMISC_PARALLELFOR_H
+#define BLACKMISC_PARALLELFOR_H
+
+#include "blackmisc/blackmiscexport.h"
+
+#include <functional>
+
+class QThreadPool;
+
+namespace BlackMisc
+{
+    /*!
+     * Call task(i) for all i in [0, count) using the threads of a pool and the calling thread
+     * \details The indexes are handed out in chunks from a shared counter, whoever is idle takes the next chunk.
+     *          So threads finishing early take over the remaining work and uneven task durations are balanced.
+     *          Returns when all tasks have been called, the calling thread works itself and never idles.
+     * \param pool worker threads, with nullptr the tasks are called sequentially in the calling thread
+     * \param count number of tasks
+     * \param chunkSize number of indexes taken at once, bigger chunks mean less contention on the counter
+     * \param task called once per index, concurrently for different indexes
+     * \remark the order in which the tasks are called is undefined
+     * \threadsafe as long as task is safe to be called concurrently for different indexes
+     */
+    BLACKMISC_EXPORT void parallelFor(QThreadPool *pool, int count, int chunkSize, const std::function<void(int)> &task);
+} // ns
+
+#endif // guard
@@ -822,6 +822,23 @@ namespace BlackMisc
             return qRound(0.5 * (icaoScore + liveryScore));
         }
 
+        int CAircraftModel::calculateMaxScore(const CAircraftModel &compareModel) const
+        {
+            // ICAO: 100 for DB equal, otherwise designator 50 + rank 15 or family 40, plus manufacturer 10 and military 8
+            // livery: 100 for DB equal, otherwise 85 at most
+            const CAircraftIcaoCode &icao = this->getAircraftIcaoCode();
+            const int icaoMax = icao.isDbEqual(compareModel.getAircraftIcaoCode()) ? 100 :
+                                (icao.hasValidDesignator() && icao.getDesignator() == compareModel.getAircraftIcaoCodeDesignator()) ? 83 : 58;
+            const int liveryMax = this->getLivery().isDbEqual(compareModel.getLivery()) ? 100 : 85;
+            return qRound(0.5 * (icaoMax + liveryMax));
+        }
+
+        int CAircraftModel::maxScoreUnrelatedModels()
+        {
+            static const int max = qRound(0.5 * (58 + 85));
+            return max;
+        }
+
         CStatusMessageList CAircraftModel::validate(bool withNestedObjects) const
         {
             static const CLogCategoryList cats(CLogCategoryList(this).withValidation());
@@ -412,6 +412,13 @@ namespace BlackMisc
             //! Calculate score
             int calculateScore(const CAircraftModel &compareModel, bool preferColorLiveries, CStatusMessageList *log = nullptr) const;
 
+            //! Upper bound of CAircraftModel::calculateScore, without comparing the details
+            //! \remark needs to be adjusted if the scoring of aircraft ICAO codes or liveries changes
+            int calculateMaxScore(const CAircraftModel &compareModel) const;
+
+            //! Upper bound of CAircraftModel::calculateScore for models with another aircraft designator and no DB equal aircraft ICAO code or livery
+            static int maxScoreUnrelatedModels();
+
             //! Validate
             CStatusMessageList validate(bool withNestedObjects) const;
 
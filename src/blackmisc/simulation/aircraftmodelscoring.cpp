@@ -0,0 +1,170 @@
+/* Copyright (C) 2020
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+#include "blackmisc/simulation/aircraftmodelscoring.h"
+#include "blackmisc/simulation/aircraftmodelsetindex.h"
+#include "blackmisc/aviation/callsign.h"
+#include "blackmisc/aviation/logutils.h"
+#include "blackmisc/parallelfor.h"
+#include "blackmisc/statusmessagelist.h"
+#include "blackmisc/stringutils.h"
+
+#include <QtGlobal>
+#include <algorithm>
+
+using namespace BlackMisc::Aviation;
+
+namespace BlackMisc
+{
+    namespace Simulation
+    {
+        void CAircraftModelScoring::score(const CAircraftModelList &models, const CAircraftModelSetIndex *setIndex, const CAircraftModel &remoteModel, bool preferColorLiveries, bool ignoreZeroScores, QThreadPool *pool, CStatusMessageList *log)
+        {
+            m_models = models;
+            m_maxScorePositions.clear();
+            m_topScores.clear();
+            m_maxScore = -1;
+            m_scoredCount = 0;
+            m_skippedCount = 0;
+
+            if (log)
+            {
+                this->scoreWithLog(remoteModel, preferColorLiveries, ignoreZeroScores, log);
+                this->finishTopScores();
+                return;
+            }
+
+            // related models first, only they can score better than the unrelated ones
+            const int count = models.sizeInt();
+            m_scores.fill(0, count);
+            QVector<int> related;
+            if (setIndex && setIndex->isIndexOf(models))
+            {
+                related = setIndex->findRelatedPositions(remoteModel);
+            }
+            else
+            {
+                for (int p = 0; p < count; p++)
+                {
+                    if (models[p].calculateMaxScore(remoteModel) > CAircraftModel::maxScoreUnrelatedModels()) { related.push_back(p); }
+                }
+            }
+            this->scorePositions(related, remoteModel, preferColorLiveries, pool);
+
+            int relatedAboveUnrelated = 0;
+            for (int p : related) { if (m_scores[p] > CAircraftModel::maxScoreUnrelatedModels()) { relatedAboveUnrelated++; } }
+
+            if (relatedAboveUnrelated >= m_topK)
+            {
+                // none of the others can reach the best score or any of the top K scores
+                m_skippedCount = count - related.size();
+                for (int p : related) { this->addScore(p, m_scores[p], ignoreZeroScores); }
+            }
+            else
+            {
+                QVector<int> unrelated;
+                unrelated.reserve(count - related.size());
+                auto r = related.cbegin();
+                for (int p = 0; p < count; p++)
+                {
+                    if (r != related.cend() && *r == p) { ++r; continue; }
+                    unrelated.push_back(p);
+                }
+                this->scorePositions(unrelated, remoteModel, preferColorLiveries, pool);
+                for (int p = 0; p < count; p++) { this->addScore(p, m_scores[p], ignoreZeroScores); }
+            }
+            this->finishTopScores();
+        }
+
+        CAircraftModelList CAircraftModelScoring::getMaxScoreModels() const
+        {
+            CAircraftModelList models;
+            for (auto it = m_maxScorePositions.crbegin(); it != m_maxScorePositions.crend(); ++it)
+            {
+                models.push_back(this->getModel(*it));
+            }
+            return models;
+        }
+
+        void CAircraftModelScoring::scoreWithLog(const CAircraftModel &remoteModel, bool preferColorLiveries, bool ignoreZeroScores, CStatusMessageList *log)
+        {
+            const CAircraftModelList &models = m_models;
+
+            // normally prefer colors if there is no airline
+            CLogUtilities::addLogDetailsToList(log, remoteModel.getCallsign(), QStringLiteral("Prefer color liveries: '%1', airline: '%2', ignore zero scores: '%3'").arg(boolToYesNo(preferColorLiveries), remoteModel.getAirlineIcaoCodeDesignator(), boolToYesNo(ignoreZeroScores)));
+            CLogUtilities::addLogDetailsToList(log, remoteModel.getCallsign(), QStringLiteral("--- Start scoring in list with %1 models").arg(models.size()));
+            CLogUtilities::addLogDetailsToList(log, remoteModel.getCallsign(), models.coverageSummaryForModel(remoteModel));
+
+            int c = 1;
+            for (int p = 0; p < models.sizeInt(); p++)
+            {
+                const CAircraftModel &model = models[p];
+                CStatusMessageList subMsgs;
+                const int score = model.calculateScore(remoteModel, preferColorLiveries, &subMsgs);
+                if (ignoreZeroScores && score < 1) { continue; }
+
+                CLogUtilities::addLogDetailsToList(log, remoteModel.getCallsign(), QStringLiteral("--- Calculating #%1 '%2'---").arg(c).arg(model.getModelStringAndDbKey()));
+                log->push_back(subMsgs);
+                CLogUtilities::addLogDetailsToList(log, remoteModel.getCallsign(), QStringLiteral("--- End calculating #%1 ---").arg(c));
+                c++;
+                this->addScore(p, score, ignoreZeroScores);
+            }
+            CLogUtilities::addLogDetailsToList(log, remoteModel.getCallsign(), QStringLiteral("--- End scoring ---"));
+        }
+
+        void CAircraftModelScoring::scorePositions(const QVector<int> &positions, const CAircraftModel &remoteModel, bool preferColorLiveries, QThreadPool *pool)
+        {
+            const CAircraftModelList &models = m_models;
+            int *scores = m_scores.data(); // each task writes its own position
+            parallelFor(pool, positions.size(), 32, [&](int i)
+            {
+                const int p = positions[i];
+                scores[p] = models[p].calculateScore(remoteModel, preferColorLiveries);
+            });
+        }
+
+        void CAircraftModelScoring::addScore(int position, int score, bool ignoreZeroScores)
+        {
+            if (ignoreZeroScores && score < 1) { return; }
+            m_scoredCount++;
+            if (score > m_maxScore)
+            {
+                m_maxScore = score;
+                m_maxScorePositions.clear();
+            }
+            if (score == m_maxScore) { m_maxScorePositions.push_back(position); }
+
+            // bounded heap, the worst of the top scores is in front
+            ScoredPosition scored;
+            scored.score = score;
+            scored.position = position;
+            if (m_topScores.size() < m_topK)
+            {
+                m_topScores.push_back(scored);
+                std::push_heap(m_topScores.begin(), m_topScores.end(), &CAircraftModelScoring::isBetter);
+            }
+            else if (isBetter(scored, m_topScores.front()))
+            {
+                std::pop_heap(m_topScores.begin(), m_topScores.end(), &CAircraftModelScoring::isBetter);
+                m_topScores.back() = scored;
+                std::push_heap(m_topScores.begin(), m_topScores.end(), &CAircraftModelScoring::isBetter);
+            }
+        }
+
+        void CAircraftModelScoring::finishTopScores()
+        {
+            std::sort_heap(m_topScores.begin(), m_topScores.end(), &CAircraftModelScoring::isBetter);
+        }
+
+        bool CAircraftModelScoring::isBetter(const ScoredPosition &s1, const ScoredPosition &s2)
+        {
+            if (s1.score != s2.score) { return s1.score > s2.score; }
+            return s1.position < s2.position;
+        }
+    } // namespace
+} // namespace
@@ -0,0 +1,114 @@
+/* Copyright (C) 2020
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \file
+
+#ifndef BLACKMISC_SIMULATION_AIRCRAFTMODELSCORING_H
+#define BLACKMISC_SIMULATION_AIRCRAFTMODELSCORING_H
+
+#include "blackmisc/simulation/aircraftmodellist.h"
+#include "blackmisc/blackmiscexport.h"
+
+#include <QVector>
+
+class QThreadPool;
+
+namespace BlackMisc
+{
+    class CStatusMessageList;
+
+    namespace Simulation
+    {
+        class CAircraftModelSetIndex;
+
+        /*!
+         * Scores the models of a list against a remote model and keeps the best ones only
+         * \details The models are scored in place by their position in the list. Only the positions with the
+         *          best score and a bounded list of the top K scores are kept, no model is copied for scoring.
+         *          With an index of the list, only the related models are scored first. If at least K of them score
+         *          better than CAircraftModel::maxScoreUnrelatedModels, all other models are skipped, as they cannot
+         *          reach any of the top K scores.
+         * \remark with a log all models are scored one by one with the same details as CAircraftModelList::scoreFull
+         */
+        class BLACKMISC_EXPORT CAircraftModelScoring
+        {
+        public:
+            //! Score of the model at a position
+            struct ScoredPosition
+            {
+                int score = 0;     //!< score
+                int position = -1; //!< position in the scored list
+            };
+
+            //! Constructor
+            //! \param topK number of best scores kept, see CAircraftModelScoring::getTopScores
+            explicit CAircraftModelScoring(int topK = 5) : m_topK(qMax(1, topK)) {}
+
+            //! Score the models
+            //! \param models scored models
+            //! \param setIndex index of the models or nullptr, skips models which cannot reach the top scores
+            //! \param remoteModel model to be matched
+            //! \param preferColorLiveries \sa CAircraftModel::calculateScore
+            //! \param ignoreZeroScores models with a score below 1 are ignored
+            //! \param pool threads to score in parallel, nullptr to score in the calling thread
+            //! \param log detailed scoring log, if given all models are scored sequentially
+            void score(const CAircraftModelList &models, const CAircraftModelSetIndex *setIndex,
+                       const CAircraftModel &remoteModel, bool preferColorLiveries, bool ignoreZeroScores,
+                       QThreadPool *pool, CStatusMessageList *log);
+
+            //! Best score, -1 if nothing was scored
+            int getMaxScore() const { return m_maxScore; }
+
+            //! Models with the best score, last scored model first (same order as in CAircraftModelList::scoreFull)
+            CAircraftModelList getMaxScoreModels() const;
+
+            //! Number of scored models, not counting ignored or skipped models
+            int getScoredCount() const { return m_scoredCount; }
+
+            //! Number of models skipped because they could not reach the top scores
+            int getSkippedCount() const { return m_skippedCount; }
+
+            //! Nothing scored?
+            bool isEmpty() const { return m_scoredCount < 1; }
+
+            //! The top K scores, best first, same scores in list order
+            //! \remark the same scores as if all models were scored, skipping does not change them
+            const QVector<ScoredPosition> &getTopScores() const { return m_topScores; }
+
+            //! Scored model at position
+            const CAircraftModel &getModel(int position) const { return m_models[position]; }
+
+        private:
+            //! Score all models sequentially with log, as CAircraftModelList::scoreFull does
+            void scoreWithLog(const CAircraftModel &remoteModel, bool preferColorLiveries, bool ignoreZeroScores, CStatusMessageList *log);
+
+            //! Score the models at the positions, in parallel if a pool is given
+            void scorePositions(const QVector<int> &positions, const CAircraftModel &remoteModel, bool preferColorLiveries, QThreadPool *pool);
+
+            //! Collect a calculated score
+            void addScore(int position, int score, bool ignoreZeroScores);
+
+            //! Sort the top scores, best first
+            void finishTopScores();
+
+            //! Better than other score?
+            static bool isBetter(const ScoredPosition &s1, const ScoredPosition &s2);
+
+            const int m_topK;                     //!< max. number of top scores
+            CAircraftModelList m_models;          //!< scored models, implicitly shared with the caller
+            QVector<int> m_scores;                //!< score per position
+            QVector<int> m_maxScorePositions;     //!< positions with the max. score, ascending
+            QVector<ScoredPosition> m_topScores;  //!< heap while scoring, sorted afterwards
+            int m_maxScore = -1;                  //!< best score
+            int m_scoredCount = 0;                //!< scored models
+            int m_skippedCount = 0;               //!< skipped models
+        };
+    } // namespace
+} // namespace
+
+#endif // guard
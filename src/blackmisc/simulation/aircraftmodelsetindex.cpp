@@ -0,0 +1,253 @@
+/* Copyright (C) 2020
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+#include "blackmisc/simulation/aircraftmodelsetindex.h"
+#include "blackmisc/aviation/aircrafticaocode.h"
+#include "blackmisc/aviation/airlineicaocode.h"
+#include "blackmisc/aviation/livery.h"
+
+#include <QtGlobal>
+#include <algorithm>
+#include <iterator>
+#include <utility>
+
+using namespace BlackMisc::Aviation;
+
+namespace BlackMisc
+{
+    namespace Simulation
+    {
+        CAircraftModelSetIndex::CAircraftModelSetIndex(const CAircraftModelList &models) :
+            m_models(models),
+            m_military(models.sizeInt()), m_vtol(models.sizeInt()), m_colorLivery(models.sizeInt())
+        {
+            // models are visited in set order, so all position vectors are ascending
+            int i = 0;
+            for (const CAircraftModel &model : models)
+            {
+                const CAircraftIcaoCode &icao = model.getAircraftIcaoCode();
+                const CAirlineIcaoCode &airline = model.getAirlineIcaoCode();
+                const CLivery &livery = model.getLivery();
+
+                const QString modelString = model.getModelString().toUpper();
+                const QString alias = model.getModelStringAlias().toUpper();
+                if (!modelString.isEmpty()) { m_byModelStringOrAlias[modelString].push_back(i); }
+                if (!alias.isEmpty() && alias != modelString) { m_byModelStringOrAlias[alias].push_back(i); }
+
+                m_byAircraftDesignator[icao.getDesignator()].push_back(i);
+                m_byAirlineDesignator[airline.getDesignator()].push_back(i);
+                m_byCombinedType[icao.getCombinedType()].push_back(i);
+                m_byManufacturer[icao.getManufacturer()].push_back(i);
+                if (icao.hasFamily()) { m_byFamily[icao.getFamily()].push_back(i); }
+                if (livery.hasCombinedCode()) { m_byLiveryCombinedCode[livery.getCombinedCode()].push_back(i); }
+                if (airline.getGroupId() >= 0) { m_byAirlineGroup[airline.getGroupId()].push_back(i); }
+                if (icao.isLoadedFromDb()) { m_byAircraftIcaoDbKey[icao.getDbKey()].push_back(i); }
+                if (livery.isLoadedFromDb()) { m_byLiveryDbKey[livery.getDbKey()].push_back(i); }
+
+                m_military.setBit(i, model.isMilitary());
+                m_colorLivery.setBit(i, livery.isColorLivery());
+                if (model.isVtol())
+                {
+                    m_vtol.setBit(i);
+                    m_vtolCount++;
+                }
+                i++;
+            }
+        }
+
+        bool CAircraftModelSetIndex::isIndexOf(const CAircraftModelList &models) const
+        {
+            // implicitly shared, an unmodified copy of the indexed list points to the same elements
+            if (models.size() != m_models.size()) { return false; }
+            return models.isEmpty() || &models.front() == &m_models.front();
+        }
+
+        CAircraftModel CAircraftModelSetIndex::findFirstByModelStringAliasOrDefault(const QString &modelString) const
+        {
+            if (modelString.isEmpty()) { return CAircraftModel(); }
+            for (int i : lookup(m_byModelStringOrAlias, modelString.toUpper()))
+            {
+                // the key is only a pre-selection, the model decides
+                const CAircraftModel &model = m_models[i];
+                if (model.matchesModelStringOrAlias(modelString, Qt::CaseInsensitive)) { return model; }
+            }
+            return CAircraftModel();
+        }
+
+        CAircraftModelList CAircraftModelSetIndex::findByIcaoDesignators(const CAircraftIcaoCode &aircraftIcaoCode, const CAirlineIcaoCode &airlineIcaoCode) const
+        {
+            const QString aircraft(aircraftIcaoCode.getDesignator());
+            const QString airline(airlineIcaoCode.getDesignator());
+            if (airline.isEmpty())  { return this->models(lookup(m_byAircraftDesignator, aircraft)); }
+            if (aircraft.isEmpty()) { return this->models(lookup(m_byAirlineDesignator, airline)); }
+
+            // walk the shorter list, check the other designator
+            const Indexes &byAircraft = lookup(m_byAircraftDesignator, aircraft);
+            const Indexes &byAirline  = lookup(m_byAirlineDesignator, airline);
+            const bool aircraftFirst  = byAircraft.size() <= byAirline.size();
+            CAircraftModelList found;
+            for (int i : (aircraftFirst ? byAircraft : byAirline))
+            {
+                const CAircraftModel &model = m_models[i];
+                const bool match = aircraftFirst ?
+                                   model.getAirlineIcaoCode().getDesignator() == airline :
+                                   model.getAircraftIcaoCode().getDesignator() == aircraft;
+                if (match) { found.push_back(model); }
+            }
+            return found;
+        }
+
+        CAircraftModelList CAircraftModelSetIndex::findByAircraftDesignatorAndLiveryCombinedCode(const QString &aircraftDesignator, const QString &combinedCode) const
+        {
+            if (aircraftDesignator.isEmpty()) { return CAircraftModelList(); }
+            CAircraftModelList found;
+            for (int i : lookup(m_byAircraftDesignator, aircraftDesignator.trimmed().toUpper()))
+            {
+                const CAircraftModel &model = m_models[i];
+                if (model.getLivery().matchesCombinedCode(combinedCode)) { found.push_back(model); }
+            }
+            return found;
+        }
+
+        CAircraftModelList CAircraftModelSetIndex::findByAirlineGroup(const CAirlineIcaoCode &airline) const
+        {
+            const int id = airline.getGroupId();
+            if (id < 0) { return CAircraftModelList(); }
+            return this->models(lookup(m_byAirlineGroup, id));
+        }
+
+        CAircraftModelList CAircraftModelSetIndex::findByLiveryCode(const CLivery &livery) const
+        {
+            if (!livery.hasCombinedCode()) { return CAircraftModelList(); }
+            return this->models(lookup(m_byLiveryCombinedCode, livery.getCombinedCode()));
+        }
+
+        CAircraftModelList CAircraftModelSetIndex::findByManufacturer(const QString &manufacturer) const
+        {
+            if (manufacturer.isEmpty()) { return CAircraftModelList(); }
+            return this->models(lookup(m_byManufacturer, manufacturer.toUpper().trimmed()));
+        }
+
+        CAircraftModelList CAircraftModelSetIndex::findByFamily(const QString &family) const
+        {
+            if (family.isEmpty()) { return CAircraftModelList(); }
+            return this->models(lookup(m_byFamily, family.toUpper().trimmed()));
+        }
+
+        CAircraftModelList CAircraftModelSetIndex::findByCombinedType(const QString &combinedType) const
+        {
+            if (combinedType.length() != 3) { return CAircraftModelList(); }
+            return this->models(this->combinedTypeIndexes(combinedType.trimmed().toUpper()));
+        }
+
+        CAircraftModelList CAircraftModelSetIndex::findByCombinedTypeWithColorLivery(const QString &combinedType) const
+        {
+            if (combinedType.length() != 3) { return CAircraftModelList(); }
+            return this->models(this->combinedTypeIndexes(combinedType.trimmed().toUpper()), m_colorLivery, true);
+        }
+
+        CAircraftModelList CAircraftModelSetIndex::findByCombinedAndManufacturer(const CAircraftIcaoCode &icao) const
+        {
+            return this->findByCombinedAndManufacturer(icao.getCombinedType(), icao.getManufacturer());
+        }
+
+        CAircraftModelList CAircraftModelSetIndex::findByCombinedAndManufacturer(const QString &combinedType, const QString &manufacturer) const
+        {
+            if (manufacturer.isEmpty()) { return this->findByCombinedType(combinedType); }
+            if (combinedType.isEmpty()) { return this->findByManufacturer(manufacturer); }
+            CAircraftModelList found;
+            for (int i : this->combinedTypeIndexes(combinedType))
+            {
+                const CAircraftModel &model = m_models[i];
+                if (model.getAircraftIcaoCode().matchesManufacturer(manufacturer)) { found.push_back(model); }
+            }
+            return found;
+        }
+
+        CAircraftModelList CAircraftModelSetIndex::findColorLiveries() const
+        {
+            return this->models(m_colorLivery, true);
+        }
+
+        CAircraftModelList CAircraftModelSetIndex::findByMilitaryFlag(bool military) const
+        {
+            return this->models(m_military, military);
+        }
+
+        CAircraftModelList CAircraftModelSetIndex::findByVtolFlag(bool vtol) const
+        {
+            return this->models(m_vtol, vtol);
+        }
+
+        QVector<int> CAircraftModelSetIndex::findRelatedPositions(const CAircraftModel &model) const
+        {
+            const Indexes &byDesignator = lookup(m_byAircraftDesignator, model.getAircraftIcaoCodeDesignator());
+            const Indexes &byIcao   = model.getAircraftIcaoCode().isLoadedFromDb() ? lookup(m_byAircraftIcaoDbKey, model.getAircraftIcaoCode().getDbKey()) : Indexes();
+            const Indexes &byLivery = model.getLivery().isLoadedFromDb() ? lookup(m_byLiveryDbKey, model.getLivery().getDbKey()) : Indexes();
+            if (byIcao.isEmpty() && byLivery.isEmpty()) { return byDesignator; }
+
+            // merge the ascending positions
+            Indexes designatorOrIcao;
+            std::set_union(byDesignator.cbegin(), byDesignator.cend(), byIcao.cbegin(), byIcao.cend(), std::back_inserter(designatorOrIcao));
+            Indexes related;
+            std::set_union(designatorOrIcao.cbegin(), designatorOrIcao.cend(), byLivery.cbegin(), byLivery.cend(), std::back_inserter(related));
+            return related;
+        }
+
+        CAircraftModelList CAircraftModelSetIndex::models(const Indexes &indexes) const
+        {
+            QVector<CAircraftModel> found;
+            found.reserve(indexes.size());
+            for (int i : indexes) { found.push_back(m_models[i]); }
+            return CAircraftModelList(std::move(found));
+        }
+
+        CAircraftModelList CAircraftModelSetIndex::models(const Indexes &indexes, const QBitArray &flags, bool flag) const
+        {
+            CAircraftModelList found;
+            for (int i : indexes)
+            {
+                if (flags.testBit(i) == flag) { found.push_back(m_models[i]); }
+            }
+            return found;
+        }
+
+        CAircraftModelList CAircraftModelSetIndex::models(const QBitArray &flags, bool flag) const
+        {
+            CAircraftModelList found;
+            for (int i = 0; i < flags.size(); i++)
+            {
+                if (flags.testBit(i) == flag) { found.push_back(m_models[i]); }
+            }
+            return found;
+        }
+
+        template <class Key>
+        const CAircraftModelSetIndex::Indexes &CAircraftModelSetIndex::lookup(const QHash<Key, Indexes> &hash, const Key &key)
+        {
+            static const Indexes empty;
+            const auto it = hash.constFind(key);
+            return it == hash.constEnd() ? empty : it.value();
+        }
+
+        CAircraftModelSetIndex::Indexes CAircraftModelSetIndex::combinedTypeIndexes(const QString &combinedType) const
+        {
+            // same rules as CAircraftIcaoCode::matchesCombinedType
+            if (combinedType.length() != 3) { return Indexes(); }
+            const QString cc(combinedType.toUpper().trimmed().replace(' ', '*').replace('-', '*'));
+            if (!cc.contains('*')) { return lookup(m_byCombinedType, cc); }
+
+            Indexes found;
+            for (int i = 0; i < m_models.sizeInt(); i++)
+            {
+                if (m_models[i].getAircraftIcaoCode().matchesCombinedType(combinedType)) { found.push_back(i); }
+            }
+            return found;
+        }
+    } // namespace
+} // namespace
@@ -0,0 +1,152 @@
+/* Copyright (C) 2020
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \file
+
+#ifndef BLACKMISC_SIMULATION_AIRCRAFTMODELSETINDEX_H
+#define BLACKMISC_SIMULATION_AIRCRAFTMODELSETINDEX_H
+
+#include "blackmisc/simulation/aircraftmodellist.h"
+#include "blackmisc/blackmiscexport.h"
+
+#include <QBitArray>
+#include <QHash>
+#include <QString>
+#include <QVector>
+
+namespace BlackMisc
+{
+    namespace Aviation
+    {
+        class CAircraftIcaoCode;
+        class CAirlineIcaoCode;
+        class CLivery;
+    }
+
+    namespace Simulation
+    {
+        /*!
+         * Immutable lookup index over a model set
+         * \details Built once whenever the model set changes, the finders then look up the matching models
+         *          in hash tables instead of scanning the whole set. The finders have the same names and
+         *          return the same models in the same order as the corresponding CAircraftModelList finders.
+         * \remark combined types with wildcards cannot be looked up and are found by scanning the set
+         * \threadsafe all finders are const, the index is never changed after construction
+         */
+        class BLACKMISC_EXPORT CAircraftModelSetIndex
+        {
+        public:
+            //! Default constructor, empty index
+            CAircraftModelSetIndex() {}
+
+            //! Index the given models
+            explicit CAircraftModelSetIndex(const CAircraftModelList &models);
+
+            //! The indexed models
+            const CAircraftModelList &getModels() const { return m_models; }
+
+            //! Number of indexed models
+            int size() const { return m_models.sizeInt(); }
+
+            //! Empty index?
+            bool isEmpty() const { return m_models.isEmpty(); }
+
+            //! Is this the index of exactly these models?
+            //! \remark true only if the list shares its data with the indexed models, cheap to call
+            bool isIndexOf(const CAircraftModelList &models) const;
+
+            //! \copydoc CAircraftModelList::findFirstByModelStringAliasOrDefault
+            //! \remark case insensitive only
+            CAircraftModel findFirstByModelStringAliasOrDefault(const QString &modelString) const;
+
+            //! \copydoc CAircraftModelList::findByIcaoDesignators
+            CAircraftModelList findByIcaoDesignators(const Aviation::CAircraftIcaoCode &aircraftIcaoCode, const Aviation::CAirlineIcaoCode &airlineIcaoCode) const;
+
+            //! \copydoc CAircraftModelList::findByAircraftDesignatorAndLiveryCombinedCode
+            CAircraftModelList findByAircraftDesignatorAndLiveryCombinedCode(const QString &aircraftDesignator, const QString &combinedCode) const;
+
+            //! \copydoc CAircraftModelList::findByAirlineGroup
+            CAircraftModelList findByAirlineGroup(const Aviation::CAirlineIcaoCode &airline) const;
+
+            //! \copydoc CAircraftModelList::findByLiveryCode
+            CAircraftModelList findByLiveryCode(const Aviation::CLivery &livery) const;
+
+            //! \copydoc CAircraftModelList::findByManufacturer
+            CAircraftModelList findByManufacturer(const QString &manufacturer) const;
+
+            //! \copydoc CAircraftModelList::findByFamily
+            CAircraftModelList findByFamily(const QString &family) const;
+
+            //! \copydoc CAircraftModelList::findByCombinedType
+            CAircraftModelList findByCombinedType(const QString &combinedType) const;
+
+            //! \copydoc CAircraftModelList::findByCombinedTypeWithColorLivery
+            CAircraftModelList findByCombinedTypeWithColorLivery(const QString &combinedType) const;
+
+            //! \copydoc CAircraftModelList::findByCombinedAndManufacturer(const Aviation::CAircraftIcaoCode &) const
+            CAircraftModelList findByCombinedAndManufacturer(const Aviation::CAircraftIcaoCode &icao) const;
+
+            //! \copydoc CAircraftModelList::findByCombinedAndManufacturer(const QString &, const QString &) const
+            CAircraftModelList findByCombinedAndManufacturer(const QString &combinedType, const QString &manufacturer) const;
+
+            //! \copydoc CAircraftModelList::findColorLiveries
+            CAircraftModelList findColorLiveries() const;
+
+            //! \copydoc CAircraftModelList::findByMilitaryFlag
+            CAircraftModelList findByMilitaryFlag(bool military) const;
+
+            //! \copydoc CAircraftModelList::findByVtolFlag
+            CAircraftModelList findByVtolFlag(bool vtol) const;
+
+            //! \copydoc CAircraftModelList::containsVtol
+            bool containsVtol() const { return m_vtolCount > 0; }
+
+            //! Positions of the models with the same aircraft designator or the same DB aircraft ICAO code or livery
+            //! \remark all other models score CAircraftModel::maxScoreUnrelatedModels at most
+            //! \return ascending positions in CAircraftModelSetIndex::getModels
+            QVector<int> findRelatedPositions(const CAircraftModel &model) const;
+
+        private:
+            using Indexes = QVector<int>; //!< ascending positions in m_models
+
+            //! Models at the given positions
+            CAircraftModelList models(const Indexes &indexes) const;
+
+            //! Models at the given positions, only those with the flag
+            CAircraftModelList models(const Indexes &indexes, const QBitArray &flags, bool flag) const;
+
+            //! Models with the flag
+            CAircraftModelList models(const QBitArray &flags, bool flag) const;
+
+            //! Positions for the key, empty if not indexed
+            template <class Key>
+            static const Indexes &lookup(const QHash<Key, Indexes> &hash, const Key &key);
+
+            //! Positions of the models with the combined type, wildcards are resolved by scanning
+            Indexes combinedTypeIndexes(const QString &combinedType) const;
+
+            CAircraftModelList      m_models;                   //!< indexed models
+            QHash<QString, Indexes> m_byModelStringOrAlias;     //!< upper case model string and alias
+            QHash<QString, Indexes> m_byAircraftDesignator;     //!< aircraft ICAO designator
+            QHash<QString, Indexes> m_byAirlineDesignator;      //!< airline ICAO designator
+            QHash<QString, Indexes> m_byCombinedType;           //!< combined type such as "L2J"
+            QHash<QString, Indexes> m_byFamily;                 //!< aircraft family
+            QHash<QString, Indexes> m_byManufacturer;           //!< aircraft manufacturer
+            QHash<QString, Indexes> m_byLiveryCombinedCode;     //!< livery combined code
+            QHash<int, Indexes>     m_byAirlineGroup;           //!< airline group id
+            QHash<int, Indexes>     m_byAircraftIcaoDbKey;      //!< DB key of aircraft ICAO codes loaded from DB
+            QHash<int, Indexes>     m_byLiveryDbKey;            //!< DB key of liveries loaded from DB
+            QBitArray               m_military;                 //!< military flag per model
+            QBitArray               m_vtol;                     //!< VTOL flag per model
+            QBitArray               m_colorLivery;              //!< color livery flag per model
+            int                     m_vtolCount = 0;            //!< number of VTOL models
+        };
+    } // namespace
+} // namespace
+
+#endif // guard
@@ -0,0 +1,41 @@
+/* Copyright (C) 2020
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+#include "blackmisc/simulation/aircraftsituationbuffer.h"
+
+using namespace BlackMisc::Aviation;
+
+namespace BlackMisc
+{
+    namespace Simulation
+    {
+        CAircraftSituationBuffer::CAircraftSituationBuffer(int capacity) : m_capacity(capacity)
+        {
+            Q_ASSERT_X(capacity > 0, Q_FUNC_INFO, "Need capacity");
+        }
+
+        void CAircraftSituationBuffer::clear()
+        {
+            QMutexLocker l(&m_writeMutex);
+            Snapshot snapshot = m_snapshot.read().get();
+            if (snapshot.situations.isEmpty()) { return; }
+            snapshot.situations.clear();
+            snapshot.latest = CAircraftSituation();
+            snapshot.lastModified = -1;
+            this->publish(std::move(snapshot), -1);
+        }
+
+        void CAircraftSituationBuffer::publish(Snapshot &&snapshot, qint64 modifiedTimestamp)
+        {
+            snapshot.situations.truncate(m_capacity);
+            if (modifiedTimestamp >= 0) { snapshot.lastModified = modifiedTimestamp; }
+            snapshot.epoch++;
+            m_snapshot.uniqueWrite() = std::move(snapshot);
+        }
+    } // namespace
+} // namespace
@@ -0,0 +1,103 @@
+/* Copyright (C) 2020
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \file
+
+#ifndef BLACKMISC_SIMULATION_AIRCRAFTSITUATIONBUFFER_H
+#define BLACKMISC_SIMULATION_AIRCRAFTSITUATIONBUFFER_H
+
+#include "blackmisc/aviation/aircraftsituationlist.h"
+#include "blackmisc/aviation/aircraftsituation.h"
+#include "blackmisc/lockfree.h"
+#include "blackmisc/blackmiscexport.h"
+
+#include <QMutex>
+#include <QMutexLocker>
+#include <QtGlobal>
+#include <utility>
+
+namespace BlackMisc
+{
+    namespace Simulation
+    {
+        /*!
+         * Fixed capacity situation history of one remote aircraft, one writer and many readers
+         * \details Each modification is published as a new immutable snapshot with an incremented epoch.
+         *          Readers take the latest snapshot without any lock and never see a partially modified history,
+         *          a snapshot stays valid as long as it is referenced, even if newer ones have been published.
+         *          The situations are implicitly shared, taking a snapshot does not copy them.
+         * \remark writers are serialized per aircraft only, so storing situations of one aircraft does not block any reader or writer of other aircraft
+         */
+        class BLACKMISC_EXPORT CAircraftSituationBuffer
+        {
+        public:
+            //! Published state of the buffer
+            struct Snapshot
+            {
+                Aviation::CAircraftSituationList situations; //!< situations, latest first
+                Aviation::CAircraftSituation latest;         //!< latest stored situation as received
+                qint64  lastModified = -1;                   //!< when modified, ms since epoch
+                quint64 epoch = 0;                           //!< number of published modifications
+            };
+
+            //! Constructor
+            explicit CAircraftSituationBuffer(int capacity);
+
+            //! Copy constructor
+            CAircraftSituationBuffer(const CAircraftSituationBuffer &) = delete;
+
+            //! Copy assignment operator
+            CAircraftSituationBuffer &operator =(const CAircraftSituationBuffer &) = delete;
+
+            //! Max.number of situations
+            int capacity() const { return m_capacity; }
+
+            //! The latest snapshot
+            //! \threadsafe lock free
+            LockFreeReader<const Snapshot> read() const { return m_snapshot.read(); }
+
+            //! Situations of the latest snapshot, latest first
+            //! \threadsafe lock free
+            Aviation::CAircraftSituationList situations() const { return m_snapshot.read()->situations; }
+
+            //! Number of published modifications
+            //! \threadsafe lock free
+            quint64 epoch() const { return m_snapshot.read()->epoch; }
+
+            //! Modify the situations and publish them as new snapshot
+            //! \param mutator called as bool mutator(Snapshot &), the snapshot is only published if true is returned
+            //! \param modifiedTimestamp marked as last modified timestamp, a negative value keeps the last modified timestamp
+            //! \return published?
+            //! \remark situations exceeding the capacity are cut off
+            //! \threadsafe writers are serialized
+            template <class F>
+            bool modify(F &&mutator, qint64 modifiedTimestamp)
+            {
+                QMutexLocker l(&m_writeMutex);
+                Snapshot snapshot = m_snapshot.read().get();
+                if (!std::forward<F>(mutator)(snapshot)) { return false; }
+                this->publish(std::move(snapshot), modifiedTimestamp);
+                return true;
+            }
+
+            //! Remove all situations
+            //! \threadsafe writers are serialized
+            void clear();
+
+        private:
+            //! Publish a new snapshot, write lock must be held
+            void publish(Snapshot &&snapshot, qint64 modifiedTimestamp);
+
+            const int m_capacity;          //!< max.number of situations
+            LockFree<Snapshot> m_snapshot; //!< published state
+            QMutex m_writeMutex;           //!< serializes writers
+        };
+    } // namespace
+} // namespace
+
+#endif // guard
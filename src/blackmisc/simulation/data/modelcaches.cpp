@@ -38,19 +38,19 @@ namespace BlackMisc
             QString IMultiSimulatorModelCaches::getInfoString() const
             {
                 static const QString is("FSX: %1 P3D: %2 FS9: %3 XP: %4 FG: %5");
-                return is.arg(this->getCachedModelsCount(CSimulatorInfo::FSX)).arg(this->getCachedModelsCount(CSimulatorInfo::P3D)).arg(this->getCachedModelsCount(CSimulatorInfo::FS9)).arg(this->getCachedModelsCount(CSimulatorInfo::XPLANE)).arg(this->getCachedModelsCount(CSimulatorInfo::FG));
+                return is.arg(this->getCachedModelsCountString(CSimulatorInfo::FSX), this->getCachedModelsCountString(CSimulatorInfo::P3D), this->getCachedModelsCountString(CSimulatorInfo::FS9), this->getCachedModelsCountString(CSimulatorInfo::XPLANE), this->getCachedModelsCountString(CSimulatorInfo::FG));
             }
 
             QString IMultiSimulatorModelCaches::getInfoStringFsFamily() const
             {
                 static const QString is("FSX: %1 P3D: %2 FS9: %3");
-                return is.arg(this->getCachedModelsCount(CSimulatorInfo::FSX)).arg(this->getCachedModelsCount(CSimulatorInfo::P3D)).arg(this->getCachedModelsCount(CSimulatorInfo::FS9));
+                return is.arg(this->getCachedModelsCountString(CSimulatorInfo::FSX), this->getCachedModelsCountString(CSimulatorInfo::P3D), this->getCachedModelsCountString(CSimulatorInfo::FS9));
             }
 
             QString IMultiSimulatorModelCaches::getCacheCountAndTimestamp(const CSimulatorInfo &simulator) const
             {
                 static const QString s("%1 models, ts: %2");
-                return s.arg(this->getCachedModelsCount(simulator)).arg(this->getCacheTimestamp(simulator).toString("yyyy-MM-dd HH:mm:ss"));
+                return s.arg(this->getCachedModelsCountString(simulator), this->getCacheTimestamp(simulator).toString("yyyy-MM-dd HH:mm:ss"));
             }
 
             void IMultiSimulatorModelCaches::gracefulShutdown()
@@ -81,9 +81,28 @@ namespace BlackMisc
 
             int IMultiSimulatorModelCaches::getCachedModelsCount(const CSimulatorInfo &simulator) const
             {
+                // do not load a deferred cache only to count its models
+                if (!this->isAdmitted(simulator)) { return -1; }
                 return this->getCachedModels(simulator).size();
             }
 
+            QString IMultiSimulatorModelCaches::getCachedModelsCountString(const CSimulatorInfo &simulator) const
+            {
+                static const QString notLoaded("not loaded");
+                const int c = this->getCachedModelsCount(simulator);
+                return c < 0 ? notLoaded : QString::number(c);
+            }
+
+            bool IMultiSimulatorModelCaches::hasCachedModels(const CSimulatorInfo &simulator) const
+            {
+                const int c = this->getCachedModelsCount(simulator);
+                if (c >= 0) { return c > 0; }
+
+                // not loaded, but saved: the timestamp on disk is known without loading the models
+                const QDateTime ts = this->getCacheTimestamp(simulator);
+                return ts.isValid() && ts.toMSecsSinceEpoch() > 0;
+            }
+
             bool IMultiSimulatorModelCaches::hasOtherVersionFile(const CApplicationInfo &info, const CSimulatorInfo &simulator) const
             {
                 const QString fn = this->getFilename(simulator);
@@ -166,7 +185,7 @@ namespace BlackMisc
                 CSimulatorInfo withModels;
                 for (const CSimulatorInfo &simInfo : CSimulatorInfo::allSimulators().asSingleSimulatorSet())
                 {
-                    if (this->getCachedModelsCount(simInfo) > 0)
+                    if (this->hasCachedModels(simInfo))
                     {
                         withModels.add(simInfo);
                     }
@@ -353,6 +372,23 @@ namespace BlackMisc
                 return false;
             }
 
+            bool CModelCaches::isAdmitted(const CSimulatorInfo &simulator) const
+            {
+                Q_ASSERT_X(simulator.isSingleSimulator(), Q_FUNC_INFO, "No single simulator");
+                switch (simulator.getSimulator())
+                {
+                case CSimulatorInfo::FS9:    return m_modelCacheFs9.isAdmitted();
+                case CSimulatorInfo::FSX:    return m_modelCacheFsx.isAdmitted();
+                case CSimulatorInfo::P3D:    return m_modelCacheP3D.isAdmitted();
+                case CSimulatorInfo::XPLANE: return m_modelCacheXP.isAdmitted();
+                case CSimulatorInfo::FG:     return m_modelCacheFG.isAdmitted();
+                default:
+                    Q_ASSERT_X(false, Q_FUNC_INFO, "wrong simulator");
+                    break;
+                }
+                return false;
+            }
+
             void CModelCaches::synchronizeCacheImpl(const CSimulatorInfo &simulator)
             {
                 Q_ASSERT_X(simulator.isSingleSimulator(), Q_FUNC_INFO, "No single simulator");
@@ -550,6 +586,23 @@ namespace BlackMisc
                 return false;
             }
 
+            bool CModelSetCaches::isAdmitted(const CSimulatorInfo &simulator) const
+            {
+                Q_ASSERT_X(simulator.isSingleSimulator(), Q_FUNC_INFO, "No single simulator");
+                switch (simulator.getSimulator())
+                {
+                case CSimulatorInfo::FS9:    return m_modelCacheFs9.isAdmitted();
+                case CSimulatorInfo::FSX:    return m_modelCacheFsx.isAdmitted();
+                case CSimulatorInfo::P3D:    return m_modelCacheP3D.isAdmitted();
+                case CSimulatorInfo::XPLANE: return m_modelCacheXP.isAdmitted();
+                case CSimulatorInfo::FG:     return m_modelCacheFG.isAdmitted();
+                default:
+                    Q_ASSERT_X(false, Q_FUNC_INFO, "Wrong simulator");
+                    break;
+                }
+                return false;
+            }
+
             void CModelSetCaches::synchronizeCacheImpl(const CSimulatorInfo &simulator)
             {
                 Q_ASSERT_X(simulator.isSingleSimulator(), Q_FUNC_INFO, "No single simulator");
@@ -35,6 +35,9 @@ namespace BlackMisc
             {
                 //! Defer loading
                 static constexpr bool isDeferred() { return true; }
+
+                //! Large, saved in binary format
+                static constexpr bool isBinary() { return true; }
             };
 
             //! \name Caches for own models on disk, loaded by IAircraftModelLoader
@@ -186,8 +189,17 @@ namespace BlackMisc
                 CAircraftModelList getSynchronizedCachedModels(const CSimulatorInfo &simulator);
 
                 //! Count of models for simulator
+                //! \return -1 if the cache is not loaded (deferred and not yet admitted), counting does not load the cache
                 int getCachedModelsCount(const CSimulatorInfo &simulator) const;
 
+                //! Count of models for simulator as string, "not loaded" if not yet loaded
+                QString getCachedModelsCountString(const CSimulatorInfo &simulator) const;
+
+                //! Has the simulator any models?
+                //! \remark a cache not yet loaded has models if saved, it is not loaded to check
+                //! \threadsafe
+                bool hasCachedModels(const CSimulatorInfo &simulator) const;
+
                 //! Get filename for simulator cache file
                 virtual QString getFilename(const CSimulatorInfo &simulator) const = 0;
 
@@ -215,11 +227,16 @@ namespace BlackMisc
                 //! \threadsafe
                 virtual bool isSaved(const CSimulatorInfo &simulator) const = 0;
 
+                //! Cache admitted, i.e. loaded or being loaded?
+                //! \threadsafe
+                virtual bool isAdmitted(const CSimulatorInfo &simulator) const = 0;
+
                 //! Initialized caches for which simulator?
                 //! \threadsafe
                 CSimulatorInfo simulatorsWithInitializedCache() const;
 
                 //! Simulators which have models
+                //! \sa hasCachedModels
                 //! \threadsafe
                 CSimulatorInfo simulatorsWithModels() const;
 
@@ -332,6 +349,7 @@ namespace BlackMisc
                 virtual void admitCache(const CSimulatorInfo &simulator) override;
                 virtual QString getFilename(const CSimulatorInfo &simulator) const override;
                 virtual bool isSaved(const CSimulatorInfo &simulator) const override;
+                virtual bool isAdmitted(const CSimulatorInfo &simulator) const override;
                 virtual QString getDescription() const override { return "Model caches"; }
                 //! @}
 
@@ -373,6 +391,7 @@ namespace BlackMisc
                 virtual void admitCache(const CSimulatorInfo &simulator) override;
                 virtual QString getFilename(const CSimulatorInfo &simulator) const override;
                 virtual bool isSaved(const CSimulatorInfo &simulator) const override;
+                virtual bool isAdmitted(const CSimulatorInfo &simulator) const override;
                 virtual QString getDescription() const override { return "Model sets"; }
                 //! @}
 
@@ -405,6 +424,7 @@ namespace BlackMisc
                 virtual void admitCache(const CSimulatorInfo &simulator) override { return instanceCaches().admitCache(simulator); }
                 virtual QString getFilename(const CSimulatorInfo &simulator) const override { return instanceCaches().getFilename(simulator); }
                 virtual bool isSaved(const CSimulatorInfo &simulator) const override { return instanceCaches().isSaved(simulator); }
+                virtual bool isAdmitted(const CSimulatorInfo &simulator) const override { return instanceCaches().isAdmitted(simulator); }
                 virtual QString getDescription() const override { return instanceCaches().getDescription(); }
                 //! @}
 
@@ -462,6 +482,8 @@ namespace BlackMisc
                 //! @{
                 CAircraftModelList getCachedModels(const CSimulatorInfo &simulator) const { return CCentralMultiSimulatorModelCachesProvider::modelCachesInstance().getCachedModels(simulator); }
                 int getCachedModelsCount(const CSimulatorInfo &simulator) const { return CCentralMultiSimulatorModelCachesProvider::modelCachesInstance().getCachedModelsCount(simulator); }
+                bool hasCachedModels(const CSimulatorInfo &simulator) const { return CCentralMultiSimulatorModelCachesProvider::modelCachesInstance().hasCachedModels(simulator); }
+                QString getCachedModelsCountString(const CSimulatorInfo &simulator) const { return CCentralMultiSimulatorModelCachesProvider::modelCachesInstance().getCachedModelsCountString(simulator); }
                 QString getCacheCountAndTimestamp(const CSimulatorInfo &simulator) const { return CCentralMultiSimulatorModelCachesProvider::modelCachesInstance().getCacheCountAndTimestamp(simulator); }
                 CStatusMessage setCachedModels(const CAircraftModelList &models, const CSimulatorInfo &simulator) { return CCentralMultiSimulatorModelCachesProvider::modelCachesInstance().setCachedModels(models, simulator); }
                 CStatusMessage clearCachedModels(const CSimulatorInfo &simulator) { return CCentralMultiSimulatorModelCachesProvider::modelCachesInstance().clearCachedModels(simulator); }
@@ -515,6 +537,8 @@ namespace BlackMisc
                 //! @{
                 CAircraftModelList getCachedModels(const CSimulatorInfo &simulator) const { return CCentralMultiSimulatorModelSetCachesProvider::modelCachesInstance().getCachedModels(simulator); }
                 int getCachedModelsCount(const CSimulatorInfo &simulator) const { return CCentralMultiSimulatorModelSetCachesProvider::modelCachesInstance().getCachedModelsCount(simulator); }
+                bool hasCachedModels(const CSimulatorInfo &simulator) const { return CCentralMultiSimulatorModelSetCachesProvider::modelCachesInstance().hasCachedModels(simulator); }
+                QString getCachedModelsCountString(const CSimulatorInfo &simulator) const { return CCentralMultiSimulatorModelSetCachesProvider::modelCachesInstance().getCachedModelsCountString(simulator); }
                 QString getCacheCountAndTimestamp(const CSimulatorInfo &simulator) const { return CCentralMultiSimulatorModelCachesProvider::modelCachesInstance().getCacheCountAndTimestamp(simulator); }
                 CStatusMessage setCachedModels(const CAircraftModelList &models, const CSimulatorInfo &simulator) { return CCentralMultiSimulatorModelSetCachesProvider::modelCachesInstance().setCachedModels(models, simulator); }
                 CStatusMessage clearCachedModels(const CSimulatorInfo &simulator) { return CCentralMultiSimulatorModelCachesProvider::modelCachesInstance().clearCachedModels(simulator); }
@@ -0,0 +1,116 @@
+/* Copyright (C) 2020
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+#include "blackmisc/simulation/interpolationbatch.h"
+#include "blackmisc/simulation/interpolatorfunctions.h"
+
+#include <QtGlobal>
+
+namespace BlackMisc
+{
+    namespace Simulation
+    {
+        void CInterpolationBatch::resize(int lanes)
+        {
+            Q_ASSERT_X(lanes >= 0, Q_FUNC_INFO, "Negative lanes");
+            if (lanes > static_cast<int>(m_timeFraction.size()))
+            {
+                const size_t s = static_cast<size_t>(qMax(16, lanes));
+                m_timeFraction.resize(s, 0.0);
+                for (ChannelArrays *arrays : { &m_y0, &m_y1, &m_a, &m_b, &m_result })
+                {
+                    for (std::vector<double> &values : *arrays) { values.resize(s, 0.0); }
+                }
+            }
+            m_lanes = lanes;
+        }
+
+        int CInterpolationBatch::addLane(double timeFraction)
+        {
+            const int lane = m_lanes;
+            if (lane >= static_cast<int>(m_timeFraction.size())) { this->resize(2 * lane + 1); } // grow the memory
+            this->resize(lane + 1);
+            this->setLane(lane, timeFraction);
+            return lane;
+        }
+
+        void CInterpolationBatch::setLane(int lane, double timeFraction)
+        {
+            Q_ASSERT_X(lane >= 0 && lane < m_lanes, Q_FUNC_INFO, "Wrong lane");
+            const size_t l = static_cast<size_t>(lane);
+            m_timeFraction[l] = clampValidTimeFraction(timeFraction);
+            for (int c = 0; c < ChannelCount; ++c)
+            {
+                m_y0[c][l] = m_y1[c][l] = m_a[c][l] = m_b[c][l] = 0.0;
+            }
+        }
+
+        void CInterpolationBatch::setCubic(int lane, Channel channel, double x0, double x1, double y0, double y1, double k0, double k1)
+        {
+            Q_ASSERT_X(lane >= 0 && lane < m_lanes, Q_FUNC_INFO, "Wrong lane");
+            const size_t l = static_cast<size_t>(lane);
+            m_y0[channel][l] =  y0;
+            m_y1[channel][l] =  y1;
+            m_a[channel][l]  =  k0 * (x1 - x0) - (y1 - y0);
+            m_b[channel][l]  = -k1 * (x1 - x0) + (y1 - y0);
+        }
+
+        void CInterpolationBatch::setLinear(int lane, Channel channel, double y0, double y1)
+        {
+            Q_ASSERT_X(lane >= 0 && lane < m_lanes, Q_FUNC_INFO, "Wrong lane");
+            const size_t l = static_cast<size_t>(lane);
+            m_y0[channel][l] = y0;
+            m_y1[channel][l] = y1;
+            m_a[channel][l]  = 0.0;
+            m_b[channel][l]  = 0.0;
+        }
+
+        void CInterpolationBatch::setAngleDeg(int lane, Channel channel, double beginDeg, double endDeg)
+        {
+            double deltaDeg = endDeg - beginDeg;
+            if (deltaDeg > 180.0) { deltaDeg -= 360.0; }
+            else if (deltaDeg < -180.0) { deltaDeg += 360.0; }
+            this->setLinear(lane, channel, beginDeg, beginDeg + deltaDeg);
+        }
+
+        void CInterpolationBatch::evaluate()
+        {
+            const int lanes = m_lanes;
+            const double *tf = m_timeFraction.data();
+            for (int c = 0; c < ChannelCount; ++c)
+            {
+                // plain loop over contiguous arrays, no branches, so it can be vectorized
+                const double *y0 = m_y0[c].data();
+                const double *y1 = m_y1[c].data();
+                const double *a  = m_a[c].data();
+                const double *b  = m_b[c].data();
+                double *result = m_result[c].data();
+                for (int i = 0; i < lanes; ++i)
+                {
+                    const double t = tf[i];
+                    const double u = 1.0 - t;
+                    result[i] = u * y0[i] + t * y1[i] + t * u * (a[i] * u + b[i] * t);
+                }
+            }
+        }
+
+        SituationSample CInterpolationBatch::sample(int lane) const
+        {
+            Q_ASSERT_X(lane >= 0 && lane < m_lanes, Q_FUNC_INFO, "Wrong lane");
+            SituationSample sample;
+            sample.normalVector   = {{ this->value(lane, NormalX), this->value(lane, NormalY), this->value(lane, NormalZ) }};
+            sample.altitudeFt     = this->value(lane, AltitudeFt);
+            sample.groundFactor   = this->value(lane, GroundFactor);
+            sample.headingDeg     = this->value(lane, HeadingDeg);
+            sample.pitchDeg       = this->value(lane, PitchDeg);
+            sample.bankDeg        = this->value(lane, BankDeg);
+            sample.groundSpeedKts = this->value(lane, GroundSpeedKts);
+            return sample;
+        }
+    } // namespace
+} // namespace
@@ -0,0 +1,109 @@
+/* Copyright (C) 2020
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \file
+
+#ifndef BLACKMISC_SIMULATION_INTERPOLATIONBATCH_H
+#define BLACKMISC_SIMULATION_INTERPOLATIONBATCH_H
+
+#include "blackmisc/simulation/situationsample.h"
+#include "blackmisc/blackmiscexport.h"
+
+#include <array>
+#include <vector>
+
+namespace BlackMisc
+{
+    namespace Simulation
+    {
+        /*!
+         * Evaluates the interpolants of all remote aircraft of one frame in a single pass
+         * \details Each interpolant sets one lane with its time fraction and the segment of every channel.
+         *          The segments are stored as structure of arrays, one contiguous array per channel and coefficient,
+         *          so CInterpolationBatch::evaluate runs the same branch free kernel over all lanes and the compiler can
+         *          vectorize it. Linear segments and angles are cubic segments with zero bending terms,
+         *          hence spline and linear interpolants share the kernel.
+         * \remark the batch is meant to be reused frame by frame, CInterpolationBatch::resize keeps the allocated memory
+         * \remark after CInterpolationBatch::resize different lanes can be set from different threads
+         */
+        class BLACKMISC_EXPORT CInterpolationBatch
+        {
+        public:
+            //! Interpolated values
+            enum Channel
+            {
+                NormalX,
+                NormalY,
+                NormalZ,
+                AltitudeFt,
+                GroundFactor,
+                HeadingDeg,
+                PitchDeg,
+                BankDeg,
+                GroundSpeedKts,
+                ChannelCount //!< number of channels, must be last
+            };
+
+            //! Remove all lanes, keeps the allocated memory
+            void clear() { this->resize(0); }
+
+            //! Set the number of lanes, keeps the allocated memory
+            //! \remark lanes not set by CInterpolationBatch::setLane are evaluated, but the values are meaningless
+            void resize(int lanes);
+
+            //! Number of lanes
+            int size() const { return m_lanes; }
+
+            //! No lanes?
+            bool isEmpty() const { return m_lanes < 1; }
+
+            //! Add a lane, same as resizing and setting the last lane
+            //! \return lane index
+            int addLane(double timeFraction);
+
+            //! Init a lane, all channels are set to zero
+            //! \param lane 0..size-1
+            //! \param timeFraction 0..1 between start and end of the segments
+            void setLane(int lane, double timeFraction);
+
+            //! Cubic Hermite segment from (x0, y0) to (x1, y1) with the derivatives k0, k1
+            void setCubic(int lane, Channel channel, double x0, double x1, double y0, double y1, double k0, double k1);
+
+            //! Linear segment from y0 to y1
+            void setLinear(int lane, Channel channel, double y0, double y1);
+
+            //! Angle in degrees from begin to end the shorter way round
+            //! \sa SituationSample::interpolateAngleDeg
+            void setAngleDeg(int lane, Channel channel, double beginDeg, double endDeg);
+
+            //! Evaluate all lanes
+            void evaluate();
+
+            //! Evaluated value
+            //! \remark only valid after CInterpolationBatch::evaluate
+            double value(int lane, Channel channel) const { return m_result[channel][static_cast<size_t>(lane)]; }
+
+            //! Evaluated values of a lane, timestamps are not set
+            //! \remark only valid after CInterpolationBatch::evaluate
+            SituationSample sample(int lane) const;
+
+        private:
+            using ChannelArrays = std::array<std::vector<double>, ChannelCount>;
+
+            int m_lanes = 0;                    //!< number of lanes
+            std::vector<double> m_timeFraction; //!< per lane
+            ChannelArrays m_y0;                 //!< segment start
+            ChannelArrays m_y1;                 //!< segment end
+            ChannelArrays m_a;                  //!< bending at start, 0 for linear segments
+            ChannelArrays m_b;                  //!< bending at end, 0 for linear segments
+            ChannelArrays m_result;             //!< evaluated values
+        };
+    } // namespace
+} // namespace
+
+#endif // guard
@@ -262,6 +262,19 @@ namespace BlackMisc
             return rt;
         }
 
+        bool CInterpolationAndRenderingSetupGlobal::setParallelUpdateThreads(int threads)
+        {
+            const int t = qBound(0, threads, MaxParallelUpdateThreads());
+            if (t == m_parallelUpdateThreads) { return false; }
+            m_parallelUpdateThreads = t;
+            return true;
+        }
+
+        int CInterpolationAndRenderingSetupGlobal::MaxParallelUpdateThreads()
+        {
+            return 16;
+        }
+
         void CInterpolationAndRenderingSetupGlobal::setBaseValues(const CInterpolationAndRenderingSetupBase &baseValues)
         {
             m_logInterpolation       = baseValues.logInterpolation();
@@ -280,7 +293,8 @@ namespace BlackMisc
             return
                 CInterpolationAndRenderingSetupBase::convertToQString(i18n) %
                 QStringLiteral(" max.aircraft:") % QString::number(m_maxRenderedAircraft) %
-                QStringLiteral(" max.distance:") % m_maxRenderedDistance.valueRoundedWithUnit(CLengthUnit::NM(), 2);
+                QStringLiteral(" max.distance:") % m_maxRenderedDistance.valueRoundedWithUnit(CLengthUnit::NM(), 2) %
+                QStringLiteral(" parallel threads:") % QString::number(m_parallelUpdateThreads);
         }
 
         CVariant CInterpolationAndRenderingSetupGlobal::propertyByIndex(const CPropertyIndex &index) const
@@ -291,6 +305,7 @@ namespace BlackMisc
             {
             case IndexMaxRenderedAircraft: return CVariant::fromValue(m_maxRenderedAircraft);
             case IndexMaxRenderedDistance: return CVariant::fromValue(m_maxRenderedDistance);
+            case IndexParallelUpdateThreads: return CVariant::fromValue(m_parallelUpdateThreads);
             default: break;
             }
             if (CInterpolationAndRenderingSetupBase::canHandleIndex(i)) { return CInterpolationAndRenderingSetupBase::propertyByIndex(index); }
@@ -309,6 +324,7 @@ namespace BlackMisc
             {
             case IndexMaxRenderedAircraft: m_maxRenderedAircraft = variant.toInt(); return;
             case IndexMaxRenderedDistance: m_maxRenderedDistance = variant.value<CLength>(); return;
+            case IndexParallelUpdateThreads: this->setParallelUpdateThreads(variant.toInt()); return;
             default: break;
             }
             if (CInterpolationAndRenderingSetupBase::canHandleIndex(i))
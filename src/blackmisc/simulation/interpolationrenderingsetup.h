@@ -148,7 +148,8 @@ namespace BlackMisc
             enum ColumnIndex
             {
                 IndexMaxRenderedAircraft = CInterpolationAndRenderingSetupBase::IndexFixSceneryOffset + 1,
-                IndexMaxRenderedDistance
+                IndexMaxRenderedDistance,
+                IndexParallelUpdateThreads
             };
 
             //! Constructor.
@@ -193,6 +194,19 @@ namespace BlackMisc
             //! Text describing the restrictions
             QString getRenderRestrictionText() const;
 
+            //! Number of threads updating the remote aircraft in parallel, 0 or 1 means sequentially
+            int getParallelUpdateThreads() const { return m_parallelUpdateThreads; }
+
+            //! Number of threads updating the remote aircraft in parallel, 0 or 1 means sequentially
+            //! \remark values are limited to 0..MaxParallelUpdateThreads
+            bool setParallelUpdateThreads(int threads);
+
+            //! Remote aircraft updated in parallel?
+            bool isParallelUpdateEnabled() const { return m_parallelUpdateThreads > 1; }
+
+            //! Max.number of threads updating the remote aircraft
+            static int MaxParallelUpdateThreads();
+
             //! Set all base values
             void setBaseValues(const CInterpolationAndRenderingSetupBase &baseValues);
 
@@ -208,6 +222,7 @@ namespace BlackMisc
         private:
             int m_maxRenderedAircraft = InfiniteAircraft(); //!< max.rendered aircraft
             PhysicalQuantities::CLength m_maxRenderedDistance { 0, nullptr }; //!< max.distance for rendering
+            int m_parallelUpdateThreads = 0; //!< threads updating the remote aircraft, 0 or 1 sequentially
 
             BLACK_METACLASS(
                 CInterpolationAndRenderingSetupGlobal,
@@ -220,7 +235,8 @@ namespace BlackMisc
                 BLACK_METAMEMBER(interpolatorMode),
                 BLACK_METAMEMBER(pitchOnGround),
                 BLACK_METAMEMBER(maxRenderedAircraft),
-                BLACK_METAMEMBER(maxRenderedDistance)
+                BLACK_METAMEMBER(maxRenderedDistance),
+                BLACK_METAMEMBER(parallelUpdateThreads)
             );
         };
 
@@ -233,7 +249,7 @@ namespace BlackMisc
             //! Properties by index
             enum ColumnIndex
             {
-                IndexCallsign = CInterpolationAndRenderingSetupGlobal::IndexMaxRenderedDistance + 1
+                IndexCallsign = CInterpolationAndRenderingSetupGlobal::IndexParallelUpdateThreads + 1
             };
 
             //! Constructor
@@ -8,11 +8,13 @@
 
 #include "interpolator.h"
 #include "blackconfig/buildconfig.h"
+#include "blackmisc/simulation/interpolationbatch.h"
 #include "blackmisc/simulation/interpolationlogger.h"
 #include "blackmisc/simulation/interpolatorlinear.h"
 #include "blackmisc/simulation/interpolatorspline.h"
 #include "blackmisc/network/fsdsetup.h"
 #include "blackmisc/aviation/callsign.h"
+#include "blackmisc/aviation/callsigninterner.h"
 #include "blackmisc/aviation/heading.h"
 #include "blackmisc/pq/angle.h"
 #include "blackmisc/pq/speed.h"
@@ -41,7 +43,8 @@ namespace BlackMisc
                                               ISimulationEnvironmentProvider *simEnvProvider,
                                               IInterpolationSetupProvider    *setupProvider,
                                               IRemoteAircraftProvider *remoteProvider,
-                                              CInterpolationLogger    *logger) : m_callsign(callsign)
+                                              CInterpolationLogger    *logger) :
+            m_callsign(callsign), m_callsignId(CCallsignInterner::id(callsign))
         {
             // normally when created m_cg is still null since there is no CG in the provider yet
 
@@ -91,11 +94,11 @@ namespace BlackMisc
         CAircraftSituationList CInterpolator<Derived>::remoteAircraftSituationsAndChange(const CInterpolationAndRenderingSetupPerCallsign &setup)
         {
             // const bool vtol = setup.isForcingFullInterpolation() || m_model.isVtol();
-            CAircraftSituationList validSituations = this->remoteAircraftSituations(m_callsign);
+            CAircraftSituationList validSituations = this->remoteAircraftSituations(m_callsignId);
 
             // get the changes, we need the second value as we want to look in the past
             // the first value is already based on the latest situation
-            const CAircraftSituationChangeList changes = this->remoteAircraftSituationChanges(m_callsign);
+            const CAircraftSituationChangeList changes = this->remoteAircraftSituationChanges(m_callsignId);
             m_pastSituationsChange = changes.indexOrNull(1);
 
             // fixing offset
@@ -191,6 +194,71 @@ namespace BlackMisc
             return result;
         }
 
+        template <typename Derived>
+        bool CInterpolator<Derived>::prepareBatchedInterpolation(qint64 currentTimeSinceEpoc, const CInterpolationAndRenderingSetupPerCallsign &setup, int aircraftNumber, CInterpolationBatch &batch, int lane)
+        {
+            m_batchLane = -1;
+            m_batchInterpolated = false;
+            if (this->doLogging())
+            {
+                // the log is written while interpolating, so logged aircraft are interpolated one by one
+                m_batchResult = this->getInterpolation(currentTimeSinceEpoc, setup, aircraftNumber);
+                m_batchInterpolated = true;
+                return false;
+            }
+
+            // make sure we can also interpolate parts only (needed in unit tests)
+            if (aircraftNumber < 0) { aircraftNumber = 0; }
+            m_batchAircraftNumber = aircraftNumber;
+            m_batchInit = this->initIniterpolationStepData(currentTimeSinceEpoc, setup, aircraftNumber);
+            Q_ASSERT_X(!m_currentInterpolationStatus.isInterpolated(), Q_FUNC_INFO, "Expect reset status");
+            if (!m_unitTest && !m_batchInit) { return false; }
+            if (m_currentSituations.isEmpty()) { return false; }
+
+            SituationLog log; // unused, no logging here
+            const auto &interpolant = derived()->getInterpolant(log);
+            if (!interpolant.isValid()) { return false; }
+            interpolant.setBatchLane(batch, lane);
+            m_batchLane = lane;
+            return true;
+        }
+
+        template <typename Derived>
+        CInterpolationResult CInterpolator<Derived>::getBatchedInterpolation(const CInterpolationBatch &batch)
+        {
+            if (m_batchInterpolated)
+            {
+                m_batchInterpolated = false;
+                return m_batchResult;
+            }
+
+            CInterpolationResult result;
+            do
+            {
+                if (!m_unitTest && !m_batchInit) { break; } // failure in real scenarios, unit tests move on
+                Q_ASSERT_X(m_currentTimeMsSinceEpoch > 0, Q_FUNC_INFO, "No valid timestamp, interpolator initialized?");
+
+                CAircraftSituation interpolatedSituation = CAircraftSituation::null();
+                if (m_currentSituations.isEmpty())
+                {
+                    m_lastSituation = CAircraftSituation::null();
+                }
+                else
+                {
+                    SituationLog log;
+                    const SituationSample evaluated = m_batchLane >= 0 ? batch.sample(m_batchLane) : SituationSample();
+                    interpolatedSituation = this->getInterpolatedSituation(derived()->getCurrentInterpolant(), log, m_batchLane >= 0 ? &evaluated : nullptr);
+                }
+                const CAircraftParts interpolatedParts = this->getInterpolatedOrGuessedParts(m_batchAircraftNumber);
+                result.setValues(interpolatedSituation, interpolatedParts);
+            }
+            while (false);
+
+            result.setStatus(m_currentInterpolationStatus, m_currentPartsStatus);
+            m_batchLane = -1;
+            return result;
+        }
+
         template <typename Derived>
         CAircraftSituation CInterpolator<Derived>::getInterpolatedSituation()
         {
@@ -204,7 +272,14 @@ namespace BlackMisc
             // interpolant as function of derived class
             // CInterpolatorLinear::Interpolant or CInterpolatorSpline::Interpolant
             SituationLog log;
-            const auto interpolant = derived()->getInterpolant(log);
+            const auto &interpolant = derived()->getInterpolant(log); // no copy of the interpolant in each step
+            return this->getInterpolatedSituation(interpolant, log, nullptr);
+        }
+
+        template <typename Derived>
+        template <class Interpolant>
+        CAircraftSituation CInterpolator<Derived>::getInterpolatedSituation(const Interpolant &interpolant, SituationLog &log, const SituationSample *evaluated)
+        {
             const bool isValidInterpolant = interpolant.isValid();
 
             CAircraftSituation currentSituation = m_lastSituation;
@@ -214,20 +289,32 @@ namespace BlackMisc
             do
             {
                 if (!isValidInterpolant) { break; }
-                const CInterpolatorPbh pbh = interpolant.pbh();
+                const CInterpolatorPbh &pbh = interpolant.pbh();
 
                 // init interpolated situation
                 currentSituation = this->initInterpolatedSituation(pbh.getOldSituation(), pbh.getNewSituation());
 
                 // Pitch bank heading first, so follow up steps could use those values
-                currentSituation.setHeading(pbh.getHeading());
-                currentSituation.setPitch(pbh.getPitch());
-                currentSituation.setBank(pbh.getBank());
-                currentSituation.setGroundSpeed(pbh.getGroundSpeed());
+                if (evaluated)
+                {
+                    currentSituation.setHeading(pbh.getHeading(*evaluated));
+                    currentSituation.setPitch(pbh.getPitch(*evaluated));
+                    currentSituation.setBank(pbh.getBank(*evaluated));
+                    currentSituation.setGroundSpeed(pbh.getGroundSpeed(*evaluated));
+                }
+                else
+                {
+                    currentSituation.setHeading(pbh.getHeading());
+                    currentSituation.setPitch(pbh.getPitch());
+                    currentSituation.setBank(pbh.getBank());
+                    currentSituation.setGroundSpeed(pbh.getGroundSpeed());
+                }
 
                 // use derived interpolant function
                 const bool interpolateGndFlag = pbh.getNewSituation().hasGroundDetailsForGndInterpolation() && pbh.getOldSituation().hasGroundDetailsForGndInterpolation();
-                currentSituation = interpolant.interpolatePositionAndAltitude(currentSituation, interpolateGndFlag);
+                currentSituation = evaluated ?
+                                   interpolant.interpolatePositionAndAltitude(currentSituation, interpolateGndFlag, *evaluated) :
+                                   interpolant.interpolatePositionAndAltitude(currentSituation, interpolateGndFlag);
                 if (currentSituation.isNull()) { break; }
 
                 // if we get here and the vector is invalid it means we haven't handled it correctly in one of the interpolators
@@ -367,7 +454,7 @@ namespace BlackMisc
             // (!) this code is used by linear and spline interpolator
 
             // Parts are supposed to be in correct order, latest first
-            const CAircraftPartsList validParts = this->remoteAircraftParts(m_callsign);
+            const CAircraftPartsList validParts = this->remoteAircraftParts(m_callsignId);
 
             // log for empty parts aircraft parts
             if (validParts.isEmpty())
@@ -526,7 +613,7 @@ namespace BlackMisc
         {
             Q_ASSERT_X(!m_callsign.isEmpty(), Q_FUNC_INFO, "Missing callsign");
 
-            const qint64 lastModifed  = this->situationsLastModified(m_callsign);
+            const qint64 lastModifed  = this->situationsLastModified(m_callsignId);
             const bool slowUpdateStep = (((m_interpolatedSituationsCounter + aircraftNumber) % 25) == 0); // flag when parts are updated, which need not to be updated every time
             const bool changedSituations = lastModifed > m_situationsLastModified;
 
@@ -32,9 +32,12 @@ namespace BlackMisc
 {
     namespace Simulation
     {
+        class CInterpolationBatch;
         class CInterpolationLogger;
         class CInterpolatorLinear;
         class CInterpolatorSpline;
+        struct SituationLog;
+        struct SituationSample;
 
         //! Status of interpolation
         struct BLACKMISC_EXPORT CInterpolationStatus
@@ -195,6 +198,16 @@ namespace BlackMisc
             //! Parts and situation interpolated
             CInterpolationResult getInterpolation(qint64 currentTimeSinceEpoc, const CInterpolationAndRenderingSetupPerCallsign &setup, int aircraftNumber = -1);
 
+            //! Init the interpolation step and set the interpolant as lane of a batch of all aircraft
+            //! \remark first of the two batched steps, after CInterpolationBatch::evaluate call CInterpolator::getBatchedInterpolation
+            //! \remark different interpolators can be prepared in parallel as long as they use different lanes
+            //! \return true if the lane was set
+            bool prepareBatchedInterpolation(qint64 currentTimeSinceEpoc, const CInterpolationAndRenderingSetupPerCallsign &setup, int aircraftNumber, CInterpolationBatch &batch, int lane);
+
+            //! Parts and situation interpolated with the evaluated batch
+            //! \remark second of the two batched steps, same result as CInterpolator::getInterpolation
+            CInterpolationResult getBatchedInterpolation(const CInterpolationBatch &batch);
+
             //! Takes input between 0 and 1 and returns output between 0 and 1 smoothed with an S-shaped curve.
             //!
             //! Useful for making interpolation seem smoother, efficiently as it just uses simple arithmetic.
@@ -275,6 +288,7 @@ namespace BlackMisc
             static double groundInterpolationFactor();
 
             const Aviation::CCallsign  m_callsign; //!< corresponding callsign
+            const int m_callsignId;            //!< interned callsign id, see Aviation::CCallsignInterner
             CAircraftModel m_model; //!< corresponding model
 
             // values for current interpolation step
@@ -309,6 +323,17 @@ namespace BlackMisc
             CInterpolationLogger *m_logger = nullptr; //!< optional interpolation logger
             QTimer m_initTimer; //!< timer to init model, will be deleted when interpolator is deleted and cancel the call
 
+            int  m_batchLane = -1;              //!< lane of the prepared batched step
+            int  m_batchAircraftNumber = 0;     //!< aircraft number of the prepared batched step
+            bool m_batchInit = false;           //!< prepared batched step initialized
+            bool m_batchInterpolated = false;   //!< prepared batched step already interpolated
+            CInterpolationResult m_batchResult; //!< result if already interpolated
+
+            //! Interpolated situation
+            //! \param evaluated values evaluated by CInterpolationBatch, or nullptr to evaluate the interpolant
+            template <class Interpolant>
+            Aviation::CAircraftSituation getInterpolatedSituation(const Interpolant &interpolant, SituationLog &log, const SituationSample *evaluated);
+
             //! Log parts
             void logParts(const Aviation::CAircraftParts &parts, int partsNo, bool empty) const;
 
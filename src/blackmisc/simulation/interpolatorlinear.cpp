@@ -8,6 +8,7 @@
 
 #include "interpolatorlinear.h"
 #include "interpolatorfunctions.h"
+#include "interpolationbatch.h"
 #include "blackmisc/aviation/aircraftsituationlist.h"
 #include "blackmisc/aviation/altitude.h"
 #include "blackmisc/geo/coordinategeodetic.h"
@@ -38,12 +39,14 @@ namespace BlackMisc
     {
         CInterpolatorLinear::CInterpolant::CInterpolant(const CAircraftSituation &oldSituation) :
             IInterpolant(1, CInterpolatorPbh(0, oldSituation, oldSituation)),
-            m_oldSituation(oldSituation)
+            m_oldSituation(oldSituation),
+            m_oldSample(m_pbh.getOldSample()), m_newSample(SituationSample::fromSituation(m_newSituation))
         { }
 
         CInterpolatorLinear::CInterpolant::CInterpolant(const CAircraftSituation &oldSituation, const CInterpolatorPbh &pbh) :
             IInterpolant(1, pbh),
-            m_oldSituation(oldSituation)
+            m_oldSituation(oldSituation),
+            m_oldSample(SituationSample::fromSituation(oldSituation)), m_newSample(SituationSample::fromSituation(m_newSituation))
         { }
 
         CInterpolatorLinear::CInterpolant::CInterpolant(const CAircraftSituation &oldSituation, const CAircraftSituation &newSituation, double timeFraction, qint64 interpolatedTime) :
@@ -52,44 +55,69 @@ namespace BlackMisc
             m_simulationTimeFraction(timeFraction)
         {
             m_pbh = CInterpolatorPbh(m_simulationTimeFraction, oldSituation, newSituation);
+            m_oldSample = m_pbh.getOldSample(); // same CG, so the PBH samples can be used
+            m_newSample = m_pbh.getNewSample();
         }
 
         void CInterpolatorLinear::anchor()
         { }
 
-        CAircraftSituation CInterpolatorLinear::CInterpolant::interpolatePositionAndAltitude(const CAircraftSituation &situation, bool interpolateGndFactor) const
+        SituationSample CInterpolatorLinear::CInterpolant::evaluate() const
         {
-            const std::array<double, 3> oldVec(m_oldSituation.getPosition().normalVectorDouble());
-            const std::array<double, 3> newVec(m_newSituation.getPosition().normalVectorDouble());
+            const std::array<double, 3> &oldVec = m_oldSample.normalVector;
+            const std::array<double, 3> &newVec = m_newSample.normalVector;
 
+            // Interpolate position: pos = (posB - posA) * t + posA
+            // Interpolate altitude: Alt = (AltB - AltA) * t + AltA
+            // avoid underflow below ground elevation by using the corrected altitude of the samples
+            const double tf = clampValidTimeFraction(m_simulationTimeFraction);
+            SituationSample sample;
+            sample.normalVector = {{ (newVec[0] - oldVec[0]) * tf + oldVec[0],
+                                     (newVec[1] - oldVec[1]) * tf + oldVec[1],
+                                     (newVec[2] - oldVec[2]) * tf + oldVec[2]
+                                  }};
+            sample.altitudeFt   = SituationSample::interpolateLinear(m_oldSample.altitudeFt, m_newSample.altitudeFt, tf);
+            sample.groundFactor = SituationSample::interpolateLinear(m_oldSample.groundFactor, m_newSample.groundFactor, tf);
+            return sample;
+        }
+
+        void CInterpolatorLinear::CInterpolant::setTimes(double timeFraction, qint64 interpolatedTimeMs)
+        {
+            m_simulationTimeFraction = timeFraction;
+            m_interpolatedTime = interpolatedTimeMs;
+            m_pbh.setTimeFraction(timeFraction);
+        }
+
+        void CInterpolatorLinear::CInterpolant::setBatchLane(CInterpolationBatch &batch, int lane) const
+        {
+            batch.setLane(lane, m_simulationTimeFraction);
+            batch.setLinear(lane, CInterpolationBatch::NormalX,      m_oldSample.normalVector[0], m_newSample.normalVector[0]);
+            batch.setLinear(lane, CInterpolationBatch::NormalY,      m_oldSample.normalVector[1], m_newSample.normalVector[1]);
+            batch.setLinear(lane, CInterpolationBatch::NormalZ,      m_oldSample.normalVector[2], m_newSample.normalVector[2]);
+            batch.setLinear(lane, CInterpolationBatch::AltitudeFt,   m_oldSample.altitudeFt,      m_newSample.altitudeFt);
+            batch.setLinear(lane, CInterpolationBatch::GroundFactor, m_oldSample.groundFactor,    m_newSample.groundFactor);
+            m_pbh.setBatchLane(batch, lane);
+        }
+
+        CAircraftSituation CInterpolatorLinear::CInterpolant::interpolatePositionAndAltitude(const CAircraftSituation &situation, bool interpolateGndFactor, const SituationSample &evaluated) const
+        {
             if (CBuildConfig::isLocalDeveloperDebugBuild())
             {
-                BLACK_VERIFY_X(CAircraftSituation::isValidVector(oldVec), Q_FUNC_INFO, "Invalid old vector");
-                BLACK_VERIFY_X(CAircraftSituation::isValidVector(newVec), Q_FUNC_INFO, "Invalid new vector");
+                BLACK_VERIFY_X(CAircraftSituation::isValidVector(m_oldSample.normalVector), Q_FUNC_INFO, "Invalid old vector");
+                BLACK_VERIFY_X(CAircraftSituation::isValidVector(m_newSample.normalVector), Q_FUNC_INFO, "Invalid new vector");
                 BLACK_VERIFY_X(isAcceptableTimeFraction(m_simulationTimeFraction), Q_FUNC_INFO, "Invalid fraction");
             }
 
-            // Interpolate position: pos = (posB - posA) * t + posA
             CCoordinateGeodetic newPosition;
-            const double tf = clampValidTimeFraction(m_simulationTimeFraction);
-            newPosition.setNormalVector((newVec[0] - oldVec[0]) * tf + oldVec[0],
-                                        (newVec[1] - oldVec[1]) * tf + oldVec[1],
-                                        (newVec[2] - oldVec[2]) * tf + oldVec[2]);
+            newPosition.setNormalVector(evaluated.normalVector[0], evaluated.normalVector[1], evaluated.normalVector[2]);
 
             if (CBuildConfig::isLocalDeveloperDebugBuild())
             {
                 BLACK_VERIFY_X(newPosition.isValidVectorRange(), Q_FUNC_INFO, "Invalid vector");
             }
 
-            // Interpolate altitude: Alt = (AltB - AltA) * t + AltA
-            // avoid underflow below ground elevation by using getCorrectedAltitude
-            const CAltitude oldAlt(m_oldSituation.getCorrectedAltitude());
-            const CAltitude newAlt(m_newSituation.getCorrectedAltitude());
-            Q_ASSERT_X(oldAlt.getReferenceDatum() == CAltitude::MeanSeaLevel && oldAlt.getReferenceDatum() == newAlt.getReferenceDatum(), Q_FUNC_INFO, "mismatch in reference"); // otherwise no calculation is possible
-            const CAltitude altitude((newAlt - oldAlt)
-                                     * tf
-                                     + oldAlt,
-                                     oldAlt.getReferenceDatum());
+            Q_ASSERT_X(m_oldSituation.getAltitude().getReferenceDatum() == CAltitude::MeanSeaLevel && m_newSituation.getAltitude().getReferenceDatum() == CAltitude::MeanSeaLevel, Q_FUNC_INFO, "mismatch in reference"); // otherwise no calculation is possible
+            const CAltitude altitude(evaluated.altitudeFt, CAltitude::MeanSeaLevel, CLengthUnit::ft());
 
             CAircraftSituation newSituation(situation);
             newSituation.setPosition(newPosition);
@@ -98,14 +126,13 @@ namespace BlackMisc
 
             if (interpolateGndFactor)
             {
-                const double oldGroundFactor = m_oldSituation.getOnGroundFactor();
-                const double newGroundFactor = m_newSituation.getOnGroundFactor();
+                const double oldGroundFactor = m_oldSample.groundFactor;
+                const double newGroundFactor = m_newSample.groundFactor;
                 do
                 {
                     if (CAircraftSituation::isGfEqualAirborne(oldGroundFactor, newGroundFactor)) { newSituation.setOnGround(false); break; }
                     if (CAircraftSituation::isGfEqualOnGround(oldGroundFactor, newGroundFactor)) { newSituation.setOnGround(true);  break; }
-                    const double groundFactor = (newGroundFactor - oldGroundFactor) * tf + oldGroundFactor;
-                    newSituation.setOnGroundFactor(groundFactor);
+                    newSituation.setOnGroundFactor(evaluated.groundFactor);
                     newSituation.setOnGroundFromGroundFactorFromInterpolation(groundInterpolationFactor());
                 }
                 while (false);
@@ -113,7 +140,7 @@ namespace BlackMisc
             return newSituation;
         }
 
-        CInterpolatorLinear::CInterpolant CInterpolatorLinear::getInterpolant(SituationLog &log)
+        const CInterpolatorLinear::CInterpolant &CInterpolatorLinear::getInterpolant(SituationLog &log)
         {
             // set default situations
             CAircraftSituation oldSituation = m_interpolant.getOldSituation();
@@ -229,7 +256,15 @@ namespace BlackMisc
                 log.interpolantRecalc = recalculate;
             }
 
-            m_interpolant = { oldSituation, newSituation, simulationTimeFraction, interpolatedTime };
+            if (recalculate || m_interpolant.getSituationsAvailable() < 2)
+            {
+                m_interpolant = { oldSituation, newSituation, simulationTimeFraction, interpolatedTime };
+            }
+            else
+            {
+                // same situation pair, keep the samples
+                m_interpolant.setTimes(simulationTimeFraction, interpolatedTime);
+            }
             m_interpolant.setRecalculated(recalculate);
 
             return m_interpolant;
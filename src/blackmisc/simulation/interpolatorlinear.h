@@ -14,6 +14,7 @@
 #include "interpolator.h"
 #include "interpolationlogger.h"
 #include "interpolant.h"
+#include "situationsample.h"
 #include "blackmisc/aviation/aircraftsituation.h"
 #include "blackmisc/blackmiscexport.h"
 #include <QString>
@@ -51,7 +52,23 @@ namespace BlackMisc
                 //! @}
 
                 //! Perform the interpolation
-                Aviation::CAircraftSituation interpolatePositionAndAltitude(const Aviation::CAircraftSituation &situation, bool interpolateGndFactor) const;
+                Aviation::CAircraftSituation interpolatePositionAndAltitude(const Aviation::CAircraftSituation &situation, bool interpolateGndFactor) const
+                {
+                    return this->interpolatePositionAndAltitude(situation, interpolateGndFactor, this->evaluate());
+                }
+
+                //! Perform the interpolation with position, altitude and ground factor evaluated before
+                //! \sa CInterpolationBatch::sample
+                Aviation::CAircraftSituation interpolatePositionAndAltitude(const Aviation::CAircraftSituation &situation, bool interpolateGndFactor, const SituationSample &evaluated) const;
+
+                //! Position, altitude and ground factor at the current time fraction
+                SituationSample evaluate() const;
+
+                //! Set a batch lane with the segments of this interpolant
+                void setBatchLane(CInterpolationBatch &batch, int lane) const;
+
+                //! Set the time fraction and interpolated time, the situations and their samples are kept
+                void setTimes(double timeFraction, qint64 interpolatedTimeMs);
 
                 //! Old situation
                 const Aviation::CAircraftSituation &getOldSituation() const { return m_oldSituation; }
@@ -62,11 +79,17 @@ namespace BlackMisc
             private:
                 Aviation::CAircraftSituation m_oldSituation;
                 Aviation::CAircraftSituation m_newSituation;
+                SituationSample m_oldSample; //!< values of m_oldSituation used for interpolation
+                SituationSample m_newSample; //!< values of m_newSituation used for interpolation
                 double m_simulationTimeFraction = 0.0; //!< 0..1
             };
 
             //! Get the interpolant for the given time point
-            CInterpolant getInterpolant(SituationLog &log);
+            //! \remark reference to the current interpolant, valid until the next call
+            const CInterpolant &getInterpolant(SituationLog &log);
+
+            //! Interpolant of the last CInterpolatorLinear::getInterpolant call
+            const CInterpolant &getCurrentInterpolant() const { return m_interpolant; }
 
         private:
             CInterpolant m_interpolant; //!< current interpolant
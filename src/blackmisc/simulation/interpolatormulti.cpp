@@ -33,6 +33,29 @@ namespace BlackMisc
             return CInterpolationResult();
         }
 
+        bool CInterpolatorMulti::prepareBatchedInterpolation(qint64 currentTimeSinceEpoc, const CInterpolationAndRenderingSetupPerCallsign &setup, int aircraftNumber, CInterpolationBatch &batch, int lane)
+        {
+            m_batchMode = setup.getInterpolatorMode();
+            switch (m_batchMode)
+            {
+            case CInterpolationAndRenderingSetupBase::Linear: return m_linear.prepareBatchedInterpolation(currentTimeSinceEpoc, setup, aircraftNumber, batch, lane);
+            case CInterpolationAndRenderingSetupBase::Spline: return m_spline.prepareBatchedInterpolation(currentTimeSinceEpoc, setup, aircraftNumber, batch, lane);
+            default: break;
+            }
+            return false;
+        }
+
+        CInterpolationResult CInterpolatorMulti::getBatchedInterpolation(const CInterpolationBatch &batch)
+        {
+            switch (m_batchMode)
+            {
+            case CInterpolationAndRenderingSetupBase::Linear: return m_linear.getBatchedInterpolation(batch);
+            case CInterpolationAndRenderingSetupBase::Spline: return m_spline.getBatchedInterpolation(batch);
+            default: break;
+            }
+            return CInterpolationResult();
+        }
+
         const CAircraftSituation &CInterpolatorMulti::getLastInterpolatedSituation(CInterpolationAndRenderingSetupBase::InterpolatorMode mode) const
         {
             switch (mode)
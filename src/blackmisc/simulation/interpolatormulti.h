@@ -31,6 +31,12 @@ namespace BlackMisc
             //! \copydoc CInterpolator::getInterpolation
             CInterpolationResult getInterpolation(qint64 currentTimeSinceEpoc, const CInterpolationAndRenderingSetupPerCallsign &setup, int aircraftNumber);
 
+            //! \copydoc CInterpolator::prepareBatchedInterpolation
+            bool prepareBatchedInterpolation(qint64 currentTimeSinceEpoc, const CInterpolationAndRenderingSetupPerCallsign &setup, int aircraftNumber, CInterpolationBatch &batch, int lane);
+
+            //! \copydoc CInterpolator::getBatchedInterpolation
+            CInterpolationResult getBatchedInterpolation(const CInterpolationBatch &batch);
+
             //! \copydoc CInterpolator::getLastInterpolatedSituation
             const Aviation::CAircraftSituation &getLastInterpolatedSituation(CInterpolationAndRenderingSetupBase::InterpolatorMode mode) const;
 
@@ -49,6 +55,7 @@ namespace BlackMisc
         private:
             CInterpolatorSpline m_spline;
             CInterpolatorLinear m_linear;
+            CInterpolationAndRenderingSetupBase::InterpolatorMode m_batchMode = CInterpolationAndRenderingSetupBase::Spline; //!< mode of the prepared batched step
         };
 
         /**
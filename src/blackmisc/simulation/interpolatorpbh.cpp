@@ -8,6 +8,7 @@
 
 #include "interpolatorpbh.h"
 #include "interpolatorfunctions.h"
+#include "interpolationbatch.h"
 #include "blackmisc/verify.h"
 #include "blackconfig/buildconfig.h"
 
@@ -19,65 +20,85 @@ namespace BlackMisc
 {
     namespace Simulation
     {
-        CAngle CInterpolatorPbh::interpolateAngle(const CAngle &begin, const CAngle &end, double timeFraction0to1)
-        {
-            // determine the right direction (to left, to right) we interpolate towards to
-            //  -30 ->   30 =>    60 (via 0)
-            //   30 ->  -30 =>   -60 (via 0)
-            //  170 -> -170 =>  -340 (via 180)
-            // -170 ->  170 =>   340 (via 180)
-            double deltaDeg = (end - begin).value(CAngleUnit::deg());
-            if (deltaDeg > 180.0) { deltaDeg -= 360; }
-            else if (deltaDeg < -180.0) { deltaDeg += 360; }
-
-            if (CBuildConfig::isLocalDeveloperDebugBuild())
-            {
-                BLACK_VERIFY_X(isAcceptableTimeFraction(timeFraction0to1), Q_FUNC_INFO, "0..1 fraction needed");
-            }
+        CInterpolatorPbh::CInterpolatorPbh(const CAircraftSituation &older, const CAircraftSituation &newer) :
+            m_oldSituation(older), m_newSituation(newer),
+            m_oldSample(SituationSample::fromSituation(older)), m_newSample(SituationSample::fromSituation(newer))
+        { }
 
-            //! make sure to not end up we extrapolation
-            if (timeFraction0to1 >= 1.0) { return begin + CAngle(deltaDeg, CAngleUnit::deg()); }
-            if (timeFraction0to1 <= 0.0) { return begin; }
-            return begin + CAngle(timeFraction0to1 * deltaDeg, CAngleUnit::deg());
-        }
+        CInterpolatorPbh::CInterpolatorPbh(double time, const CAircraftSituation &older, const CAircraftSituation &newer) :
+            m_simulationTimeFraction(time), m_oldSituation(older), m_newSituation(newer),
+            m_oldSample(SituationSample::fromSituation(older)), m_newSample(SituationSample::fromSituation(newer))
+        { }
 
         CHeading CInterpolatorPbh::getHeading() const
         {
             // HINT: VTOL aircraft can change pitch/bank without changing position, planes cannot
             // Interpolate heading: HDG = (HdgB - HdgA) * t + HdgA
-            const CHeading headingBegin = m_oldSituation.getHeading();
-            const CHeading headingEnd   = m_newSituation.getHeading();
-
             if (CBuildConfig::isLocalDeveloperDebugBuild())
             {
-                BLACK_VERIFY_X(headingBegin.getReferenceNorth() == headingEnd.getReferenceNorth(), Q_FUNC_INFO, "Need same reference");
+                BLACK_VERIFY_X(m_oldSituation.getHeading().getReferenceNorth() == m_newSituation.getHeading().getReferenceNorth(), Q_FUNC_INFO, "Need same reference");
             }
-            return CHeading(interpolateAngle(headingBegin, headingEnd, m_simulationTimeFraction), headingEnd.getReferenceNorth());
+            const double headingDeg = SituationSample::interpolateAngleDeg(m_oldSample.headingDeg, m_newSample.headingDeg, m_simulationTimeFraction);
+            return CHeading(headingDeg, m_newSituation.getHeading().getReferenceNorth(), CAngleUnit::deg());
         }
 
         CAngle CInterpolatorPbh::getPitch() const
         {
             // Interpolate Pitch: Pitch = (PitchB - PitchA) * t + PitchA
-            return interpolateAngle(m_oldSituation.getPitch(), m_newSituation.getPitch(), m_simulationTimeFraction);
+            return CAngle(SituationSample::interpolateAngleDeg(m_oldSample.pitchDeg, m_newSample.pitchDeg, m_simulationTimeFraction), CAngleUnit::deg());
         }
 
         CAngle CInterpolatorPbh::getBank() const
         {
             // Interpolate bank: Bank = (BankB - BankA) * t + BankA
-            return interpolateAngle(m_oldSituation.getBank(), m_newSituation.getBank(), m_simulationTimeFraction);
+            return CAngle(SituationSample::interpolateAngleDeg(m_oldSample.bankDeg, m_newSample.bankDeg, m_simulationTimeFraction), CAngleUnit::deg());
         }
 
         CSpeed CInterpolatorPbh::getGroundSpeed() const
         {
-            return (m_newSituation.getGroundSpeed() - m_oldSituation.getGroundSpeed())
-                   * m_simulationTimeFraction
-                   + m_oldSituation.getGroundSpeed();
+            if (m_oldSituation.getGroundSpeed().isNull() || m_newSituation.getGroundSpeed().isNull())
+            {
+                // keep the null handling of the quantities
+                return (m_newSituation.getGroundSpeed() - m_oldSituation.getGroundSpeed()) * m_simulationTimeFraction + m_oldSituation.getGroundSpeed();
+            }
+            return CSpeed(SituationSample::interpolateLinear(m_oldSample.groundSpeedKts, m_newSample.groundSpeedKts, m_simulationTimeFraction), CSpeedUnit::kts());
+        }
+
+        CHeading CInterpolatorPbh::getHeading(const SituationSample &evaluated) const
+        {
+            return CHeading(evaluated.headingDeg, m_newSituation.getHeading().getReferenceNorth(), CAngleUnit::deg());
+        }
+
+        CAngle CInterpolatorPbh::getPitch(const SituationSample &evaluated) const
+        {
+            return CAngle(evaluated.pitchDeg, CAngleUnit::deg());
+        }
+
+        CAngle CInterpolatorPbh::getBank(const SituationSample &evaluated) const
+        {
+            return CAngle(evaluated.bankDeg, CAngleUnit::deg());
+        }
+
+        CSpeed CInterpolatorPbh::getGroundSpeed(const SituationSample &evaluated) const
+        {
+            if (m_oldSituation.getGroundSpeed().isNull() || m_newSituation.getGroundSpeed().isNull()) { return this->getGroundSpeed(); }
+            return CSpeed(evaluated.groundSpeedKts, CSpeedUnit::kts());
+        }
+
+        void CInterpolatorPbh::setBatchLane(CInterpolationBatch &batch, int lane) const
+        {
+            batch.setAngleDeg(lane, CInterpolationBatch::HeadingDeg, m_oldSample.headingDeg, m_newSample.headingDeg);
+            batch.setAngleDeg(lane, CInterpolationBatch::PitchDeg,   m_oldSample.pitchDeg,   m_newSample.pitchDeg);
+            batch.setAngleDeg(lane, CInterpolationBatch::BankDeg,    m_oldSample.bankDeg,    m_newSample.bankDeg);
+            batch.setLinear(lane, CInterpolationBatch::GroundSpeedKts, m_oldSample.groundSpeedKts, m_newSample.groundSpeedKts);
         }
 
         void CInterpolatorPbh::setSituations(const CAircraftSituation &older, const CAircraftSituation &newer)
         {
             m_oldSituation = older;
             m_newSituation = newer;
+            m_oldSample = SituationSample::fromSituation(older);
+            m_newSample = SituationSample::fromSituation(newer);
         }
 
         void CInterpolatorPbh::setTimeFraction(double tf)
@@ -11,6 +11,7 @@
 #ifndef BLACKMISC_SIMULATION_INTERPOLATORPBH_H
 #define BLACKMISC_SIMULATION_INTERPOLATORPBH_H
 
+#include "blackmisc/simulation/situationsample.h"
 #include "blackmisc/aviation/aircraftsituation.h"
 #include "blackmisc/aviation/heading.h"
 #include "blackmisc/pq/angle.h"
@@ -21,15 +22,18 @@ namespace BlackMisc
 {
     namespace Simulation
     {
+        class CInterpolationBatch;
+
         //! Simple interpolator for pitch, bank, heading, groundspeed
+        //! \remark interpolates on SituationSample values, the situations are kept for the callers
         class BLACKMISC_EXPORT CInterpolatorPbh
         {
         public:
             //! Constructor
             //! @{
             CInterpolatorPbh() {}
-            CInterpolatorPbh(const Aviation::CAircraftSituation &older, const Aviation::CAircraftSituation &newer) : m_oldSituation(older), m_newSituation(newer) {}
-            CInterpolatorPbh(double time, const Aviation::CAircraftSituation &older, const Aviation::CAircraftSituation &newer) : m_simulationTimeFraction(time), m_oldSituation(older), m_newSituation(newer) {}
+            CInterpolatorPbh(const Aviation::CAircraftSituation &older, const Aviation::CAircraftSituation &newer);
+            CInterpolatorPbh(double time, const Aviation::CAircraftSituation &older, const Aviation::CAircraftSituation &newer);
             //! @}
 
             //! Getter
@@ -40,8 +44,22 @@ namespace BlackMisc
             PhysicalQuantities::CSpeed getGroundSpeed() const;
             const Aviation::CAircraftSituation &getOldSituation() const { return m_oldSituation; }
             const Aviation::CAircraftSituation &getNewSituation() const { return m_newSituation; }
+            const SituationSample &getOldSample() const { return m_oldSample; }
+            const SituationSample &getNewSample() const { return m_newSample; }
+            double getTimeFraction() const { return m_simulationTimeFraction; }
+            //! @}
+
+            //! Getter for values evaluated by CInterpolationBatch
+            //! @{
+            Aviation::CHeading getHeading(const SituationSample &evaluated) const;
+            PhysicalQuantities::CAngle getPitch(const SituationSample &evaluated) const;
+            PhysicalQuantities::CAngle getBank(const SituationSample &evaluated) const;
+            PhysicalQuantities::CSpeed getGroundSpeed(const SituationSample &evaluated) const;
             //! @}
 
+            //! Set the pitch, bank, heading and ground speed segments of a batch lane
+            void setBatchLane(CInterpolationBatch &batch, int lane) const;
+
             //! Set situations
             //! \remark mostly needed for UNIT tests
             void setSituations(const Aviation::CAircraftSituation &older, const Aviation::CAircraftSituation &newer);
@@ -50,12 +68,11 @@ namespace BlackMisc
             void setTimeFraction(double tf);
 
         private:
-            //! Interpolate angle
-            static PhysicalQuantities::CAngle interpolateAngle(const PhysicalQuantities::CAngle &begin, const PhysicalQuantities::CAngle &end, double timeFraction0to1);
-
             double m_simulationTimeFraction = 0.0;
             Aviation::CAircraftSituation m_oldSituation;
             Aviation::CAircraftSituation m_newSituation;
+            SituationSample m_oldSample; //!< values of m_oldSituation
+            SituationSample m_newSample; //!< values of m_newSituation
         };
     } // namespace
 } // namespace
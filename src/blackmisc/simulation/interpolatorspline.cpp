@@ -8,6 +8,8 @@
 
 #include "interpolatorspline.h"
 #include "interpolatorfunctions.h"
+#include "situationsample.h"
+#include "interpolationbatch.h"
 #include "blackmisc/network/fsdsetup.h"
 #include "blackmisc/logmessage.h"
 #include "blackmisc/verify.h"
@@ -184,7 +186,7 @@ namespace BlackMisc
         void CInterpolatorSpline::anchor()
         { }
 
-        CInterpolatorSpline::CInterpolant CInterpolatorSpline::getInterpolant(SituationLog &log)
+        const CInterpolatorSpline::CInterpolant &CInterpolatorSpline::getInterpolant(SituationLog &log)
         {
             // recalculate derivatives only if they changed
             // m_situationsLastModified updated in initIniterpolationStepData
@@ -203,17 +205,6 @@ namespace BlackMisc
                     return  m_interpolant;
                 }
 
-                const std::array<std::array<double, 3>, 3> normals {{ m_s[0].getPosition().normalVectorDouble(), m_s[1].getPosition().normalVectorDouble(), m_s[2].getPosition().normalVectorDouble() }};
-                PosArray pa;
-                pa.x = {{ normals[0][0], normals[1][0], normals[2][0] }}; // oldest -> latest
-                pa.y = {{ normals[0][1], normals[1][1], normals[2][1] }};
-                pa.z = {{ normals[0][2], normals[1][2], normals[2][2] }}; // latest
-                pa.t = {{ static_cast<double>(m_s[0].getAdjustedMSecsSinceEpoch()), static_cast<double>(m_s[1].getAdjustedMSecsSinceEpoch()), static_cast<double>(m_s[2].getAdjustedMSecsSinceEpoch()) }};
-
-                pa.dx = getDerivatives(pa.t, pa.x);
-                pa.dy = getDerivatives(pa.t, pa.y);
-                pa.dz = getDerivatives(pa.t, pa.z);
-
                 // - altitude unit must be the same for all three, but the unit itself does not matter
                 // - ground elevantion here normally is not available
                 // - some info how fast a plane moves: 100km/h => 1sec 27,7m => 5 secs 136m
@@ -221,13 +212,26 @@ namespace BlackMisc
                 // - and the elevation remains (almost) constant for a wider area
                 // - during flying the ground elevation not really matters
                 this->updateElevations(true);
-                static const CLengthUnit altUnit = CAltitude::defaultUnit();
-                const CLength cg(this->getModelCG().switchedUnit(altUnit));
-                const double a0 = m_s[0].getCorrectedAltitude(cg).value(altUnit); // oldest
-                const double a1 = m_s[1].getCorrectedAltitude(cg).value(altUnit);
-                const double a2 = m_s[2].getCorrectedAltitude(cg).value(altUnit); // latest
-                pa.a    = {{ a0, a1, a2 }};
-                pa.gnd  = {{ m_s[0].getOnGroundFactor(), m_s[1].getOnGroundFactor(), m_s[2].getOnGroundFactor() }};
+
+                // from here on only the plain values are used
+                const CLength cg(this->getModelCG());
+                const std::array<SituationSample, 3> samples {{ SituationSample::fromSituation(m_s[0], cg), SituationSample::fromSituation(m_s[1], cg), SituationSample::fromSituation(m_s[2], cg) }}; // oldest -> latest
+
+                PosArray pa;
+                for (size_t i = 0; i < samples.size(); ++i)
+                {
+                    const SituationSample &sample = samples[i];
+                    pa.x[i]   = sample.normalVector[0];
+                    pa.y[i]   = sample.normalVector[1];
+                    pa.z[i]   = sample.normalVector[2];
+                    pa.t[i]   = static_cast<double>(sample.adjustedMsSinceEpoch);
+                    pa.a[i]   = sample.altitudeFt;
+                    pa.gnd[i] = sample.groundFactor;
+                }
+
+                pa.dx = getDerivatives(pa.t, pa.x);
+                pa.dy = getDerivatives(pa.t, pa.y);
+                pa.dz = getDerivatives(pa.t, pa.z);
                 pa.da   = getDerivatives(pa.t, pa.a);
                 pa.dgnd = getDerivatives(pa.t, pa.gnd);
 
@@ -235,7 +239,7 @@ namespace BlackMisc
                 m_nextSampleAdjustedTime = m_s[2].getAdjustedMSecsSinceEpoch(); // latest
                 m_prevSampleTime = m_s[1].getMSecsSinceEpoch(); // last interpolated situation normally
                 m_nextSampleTime = m_s[2].getMSecsSinceEpoch(); // latest
-                m_interpolant = CInterpolant(pa, altUnit, CInterpolatorPbh(m_s[1], m_s[2])); // older, newer
+                m_interpolant = CInterpolant(pa, CLengthUnit::ft(), CInterpolatorPbh(m_s[1], m_s[2])); // older, newer
                 Q_ASSERT_X(m_prevSampleAdjustedTime < m_nextSampleAdjustedTime, Q_FUNC_INFO, "Wrong time order");
             }
 
@@ -325,7 +329,39 @@ namespace BlackMisc
             m_situationsAvailable = pa.size();
         }
 
-        CAircraftSituation CInterpolatorSpline::CInterpolant::interpolatePositionAndAltitude(const CAircraftSituation &currentSituation, bool interpolateGndFactor) const
+        SituationSample CInterpolatorSpline::CInterpolant::evaluate() const
+        {
+            const double t1 = m_pa.t[1];
+            const double t2 = m_pa.t[2]; // latest (adjusted)
+            const double t  = static_cast<double>(m_currentTimeMsSinceEpoc);
+
+            SituationSample sample;
+            if (!(t1 < t2 && t >= t1 && t < t2)) { return sample; } // invalid, reported by interpolatePositionAndAltitude
+            sample.normalVector = {{ evalSplineInterval(t, t1, t2, m_pa.x[1], m_pa.x[2], m_pa.dx[1], m_pa.dx[2]),
+                                     evalSplineInterval(t, t1, t2, m_pa.y[1], m_pa.y[2], m_pa.dy[1], m_pa.dy[2]),
+                                     evalSplineInterval(t, t1, t2, m_pa.z[1], m_pa.z[2], m_pa.dz[1], m_pa.dz[2])
+                                  }};
+            sample.altitudeFt   = evalSplineInterval(t, t1, t2, m_pa.a[1], m_pa.a[2], m_pa.da[1], m_pa.da[2]);
+            sample.groundFactor = evalSplineInterval(t, t1, t2, m_pa.gnd[1], m_pa.gnd[2], m_pa.dgnd[1], m_pa.dgnd[2]);
+            return sample;
+        }
+
+        void CInterpolatorSpline::CInterpolant::setBatchLane(CInterpolationBatch &batch, int lane) const
+        {
+            const double t1 = m_pa.t[1];
+            const double t2 = m_pa.t[2]; // latest (adjusted)
+
+            // same fraction as (current time - t1) / (t2 - t1), see CInterpolatorSpline::getInterpolant
+            batch.setLane(lane, m_pbh.getTimeFraction());
+            batch.setCubic(lane, CInterpolationBatch::NormalX,      t1, t2, m_pa.x[1],   m_pa.x[2],   m_pa.dx[1],   m_pa.dx[2]);
+            batch.setCubic(lane, CInterpolationBatch::NormalY,      t1, t2, m_pa.y[1],   m_pa.y[2],   m_pa.dy[1],   m_pa.dy[2]);
+            batch.setCubic(lane, CInterpolationBatch::NormalZ,      t1, t2, m_pa.z[1],   m_pa.z[2],   m_pa.dz[1],   m_pa.dz[2]);
+            batch.setCubic(lane, CInterpolationBatch::AltitudeFt,   t1, t2, m_pa.a[1],   m_pa.a[2],   m_pa.da[1],   m_pa.da[2]);
+            batch.setCubic(lane, CInterpolationBatch::GroundFactor, t1, t2, m_pa.gnd[1], m_pa.gnd[2], m_pa.dgnd[1], m_pa.dgnd[2]);
+            m_pbh.setBatchLane(batch, lane);
+        }
+
+        CAircraftSituation CInterpolatorSpline::CInterpolant::interpolatePositionAndAltitude(const CAircraftSituation &currentSituation, bool interpolateGndFactor, const SituationSample &evaluated) const
         {
             const double t1 = m_pa.t[1];
             const double t2 = m_pa.t[2]; // latest (adjusted)
@@ -339,10 +375,6 @@ namespace BlackMisc
             }
             if (!valid) { return CAircraftSituation::null(); }
 
-            const double newX = evalSplineInterval(m_currentTimeMsSinceEpoc, t1, t2, m_pa.x[1], m_pa.x[2], m_pa.dx[1], m_pa.dx[2]);
-            const double newY = evalSplineInterval(m_currentTimeMsSinceEpoc, t1, t2, m_pa.y[1], m_pa.y[2], m_pa.dy[1], m_pa.dy[2]);
-            const double newZ = evalSplineInterval(m_currentTimeMsSinceEpoc, t1, t2, m_pa.z[1], m_pa.z[2], m_pa.dz[1], m_pa.dz[2]);
-
             valid = CAircraftSituation::isValidVector(m_pa.x) && CAircraftSituation::isValidVector(m_pa.y) && CAircraftSituation::isValidVector(m_pa.z);
             if (!valid && CBuildConfig::isLocalDeveloperDebugBuild())
             {
@@ -353,7 +385,7 @@ namespace BlackMisc
             if (!valid) { return CAircraftSituation::null(); }
 
             CAircraftSituation newSituation(currentSituation);
-            const std::array<double, 3> normalVector = {{ newX, newY, newZ }};
+            const std::array<double, 3> &normalVector = evaluated.normalVector;
             const CCoordinateGeodetic currentPosition(normalVector);
 
             valid = CAircraftSituation::isValidVector(normalVector);
@@ -365,8 +397,7 @@ namespace BlackMisc
             }
             if (!valid) { return CAircraftSituation::null(); }
 
-            const double newA = evalSplineInterval(m_currentTimeMsSinceEpoc, t1, t2, m_pa.a[1], m_pa.a[2], m_pa.da[1], m_pa.da[2]);
-            const CAltitude alt(newA, m_altitudeUnit);
+            const CAltitude alt(evaluated.altitudeFt, m_altitudeUnit);
 
             newSituation.setPosition(currentPosition);
             newSituation.setAltitude(alt);
@@ -381,8 +412,7 @@ namespace BlackMisc
                     newSituation.setOnGroundDetails(CAircraftSituation::OnGroundByInterpolation);
                     if (CAircraftSituation::isGfEqualAirborne(gnd1, gnd2)) { newSituation.setOnGround(false); break; }
                     if (CAircraftSituation::isGfEqualOnGround(gnd1, gnd2)) { newSituation.setOnGround(true); break; }
-                    const double newGnd = evalSplineInterval(m_currentTimeMsSinceEpoc, t1, t2, gnd1, gnd2, m_pa.dgnd[1], m_pa.dgnd[2]);
-                    newSituation.setOnGroundFactor(newGnd);
+                    newSituation.setOnGroundFactor(evaluated.groundFactor);
                     newSituation.setOnGroundFromGroundFactorFromInterpolation(groundInterpolationFactor());
                 }
                 while (false);
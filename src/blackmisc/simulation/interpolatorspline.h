@@ -64,7 +64,20 @@ namespace BlackMisc
                 CInterpolant(const PosArray &pa, const PhysicalQuantities::CLengthUnit &altitudeUnit, const CInterpolatorPbh &pbh);
 
                 //! Perform the interpolation
-                Aviation::CAircraftSituation interpolatePositionAndAltitude(const Aviation::CAircraftSituation &currentSituation, bool interpolateGndFactor) const;
+                Aviation::CAircraftSituation interpolatePositionAndAltitude(const Aviation::CAircraftSituation &currentSituation, bool interpolateGndFactor) const
+                {
+                    return this->interpolatePositionAndAltitude(currentSituation, interpolateGndFactor, this->evaluate());
+                }
+
+                //! Perform the interpolation with position, altitude and ground factor evaluated before
+                //! \sa CInterpolationBatch::sample
+                Aviation::CAircraftSituation interpolatePositionAndAltitude(const Aviation::CAircraftSituation &currentSituation, bool interpolateGndFactor, const SituationSample &evaluated) const;
+
+                //! Position, altitude and ground factor at the current time
+                SituationSample evaluate() const;
+
+                //! Set a batch lane with the segments of this interpolant
+                void setBatchLane(CInterpolationBatch &batch, int lane) const;
 
                 //! Old situation
                 const Aviation::CAircraftSituation &getOldSituation() const { return pbh().getOldSituation(); }
@@ -85,7 +98,11 @@ namespace BlackMisc
             };
 
             //! Strategy used by CInterpolator::getInterpolatedSituation
-            CInterpolant getInterpolant(SituationLog &log);
+            //! \remark reference to the current interpolant, valid until the next call
+            const CInterpolant &getInterpolant(SituationLog &log);
+
+            //! Interpolant of the last CInterpolatorSpline::getInterpolant call
+            const CInterpolant &getCurrentInterpolant() const { return m_interpolant; }
 
         private:
             //! Update the elevations used in CInterpolatorSpline::m_s
@@ -8,13 +8,17 @@
 
 #include "blackmisc/simulation/remoteaircraftprovider.h"
 #include "blackmisc/simulation/matchingutils.h"
+#include "blackmisc/aviation/callsigninterner.h"
 #include "blackmisc/aviation/logutils.h"
 #include "blackmisc/logmessage.h"
 #include "blackmisc/json.h"
 #include "blackmisc/verify.h"
 #include "blackmisc/stringutils.h"
+#include "blackmisc/range.h"
 #include "blackconfig/buildconfig.h"
 
+#include <QVector>
+
 using namespace BlackMisc::Aviation;
 using namespace BlackMisc::PhysicalQuantities;
 using namespace BlackMisc::Geo;
@@ -61,8 +65,9 @@ namespace BlackMisc
 
         CSimulatedAircraft CRemoteAircraftProvider::getAircraftInRangeForCallsign(const CCallsign &callsign) const
         {
-            const CSimulatedAircraft aircraft = this->getAircraftInRange().findFirstByCallsign(callsign);
-            return aircraft;
+            const int id = CCallsignInterner::findId(callsign);
+            QReadLocker l(&m_lockAircraft);
+            return m_aircraftInRange.value(id);
         }
 
         CAircraftModel CRemoteAircraftProvider::getAircraftInRangeModelForCallsign(const CCallsign &callsign) const
@@ -73,10 +78,13 @@ namespace BlackMisc
 
         CAircraftSituationList CRemoteAircraftProvider::remoteAircraftSituations(const CCallsign &callsign) const
         {
-            static const CAircraftSituationList empty;
-            QReadLocker l(&m_lockSituations);
-            if (!m_situationsByCallsign.contains(callsign)) { return empty; }
-            return m_situationsByCallsign[callsign];
+            return this->remoteAircraftSituations(CCallsignInterner::findId(callsign));
+        }
+
+        CAircraftSituationList CRemoteAircraftProvider::remoteAircraftSituations(int callsignId) const
+        {
+            const std::shared_ptr<CAircraftSituationBuffer> buffer = this->situationBuffer(callsignId);
+            return buffer ? buffer->situations() : CAircraftSituationList();
         }
 
         CAircraftSituation CRemoteAircraftProvider::remoteAircraftSituation(const CCallsign &callsign, int index) const
@@ -95,9 +103,17 @@ namespace BlackMisc
         CAircraftSituationList CRemoteAircraftProvider::latestRemoteAircraftSituations() const
         {
             QReadLocker l(&m_lockSituations);
-            const QList<CAircraftSituation> situations(m_latestSituationByCallsign.values());
+            const QList<std::shared_ptr<CAircraftSituationBuffer>> buffers(m_situationsByCallsign.values());
             l.unlock();
-            return CAircraftSituationList(situations);
+
+            CAircraftSituationList situations;
+            for (const std::shared_ptr<CAircraftSituationBuffer> &buffer : buffers)
+            {
+                const auto snapshot = buffer->read();
+                if (snapshot->situations.isEmpty()) { continue; }
+                situations.push_back(snapshot->latest);
+            }
+            return situations;
         }
 
         CAircraftSituationList CRemoteAircraftProvider::latestOnGroundProviderElevations() const
@@ -110,24 +126,27 @@ namespace BlackMisc
 
         int CRemoteAircraftProvider::remoteAircraftSituationsCount(const CCallsign &callsign) const
         {
-            QReadLocker l(&m_lockSituations);
-            if (!m_situationsByCallsign.contains(callsign)) { return -1; }
-            return m_situationsByCallsign[callsign].size();
+            const std::shared_ptr<CAircraftSituationBuffer> buffer = this->situationBuffer(CCallsignInterner::findId(callsign));
+            return buffer ? buffer->read()->situations.size() : -1;
         }
 
         CAircraftPartsList CRemoteAircraftProvider::remoteAircraftParts(const CCallsign &callsign) const
         {
-            static const CAircraftPartsList empty;
+            return this->remoteAircraftParts(CCallsignInterner::findId(callsign));
+        }
+
+        CAircraftPartsList CRemoteAircraftProvider::remoteAircraftParts(int callsignId) const
+        {
             QReadLocker l(&m_lockParts);
-            if (!m_partsByCallsign.contains(callsign)) { return empty; }
-            return m_partsByCallsign[callsign];
+            return m_partsByCallsign.value(callsignId);
         }
 
         int CRemoteAircraftProvider::remoteAircraftPartsCount(const CCallsign &callsign) const
         {
+            const int id = CCallsignInterner::findId(callsign);
             QReadLocker l(&m_lockParts);
-            if (!m_partsByCallsign.contains(callsign)) { return -1; }
-            return m_partsByCallsign[callsign].size();
+            if (!m_partsByCallsign.contains(id)) { return -1; }
+            return m_partsByCallsign[id].size();
         }
 
         bool CRemoteAircraftProvider::isRemoteAircraftSupportingParts(const CCallsign &callsign) const
@@ -149,15 +168,21 @@ namespace BlackMisc
         }
 
         CAircraftSituationChangeList CRemoteAircraftProvider::remoteAircraftSituationChanges(const CCallsign &callsign) const
+        {
+            return this->remoteAircraftSituationChanges(CCallsignInterner::findId(callsign));
+        }
+
+        CAircraftSituationChangeList CRemoteAircraftProvider::remoteAircraftSituationChanges(int callsignId) const
         {
             QReadLocker l(&m_lockChanges);
-            return m_changesByCallsign[callsign];
+            return m_changesByCallsign.value(callsignId);
         }
 
         int CRemoteAircraftProvider::remoteAircraftSituationChangesCount(const CCallsign &callsign) const
         {
+            const int id = CCallsignInterner::findId(callsign);
             QReadLocker l(&m_lockChanges);
-            return m_changesByCallsign[callsign].size();
+            return m_changesByCallsign[id].size();
         }
 
         int CRemoteAircraftProvider::getAircraftInRangeCount() const
@@ -181,10 +206,8 @@ namespace BlackMisc
             {
                 QWriteLocker l(&m_lockSituations);
                 m_situationsByCallsign.clear();
-                m_latestSituationByCallsign.clear();
                 m_latestOnGroundProviderElevation.clear();
                 m_situationsAdded = 0;
-                m_situationsLastModified.clear();
                 m_testOffset.clear();
             }
             {
@@ -231,9 +254,10 @@ namespace BlackMisc
             Q_ASSERT_X(!callsign.isEmpty(), Q_FUNC_INFO, "Missing callsign");
             int c = 0;
             {
+                const int id = CCallsignInterner::findId(callsign);
                 QWriteLocker l(&m_lockAircraft);
-                if (!m_aircraftInRange.contains(callsign)) { return 0; }
-                c = m_aircraftInRange[callsign].apply(vm, skipEqualValues).size();
+                if (!m_aircraftInRange.contains(id)) { return 0; }
+                c = m_aircraftInRange[id].apply(vm, skipEqualValues).size();
             }
             if (c > 0)
             {
@@ -246,9 +270,10 @@ namespace BlackMisc
         {
             Q_ASSERT_X(!callsign.isEmpty(), Q_FUNC_INFO, "Missing callsign");
             {
+                const int id = CCallsignInterner::findId(callsign);
                 QWriteLocker l(&m_lockAircraft);
-                if (!m_aircraftInRange.contains(callsign)) { return false; }
-                CSimulatedAircraft &aircraft =  m_aircraftInRange[callsign];
+                if (!m_aircraftInRange.contains(id)) { return false; }
+                CSimulatedAircraft &aircraft =  m_aircraftInRange[id];
                 aircraft.setSituation(situation);
                 if (!bearing.isNull())  { aircraft.setRelativeBearing(bearing); }
                 if (!distance.isNull()) { aircraft.setRelativeDistance(distance); }
@@ -258,95 +283,160 @@ namespace BlackMisc
 
         CAircraftSituation CRemoteAircraftProvider::storeAircraftSituation(const CAircraftSituation &situation, bool allowTestAltitudeOffset)
         {
-            const CCallsign cs = situation.getCallsign();
-            if (cs.isEmpty()) { return situation; }
-
-            // testing
-            if (CBuildConfig::isLocalDeveloperDebugBuild())
-            {
-                BLACK_VERIFY_X(situation.getTimeOffsetMs() > 0, Q_FUNC_INFO, "Missing offset");
-                BLACK_VERIFY_X(situation.isValidVectorRange(),  Q_FUNC_INFO, "Invalid vector");
-            }
+            if (situation.getCallsign().isEmpty()) { return situation; }
+            CAircraftSituationList situations;
+            situations.push_back(situation);
+            return this->storeAircraftSituationsImpl(situations, allowTestAltitudeOffset).front();
+        }
 
-            // add altitude offset (for testing only)
-            CAircraftSituation situationCorrected(allowTestAltitudeOffset ? this->addTestAltitudeOffsetToSituation(situation) : situation);
+        CAircraftSituationList CRemoteAircraftProvider::storeAircraftSituations(const CAircraftSituationList &situations, bool allowTestAltitudeOffset)
+        {
+            return this->storeAircraftSituationsImpl(situations, allowTestAltitudeOffset);
+        }
 
-            // CG, model
-            const CAircraftModel aircraftModel = this->getAircraftInRangeModelForCallsign(cs);
-            if (situation.hasCG() && aircraftModel.getCG() != situation.getCG())
-            {
-                this->updateCG(cs, situation.getCG());
-            }
+        CAircraftSituationList CRemoteAircraftProvider::storeAircraftSituationsImpl(const CAircraftSituationList &situations, bool allowTestAltitudeOffset)
+        {
+            const int count = situations.sizeInt();
+            CAircraftSituationList situationsCorrected;   // same order as situations
+            QVector<CAircraftModel> aircraftModels;       // model per situation
+            QVector<CAircraftSituationList> updatedSituations(count); // copies of updated situations
+            aircraftModels.reserve(count);
 
-            // list from new to old
-            CAircraftSituationList updatedSituations; // copy of updated situations
+            // everything not needing the situations lock is done upfront
+            for (const CAircraftSituation &situation : situations)
             {
-                const qint64 now = QDateTime::currentMSecsSinceEpoch();
-                QWriteLocker lock(&m_lockSituations);
-                m_situationsAdded++;
-                m_situationsLastModified[cs] = now;
-                CAircraftSituationList &newSituationsList = m_situationsByCallsign[cs];
-                newSituationsList.setAdjustedSortHint(CAircraftSituationList::AdjustedTimestampLatestFirst);
-                const int situations = newSituationsList.size();
-                if (situations < 1)
+                const CCallsign cs = situation.getCallsign();
+                if (cs.isEmpty())
                 {
-                    newSituationsList.prefillLatestAdjustedFirst(situationCorrected, IRemoteAircraftProvider::MaxSituationsPerCallsign);
+                    situationsCorrected.push_back(situation);
+                    aircraftModels.push_back(CAircraftModel());
+                    continue;
                 }
-                else
-                {
-                    // newSituationsList.push_frontKeepLatestFirstIgnoreOverlapping(situationCorrected, true, IRemoteAircraftProvider::MaxSituationsPerCallsign);
-                    newSituationsList.push_frontKeepLatestFirstAdjustOffset(situationCorrected, true, IRemoteAircraftProvider::MaxSituationsPerCallsign);
-                    newSituationsList.setAdjustedSortHint(CAircraftSituationList::AdjustedTimestampLatestFirst);
-                    newSituationsList.transferElevationForward(); // transfer elevations, will do nothing if elevations already exist
 
-                    // unify all inbound ground information
-                    if (situation.hasInboundGroundDetails())
-                    {
-                        newSituationsList.setOnGroundDetails(situation.getOnGroundDetails());
-                    }
+                // testing
+                if (CBuildConfig::isLocalDeveloperDebugBuild())
+                {
+                    BLACK_VERIFY_X(situation.getTimeOffsetMs() > 0, Q_FUNC_INFO, "Missing offset");
+                    BLACK_VERIFY_X(situation.isValidVectorRange(),  Q_FUNC_INFO, "Invalid vector");
                 }
-                m_latestSituationByCallsign[cs] = situationCorrected;
 
-                // check sort order
-                if (CBuildConfig::isLocalDeveloperDebugBuild())
+                // add altitude offset (for testing only)
+                situationsCorrected.push_back(allowTestAltitudeOffset ? this->addTestAltitudeOffsetToSituation(situation) : situation);
+
+                // CG, model
+                const CAircraftModel aircraftModel = this->getAircraftInRangeModelForCallsign(cs);
+                if (situation.hasCG() && aircraftModel.getCG() != situation.getCG())
                 {
-                    BLACK_VERIFY_X(newSituationsList.isSortedAdjustedLatestFirstWithoutNullPositions(), Q_FUNC_INFO, "wrong adjusted sort order");
-                    BLACK_VERIFY_X(newSituationsList.isSortedLatestFirst(), Q_FUNC_INFO, "wrong sort order");
-                    BLACK_VERIFY_X(newSituationsList.size() <= IRemoteAircraftProvider::MaxSituationsPerCallsign, Q_FUNC_INFO, "Wrong size");
+                    this->updateCG(cs, situation.getCG());
                 }
+                aircraftModels.push_back(aircraftModel);
+            }
 
-                if (!situation.hasInboundGroundDetails())
+            // list from new to old, published per aircraft, readers are never blocked
+            {
+                const qint64 now = QDateTime::currentMSecsSinceEpoch();
+                for (int i = 0; i < count; ++i)
                 {
-                    // first use a version without standard deviations to guess "on ground
-                    const CAircraftSituationChange simpleChange(updatedSituations, situationCorrected.getCG(), aircraftModel.isVtol(), true, false);
+                    const CAircraftSituation &situation = situations[i];
+                    const CCallsign cs = situation.getCallsign();
+                    if (cs.isEmpty()) { continue; }
+
+                    const CAircraftSituation &situationCorrected = situationsCorrected[i];
+                    const std::shared_ptr<CAircraftSituationBuffer> buffer = this->situationBufferForWriting(CCallsignInterner::id(cs));
+                    m_situationsAdded++;
+                    buffer->modify([&](CAircraftSituationBuffer::Snapshot &snapshot)
+                    {
+                        CAircraftSituationList &newSituationsList = snapshot.situations;
+                        newSituationsList.setAdjustedSortHint(CAircraftSituationList::AdjustedTimestampLatestFirst);
+                        const int situationsSize = newSituationsList.size();
+                        if (situationsSize < 1)
+                        {
+                            newSituationsList.prefillLatestAdjustedFirst(situationCorrected, IRemoteAircraftProvider::MaxSituationsPerCallsign);
+                        }
+                        else
+                        {
+                            // newSituationsList.push_frontKeepLatestFirstIgnoreOverlapping(situationCorrected, true, IRemoteAircraftProvider::MaxSituationsPerCallsign);
+                            newSituationsList.push_frontKeepLatestFirstAdjustOffset(situationCorrected, true, IRemoteAircraftProvider::MaxSituationsPerCallsign);
+                            newSituationsList.setAdjustedSortHint(CAircraftSituationList::AdjustedTimestampLatestFirst);
+                            newSituationsList.transferElevationForward(); // transfer elevations, will do nothing if elevations already exist
 
-                    // guess GND
-                    newSituationsList.front().guessOnGround(simpleChange, aircraftModel);
-                }
-                updatedSituations = m_situationsByCallsign[cs];
+                            // unify all inbound ground information
+                            if (situation.hasInboundGroundDetails())
+                            {
+                                newSituationsList.setOnGroundDetails(situation.getOnGroundDetails());
+                            }
+                        }
+                        snapshot.latest = situationCorrected;
 
-            } // lock
+                        // check sort order
+                        if (CBuildConfig::isLocalDeveloperDebugBuild())
+                        {
+                            BLACK_VERIFY_X(newSituationsList.isSortedAdjustedLatestFirstWithoutNullPositions(), Q_FUNC_INFO, "wrong adjusted sort order");
+                            BLACK_VERIFY_X(newSituationsList.isSortedLatestFirst(), Q_FUNC_INFO, "wrong sort order");
+                            BLACK_VERIFY_X(newSituationsList.size() <= IRemoteAircraftProvider::MaxSituationsPerCallsign, Q_FUNC_INFO, "Wrong size");
+                        }
 
-            // calculate change AFTER gnd. was guessed
-            Q_ASSERT_X(!updatedSituations.isEmpty(), Q_FUNC_INFO, "Missing situations");
-            const CAircraftSituationChange change(updatedSituations, situationCorrected.getCG(), aircraftModel.isVtol(), true, true);
-            this->storeChange(change);
+                        if (!situation.hasInboundGroundDetails())
+                        {
+                            // first use a version without standard deviations to guess "on ground
+                            const CAircraftSituationChange simpleChange(updatedSituations[i], situationCorrected.getCG(), aircraftModels[i].isVtol(), true, false);
+
+                            // guess GND
+                            newSituationsList.front().guessOnGround(simpleChange, aircraftModels[i]);
+                        }
+                        updatedSituations[i] = newSituationsList;
+                        return true;
+                    }, now);
+                }
+            }
 
-            if (change.hasSceneryDeviation())
+            // calculate change AFTER gnd. was guessed
+            QVector<int> withSceneryDeviation;
+            for (int i = 0; i < count; ++i)
             {
-                const CLength offset = change.getGuessedSceneryDeviation();
-                situationCorrected.setSceneryOffset(offset);
+                if (situations[i].getCallsign().isEmpty()) { continue; }
+                Q_ASSERT_X(!updatedSituations[i].isEmpty(), Q_FUNC_INFO, "Missing situations");
+                const CAircraftSituationChange change(updatedSituations[i], situationsCorrected[i].getCG(), aircraftModels[i].isVtol(), true, true);
+                this->storeChange(change);
+
+                if (change.hasSceneryDeviation())
+                {
+                    situationsCorrected[i].setSceneryOffset(change.getGuessedSceneryDeviation());
+                    withSceneryDeviation.push_back(i);
+                }
+            }
 
-                QWriteLocker lock(&m_lockSituations);
-                m_latestSituationByCallsign[cs].setSceneryOffset(offset);
-                m_situationsByCallsign[cs].front().setSceneryOffset(offset);
+            for (int i : as_const(withSceneryDeviation))
+            {
+                const CAircraftSituation &situationCorrected = situationsCorrected[i];
+                const std::shared_ptr<CAircraftSituationBuffer> buffer = this->situationBuffer(CCallsignInterner::findId(situationCorrected.getCallsign()));
+                if (!buffer) { continue; } // removed meanwhile
+                const CLength offset = situationCorrected.getSceneryOffset();
+                const qint64 ts = situationCorrected.getMSecsSinceEpoch();
+
+                // a later situation of the same callsign in this batch might be the latest one already
+                buffer->modify([&](CAircraftSituationBuffer::Snapshot &snapshot)
+                {
+                    if (snapshot.latest.getMSecsSinceEpoch() == ts) { snapshot.latest.setSceneryOffset(offset); }
+                    for (CAircraftSituation &stored : snapshot.situations)
+                    {
+                        if (stored.getMSecsSinceEpoch() != ts) { continue; }
+                        stored.setSceneryOffset(offset);
+                        break;
+                    }
+                    return true;
+                }, -1);
             }
 
-            // situation has been added
-            emit this->addedAircraftSituation(situationCorrected);
+            // situations have been added
+            for (const CAircraftSituation &situationCorrected : as_const(situationsCorrected))
+            {
+                if (situationCorrected.getCallsign().isEmpty()) { continue; }
+                emit this->addedAircraftSituation(situationCorrected);
+            }
 
             // bye
-            return situationCorrected;
+            return situationsCorrected;
         }
 
         void CRemoteAircraftProvider::storeAircraftParts(const CCallsign &callsign, const CAircraftParts &parts, bool removeOutdated)
@@ -356,12 +446,13 @@ namespace BlackMisc
 
             // list sorted from new to old
             const qint64 ts = QDateTime::currentMSecsSinceEpoch();
+            const int id = CCallsignInterner::id(callsign);
             CAircraftPartsList correctiveParts;
             {
                 QWriteLocker lock(&m_lockParts);
                 m_partsAdded++;
-                m_partsLastModified[callsign] = ts;
-                CAircraftPartsList &partsList = m_partsByCallsign[callsign];
+                m_partsLastModified[id] = ts;
+                CAircraftPartsList &partsList = m_partsByCallsign[id];
                 partsList.push_frontKeepLatestFirstAdjustOffset(parts, true, IRemoteAircraftProvider::MaxPartsPerCallsign);
                 partsList.setAdjustedSortHint(CAircraftPartsList::AdjustedTimestampLatestFirst);
 
@@ -377,18 +468,22 @@ namespace BlackMisc
             // adjust gnd.flag from parts
             if (!correctiveParts.isEmpty())
             {
-                QWriteLocker lock(&m_lockSituations);
-                CAircraftSituationList &situationList = m_situationsByCallsign[callsign];
-                const int c = situationList.adjustGroundFlag(parts);
-                if (c > 0) { m_situationsLastModified[callsign] = ts; }
+                const std::shared_ptr<CAircraftSituationBuffer> buffer = this->situationBuffer(id);
+                if (buffer)
+                {
+                    buffer->modify([&](CAircraftSituationBuffer::Snapshot &snapshot)
+                    {
+                        return snapshot.situations.adjustGroundFlag(parts) > 0;
+                    }, ts);
+                }
             }
 
             // update aircraft
             {
                 QWriteLocker l(&m_lockAircraft);
-                if (m_aircraftInRange.contains(callsign))
+                if (m_aircraftInRange.contains(id))
                 {
-                    CSimulatedAircraft &aircraft = m_aircraftInRange[callsign];
+                    CSimulatedAircraft &aircraft = m_aircraftInRange[id];
                     aircraft.setParts(parts);
                     aircraft.setPartsSynchronized(true);
                 }
@@ -491,12 +586,29 @@ namespace BlackMisc
             }
         }
 
+        std::shared_ptr<CAircraftSituationBuffer> CRemoteAircraftProvider::situationBuffer(int callsignId) const
+        {
+            QReadLocker l(&m_lockSituations);
+            return m_situationsByCallsign.value(callsignId);
+        }
+
+        std::shared_ptr<CAircraftSituationBuffer> CRemoteAircraftProvider::situationBufferForWriting(int callsignId)
+        {
+            std::shared_ptr<CAircraftSituationBuffer> buffer = this->situationBuffer(callsignId);
+            if (buffer) { return buffer; }
+
+            QWriteLocker l(&m_lockSituations);
+            std::shared_ptr<CAircraftSituationBuffer> &newBuffer = m_situationsByCallsign[callsignId];
+            if (!newBuffer) { newBuffer = std::make_shared<CAircraftSituationBuffer>(IRemoteAircraftProvider::MaxSituationsPerCallsign); } // might have been added meanwhile
+            return newBuffer;
+        }
+
         void CRemoteAircraftProvider::storeChange(const CAircraftSituationChange &change)
         {
             // a change with the same timestamp will be replaced
-            const CCallsign cs(change.getCallsign());
+            const int id = CCallsignInterner::id(change.getCallsign());
             QWriteLocker lock(&m_lockChanges);
-            CAircraftSituationChangeList &changeList = m_changesByCallsign[cs];
+            CAircraftSituationChangeList &changeList = m_changesByCallsign[id];
             changeList.push_frontKeepLatestAdjustedFirst(change, true, IRemoteAircraftProvider::MaxSituationsPerCallsign);
         }
 
@@ -515,9 +627,10 @@ namespace BlackMisc
 
         bool CRemoteAircraftProvider::setAircraftEnabledFlag(const CCallsign &callsign, bool enabledForRendering)
         {
+            const int id = CCallsignInterner::findId(callsign);
             QWriteLocker l(&m_lockAircraft);
-            if (!m_aircraftInRange.contains(callsign)) { return false; }
-            return m_aircraftInRange[callsign].setEnabled(enabledForRendering);
+            if (!m_aircraftInRange.contains(id)) { return false; }
+            return m_aircraftInRange[id].setEnabled(enabledForRendering);
         }
 
         int CRemoteAircraftProvider::updateMultipleAircraftEnabled(const CCallsignSet &callsigns, bool enabledForRendering)
@@ -527,8 +640,9 @@ namespace BlackMisc
             int c = 0;
             for (const CCallsign &cs : callsigns)
             {
-                if (!m_aircraftInRange.contains(cs)) { continue; }
-                if (m_aircraftInRange[cs].setEnabled(enabledForRendering)) { c++; }
+                const int id = CCallsignInterner::findId(cs);
+                if (!m_aircraftInRange.contains(id)) { continue; }
+                if (m_aircraftInRange[id].setEnabled(enabledForRendering)) { c++; }
             }
             return c;
         }
@@ -551,16 +665,18 @@ namespace BlackMisc
 
         bool CRemoteAircraftProvider::updateFastPositionEnabled(const CCallsign &callsign, bool enableFastPositonUpdates)
         {
+            const int id = CCallsignInterner::findId(callsign);
             QWriteLocker l(&m_lockAircraft);
-            if (!m_aircraftInRange.contains(callsign)) { return false; }
-            return m_aircraftInRange[callsign].setFastPositionUpdates(enableFastPositonUpdates);
+            if (!m_aircraftInRange.contains(id)) { return false; }
+            return m_aircraftInRange[id].setFastPositionUpdates(enableFastPositonUpdates);
         }
 
         bool CRemoteAircraftProvider::updateAircraftRendered(const CCallsign &callsign, bool rendered)
         {
+            const int id = CCallsignInterner::findId(callsign);
             QWriteLocker l(&m_lockAircraft);
-            if (!m_aircraftInRange.contains(callsign)) { return false; }
-            return m_aircraftInRange[callsign].setRendered(rendered);
+            if (!m_aircraftInRange.contains(id)) { return false; }
+            return m_aircraftInRange[id].setRendered(rendered);
         }
 
         int CRemoteAircraftProvider::updateMultipleAircraftRendered(const CCallsignSet &callsigns, bool rendered)
@@ -569,8 +685,9 @@ namespace BlackMisc
             int c = 0;
             for (const CCallsign &cs : callsigns)
             {
-                if (!m_aircraftInRange.contains(cs)) { continue; }
-                if (m_aircraftInRange[cs].setRendered(rendered)) { c++; }
+                const int id = CCallsignInterner::findId(cs);
+                if (!m_aircraftInRange.contains(id)) { continue; }
+                if (m_aircraftInRange[id].setRendered(rendered)) { c++; }
             }
             return c;
         }
@@ -581,23 +698,32 @@ namespace BlackMisc
 
             // update aircraft situation
             const qint64 now = QDateTime::currentMSecsSinceEpoch();
+            const int id = CCallsignInterner::id(callsign);
             const CAircraftModel model = this->getAircraftInRangeModelForCallsign(callsign);
             CAircraftSituationChange change;
             bool setForOnGndPosition = false;
 
             int updated = 0;
+            CAircraftSituation latestSituation;
             {
-                QWriteLocker l(&m_lockSituations);
-                CAircraftSituationList &situations = m_situationsByCallsign[callsign];
-                if (situations.isEmpty()) { return 0; }
-                updated = situations.setGroundElevationCheckedAndGuessGround(elevation, info, model, &change, &setForOnGndPosition);
-                if (updated < 1) { return 0; }
-                m_situationsLastModified[callsign] = now;
-                const CAircraftSituation latestSituation = situations.front();
-                if (info == CAircraftSituation::FromProvider && latestSituation.isOnGround())
+                const std::shared_ptr<CAircraftSituationBuffer> buffer = this->situationBuffer(id);
+                if (!buffer) { return 0; }
+                const bool published = buffer->modify([&](CAircraftSituationBuffer::Snapshot &snapshot)
                 {
-                    m_latestOnGroundProviderElevation[callsign] = latestSituation;
-                }
+                    CAircraftSituationList &situations = snapshot.situations;
+                    if (situations.isEmpty()) { return false; }
+                    updated = situations.setGroundElevationCheckedAndGuessGround(elevation, info, model, &change, &setForOnGndPosition);
+                    if (updated < 1) { return false; }
+                    latestSituation = situations.front();
+                    return true;
+                }, now);
+                if (!published) { return 0; }
+            }
+
+            if (info == CAircraftSituation::FromProvider && latestSituation.isOnGround())
+            {
+                QWriteLocker l(&m_lockSituations);
+                m_latestOnGroundProviderElevation[callsign] = latestSituation;
             }
 
             // update change
@@ -608,9 +734,9 @@ namespace BlackMisc
 
             // aircraft updates
             QWriteLocker l(&m_lockAircraft);
-            if (m_aircraftInRange.contains(callsign))
+            if (m_aircraftInRange.contains(id))
             {
-                m_aircraftInRange[callsign].setGroundElevationChecked(elevation, info);
+                m_aircraftInRange[id].setGroundElevationChecked(elevation, info);
             }
 
             if (setForOnGroundPosition) { *setForOnGroundPosition = setForOnGndPosition; }
@@ -619,17 +745,19 @@ namespace BlackMisc
 
         bool CRemoteAircraftProvider::updateCG(const CCallsign &callsign, const CLength &cg)
         {
+            const int id = CCallsignInterner::findId(callsign);
             QWriteLocker l(&m_lockAircraft);
-            if (!m_aircraftInRange.contains(callsign)) { return false; }
-            m_aircraftInRange[callsign].setCG(cg);
+            if (!m_aircraftInRange.contains(id)) { return false; }
+            m_aircraftInRange[id].setCG(cg);
             return true;
         }
 
         bool CRemoteAircraftProvider::updateCGAndModelString(const CCallsign &callsign, const CLength &cg, const QString &modelString)
         {
+            const int id = CCallsignInterner::findId(callsign);
             QWriteLocker l(&m_lockAircraft);
-            if (!m_aircraftInRange.contains(callsign)) { return false; }
-            CSimulatedAircraft &aircraft = m_aircraftInRange[callsign];
+            if (!m_aircraftInRange.contains(id)) { return false; }
+            CSimulatedAircraft &aircraft = m_aircraftInRange[id];
             if (!cg.isNull()) { aircraft.setCG(cg); }
             if (!modelString.isEmpty()) { aircraft.setModelString(modelString); }
             return true;
@@ -678,11 +806,10 @@ namespace BlackMisc
 
         void CRemoteAircraftProvider::updateMarkAllAsNotRendered()
         {
-            const CCallsignSet callsigns = this->getAircraftInRangeCallsigns();
             QWriteLocker l(&m_lockAircraft);
-            for (const CCallsign &cs : callsigns)
+            for (CSimulatedAircraft &aircraft : m_aircraftInRange)
             {
-                m_aircraftInRange[cs].setRendered(false);
+                aircraft.setRendered(false);
             }
         }
 
@@ -792,14 +919,18 @@ namespace BlackMisc
 
         int CRemoteAircraftProvider::aircraftSituationsAdded() const
         {
-            QReadLocker l(&m_lockSituations);
             return m_situationsAdded;
         }
 
         qint64 CRemoteAircraftProvider::situationsLastModified(const CCallsign &callsign) const
         {
-            QReadLocker l(&m_lockSituations);
-            return m_situationsLastModified.value(callsign, -1);
+            return this->situationsLastModified(CCallsignInterner::findId(callsign));
+        }
+
+        qint64 CRemoteAircraftProvider::situationsLastModified(int callsignId) const
+        {
+            const std::shared_ptr<CAircraftSituationBuffer> buffer = this->situationBuffer(callsignId);
+            return buffer ? buffer->read()->lastModified : -1;
         }
 
         qint64 CRemoteAircraftProvider::partsLastModified(const CCallsign &callsign) const
@@ -872,25 +1003,24 @@ namespace BlackMisc
 
         bool CRemoteAircraftProvider::removeAircraft(const CCallsign &callsign)
         {
+            const int id = CCallsignInterner::findId(callsign);
             {
                 QWriteLocker l1(&m_lockParts);
-                m_partsByCallsign.remove(callsign);
+                m_partsByCallsign.remove(id);
                 m_aircraftWithParts.remove(callsign);
-                m_partsLastModified.remove(callsign);
+                m_partsLastModified.remove(id);
             }
             {
                 QWriteLocker l2(&m_lockSituations);
-                m_situationsByCallsign.remove(callsign);
-                m_latestSituationByCallsign.remove(callsign);
+                m_situationsByCallsign.remove(id);
                 m_latestOnGroundProviderElevation.remove(callsign);
-                m_situationsLastModified.remove(callsign);
             }
             { QWriteLocker l4(&m_lockPartsHistory); m_aircraftPartsMessages.remove(callsign); }
             bool removedCallsign = false;
             {
                 QWriteLocker l(&m_lockAircraft);
                 m_dbCGPerCallsign.remove(callsign);
-                const int c = m_aircraftInRange.remove(callsign);
+                const int c = m_aircraftInRange.remove(id);
                 removedCallsign = c > 0;
             }
             return removedCallsign;
@@ -953,6 +1083,12 @@ namespace BlackMisc
             return this->provider()->remoteAircraftSituations(callsign);
         }
 
+        CAircraftSituationList CRemoteAircraftAware::remoteAircraftSituations(int callsignId) const
+        {
+            Q_ASSERT_X(this->provider(), Q_FUNC_INFO, "No object available");
+            return this->provider()->remoteAircraftSituations(callsignId);
+        }
+
         CAircraftSituation CRemoteAircraftAware::remoteAircraftSituation(const CCallsign &callsign, int index) const
         {
             Q_ASSERT_X(this->provider(), Q_FUNC_INFO, "No object available");
@@ -977,12 +1113,24 @@ namespace BlackMisc
             return this->provider()->remoteAircraftSituationChanges(callsign);
         }
 
+        CAircraftSituationChangeList CRemoteAircraftAware::remoteAircraftSituationChanges(int callsignId) const
+        {
+            Q_ASSERT_X(this->provider(), Q_FUNC_INFO, "No object available");
+            return this->provider()->remoteAircraftSituationChanges(callsignId);
+        }
+
         CAircraftPartsList CRemoteAircraftAware::remoteAircraftParts(const CCallsign &callsign) const
         {
             Q_ASSERT_X(this->provider(), Q_FUNC_INFO, "No object available");
             return this->provider()->remoteAircraftParts(callsign);
         }
 
+        CAircraftPartsList CRemoteAircraftAware::remoteAircraftParts(int callsignId) const
+        {
+            Q_ASSERT_X(this->provider(), Q_FUNC_INFO, "No object available");
+            return this->provider()->remoteAircraftParts(callsignId);
+        }
+
         int CRemoteAircraftAware::remoteAircraftPartsCount(const CCallsign &callsign) const
         {
             Q_ASSERT_X(this->provider(), Q_FUNC_INFO, "No object available");
@@ -1073,6 +1221,12 @@ namespace BlackMisc
             return this->provider()->situationsLastModified(callsign);
         }
 
+        qint64 CRemoteAircraftAware::situationsLastModified(int callsignId) const
+        {
+            Q_ASSERT_X(this->provider(), Q_FUNC_INFO, "No object available");
+            return this->provider()->situationsLastModified(callsignId);
+        }
+
         qint64 CRemoteAircraftAware::partsLastModified(const CCallsign &callsign) const
         {
             Q_ASSERT_X(this->provider(), Q_FUNC_INFO, "No object available");
@@ -12,6 +12,7 @@
 #define BLACKMISC_SIMULATION_REMOTEAIRCRAFTPROVIDER_H
 
 #include "blackmisc/simulation/aircraftmodel.h"
+#include "blackmisc/simulation/aircraftsituationbuffer.h"
 #include "blackmisc/simulation/airspaceaircraftsnapshot.h"
 #include "blackmisc/simulation/reverselookup.h"
 #include "blackmisc/simulation/simulatedaircraftlist.h"
@@ -20,6 +21,7 @@
 #include "blackmisc/aviation/aircraftsituationchangelist.h"
 #include "blackmisc/aviation/percallsign.h"
 #include "blackmisc/aviation/callsignset.h"
+#include "blackmisc/aviation/callsignidmap.h"
 #include "blackmisc/provider.h"
 #include "blackmisc/blackmiscexport.h"
 #include "blackmisc/identifiable.h"
@@ -31,7 +33,9 @@
 #include <QJsonObject>
 #include <QtGlobal>
 #include <QReadWriteLock>
+#include <atomic>
 #include <functional>
+#include <memory>
 
 namespace BlackMisc
 {
@@ -94,6 +98,12 @@ namespace BlackMisc
             //! \threadsafe
             virtual Aviation::CAircraftSituationList remoteAircraftSituations(const Aviation::CCallsign &callsign) const = 0;
 
+            //! Rendered aircraft situations by interned callsign id
+            //! \remark no callsign is hashed, for callers caching the id (e.g. per frame)
+            //! \sa Aviation::CCallsignInterner
+            //! \threadsafe
+            virtual Aviation::CAircraftSituationList remoteAircraftSituations(int callsignId) const = 0;
+
             //! Average update time
             //! \threadsafe
             virtual MillisecondsMinMaxMean remoteAircraftSituationsTimestampDifferenceMinMaxMean(const Aviation::CCallsign &callsign) const = 0;
@@ -123,6 +133,11 @@ namespace BlackMisc
             //! \threadsafe
             virtual Aviation::CAircraftPartsList remoteAircraftParts(const Aviation::CCallsign &callsign) const = 0;
 
+            //! All parts by interned callsign id
+            //! \sa Aviation::CCallsignInterner
+            //! \threadsafe
+            virtual Aviation::CAircraftPartsList remoteAircraftParts(int callsignId) const = 0;
+
             //! All parts (per callsign, time history)
             //! \threadsafe
             virtual int remoteAircraftPartsCount(const Aviation::CCallsign &callsign) const = 0;
@@ -147,6 +162,11 @@ namespace BlackMisc
             //! \threadsafe
             virtual Aviation::CAircraftSituationChangeList remoteAircraftSituationChanges(const Aviation::CCallsign &callsign) const = 0;
 
+            //! Aircraft changes by interned callsign id
+            //! \sa Aviation::CCallsignInterner
+            //! \threadsafe
+            virtual Aviation::CAircraftSituationChangeList remoteAircraftSituationChanges(int callsignId) const = 0;
+
             //! Aircraft changes count.
             //! \threadsafe
             virtual int remoteAircraftSituationChangesCount(const Aviation::CCallsign &callsign) const = 0;
@@ -249,6 +269,11 @@ namespace BlackMisc
             //! \threadsafe
             virtual qint64 situationsLastModified(const Aviation::CCallsign &callsign) const = 0;
 
+            //! When last modified, by interned callsign id
+            //! \sa Aviation::CCallsignInterner
+            //! \threadsafe
+            virtual qint64 situationsLastModified(int callsignId) const = 0;
+
             //! When last modified
             //! \threadsafe
             virtual qint64 partsLastModified(const Aviation::CCallsign &callsign) const = 0;
@@ -314,17 +339,20 @@ namespace BlackMisc
             virtual bool isAircraftInRange(const Aviation::CCallsign &callsign) const override;
             virtual bool isVtolAircraft(const Aviation::CCallsign &callsign) const override;
             virtual Aviation::CAircraftSituationList remoteAircraftSituations(const Aviation::CCallsign &callsign) const override;
+            virtual Aviation::CAircraftSituationList remoteAircraftSituations(int callsignId) const override;
             virtual Aviation::CAircraftSituation remoteAircraftSituation(const Aviation::CCallsign &callsign, int index) const override;
             virtual MillisecondsMinMaxMean remoteAircraftSituationsTimestampDifferenceMinMaxMean(const Aviation::CCallsign &callsign) const override;
             virtual Aviation::CAircraftSituationList latestRemoteAircraftSituations() const override;
             virtual Aviation::CAircraftSituationList latestOnGroundProviderElevations() const override;
             virtual int remoteAircraftSituationsCount(const Aviation::CCallsign &callsign) const override;
             virtual Aviation::CAircraftPartsList remoteAircraftParts(const Aviation::CCallsign &callsign) const override;
+            virtual Aviation::CAircraftPartsList remoteAircraftParts(int callsignId) const override;
             virtual int remoteAircraftPartsCount(const Aviation::CCallsign &callsign) const override;
             virtual bool isRemoteAircraftSupportingParts(const Aviation::CCallsign &callsign) const override;
             virtual int getRemoteAircraftSupportingPartsCount() const override;
             virtual Aviation::CCallsignSet remoteAircraftSupportingParts() const override;
             virtual Aviation::CAircraftSituationChangeList remoteAircraftSituationChanges(const Aviation::CCallsign &callsign) const override;
+            virtual Aviation::CAircraftSituationChangeList remoteAircraftSituationChanges(int callsignId) const override;
             virtual int remoteAircraftSituationChangesCount(const Aviation::CCallsign &callsign) const override;
             virtual bool updateAircraftEnabled(const Aviation::CCallsign &callsign, bool enabledForRendering) override;
             virtual bool setAircraftEnabledFlag(const BlackMisc::Aviation::CCallsign &callsign, bool enabledForRendering) override;
@@ -349,6 +377,7 @@ namespace BlackMisc
             virtual int aircraftSituationsAdded() const override;
             virtual int aircraftPartsAdded() const override;
             virtual qint64 situationsLastModified(const Aviation::CCallsign &callsign) const override;
+            virtual qint64 situationsLastModified(int callsignId) const override;
             virtual qint64 partsLastModified(const Aviation::CCallsign &callsign) const override;
             virtual Geo::CElevationPlane averageElevationOfNonMovingAircraft(const Aviation::CAircraftSituation &reference, const PhysicalQuantities::CLength &range, int minValues = 1, int sufficientValues = 2) const override;
             virtual QList<QMetaObject::Connection> connectRemoteAircraftProviderSignals(
@@ -454,6 +483,12 @@ namespace BlackMisc
             //! \threadsafe
             virtual Aviation::CAircraftSituation storeAircraftSituation(const Aviation::CAircraftSituation &situation, bool allowTestAltitudeOffset = true);
 
+            //! Store many aircraft situations at once
+            //! \remark the situations lock is only taken once for the whole batch
+            //! \remark returns the stored (corrected) situations in the order of the passed ones
+            //! \threadsafe
+            virtual Aviation::CAircraftSituationList storeAircraftSituations(const Aviation::CAircraftSituationList &situations, bool allowTestAltitudeOffset = true);
+
             //! Store an aircraft part
             //! \remark latest parts are kept first
             //! \threadsafe
@@ -479,21 +514,30 @@ namespace BlackMisc
             //! \threadsafe
             void storeChange(const Aviation::CAircraftSituationChange &change);
 
-            Aviation::CAircraftSituationListPerCallsign m_situationsByCallsign;        //!< situations, for performance reasons per callsign, thread safe access required
-            Aviation::CAircraftSituationPerCallsign m_latestSituationByCallsign;       //!< latest situations, for performance reasons per callsign, thread safe access required
-            Aviation::CAircraftSituationPerCallsign m_latestOnGroundProviderElevation; //!< situations on ground with elevation from provider
-            Aviation::CAircraftPartsListPerCallsign m_partsByCallsign;                 //!< parts, for performance reasons per callsign, thread safe access required
-            Aviation::CAircraftSituationChangeListPerCallsign m_changesByCallsign;     //!< changes, for performance reasons per callsign, thread safe access required (same timestamps as corresponding situations)
+            //! Store situations, implementation for single and batched storing
+            Aviation::CAircraftSituationList storeAircraftSituationsImpl(const Aviation::CAircraftSituationList &situations, bool allowTestAltitudeOffset);
+
+            //! Situation buffer of the callsign, null if there is none
+            //! \threadsafe
+            std::shared_ptr<CAircraftSituationBuffer> situationBuffer(int callsignId) const;
+
+            //! Situation buffer of the callsign, created if there is none
+            //! \threadsafe
+            std::shared_ptr<CAircraftSituationBuffer> situationBufferForWriting(int callsignId);
+
+            Aviation::CCallsignIdMap<std::shared_ptr<CAircraftSituationBuffer>> m_situationsByCallsign; //!< situations per callsign id, the lock only guards the map, not the buffers
+            Aviation::CAircraftSituationPerCallsign m_latestOnGroundProviderElevation;             //!< situations on ground with elevation from provider
+            Aviation::CCallsignIdMap<Aviation::CAircraftPartsList> m_partsByCallsign;              //!< parts, for performance reasons per callsign id, thread safe access required
+            Aviation::CCallsignIdMap<Aviation::CAircraftSituationChangeList> m_changesByCallsign;  //!< changes, for performance reasons per callsign id, thread safe access required (same timestamps as corresponding situations)
             Aviation::CCallsignSet m_aircraftWithParts;                                //!< aircraft supporting parts, thread safe access required
-            int m_situationsAdded = 0; //!< total number of situations added, thread safe access required
+            std::atomic<int> m_situationsAdded { 0 }; //!< total number of situations added
             int m_partsAdded      = 0; //!< total number of parts added, thread safe access required
 
             ReverseLookupLogging m_enableReverseLookupMsgs = RevLogSimplifiedInfo;     //!< shall we log. information about the matching process
-            Simulation::CSimulatedAircraftPerCallsign m_aircraftInRange;      //!< aircraft, thread safe access required
+            Aviation::CCallsignIdMap<CSimulatedAircraft> m_aircraftInRange;   //!< aircraft per callsign id, thread safe access required
             Aviation::CStatusMessageListPerCallsign m_reverseLookupMessages;  //!< reverse lookup messages
             Aviation::CStatusMessageListPerCallsign m_aircraftPartsMessages;  //!< status messages for parts history
-            Aviation::CTimestampPerCallsign m_situationsLastModified;         //!< when situations last modified
-            Aviation::CTimestampPerCallsign m_partsLastModified;              //!< when parts last modified
+            Aviation::CCallsignIdMap<qint64> m_partsLastModified;             //!< when parts last modified
             Aviation::CLengthPerCallsign    m_testOffset;                     //!< offsets
             Aviation::CLengthPerCallsign    m_dbCGPerCallsign;                //!< DB CG per callsign
             QHash<QString, PhysicalQuantities::CLength> m_dbCGPerModelString; //!< DB CG per model string
@@ -501,7 +545,7 @@ namespace BlackMisc
             bool m_enableAircraftPartsHistory = true;  //!< shall we keep a history of aircraft parts
 
             // locks
-            mutable QReadWriteLock m_lockSituations;   //!< lock for situations: m_situationsByCallsign
+            mutable QReadWriteLock m_lockSituations;   //!< lock for situations: m_situationsByCallsign (map only), m_latestOnGroundProviderElevation, m_testOffset
             mutable QReadWriteLock m_lockParts;        //!< lock for parts: m_partsByCallsign, m_aircraftSupportingParts
             mutable QReadWriteLock m_lockChanges;      //!< lock for changes: m_changesByCallsign
             mutable QReadWriteLock m_lockAircraft;     //!< lock aircraft: m_aircraftInRange, m_dbCGPerCallsign
@@ -543,6 +587,9 @@ namespace BlackMisc
             //! \copydoc IRemoteAircraftProvider::remoteAircraftSituations
             Aviation::CAircraftSituationList remoteAircraftSituations(const Aviation::CCallsign &callsign) const;
 
+            //! \copydoc IRemoteAircraftProvider::remoteAircraftSituations(int) const
+            Aviation::CAircraftSituationList remoteAircraftSituations(int callsignId) const;
+
             //! \copydoc IRemoteAircraftProvider::remoteAircraftSituation
             Aviation::CAircraftSituation remoteAircraftSituation(const Aviation::CCallsign &callsign, int index) const;
 
@@ -558,12 +605,18 @@ namespace BlackMisc
             //! \copydoc IRemoteAircraftProvider::remoteAircraftParts
             Aviation::CAircraftPartsList remoteAircraftParts(const Aviation::CCallsign &callsign) const;
 
+            //! \copydoc IRemoteAircraftProvider::remoteAircraftParts(int) const
+            Aviation::CAircraftPartsList remoteAircraftParts(int callsignId) const;
+
             //! \copydoc IRemoteAircraftProvider::remoteAircraftPartsCount
             int remoteAircraftPartsCount(const Aviation::CCallsign &callsign) const;
 
             //! \copydoc IRemoteAircraftProvider::remoteAircraftSituationChanges
             Aviation::CAircraftSituationChangeList remoteAircraftSituationChanges(const Aviation::CCallsign &callsign) const;
 
+            //! \copydoc IRemoteAircraftProvider::remoteAircraftSituationChanges(int) const
+            Aviation::CAircraftSituationChangeList remoteAircraftSituationChanges(int callsignId) const;
+
             //! \copydoc IRemoteAircraftProvider::remoteAircraftSupportingParts
             Aviation::CCallsignSet remoteAircraftSupportingParts() const;
 
@@ -618,6 +671,9 @@ namespace BlackMisc
             //! \copydoc IRemoteAircraftProvider::situationsLastModified
             qint64 situationsLastModified(const Aviation::CCallsign &callsign) const;
 
+            //! \copydoc IRemoteAircraftProvider::situationsLastModified(int) const
+            qint64 situationsLastModified(int callsignId) const;
+
             //! \copydoc IRemoteAircraftProvider::partsLastModified
             qint64 partsLastModified(const Aviation::CCallsign &callsign) const;
 
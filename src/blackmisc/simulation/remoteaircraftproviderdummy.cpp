@@ -33,10 +33,7 @@ namespace BlackMisc
 
         void CRemoteAircraftProviderDummy::insertNewSituations(const CAircraftSituationList &situations)
         {
-            for (const CAircraftSituation &situation : situations)
-            {
-                this->storeAircraftSituation(situation);
-            }
+            this->storeAircraftSituations(situations);
         }
 
         void CRemoteAircraftProviderDummy::insertNewAircraftParts(const CCallsign &callsign, const CAircraftParts &parts, bool removeOutdatedParts)
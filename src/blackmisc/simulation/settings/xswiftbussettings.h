@@ -106,6 +106,7 @@ namespace BlackMisc
                     BLACK_METAMEMBER(logRenderPhases),
                     BLACK_METAMEMBER(tcasEnabled),
                     BLACK_METAMEMBER(terrainProbeEnabled),
+                    BLACK_METAMEMBER(terrainProbeBudgetUs),
                     BLACK_METAMEMBER(timestampMSecsSinceEpoch, 0, DisabledForComparison | DisabledForHashing)
                 );
             };
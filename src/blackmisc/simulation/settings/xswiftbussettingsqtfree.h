@@ -139,6 +139,12 @@ namespace BlackMisc
                 //! Terrain probe to query ground elevation enabled?
                 void setTerrainProbeEnabled(bool enabled) { m_terrainProbeEnabled = enabled; }
 
+                //! Time in microseconds XSwiftBus spends on terrain probes per frame
+                int getTerrainProbeBudgetUs() const { return m_terrainProbeBudgetUs; }
+
+                //! Time in microseconds XSwiftBus spends on terrain probes per frame
+                void setTerrainProbeBudgetUs(int us) { m_terrainProbeBudgetUs = us; }
+
                 //! Load and parse config file
                 bool parseXSwiftBusString(const std::string &json);
 
@@ -167,6 +173,7 @@ namespace BlackMisc
                 static constexpr char JsonLogRenderPhases[]   = "renderPhases";
                 static constexpr char JsonTcas[]              = "tcas";
                 static constexpr char JsonTerrainProbe[]      = "terrainProbe";
+                static constexpr char JsonTerrainProbeBudget[] = "terrainProbeBudget";
                 static constexpr char JsonMaxPlanes[]         = "maxplanes";
                 static constexpr char JsonMaxDrawDistance[]   = "maxDrawDistance";
                 static constexpr char JsonNightTextureMode[]  = "nighttexture";
@@ -189,6 +196,7 @@ namespace BlackMisc
                 bool   m_logRenderPhases         = false;   //!< render phases debug messages
                 bool   m_tcasEnabled             = true;    //!< TCAS functionality
                 bool   m_terrainProbeEnabled     = true;    //!< terrain probe to establish ground elevation
+                int    m_terrainProbeBudgetUs    = 1000;    //!< terrain probe time per frame
                 double m_maxDrawDistanceNM       = 50.0;    //!< distance in XPlane
                 int64_t m_msSinceEpochQtFree     = 0;       //!< timestamp
             };
@@ -0,0 +1,52 @@
+/* Copyright (C) 2020
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+#include "blackmisc/simulation/situationsample.h"
+#include "blackmisc/aviation/aircraftsituation.h"
+#include "blackmisc/aviation/altitude.h"
+#include "blackmisc/pq/length.h"
+#include "blackmisc/pq/units.h"
+
+using namespace BlackMisc::Aviation;
+using namespace BlackMisc::PhysicalQuantities;
+
+namespace BlackMisc
+{
+    namespace Simulation
+    {
+        namespace
+        {
+            //! Value in unit, 0 for null
+            template <class PQ, class MU>
+            double valueOrZero(const PQ &pq, const MU &unit)
+            {
+                return pq.isNull() ? 0.0 : pq.value(unit);
+            }
+        }
+
+        SituationSample SituationSample::fromSituation(const CAircraftSituation &situation)
+        {
+            return SituationSample::fromSituation(situation, situation.getCG());
+        }
+
+        SituationSample SituationSample::fromSituation(const CAircraftSituation &situation, const CLength &cg)
+        {
+            SituationSample sample;
+            sample.normalVector   = situation.normalVectorDouble();
+            sample.altitudeFt     = valueOrZero(situation.getCorrectedAltitude(cg), CLengthUnit::ft());
+            sample.pitchDeg       = valueOrZero(situation.getPitch(), CAngleUnit::deg());
+            sample.bankDeg        = valueOrZero(situation.getBank(), CAngleUnit::deg());
+            sample.headingDeg     = valueOrZero(situation.getHeading(), CAngleUnit::deg());
+            sample.groundSpeedKts = valueOrZero(situation.getGroundSpeed(), CSpeedUnit::kts());
+            sample.groundFactor   = situation.getOnGroundFactor();
+            sample.msSinceEpoch   = situation.getMSecsSinceEpoch();
+            sample.adjustedMsSinceEpoch = situation.getAdjustedMSecsSinceEpoch();
+            return sample;
+        }
+    } // namespace
+} // namespace
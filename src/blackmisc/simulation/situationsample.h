@@ -0,0 +1,75 @@
+/* Copyright (C) 2020
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \file
+
+#ifndef BLACKMISC_SIMULATION_SITUATIONSAMPLE_H
+#define BLACKMISC_SIMULATION_SITUATIONSAMPLE_H
+
+#include "blackmisc/blackmiscexport.h"
+
+#include <QtGlobal>
+#include <array>
+#include <type_traits>
+
+namespace BlackMisc
+{
+    namespace PhysicalQuantities { class CLength; }
+    namespace Aviation { class CAircraftSituation; }
+    namespace Simulation
+    {
+        /*!
+         * Compact, trivially copyable values of a situation as used by the interpolation kernels
+         * \details A CAircraftSituation carries physical quantities with units, a callsign, strings and more.
+         *          The kernels only need plain numbers, so situations are converted once when an interpolant
+         *          is calculated and not in every interpolation step.
+         */
+        struct BLACKMISC_EXPORT SituationSample
+        {
+            std::array<double, 3> normalVector {{ 0.0, 0.0, 0.0 }}; //!< position as normal vector
+            double altitudeFt     =  0.0; //!< corrected altitude MSL in ft, see Aviation::CAircraftSituation::getCorrectedAltitude
+            double pitchDeg       =  0.0; //!< pitch in degrees
+            double bankDeg        =  0.0; //!< bank in degrees
+            double headingDeg     =  0.0; //!< heading in degrees
+            double groundSpeedKts =  0.0; //!< ground speed in kts
+            double groundFactor   = -1.0; //!< ground factor, see Aviation::CAircraftSituation::getOnGroundFactor
+            qint64 msSinceEpoch   = -1;   //!< timestamp
+            qint64 adjustedMsSinceEpoch = -1; //!< timestamp plus offset time
+
+            //! Sample of a situation, altitude corrected with the situation's CG
+            static SituationSample fromSituation(const Aviation::CAircraftSituation &situation);
+
+            //! Sample of a situation, altitude corrected with the given CG
+            static SituationSample fromSituation(const Aviation::CAircraftSituation &situation, const PhysicalQuantities::CLength &cg);
+
+            //! Interpolate an angle in degrees the shorter way round
+            //! \remark -30 -> 30 via 0, 170 -> -170 via 180
+            static double interpolateAngleDeg(double beginDeg, double endDeg, double timeFraction0to1)
+            {
+                double deltaDeg = endDeg - beginDeg;
+                if (deltaDeg > 180.0) { deltaDeg -= 360.0; }
+                else if (deltaDeg < -180.0) { deltaDeg += 360.0; }
+
+                // make sure to not end up with extrapolation
+                if (timeFraction0to1 >= 1.0) { return beginDeg + deltaDeg; }
+                if (timeFraction0to1 <= 0.0) { return beginDeg; }
+                return beginDeg + timeFraction0to1 * deltaDeg;
+            }
+
+            //! Linear interpolation
+            static double interpolateLinear(double begin, double end, double timeFraction0to1)
+            {
+                return (end - begin) * timeFraction0to1 + begin;
+            }
+        };
+
+        static_assert(std::is_trivially_copyable<SituationSample>::value, "SituationSample shall be copied as plain memory");
+    } // namespace
+} // namespace
+
+#endif // guard
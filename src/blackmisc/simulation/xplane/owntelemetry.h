@@ -0,0 +1,157 @@
+/* Copyright (C) 2020
+ * swift Project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \file
+
+#ifndef BLACKMISC_SIMULATION_XPLANE_OWNTELEMETRY_H
+#define BLACKMISC_SIMULATION_XPLANE_OWNTELEMETRY_H
+
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+// Strict header only layout of the own aircraft telemetry signal shared between the X-Plane driver and XSwiftBus.
+// Header only is necessary to no require XSwiftBus to link against BlackMisc.
+
+namespace BlackMisc
+{
+    namespace Simulation
+    {
+        namespace XPlane
+        {
+            namespace OwnTelemetry
+            {
+                //! Index in the value array of the telemetry signal, the engine N1 values follow OwnTelemetry::ValueCount
+                enum Value : std::size_t
+                {
+                    LatitudeDeg,          //!< latitude
+                    LongitudeDeg,         //!< longitude
+                    AltitudeM,            //!< altitude MSL
+                    GroundSpeedMs,        //!< ground speed
+                    PitchDeg,             //!< pitch
+                    RollDeg,              //!< roll
+                    TrueHeadingDeg,       //!< true heading
+                    SeaLevelPressureInHg, //!< sea level pressure
+                    Com1Volume,           //!< COM1 volume 0..1
+                    Com2Volume,           //!< COM2 volume 0..1
+                    FlapsDeployRatio,     //!< flaps ratio
+                    GearDeployRatio,      //!< gear ratio
+                    SpeedBrakeRatio,      //!< speed brake ratio
+                    ValueCount            //!< number of fixed values
+                };
+
+                //! Index in the integer array of the telemetry signal
+                enum Integer : std::size_t
+                {
+                    Com1ActiveKhz,        //!< COM1 active frequency
+                    Com1StandbyKhz,       //!< COM1 standby frequency
+                    Com2ActiveKhz,        //!< COM2 active frequency
+                    Com2StandbyKhz,       //!< COM2 standby frequency
+                    XpdrCode,             //!< transponder code
+                    XpdrMode,             //!< transponder mode
+                    Flags,                //!< OwnTelemetry::Flag values
+                    IntegerCount          //!< number of integers
+                };
+
+                //! Flags in the OwnTelemetry::Flags integer
+                enum Flag : int
+                {
+                    OnGroundAll      = 1 << 0,  //!< all wheels on ground
+                    Com1Receiving    = 1 << 1,  //!< COM1 receiving
+                    Com1Transmitting = 1 << 2,  //!< COM1 transmitting
+                    Com2Receiving    = 1 << 3,  //!< COM2 receiving
+                    Com2Transmitting = 1 << 4,  //!< COM2 transmitting
+                    XpdrIdent        = 1 << 5,  //!< transponder ident
+                    BeaconLights     = 1 << 6,  //!< beacon lights on
+                    LandingLights    = 1 << 7,  //!< landing lights on
+                    NavLights        = 1 << 8,  //!< nav lights on
+                    StrobeLights     = 1 << 9,  //!< strobe lights on
+                    TaxiLights       = 1 << 10  //!< taxi lights on
+                };
+
+                //! Default interval of the telemetry signal in ms
+                constexpr int DefaultIntervalMs = 100;
+
+                //! Smallest interval of the telemetry signal in ms, about one frame
+                constexpr int MinIntervalMs = 20;
+
+                //! Changes below this tolerance are not published
+                inline double tolerance(std::size_t valueIndex)
+                {
+                    switch (valueIndex)
+                    {
+                    case LatitudeDeg:
+                    case LongitudeDeg: return 1e-7;   // about 1cm
+                    case AltitudeM:    return 0.01;
+                    case PitchDeg:
+                    case RollDeg:
+                    case TrueHeadingDeg: return 0.01;
+                    case SeaLevelPressureInHg: return 0.001;
+                    default: return 0.001; // speeds, ratios, volumes, N1
+                    }
+                }
+
+                /*!
+                 * One sample of the own aircraft, the arguments of the telemetry signal
+                 */
+                struct Telemetry
+                {
+                    std::vector<double> values = std::vector<double>(ValueCount, 0.0); //!< OwnTelemetry::Value values and engine N1
+                    std::vector<int> integers = std::vector<int>(IntegerCount, 0);      //!< OwnTelemetry::Integer values
+
+                    //! Value
+                    double value(Value index) const { return values[index]; }
+
+                    //! Set value
+                    void setValue(Value index, double value) { values[index] = value; }
+
+                    //! Integer
+                    int integer(Integer index) const { return integers[index]; }
+
+                    //! Set integer
+                    void setInteger(Integer index, int value) { integers[index] = value; }
+
+                    //! Flag set?
+                    bool hasFlag(Flag flag) const { return (integers[Flags] & flag) != 0; }
+
+                    //! Set or clear flag
+                    void setFlag(Flag flag, bool set) { integers[Flags] = set ? (integers[Flags] | flag) : (integers[Flags] & ~flag); }
+
+                    //! Number of engines
+                    std::size_t engineCount() const { return values.size() > ValueCount ? values.size() - ValueCount : 0; }
+
+                    //! N1 of engine 0..engineCount()-1
+                    double engineN1Percentage(std::size_t engine) const { return values[ValueCount + engine]; }
+
+                    //! Set the N1 values of all engines
+                    void setEngineN1Percentages(const std::vector<double> &n1)
+                    {
+                        values.resize(ValueCount);
+                        values.insert(values.end(), n1.begin(), n1.end());
+                    }
+
+                    //! Sizes as expected?
+                    bool isValid() const { return values.size() >= ValueCount && integers.size() == IntegerCount; }
+
+                    //! Changed against the other sample, ignoring changes below OwnTelemetry::tolerance
+                    bool isSignificantlyDifferent(const Telemetry &other) const
+                    {
+                        if (integers != other.integers || values.size() != other.values.size()) { return true; }
+                        for (std::size_t i = 0; i < values.size(); i++)
+                        {
+                            if (std::abs(values[i] - other.values[i]) >= tolerance(i)) { return true; }
+                        }
+                        return false;
+                    }
+                };
+            } // ns
+        } // ns
+    } // ns
+} // ns
+
+#endif // guard
@@ -0,0 +1,334 @@
+/* Copyright (C) 2020
+ * swift Project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \file
+
+#ifndef BLACKMISC_SIMULATION_XPLANE_TERRAINPROBEQUEUE_H
+#define BLACKMISC_SIMULATION_XPLANE_TERRAINPROBEQUEUE_H
+
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <limits>
+#include <list>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// Strict header only terrain probe scheduling used by XSwiftBus, the probing itself is done by the X-Plane SDK.
+// Header only is necessary to no require XSwiftBus to link against BlackMisc.
+
+namespace BlackMisc
+{
+    namespace Simulation
+    {
+        namespace XPlane
+        {
+            namespace TerrainProbing
+            {
+                //! Grid size in degrees, positions in the same cell are probed once, about 1m
+                constexpr double DefaultGridDeg = 1e-5;
+
+                //! Number of probe results kept in the cache
+                constexpr std::size_t DefaultCacheCapacity = 256;
+
+                //! Default time in microseconds spent probing per frame
+                constexpr int DefaultFrameBudgetUs = 1000;
+
+                //! Position to be probed
+                struct Point
+                {
+                    double latitudeDeg  = 0.0; //!< latitude
+                    double longitudeDeg = 0.0; //!< longitude
+                    double altitudeM    = 0.0; //!< altitude, start of the probe
+                };
+
+                //! Result of one probe
+                struct Result
+                {
+                    double elevationM = std::numeric_limits<double>::quiet_NaN(); //!< ground elevation, NaN if no ground was hit
+                    bool isWater = false; //!< hit water
+
+                    //! Ground hit?
+                    bool isHit() const { return !std::isnan(elevationM); }
+                };
+
+                /*!
+                 * Probes the terrain at one position, implemented with the X-Plane SDK in XSwiftBus
+                 */
+                class ITerrainProber
+                {
+                public:
+                    //! Destructor
+                    virtual ~ITerrainProber() {}
+
+                    //! Probe the terrain
+                    virtual Result probeTerrain(double latitudeDeg, double longitudeDeg, double altitudeM) = 0;
+                };
+
+                //! Quantized position, the cell of the grid
+                struct GridKey
+                {
+                    std::int64_t latitude  = 0; //!< latitude in grid units
+                    std::int64_t longitude = 0; //!< longitude in grid units
+
+                    //! Equal
+                    bool operator ==(const GridKey &other) const { return latitude == other.latitude && longitude == other.longitude; }
+
+                    //! Cell of a position
+                    static GridKey fromPosition(double latitudeDeg, double longitudeDeg, double gridDeg)
+                    {
+                        GridKey key;
+                        key.latitude  = std::llround(latitudeDeg / gridDeg);
+                        key.longitude = std::llround(longitudeDeg / gridDeg);
+                        return key;
+                    }
+                };
+
+                //! Hash of a GridKey
+                struct GridKeyHash
+                {
+                    //! Hash value
+                    std::size_t operator()(const GridKey &key) const
+                    {
+                        const std::uint64_t h = static_cast<std::uint64_t>(key.latitude) * 0x9E3779B97F4A7C15ull ^ static_cast<std::uint64_t>(key.longitude);
+                        return static_cast<std::size_t>(h ^ (h >> 32));
+                    }
+                };
+
+                /*!
+                 * Least recently used probe results by grid cell
+                 */
+                class CTerrainProbeCache
+                {
+                public:
+                    //! Constructor
+                    explicit CTerrainProbeCache(std::size_t capacity = DefaultCacheCapacity) : m_capacity(capacity) {}
+
+                    //! Cached result of the cell, the entry becomes the most recently used one
+                    bool find(const GridKey &key, Result &o_result)
+                    {
+                        const auto it = m_index.find(key);
+                        if (it == m_index.end()) { return false; }
+                        m_entries.splice(m_entries.begin(), m_entries, it->second);
+                        o_result = it->second->second;
+                        return true;
+                    }
+
+                    //! Add or replace the result of the cell, drops the least recently used entry if full
+                    void insert(const GridKey &key, const Result &result)
+                    {
+                        if (m_capacity < 1) { return; }
+                        const auto it = m_index.find(key);
+                        if (it != m_index.end())
+                        {
+                            it->second->second = result;
+                            m_entries.splice(m_entries.begin(), m_entries, it->second);
+                            return;
+                        }
+                        if (m_entries.size() >= m_capacity)
+                        {
+                            m_index.erase(m_entries.back().first);
+                            m_entries.pop_back();
+                        }
+                        m_entries.emplace_front(key, result);
+                        m_index[key] = m_entries.begin();
+                    }
+
+                    //! Remove all entries
+                    void clear()
+                    {
+                        m_entries.clear();
+                        m_index.clear();
+                    }
+
+                    //! Number of entries
+                    std::size_t size() const { return m_entries.size(); }
+
+                private:
+                    using Entries = std::list<std::pair<GridKey, Result>>;
+                    std::size_t m_capacity = DefaultCacheCapacity;
+                    Entries m_entries; //!< most recently used first
+                    std::unordered_map<GridKey, Entries::iterator, GridKeyHash> m_index;
+                };
+
+                /*!
+                 * Queue of terrain probe requests, probed under a time budget once per frame
+                 * \details A request is a batch of positions and is answered as a whole once all its positions are
+                 *          probed. Positions in the same grid cell are probed once for all waiting requests, recent
+                 *          results are answered from a CTerrainProbeCache without probing. Misses are not cached.
+                 */
+                class CTerrainProbeQueue
+                {
+                public:
+                    //! Id of a request
+                    using RequestId = std::uint64_t;
+
+                    //! Called with the results of a completed request, in the order of the requested points
+                    using CompletedCallback = std::function<void(RequestId, const std::vector<Result> &)>;
+
+                    //! Constructor
+                    //! \param prober used to probe, not owned
+                    //! \param gridDeg cell size of the grid
+                    //! \param cacheCapacity number of cached results
+                    explicit CTerrainProbeQueue(ITerrainProber *prober, double gridDeg = DefaultGridDeg, std::size_t cacheCapacity = DefaultCacheCapacity) :
+                        m_prober(prober), m_gridDeg(gridDeg > 0.0 ? gridDeg : DefaultGridDeg), m_cache(cacheCapacity) {}
+
+                    //! Not copyable
+                    //! @{
+                    CTerrainProbeQueue(const CTerrainProbeQueue &) = delete;
+                    CTerrainProbeQueue &operator =(const CTerrainProbeQueue &) = delete;
+                    //! @}
+
+                    //! Queue a request, its results are reported by a later CTerrainProbeQueue::process
+                    RequestId enqueue(const std::vector<Point> &points)
+                    {
+                        const RequestId id = ++m_lastRequestId;
+                        Request &request = m_requests[id];
+                        request.results.resize(points.size());
+                        for (std::size_t i = 0; i < points.size(); i++)
+                        {
+                            const Point &point = points[i];
+                            const GridKey key = GridKey::fromPosition(point.latitudeDeg, point.longitudeDeg, m_gridDeg);
+                            if (m_cache.find(key, request.results[i]))
+                            {
+                                m_cacheHitCount++;
+                                continue;
+                            }
+
+                            auto cell = m_cells.find(key);
+                            if (cell == m_cells.end())
+                            {
+                                cell = m_cells.emplace(key, Cell()).first;
+                                cell->second.point = point;
+                                m_pendingCells.push_back(key);
+                            }
+                            else
+                            {
+                                m_mergedCount++;
+                            }
+                            cell->second.waiters.emplace_back(id, i);
+                            request.open++;
+                        }
+                        if (request.open == 0) { m_completed.push_back(id); }
+                        return id;
+                    }
+
+                    //! Probe pending cells until the budget is used up and report the completed requests
+                    //! \remark at least one cell is probed per call, so every request completes eventually
+                    //! \return number of probes
+                    int process(std::chrono::microseconds budget, const CompletedCallback &completed)
+                    {
+                        using Clock = std::chrono::steady_clock;
+                        const Clock::time_point start = Clock::now();
+                        int probes = 0;
+                        while (!m_pendingCells.empty())
+                        {
+                            if (probes > 0 && Clock::now() - start >= budget) { break; }
+
+                            const GridKey key = m_pendingCells.front();
+                            m_pendingCells.pop_front();
+                            const auto it = m_cells.find(key);
+                            if (it == m_cells.end()) { continue; }
+                            const Cell cell = std::move(it->second);
+                            m_cells.erase(it);
+
+                            const Result result = m_prober ? m_prober->probeTerrain(cell.point.latitudeDeg, cell.point.longitudeDeg, cell.point.altitudeM) : Result();
+                            probes++;
+                            m_probeCount++;
+                            if (result.isHit()) { m_cache.insert(key, result); }
+                            for (const auto &waiter : cell.waiters) { this->resolve(waiter.first, waiter.second, result); }
+                        }
+
+                        // copied, a callback may enqueue new requests
+                        const std::vector<RequestId> done = std::move(m_completed);
+                        m_completed.clear();
+                        for (RequestId id : done)
+                        {
+                            const auto it = m_requests.find(id);
+                            if (it == m_requests.end()) { continue; }
+                            const std::vector<Result> results = std::move(it->second.results);
+                            m_requests.erase(it);
+                            if (completed) { completed(id, results); }
+                        }
+                        return probes;
+                    }
+
+                    //! Drop all requests, the cache is kept
+                    void clear()
+                    {
+                        m_requests.clear();
+                        m_cells.clear();
+                        m_pendingCells.clear();
+                        m_completed.clear();
+                    }
+
+                    //! Drop all cached results
+                    void clearCache() { m_cache.clear(); }
+
+                    //! Number of requests not yet reported
+                    std::size_t getPendingRequestCount() const { return m_requests.size(); }
+
+                    //! Number of cells not yet probed
+                    std::size_t getPendingProbeCount() const { return m_cells.size(); }
+
+                    //! Number of probes so far
+                    std::uint64_t getProbeCount() const { return m_probeCount; }
+
+                    //! Number of positions answered from the cache so far
+                    std::uint64_t getCacheHitCount() const { return m_cacheHitCount; }
+
+                    //! Number of positions merged into an already pending cell so far
+                    std::uint64_t getMergedCount() const { return m_mergedCount; }
+
+                private:
+                    //! Request waiting for its results
+                    struct Request
+                    {
+                        std::vector<Result> results; //!< per requested point
+                        std::size_t open = 0;        //!< points not yet probed
+                    };
+
+                    //! Cell to be probed
+                    struct Cell
+                    {
+                        Point point; //!< first point requested in the cell
+                        std::vector<std::pair<RequestId, std::size_t>> waiters; //!< request and point index
+                    };
+
+                    //! Result of a point of a request
+                    void resolve(RequestId id, std::size_t index, const Result &result)
+                    {
+                        const auto it = m_requests.find(id);
+                        if (it == m_requests.end()) { return; }
+                        Request &request = it->second;
+                        request.results[index] = result;
+                        if (--request.open == 0) { m_completed.push_back(id); }
+                    }
+
+                    ITerrainProber *m_prober = nullptr;
+                    double m_gridDeg = DefaultGridDeg;
+                    CTerrainProbeCache m_cache;
+                    std::unordered_map<RequestId, Request> m_requests;
+                    std::unordered_map<GridKey, Cell, GridKeyHash> m_cells;
+                    std::deque<GridKey> m_pendingCells;  //!< cells in request order
+                    std::vector<RequestId> m_completed;  //!< completed, not yet reported
+                    RequestId m_lastRequestId = 0;
+                    std::uint64_t m_probeCount = 0;
+                    std::uint64_t m_cacheHitCount = 0;
+                    std::uint64_t m_mergedCount = 0;
+                };
+            } // ns
+        } // ns
+    } // ns
+} // ns
+
+#endif // guard
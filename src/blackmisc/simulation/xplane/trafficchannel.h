@@ -0,0 +1,338 @@
+/* Copyright (C) 2020
+ * swift Project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \file
+
+#ifndef BLACKMISC_SIMULATION_XPLANE_TRAFFICCHANNEL_H
+#define BLACKMISC_SIMULATION_XPLANE_TRAFFICCHANNEL_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <string>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define BLACKMISC_XPLANE_TRAFFICCHANNEL_POSIX 1
+#endif
+
+// Strict header only shared memory traffic channel shared between the X-Plane driver and XSwiftBus.
+// Header only is necessary to no require XSwiftBus to link against BlackMisc.
+
+namespace BlackMisc
+{
+    namespace Simulation
+    {
+        namespace XPlane
+        {
+            namespace TrafficChannel
+            {
+                //! Flags of a TrafficChannel::Record
+                enum RecordFlag : std::uint32_t
+                {
+                    HasPosition      = 1 << 0,  //!< position values are set
+                    HasSurfaces      = 1 << 1,  //!< surfaces and lights values are set
+                    HasTransponder   = 1 << 2,  //!< transponder values are set
+                    OnGround         = 1 << 3,  //!< position is on ground
+                    LandingLights    = 1 << 4,  //!< landing lights on
+                    TaxiLights       = 1 << 5,  //!< taxi lights on
+                    BeaconLights     = 1 << 6,  //!< beacon lights on
+                    StrobeLights     = 1 << 7,  //!< strobe lights on
+                    NavLights        = 1 << 8,  //!< nav lights on
+                    TransponderModeC = 1 << 9,  //!< transponder mode C
+                    TransponderIdent = 1 << 10  //!< transponder ident
+                };
+
+                //! Fixed size update of one plane, the counterpart of one entry of the setPlanesXXX DBus arrays
+                struct Record
+                {
+                    std::uint64_t planeId = 0;         //!< id as reported by remoteAircraftAddedWithId
+                    std::uint32_t flags = 0;           //!< TrafficChannel::RecordFlag values
+                    std::int32_t  transponderCode = 0; //!< transponder code
+                    double latitudeDeg  = 0.0;         //!< latitude
+                    double longitudeDeg = 0.0;         //!< longitude
+                    double altitudeFt   = 0.0;         //!< altitude
+                    float pitchDeg      = 0.0f;        //!< pitch
+                    float rollDeg       = 0.0f;        //!< roll
+                    float headingDeg    = 0.0f;        //!< heading
+                    float gear          = 0.0f;        //!< gear ratio
+                    float flaps         = 0.0f;        //!< flaps ratio
+                    float spoilers      = 0.0f;        //!< spoilers ratio
+                    float speedBrakes   = 0.0f;        //!< speed brakes ratio
+                    float slats         = 0.0f;        //!< slats ratio
+                    float wingSweep     = 0.0f;        //!< wing sweep ratio
+                    float thrust        = 0.0f;        //!< thrust ratio
+                    float elevator      = 0.0f;        //!< elevator ratio
+                    float rudder        = 0.0f;        //!< rudder ratio
+                    float aileron       = 0.0f;        //!< aileron ratio
+                    std::int32_t lightPattern = 0;     //!< light flash pattern
+
+                    //! Flag set?
+                    bool hasFlag(RecordFlag flag) const { return (flags & flag) != 0; }
+
+                    //! Set or clear flag
+                    void setFlag(RecordFlag flag, bool set) { flags = set ? (flags | flag) : (flags & ~static_cast<std::uint32_t>(flag)); }
+                };
+
+                //! Layout version, increase whenever TrafficChannel::Record or TrafficChannel::Header change
+                constexpr std::uint32_t Version = 1;
+
+                //! Marks an initialized channel
+                constexpr std::uint32_t Magic = 0x53574654; // "SWFT"
+
+                //! Default number of records in the ring
+                constexpr std::uint32_t DefaultCapacity = 4096;
+
+                //! Start of the shared memory, followed by the ring of records
+                struct Header
+                {
+                    std::uint32_t magic = 0;      //!< TrafficChannel::Magic once initialized
+                    std::uint32_t version = 0;    //!< TrafficChannel::Version
+                    std::uint32_t recordSize = 0; //!< sizeof(Record)
+                    std::uint32_t capacity = 0;   //!< number of records, power of 2
+                    alignas(64) std::atomic<std::uint32_t> writeIndex { 0 }; //!< records ever written, only changed by the writer
+                    alignas(64) std::atomic<std::uint32_t> readIndex { 0 };  //!< records ever read, only changed by the reader
+                };
+
+                static_assert(ATOMIC_INT_LOCK_FREE == 2, "Atomics in shared memory must be lock free");
+                static_assert(sizeof(Record) == 96, "Record layout is shared between processes");
+                static_assert(sizeof(Header) % alignof(Record) == 0, "Records must be aligned");
+
+                /*!
+                 * Single producer single consumer ring of plane records in shared memory
+                 * \details The X-Plane driver creates the channel and writes one batch of records per update, XSwiftBus
+                 *          opens it by name and reads all available records once per frame. A batch becomes visible to
+                 *          the reader at once. If the ring is full a batch is rejected as a whole, nothing is overwritten.
+                 * \remark Shared memory is only available with POSIX, otherwise the channel cannot be created or opened
+                 */
+                class CTrafficChannel
+                {
+                public:
+                    //! Default constructor, closed channel
+                    CTrafficChannel() {}
+
+                    //! Destructor
+                    ~CTrafficChannel() { close(); }
+
+                    //! Not copyable
+                    //! @{
+                    CTrafficChannel(const CTrafficChannel &) = delete;
+                    CTrafficChannel &operator =(const CTrafficChannel &) = delete;
+                    //! @}
+
+                    //! Shared memory available on this platform?
+                    static bool isSupported()
+                    {
+#ifdef BLACKMISC_XPLANE_TRAFFICCHANNEL_POSIX
+                        return true;
+#else
+                        return false;
+#endif
+                    }
+
+                    //! Bytes needed for a channel with the given capacity
+                    static std::size_t requiredSize(std::uint32_t capacity)
+                    {
+                        return sizeof(Header) + static_cast<std::size_t>(capacity) * sizeof(Record);
+                    }
+
+                    //! Create and initialize a new shared memory channel, writer side
+                    //! \param name POSIX shared memory name such as "/swift-traffic-1234"
+                    //! \param capacity number of records, rounded up to a power of 2
+                    bool create(const std::string &name, std::uint32_t capacity = DefaultCapacity)
+                    {
+                        close();
+#ifdef BLACKMISC_XPLANE_TRAFFICCHANNEL_POSIX
+                        capacity = roundUpToPowerOf2(capacity);
+                        const std::size_t size = requiredSize(capacity);
+                        shm_unlink(name.c_str()); // left over from a crashed process
+                        const int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, S_IRUSR | S_IWUSR);
+                        if (fd < 0) { return false; }
+                        if (ftruncate(fd, static_cast<off_t>(size)) != 0)
+                        {
+                            ::close(fd);
+                            shm_unlink(name.c_str());
+                            return false;
+                        }
+                        void *memory = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+                        ::close(fd);
+                        if (memory == MAP_FAILED)
+                        {
+                            shm_unlink(name.c_str());
+                            return false;
+                        }
+                        m_mapped = true;
+                        m_owner = true;
+                        m_name = name;
+                        return attach(memory, size, true, capacity);
+#else
+                        (void)name;
+                        (void)capacity;
+                        return false;
+#endif
+                    }
+
+                    //! Open an existing shared memory channel, reader side
+                    bool open(const std::string &name)
+                    {
+                        close();
+#ifdef BLACKMISC_XPLANE_TRAFFICCHANNEL_POSIX
+                        const int fd = shm_open(name.c_str(), O_RDWR, 0);
+                        if (fd < 0) { return false; }
+                        struct stat st {};
+                        if (fstat(fd, &st) != 0 || st.st_size < static_cast<off_t>(sizeof(Header)))
+                        {
+                            ::close(fd);
+                            return false;
+                        }
+                        const std::size_t size = static_cast<std::size_t>(st.st_size);
+                        void *memory = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+                        ::close(fd);
+                        if (memory == MAP_FAILED) { return false; }
+                        m_mapped = true;
+                        m_name = name;
+                        return attach(memory, size, false);
+#else
+                        (void)name;
+                        return false;
+#endif
+                    }
+
+                    //! Use a given memory block, the memory must outlive the channel
+                    //! \remark without shared memory, e.g. both sides in one process for testing
+                    //! \param initialize true for the writer side, false to use an already initialized block
+                    bool attach(void *memory, std::size_t size, bool initialize, std::uint32_t capacity = DefaultCapacity)
+                    {
+                        if (!memory || size < sizeof(Header)) { close(); return false; }
+                        m_memory = memory;
+                        m_size = size;
+                        m_header = static_cast<Header *>(memory);
+                        if (initialize)
+                        {
+                            capacity = roundUpToPowerOf2(capacity);
+                            if (size < requiredSize(capacity)) { close(); return false; }
+                            new (m_header) Header();
+                            m_header->version = Version;
+                            m_header->recordSize = sizeof(Record);
+                            m_header->capacity = capacity;
+                            std::atomic_thread_fence(std::memory_order_release);
+                            m_header->magic = Magic;
+                        }
+                        else
+                        {
+                            const Header &h = *m_header;
+                            const bool valid = h.magic == Magic && h.version == Version && h.recordSize == sizeof(Record) &&
+                                               h.capacity > 0 && (h.capacity & (h.capacity - 1)) == 0 && size >= requiredSize(h.capacity);
+                            if (!valid) { close(); return false; }
+                            std::atomic_thread_fence(std::memory_order_acquire);
+                        }
+                        m_capacity = m_header->capacity;
+                        m_records = reinterpret_cast<Record *>(static_cast<char *>(memory) + sizeof(Header));
+                        return true;
+                    }
+
+                    //! Close the channel, the creator also removes the shared memory name
+                    void close()
+                    {
+#ifdef BLACKMISC_XPLANE_TRAFFICCHANNEL_POSIX
+                        if (m_mapped && m_memory) { munmap(m_memory, m_size); }
+                        if (m_owner && !m_name.empty()) { shm_unlink(m_name.c_str()); }
+#endif
+                        m_memory = nullptr;
+                        m_size = 0;
+                        m_header = nullptr;
+                        m_records = nullptr;
+                        m_capacity = 0;
+                        m_mapped = false;
+                        m_owner = false;
+                        m_name.clear();
+                    }
+
+                    //! Channel open?
+                    bool isOpen() const { return m_header != nullptr; }
+
+                    //! Shared memory name, empty if attached to a memory block
+                    const std::string &getName() const { return m_name; }
+
+                    //! Number of records in the ring
+                    std::uint32_t getCapacity() const { return m_capacity; }
+
+                    //! Write a batch of records, writer side
+                    //! \return false if the channel is closed or there is not enough space for the whole batch
+                    bool write(const Record *records, std::uint32_t count)
+                    {
+                        if (!isOpen()) { return false; }
+                        if (count == 0) { return true; }
+                        const std::uint32_t w = m_header->writeIndex.load(std::memory_order_relaxed);
+                        const std::uint32_t r = m_header->readIndex.load(std::memory_order_acquire);
+                        if (m_capacity - (w - r) < count) { return false; }
+
+                        const std::uint32_t mask = m_capacity - 1;
+                        for (std::uint32_t i = 0; i < count; i++)
+                        {
+                            std::memcpy(&m_records[(w + i) & mask], &records[i], sizeof(Record));
+                        }
+                        m_header->writeIndex.store(w + count, std::memory_order_release);
+                        return true;
+                    }
+
+                    //! Read all records written so far, reader side
+                    //! \param f called with each const Record &, in the order written
+                    //! \return number of records read
+                    template <class F>
+                    std::uint32_t read(F &&f)
+                    {
+                        if (!isOpen()) { return 0; }
+                        const std::uint32_t r = m_header->readIndex.load(std::memory_order_relaxed);
+                        const std::uint32_t w = m_header->writeIndex.load(std::memory_order_acquire);
+                        const std::uint32_t count = w - r;
+                        if (count > m_capacity)
+                        {
+                            // indexes out of sync, skip everything
+                            m_header->readIndex.store(w, std::memory_order_release);
+                            return 0;
+                        }
+
+                        const std::uint32_t mask = m_capacity - 1;
+                        for (std::uint32_t i = 0; i < count; i++)
+                        {
+                            f(static_cast<const Record &>(m_records[(r + i) & mask]));
+                        }
+                        m_header->readIndex.store(w, std::memory_order_release);
+                        return count;
+                    }
+
+                private:
+                    //! Round up to the next power of 2
+                    static std::uint32_t roundUpToPowerOf2(std::uint32_t v)
+                    {
+                        std::uint32_t p = 1;
+                        while (p < v && p < (1u << 30)) { p <<= 1; }
+                        return p;
+                    }
+
+                    void *m_memory = nullptr;
+                    std::size_t m_size = 0;
+                    Header *m_header = nullptr;
+                    Record *m_records = nullptr;
+                    std::uint32_t m_capacity = 0;
+                    bool m_mapped = false; //!< memory mapped by this object
+                    bool m_owner = false;  //!< shared memory created by this object
+                    std::string m_name;
+                };
+            } // ns
+        } // ns
+    } // ns
+} // ns
+
+#endif // guard
@@ -0,0 +1,105 @@
+/* Copyright (C) 2020
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \file
+
+#ifndef BLACKMISC_SPSCQUEUE_H
+#define BLACKMISC_SPSCQUEUE_H
+
+#include <QtGlobal>
+#include <atomic>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace BlackMisc
+{
+    /*!
+     * Bounded lock-free queue between exactly one producer thread and one consumer thread.
+     * \details Values are moved into slots allocated once in the constructor, so neither side ever waits
+     *          and pushing or popping does not allocate as long as moving T does not.
+     *          The capacity is rounded up to a power of two.
+     */
+    template <typename T>
+    class CSpscQueue
+    {
+    public:
+        //! Constructor
+        explicit CSpscQueue(int capacity) : m_slots(roundUpToPowerOfTwo(capacity)), m_mask(m_slots.size() - 1) {}
+
+        //! Not copyable
+        //! @{
+        CSpscQueue(const CSpscQueue &) = delete;
+        CSpscQueue &operator =(const CSpscQueue &) = delete;
+        //! @}
+
+        //! Add a value, false if the queue is full
+        //! \remark producer thread only
+        bool push(T &&value)
+        {
+            const std::size_t tail = m_tail.load(std::memory_order_relaxed);
+            if (tail - m_head.load(std::memory_order_acquire) > m_mask) { return false; }
+            m_slots[tail & m_mask] = std::move(value);
+            m_tail.store(tail + 1, std::memory_order_release);
+            return true;
+        }
+
+        //! \copydoc push
+        bool push(const T &value)
+        {
+            T copy(value);
+            return this->push(std::move(copy));
+        }
+
+        //! Take the oldest value, false if the queue is empty
+        //! \remark consumer thread only
+        bool pop(T &value)
+        {
+            const std::size_t head = m_head.load(std::memory_order_relaxed);
+            if (head == m_tail.load(std::memory_order_acquire)) { return false; }
+            value = std::move(m_slots[head & m_mask]);
+            m_head.store(head + 1, std::memory_order_release);
+            return true;
+        }
+
+        //! Number of queued values, a snapshot
+        //! \threadsafe
+        int size() const
+        {
+            const std::size_t head = m_head.load(std::memory_order_acquire);
+            return static_cast<int>(m_tail.load(std::memory_order_acquire) - head);
+        }
+
+        //! Empty?
+        //! \threadsafe
+        bool isEmpty() const { return this->size() < 1; }
+
+        //! Max. number of queued values
+        int capacity() const { return static_cast<int>(m_slots.size()); }
+
+    private:
+        static std::size_t roundUpToPowerOfTwo(int capacity)
+        {
+            std::size_t size = 1;
+            while (size < static_cast<std::size_t>(qMax(1, capacity))) { size *= 2; }
+            return size;
+        }
+
+        std::vector<T> m_slots;
+        const std::size_t m_mask;
+
+        // producer and consumer index on their own cache lines
+        char m_padding1[64] = {};
+        std::atomic<std::size_t> m_head { 0 }; //!< next slot to pop, written by the consumer
+        char m_padding2[64] = {};
+        std::atomic<std::size_t> m_tail { 0 }; //!< next slot to push, written by the producer
+        char m_padding3[64] = {};
+    };
+} // ns
+
+#endif
@@ -6,13 +6,18 @@
  * or distributed except according to the terms contained in the LICENSE file.
  */
 
+#include "blackmisc/aviation/altitude.h"
 #include "blackmisc/aviation/callsign.h"
+#include "blackmisc/aviation/heading.h"
 #include "blackmisc/geo/coordinategeodetic.h"
+#include "blackmisc/geo/latitude.h"
+#include "blackmisc/geo/longitude.h"
 #include "blackmisc/iterator.h"
 #include "blackmisc/network/user.h"
 #include "blackmisc/pq/frequency.h"
 #include "blackmisc/pq/length.h"
 #include "blackmisc/pq/physicalquantity.h"
+#include "blackmisc/pq/speed.h"
 #include "blackmisc/pq/units.h"
 #include "blackmisc/propertyindexvariantmap.h"
 #include "blackmisc/sequence.h"
@@ -137,5 +142,23 @@ namespace BlackMisc
             }
             return list;
         }
+
+        CAircraftSituation CTesting::getTestSituation(const CCallsign &callsign, int number, qint64 ts, qint64 deltaT, qint64 offset)
+        {
+            const CAltitude alt(number, CAltitude::MeanSeaLevel, CLengthUnit::m());
+            const CLatitude lat(number, CAngleUnit::deg());
+            const CLongitude lng(180.0 + number, CAngleUnit::deg());
+            const CHeading heading(number * 10, CHeading::True, CAngleUnit::deg());
+            const CAngle bank(number, CAngleUnit::deg());
+            const CAngle pitch(number, CAngleUnit::deg());
+            const CSpeed gs(number * 10, CSpeedUnit::km_h());
+            const CAltitude gndElev({ 0, CLengthUnit::m() }, CAltitude::MeanSeaLevel);
+            const CCoordinateGeodetic c(lat, lng, alt);
+            CAircraftSituation s(callsign, c, heading, pitch, bank, gs);
+            s.setGroundElevation(gndElev, CAircraftSituation::Test);
+            s.setMSecsSinceEpoch(ts - deltaT * number); // values in past
+            s.setTimeOffsetMs(offset);
+            return s;
+        }
     }  // namespace
 } // namespace
@@ -14,6 +14,7 @@
 #include "blackmisc/simulation/fscommon/aircraftcfgentrieslist.h"
 #include "blackmisc/aviation/atcstationlist.h"
 #include "blackmisc/aviation/airportlist.h"
+#include "blackmisc/aviation/aircraftsituation.h"
 #include "blackmisc/network/clientlist.h"
 #include "blackmisc/blackmiscexport.h"
 #include <QString>
@@ -41,6 +42,9 @@ namespace BlackMisc
 
             //! Get clients
             static BlackMisc::Network::CClientList getClients(int number);
+
+            //! Situation for testing interpolators, the latest with number 0, the others deltaT apart in the past
+            static BlackMisc::Aviation::CAircraftSituation getTestSituation(const BlackMisc::Aviation::CCallsign &callsign, int number, qint64 ts, qint64 deltaT, qint64 offset);
         };
     } // ns
 } // ns
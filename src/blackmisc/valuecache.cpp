@@ -20,6 +20,7 @@
 
 #include <QByteArray>
 #include <QCoreApplication>
+#include <QDataStream>
 #include <QDBusMetaType>
 #include <QDir>
 #include <QDirIterator>
@@ -44,6 +45,23 @@ namespace BlackMisc
 
     using Private::CValuePage;
 
+    //! \private Binary value file: header (magic, format version, QDataStream version, key, value size), then the marshalled value.
+    //! The value is the last part, so the header can be read without decoding it.
+    constexpr quint32 binaryFileMagic = 0x53574356; // "SWCV"
+
+    //! \private Increase if the header layout changes.
+    constexpr quint32 binaryFileFormatVersion = 1;
+
+    //! \private QDataStream version used to marshal the value.
+    constexpr QDataStream::Version binaryFileStreamVersion = QDataStream::Qt_5_6;
+
+    //! \private Suffix of binary value files.
+    const QString &binaryFileSuffix()
+    {
+        static const QString suffix(".bin");
+        return suffix;
+    }
+
     //! Used in asserts to protect against signed integer overflow.
     template <typename T>
     bool isSafeToIncrement(const T &value) { return value < std::numeric_limits<T>::max(); }
@@ -368,14 +386,25 @@ namespace BlackMisc
     CStatusMessage CValueCache::saveToFiles(const QString &dir, const CVariantMap &values, const QString &keysMessage) const
     {
         QMap<QString, CVariantMap> namespaces;
+        CVariantMap binaryValues;
         for (auto it = values.cbegin(); it != values.cend(); ++it)
         {
-            namespaces[it.key().section('/', 0, m_fileSplitDepth - 1)].insert(it.key(), it.value());
+            if (isBinaryFormat(it.key())) { binaryValues.insert(it.key(), it.value()); }
+            else { namespaces[it.key().section('/', 0, m_fileSplitDepth - 1)].insert(it.key(), it.value()); }
         }
         if (! QDir::root().mkpath(dir))
         {
             return CStatusMessage(this).error(u"Failed to create directory '%1'") << dir;
         }
+        for (auto it = binaryValues.cbegin(); it != binaryValues.cend(); ++it)
+        {
+            const CStatusMessage status = saveToBinaryFile(dir + "/" + it.key() + binaryFileSuffix(), it.key(), it.value());
+            if (status.isFailure()) { return status; }
+            for (const QString &jsonFile : jsonFilesForKey(it.key())) { removeFromJsonFile(dir + "/" + jsonFile, it.key()); } // value saved in Json before
+        }
+
+        // with one file per value, only the changed values are written, otherwise they are merged into the namespace file
+        const bool merge = m_fileSplitDepth > 0;
         for (auto it = namespaces.cbegin(); it != namespaces.cend(); ++it)
         {
             CAtomicFile file(dir + "/" + it.key() + ".json");
@@ -383,22 +412,33 @@ namespace BlackMisc
             {
                 return CStatusMessage(this).error(u"Failed to create directory '%1'") << QFileInfo(file).path();
             }
-            if (! file.open(QFile::ReadWrite | QFile::Text))
+            if (! file.open(merge ? QFile::ReadWrite | QFile::Text : QFile::WriteOnly | QFile::Text))
             {
                 return CStatusMessage(this).error(u"Failed to open %1: %2") << file.fileName() << file.errorString();
             }
-            auto json = QJsonDocument::fromJson(file.readAll());
-            if (json.isArray() || (json.isNull() && ! json.isEmpty()))
+            QJsonObject object;
+            if (merge)
             {
-                return CStatusMessage(this).error(u"Invalid JSON format in %1") << file.fileName();
+                const QJsonDocument existing = QJsonDocument::fromJson(file.readAll());
+                if (existing.isArray() || (existing.isNull() && ! existing.isEmpty()))
+                {
+                    return CStatusMessage(this).error(u"Invalid JSON format in %1") << file.fileName();
+                }
+                object = existing.object();
             }
-            auto object = json.object();
-            json.setObject(it->mergeToMemoizedJson(object));
+            const QJsonDocument json(it->mergeToMemoizedJson(object));
 
             if (!(file.seek(0) && file.resize(0) && file.write(json.toJson()) > 0 && file.checkedClose()))
             {
                 return CStatusMessage(this).error(u"Failed to write to %1: %2") << file.fileName() << file.errorString();
             }
+            for (const QString &key : it->keys())
+            {
+                const QString binaryFile = dir + "/" + key + binaryFileSuffix(); // value saved in binary format before
+                if (QFile::exists(binaryFile)) { QFile::remove(binaryFile); }
+                const QStringList jsonFiles = jsonFilesForKey(key);
+                for (int i = 1; i < jsonFiles.size(); i++) { removeFromJsonFile(dir + "/" + jsonFiles[i], key); } // saved with a shallower split before
+            }
         }
         return CStatusMessage(this).info(u"Written '%1' to value cache in '%2'") <<
             (keysMessage.isEmpty() ? values.keys().to<QStringList>().join(",") : keysMessage) << dir;
@@ -426,19 +466,54 @@ namespace BlackMisc
         }
 
         QMap<QString, QStringList> keysInFiles;
+        QStringList binaryFiles;
         for (const auto &key : keys)
         {
-            keysInFiles[key.section('/', 0, m_fileSplitDepth - 1) + ".json"].push_back(key);
+            // a binary file takes precedence, whatever the format of the key is
+            const QString binaryFile = key + binaryFileSuffix();
+            if (QFile::exists(QDir(dir).absoluteFilePath(binaryFile)))
+            {
+                binaryFiles.push_back(binaryFile);
+                continue;
+            }
+
+            // the file of the key, or of a shallower namespace if saved with a smaller split depth before
+            const QStringList jsonFiles = jsonFilesForKey(key);
+            auto jsonFile = std::find_if(jsonFiles.begin(), jsonFiles.end(), [&](const QString &file) { return QFile::exists(QDir(dir).absoluteFilePath(file)); });
+            keysInFiles[jsonFile == jsonFiles.end() ? jsonFiles.front() : *jsonFile].push_back(key);
         }
         if (keys.isEmpty())
         {
-            QDirIterator iter(dir, { "*.json" }, QDir::Files, QDirIterator::Subdirectories);
+            // keysInFiles sorts "a.json" before "a/b.json", so the file of a key replaces a value left in a shallower namespace file
+            QDirIterator iter(dir, { "*.json", "*" + binaryFileSuffix() }, QDir::Files, QDirIterator::Subdirectories);
             while (iter.hasNext())
             {
-                keysInFiles.insert(QDir(dir).relativeFilePath(iter.next()), {});
+                const QString file = QDir(dir).relativeFilePath(iter.next());
+                if (file.endsWith(binaryFileSuffix())) { binaryFiles.push_back(file); }
+                else { keysInFiles.insert(file, {}); }
             }
         }
         bool ok = true;
+        QSet<QString> binaryKeys;
+        for (const QString &binaryFile : as_const(binaryFiles))
+        {
+            QFile file(QDir(dir).absoluteFilePath(binaryFile));
+            QString key;
+            CVariant value;
+            const CStatusMessage status = loadFromBinaryFile(file.fileName(), key, keysOnly ? nullptr : &value);
+            if (status.isFailure())
+            {
+                ok = false;
+                backupFile(file);
+                CLogMessage::preformatted(status);
+                continue;
+            }
+            binaryKeys.insert(key);
+            CVariantMap temp;
+            temp.insert(key, value);
+            temp.removeDuplicates(currentValues);
+            o_values.insert(temp, QFileInfo(file).lastModified().toMSecsSinceEpoch());
+        }
         for (auto it = keysInFiles.cbegin(); it != keysInFiles.cend(); ++it)
         {
             QFile file(QDir(dir).absoluteFilePath(it.key()));
@@ -473,6 +548,7 @@ namespace BlackMisc
                     CLogMessage::preformatted(messages);
                 }
             }
+            for (const QString &key : as_const(binaryKeys)) { temp.remove(key); } // outdated Json value
             temp.removeDuplicates(currentValues);
             o_values.insert(temp, QFileInfo(file).lastModified().toMSecsSinceEpoch());
         }
@@ -480,6 +556,137 @@ namespace BlackMisc
             (keysMessage.isEmpty() ? o_values.keys().to<QStringList>().join(",") : keysMessage) << dir << (ok ? "successfully" : "with errors");
     }
 
+    CStatusMessage CValueCache::saveToBinaryFile(const QString &fileName, const QString &key, const CVariant &value) const
+    {
+        CAtomicFile file(fileName);
+        if (! QDir::root().mkpath(QFileInfo(file).path()))
+        {
+            return CStatusMessage(this).error(u"Failed to create directory '%1'") << QFileInfo(file).path();
+        }
+        if (! file.open(QFile::WriteOnly))
+        {
+            return CStatusMessage(this).error(u"Failed to open %1: %2") << file.fileName() << file.errorString();
+        }
+
+        // marshalled straight into the file, the size is written when known
+        QDataStream stream(&file);
+        stream.setByteOrder(QDataStream::LittleEndian);
+        stream << binaryFileMagic << binaryFileFormatVersion << static_cast<qint32>(binaryFileStreamVersion) << key;
+        const qint64 sizePosition = file.pos();
+        stream << quint64(0);
+        const qint64 valuePosition = file.pos();
+        stream.setVersion(binaryFileStreamVersion);
+        stream << value;
+        const quint64 valueSize = static_cast<quint64>(file.pos() - valuePosition);
+        const bool ok = stream.status() == QDataStream::Ok && file.seek(sizePosition);
+        if (ok) { stream << valueSize; }
+
+        if (! ok || stream.status() != QDataStream::Ok)
+        {
+            const QString error = file.errorString();
+            file.abandon();
+            return CStatusMessage(this).error(u"Failed to write to %1: %2") << fileName << error;
+        }
+        if (! file.checkedClose())
+        {
+            return CStatusMessage(this).error(u"Failed to write to %1: %2") << fileName << file.errorString();
+        }
+        return CStatusMessage(this).info(u"Written '%1' to binary file '%2'") << key << fileName;
+    }
+
+    CStatusMessage CValueCache::loadFromBinaryFile(const QString &fileName, QString &o_key, CVariant *o_value)
+    {
+        QFile file(fileName);
+        if (! file.open(QFile::ReadOnly))
+        {
+            return CStatusMessage(getLogCategories()).error(u"Failed to open %1: %2") << fileName << file.errorString();
+        }
+
+        // decoded from the memory mapped file, read into memory only where mapping is not available
+        const qint64 size = file.size();
+        uchar *mapped = size > 0 && size <= std::numeric_limits<int>::max() ? file.map(0, size) : nullptr;
+        const QByteArray bytes = mapped ? QByteArray::fromRawData(reinterpret_cast<const char *>(mapped), static_cast<int>(size)) : file.readAll();
+
+        QDataStream stream(bytes);
+        stream.setByteOrder(QDataStream::LittleEndian);
+        quint32 magic = 0;
+        quint32 formatVersion = 0;
+        qint32 streamVersion = 0;
+        quint64 valueSize = 0;
+        stream >> magic >> formatVersion >> streamVersion >> o_key >> valueSize;
+        if (stream.status() != QDataStream::Ok || magic != binaryFileMagic || o_key.isEmpty())
+        {
+            return CStatusMessage(getLogCategories()).error(u"Invalid binary format in %1") << fileName;
+        }
+        if (formatVersion != binaryFileFormatVersion || streamVersion < QDataStream::Qt_1_0 || streamVersion > QDataStream::Qt_DefaultCompiledVersion)
+        {
+            return CStatusMessage(getLogCategories()).error(u"Unsupported binary format version %1 in %2") << formatVersion << fileName;
+        }
+        if (valueSize != static_cast<quint64>(bytes.size() - stream.device()->pos()))
+        {
+            return CStatusMessage(getLogCategories()).error(u"Incomplete binary file %1") << fileName;
+        }
+        if (! o_value) { return CStatusMessage(getLogCategories()).info(u"Read key '%1' from %2") << o_key << fileName; }
+
+        stream.setVersion(streamVersion);
+        stream >> *o_value;
+        if (stream.status() != QDataStream::Ok || ! stream.atEnd())
+        {
+            *o_value = {};
+            return CStatusMessage(getLogCategories()).error(u"Failed to decode '%1' from %2") << o_key << fileName;
+        }
+        return CStatusMessage(getLogCategories()).info(u"Loaded '%1' from %2") << o_key << fileName;
+    }
+
+    void CValueCache::removeFromJsonFile(const QString &fileName, const QString &key) const
+    {
+        if (! QFile::exists(fileName)) { return; }
+        CAtomicFile file(fileName);
+        if (! file.open(QFile::ReadWrite | QFile::Text)) { return; }
+        auto json = QJsonDocument::fromJson(file.readAll());
+        QJsonObject object = json.object();
+        if (! object.contains(key))
+        {
+            file.abandon();
+            return;
+        }
+        object.remove(key);
+        if (object.isEmpty())
+        {
+            file.abandon();
+            QFile::remove(fileName);
+            return;
+        }
+        json.setObject(object);
+        if (!(file.seek(0) && file.resize(0) && file.write(json.toJson()) > 0 && file.checkedClose()))
+        {
+            CLogMessage(this).warning(u"Failed to remove '%1' from %2: %3") << key << fileName << file.errorString();
+        }
+    }
+
+    QStringList CValueCache::jsonFilesForKey(const QString &key) const
+    {
+        QStringList files { filenameForKey(key) };
+        if (isBinaryFormat(key)) { files.front() = key.section('/', 0, m_fileSplitDepth - 1) + ".json"; }
+        for (int depth = files.front().count('/'); depth > 0; depth--)
+        {
+            files.push_back(key.section('/', 0, depth - 1) + ".json");
+        }
+        return files;
+    }
+
+    void CValueCache::setBinaryFormat(const QString &key)
+    {
+        QMutexLocker lock(&m_binaryKeysMutex);
+        m_binaryKeys.insert(key);
+    }
+
+    bool CValueCache::isBinaryFormat(const QString &key) const
+    {
+        QMutexLocker lock(&m_binaryKeysMutex);
+        return m_binaryKeys.contains(key);
+    }
+
     void CValueCache::backupFile(QFile &file) const
     {
         QDir dir = getCacheRootDirectory();
@@ -520,6 +727,7 @@ namespace BlackMisc
 
     QString CValueCache::filenameForKey(const QString &key) const
     {
+        if (isBinaryFormat(key)) { return key + binaryFileSuffix(); }
         return key.section('/', 0, m_fileSplitDepth - 1) + ".json";
     }
 
@@ -166,6 +166,8 @@ namespace BlackMisc
         static const CLogCategoryList &getLogCategories();
 
         //! Constructor.
+        //! \param fileSplitDepth Number of key levels used for the file names, 0 for one file per value.
+        //! \param parent QObject parent.
         explicit CValueCache(int fileSplitDepth, QObject *parent = nullptr);
 
         //! Return map containing all values in the cache.
@@ -219,6 +221,23 @@ namespace BlackMisc
         //! \threadsafe
         CStatusMessage loadFromFiles(const QString &directory);
 
+        //! Save the value with the given key in its own binary file instead of the Json file of its namespace.
+        //! \details The value is marshalled with QDataStream, which is much faster to load than Json for large values.
+        //!          Files are read in either format, the switch only decides how the value is saved next time.
+        //! \threadsafe
+        void setBinaryFormat(const QString &key);
+
+        //! True if the value with the given key is saved in a binary file.
+        //! \threadsafe
+        bool isBinaryFormat(const QString &key) const;
+
+        //! Read a value from a binary file written by saveToFiles.
+        //! \param fileName Binary file.
+        //! \param o_key Key of the value.
+        //! \param o_value Value, if nullptr only the header is read and the value is not decoded.
+        //! \threadsafe
+        static CStatusMessage loadFromBinaryFile(const QString &fileName, QString &o_key, CVariant *o_value);
+
         //! Return the (relative) filename that may is (or would be) used to save the value with the given key.
         //! The file may or may not exist (because it might not have been saved yet).
         //! \threadsafe
@@ -326,6 +345,9 @@ namespace BlackMisc
         Element &getElement(const QString &key, QMap<QString, ElementPtr>::const_iterator pos);
         std::tuple<CVariant, qint64, bool> getValue(const QString &key);
         void backupFile(QFile &file) const;
+        CStatusMessage saveToBinaryFile(const QString &fileName, const QString &key, const CVariant &value) const;
+        void removeFromJsonFile(const QString &fileName, const QString &key) const;
+        QStringList jsonFilesForKey(const QString &key) const; //!< Json file of the key, then the files of shallower namespaces
 
         virtual void connectPage(Private::CValuePage *page);
 
@@ -333,6 +355,9 @@ namespace BlackMisc
         QSet<QString> m_warnedKeys;
         QMutex m_warnedKeysMutex;
 
+        QSet<QString> m_binaryKeys; //!< keys saved in binary files
+        mutable QMutex m_binaryKeysMutex;
+
     signals:
         //! \private
         void valuesChanged(const BlackMisc::CValueCachePacket &values, QObject *changedBy);
@@ -36,14 +36,29 @@ namespace BlackSound
             QVector<qint16> decoded(MaxDataBytes, 0);
             int count = frameCount(MaxDataBytes);
 
+            *decodedLength = 0;
             if (!opusData.isEmpty())
             {
-                *decodedLength = opus_decode(m_opusDecoder, reinterpret_cast<const unsigned char *>(opusData.data()), dataLength, decoded.data(), count, 0);
+                *decodedLength = qMax(0, opus_decode(m_opusDecoder, reinterpret_cast<const unsigned char *>(opusData.data()), dataLength, decoded.data(), count, 0));
             }
             decoded.resize(*decodedLength);
             return decoded;
         }
 
+        int COpusDecoder::decode(const QByteArray &opusData, qint16 *pcm, int frameSize)
+        {
+            if (opusData.isEmpty()) { return 0; }
+            const int decoded = opus_decode(m_opusDecoder, reinterpret_cast<const unsigned char *>(opusData.constData()), opusData.size(), pcm, frameSize, 0);
+            return qMax(0, decoded);
+        }
+
+        int COpusDecoder::decodeLost(qint16 *pcm, int frameSize)
+        {
+            // no data: the decoder extrapolates from its state
+            const int decoded = opus_decode(m_opusDecoder, nullptr, 0, pcm, frameSize, 0);
+            return qMax(0, decoded);
+        }
+
         void COpusDecoder::resetState()
         {
             if (!m_opusDecoder) { return; }
@@ -42,6 +42,14 @@ namespace BlackSound
             //! Decode
             QVector<qint16> decode(const QByteArray &opusData, int dataLength, int *decodedLength);
 
+            //! Decode into a caller provided buffer of frameSize samples per channel
+            //! \return decoded samples per channel, 0 on errors
+            int decode(const QByteArray &opusData, qint16 *pcm, int frameSize);
+
+            //! Frame for a lost packet, by the packet loss concealment of the decoder
+            //! \return decoded samples per channel, 0 on errors
+            int decodeLost(qint16 *pcm, int frameSize);
+
             //! Reset
             void resetState();
 
@@ -12,6 +12,7 @@
 
 #include <QtMath>
 #include <algorithm>
+#include <iterator>
 
 using namespace BlackMisc;
 using namespace BlackConfig;
@@ -98,6 +99,31 @@ namespace BlackSound
             setCoefficients(aa0, aa1, aa2, b0, b1, b2);
         }
 
+        bool BiQuadCascade::append(const BiQuadFilter &filter)
+        {
+            const int f = m_data.filters;
+            if (f >= BiQuadCascadeData::MaxFilters) { return false; }
+            m_data.a0[f] = filter.m_a0;
+            m_data.a1[f] = filter.m_a1;
+            m_data.a2[f] = filter.m_a2;
+            m_data.a3[f] = filter.m_a3;
+            m_data.a4[f] = filter.m_a4;
+            m_data.x1[f] = filter.m_x1;
+            m_data.x2[f] = filter.m_x2;
+            m_data.y1[f] = filter.m_y1;
+            m_data.y2[f] = filter.m_y2;
+            m_data.filters++;
+            return true;
+        }
+
+        void BiQuadCascade::reset()
+        {
+            std::fill(std::begin(m_data.x1), std::end(m_data.x1), 0.0f);
+            std::fill(std::begin(m_data.x2), std::end(m_data.x2), 0.0f);
+            std::fill(std::begin(m_data.y1), std::end(m_data.y1), 0.0f);
+            std::fill(std::begin(m_data.y2), std::end(m_data.y2), 0.0f);
+        }
+
         BiQuadFilter BiQuadFilter::lowPassFilter(float sampleRate, float cutoffFrequency, float q)
         {
             BiQuadFilter filter;
@@ -12,13 +12,14 @@
 #define BLACKSOUND_DSP_BIQUADFILTER_H
 
 #include "blacksound/blacksoundexport.h"
+#include "blacksound/dsp/samplekernels.h"
 
 namespace BlackSound
 {
     namespace Dsp
     {
         //! Digital biquad filter
-        class BiQuadFilter
+        class BLACKSOUND_EXPORT BiQuadFilter
         {
         public:
             //! Ctor
@@ -54,6 +55,32 @@ namespace BlackSound
             float m_x2 = 0.0;
             float m_y1 = 0.0;
             float m_y2 = 0.0;
+
+            friend class BiQuadCascade;
+        };
+
+        //! Biquad filters in series, transformed block wise by the vector kernels
+        class BLACKSOUND_EXPORT BiQuadCascade
+        {
+        public:
+            //! Ctor
+            BiQuadCascade() = default;
+
+            //! Append a filter, including its state
+            //! \return false if there are already BiQuadCascadeData::MaxFilters filters
+            bool append(const BiQuadFilter &filter);
+
+            //! Number of filters
+            int size() const { return m_data.filters; }
+
+            //! Reset the state of all filters, the coefficients are kept
+            void reset();
+
+            //! Transform samples in place, same result as BiQuadFilter::transform of all filters per sample
+            void process(float *samples, int count) { processBiQuadCascade(m_data, samples, count); }
+
+        private:
+            BiQuadCascadeData m_data;
         };
     } // ns
 } // ns
@@ -0,0 +1,594 @@
+/* Copyright (C) 2020
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+#include "samplekernels.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+
+// SSE2 is the baseline of x86_64 and of our 32bit builds, AVX is used if the CPU supports it
+#if defined(Q_PROCESSOR_X86) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#   define BLACKSOUND_DSP_SSE2
+#   define BLACKSOUND_DSP_AVX
+#   include <immintrin.h>
+#   if defined(Q_CC_MSVC)
+#       include <intrin.h>
+#   endif
+#   if defined(Q_CC_GNU) || defined(Q_CC_CLANG)
+#       define BLACKSOUND_DSP_TARGET_AVX __attribute__((target("avx")))
+#   else
+#       define BLACKSOUND_DSP_TARGET_AVX
+#   endif
+#endif
+
+namespace BlackSound
+{
+    namespace Dsp
+    {
+        namespace
+        {
+            //! Implementations of one instruction set
+            struct Kernels
+            {
+                SimdLevel level;
+                void (*biQuadCascade)(BiQuadCascadeData &, float *, int);
+                void (*gain)(float *, int, float);
+                void (*mix)(float *, const float *, int);
+                float (*peak)(const float *, int);
+                int (*gainAndClip)(qint16 *, int, double);
+            };
+
+            // ------------------------ scalar, the reference ------------------------
+
+            void biQuadCascadeScalar(BiQuadCascadeData &cascade, float *samples, int count)
+            {
+                const int filters = cascade.filters;
+                for (int n = 0; n < count; n++)
+                {
+                    float sample = samples[n];
+                    for (int f = 0; f < filters; f++)
+                    {
+                        // same as BiQuadFilter::transform
+                        const double result = cascade.a0[f] * sample + cascade.a1[f] * cascade.x1[f] + cascade.a2[f] * cascade.x2[f] - cascade.a3[f] * cascade.y1[f] - cascade.a4[f] * cascade.y2[f];
+                        cascade.x2[f] = cascade.x1[f];
+                        cascade.x1[f] = sample;
+                        cascade.y2[f] = cascade.y1[f];
+                        cascade.y1[f] = static_cast<float>(result);
+                        sample = cascade.y1[f];
+                    }
+                    samples[n] = sample;
+                }
+            }
+
+            void gainScalar(float *samples, int count, float gain)
+            {
+                for (int n = 0; n < count; n++) { samples[n] *= gain; }
+            }
+
+            void mixScalar(float *destination, const float *source, int count)
+            {
+                for (int n = 0; n < count; n++) { destination[n] += source[n]; }
+            }
+
+            float peakScalar(const float *samples, int count)
+            {
+                float peak = 0.0f;
+                for (int n = 0; n < count; n++)
+                {
+                    const float absSample = std::abs(samples[n]);
+                    if (absSample > peak) { peak = absSample; }
+                }
+                return peak;
+            }
+
+            int gainAndClipScalar(qint16 *samples, int count, double gain)
+            {
+                int peak = 0;
+                for (int n = 0; n < count; n++)
+                {
+                    // rounding halves up like qRound
+                    const double value = std::floor(samples[n] * gain + 0.5);
+                    const int clipped = value > 32767.0 ? 32767 : (value < -32768.0 ? -32768 : static_cast<int>(value));
+                    samples[n] = static_cast<qint16>(clipped);
+                    peak = qMax(peak, std::abs(clipped));
+                }
+                return peak;
+            }
+
+            const Kernels &scalarKernels()
+            {
+                static const Kernels kernels = { SimdScalar, &biQuadCascadeScalar, &gainScalar, &mixScalar, &peakScalar, &gainAndClipScalar };
+                return kernels;
+            }
+
+#ifdef BLACKSOUND_DSP_SSE2
+            // ------------------------ lane helpers, also used by AVX ------------------------
+            //
+            // The cascade is pipelined, one filter per lane: in step t filter k transforms sample t - k,
+            // its input is the output filter k - 1 produced in step t - 1. The first and the last steps
+            // of a call only update the lanes with a sample, so the state after a call is the same
+            // as the one of the scalar code.
+
+            //! Inputs of 4 filters: outputs of the previous filters, lane 0 gets the carry
+            inline __m128 cascadeInput(__m128 previousOutputs, __m128 carry)
+            {
+                const __m128 shifted = _mm_castsi128_ps(_mm_slli_si128(_mm_castps_si128(previousOutputs), 4));
+                return _mm_move_ss(shifted, carry);
+            }
+
+            //! Lanes of the group with a sample in this step
+            inline __m128 activeLanes(int group, int step, int count)
+            {
+                const __m128i lane = _mm_add_epi32(_mm_set_epi32(3, 2, 1, 0), _mm_set1_epi32(4 * group));
+                const __m128i started = _mm_cmpgt_epi32(_mm_set1_epi32(step + 1), lane);
+                const __m128i notDone = _mm_cmpgt_epi32(lane, _mm_set1_epi32(step - count));
+                return _mm_castsi128_ps(_mm_and_si128(started, notDone));
+            }
+
+            //! mask ? a : b
+            inline __m128 select(__m128 mask, __m128 a, __m128 b)
+            {
+                return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+            }
+
+            //! Value of a lane
+            inline float laneValue(__m128 v, int lane)
+            {
+                switch (lane)
+                {
+                case 1:  return _mm_cvtss_f32(_mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 1, 1)));
+                case 2:  return _mm_cvtss_f32(_mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 2, 2, 2)));
+                case 3:  return _mm_cvtss_f32(_mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 3, 3, 3)));
+                default: return _mm_cvtss_f32(v);
+                }
+            }
+
+            //! Filter state of up to 8 lanes
+            struct CascadeLanes
+            {
+                static constexpr int Groups = BiQuadCascadeData::MaxFilters / 4;
+                __m128 x1[Groups];
+                __m128 x2[Groups];
+                __m128 y1[Groups];
+                __m128 y2[Groups];
+
+                void load(const BiQuadCascadeData &cascade)
+                {
+                    for (int g = 0; g < Groups; g++)
+                    {
+                        x1[g] = _mm_loadu_ps(cascade.x1 + 4 * g);
+                        x2[g] = _mm_loadu_ps(cascade.x2 + 4 * g);
+                        y1[g] = _mm_loadu_ps(cascade.y1 + 4 * g);
+                        y2[g] = _mm_loadu_ps(cascade.y2 + 4 * g);
+                    }
+                }
+
+                //! Store the lanes of the used filters only, the others hold values passed through
+                void store(BiQuadCascadeData &cascade, int filters) const
+                {
+                    alignas(16) float values[4][BiQuadCascadeData::MaxFilters];
+                    for (int g = 0; g < Groups; g++)
+                    {
+                        _mm_store_ps(values[0] + 4 * g, x1[g]);
+                        _mm_store_ps(values[1] + 4 * g, x2[g]);
+                        _mm_store_ps(values[2] + 4 * g, y1[g]);
+                        _mm_store_ps(values[3] + 4 * g, y2[g]);
+                    }
+                    std::copy(values[0], values[0] + filters, cascade.x1);
+                    std::copy(values[1], values[1] + filters, cascade.x2);
+                    std::copy(values[2], values[2] + filters, cascade.y1);
+                    std::copy(values[3], values[3] + filters, cascade.y2);
+                }
+
+                //! Inputs of all groups, before any group is updated
+                void inputs(float sample, int groups, __m128 *x) const
+                {
+                    x[0] = cascadeInput(y1[0], _mm_set_ss(sample));
+                    for (int g = 1; g < groups; g++)
+                    {
+                        x[g] = cascadeInput(y1[g], _mm_shuffle_ps(y1[g - 1], y1[g - 1], _MM_SHUFFLE(3, 3, 3, 3)));
+                    }
+                }
+
+                void update(int g, __m128 x, __m128 y)
+                {
+                    x2[g] = x1[g];
+                    x1[g] = x;
+                    y2[g] = y1[g];
+                    y1[g] = y;
+                }
+
+                void update(int g, __m128 x, __m128 y, __m128 mask)
+                {
+                    x2[g] = select(mask, x1[g], x2[g]);
+                    x1[g] = select(mask, x, x1[g]);
+                    y2[g] = select(mask, y1[g], y2[g]);
+                    y1[g] = select(mask, y, y1[g]);
+                }
+            };
+
+            // ------------------------ SSE2 ------------------------
+
+            void biQuadCascadeSse2(BiQuadCascadeData &cascade, float *samples, int count)
+            {
+                const int filters = cascade.filters;
+                if (filters < 1 || count < 1) { return; }
+                const int groups = (filters + 3) / 4;
+                const int last = filters - 1;
+
+                // coefficients, 2 doubles per register
+                __m128d a[5][CascadeLanes::Groups][2];
+                const double *coefficients[5] = { cascade.a0, cascade.a1, cascade.a2, cascade.a3, cascade.a4 };
+                for (int c = 0; c < 5; c++)
+                {
+                    for (int g = 0; g < groups; g++)
+                    {
+                        a[c][g][0] = _mm_loadu_pd(coefficients[c] + 4 * g);
+                        a[c][g][1] = _mm_loadu_pd(coefficients[c] + 4 * g + 2);
+                    }
+                }
+
+                CascadeLanes lanes;
+                lanes.load(cascade);
+                __m128 x[CascadeLanes::Groups];
+                const int steps = count + last;
+                for (int step = 0; step < steps; step++)
+                {
+                    lanes.inputs(step < count ? samples[step] : 0.0f, groups, x);
+                    const bool partial = step < last || step >= count;
+                    for (int g = 0; g < groups; g++)
+                    {
+                        // same operations in the same order as BiQuadFilter::transform
+                        __m128d r[2];
+                        const __m128 in[5] = { x[g], lanes.x1[g], lanes.x2[g], lanes.y1[g], lanes.y2[g] };
+                        for (int h = 0; h < 2; h++)
+                        {
+                            const __m128d x0 = _mm_cvtps_pd(h ? _mm_movehl_ps(in[0], in[0]) : in[0]);
+                            const __m128d x1 = _mm_cvtps_pd(h ? _mm_movehl_ps(in[1], in[1]) : in[1]);
+                            const __m128d x2 = _mm_cvtps_pd(h ? _mm_movehl_ps(in[2], in[2]) : in[2]);
+                            const __m128d y1 = _mm_cvtps_pd(h ? _mm_movehl_ps(in[3], in[3]) : in[3]);
+                            const __m128d y2 = _mm_cvtps_pd(h ? _mm_movehl_ps(in[4], in[4]) : in[4]);
+                            __m128d result = _mm_mul_pd(a[0][g][h], x0);
+                            result = _mm_add_pd(result, _mm_mul_pd(a[1][g][h], x1));
+                            result = _mm_add_pd(result, _mm_mul_pd(a[2][g][h], x2));
+                            result = _mm_sub_pd(result, _mm_mul_pd(a[3][g][h], y1));
+                            r[h] = _mm_sub_pd(result, _mm_mul_pd(a[4][g][h], y2));
+                        }
+                        const __m128 y = _mm_movelh_ps(_mm_cvtpd_ps(r[0]), _mm_cvtpd_ps(r[1]));
+                        if (partial) { lanes.update(g, x[g], y, activeLanes(g, step, count)); }
+                        else { lanes.update(g, x[g], y); }
+                    }
+                    if (step >= last) { samples[step - last] = laneValue(lanes.y1[last / 4], last % 4); }
+                }
+                lanes.store(cascade, filters);
+            }
+
+            void gainSse2(float *samples, int count, float gain)
+            {
+                const __m128 g = _mm_set1_ps(gain);
+                int n = 0;
+                for (; n + 4 <= count; n += 4)
+                {
+                    _mm_storeu_ps(samples + n, _mm_mul_ps(_mm_loadu_ps(samples + n), g));
+                }
+                gainScalar(samples + n, count - n, gain);
+            }
+
+            void mixSse2(float *destination, const float *source, int count)
+            {
+                int n = 0;
+                for (; n + 4 <= count; n += 4)
+                {
+                    _mm_storeu_ps(destination + n, _mm_add_ps(_mm_loadu_ps(destination + n), _mm_loadu_ps(source + n)));
+                }
+                mixScalar(destination + n, source + n, count - n);
+            }
+
+            //! Largest value of the lanes, NaN are ignored as in the scalar code
+            inline float maxLane(__m128 v, float peak)
+            {
+                alignas(16) float values[4];
+                _mm_store_ps(values, v);
+                for (float value : values) { if (value > peak) { peak = value; } }
+                return peak;
+            }
+
+            float peakSse2(const float *samples, int count)
+            {
+                const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+                __m128 peak = _mm_setzero_ps();
+                int n = 0;
+                for (; n + 4 <= count; n += 4)
+                {
+                    // max(a, b) is b if a is NaN
+                    peak = _mm_max_ps(_mm_and_ps(_mm_loadu_ps(samples + n), absMask), peak);
+                }
+                return qMax(maxLane(peak, 0.0f), peakScalar(samples + n, count - n));
+            }
+
+            //! Floor of 2 values, clipped to the 16bit range
+            inline __m128d floorClipSse2(__m128d value)
+            {
+                // clipping before flooring is the same, as the limits are integers
+                value = _mm_min_pd(_mm_max_pd(value, _mm_set1_pd(-32768.0)), _mm_set1_pd(32767.0));
+                const __m128d truncated = _mm_cvtepi32_pd(_mm_cvttpd_epi32(value));
+                return _mm_sub_pd(truncated, _mm_and_pd(_mm_cmpgt_pd(truncated, value), _mm_set1_pd(1.0)));
+            }
+
+            //! 4 samples as int32 multiplied, rounded and clipped
+            inline __m128i gainAndClip4Sse2(__m128i samples, __m128d gain)
+            {
+                const __m128d half = _mm_set1_pd(0.5);
+                const __m128d lo = floorClipSse2(_mm_add_pd(_mm_mul_pd(_mm_cvtepi32_pd(samples), gain), half));
+                const __m128d hi = floorClipSse2(_mm_add_pd(_mm_mul_pd(_mm_cvtepi32_pd(_mm_shuffle_epi32(samples, _MM_SHUFFLE(1, 0, 3, 2))), gain), half));
+                return _mm_unpacklo_epi64(_mm_cvttpd_epi32(lo), _mm_cvttpd_epi32(hi));
+            }
+
+            //! Largest absolute value of the 16bit lanes
+            inline int peak16(__m128i maxValues, __m128i minValues)
+            {
+                alignas(16) qint16 maxs[8];
+                alignas(16) qint16 mins[8];
+                _mm_store_si128(reinterpret_cast<__m128i *>(maxs), maxValues);
+                _mm_store_si128(reinterpret_cast<__m128i *>(mins), minValues);
+                int peak = 0;
+                for (int i = 0; i < 8; i++) { peak = qMax(peak, qMax(static_cast<int>(maxs[i]), -static_cast<int>(mins[i]))); }
+                return peak;
+            }
+
+            int gainAndClipSse2(qint16 *samples, int count, double gain)
+            {
+                const __m128d g = _mm_set1_pd(gain);
+                __m128i maxValues = _mm_setzero_si128();
+                __m128i minValues = _mm_setzero_si128();
+                int n = 0;
+                for (; n + 8 <= count; n += 8)
+                {
+                    __m128i *block = reinterpret_cast<__m128i *>(samples + n);
+                    const __m128i values = _mm_loadu_si128(block);
+                    const __m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(values, values), 16);
+                    const __m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(values, values), 16);
+                    const __m128i result = _mm_packs_epi32(gainAndClip4Sse2(lo, g), gainAndClip4Sse2(hi, g));
+                    _mm_storeu_si128(block, result);
+                    maxValues = _mm_max_epi16(maxValues, result);
+                    minValues = _mm_min_epi16(minValues, result);
+                }
+                return qMax(peak16(maxValues, minValues), gainAndClipScalar(samples + n, count - n, gain));
+            }
+
+            const Kernels &sse2Kernels()
+            {
+                static const Kernels kernels = { SimdSse2, &biQuadCascadeSse2, &gainSse2, &mixSse2, &peakSse2, &gainAndClipSse2 };
+                return kernels;
+            }
+#endif
+
+#ifdef BLACKSOUND_DSP_AVX
+            // ------------------------ AVX ------------------------
+
+            BLACKSOUND_DSP_TARGET_AVX void biQuadCascadeAvx(BiQuadCascadeData &cascade, float *samples, int count)
+            {
+                const int filters = cascade.filters;
+                if (filters < 1 || count < 1) { return; }
+                const int groups = (filters + 3) / 4;
+                const int last = filters - 1;
+
+                // coefficients, 4 doubles per register
+                __m256d a[5][CascadeLanes::Groups];
+                const double *coefficients[5] = { cascade.a0, cascade.a1, cascade.a2, cascade.a3, cascade.a4 };
+                for (int c = 0; c < 5; c++)
+                {
+                    for (int g = 0; g < groups; g++) { a[c][g] = _mm256_loadu_pd(coefficients[c] + 4 * g); }
+                }
+
+                CascadeLanes lanes;
+                lanes.load(cascade);
+                __m128 x[CascadeLanes::Groups];
+                const int steps = count + last;
+                for (int step = 0; step < steps; step++)
+                {
+                    lanes.inputs(step < count ? samples[step] : 0.0f, groups, x);
+                    const bool partial = step < last || step >= count;
+                    for (int g = 0; g < groups; g++)
+                    {
+                        // same operations in the same order as BiQuadFilter::transform
+                        __m256d result = _mm256_mul_pd(a[0][g], _mm256_cvtps_pd(x[g]));
+                        result = _mm256_add_pd(result, _mm256_mul_pd(a[1][g], _mm256_cvtps_pd(lanes.x1[g])));
+                        result = _mm256_add_pd(result, _mm256_mul_pd(a[2][g], _mm256_cvtps_pd(lanes.x2[g])));
+                        result = _mm256_sub_pd(result, _mm256_mul_pd(a[3][g], _mm256_cvtps_pd(lanes.y1[g])));
+                        result = _mm256_sub_pd(result, _mm256_mul_pd(a[4][g], _mm256_cvtps_pd(lanes.y2[g])));
+                        const __m128 y = _mm256_cvtpd_ps(result);
+                        if (partial) { lanes.update(g, x[g], y, activeLanes(g, step, count)); }
+                        else { lanes.update(g, x[g], y); }
+                    }
+                    if (step >= last) { samples[step - last] = laneValue(lanes.y1[last / 4], last % 4); }
+                }
+                lanes.store(cascade, filters);
+            }
+
+            BLACKSOUND_DSP_TARGET_AVX void gainAvx(float *samples, int count, float gain)
+            {
+                const __m256 g = _mm256_set1_ps(gain);
+                int n = 0;
+                for (; n + 8 <= count; n += 8)
+                {
+                    _mm256_storeu_ps(samples + n, _mm256_mul_ps(_mm256_loadu_ps(samples + n), g));
+                }
+                gainScalar(samples + n, count - n, gain);
+            }
+
+            BLACKSOUND_DSP_TARGET_AVX void mixAvx(float *destination, const float *source, int count)
+            {
+                int n = 0;
+                for (; n + 8 <= count; n += 8)
+                {
+                    _mm256_storeu_ps(destination + n, _mm256_add_ps(_mm256_loadu_ps(destination + n), _mm256_loadu_ps(source + n)));
+                }
+                mixScalar(destination + n, source + n, count - n);
+            }
+
+            BLACKSOUND_DSP_TARGET_AVX float peakAvx(const float *samples, int count)
+            {
+                const __m256 absMask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7fffffff));
+                __m256 peak = _mm256_setzero_ps();
+                int n = 0;
+                for (; n + 8 <= count; n += 8)
+                {
+                    peak = _mm256_max_ps(_mm256_and_ps(_mm256_loadu_ps(samples + n), absMask), peak);
+                }
+                const __m128 peak4 = _mm_max_ps(_mm256_extractf128_ps(peak, 1), _mm256_castps256_ps128(peak));
+                return qMax(maxLane(peak4, 0.0f), peakScalar(samples + n, count - n));
+            }
+
+            BLACKSOUND_DSP_TARGET_AVX int gainAndClipAvx(qint16 *samples, int count, double gain)
+            {
+                const __m256d g = _mm256_set1_pd(gain);
+                const __m256d half = _mm256_set1_pd(0.5);
+                const __m256d lowest = _mm256_set1_pd(-32768.0);
+                const __m256d highest = _mm256_set1_pd(32767.0);
+                __m128i maxValues = _mm_setzero_si128();
+                __m128i minValues = _mm_setzero_si128();
+                int n = 0;
+                for (; n + 8 <= count; n += 8)
+                {
+                    __m128i *block = reinterpret_cast<__m128i *>(samples + n);
+                    const __m128i values = _mm_loadu_si128(block);
+                    const __m128i halves[2] = { _mm_srai_epi32(_mm_unpacklo_epi16(values, values), 16), _mm_srai_epi32(_mm_unpackhi_epi16(values, values), 16) };
+                    __m128i results[2];
+                    for (int h = 0; h < 2; h++)
+                    {
+                        // clipping before flooring is the same, as the limits are integers
+                        const __m256d value = _mm256_add_pd(_mm256_mul_pd(_mm256_cvtepi32_pd(halves[h]), g), half);
+                        results[h] = _mm256_cvttpd_epi32(_mm256_floor_pd(_mm256_min_pd(_mm256_max_pd(value, lowest), highest)));
+                    }
+                    const __m128i result = _mm_packs_epi32(results[0], results[1]);
+                    _mm_storeu_si128(block, result);
+                    maxValues = _mm_max_epi16(maxValues, result);
+                    minValues = _mm_min_epi16(minValues, result);
+                }
+                return qMax(peak16(maxValues, minValues), gainAndClipScalar(samples + n, count - n, gain));
+            }
+
+            const Kernels &avxKernels()
+            {
+                static const Kernels kernels = { SimdAvx, &biQuadCascadeAvx, &gainAvx, &mixAvx, &peakAvx, &gainAndClipAvx };
+                return kernels;
+            }
+
+            bool cpuHasAvx()
+            {
+#if defined(Q_CC_MSVC)
+                int info[4] = {};
+                __cpuid(info, 1);
+                const bool osxsave = (info[2] & (1 << 27)) != 0;
+                const bool avx = (info[2] & (1 << 28)) != 0;
+                // YMM registers saved by the OS
+                return osxsave && avx && (_xgetbv(0) & 0x6) == 0x6;
+#else
+                __builtin_cpu_init();
+                return __builtin_cpu_supports("avx");
+#endif
+            }
+#endif
+
+            const Kernels &kernelsOf(SimdLevel level)
+            {
+                switch (level)
+                {
+#ifdef BLACKSOUND_DSP_AVX
+                case SimdAvx: return avxKernels();
+#endif
+#ifdef BLACKSOUND_DSP_SSE2
+                case SimdSse2: return sse2Kernels();
+#endif
+                default: return scalarKernels();
+                }
+            }
+
+            std::atomic<const Kernels *> g_kernels { nullptr };
+
+            const Kernels &kernels()
+            {
+                const Kernels *kernels = g_kernels.load(std::memory_order_acquire);
+                if (kernels) { return *kernels; }
+                kernels = &kernelsOf(supportedSimdLevel());
+                g_kernels.store(kernels, std::memory_order_release);
+                return *kernels;
+            }
+        } // anonymous ns
+
+        SimdLevel supportedSimdLevel()
+        {
+            static const SimdLevel level = []
+            {
+#if defined(BLACKSOUND_DSP_AVX)
+                if (cpuHasAvx()) { return SimdAvx; }
+#endif
+#if defined(BLACKSOUND_DSP_SSE2)
+                return SimdSse2;
+#else
+                return SimdScalar;
+#endif
+            }();
+            return level;
+        }
+
+        SimdLevel simdLevel()
+        {
+            return kernels().level;
+        }
+
+        SimdLevel setSimdLevel(SimdLevel level)
+        {
+            const Kernels &used = kernelsOf(qMin(level, supportedSimdLevel()));
+            g_kernels.store(&used, std::memory_order_release);
+            return used.level;
+        }
+
+        const QString &simdLevelToString(SimdLevel level)
+        {
+            static const QString scalar("scalar");
+            static const QString sse2("SSE2");
+            static const QString avx("AVX");
+            switch (level)
+            {
+            case SimdSse2: return sse2;
+            case SimdAvx:  return avx;
+            default: break;
+            }
+            return scalar;
+        }
+
+        void processBiQuadCascade(BiQuadCascadeData &cascade, float *samples, int count)
+        {
+            kernels().biQuadCascade(cascade, samples, count);
+        }
+
+        void applyGain(float *samples, int count, float gain)
+        {
+            kernels().gain(samples, count, gain);
+        }
+
+        void mixSamples(float *destination, const float *source, int count)
+        {
+            kernels().mix(destination, source, count);
+        }
+
+        float peakAbs(const float *samples, int count)
+        {
+            return kernels().peak(samples, count);
+        }
+
+        int applyGainAndClip(qint16 *samples, int count, double gain)
+        {
+            return kernels().gainAndClip(samples, count, gain);
+        }
+    } // ns
+} // ns
@@ -0,0 +1,97 @@
+/* Copyright (C) 2020
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \file
+
+#ifndef BLACKSOUND_DSP_SAMPLEKERNELS_H
+#define BLACKSOUND_DSP_SAMPLEKERNELS_H
+
+#include "blacksound/blacksoundexport.h"
+#include <QString>
+#include <QtGlobal>
+
+namespace BlackSound
+{
+    namespace Dsp
+    {
+        //! Instruction set used by the sample kernels
+        enum SimdLevel
+        {
+            SimdScalar, //!< plain C++, the reference implementation
+            SimdSse2,   //!< SSE2
+            SimdAvx     //!< AVX
+        };
+
+        //! Best instruction set supported by the CPU, detected once at runtime
+        BLACKSOUND_EXPORT SimdLevel supportedSimdLevel();
+
+        //! Instruction set used by the kernels, by default the supported one
+        //! \threadsafe
+        BLACKSOUND_EXPORT SimdLevel simdLevel();
+
+        //! Use an instruction set, limited to the supported one
+        //! \remark meant for tests and benchmarks
+        //! \threadsafe
+        BLACKSOUND_EXPORT SimdLevel setSimdLevel(SimdLevel level);
+
+        //! Instruction set as string
+        BLACKSOUND_EXPORT const QString &simdLevelToString(SimdLevel level);
+
+        /*!
+         * Coefficients and state of biquad filters in series, one array entry per filter
+         * \remark laid out for the vector kernels, use BiQuadCascade
+         */
+        struct BiQuadCascadeData
+        {
+            //! Max. number of filters
+            static constexpr int MaxFilters = 8;
+
+            int filters = 0; //!< number of filters used
+
+            //! Coefficients as in BiQuadFilter
+            //! @{
+            double a0[MaxFilters] = {};
+            double a1[MaxFilters] = {};
+            double a2[MaxFilters] = {};
+            double a3[MaxFilters] = {};
+            double a4[MaxFilters] = {};
+            //! @}
+
+            //! State as in BiQuadFilter
+            //! @{
+            float x1[MaxFilters] = {};
+            float x2[MaxFilters] = {};
+            float y1[MaxFilters] = {};
+            float y2[MaxFilters] = {};
+            //! @}
+        };
+
+        //! Sample kernels, dispatched to the instruction set of simdLevel()
+        //! \remark results are the same as the ones of SimdScalar
+        //! @{
+
+        //! Run samples through all filters of the cascade, in place
+        BLACKSOUND_EXPORT void processBiQuadCascade(BiQuadCascadeData &cascade, float *samples, int count);
+
+        //! Multiply samples by gain, in place
+        BLACKSOUND_EXPORT void applyGain(float *samples, int count, float gain);
+
+        //! Add source samples to the destination samples
+        BLACKSOUND_EXPORT void mixSamples(float *destination, const float *source, int count);
+
+        //! Largest absolute sample value
+        BLACKSOUND_EXPORT float peakAbs(const float *samples, int count);
+
+        //! Multiply 16bit samples by gain, rounded with qRound and clipped to the 16bit range, in place
+        //! \return largest absolute sample value after clipping, 0..32768
+        BLACKSOUND_EXPORT int applyGainAndClip(qint16 *samples, int count, double gain);
+        //! @}
+    } // ns
+} // ns
+
+#endif // guard
@@ -2,6 +2,7 @@
 #include "blacksound/audioutilities.h"
 
 #include <QDebug>
+#include <algorithm>
 
 namespace BlackSound
 {
@@ -19,18 +20,28 @@ namespace BlackSound
 
         void CBufferedWaveProvider::addSamples(const QVector<float> &samples)
         {
-            int delta = m_audioBuffer.size() + samples.size() - m_maxBufferSize;
+            this->addSamples(samples.constData(), samples.size());
+        }
+
+        void CBufferedWaveProvider::addSamples(const float *samples, int count)
+        {
+            int delta = m_audioBuffer.size() + count - m_maxBufferSize;
             if (delta > 0)
             {
                 m_audioBuffer.remove(0, delta);
             }
-            m_audioBuffer.append(samples);
+
+            // grow geometrically, the capacity is kept when reading
+            const int size = m_audioBuffer.size();
+            if (m_audioBuffer.capacity() < size + count) { m_audioBuffer.reserve(qMax(2 * m_audioBuffer.capacity(), size + count)); }
+            m_audioBuffer.resize(size + count);
+            std::copy(samples, samples + count, m_audioBuffer.begin() + size);
         }
 
-        int CBufferedWaveProvider::readSamples(QVector<float> &samples, qint64 count)
+        int CBufferedWaveProvider::readSamples(float *samples, int count)
         {
-            const int len = static_cast<int>(qMin(count, static_cast<qint64>(m_audioBuffer.size())));
-            samples = m_audioBuffer.mid(0, len);
+            const int len = qMin(count, m_audioBuffer.size());
+            std::copy(m_audioBuffer.cbegin(), m_audioBuffer.cbegin() + len, samples);
             // if (len != 0) qDebug() << "Reading" << count << "samples." << m_audioBuffer.size() << "currently in the buffer.";
             m_audioBuffer.remove(0, len);
             return len;
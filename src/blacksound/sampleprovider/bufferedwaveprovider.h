@@ -32,10 +32,16 @@ namespace BlackSound
             CBufferedWaveProvider(const QAudioFormat &format, QObject *parent = nullptr);
 
             //! Add samples
+            //! @{
             void addSamples(const QVector<float> &samples);
+            void addSamples(const float *samples, int count);
+            //! @}
 
             //! ISampleProvider::readSamples
-            virtual int readSamples(QVector<float> &samples, qint64 count) override;
+            virtual int readSamples(float *samples, int count) override;
+
+            //! \copydoc ISampleProvider::isSilent
+            virtual bool isSilent() const override { return m_audioBuffer.isEmpty(); }
 
             //! Bytes from buffer
             int getBufferedBytes() const { return m_audioBuffer.size(); }
@@ -1,5 +1,6 @@
 #include "equalizersampleprovider.h"
 #include "blacksound/audioutilities.h"
+#include "blacksound/dsp/samplekernels.h"
 #include <QDebug>
 
 using namespace BlackSound::Dsp;
@@ -19,19 +20,13 @@ namespace BlackSound
             setupPreset(preset);
         }
 
-        int CEqualizerSampleProvider::readSamples(QVector<float> &samples, qint64 count)
+        int CEqualizerSampleProvider::readSamples(float *samples, int count)
         {
             const int samplesRead = m_sourceProvider->readSamples(samples, count);
             if (m_bypass) return samplesRead;
 
-            for (int n = 0; n < samplesRead; n++)
-            {
-                for (int band = 0; band < m_filters.size(); band++)
-                {
-                    samples[n] = m_filters[band].transform(samples[n]);
-                }
-                samples[n] *= static_cast<float>(m_outputGain);
-            }
+            m_filters.process(samples, samplesRead);
+            applyGain(samples, samplesRead, static_cast<float>(m_outputGain));
             return samplesRead;
         }
 
@@ -40,11 +35,11 @@ namespace BlackSound
             switch (preset)
             {
             case VHFEmulation:
-                m_filters.push_back(BiQuadFilter::highPassFilter(44100, 310, 0.25));
-                m_filters.push_back(BiQuadFilter::peakingEQ(44100, 450, 0.75, 17.0));
-                m_filters.push_back(BiQuadFilter::peakingEQ(44100, 1450, 1.0, 25.0));
-                m_filters.push_back(BiQuadFilter::peakingEQ(44100, 2000, 1.0, 25.0));
-                m_filters.push_back(BiQuadFilter::lowPassFilter(44100, 2500, 0.25));
+                m_filters.append(BiQuadFilter::highPassFilter(44100, 310, 0.25));
+                m_filters.append(BiQuadFilter::peakingEQ(44100, 450, 0.75, 17.0));
+                m_filters.append(BiQuadFilter::peakingEQ(44100, 1450, 1.0, 25.0));
+                m_filters.append(BiQuadFilter::peakingEQ(44100, 2000, 1.0, 25.0));
+                m_filters.append(BiQuadFilter::lowPassFilter(44100, 2500, 0.25));
                 break;
             }
         }
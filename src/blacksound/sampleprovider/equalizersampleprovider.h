@@ -38,7 +38,13 @@ namespace BlackSound
             CEqualizerSampleProvider(ISampleProvider *sourceProvider, EqualizerPresets preset, QObject *parent = nullptr);
 
             //! \copydoc ISampleProvider::readSamples
-            virtual int readSamples(QVector<float> &samples, qint64 count) override;
+            virtual int readSamples(float *samples, int count) override;
+
+            //! \copydoc ISampleProvider::isSilent
+            virtual bool isSilent() const override { return m_sourceProvider->isSilent(); }
+
+            //! Reset the filter state, as after a long silence
+            void reset() { m_filters.reset(); }
 
             //! Bypassing?
             void setBypassEffects(bool value) { m_bypass = value; }
@@ -56,7 +62,7 @@ namespace BlackSound
             int    m_channels   = 1;
             bool   m_bypass     = false;
             double m_outputGain = 1.0;
-            QVector<Dsp::BiQuadFilter> m_filters;
+            Dsp::BiQuadCascade m_filters;
         };
     } // ns
 } // ns
@@ -7,60 +7,103 @@
  */
 
 #include "mixingsampleprovider.h"
+#include "blacksound/dsp/samplekernels.h"
 #include "blackmisc/metadatautils.h"
 
+#include <algorithm>
+
 using namespace BlackMisc;
+using namespace BlackSound::Dsp;
 
 namespace BlackSound
 {
     namespace SampleProvider
     {
+        constexpr int CMixingSampleProvider::MaxInputs;
+
         CMixingSampleProvider::CMixingSampleProvider(QObject *parent) : ISampleProvider(parent)
         {
             const QString on = QStringLiteral("%1").arg(classNameShort(this));
             this->setObjectName(on);
+            for (auto &source : m_sources) { source.store(nullptr); }
+            m_sourceBuffer.fill(0, BlockSize);
         }
 
-        void CMixingSampleProvider::addMixerInput(ISampleProvider *provider)
+        bool CMixingSampleProvider::addMixerInput(ISampleProvider *provider)
         {
             Q_ASSERT(provider);
-            m_sources.append(provider);
+            if (this->containsMixerInput(provider)) { return true; }
+            for (auto &source : m_sources)
+            {
+                ISampleProvider *expected = nullptr;
+                if (source.compare_exchange_strong(expected, provider)) { return true; }
+            }
+            Q_ASSERT_X(false, Q_FUNC_INFO, "Too many mixer inputs");
+            return false;
+        }
 
-            const QString on = QStringLiteral("%1 sources: %2").arg(classNameShort(this)).arg(m_sources.size());
-            this->setObjectName(on);
+        bool CMixingSampleProvider::removeMixerInput(ISampleProvider *provider)
+        {
+            for (auto &source : m_sources)
+            {
+                ISampleProvider *expected = provider;
+                if (source.compare_exchange_strong(expected, nullptr)) { return true; }
+            }
+            return false;
         }
 
-        int CMixingSampleProvider::readSamples(QVector<float> &samples, qint64 count)
+        bool CMixingSampleProvider::containsMixerInput(const ISampleProvider *provider) const
         {
-            samples.clear();
-            samples.fill(0, static_cast<int>(count));
-            int outputLen = 0;
+            for (const auto &source : m_sources)
+            {
+                if (source.load() == provider) { return true; }
+            }
+            return false;
+        }
 
-            QVector<ISampleProvider *> finishedProviders;
-            for (int i = 0; i < m_sources.size(); i++)
+        bool CMixingSampleProvider::isSilent() const
+        {
+            for (const auto &source : m_sources)
             {
-                ISampleProvider *sampleProvider = m_sources.at(i);
-                QVector<float> sourceBuffer;
+                const ISampleProvider *sampleProvider = source.load(std::memory_order_acquire);
+                if (sampleProvider && !sampleProvider->isSilent()) { return false; }
+            }
+            return true;
+        }
 
-                const int len = sampleProvider->readSamples(sourceBuffer, count);
-                for (int n = 0; n < len; n++)
-                {
-                    samples[n] += sourceBuffer[n];
-                }
+        int CMixingSampleProvider::readSamples(float *samples, int count)
+        {
+            std::fill(samples, samples + count, 0.0f);
+            float *sourceBuffer = m_sourceBuffer.data();
+            int outputLen = 0;
 
-                outputLen = qMax(len, outputLen);
-                if (sampleProvider->isFinished())
+            // blocks of the preallocated scratch buffer
+            for (int offset = 0; offset < count; offset += BlockSize)
+            {
+                const int blockCount = qMin(count - offset, static_cast<int>(BlockSize));
+                float *block = samples + offset;
+                for (auto &source : m_sources)
                 {
-                    finishedProviders.push_back(sampleProvider);
-                }
-            }
+                    ISampleProvider *sampleProvider = source.load(std::memory_order_acquire);
+                    if (!sampleProvider) { continue; }
+                    if (sampleProvider->isSilent())
+                    {
+                        // zeros, already filled
+                        outputLen = qMax(offset + blockCount, outputLen);
+                        continue;
+                    }
 
-            for (ISampleProvider *sampleProvider : finishedProviders)
-            {
-                sampleProvider->deleteLater();
-                m_sources.removeAll(sampleProvider);
-            }
+                    const int len = sampleProvider->readSamples(sourceBuffer, blockCount);
+                    mixSamples(block, sourceBuffer, len);
 
+                    outputLen = qMax(offset + len, outputLen);
+                    if (sampleProvider->isFinished())
+                    {
+                        // removed only if not replaced meanwhile
+                        source.compare_exchange_strong(sampleProvider, nullptr);
+                    }
+                }
+            }
             return outputLen;
         }
     } // ns
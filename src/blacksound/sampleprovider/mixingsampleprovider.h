@@ -13,28 +13,50 @@
 
 #include "blacksound/blacksoundexport.h"
 #include "blacksound/sampleprovider/sampleprovider.h"
-#include <QSharedPointer>
 #include <QVector>
+#include <array>
+#include <atomic>
 
 namespace BlackSound
 {
     namespace SampleProvider
     {
         //! Mixer
+        //! \details The inputs are kept in a fixed number of slots, they can be added and removed from any thread
+        //!          without locking while the audio thread reads. Finished inputs are removed, but not deleted.
+        //!          Inputs are owned by their QObject parent and must outlive the mixer. Silent inputs are
+        //!          not read at all, so an idle branch of the graph costs nothing.
         class BLACKSOUND_EXPORT CMixingSampleProvider : public ISampleProvider
         {
         public:
+            //! Max. number of inputs
+            static constexpr int MaxInputs = 16;
+
             //! Ctor mixing provider
             CMixingSampleProvider(QObject *parent = nullptr);
 
-            //! Add a provider
-            void addMixerInput(ISampleProvider *provider);
+            //! Add a provider, nothing happens if it is already an input
+            //! \threadsafe
+            bool addMixerInput(ISampleProvider *provider);
+
+            //! Remove a provider
+            //! \threadsafe
+            bool removeMixerInput(ISampleProvider *provider);
+
+            //! Is the provider an input?
+            //! \threadsafe
+            bool containsMixerInput(const ISampleProvider *provider) const;
 
             //! \copydoc ISampleProvider::readSamples
-            virtual int readSamples(QVector<float> &samples, qint64 count) override;
+            virtual int readSamples(float *samples, int count) override;
+
+            //! \copydoc ISampleProvider::isSilent
+            //! \remark silent if all inputs are silent
+            virtual bool isSilent() const override;
 
         private:
-            QVector<ISampleProvider *> m_sources;
+            std::array<std::atomic<ISampleProvider *>, MaxInputs> m_sources;
+            QVector<float> m_sourceBuffer; //!< scratch buffer of ISampleProvider::BlockSize
         };
     } // ns
 } // ns
@@ -14,12 +14,8 @@ namespace BlackSound
 {
     namespace SampleProvider
     {
-        int CPinkNoiseGenerator::readSamples(QVector<float> &samples, qint64 count)
+        int CPinkNoiseGenerator::readSamples(float *samples, int count)
         {
-            const int c = static_cast<int>(count);
-            samples.clear();
-            samples.fill(0, c);
-
             for (int sampleCount = 0; sampleCount < count; sampleCount++)
             {
                 double white = 2 * m_random.generateDouble() - 1;
@@ -35,7 +31,7 @@ namespace BlackSound
                 const float sampleValue = static_cast<float>(m_gain * (pink / 5));
                 samples[sampleCount] = sampleValue;
             }
-            return c;
+            return count;
         }
     }
 }
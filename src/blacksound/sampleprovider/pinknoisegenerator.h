@@ -33,7 +33,10 @@ namespace BlackSound
             CPinkNoiseGenerator(QObject *parent = nullptr) : ISampleProvider(parent) {}
 
             //! Read samples
-            virtual int readSamples(QVector<float> &samples, qint64 count) override;
+            virtual int readSamples(float *samples, int count) override;
+
+            //! \copydoc ISampleProvider::isSilent
+            virtual bool isSilent() const override { return qFuzzyIsNull(m_gain); }
 
             //! Gain
             void setGain(double gain) { m_gain = gain; }
@@ -27,11 +27,19 @@ namespace BlackSound
             CResourceSoundSampleProvider(const CResourceSound &resourceSound, QObject *parent = nullptr);
 
             //! copydoc ISampleProvider::readSamples
-            virtual int readSamples(QVector<float> &samples, qint64 count) override;
+            virtual int readSamples(float *samples, int count) override;
 
             //! copydoc ISampleProvider::isFinished
             virtual bool isFinished() const override { return m_isFinished; }
 
+            //! \copydoc ISampleProvider::isSilent
+            //! \remark only a looping sound, others play to their end
+            virtual bool isSilent() const override { return m_looping && qFuzzyIsNull(m_gain); }
+
+            //! Play again from the start
+            //! \remark not thread safe, only call while not read or from the reading thread
+            void restart();
+
             //! Looping
             //! @{
             bool looping() const { return m_looping; }
@@ -50,8 +58,6 @@ namespace BlackSound
 
             CResourceSound  m_resourceSound;
             qint64          m_position = 0;
-            const int       m_tempBufferSize = 24000; //24000 = 500ms (avoid buffer overflow), m_tempBufferSize = 9600; //9600 = 200ms
-            QVector<float>  m_tempBuffer;
             bool            m_isFinished = false;
         };
     } // ns
@@ -32,12 +32,23 @@ namespace BlackSound
             //! Dtor
             virtual ~ISampleProvider() override {}
 
-            //! Read samples
-            virtual int readSamples(QVector<float> &samples, qint64 count) = 0;
+            //! Samples of the scratch buffers preallocated by the providers, larger reads are processed in blocks of this size
+            static constexpr int BlockSize = 4800;
+
+            //! Read samples into a caller owned buffer
+            //! \param samples buffer of at least count samples, the provider writes from its start
+            //! \param count number of samples requested
+            //! \return number of samples written
+            //! \remark called from the audio thread, implementations must neither allocate nor lock
+            virtual int readSamples(float *samples, int count) = 0;
 
             //! Finished?
             virtual bool isFinished() const { return false; }
 
+            //! Silent, the next read would deliver zeros only
+            //! \remark mixers do not read silent inputs, so their state does not advance while silent
+            virtual bool isSilent() const { return false; }
+
         protected:
             //! Verbose logs?
             bool static verbose() { return BlackConfig::CBuildConfig::isLocalDeveloperDebugBuild(); }
@@ -20,11 +20,8 @@ namespace BlackSound
             this->setObjectName("CSawToothGenerator");
         }
 
-        int CSawToothGenerator::readSamples(QVector<float> &samples, qint64 count)
+        int CSawToothGenerator::readSamples(float *samples, int count)
         {
-            samples.clear();
-            samples.fill(0, static_cast<int>(count));
-
             for (int sampleCount = 0; sampleCount < count; sampleCount++)
             {
                 double multiple = 2 * m_frequency / m_sampleRate;
@@ -33,7 +30,7 @@ namespace BlackSound
                 samples[sampleCount] = static_cast<float>(sampleValue);
                 m_nSample++;
             }
-            return static_cast<int>(count);
+            return count;
         }
     } // ns
 } // ns
@@ -32,7 +32,13 @@ namespace BlackSound
             CSimpleCompressorEffect(ISampleProvider *source, QObject *parent = nullptr);
 
             //! \copydoc ISampleProvider::readSamples
-            virtual int readSamples(QVector<float> &samples, qint64 count) override;
+            virtual int readSamples(float *samples, int count) override;
+
+            //! \copydoc ISampleProvider::isSilent
+            virtual bool isSilent() const override { return m_sourceStream->isSilent(); }
+
+            //! Reset the envelope, as after a long silence
+            void reset() { m_simpleCompressor.initRuntime(); }
 
             //! Enable
             void setEnabled(bool enabled);
@@ -24,11 +24,8 @@ namespace BlackSound
             this->setObjectName(on);
         }
 
-        int CSinusGenerator::readSamples(QVector<float> &samples, qint64 count)
+        int CSinusGenerator::readSamples(float *samples, int count)
         {
-            samples.clear();
-            samples.fill(0, static_cast<int>(count));
-
             for (int sampleCount = 0; sampleCount < count; sampleCount++)
             {
                 const double multiple    = s_twoPi * m_frequencyHz / m_sampleRate;
@@ -36,7 +33,7 @@ namespace BlackSound
                 samples[sampleCount]     = static_cast<float>(sampleValue);
                 m_nSample++;
             }
-            return static_cast<int>(count);
+            return count;
         }
 
         void CSinusGenerator::setFrequency(double frequencyHz)
@@ -30,7 +30,10 @@ namespace BlackSound
             CSinusGenerator(double frequencyHz, QObject *parent = nullptr);
 
             //! \copydoc ISampleProvider::readSamples
-            virtual int readSamples(QVector<float> &samples, qint64 count) override;
+            virtual int readSamples(float *samples, int count) override;
+
+            //! \copydoc ISampleProvider::isSilent
+            virtual bool isSilent() const override { return qFuzzyIsNull(m_gain); }
 
             //! Set the gain
             void setGain(double gain) { m_gain = gain; }
@@ -9,9 +9,11 @@
 //! \file
 
 #include "volumesampleprovider.h"
+#include "blacksound/dsp/samplekernels.h"
 #include "blackmisc/metadatautils.h"
 
 using namespace BlackMisc;
+using namespace BlackSound::Dsp;
 
 namespace BlackSound
 {
@@ -26,15 +28,12 @@ namespace BlackSound
             this->setObjectName(on);
         }
 
-        int CVolumeSampleProvider::readSamples(QVector<float> &samples, qint64 count)
+        int CVolumeSampleProvider::readSamples(float *samples, int count)
         {
             const int samplesRead = m_sourceProvider->readSamples(samples, count);
             if (!qFuzzyCompare(m_gainRatio, 1.0))
             {
-                for (int n = 0; n < samplesRead; n++)
-                {
-                    samples[n] = static_cast<float>(m_gainRatio * samples[n]);
-                }
+                applyGain(samples, samplesRead, static_cast<float>(m_gainRatio));
             }
             return samplesRead;
         }
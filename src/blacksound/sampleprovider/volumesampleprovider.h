@@ -28,7 +28,10 @@ namespace BlackSound
             CVolumeSampleProvider(ISampleProvider *sourceProvider, QObject *parent = nullptr);
 
             //! \copydoc ISampleProvider::readSamples
-            virtual int readSamples(QVector<float> &samples, qint64 count) override;
+            virtual int readSamples(float *samples, int count) override;
+
+            //! \copydoc ISampleProvider::isSilent
+            virtual bool isSilent() const override { return m_sourceProvider->isSilent(); }
 
             //! Gain ratio, value a amplitude need to be multiplied with
             //! \see http://www.sengpielaudio.com/calculator-amplification.htm
@@ -58,6 +58,7 @@
 #include <QDBusServiceWatcher>
 #include <QString>
 #include <QTimer>
+#include <QVector>
 #include <QtGlobal>
 #include <QPointer>
 #include <math.h>
@@ -636,9 +637,20 @@ namespace BlackSimPlugin
             PlanesSurfaces planesSurfaces;
             PlanesTransponders planesTransponders;
 
-            int aircraftNumber = 0;
             const bool updateAllAircraft = this->isUpdateAllRemoteAircraft(currentTimestamp);
             const CCallsignSet callsignsInRange = this->getAircraftInRangeCallsigns();
+
+            //! Result of one aircraft, written by the update tasks
+            struct UpdatedAircraft
+            {
+                const CFlightgearMPAircraft *aircraft = nullptr;
+                CInterpolationResult result;
+                bool sendSituation = false;
+                bool sendParts = false;
+            };
+
+            QVector<UpdatedAircraft> updatedAircraft;
+            updatedAircraft.reserve(remoteAircraftNo);
             for (const CFlightgearMPAircraft &flightgearAircraft : m_flightgearAircraftObjects)
             {
                 const CCallsign callsign(flightgearAircraft.getCallsign());
@@ -653,24 +665,57 @@ namespace BlackSimPlugin
                 // skip no longer in range
                 if (!callsignsInRange.contains(callsign)) { continue; }
 
+                UpdatedAircraft updated;
+                updated.aircraft = &flightgearAircraft;
+                updatedAircraft.push_back(updated);
+            }
+
+            // interpolants of all aircraft first, evaluated in one pass
+            // the tasks only read shared data and write their own lane and result, so they can run in parallel
+            const int updatedAircraftNo = updatedAircraft.size();
+            m_interpolationBatch.resize(updatedAircraftNo);
+            this->runRemoteAircraftUpdateTasks(updatedAircraftNo, [&](int i)
+            {
+                const CFlightgearMPAircraft &flightgearAircraft = *updatedAircraft[i].aircraft;
+                const CInterpolationAndRenderingSetupPerCallsign setup = this->getInterpolationSetupConsolidated(flightgearAircraft.getCallsign(), updateAllAircraft);
+                flightgearAircraft.prepareBatchedInterpolation(currentTimestamp, setup, i, m_interpolationBatch, i);
+            });
+            m_interpolationBatch.evaluate();
+            this->runRemoteAircraftUpdateTasks(updatedAircraftNo, [&](int i)
+            {
+                UpdatedAircraft &updated = updatedAircraft[i];
+                updated.result = updated.aircraft->getBatchedInterpolation(m_interpolationBatch);
+                if (updated.result.getInterpolationStatus().hasValidSituation())
+                {
+                    updated.sendSituation = updateAllAircraft || !this->isEqualLastSent(CAircraftSituation(updated.result));
+                }
+                const CAircraftParts parts(updated.result);
+                if (updated.result.getPartsStatus().isSupportingParts() || parts.getPartsDetails() == CAircraftParts::GuessedParts)
+                {
+                    updated.sendParts = updateAllAircraft || !this->isEqualLastSent(parts, updated.aircraft->getCallsign());
+                }
+            });
+
+            // merge in the order of the aircraft
+            for (const UpdatedAircraft &updated : as_const(updatedAircraft))
+            {
+                const CFlightgearMPAircraft &flightgearAircraft = *updated.aircraft;
+                const CCallsign callsign(flightgearAircraft.getCallsign());
+                const CInterpolationResult &result = updated.result;
+
                 planesTransponders.callsigns.push_back(callsign.asString());
                 planesTransponders.codes.push_back(flightgearAircraft.getAircraft().getTransponderCode());
                 CTransponder::TransponderMode transponderMode = flightgearAircraft.getAircraft().getTransponderMode();
                 planesTransponders.idents.push_back(transponderMode == CTransponder::StateIdent);
                 planesTransponders.modeCs.push_back(transponderMode == CTransponder::ModeC);
 
-                // setup
-                const CInterpolationAndRenderingSetupPerCallsign setup = this->getInterpolationSetupConsolidated(callsign, updateAllAircraft);
-
                 // interpolated situation/parts
-                const CInterpolationResult result = flightgearAircraft.getInterpolation(currentTimestamp, setup, aircraftNumber++);
                 if (result.getInterpolationStatus().hasValidSituation())
                 {
-                    const CAircraftSituation interpolatedSituation(result);
-
                     // update situation
-                    if (updateAllAircraft || !this->isEqualLastSent(interpolatedSituation))
+                    if (updated.sendSituation)
                     {
+                        const CAircraftSituation interpolatedSituation(result);
                         this->rememberLastSent(interpolatedSituation);
                         planesPositions.push_back(interpolatedSituation);
                     }
@@ -680,14 +725,11 @@ namespace BlackSimPlugin
                     CLogMessage(this).warning(this->getInvalidSituationLogMessage(callsign, result.getInterpolationStatus()));
                 }
 
-                const CAircraftParts parts(result);
-                if (result.getPartsStatus().isSupportingParts() || parts.getPartsDetails() == CAircraftParts::GuessedParts)
+                if (updated.sendParts)
                 {
-                    if (updateAllAircraft || !this->isEqualLastSent(parts, callsign))
-                    {
-                        this->rememberLastSent(parts, callsign);
-                        planesSurfaces.push_back(flightgearAircraft.getCallsign(), parts);
-                    }
+                    const CAircraftParts parts(result);
+                    this->rememberLastSent(parts, callsign);
+                    planesSurfaces.push_back(flightgearAircraft.getCallsign(), parts);
                 }
 
             } // all callsigns
@@ -219,6 +219,18 @@ namespace BlackSimPlugin
             return m_interpolator->getInterpolation(currentTimeSinceEpoc, setup, aircraftNumber);
         }
 
+        bool CSimConnectObject::prepareBatchedInterpolation(qint64 currentTimeSinceEpoc, const CInterpolationAndRenderingSetupPerCallsign &setup, int aircraftNumber, CInterpolationBatch &batch, int lane) const
+        {
+            if (!m_interpolator) { return false; }
+            return m_interpolator->prepareBatchedInterpolation(currentTimeSinceEpoc, setup, aircraftNumber, batch, lane);
+        }
+
+        CInterpolationResult CSimConnectObject::getBatchedInterpolation(const CInterpolationBatch &batch) const
+        {
+            if (!m_interpolator) { CInterpolationResult result; result.reset(); return result; }
+            return m_interpolator->getBatchedInterpolation(batch);
+        }
+
         const CAircraftSituation &CSimConnectObject::getLastInterpolatedSituation(CInterpolationAndRenderingSetupBase::InterpolatorMode mode) const
         {
             if (!m_interpolator) { return CAircraftSituation::null(); }
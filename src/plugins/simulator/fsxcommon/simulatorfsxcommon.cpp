@@ -32,6 +32,7 @@
 #include <QTimer>
 #include <QPointer>
 #include <QStringBuilder>
+#include <QVector>
 #include <type_traits>
 #include <QElapsedTimer>
 
@@ -1963,6 +1964,18 @@ namespace BlackSimPlugin
             int simObjectNumber = 0;
             const bool traceSendId       = this->isTracingSendId();
             const bool updateAllAircraft = this->isUpdateAllRemoteAircraft(currentTimestamp);
+
+            //! Object to be updated, setup and result are written by the update tasks
+            struct InterpolatedObject
+            {
+                const CSimConnectObject *simObject = nullptr;
+                int simObjectNumber = -1;
+                CInterpolationAndRenderingSetupPerCallsign setup;
+                CInterpolationResult result;
+                bool sendSituation = false;
+            };
+            QVector<InterpolatedObject> interpolatedObjects;
+            interpolatedObjects.reserve(simObjects.size());
             for (const CSimConnectObject &simObject : simObjects)
             {
                 // happening if aircraft is not yet added to simulator or to be deleted
@@ -1975,21 +1988,52 @@ namespace BlackSimPlugin
                 BLACK_VERIFY_X(hasCs, Q_FUNC_INFO, "missing callsign");
                 BLACK_AUDIT_X(hasValidIds, Q_FUNC_INFO, "Missing ids");
                 if (!hasCs || !hasValidIds) { continue; } // not supposed to happen
-                const DWORD objectId = simObject.getObjectId();
 
-                // setup
-                const CInterpolationAndRenderingSetupPerCallsign setup = this->getInterpolationSetupConsolidated(callsign, updateAllAircraft);
+                // simObjectNumber is passed to equally distributed steps like guessing parts
+                InterpolatedObject interpolatedObject;
+                interpolatedObject.simObject = &simObject;
+                interpolatedObject.simObjectNumber = simObjectNumber++;
+                interpolatedObjects.push_back(interpolatedObject);
+            }
+
+            // interpolants of all aircraft first, evaluated in one pass
+            // the tasks only read shared data and write their own lane and object, so they can run in parallel
+            const int interpolatedObjectsNo = interpolatedObjects.size();
+            m_interpolationBatch.resize(interpolatedObjectsNo);
+            this->runRemoteAircraftUpdateTasks(interpolatedObjectsNo, [&](int i)
+            {
+                InterpolatedObject &interpolatedObject = interpolatedObjects[i];
+                const CSimConnectObject &simObject = *interpolatedObject.simObject;
+                interpolatedObject.setup = this->getInterpolationSetupConsolidated(simObject.getCallsign(), updateAllAircraft);
+                simObject.prepareBatchedInterpolation(currentTimestamp, interpolatedObject.setup, interpolatedObject.simObjectNumber, m_interpolationBatch, i);
+            });
+            m_interpolationBatch.evaluate();
+            this->runRemoteAircraftUpdateTasks(interpolatedObjectsNo, [&](int i)
+            {
+                InterpolatedObject &interpolatedObject = interpolatedObjects[i];
+                interpolatedObject.result = interpolatedObject.simObject->getBatchedInterpolation(m_interpolationBatch);
+                if (!interpolatedObject.result.getInterpolationStatus().hasValidSituation()) { return; }
+                const bool slowUpdate = (((m_statsUpdateAircraftRuns + interpolatedObject.simObjectNumber) % 40) == 0);
+                const bool forceUpdate = slowUpdate || updateAllAircraft || interpolatedObject.setup.isForcingFullInterpolation();
+                interpolatedObject.sendSituation = forceUpdate || !this->isEqualLastSent(interpolatedObject.result.getInterpolatedSituation());
+            });
+
+            // SimConnect calls in this thread
+            for (const InterpolatedObject &interpolatedObject : as_const(interpolatedObjects))
+            {
+                const CSimConnectObject &simObject = *interpolatedObject.simObject;
+                const CInterpolationAndRenderingSetupPerCallsign &setup = interpolatedObject.setup;
+                const DWORD objectId = simObject.getObjectId();
                 const bool sendGround = setup.isSendingGndFlagToSimulator();
 
                 // Interpolated situation
-                // simObjectNumber is passed to equally distributed steps like guessing parts
-                const bool slowUpdate = (((m_statsUpdateAircraftRuns + simObjectNumber) % 40) == 0);
-                const CInterpolationResult result = simObject.getInterpolation(currentTimestamp, setup, simObjectNumber++);
+                const bool slowUpdate = (((m_statsUpdateAircraftRuns + interpolatedObject.simObjectNumber) % 40) == 0);
+                const CInterpolationResult &result = interpolatedObject.result;
                 const bool forceUpdate = slowUpdate || updateAllAircraft || setup.isForcingFullInterpolation();
                 if (result.getInterpolationStatus().hasValidSituation())
                 {
                     // update situation
-                    if (forceUpdate || !this->isEqualLastSent(result.getInterpolatedSituation()))
+                    if (interpolatedObject.sendSituation)
                     {
                         SIMCONNECT_DATA_INITPOSITION position = this->aircraftSituationToFsxPosition(result, sendGround);
                         const HRESULT hr = this->logAndTraceSendId(
@@ -17,6 +17,7 @@
 #include "plugins/simulator/fsxcommon/simconnectwindows.h"
 #include "plugins/simulator/fscommon/simulatorfscommon.h"
 #include "blackcore/simulator.h"
+#include "blackmisc/simulation/interpolationbatch.h"
 #include "blackmisc/simulation/interpolatorlinear.h"
 #include "blackmisc/simulation/simulatorplugininfo.h"
 #include "blackmisc/simulation/settings/simulatorsettings.h"
@@ -332,6 +333,7 @@ namespace BlackSimPlugin
             HANDLE m_hSimConnect = nullptr;                                     //!< handle to SimConnect object
             DispatchProc m_dispatchProc = &CSimulatorFsxCommon::SimConnectProc; //!< called function for dispatch, can be overriden by specialized P3D function
             CSimConnectObjects m_simConnectObjects;                             //!< AI objects and their object and request ids
+            BlackMisc::Simulation::CInterpolationBatch m_interpolationBatch;    //!< interpolants of all remote aircraft, reused in each update
 
             // probes
             bool m_useFsxTerrainProbe = is32bit(); //!< Use FSX Terrain probe?
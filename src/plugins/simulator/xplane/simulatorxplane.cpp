@@ -57,9 +57,12 @@
 #include "dbus/dbus.h"
 
 #include <QColor>
+#include <QCoreApplication>
 #include <QDBusServiceWatcher>
+#include <QDateTime>
 #include <QString>
 #include <QTimer>
+#include <QVector>
 #include <QtGlobal>
 #include <QPointer>
 #include <QElapsedTimer>
@@ -73,9 +76,12 @@ using namespace BlackMisc::PhysicalQuantities;
 using namespace BlackMisc::Geo;
 using namespace BlackMisc::Simulation;
 using namespace BlackMisc::Simulation::Settings;
+using namespace BlackMisc::Simulation::XPlane::TrafficChannel;
 using namespace BlackMisc::Weather;
 using namespace BlackCore;
 
+namespace OwnTelemetry = BlackMisc::Simulation::XPlane::OwnTelemetry;
+
 namespace
 {
     const QString &xswiftbusServiceName()
@@ -307,12 +313,27 @@ namespace BlackSimPlugin
             {
                 m_fastTimerCalls++;
 
-                m_serviceProxy->getOwnAircraftSituationDataAsync(&m_xplaneData);
-                m_serviceProxy->getOwnAircraftCom1DataAsync(&m_xplaneData);
-                m_serviceProxy->getOwnAircraftCom2DataAsync(&m_xplaneData);
-                m_serviceProxy->getOwnAircraftXpdrAsync(&m_xplaneData);
-                m_serviceProxy->getAllWheelsOnGroundAsync(&m_xplaneData.onGroundAll);
+                if (m_ownAircraftTelemetry)
+                {
+                    // pushed by xswiftbus, only changes are published, so refresh with the last values if nothing came in
+                    if (m_ownAircraftTelemetryReceived) { m_ownAircraftTelemetryReceived = false; return; }
+                }
+                else
+                {
+                    m_serviceProxy->getOwnAircraftSituationDataAsync(&m_xplaneData);
+                    m_serviceProxy->getOwnAircraftCom1DataAsync(&m_xplaneData);
+                    m_serviceProxy->getOwnAircraftCom2DataAsync(&m_xplaneData);
+                    m_serviceProxy->getOwnAircraftXpdrAsync(&m_xplaneData);
+                    m_serviceProxy->getAllWheelsOnGroundAsync(&m_xplaneData.onGroundAll);
+                }
+                this->updateOwnAircraftFromXPlaneData();
+            }
+        }
 
+        void CSimulatorXPlane::updateOwnAircraftFromXPlaneData()
+        {
+            if (!this->isShuttingDownOrDisconnected())
+            {
                 CAircraftSituation situation;
                 situation.setPosition({ m_xplaneData.latitudeDeg, m_xplaneData.longitudeDeg, 0 });
                 const CAltitude altitude { m_xplaneData.altitudeM, CAltitude::MeanSeaLevel, CLengthUnit::m() };
@@ -378,16 +399,81 @@ namespace BlackSimPlugin
             }
         }
 
+        void CSimulatorXPlane::enableOwnAircraftTelemetry()
+        {
+            m_ownAircraftTelemetry = m_serviceProxy && m_serviceProxy->setOwnAircraftTelemetryInterval(OwnTelemetry::DefaultIntervalMs);
+            m_ownAircraftTelemetryReceived = false;
+            if (!m_ownAircraftTelemetry)
+            {
+                CLogMessage(this).info(u"xswiftbus does not publish own aircraft telemetry, polling own aircraft");
+            }
+        }
+
+        void CSimulatorXPlane::onOwnAircraftTelemetry(const QDoubleList &values, const QList<int> &integers)
+        {
+            if (!m_ownAircraftTelemetry || this->isShuttingDownOrDisconnected()) { return; }
+
+            OwnTelemetry::Telemetry telemetry;
+            telemetry.values.assign(values.cbegin(), values.cend());
+            telemetry.integers.assign(integers.cbegin(), integers.cend());
+            if (!telemetry.isValid()) { return; }
+
+            m_xplaneData.latitudeDeg = telemetry.value(OwnTelemetry::LatitudeDeg);
+            m_xplaneData.longitudeDeg = telemetry.value(OwnTelemetry::LongitudeDeg);
+            m_xplaneData.altitudeM = telemetry.value(OwnTelemetry::AltitudeM);
+            m_xplaneData.groundspeedMs = telemetry.value(OwnTelemetry::GroundSpeedMs);
+            m_xplaneData.pitchDeg = telemetry.value(OwnTelemetry::PitchDeg);
+            m_xplaneData.rollDeg = telemetry.value(OwnTelemetry::RollDeg);
+            m_xplaneData.trueHeadingDeg = telemetry.value(OwnTelemetry::TrueHeadingDeg);
+            m_xplaneData.seaLevelPressureInHg = telemetry.value(OwnTelemetry::SeaLevelPressureInHg);
+            m_xplaneData.onGroundAll = telemetry.hasFlag(OwnTelemetry::OnGroundAll);
+            m_xplaneData.flapsDeployRatio = telemetry.value(OwnTelemetry::FlapsDeployRatio);
+            m_xplaneData.gearDeployRatio = telemetry.value(OwnTelemetry::GearDeployRatio);
+            m_xplaneData.speedBrakeRatio = telemetry.value(OwnTelemetry::SpeedBrakeRatio);
+            m_xplaneData.enginesN1Percentage.clear();
+            for (std::size_t e = 0; e < telemetry.engineCount(); e++) { m_xplaneData.enginesN1Percentage.push_back(telemetry.engineN1Percentage(e)); }
+            m_xplaneData.beaconLightsOn = telemetry.hasFlag(OwnTelemetry::BeaconLights);
+            m_xplaneData.landingLightsOn = telemetry.hasFlag(OwnTelemetry::LandingLights);
+            m_xplaneData.navLightsOn = telemetry.hasFlag(OwnTelemetry::NavLights);
+            m_xplaneData.strobeLightsOn = telemetry.hasFlag(OwnTelemetry::StrobeLights);
+            m_xplaneData.taxiLightsOn = telemetry.hasFlag(OwnTelemetry::TaxiLights);
+            m_xplaneData.com1Volume = telemetry.value(OwnTelemetry::Com1Volume);
+            m_xplaneData.isCom1Receiving = telemetry.hasFlag(OwnTelemetry::Com1Receiving);
+            m_xplaneData.isCom1Transmitting = telemetry.hasFlag(OwnTelemetry::Com1Transmitting);
+            m_xplaneData.com2Volume = telemetry.value(OwnTelemetry::Com2Volume);
+            m_xplaneData.isCom2Receiving = telemetry.hasFlag(OwnTelemetry::Com2Receiving);
+            m_xplaneData.isCom2Transmitting = telemetry.hasFlag(OwnTelemetry::Com2Transmitting);
+
+            // telemetry sent before a cockpit update from swift arrived in X-Plane would reset the cockpit
+            const bool cockpitPending = m_cockpitUpdatedMs >= 0 && QDateTime::currentMSecsSinceEpoch() - m_cockpitUpdatedMs < CockpitUpdatePendingMs;
+            if (!cockpitPending)
+            {
+                m_xplaneData.com1ActiveKhz = telemetry.integer(OwnTelemetry::Com1ActiveKhz);
+                m_xplaneData.com1StandbyKhz = telemetry.integer(OwnTelemetry::Com1StandbyKhz);
+                m_xplaneData.com2ActiveKhz = telemetry.integer(OwnTelemetry::Com2ActiveKhz);
+                m_xplaneData.com2StandbyKhz = telemetry.integer(OwnTelemetry::Com2StandbyKhz);
+                m_xplaneData.xpdrCode = telemetry.integer(OwnTelemetry::XpdrCode);
+                m_xplaneData.xpdrMode = telemetry.integer(OwnTelemetry::XpdrMode);
+                m_xplaneData.xpdrIdent = telemetry.hasFlag(OwnTelemetry::XpdrIdent);
+            }
+
+            m_ownAircraftTelemetryReceived = true;
+            this->updateOwnAircraftFromXPlaneData();
+        }
+
         void CSimulatorXPlane::slowTimerTimeout()
         {
             if (!this->isShuttingDownOrDisconnected())
             {
                 m_slowTimerCalls++;
 
-                // own aircraft data
+                // own aircraft data, lights and parts are part of the telemetry
                 m_serviceProxy->getOwnAircraftModelDataAsync(&m_xplaneData);
-                m_serviceProxy->getOwnAircraftLightsAsync(&m_xplaneData);
-                m_serviceProxy->getOwnAircraftPartsAsync(&m_xplaneData);
+                if (!m_ownAircraftTelemetry)
+                {
+                    m_serviceProxy->getOwnAircraftLightsAsync(&m_xplaneData);
+                    m_serviceProxy->getOwnAircraftPartsAsync(&m_xplaneData);
+                }
 
                 CAircraftEngineList engines;
                 for (int engineNumber = 0; engineNumber < m_xplaneData.enginesN1Percentage.size(); ++engineNumber)
@@ -494,12 +580,16 @@ namespace BlackSimPlugin
             setSimulatorDetails("X-Plane", {}, xplaneVersion);
             connect(m_serviceProxy, &CXSwiftBusServiceProxy::aircraftModelChanged,   this, &CSimulatorXPlane::emitOwnAircraftModelChanged);
             connect(m_serviceProxy, &CXSwiftBusServiceProxy::airportsInRangeUpdated, this, &CSimulatorXPlane::setAirportsInRange);
+            connect(m_serviceProxy, &CXSwiftBusServiceProxy::ownAircraftTelemetry,   this, &CSimulatorXPlane::onOwnAircraftTelemetry);
             m_serviceProxy->updateAirportsInRange();
+            this->enableOwnAircraftTelemetry();
             connect(m_trafficProxy, &CXSwiftBusTrafficProxy::simFrame,                   this, &CSimulatorXPlane::updateRemoteAircraft);
             connect(m_trafficProxy, &CXSwiftBusTrafficProxy::remoteAircraftAdded,        this, &CSimulatorXPlane::onRemoteAircraftAdded);
+            connect(m_trafficProxy, &CXSwiftBusTrafficProxy::remoteAircraftAddedWithId,  this, &CSimulatorXPlane::onRemoteAircraftAddedWithId);
             connect(m_trafficProxy, &CXSwiftBusTrafficProxy::remoteAircraftAddingFailed, this, &CSimulatorXPlane::onRemoteAircraftAddingFailed);
             if (m_watcher) { m_watcher->setConnection(m_dBusConnection); }
             m_trafficProxy->removeAllPlanes();
+            this->openTrafficChannel();
 
             // send the settings
             this->sendXSwiftBusSettings();
@@ -518,6 +608,7 @@ namespace BlackSimPlugin
         {
             if (!this->isConnected()) { return true; } // avoid emit if already disconnected
             this->disconnectFromDBus();
+            this->closeTrafficChannel();
             if (m_watcher) { m_watcher->setConnection(m_dBusConnection); }
             delete m_serviceProxy;
             delete m_trafficProxy;
@@ -527,6 +618,7 @@ namespace BlackSimPlugin
             m_weatherProxy = nullptr;
             m_fastTimerCalls = 0;
             m_slowTimerCalls = 0;
+            m_ownAircraftTelemetry = false;
 
             this->emitSimulatorCombinedStatus();
             return true;
@@ -539,6 +631,7 @@ namespace BlackSimPlugin
 
             if (m_dbusMode == P2P) { m_dBusConnection.disconnectFromPeer(m_dBusConnection.name()); }
             m_dBusConnection = QDBusConnection { "default" };
+            this->closeTrafficChannel();
             if (m_watcher) { m_watcher->setConnection(m_dBusConnection); }
             delete m_serviceProxy;
             delete m_trafficProxy;
@@ -546,6 +639,7 @@ namespace BlackSimPlugin
             m_serviceProxy = nullptr;
             m_trafficProxy = nullptr;
             m_weatherProxy = nullptr;
+            m_ownAircraftTelemetry = false;
             this->emitSimulatorCombinedStatus();
         }
 
@@ -658,6 +752,7 @@ namespace BlackSimPlugin
                 m_serviceProxy->setTransponderMode(m_xplaneData.xpdrMode);
 
                 m_serviceProxy->cancelAllPendingAsyncCalls(); // in case there is already a reply with some old data incoming
+                m_cockpitUpdatedMs = QDateTime::currentMSecsSinceEpoch(); // same for telemetry
                 return true;
             }
             return false;
@@ -867,6 +962,7 @@ namespace BlackSimPlugin
             }
 
             m_trafficProxy->removePlane(callsign.asString());
+            m_trafficChannelIds.remove(callsign);
             m_xplaneAircraftObjects.remove(callsign);
             m_pendingToBeAddedAircraft.removeByCallsign(callsign);
 
@@ -879,6 +975,7 @@ namespace BlackSimPlugin
             if (this->isShuttingDownOrDisconnected()) { return 0; }
             m_pendingToBeAddedAircraft.clear();
             m_addingInProgressAircraft.clear();
+            m_trafficChannelIds.clear();
             return CSimulatorPluginCommon::physicallyRemoveAllRemoteAircraft();
         }
 
@@ -1016,10 +1113,22 @@ namespace BlackSimPlugin
             PlanesPositions planesPositions;
             PlanesSurfaces planesSurfaces;
             PlanesTransponders planesTransponders;
+            m_planesRecords.clear();
 
-            int aircraftNumber = 0;
             const bool updateAllAircraft = this->isUpdateAllRemoteAircraft(currentTimestamp);
             const CCallsignSet callsignsInRange = this->getAircraftInRangeCallsigns();
+
+            //! Result of one aircraft, written by the update tasks
+            struct UpdatedAircraft
+            {
+                const CXPlaneMPAircraft *aircraft = nullptr;
+                CInterpolationResult result;
+                bool sendSituation = false;
+                bool sendParts = false;
+            };
+
+            QVector<UpdatedAircraft> updatedAircraft;
+            updatedAircraft.reserve(remoteAircraftNo);
             for (const CXPlaneMPAircraft &xplaneAircraft : m_xplaneAircraftObjects)
             {
                 const CCallsign callsign(xplaneAircraft.getCallsign());
@@ -1034,26 +1143,70 @@ namespace BlackSimPlugin
                 // skip no longer in range
                 if (!callsignsInRange.contains(callsign)) { continue; }
 
-                planesTransponders.callsigns.push_back(callsign.asString());
-                planesTransponders.codes.push_back(xplaneAircraft.getAircraft().getTransponderCode());
-                CTransponder::TransponderMode transponderMode = xplaneAircraft.getAircraft().getTransponderMode();
-                planesTransponders.idents.push_back(transponderMode == CTransponder::StateIdent);
-                planesTransponders.modeCs.push_back(transponderMode == CTransponder::ModeC);
+                UpdatedAircraft updated;
+                updated.aircraft = &xplaneAircraft;
+                updatedAircraft.push_back(updated);
+            }
+
+            // interpolants of all aircraft first, evaluated in one pass
+            // the tasks only read shared data and write their own lane and result, so they can run in parallel
+            const int updatedAircraftNo = updatedAircraft.size();
+            m_interpolationBatch.resize(updatedAircraftNo);
+            this->runRemoteAircraftUpdateTasks(updatedAircraftNo, [&](int i)
+            {
+                const CXPlaneMPAircraft &xplaneAircraft = *updatedAircraft[i].aircraft;
+                const CInterpolationAndRenderingSetupPerCallsign setup = this->getInterpolationSetupConsolidated(xplaneAircraft.getCallsign(), updateAllAircraft);
+                xplaneAircraft.prepareBatchedInterpolation(currentTimestamp, setup, i, m_interpolationBatch, i);
+            });
+            m_interpolationBatch.evaluate();
+            this->runRemoteAircraftUpdateTasks(updatedAircraftNo, [&](int i)
+            {
+                UpdatedAircraft &updated = updatedAircraft[i];
+                updated.result = updated.aircraft->getBatchedInterpolation(m_interpolationBatch);
+                if (updated.result.getInterpolationStatus().hasValidSituation())
+                {
+                    updated.sendSituation = updateAllAircraft || !this->isEqualLastSent(CAircraftSituation(updated.result));
+                }
+                const CAircraftParts parts(updated.result);
+                if (updated.result.getPartsStatus().isSupportingParts() || parts.getPartsDetails() == CAircraftParts::GuessedParts)
+                {
+                    updated.sendParts = updateAllAircraft || !this->isEqualLastSent(parts, updated.aircraft->getCallsign());
+                }
+            });
+
+            // merge in the order of the aircraft
+            for (const UpdatedAircraft &updated : as_const(updatedAircraft))
+            {
+                const CXPlaneMPAircraft &xplaneAircraft = *updated.aircraft;
+                const CCallsign callsign(xplaneAircraft.getCallsign());
+                const CInterpolationResult &result = updated.result;
 
-                // setup
-                const CInterpolationAndRenderingSetupPerCallsign setup = this->getInterpolationSetupConsolidated(callsign, updateAllAircraft);
+                // planes known by id are updated through the traffic channel, all values in one record
+                const quint64 planeId = m_trafficChannel.isOpen() ? m_trafficChannelIds.value(callsign) : 0;
+                const CTransponder::TransponderMode transponderMode = xplaneAircraft.getAircraft().getTransponderMode();
+                if (planeId)
+                {
+                    m_planesRecords.push_back(planeId);
+                    m_planesRecords.setTransponder(xplaneAircraft.getAircraft().getTransponderCode(), transponderMode == CTransponder::ModeC, transponderMode == CTransponder::StateIdent);
+                }
+                else
+                {
+                    planesTransponders.callsigns.push_back(callsign.asString());
+                    planesTransponders.codes.push_back(xplaneAircraft.getAircraft().getTransponderCode());
+                    planesTransponders.idents.push_back(transponderMode == CTransponder::StateIdent);
+                    planesTransponders.modeCs.push_back(transponderMode == CTransponder::ModeC);
+                }
 
                 // interpolated situation/parts
-                const CInterpolationResult result = xplaneAircraft.getInterpolation(currentTimestamp, setup, aircraftNumber++);
                 if (result.getInterpolationStatus().hasValidSituation())
                 {
-                    const CAircraftSituation interpolatedSituation(result);
-
                     // update situation
-                    if (updateAllAircraft || !this->isEqualLastSent(interpolatedSituation))
+                    if (updated.sendSituation)
                     {
+                        const CAircraftSituation interpolatedSituation(result);
                         this->rememberLastSent(interpolatedSituation);
-                        planesPositions.push_back(interpolatedSituation);
+                        if (planeId) { m_planesRecords.setSituation(interpolatedSituation); }
+                        else { planesPositions.push_back(interpolatedSituation); }
                     }
                 }
                 else
@@ -1061,18 +1214,23 @@ namespace BlackSimPlugin
                     CLogMessage(this).warning(this->getInvalidSituationLogMessage(callsign, result.getInterpolationStatus()));
                 }
 
-                const CAircraftParts parts(result);
-                if (result.getPartsStatus().isSupportingParts() || parts.getPartsDetails() == CAircraftParts::GuessedParts)
+                if (updated.sendParts)
                 {
-                    if (updateAllAircraft || !this->isEqualLastSent(parts, callsign))
-                    {
-                        this->rememberLastSent(parts, callsign);
-                        planesSurfaces.push_back(xplaneAircraft.getCallsign(), parts);
-                    }
+                    const CAircraftParts parts(result);
+                    this->rememberLastSent(parts, callsign);
+                    if (planeId) { m_planesRecords.setParts(parts); }
+                    else { planesSurfaces.push_back(xplaneAircraft.getCallsign(), parts); }
                 }
 
             } // all callsigns
 
+            if (!m_planesRecords.isEmpty())
+            {
+                // one batch per update, if xswiftbus does not keep up everything is sent again with the next updates
+                const bool written = m_trafficChannel.write(m_planesRecords.records.data(), static_cast<std::uint32_t>(m_planesRecords.records.size()));
+                if (!written) { this->setUpdateAllRemoteAircraft(currentTimestamp); }
+            }
+
             if (!planesTransponders.isEmpty())
             {
                 m_trafficProxy->setPlanesTransponders(planesTransponders);
@@ -1207,6 +1365,7 @@ namespace BlackSimPlugin
             if (m_dBusConnection.isConnected())
             {
                 if (m_trafficProxy) { m_trafficProxy->cleanup(); }
+                if (m_serviceProxy && m_ownAircraftTelemetry) { m_serviceProxy->setOwnAircraftTelemetryInterval(0); }
 
                 if (m_dbusMode == P2P) { QDBusConnection::disconnectFromPeer(m_dBusConnection.name()); }
                 else { QDBusConnection::disconnectFromBus(m_dBusConnection.name()); }
@@ -1214,6 +1373,34 @@ namespace BlackSimPlugin
             m_dBusConnection = QDBusConnection { "default" };
         }
 
+        void CSimulatorXPlane::openTrafficChannel()
+        {
+            this->closeTrafficChannel();
+            if (!m_trafficProxy || !CTrafficChannel::isSupported()) { return; }
+
+            // xswiftbus can only open the channel if running on the same machine, otherwise DBus is used
+            const QString name = QStringLiteral("/swift-traffic-%1").arg(QCoreApplication::applicationPid());
+            if (!m_trafficChannel.create(name.toStdString()))
+            {
+                CLogMessage(this).warning(u"Cannot create traffic channel '%1', using DBus") << name;
+                return;
+            }
+            if (!m_trafficProxy->openTrafficChannel(name))
+            {
+                CLogMessage(this).info(u"xswiftbus cannot open traffic channel '%1', using DBus") << name;
+                m_trafficChannel.close();
+                return;
+            }
+            CLogMessage(this).info(u"Sending traffic through channel '%1'") << name;
+        }
+
+        void CSimulatorXPlane::closeTrafficChannel()
+        {
+            m_trafficChannel.close();
+            m_trafficChannelIds.clear();
+            m_planesRecords.clear();
+        }
+
         bool CSimulatorXPlane::sendXSwiftBusSettings()
         {
             if (this->isShuttingDownOrDisconnected()) { return false; }
@@ -1316,6 +1503,12 @@ namespace BlackSimPlugin
             emit this->aircraftRenderingChanged(addedRemoteAircraft);
         }
 
+        void CSimulatorXPlane::onRemoteAircraftAddedWithId(const QString &callsign, quint64 id)
+        {
+            if (callsign.isEmpty() || id == 0) { return; }
+            m_trafficChannelIds.insert(CCallsign(callsign), id);
+        }
+
         void CSimulatorXPlane::onRemoteAircraftAddingFailed(const QString &callsign)
         {
             BLACK_VERIFY_X(!callsign.isEmpty(), Q_FUNC_INFO, "Need callsign");
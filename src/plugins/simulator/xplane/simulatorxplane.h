@@ -12,13 +12,17 @@
 #define BLACKSIMPLUGIN_SIMULATOR_XPLANE_H
 
 #include "xplanempaircraft.h"
+#include "xswiftbustrafficproxy.h"
 #include "plugins/simulator/xplaneconfig/simulatorxplaneconfig.h"
 #include "plugins/simulator/plugincommon/simulatorplugincommon.h"
 #include "blackmisc/simulation/aircraftmodellist.h"
+#include "blackmisc/simulation/interpolationbatch.h"
 #include "blackmisc/simulation/data/modelcaches.h"
 #include "blackmisc/simulation/settings/simulatorsettings.h"
 #include "blackmisc/simulation/settings/xswiftbussettings.h"
 #include "blackmisc/simulation/simulatedaircraftlist.h"
+#include "blackmisc/simulation/xplane/owntelemetry.h"
+#include "blackmisc/simulation/xplane/trafficchannel.h"
 #include "blackmisc/weather/weathergrid.h"
 #include "blackmisc/aviation/airportlist.h"
 #include "blackmisc/aviation/callsignset.h"
@@ -187,6 +191,15 @@ namespace BlackSimPlugin
             void fastTimerTimeout();
             void slowTimerTimeout();
 
+            //! Update own situation and cockpit from the data received from xswiftbus
+            void updateOwnAircraftFromXPlaneData();
+
+            //! Own aircraft telemetry pushed by xswiftbus, replaces polling the own aircraft in the timers
+            //! @{
+            void enableOwnAircraftTelemetry();
+            void onOwnAircraftTelemetry(const QDoubleList &values, const QList<int> &integers);
+            //! @}
+
             void loadCslPackages();
             QString findCslPackage(const QString &modelFileName);
 
@@ -225,6 +238,7 @@ namespace BlackSimPlugin
             //! Callbacks from simulator
             //! @{
             void onRemoteAircraftAdded(const QString &callsign);
+            void onRemoteAircraftAddedWithId(const QString &callsign, quint64 id);
             void onRemoteAircraftAddingFailed(const QString &callsign);
             void updateRemoteAircraftFromSimulator(const QStringList &callsigns, const QDoubleList &latitudesDeg, const QDoubleList &longitudesDeg,
                                                    const QDoubleList &elevationsMeters, const QBoolList &waterFlags, const QDoubleList &verticalOffsetsMeters);
@@ -233,6 +247,12 @@ namespace BlackSimPlugin
             //! Disconnect from DBus
             void disconnectFromDBus();
 
+            //! Shared memory traffic channel, positions, surfaces and transponders are sent via DBus if not open
+            //! @{
+            void openTrafficChannel();
+            void closeTrafficChannel();
+            //! @}
+
             //! Send/receive settings
             //! @{
             bool sendXSwiftBusSettings();
@@ -256,6 +276,7 @@ namespace BlackSimPlugin
             DBusMode m_dbusMode;
             BlackMisc::CSetting<BlackMisc::Simulation::Settings::TXSwiftBusSettings> m_xSwiftBusServerSettings { this, &CSimulatorXPlane::onXSwiftBusSettingsChanged };
             static constexpr qint64 TimeoutAdding = 10000;
+            static constexpr qint64 CockpitUpdatePendingMs = 500; //!< cockpit values in telemetry are ignored after a cockpit update
             QDBusConnection m_dBusConnection     { "default" };
             QDBusServiceWatcher    *m_watcher      { nullptr };
             CXSwiftBusServiceProxy *m_serviceProxy { nullptr };
@@ -267,9 +288,16 @@ namespace BlackSimPlugin
             QTimer m_pendingAddedTimer;
             unsigned int m_fastTimerCalls = 0; //!< how often called
             unsigned int m_slowTimerCalls = 0; //!< how often called
+            bool m_ownAircraftTelemetry = false;         //!< own aircraft is pushed by xswiftbus, not polled
+            bool m_ownAircraftTelemetryReceived = false; //!< telemetry received since the last fast timer call
+            qint64 m_cockpitUpdatedMs = -1;              //!< last cockpit update sent to X-Plane
 
             BlackMisc::Aviation::CAirportList m_airportsInRange; //!< aiports in range of own aircraft
             CXPlaneMPAircraftObjects m_xplaneAircraftObjects;    //!< XPlane multiplayer aircraft
+            BlackMisc::Simulation::CInterpolationBatch m_interpolationBatch; //!< interpolants of all remote aircraft, reused in each update
+            BlackMisc::Simulation::XPlane::TrafficChannel::CTrafficChannel m_trafficChannel; //!< shared memory channel to xswiftbus
+            QHash<BlackMisc::Aviation::CCallsign, quint64> m_trafficChannelIds;               //!< xswiftbus plane ids keying the channel records
+            PlanesRecords m_planesRecords;                                                    //!< channel records, reused in each update
 
             BlackMisc::Simulation::CSimulatedAircraftList m_pendingToBeAddedAircraft;      //!< aircraft to be added
             QHash<BlackMisc::Aviation::CCallsign, qint64> m_addingInProgressAircraft;      //!< aircraft just adding
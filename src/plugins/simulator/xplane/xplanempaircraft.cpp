@@ -54,6 +54,18 @@ namespace BlackSimPlugin
             return m_interpolator->getInterpolation(currentTimeSinceEpoc, setup, aircraftNumber);
         }
 
+        bool CXPlaneMPAircraft::prepareBatchedInterpolation(qint64 currentTimeSinceEpoc, const CInterpolationAndRenderingSetupPerCallsign &setup, int aircraftNumber, CInterpolationBatch &batch, int lane) const
+        {
+            Q_ASSERT(m_interpolator);
+            return m_interpolator->prepareBatchedInterpolation(currentTimeSinceEpoc, setup, aircraftNumber, batch, lane);
+        }
+
+        CInterpolationResult CXPlaneMPAircraft::getBatchedInterpolation(const CInterpolationBatch &batch) const
+        {
+            Q_ASSERT(m_interpolator);
+            return m_interpolator->getBatchedInterpolation(batch);
+        }
+
         CStatusMessageList CXPlaneMPAircraft::getInterpolationMessages(CInterpolationAndRenderingSetupBase::InterpolatorMode mode) const
         {
             return this->getInterpolator() ? this->getInterpolator()->getInterpolationMessages(mode) : CStatusMessageList();
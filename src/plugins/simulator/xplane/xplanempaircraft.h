@@ -63,6 +63,12 @@ namespace BlackSimPlugin
             //! \copydoc BlackMisc::Simulation::CInterpolator::getInterpolation
             BlackMisc::Simulation::CInterpolationResult getInterpolation(qint64 currentTimeSinceEpoc, const BlackMisc::Simulation::CInterpolationAndRenderingSetupPerCallsign &setup, int aircraftNumber) const;
 
+            //! \copydoc BlackMisc::Simulation::CInterpolator::prepareBatchedInterpolation
+            bool prepareBatchedInterpolation(qint64 currentTimeSinceEpoc, const BlackMisc::Simulation::CInterpolationAndRenderingSetupPerCallsign &setup, int aircraftNumber, BlackMisc::Simulation::CInterpolationBatch &batch, int lane) const;
+
+            //! \copydoc BlackMisc::Simulation::CInterpolator::getBatchedInterpolation
+            BlackMisc::Simulation::CInterpolationResult getBatchedInterpolation(const BlackMisc::Simulation::CInterpolationBatch &batch) const;
+
             //! \copydoc BlackMisc::Simulation::CInterpolator::getInterpolationMessages
             BlackMisc::CStatusMessageList getInterpolationMessages(BlackMisc::Simulation::CInterpolationAndRenderingSetupBase::InterpolatorMode mode) const;
 
@@ -40,6 +40,11 @@ namespace BlackSimPlugin
                                        "sceneryLoaded", this,
                                        SIGNAL(sceneryLoaded()));
                 Q_ASSERT(s);
+
+                s = connection.connect(QString(), "/xswiftbus/service", "org.swift_project.xswiftbus.service",
+                                       "ownAircraftTelemetry", this,
+                                       SIGNAL(ownAircraftTelemetry(QList<double>, QList<int>)));
+                Q_ASSERT(s);
             }
         }
 
@@ -746,5 +751,10 @@ namespace BlackSimPlugin
         {
             m_dbusInterface->callDBus(QLatin1String("setSettingsJson"), json);
         }
+
+        bool CXSwiftBusServiceProxy::setOwnAircraftTelemetryInterval(int intervalMs)
+        {
+            return m_dbusInterface->callDBusRet<bool>(QLatin1String("setOwnAircraftTelemetryInterval"), intervalMs);
+        }
     } // ns
 } // ns
@@ -99,6 +99,10 @@ namespace BlackSimPlugin
             //! Scenery was loaded
             void sceneryLoaded();
 
+            //! Own aircraft telemetry, published if enabled by setOwnAircraftTelemetryInterval
+            //! \sa BlackMisc::Simulation::XPlane::OwnTelemetry for the layout of the values
+            void ownAircraftTelemetry(const QList<double> &values, const QList<int> &integers);
+
         public slots:
             //! Get XSwiftBus version number
             QString getVersionNumber();
@@ -461,6 +465,10 @@ namespace BlackSimPlugin
 
             //! \copydoc XSwiftBus::CSettingsProvider::setSettings
             void setSettingsJson(const QString &json);
+
+            //! \copydoc XSwiftBus::CService::setOwnAircraftTelemetryInterval
+            //! \return false if not supported by this xswiftbus version
+            bool setOwnAircraftTelemetryInterval(int intervalMs);
         };
     } // ns
 } // ns
@@ -44,6 +44,10 @@ namespace BlackSimPlugin
                                        "remoteAircraftAdded", this, SIGNAL(remoteAircraftAdded(QString)));
                 Q_ASSERT(s);
 
+                s = connection.connect(QString(), "/xswiftbus/traffic", "org.swift_project.xswiftbus.traffic",
+                                       "remoteAircraftAddedWithId", this, SIGNAL(remoteAircraftAddedWithId(QString, quint64)));
+                Q_ASSERT(s);
+
                 s = connection.connect(QString(), "/xswiftbus/traffic", "org.swift_project.xswiftbus.traffic",
                                        "remoteAircraftAddingFailed", this, SIGNAL(remoteAircraftAddingFailed(QString)));
                 Q_ASSERT(s);
@@ -194,6 +198,16 @@ namespace BlackSimPlugin
             // CLogMessage(this).debug(u"XPlane elv. request: '%1' %2 %3 %4") << callsign.asString() << latitudeDeg << longitudeDeg << altitudeMeters;
         }
 
+        bool CXSwiftBusTrafficProxy::openTrafficChannel(const QString &name)
+        {
+            return m_dbusInterface->callDBusRet<bool>(QLatin1String("openTrafficChannel"), name);
+        }
+
+        void CXSwiftBusTrafficProxy::closeTrafficChannel()
+        {
+            m_dbusInterface->callDBus(QLatin1String("closeTrafficChannel"));
+        }
+
         void CXSwiftBusTrafficProxy::setFollowedAircraft(const QString &callsign)
         {
             m_dbusInterface->callDBus(QLatin1String("setFollowedAircraft"), callsign);
@@ -17,10 +17,12 @@
 #include "blackmisc/aviation/callsign.h"
 #include "blackmisc/geo/elevationplane.h"
 #include "blackmisc/logcategorylist.h"
+#include "blackmisc/simulation/xplane/trafficchannel.h"
 
 #include <QObject>
 #include <QString>
 #include <QStringList>
+#include <vector>
 
 // clazy:excludeall=const-signal-or-slot
 
@@ -142,6 +144,78 @@ namespace BlackSimPlugin
             QList<bool> idents;     //!< List of active idents
         };
 
+        //! Planes positions, surfaces and transponders for the shared memory traffic channel, one record per plane
+        struct PlanesRecords
+        {
+            //! Record type
+            using Record = BlackMisc::Simulation::XPlane::TrafficChannel::Record;
+
+            //! Is empty?
+            bool isEmpty() const { return records.empty(); }
+
+            //! Clear, keeps the capacity
+            void clear() { records.clear(); }
+
+            //! Start the record of the next plane
+            void push_back(quint64 planeId)
+            {
+                records.emplace_back();
+                records.back().planeId = planeId;
+            }
+
+            //! Set the latest situation of the last plane
+            void setSituation(const BlackMisc::Aviation::CAircraftSituation &situation)
+            {
+                using namespace BlackMisc::Simulation::XPlane::TrafficChannel;
+                Record &r = records.back();
+                r.setFlag(HasPosition, true);
+                r.latitudeDeg  = situation.latitude().value(BlackMisc::PhysicalQuantities::CAngleUnit::deg());
+                r.longitudeDeg = situation.longitude().value(BlackMisc::PhysicalQuantities::CAngleUnit::deg());
+                r.altitudeFt   = situation.getAltitude().value(BlackMisc::PhysicalQuantities::CLengthUnit::ft());
+                r.pitchDeg     = static_cast<float>(situation.getPitch().value(BlackMisc::PhysicalQuantities::CAngleUnit::deg()));
+                r.rollDeg      = static_cast<float>(situation.getBank().value(BlackMisc::PhysicalQuantities::CAngleUnit::deg()));
+                r.headingDeg   = static_cast<float>(situation.getHeading().value(BlackMisc::PhysicalQuantities::CAngleUnit::deg()));
+                r.setFlag(OnGround, situation.getOnGround() == BlackMisc::Aviation::CAircraftSituation::OnGround);
+            }
+
+            //! Set the latest parts of the last plane, same values as PlanesSurfaces::push_back
+            void setParts(const BlackMisc::Aviation::CAircraftParts &parts)
+            {
+                using namespace BlackMisc::Simulation::XPlane::TrafficChannel;
+                Record &r = records.back();
+                r.setFlag(HasSurfaces, true);
+                r.gear        = parts.isFixedGearDown() ? 1.0f : 0.0f;
+                r.flaps       = static_cast<float>(parts.getFlapsPercent() / 100.0);
+                r.spoilers    = parts.isSpoilersOut() ? 1.0f : 0.0f;
+                r.speedBrakes = parts.isSpoilersOut() ? 1.0f : 0.0f;
+                r.slats       = static_cast<float>(parts.getFlapsPercent() / 100.0);
+                r.wingSweep   = 0.0f;
+                r.thrust      = parts.isAnyEngineOn() ? 0.75f : 0.0f;
+                r.elevator    = 0.0f;
+                r.rudder      = 0.0f;
+                r.aileron     = 0.0f;
+                r.setFlag(LandingLights, parts.getLights().isLandingOn());
+                r.setFlag(TaxiLights,    parts.getLights().isTaxiOn());
+                r.setFlag(BeaconLights,  parts.getLights().isBeaconOn());
+                r.setFlag(StrobeLights,  parts.getLights().isStrobeOn());
+                r.setFlag(NavLights,     parts.getLights().isNavOn());
+                r.lightPattern = 0;
+            }
+
+            //! Set the transponder of the last plane
+            void setTransponder(int code, bool modeC, bool ident)
+            {
+                using namespace BlackMisc::Simulation::XPlane::TrafficChannel;
+                Record &r = records.back();
+                r.setFlag(HasTransponder, true);
+                r.transponderCode = code;
+                r.setFlag(TransponderModeC, modeC);
+                r.setFlag(TransponderIdent, ident);
+            }
+
+            std::vector<Record> records; //!< one record per plane
+        };
+
         //! Multiplayer Acquire Info
         struct MultiplayerAcquireInfo
         {
@@ -194,6 +268,9 @@ namespace BlackSimPlugin
             //! Remote aircraft successfully added
             void remoteAircraftAdded(const QString &callsign);
 
+            //! Remote aircraft added, with the id used in the traffic channel
+            void remoteAircraftAddedWithId(const QString &callsign, quint64 id);
+
             //! Remote aircraft adding failed
             void remoteAircraftAddingFailed(const QString &callsign);
 
@@ -247,6 +324,12 @@ namespace BlackSimPlugin
             void getElevationAtPosition(const BlackMisc::Aviation::CCallsign &callsign, double latitudeDeg, double longitudeDeg, double altitudeMeters,
                                         const ElevationCallback &setter) const;
 
+            //! \copydoc XSwiftBus::CTraffic::openTrafficChannel
+            bool openTrafficChannel(const QString &name);
+
+            //! \copydoc XSwiftBus::CTraffic::closeTrafficChannel
+            void closeTrafficChannel();
+
             //! \copydoc XSwiftBus::CTraffic::setFollowedAircraft
             void setFollowedAircraft(const QString &callsign);
 
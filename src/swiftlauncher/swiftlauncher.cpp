@@ -145,8 +145,7 @@ void CSwiftLauncher::installerMode()
         for (const CSimulatorInfo &sim : CSimulatorInfo::allSimulatorsSet())
         {
             this->synchronizeCache(sim);
-            const int c = this->getCachedModelsCount(sim);
-            if (c > 0)
+            if (this->hasCachedModels(sim))
             {
                 // we already have data
                 runDialog = true;
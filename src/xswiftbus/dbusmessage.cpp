@@ -104,6 +104,12 @@ namespace XSwiftBus
         dbus_message_iter_append_basic(&m_messageIterator, DBUS_TYPE_INT32, &i);
     }
 
+    void CDBusMessage::appendArgument(std::uint64_t value)
+    {
+        dbus_uint64_t i = value;
+        dbus_message_iter_append_basic(&m_messageIterator, DBUS_TYPE_UINT64, &i);
+    }
+
     void CDBusMessage::appendArgument(double value)
     {
         dbus_message_iter_append_basic(&m_messageIterator, DBUS_TYPE_DOUBLE, &value);
@@ -127,6 +133,15 @@ namespace XSwiftBus
         dbus_message_iter_close_container(&m_messageIterator, &arrayIterator);
     }
 
+    void CDBusMessage::appendArgument(const std::vector<int> &array)
+    {
+        DBusMessageIter arrayIterator;
+        dbus_message_iter_open_container(&m_messageIterator, DBUS_TYPE_ARRAY, DBUS_TYPE_INT32_AS_STRING, &arrayIterator);
+        const int *ptr = array.data();
+        dbus_message_iter_append_fixed_array(&arrayIterator, DBUS_TYPE_INT32, &ptr, static_cast<int>(array.size()));
+        dbus_message_iter_close_container(&m_messageIterator, &arrayIterator);
+    }
+
     void CDBusMessage::appendArgument(const std::vector<double> &array)
     {
         DBusMessageIter arrayIterator;
@@ -10,6 +10,7 @@
 #define BLACKSIM_XSWIFTBUS_DBUSMESSAGE_H
 
 #include "dbus/dbus.h"
+#include <cstdint>
 #include <string>
 #include <vector>
 #if defined(_MSC_VER)
@@ -75,7 +76,9 @@ namespace XSwiftBus
         void appendArgument(const char *value);
         void appendArgument(const std::string &value);
         void appendArgument(int value);
+        void appendArgument(std::uint64_t value);
         void appendArgument(double value);
+        void appendArgument(const std::vector<int> &array);
         void appendArgument(const std::vector<bool> &array);
         void appendArgument(const std::vector<double> &array);
         void appendArgument(const std::vector<std::string> &array);
@@ -20,6 +20,7 @@
 
 // clazy:excludeall=reserve-candidates
 
+using namespace BlackMisc::Simulation::XPlane;
 using namespace BlackMisc::Simulation::XPlane::QtFreeUtils;
 
 namespace XSwiftBus
@@ -270,6 +271,69 @@ namespace XSwiftBus
         if (w) { INFO_LOG("Written new config file"); }
     }
 
+    void CService::setOwnAircraftTelemetryInterval(int intervalMs)
+    {
+        if (intervalMs > 0) { intervalMs = std::max(intervalMs, OwnTelemetry::MinIntervalMs); }
+        else { intervalMs = 0; }
+        m_telemetryInterval = std::chrono::milliseconds(intervalMs);
+        m_nextTelemetryTime = std::chrono::steady_clock::time_point();
+        m_hasLastTelemetry = false;
+        INFO_LOG("Own aircraft telemetry interval " + std::to_string(intervalMs) + "ms");
+    }
+
+    OwnTelemetry::Telemetry CService::sampleOwnAircraftTelemetry() const
+    {
+        OwnTelemetry::Telemetry telemetry;
+        telemetry.setValue(OwnTelemetry::LatitudeDeg, m_latitude.get());
+        telemetry.setValue(OwnTelemetry::LongitudeDeg, m_longitude.get());
+        telemetry.setValue(OwnTelemetry::AltitudeM, m_elevation.get());
+        telemetry.setValue(OwnTelemetry::GroundSpeedMs, m_groundSpeed.get());
+        telemetry.setValue(OwnTelemetry::PitchDeg, m_pitch.get());
+        telemetry.setValue(OwnTelemetry::RollDeg, m_roll.get());
+        telemetry.setValue(OwnTelemetry::TrueHeadingDeg, m_heading.get());
+        telemetry.setValue(OwnTelemetry::SeaLevelPressureInHg, m_qnhInhg.get());
+        telemetry.setValue(OwnTelemetry::Com1Volume, m_com1Volume.get());
+        telemetry.setValue(OwnTelemetry::Com2Volume, m_com2Volume.get());
+        telemetry.setValue(OwnTelemetry::FlapsDeployRatio, m_flapsReployRatio.get());
+        telemetry.setValue(OwnTelemetry::GearDeployRatio, m_gearReployRatio.getAt(0));
+        telemetry.setValue(OwnTelemetry::SpeedBrakeRatio, m_speedBrakeRatio.get());
+        telemetry.setEngineN1Percentages(getEngineN1Percentage());
+
+        telemetry.setInteger(OwnTelemetry::Com1ActiveKhz, m_com1Active.get());
+        telemetry.setInteger(OwnTelemetry::Com1StandbyKhz, m_com1Standby.get());
+        telemetry.setInteger(OwnTelemetry::Com2ActiveKhz, m_com2Active.get());
+        telemetry.setInteger(OwnTelemetry::Com2StandbyKhz, m_com2Standby.get());
+        telemetry.setInteger(OwnTelemetry::XpdrCode, m_xpdrCode.get());
+        telemetry.setInteger(OwnTelemetry::XpdrMode, m_xpdrMode.get());
+
+        telemetry.setFlag(OwnTelemetry::OnGroundAll, m_onGroundAll.get());
+        telemetry.setFlag(OwnTelemetry::Com1Receiving, this->isCom1Receiving());
+        telemetry.setFlag(OwnTelemetry::Com1Transmitting, this->isCom1Transmitting());
+        telemetry.setFlag(OwnTelemetry::Com2Receiving, this->isCom2Receiving());
+        telemetry.setFlag(OwnTelemetry::Com2Transmitting, this->isCom2Transmitting());
+        telemetry.setFlag(OwnTelemetry::XpdrIdent, m_xpdrIdent.get());
+        telemetry.setFlag(OwnTelemetry::BeaconLights, m_beaconLightsOn.get());
+        telemetry.setFlag(OwnTelemetry::LandingLights, m_landingLightsOn.get());
+        telemetry.setFlag(OwnTelemetry::NavLights, m_navLightsOn.get());
+        telemetry.setFlag(OwnTelemetry::StrobeLights, m_strobeLightsOn.get());
+        telemetry.setFlag(OwnTelemetry::TaxiLights, m_taxiLightsOn.get());
+        return telemetry;
+    }
+
+    void CService::publishOwnAircraftTelemetry()
+    {
+        if (m_telemetryInterval.count() < 1) { return; }
+        const auto now = std::chrono::steady_clock::now();
+        if (now < m_nextTelemetryTime) { return; }
+        m_nextTelemetryTime = now + m_telemetryInterval;
+
+        OwnTelemetry::Telemetry telemetry = sampleOwnAircraftTelemetry();
+        if (m_hasLastTelemetry && !telemetry.isSignificantlyDifferent(m_lastTelemetry)) { return; }
+        emitOwnAircraftTelemetry(telemetry);
+        m_lastTelemetry = std::move(telemetry);
+        m_hasLastTelemetry = true;
+    }
+
     void CService::readAirportsDatabase()
     {
         auto first = XPLMFindFirstNavAidOfType(xplm_Nav_Airport);
@@ -939,6 +1003,17 @@ namespace XSwiftBus
                     sendDBusReply(sender, serial, getSettingsJson());
                 });
             }
+            else if (message.getMethodName() == "setOwnAircraftTelemetryInterval")
+            {
+                int intervalMs = 0;
+                message.beginArgumentRead();
+                message.getArgument(intervalMs);
+                queueDBusCall([ = ]()
+                {
+                    setOwnAircraftTelemetryInterval(intervalMs);
+                    sendDBusReply(sender, serial, true);
+                });
+            }
             else if (message.getMethodName() == "setSettingsJson")
             {
                 maybeSendEmptyDBusReply(wantsReply, sender, serial);
@@ -969,6 +1044,9 @@ namespace XSwiftBus
 
         invokeQueuedDBusCalls();
 
+        // after the queued calls, so changes by the setters are published right away
+        publishOwnAircraftTelemetry();
+
         if (m_disappearMessageWindowTime != std::chrono::system_clock::time_point()
                 && std::chrono::system_clock::now() > m_disappearMessageWindowTime
                 && m_messages.isVisible())
@@ -1015,6 +1093,20 @@ namespace XSwiftBus
         sendDBusMessage(signal);
     }
 
+    void CService::emitOwnAircraftTelemetry(const OwnTelemetry::Telemetry &telemetry)
+    {
+        CDBusMessage signal = CDBusMessage::createSignal(XSWIFTBUS_SERVICE_OBJECTPATH, XSWIFTBUS_SERVICE_INTERFACENAME, "ownAircraftTelemetry");
+        signal.beginArgumentWrite();
+        signal.appendArgument(telemetry.values);
+        signal.appendArgument(telemetry.integers);
+        sendDBusMessage(signal);
+    }
+
+    void CService::dbusDisconnectedHandler()
+    {
+        setOwnAircraftTelemetryInterval(0);
+    }
+
     std::vector<CNavDataReference> CService::findClosestAirports(int number, double latitude, double longitude)
     {
         CNavDataReference ref(0, latitude, longitude);
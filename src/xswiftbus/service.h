@@ -19,6 +19,7 @@
 #include "datarefs.h"
 #include "messages.h"
 #include "navdatareference.h"
+#include "blackmisc/simulation/xplane/owntelemetry.h"
 #include <XPLM/XPLMNavigation.h>
 #include <string>
 #include <chrono>
@@ -297,12 +298,19 @@ namespace XSwiftBus
         //! Set settings
         void setSettingsJson(const std::string &jsonString);
 
+        //! Publish the own aircraft telemetry signal at most every intervalMs, only if the aircraft has changed
+        //! \remark 0 stops publishing, the first sample after enabling is always published
+        void setOwnAircraftTelemetryInterval(int intervalMs);
+
         //! Perform generic processing
         int process();
 
     protected:
         DBusHandlerResult dbusMessageHandler(const CDBusMessage &message) override;
 
+        //! Handler
+        virtual void dbusDisconnectedHandler() override;
+
     private:
         void emitAircraftModelChanged(const std::string &path, const std::string &filename, const std::string &livery,
                                       const std::string &icao, const std::string &modelString, const std::string &name,
@@ -313,6 +321,19 @@ namespace XSwiftBus
 
         void emitSceneryLoaded();
 
+        void emitOwnAircraftTelemetry(const BlackMisc::Simulation::XPlane::OwnTelemetry::Telemetry &telemetry);
+
+        //! Read all values of the own aircraft telemetry
+        BlackMisc::Simulation::XPlane::OwnTelemetry::Telemetry sampleOwnAircraftTelemetry() const;
+
+        //! Publish the own aircraft telemetry if due and changed
+        void publishOwnAircraftTelemetry();
+
+        std::chrono::milliseconds m_telemetryInterval { 0 }; //!< 0 means not publishing
+        std::chrono::steady_clock::time_point m_nextTelemetryTime;
+        BlackMisc::Simulation::XPlane::OwnTelemetry::Telemetry m_lastTelemetry;
+        bool m_hasLastTelemetry = false;
+
         CMessageBoxControl m_messages { 16, 16, 16 };
         bool m_popupMessageWindow     = true;
         bool m_disappearMessageWindow = true;
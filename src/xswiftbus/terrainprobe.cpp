@@ -11,12 +11,25 @@
 #include <XPLM/XPLMGraphics.h>
 #include <limits>
 #include <cmath>
+#include <utility>
 
 namespace XSwiftBus
 {
     CTerrainProbe::CTerrainProbe() : m_ref(XPLMCreateProbe(xplm_ProbeY)) {}
 
-    CTerrainProbe::~CTerrainProbe() { XPLMDestroyProbe(m_ref); }
+    CTerrainProbe::~CTerrainProbe() { if (m_ref) { XPLMDestroyProbe(m_ref); } }
+
+    CTerrainProbe::CTerrainProbe(CTerrainProbe &&other) noexcept : m_ref(other.m_ref), m_logMessageCount(other.m_logMessageCount)
+    {
+        other.m_ref = nullptr;
+    }
+
+    CTerrainProbe &CTerrainProbe::operator =(CTerrainProbe &&other) noexcept
+    {
+        std::swap(m_ref, other.m_ref);
+        std::swap(m_logMessageCount, other.m_logMessageCount);
+        return *this;
+    }
 
     std::array<double, 3> CTerrainProbe::getElevation(double degreesLatitude, double degreesLongitude, double metersAltitude, const std::string &callsign, bool &o_isWater) const
     {
@@ -56,4 +69,11 @@ namespace XSwiftBus
         o_isWater = probe.is_wet;
         return {{ metersAltitude, degreesLatitude, degreesLongitude }};
     }
+
+    BlackMisc::Simulation::XPlane::TerrainProbing::Result CTerrainProbe::probeTerrain(double latitudeDeg, double longitudeDeg, double altitudeM)
+    {
+        BlackMisc::Simulation::XPlane::TerrainProbing::Result result;
+        result.elevationM = getElevation(latitudeDeg, longitudeDeg, altitudeM, "probe queue", result.isWater).front();
+        return result;
+    }
 } // ns
@@ -9,6 +9,7 @@
 #ifndef BLACKSIM_XSWIFTBUS_ELEVATIONPROVIDER_H
 #define BLACKSIM_XSWIFTBUS_ELEVATIONPROVIDER_H
 
+#include "blackmisc/simulation/xplane/terrainprobequeue.h"
 #include <XPLM/XPLMScenery.h>
 #include <string>
 #include <array>
@@ -18,14 +19,14 @@ namespace XSwiftBus
     /*!
      * Class based interface to X-Plane SDK terrain probe.
      */
-    class CTerrainProbe
+    class CTerrainProbe : public BlackMisc::Simulation::XPlane::TerrainProbing::ITerrainProber
     {
     public:
         //! Constructor.
         CTerrainProbe();
 
         //! Destructor;
-        ~CTerrainProbe();
+        virtual ~CTerrainProbe() override;
 
         //! Not copyable.
         //! @{
@@ -33,11 +34,20 @@ namespace XSwiftBus
         CTerrainProbe &operator =(const CTerrainProbe &) = delete;
         //! @}
 
+        //! Movable, the probe is handed over.
+        //! @{
+        CTerrainProbe(CTerrainProbe &&other) noexcept;
+        CTerrainProbe &operator =(CTerrainProbe &&other) noexcept;
+        //! @}
+
         //! Get the elevation in meters at the given point in OpenGL space.
         //! \note Due to the Earth's curvature, the OpenGL vertical axis may not be exactly perpendicular to the surface of the geoid.
         //! \return NaN if no ground was detected.
         std::array<double, 3> getElevation(double degreesLatitude, double degreesLongitude, double metersAltitude, const std::string &callsign, bool &o_isWater) const;
 
+        //! \copydoc BlackMisc::Simulation::XPlane::TerrainProbing::ITerrainProber::probeTerrain
+        virtual BlackMisc::Simulation::XPlane::TerrainProbing::Result probeTerrain(double latitudeDeg, double longitudeDeg, double altitudeM) override;
+
     private:
         XPLMProbeRef m_ref = nullptr;
         mutable int m_logMessageCount = 0;
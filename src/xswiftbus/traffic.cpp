@@ -133,6 +133,7 @@ namespace XSwiftBus
 
     void CTraffic::cleanup()
     {
+        closeTrafficChannel();
         removeAllPlanes();
 
         if (m_enabledMultiplayer)
@@ -154,8 +155,15 @@ namespace XSwiftBus
         m_emitSimFrame = !m_emitSimFrame;
     }
 
-    void CTraffic::emitPlaneAdded(const std::string &callsign)
+    void CTraffic::emitPlaneAdded(const std::string &callsign, PlaneHandle handle)
     {
+        // the handle keys the records of the traffic channel
+        CDBusMessage signalPlaneId = CDBusMessage::createSignal(XSWIFTBUS_TRAFFIC_OBJECTPATH, XSWIFTBUS_TRAFFIC_INTERFACENAME, "remoteAircraftAddedWithId");
+        signalPlaneId.beginArgumentWrite();
+        signalPlaneId.appendArgument(callsign);
+        signalPlaneId.appendArgument(static_cast<std::uint64_t>(handle));
+        sendDBusMessage(signalPlaneId);
+
         CDBusMessage signalPlaneAdded = CDBusMessage::createSignal(XSWIFTBUS_TRAFFIC_OBJECTPATH, XSWIFTBUS_TRAFFIC_INTERFACENAME, "remoteAircraftAdded");
         signalPlaneAdded.beginArgumentWrite();
         signalPlaneAdded.appendArgument(callsign);
@@ -193,7 +201,7 @@ namespace XSwiftBus
 
     void CTraffic::followNextPlane()
     {
-        if (m_planesByCallsign.empty() || m_followPlaneViewCallsign.empty()) { return; }
+        if (m_planes.empty() || m_followPlaneViewCallsign.empty()) { return; }
         auto callsignIt = std::find(m_followPlaneViewSequence.begin(), m_followPlaneViewSequence.end(), m_followPlaneViewCallsign);
 
         // If we are not at the end, increase by one
@@ -206,7 +214,7 @@ namespace XSwiftBus
 
     void CTraffic::followPreviousPlane()
     {
-        if (m_planesByCallsign.empty() || m_followPlaneViewCallsign.empty()) { return; }
+        if (m_planes.empty() || m_followPlaneViewCallsign.empty()) { return; }
         auto callsignIt = std::find(m_followPlaneViewSequence.rbegin(), m_followPlaneViewSequence.rend(), m_followPlaneViewCallsign);
 
         // If we are not at the end, increase by one
@@ -221,9 +229,83 @@ namespace XSwiftBus
     {
         //! \fixme can be removed with C++20, as it then has a contains function
         if (callsign.empty()) { return false; }
-        const auto planeIt = m_planesByCallsign.find(callsign);
-        if (planeIt == m_planesByCallsign.end()) { return false; }
-        return true;
+        return m_planeHandlesByCallsign.find(callsign) != m_planeHandlesByCallsign.end();
+    }
+
+    CTraffic::Plane *CTraffic::findPlane(PlaneHandle handle)
+    {
+        const std::uint32_t slot = planeHandleSlot(handle);
+        if (slot >= m_planeSlots.size()) { return nullptr; }
+        const PlaneSlot &planeSlot = m_planeSlots[slot];
+        if (planeSlot.generation != planeHandleGeneration(handle) || planeSlot.index >= m_planes.size()) { return nullptr; }
+        Plane &plane = m_planes[planeSlot.index];
+        return plane.handle == handle ? &plane : nullptr;
+    }
+
+    const CTraffic::Plane *CTraffic::findPlane(PlaneHandle handle) const
+    {
+        return const_cast<CTraffic *>(this)->findPlane(handle);
+    }
+
+    const CTraffic::Plane *CTraffic::findPlane(const std::string &callsign) const
+    {
+        const auto handleIt = m_planeHandlesByCallsign.find(callsign);
+        if (handleIt == m_planeHandlesByCallsign.end()) { return nullptr; }
+        return findPlane(handleIt->second);
+    }
+
+    std::vector<CTraffic::PlaneHandle> CTraffic::findPlaneHandles(const std::vector<std::string> &callsigns) const
+    {
+        std::vector<PlaneHandle> handles;
+        handles.reserve(callsigns.size());
+        for (const std::string &callsign : callsigns)
+        {
+            const auto handleIt = m_planeHandlesByCallsign.find(callsign);
+            handles.push_back(handleIt == m_planeHandlesByCallsign.end() ? 0 : handleIt->second);
+        }
+        return handles;
+    }
+
+    CTraffic::PlaneHandle CTraffic::insertPlane(Plane &&plane)
+    {
+        std::uint32_t slot = 0;
+        if (m_freePlaneSlots.empty())
+        {
+            slot = static_cast<std::uint32_t>(m_planeSlots.size());
+            m_planeSlots.emplace_back();
+        }
+        else
+        {
+            slot = m_freePlaneSlots.back();
+            m_freePlaneSlots.pop_back();
+        }
+
+        PlaneSlot &planeSlot = m_planeSlots[slot];
+        planeSlot.index = static_cast<std::uint32_t>(m_planes.size());
+        plane.handle = makePlaneHandle(slot, planeSlot.generation);
+        m_planes.push_back(std::move(plane));
+        return m_planes.back().handle;
+    }
+
+    void CTraffic::erasePlane(PlaneHandle handle)
+    {
+        const Plane *plane = findPlane(handle);
+        if (!plane) { return; }
+
+        // keep the planes dense, the last plane moves into the gap
+        const std::uint32_t slot = planeHandleSlot(handle);
+        const std::uint32_t index = m_planeSlots[slot].index;
+        if (index + 1 != m_planes.size())
+        {
+            m_planes[index] = std::move(m_planes.back());
+            m_planeSlots[planeHandleSlot(m_planes[index].handle)].index = index;
+        }
+        m_planes.pop_back();
+
+        // outdate the handle, 0 is never a valid generation
+        PlaneSlot &planeSlot = m_planeSlots[slot];
+        if (++planeSlot.generation == 0) { planeSlot.generation = 1; }
+        m_freePlaneSlots.push_back(slot);
     }
 
     // changed T709
@@ -297,10 +379,10 @@ namespace XSwiftBus
         if (s.setMaxDrawDistanceNM(nauticalMiles)) { this->setSettings(s); }
     }
 
-    void CTraffic::addPlane(const std::string &callsign, const std::string &modelName, const std::string &aircraftIcao, const std::string &airlineIcao, const std::string &livery)
+    CTraffic::PlaneHandle CTraffic::addPlane(const std::string &callsign, const std::string &modelName, const std::string &aircraftIcao, const std::string &airlineIcao, const std::string &livery)
     {
-        auto planeIt = m_planesByCallsign.find(callsign);
-        if (planeIt != m_planesByCallsign.end()) { return; }
+        const auto handleIt = m_planeHandlesByCallsign.find(callsign);
+        if (handleIt != m_planeHandlesByCallsign.end()) { return handleIt->second; }
 
         XPMPPlaneID id = nullptr;
         if (modelName.empty() || m_modelStrings.count(modelName) == 0)
@@ -316,19 +398,19 @@ namespace XSwiftBus
         if (!id)
         {
             emitPlaneAddingFailed(callsign);
-            return;
+            return 0;
         }
 
-        Plane *plane = new Plane(id, callsign, aircraftIcao, airlineIcao, livery, modelName);
-        m_planesByCallsign[callsign] = plane;
-        m_planesById[id] = plane;
+        const PlaneHandle handle = insertPlane(Plane(id, callsign, aircraftIcao, airlineIcao, livery, modelName));
+        m_planeHandlesByCallsign[callsign] = handle;
 
         // Create view menu item
         CMenuItem planeViewMenuItem = m_followPlaneViewSubMenu.item(callsign, [this, callsign] { switchToFollowPlaneView(callsign); });
         m_followPlaneViewMenuItems[callsign] = planeViewMenuItem;
         m_followPlaneViewSequence.push_back(callsign);
 
-        emitPlaneAdded(callsign);
+        emitPlaneAdded(callsign, handle);
+        return handle;
     }
 
     void CTraffic::removePlane(const std::string &callsign)
@@ -340,27 +422,30 @@ namespace XSwiftBus
             m_followPlaneViewMenuItems.erase(menuItemIt);
         }
 
-        auto planeIt = m_planesByCallsign.find(callsign);
-        if (planeIt == m_planesByCallsign.end()) { return; }
+        const auto handleIt = m_planeHandlesByCallsign.find(callsign);
+        if (handleIt == m_planeHandlesByCallsign.end()) { return; }
 
         m_followPlaneViewSequence.erase(std::remove(m_followPlaneViewSequence.begin(), m_followPlaneViewSequence.end(), callsign),
                                         m_followPlaneViewSequence.end());
 
-        Plane *plane = planeIt->second;
-        m_planesByCallsign.erase(callsign);
-        m_planesById.erase(plane->id);
+        const PlaneHandle handle = handleIt->second;
+        m_planeHandlesByCallsign.erase(handleIt);
+        const Plane *plane = findPlane(handle);
+        assert(plane);
         XPMPDestroyPlane(plane->id);
-        delete plane;
+        erasePlane(handle);
     }
 
     void CTraffic::removeAllPlanes()
     {
-        for (const auto &kv : m_planesByCallsign)
+        for (const Plane &plane : m_planes)
         {
-            Plane *plane = kv.second;
-            assert(plane);
-            XPMPDestroyPlane(plane->id);
-            delete plane;
+            XPMPDestroyPlane(plane.id);
+
+            // outdate all handles
+            PlaneSlot &planeSlot = m_planeSlots[planeHandleSlot(plane.handle)];
+            if (++planeSlot.generation == 0) { planeSlot.generation = 1; }
+            m_freePlaneSlots.push_back(planeHandleSlot(plane.handle));
         }
 
         for (const auto &kv : m_followPlaneViewMenuItems)
@@ -369,157 +454,255 @@ namespace XSwiftBus
             m_followPlaneViewSubMenu.removeItem(item);
         }
 
-        m_planesByCallsign.clear();
-        m_planesById.clear();
+        m_planes.clear();
+        m_planeHandlesByCallsign.clear();
         m_followPlaneViewMenuItems.clear();
         m_followPlaneViewSequence.clear();
     }
 
-    void CTraffic::setPlanesPositions(const std::vector<std::string> &callsigns, std::vector<double> latitudesDeg, std::vector<double> longitudesDeg, std::vector<double> altitudesFt,
-                                      std::vector<double> pitchesDeg, std::vector<double> rollsDeg, std::vector<double> headingsDeg, const std::vector<bool> &onGrounds)
+    void CTraffic::setPlanesPositions(const std::vector<std::string> &callsigns, const std::vector<double> &latitudesDeg, const std::vector<double> &longitudesDeg, const std::vector<double> &altitudesFt,
+                                      const std::vector<double> &pitchesDeg, const std::vector<double> &rollsDeg, const std::vector<double> &headingsDeg, const std::vector<bool> &onGrounds)
     {
-        const bool setOnGround = onGrounds.size() == callsigns.size();
-        for (size_t i = 0; i < callsigns.size(); i++)
-        {
-            auto planeIt = m_planesByCallsign.find(callsigns.at(i));
-            if (planeIt == m_planesByCallsign.end()) { continue; }
+        setPlanesPositions(findPlaneHandles(callsigns), latitudesDeg, longitudesDeg, altitudesFt, pitchesDeg, rollsDeg, headingsDeg, onGrounds);
+    }
 
-            Plane *plane = planeIt->second;
+    void CTraffic::setPlanesPositions(const std::vector<PlaneHandle> &handles, const std::vector<double> &latitudesDeg, const std::vector<double> &longitudesDeg, const std::vector<double> &altitudesFt,
+                                      const std::vector<double> &pitchesDeg, const std::vector<double> &rollsDeg, const std::vector<double> &headingsDeg, const std::vector<bool> &onGrounds)
+    {
+        const bool setOnGround = onGrounds.size() == handles.size();
+        for (size_t i = 0; i < handles.size(); i++)
+        {
+            Plane *plane = findPlane(handles[i]);
             if (!plane) { continue; }
-            plane->positions[2].lat = latitudesDeg.at(i);
-            plane->positions[2].lon = longitudesDeg.at(i);
-            plane->positions[2].elevation = altitudesFt.at(i);
-            plane->positions[2].pitch   = static_cast<float>(pitchesDeg.at(i));
-            plane->positions[2].roll    = static_cast<float>(rollsDeg.at(i));
-            plane->positions[2].heading = static_cast<float>(headingsDeg.at(i));
-            plane->positions[2].offsetScale = 1.0f;
-            plane->positions[2].clampToGround = true;
-            plane->positionTimes[2] = std::chrono::steady_clock::now();
-
-            // save 2 positions at 1-second intervals for use in interpolation
-            if (plane->positionTimes[2] - plane->positionTimes[1] > 1s)
-            {
-                plane->positionTimes[0] = plane->positionTimes[1];
-                plane->positionTimes[1] = plane->positionTimes[2];
-                std::memcpy(&plane->positions[0], &plane->positions[1], sizeof(plane->positions[0]));
-                std::memcpy(&plane->positions[1], &plane->positions[2], sizeof(plane->positions[0]));
-            }
-
+            setPlanePosition(plane, latitudesDeg.at(i), longitudesDeg.at(i), altitudesFt.at(i), pitchesDeg.at(i), rollsDeg.at(i), headingsDeg.at(i));
             if (setOnGround) { plane->isOnGround = onGrounds.at(i); }
         }
     }
 
+    void CTraffic::setPlanePosition(Plane *plane, double latitudeDeg, double longitudeDeg, double altitudeFt, double pitchDeg, double rollDeg, double headingDeg)
+    {
+        plane->positions[2].lat = latitudeDeg;
+        plane->positions[2].lon = longitudeDeg;
+        plane->positions[2].elevation = altitudeFt;
+        plane->positions[2].pitch   = static_cast<float>(pitchDeg);
+        plane->positions[2].roll    = static_cast<float>(rollDeg);
+        plane->positions[2].heading = static_cast<float>(headingDeg);
+        plane->positions[2].offsetScale = 1.0f;
+        plane->positions[2].clampToGround = true;
+        plane->positionTimes[2] = std::chrono::steady_clock::now();
+
+        // save 2 positions at 1-second intervals for use in interpolation
+        if (plane->positionTimes[2] - plane->positionTimes[1] > 1s)
+        {
+            plane->positionTimes[0] = plane->positionTimes[1];
+            plane->positionTimes[1] = plane->positionTimes[2];
+            std::memcpy(&plane->positions[0], &plane->positions[1], sizeof(plane->positions[0]));
+            std::memcpy(&plane->positions[1], &plane->positions[2], sizeof(plane->positions[0]));
+        }
+    }
+
     void CTraffic::setPlanesSurfaces(const std::vector<std::string> &callsigns, const std::vector<double> &gears, const std::vector<double> &flaps, const std::vector<double> &spoilers,
                                      const std::vector<double> &speedBrakes, const std::vector<double> &slats, const std::vector<double> &wingSweeps, const std::vector<double> &thrusts,
                                      const std::vector<double> &elevators, const std::vector<double> &rudders, const std::vector<double> &ailerons,
                                      const std::vector<bool> &landLights, const std::vector<bool> &taxiLights,
                                      const std::vector<bool> &beaconLights, const std::vector<bool> &strobeLights, const std::vector<bool> &navLights, const std::vector<int> &lightPatterns)
+    {
+        setPlanesSurfaces(findPlaneHandles(callsigns), gears, flaps, spoilers, speedBrakes, slats, wingSweeps, thrusts, elevators, rudders, ailerons,
+                          landLights, taxiLights, beaconLights, strobeLights, navLights, lightPatterns);
+    }
+
+    void CTraffic::setPlanesSurfaces(const std::vector<PlaneHandle> &handles, const std::vector<double> &gears, const std::vector<double> &flaps, const std::vector<double> &spoilers,
+                                     const std::vector<double> &speedBrakes, const std::vector<double> &slats, const std::vector<double> &wingSweeps, const std::vector<double> &thrusts,
+                                     const std::vector<double> &elevators, const std::vector<double> &rudders, const std::vector<double> &ailerons,
+                                     const std::vector<bool> &landLights, const std::vector<bool> &taxiLights,
+                                     const std::vector<bool> &beaconLights, const std::vector<bool> &strobeLights, const std::vector<bool> &navLights, const std::vector<int> &lightPatterns)
     {
         const bool bundleTaxiLandingLights = this->getSettings().isBundlingTaxiAndLandingLights();
 
-        for (size_t i = 0; i < callsigns.size(); i++)
+        for (size_t i = 0; i < handles.size(); i++)
         {
-            auto planeIt = m_planesByCallsign.find(callsigns.at(i));
-            if (planeIt == m_planesByCallsign.end()) { continue; }
-
-            Plane *plane = planeIt->second;
+            Plane *plane = findPlane(handles[i]);
             if (!plane) { continue; }
+            setPlaneSurfaces(plane, bundleTaxiLandingLights, gears.at(i), flaps.at(i), spoilers.at(i), speedBrakes.at(i), slats.at(i), wingSweeps.at(i), thrusts.at(i),
+                             elevators.at(i), rudders.at(i), ailerons.at(i), landLights.at(i), taxiLights.at(i), beaconLights.at(i), strobeLights.at(i), navLights.at(i), lightPatterns.at(i));
+        }
+    }
 
-            plane->hasSurfaces = true;
-            plane->targetGearPosition = static_cast<float>(gears.at(i));
-            plane->surfaces.flapRatio = static_cast<float>(flaps.at(i));
-            plane->surfaces.spoilerRatio = static_cast<float>(spoilers.at(i));
-            plane->surfaces.speedBrakeRatio = static_cast<float>(speedBrakes.at(i));
-            plane->surfaces.slatRatio = static_cast<float>(slats.at(i));
-            plane->surfaces.wingSweep = static_cast<float>(wingSweeps.at(i));
-            plane->surfaces.thrust = static_cast<float>(thrusts.at(i));
-            plane->surfaces.yokePitch = static_cast<float>(elevators.at(i));
-            plane->surfaces.yokeHeading = static_cast<float>(rudders.at(i));
-            plane->surfaces.yokeRoll = static_cast<float>(ailerons.at(i));
-            if (bundleTaxiLandingLights)
-            {
-                const bool on = landLights.at(i) || taxiLights.at(i);
-                plane->surfaces.lights.landLights = on;
-                plane->surfaces.lights.taxiLights = on;
-            }
-            else
-            {
-                plane->surfaces.lights.landLights = landLights.at(i);
-                plane->surfaces.lights.taxiLights = taxiLights.at(i);
-            }
-            plane->surfaces.lights.bcnLights = beaconLights.at(i);
-            plane->surfaces.lights.strbLights = strobeLights.at(i);
-            plane->surfaces.lights.navLights = navLights.at(i);
-            plane->surfaces.lights.flashPattern = static_cast<unsigned int>(lightPatterns.at(i));
+    void CTraffic::setPlaneSurfaces(Plane *plane, bool bundleTaxiLandingLights, double gear, double flaps, double spoilers, double speedBrakes, double slats, double wingSweep, double thrust,
+                                    double elevator, double rudder, double aileron, bool landLights, bool taxiLights, bool beaconLights, bool strobeLights, bool navLights, int lightPattern)
+    {
+        plane->hasSurfaces = true;
+        plane->targetGearPosition = static_cast<float>(gear);
+        plane->surfaces.flapRatio = static_cast<float>(flaps);
+        plane->surfaces.spoilerRatio = static_cast<float>(spoilers);
+        plane->surfaces.speedBrakeRatio = static_cast<float>(speedBrakes);
+        plane->surfaces.slatRatio = static_cast<float>(slats);
+        plane->surfaces.wingSweep = static_cast<float>(wingSweep);
+        plane->surfaces.thrust = static_cast<float>(thrust);
+        plane->surfaces.yokePitch = static_cast<float>(elevator);
+        plane->surfaces.yokeHeading = static_cast<float>(rudder);
+        plane->surfaces.yokeRoll = static_cast<float>(aileron);
+        if (bundleTaxiLandingLights)
+        {
+            const bool on = landLights || taxiLights;
+            plane->surfaces.lights.landLights = on;
+            plane->surfaces.lights.taxiLights = on;
         }
+        else
+        {
+            plane->surfaces.lights.landLights = landLights;
+            plane->surfaces.lights.taxiLights = taxiLights;
+        }
+        plane->surfaces.lights.bcnLights = beaconLights;
+        plane->surfaces.lights.strbLights = strobeLights;
+        plane->surfaces.lights.navLights = navLights;
+        plane->surfaces.lights.flashPattern = static_cast<unsigned int>(lightPattern);
     }
 
     void CTraffic::setPlanesTransponders(const std::vector<std::string> &callsigns, const std::vector<int> &codes, const std::vector<bool> &modeCs, const std::vector<bool> &idents)
     {
-        for (size_t i = 0; i < callsigns.size(); i++)
-        {
-            auto planeIt = m_planesByCallsign.find(callsigns.at(i));
-            if (planeIt == m_planesByCallsign.end()) { continue; }
+        setPlanesTransponders(findPlaneHandles(callsigns), codes, modeCs, idents);
+    }
 
-            Plane *plane = planeIt->second;
+    void CTraffic::setPlanesTransponders(const std::vector<PlaneHandle> &handles, const std::vector<int> &codes, const std::vector<bool> &modeCs, const std::vector<bool> &idents)
+    {
+        for (size_t i = 0; i < handles.size(); i++)
+        {
+            Plane *plane = findPlane(handles[i]);
             if (!plane) { continue; }
-
-            plane->surveillance.code = codes.at(i);
-            if (idents.at(i)) { plane->surveillance.mode = xpmpTransponderMode_ModeC_Ident; }
-            else if (modeCs.at(i)) { plane->surveillance.mode = xpmpTransponderMode_ModeC; }
-            else { plane->surveillance.mode = xpmpTransponderMode_Standby; }
+            setPlaneTransponder(plane, codes.at(i), modeCs.at(i), idents.at(i));
         }
     }
 
-    void CTraffic::getRemoteAircraftData(std::vector<std::string> &callsigns, std::vector<double> &latitudesDeg, std::vector<double> &longitudesDeg,
-                                         std::vector<double> &elevationsM, std::vector<bool> &waterFlags, std::vector<double> &verticalOffsets) const
+    void CTraffic::setPlaneTransponder(Plane *plane, int code, bool modeC, bool ident)
     {
-        if (callsigns.empty() || m_planesByCallsign.empty()) { return; }
+        plane->surveillance.code = code;
+        if (ident) { plane->surveillance.mode = xpmpTransponderMode_ModeC_Ident; }
+        else if (modeC) { plane->surveillance.mode = xpmpTransponderMode_ModeC; }
+        else { plane->surveillance.mode = xpmpTransponderMode_Standby; }
+    }
 
-        const auto requestedCallsigns = callsigns;
-        callsigns.clear();
-        latitudesDeg.clear();
-        longitudesDeg.clear();
-        elevationsM.clear();
-        verticalOffsets.clear();
-        waterFlags.clear();
+    bool CTraffic::openTrafficChannel(const std::string &name)
+    {
+        const bool open = m_trafficChannel.open(name);
+        if (open) { INFO_LOG("Opened traffic channel " + name); }
+        else { WARNING_LOG("Cannot open traffic channel " + name + ", using DBus"); }
+        return open;
+    }
 
-        for (const auto &requestedCallsign : requestedCallsigns)
-        {
-            const auto planeIt = m_planesByCallsign.find(requestedCallsign);
-            if (planeIt == m_planesByCallsign.end()) { continue; }
+    void CTraffic::closeTrafficChannel()
+    {
+        m_trafficChannel.close();
+    }
+
+    void CTraffic::readTrafficChannel()
+    {
+        using namespace BlackMisc::Simulation::XPlane::TrafficChannel;
+        if (!m_trafficChannel.isOpen()) { return; }
 
-            const Plane *plane = planeIt->second;
-            assert(plane);
+        const bool bundleTaxiLandingLights = this->getSettings().isBundlingTaxiAndLandingLights();
+        m_trafficChannel.read([&](const Record &record)
+        {
+            Plane *plane = findPlane(static_cast<PlaneHandle>(record.planeId));
+            if (!plane) { return; }
 
-            const double latDeg = plane->positions[2].lat;
-            const double lonDeg = plane->positions[2].lon;
-            double groundElevation = 0.0;
-            bool isWater = false;
-            if (getSettings().isTerrainProbeEnabled())
+            if (record.hasFlag(HasPosition))
             {
-                // we expect elevation in meters
-                groundElevation = plane->terrainProbe.getElevation(latDeg, lonDeg, plane->positions[2].elevation, requestedCallsign, isWater).front();
-                if (std::isnan(groundElevation)) { groundElevation = 0.0; }
+                setPlanePosition(plane, record.latitudeDeg, record.longitudeDeg, record.altitudeFt, record.pitchDeg, record.rollDeg, record.headingDeg);
+                plane->isOnGround = record.hasFlag(OnGround);
             }
+            if (record.hasFlag(HasSurfaces))
+            {
+                setPlaneSurfaces(plane, bundleTaxiLandingLights, record.gear, record.flaps, record.spoilers, record.speedBrakes, record.slats, record.wingSweep, record.thrust,
+                                 record.elevator, record.rudder, record.aileron, record.hasFlag(LandingLights), record.hasFlag(TaxiLights),
+                                 record.hasFlag(BeaconLights), record.hasFlag(StrobeLights), record.hasFlag(NavLights), record.lightPattern);
+            }
+            if (record.hasFlag(HasTransponder))
+            {
+                setPlaneTransponder(plane, record.transponderCode, record.hasFlag(TransponderModeC), record.hasFlag(TransponderIdent));
+            }
+        });
+    }
+
+    void CTraffic::getRemoteAircraftData(const std::vector<std::string> &callsigns, const std::string &sender, dbus_uint32_t serial)
+    {
+        using namespace BlackMisc::Simulation::XPlane::TerrainProbing;
+
+        PendingRemoteAircraftData data;
+        data.sender = sender;
+        data.serial = serial;
+        std::vector<Point> points;
+        for (const auto &requestedCallsign : callsigns)
+        {
+            const Plane *plane = findPlane(requestedCallsign);
+            if (!plane) { continue; }
+
+            // we expect elevation in meters
+            Point point;
+            point.latitudeDeg  = plane->positions[2].lat;
+            point.longitudeDeg = plane->positions[2].lon;
+            point.altitudeM    = plane->positions[2].elevation;
+            points.push_back(point);
+
+            data.callsigns.push_back(requestedCallsign);
+            data.latitudesDeg.push_back(point.latitudeDeg);
+            data.longitudesDeg.push_back(point.longitudeDeg);
+        }
 
-            callsigns.push_back(requestedCallsign);
-            latitudesDeg.push_back(latDeg);
-            longitudesDeg.push_back(lonDeg);
-            elevationsM.push_back(groundElevation);
-            waterFlags.push_back(isWater);
+        if (points.empty() || !getSettings().isTerrainProbeEnabled())
+        {
+            sendRemoteAircraftData(data, std::vector<Result>(points.size()));
+            return;
+        }
+        const CTerrainProbeQueue::RequestId id = m_terrainProbeQueue.enqueue(points);
+        m_pendingRemoteAircraftData[id] = std::move(data);
+    }
+
+    void CTraffic::processTerrainProbes()
+    {
+        using namespace BlackMisc::Simulation::XPlane::TerrainProbing;
+        if (m_pendingRemoteAircraftData.empty()) { return; }
+
+        const std::chrono::microseconds budget(std::max(0, getSettings().getTerrainProbeBudgetUs()));
+        m_terrainProbeQueue.process(budget, [this](CTerrainProbeQueue::RequestId id, const std::vector<Result> &probes)
+        {
+            const auto it = m_pendingRemoteAircraftData.find(id);
+            if (it == m_pendingRemoteAircraftData.end()) { return; }
+            sendRemoteAircraftData(it->second, probes);
+            m_pendingRemoteAircraftData.erase(it);
+        });
+    }
+
+    void CTraffic::sendRemoteAircraftData(const PendingRemoteAircraftData &data, const std::vector<BlackMisc::Simulation::XPlane::TerrainProbing::Result> &probes)
+    {
+        std::vector<double> elevationsM;
+        std::vector<bool>   waterFlags;
+        std::vector<double> verticalOffsets;
+        for (const auto &probe : probes)
+        {
+            elevationsM.push_back(probe.isHit() ? probe.elevationM : 0.0);
+            waterFlags.push_back(probe.isWater);
             verticalOffsets.push_back(0); // xpmp2 adjusts the offset for us, so effectively always zero
         }
+
+        CDBusMessage reply = CDBusMessage::createReply(data.sender, data.serial);
+        reply.beginArgumentWrite();
+        reply.appendArgument(data.callsigns);
+        reply.appendArgument(data.latitudesDeg);
+        reply.appendArgument(data.longitudesDeg);
+        reply.appendArgument(elevationsM);
+        reply.appendArgument(waterFlags);
+        reply.appendArgument(verticalOffsets);
+        sendDBusMessage(reply);
     }
 
     std::array<double, 3> CTraffic::getElevationAtPosition(const std::string &callsign, double latitudeDeg, double longitudeDeg, double altitudeMeters, bool &o_isWater) const
     {
         if (!getSettings().isTerrainProbeEnabled()) { return {{ std::numeric_limits<double>::quiet_NaN(), latitudeDeg, longitudeDeg }}; }
 
-        const auto planeIt = m_planesByCallsign.find(callsign);
-        if (planeIt != m_planesByCallsign.end())
+        const Plane *plane = findPlane(callsign);
+        if (plane)
         {
-            const Plane *plane = planeIt->second;
             return plane->terrainProbe.getElevation(latitudeDeg, longitudeDeg, altitudeMeters, callsign, o_isWater);
         }
         else
@@ -535,6 +718,10 @@ namespace XSwiftBus
 
     void CTraffic::dbusDisconnectedHandler()
     {
+        closeTrafficChannel();
+        m_terrainProbeQueue.clear();
+        m_terrainProbeQueue.clearCache();
+        m_pendingRemoteAircraftData.clear();
         removeAllPlanes();
     }
 
@@ -761,22 +948,7 @@ namespace XSwiftBus
                 message.getArgument(requestedCallsigns);
                 queueDBusCall([ = ]()
                 {
-                    std::vector<std::string> callsigns = requestedCallsigns;
-                    std::vector<double> latitudesDeg;
-                    std::vector<double> longitudesDeg;
-                    std::vector<double> elevationsM;
-                    std::vector<bool>   waterFlags;
-                    std::vector<double> verticalOffsets;
-                    getRemoteAircraftData(callsigns, latitudesDeg, longitudesDeg, elevationsM, waterFlags, verticalOffsets);
-                    CDBusMessage reply = CDBusMessage::createReply(sender, serial);
-                    reply.beginArgumentWrite();
-                    reply.appendArgument(callsigns);
-                    reply.appendArgument(latitudesDeg);
-                    reply.appendArgument(longitudesDeg);
-                    reply.appendArgument(elevationsM);
-                    reply.appendArgument(waterFlags);
-                    reply.appendArgument(verticalOffsets);
-                    sendDBusMessage(reply);
+                    getRemoteAircraftData(requestedCallsigns, sender, serial);
                 });
             }
             else if (message.getMethodName() == "getElevationAtPosition")
@@ -804,6 +976,24 @@ namespace XSwiftBus
                     sendDBusMessage(reply);
                 });
             }
+            else if (message.getMethodName() == "openTrafficChannel")
+            {
+                std::string name;
+                message.beginArgumentRead();
+                message.getArgument(name);
+                queueDBusCall([ = ]()
+                {
+                    sendDBusReply(sender, serial, openTrafficChannel(name));
+                });
+            }
+            else if (message.getMethodName() == "closeTrafficChannel")
+            {
+                maybeSendEmptyDBusReply(wantsReply, sender, serial);
+                queueDBusCall([ = ]()
+                {
+                    closeTrafficChannel();
+                });
+            }
             else if (message.getMethodName() == "setFollowedAircraft")
             {
                 maybeSendEmptyDBusReply(wantsReply, sender, serial);
@@ -826,8 +1016,11 @@ namespace XSwiftBus
 
     int CTraffic::process()
     {
+        // records first, they may refer to planes removed by queued calls, outdated handles are skipped
+        readTrafficChannel();
         invokeQueuedDBusCalls();
         doPlaneUpdates();
+        processTerrainProbes();
         setDrawingLabels(getSettings().isDrawingLabels());
         emitSimFrame();
         m_countFrame++;
@@ -846,12 +1039,11 @@ namespace XSwiftBus
     void CTraffic::doPlaneUpdates()
     {
         m_updates.clear();
-        for (const auto pair : m_planesById)
+        for (Plane &plane : m_planes)
         {
-            Plane *plane = pair.second;
-            interpolatePosition(plane);
-            interpolateGear(plane);
-            m_updates.push_back({ plane->id, &plane->positions[3], &plane->surfaces, &plane->surveillance });
+            interpolatePosition(&plane);
+            interpolateGear(&plane);
+            m_updates.push_back({ plane.id, &plane.positions[3], &plane.surfaces, &plane.surveillance });
         }
         XPMPUpdatePlanes(m_updates.data(), sizeof(XPMPUpdate_t), m_updates.size());
 
@@ -909,10 +1101,10 @@ namespace XSwiftBus
         XPLMCameraPosition_t camPos {};
         XPLMReadCameraPosition(&camPos);
 
-        for (const auto pair : m_traffic->m_planesById)
+        for (const Plane &plane : m_traffic->m_planes)
         {
-            char *text = const_cast<char *>(pair.second->label);
-            const XPMPPlanePosition_t &planePos = pair.second->positions[3];
+            char *text = const_cast<char *>(plane.label);
+            const XPMPPlanePosition_t &planePos = plane.positions[3];
 
             double worldPos[4]{ 0, 0, 0, 1 };
             double localPos[4]{};
@@ -1048,7 +1240,7 @@ namespace XSwiftBus
         }
         else
         {
-            if (traffic->m_planesByCallsign.empty())
+            if (traffic->m_planes.empty())
             {
                 INFO_LOG("Follow aircraft, no planes to follow");
                 traffic->m_followPlaneViewCallsign.clear();
@@ -1063,19 +1255,10 @@ namespace XSwiftBus
                 return 0;
             }
 
-            const auto planeIt = traffic->m_planesByCallsign.find(traffic->m_followPlaneViewCallsign);
-            if (planeIt == traffic->m_planesByCallsign.end())
-            {
-                INFO_LOG("Follow aircraft, no plane found for callsign " + traffic->m_followPlaneViewCallsign);
-                traffic->m_followPlaneViewCallsign.clear();
-                traffic->m_followAircraftDistanceMultiplier = 1.0;
-                return 0;
-            }
-
-            const Plane *plane = planeIt->second;
+            const Plane *plane = traffic->findPlane(traffic->m_followPlaneViewCallsign);
             if (!plane)
             {
-                ERROR_LOG("Follow aircraft, no plane from iterator for callsign " + traffic->m_followPlaneViewCallsign);
+                INFO_LOG("Follow aircraft, no plane found for callsign " + traffic->m_followPlaneViewCallsign);
                 traffic->m_followPlaneViewCallsign.clear();
                 traffic->m_followAircraftDistanceMultiplier = 1.0;
                 return 0;
@@ -18,11 +18,15 @@
 #include "terrainprobe.h"
 #include "drawable.h"
 #include "menus.h"
+#include "blackmisc/simulation/xplane/terrainprobequeue.h"
+#include "blackmisc/simulation/xplane/trafficchannel.h"
 #include "XPMPMultiplayer.h"
 #include <XPLM/XPLMCamera.h>
 #include <XPLM/XPLMDisplay.h>
+#include <cstdint>
 #include <functional>
 #include <utility>
+#include <vector>
 
 //! \cond PRIVATE
 #define XSWIFTBUS_TRAFFIC_INTERFACENAME "org.swift_project.xswiftbus.traffic"
@@ -87,8 +91,12 @@ namespace XSwiftBus
         //! Set the maximum distance at which to draw aircraft (nautical miles).
         void setMaxDrawDistance(double nauticalMiles);
 
+        //! Stable handle of a traffic aircraft, valid until the aircraft is removed, 0 is never valid
+        using PlaneHandle = std::uint64_t;
+
         //! Introduce a new traffic aircraft
-        void addPlane(const std::string &callsign, const std::string &modelName, const std::string &aircraftIcao, const std::string &airlineIcao, const std::string &livery);
+        //! \return handle of the new or already existing aircraft, 0 if it could not be added
+        PlaneHandle addPlane(const std::string &callsign, const std::string &modelName, const std::string &aircraftIcao, const std::string &airlineIcao, const std::string &livery);
 
         //! Remove a traffic aircraft
         void removePlane(const std::string &callsign);
@@ -97,23 +105,48 @@ namespace XSwiftBus
         void removeAllPlanes();
 
         //! Set the position of multiple traffic aircrafts
-        void setPlanesPositions(const std::vector<std::string> &callsigns,
-                                std::vector<double> latitudesDeg, std::vector<double> longitudesDeg, std::vector<double> altitudesFt,
-                                std::vector<double> pitchesDeg, std::vector<double> rollsDeg, std::vector<double> headingsDeg, const std::vector<bool> &onGrounds);
+        //! \remark unknown or outdated handles are skipped
+        void setPlanesPositions(const std::vector<PlaneHandle> &handles,
+                                const std::vector<double> &latitudesDeg, const std::vector<double> &longitudesDeg, const std::vector<double> &altitudesFt,
+                                const std::vector<double> &pitchesDeg, const std::vector<double> &rollsDeg, const std::vector<double> &headingsDeg, const std::vector<bool> &onGrounds);
 
         //! Set the flight control surfaces and lights of multiple traffic aircrafts
-        void setPlanesSurfaces(const std::vector<std::string> &callsigns, const std::vector<double> &gears, const std::vector<double> &flaps, const std::vector<double> &spoilers,
+        //! \remark unknown or outdated handles are skipped
+        void setPlanesSurfaces(const std::vector<PlaneHandle> &handles, const std::vector<double> &gears, const std::vector<double> &flaps, const std::vector<double> &spoilers,
                                const std::vector<double> &speedBrakes, const std::vector<double> &slats, const std::vector<double> &wingSweeps, const std::vector<double> &thrusts,
                                const std::vector<double> &elevators, const std::vector<double> &rudders, const std::vector<double> &ailerons,
                                const std::vector<bool> &landLights, const std::vector<bool> &taxiLights,
                                const std::vector<bool> &beaconLights, const std::vector<bool> &strobeLights, const std::vector<bool> &navLights, const std::vector<int> &lightPatterns);
 
         //! Set the transponder of multiple traffic aircraft
+        //! \remark unknown or outdated handles are skipped
+        void setPlanesTransponders(const std::vector<PlaneHandle> &handles, const std::vector<int> &codes, const std::vector<bool> &modeCs, const std::vector<bool> &idents);
+
+        //! Bulk setters by callsign, as used by the DBus methods
+        //! \remark each callsign is looked up once and passed on by its handle
+        //! @{
+        void setPlanesPositions(const std::vector<std::string> &callsigns,
+                                const std::vector<double> &latitudesDeg, const std::vector<double> &longitudesDeg, const std::vector<double> &altitudesFt,
+                                const std::vector<double> &pitchesDeg, const std::vector<double> &rollsDeg, const std::vector<double> &headingsDeg, const std::vector<bool> &onGrounds);
+        void setPlanesSurfaces(const std::vector<std::string> &callsigns, const std::vector<double> &gears, const std::vector<double> &flaps, const std::vector<double> &spoilers,
+                               const std::vector<double> &speedBrakes, const std::vector<double> &slats, const std::vector<double> &wingSweeps, const std::vector<double> &thrusts,
+                               const std::vector<double> &elevators, const std::vector<double> &rudders, const std::vector<double> &ailerons,
+                               const std::vector<bool> &landLights, const std::vector<bool> &taxiLights,
+                               const std::vector<bool> &beaconLights, const std::vector<bool> &strobeLights, const std::vector<bool> &navLights, const std::vector<int> &lightPatterns);
         void setPlanesTransponders(const std::vector<std::string> &callsigns, const std::vector<int> &codes, const std::vector<bool> &modeCs, const std::vector<bool> &idents);
+        //! @}
+
+        //! Open the shared memory traffic channel created by the driver
+        //! \remark positions, surfaces and transponders are then also read from the channel once per frame
+        bool openTrafficChannel(const std::string &name);
+
+        //! Close the shared memory traffic channel
+        void closeTrafficChannel();
 
         //! Get remote aircrafts data (lat, lon, elevation and CG)
-        void getRemoteAircraftData(std::vector<std::string> &callsigns, std::vector<double> &latitudesDeg, std::vector<double> &longitudesDeg,
-                                   std::vector<double> &elevationsM, std::vector<bool> &waterFlags, std::vector<double> &verticalOffsets) const;
+        //! \remark the ground elevations are probed in the background under a per frame budget,
+        //!         the reply is sent to the sender once all of them are known
+        void getRemoteAircraftData(const std::vector<std::string> &callsigns, const std::string &sender, dbus_uint32_t serial);
 
         //! Get the ground elevation at an arbitrary position
         std::array<double, 3> getElevationAtPosition(const std::string &callsign, double latitudeDeg, double longitudeDeg, double altitudeMeters, bool &o_isWater) const;
@@ -150,8 +183,23 @@ namespace XSwiftBus
         bool m_enabledMultiplayer = false;
         CTerrainProbe m_terrainProbe;
 
+        //! Remote aircraft data waiting for its terrain probes
+        struct PendingRemoteAircraftData
+        {
+            std::string sender;
+            dbus_uint32_t serial = 0;
+            std::vector<std::string> callsigns;
+            std::vector<double> latitudesDeg;
+            std::vector<double> longitudesDeg;
+        };
+
+        BlackMisc::Simulation::XPlane::TerrainProbing::CTerrainProbeQueue m_terrainProbeQueue { &m_terrainProbe };
+        std::unordered_map<BlackMisc::Simulation::XPlane::TerrainProbing::CTerrainProbeQueue::RequestId, PendingRemoteAircraftData> m_pendingRemoteAircraftData;
+        void processTerrainProbes();
+        void sendRemoteAircraftData(const PendingRemoteAircraftData &data, const std::vector<BlackMisc::Simulation::XPlane::TerrainProbing::Result> &probes);
+
         void emitSimFrame();
-        void emitPlaneAdded(const std::string &callsign);
+        void emitPlaneAdded(const std::string &callsign, PlaneHandle handle);
         void emitPlaneAddingFailed(const std::string &callsign);
         void switchToFollowPlaneView(const std::string &callsign);
         void followNextPlane();
@@ -169,6 +217,7 @@ namespace XSwiftBus
         struct Plane
         {
             void *id = nullptr;
+            PlaneHandle handle = 0;
             std::string callsign;
             std::string aircraftIcao;
             std::string airlineIcao;
@@ -189,6 +238,13 @@ namespace XSwiftBus
                   const std::string &livery_, const std::string &modelName_);
         };
 
+        //! Slot of a plane handle
+        struct PlaneSlot
+        {
+            std::uint32_t index = 0;      //!< position in m_planes while in use
+            std::uint32_t generation = 1; //!< increased whenever the plane of the slot is removed, part of the handle
+        };
+
         //! Label renderer
         class Labels : public CDrawable
         {
@@ -238,8 +294,33 @@ namespace XSwiftBus
         //! @}
 
         std::unordered_map<std::string, std::string> m_modelStrings; // mapping uppercase to mixedcase
-        std::unordered_map<std::string, Plane *> m_planesByCallsign;
-        std::unordered_map<void *, Plane *> m_planesById;
+        std::vector<Plane> m_planes;                 //!< all planes, dense, so the per frame updates are a linear pass
+        std::vector<PlaneSlot> m_planeSlots;         //!< handle slot to position in m_planes
+        std::vector<std::uint32_t> m_freePlaneSlots; //!< slots available for reuse
+        std::unordered_map<std::string, PlaneHandle> m_planeHandlesByCallsign; //!< for the callsign based methods
+
+        //! Plane of a handle or callsign, nullptr if not existing
+        //! @{
+        Plane *findPlane(PlaneHandle handle);
+        const Plane *findPlane(PlaneHandle handle) const;
+        const Plane *findPlane(const std::string &callsign) const;
+        //! @}
+
+        //! Handles of the callsigns, 0 for unknown callsigns
+        std::vector<PlaneHandle> findPlaneHandles(const std::vector<std::string> &callsigns) const;
+
+        //! Store a plane and assign its handle
+        PlaneHandle insertPlane(Plane &&plane);
+
+        //! Remove the plane of the handle from the store, outdates the handle
+        void erasePlane(PlaneHandle handle);
+
+        //! Handle parts
+        //! @{
+        static PlaneHandle makePlaneHandle(std::uint32_t slot, std::uint32_t generation) { return (static_cast<PlaneHandle>(generation) << 32) | slot; }
+        static std::uint32_t planeHandleSlot(PlaneHandle handle) { return static_cast<std::uint32_t>(handle & 0xffffffffu); }
+        static std::uint32_t planeHandleGeneration(PlaneHandle handle) { return static_cast<std::uint32_t>(handle >> 32); }
+        //! @}
         std::vector<std::string> m_followPlaneViewSequence;
         // std::chrono::system_clock::time_point m_timestampLastSimFrame = std::chrono::system_clock::now();
 
@@ -262,6 +343,17 @@ namespace XSwiftBus
         bool m_emitSimFrame = true;
         int m_countFrame    = 0; //!< allows to do something every n-th frame
 
+        BlackMisc::Simulation::XPlane::TrafficChannel::CTrafficChannel m_trafficChannel; //!< plane updates from the driver, DBus for control messages only
+        void readTrafficChannel();
+
+        //! Set the values of one plane, shared by the DBus setters and the traffic channel
+        //! @{
+        static void setPlanePosition(Plane *plane, double latitudeDeg, double longitudeDeg, double altitudeFt, double pitchDeg, double rollDeg, double headingDeg);
+        static void setPlaneSurfaces(Plane *plane, bool bundleTaxiLandingLights, double gear, double flaps, double spoilers, double speedBrakes, double slats, double wingSweep, double thrust,
+                                     double elevator, double rudder, double aileron, bool landLights, bool taxiLights, bool beaconLights, bool strobeLights, bool navLights, int lightPattern);
+        static void setPlaneTransponder(Plane *plane, int code, bool modeC, bool ident);
+        //! @}
+
         std::vector<XPMPUpdate_t> m_updates;
         void doPlaneUpdates();
         void interpolatePosition(Plane *);
@@ -2,6 +2,9 @@
 
 XSWIFTBUS_DEPENDENTS = $$SourceRoot/src/xswiftbus \
     $$SourceRoot/src/blackmisc/simulation/xplane/qtfreeutils.* \
+    $$SourceRoot/src/blackmisc/simulation/xplane/owntelemetry.h \
+    $$SourceRoot/src/blackmisc/simulation/xplane/terrainprobequeue.h \
+    $$SourceRoot/src/blackmisc/simulation/xplane/trafficchannel.h \
     $$SourceRoot/src/blackmisc/simulation/settings/xswiftbussettingsqtfree.*
 
 XSWIFTBUS_COMMIT = $$system(git log -n 1 --format=%h -- $$XSWIFTBUS_DEPENDENTS)
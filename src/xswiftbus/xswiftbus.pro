@@ -27,6 +27,8 @@ else:macx {
 else:unix {
     # Flags needed because there is no XPLM link library
     QMAKE_LFLAGS += -shared -rdynamic -nodefaultlibs -undefined_warning -Wl,--version-script=$$PWD/xswiftbus.map
+    # shm_open for the traffic channel
+    LIBS += -lrt
 }
 
 DEPENDPATH += . $$SourceRoot/src
@@ -0,0 +1,226 @@
+/* Copyright (C) 2020
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \cond PRIVATE_TESTS
+//! \file
+//! \ingroup testblackcore
+
+#include "blackcore/afv/crypto/cryptodtoserializer.h"
+#include "blackcore/afv/dto.h"
+#include "test.h"
+
+#include <QObject>
+#include <QTest>
+
+using namespace BlackCore::Afv;
+using namespace BlackCore::Afv::Crypto;
+
+namespace BlackCoreTest
+{
+    //! AFV crypto DTO serializer tests
+    class CTestCryptoDtoSerializer : public QObject
+    {
+        Q_OBJECT
+
+    private slots:
+        //! Serialized and deserialized DTO
+        void roundTrip();
+
+        //! Packet layout and encryption as before, one combined AEAD call
+        void wireFormat();
+
+        //! Modified, truncated and foreign packets are rejected
+        void rejectedPackets();
+
+        //! The packet buffer is reused
+        void reusedBuffer();
+
+        //! Serializing one voice packet
+        void benchmarkSerialize();
+
+        //! Deserializing one voice packet
+        void benchmarkDeserialize();
+
+    private:
+        //! Voice packet as sent every 20ms
+        static AudioTxOnTransceiversDto voiceDto(uint sequence);
+
+        //! Channel with the same transmit and receive key
+        static CCryptoDtoChannel channel();
+    };
+
+    void CTestCryptoDtoSerializer::roundTrip()
+    {
+        CCryptoDtoChannel sender = channel();
+        CCryptoDtoChannel receiver = channel();
+
+        for (uint sequence = 0; sequence < 3; sequence++)
+        {
+            QByteArray packet = CryptoDtoSerializer::serialize(sender, CryptoDtoMode::AEAD_ChaCha20Poly1305, voiceDto(sequence));
+            QVERIFY(!packet.isEmpty());
+
+            const CryptoDtoSerializer::Deserializer deserializer = CryptoDtoSerializer::deserialize(receiver, packet, false);
+            QVERIFY(deserializer.m_verified);
+            QCOMPARE(deserializer.m_header.Sequence, static_cast<uint64_t>(sequence));
+            QCOMPARE(deserializer.m_header.ChannelTag, std::string("test"));
+            QCOMPARE(deserializer.m_dtoNameBuffer, AudioTxOnTransceiversDto::getShortDtoName());
+
+            CryptoDtoSerializer::Deserializer copy = deserializer;
+            const AudioTxOnTransceiversDto dto = copy.getDto<AudioTxOnTransceiversDto>();
+            const AudioTxOnTransceiversDto expected = voiceDto(sequence);
+            QCOMPARE(dto.callsign, expected.callsign);
+            QCOMPARE(dto.sequenceCounter, expected.sequenceCounter);
+            QVERIFY(dto.audio == expected.audio);
+            QCOMPARE(dto.lastPacket, expected.lastPacket);
+            QCOMPARE(dto.transceivers.size(), expected.transceivers.size());
+            QCOMPARE(dto.transceivers.front().id, expected.transceivers.front().id);
+
+            // other DTO type
+            QCOMPARE(copy.getDto<HeartbeatDto>().callsign, std::string());
+        }
+    }
+
+    void CTestCryptoDtoSerializer::wireFormat()
+    {
+        CCryptoDtoChannel sender = channel();
+        const AudioTxOnTransceiversDto dto = voiceDto(7);
+        const QByteArray packet = CryptoDtoSerializer::serialize(sender, CryptoDtoMode::AEAD_ChaCha20Poly1305, dto);
+
+        quint16 headerLength = 0;
+        std::memcpy(&headerLength, packet.constData(), sizeof(headerLength));
+        const int adLength = 2 + headerLength;
+        msgpack::object_handle header = msgpack::unpack(packet.constData() + 2, headerLength);
+        QCOMPARE(header.get().as<CryptoDtoHeaderDto>().Sequence, static_cast<uint64_t>(0));
+
+        // decrypted as the payload and MAC in one piece
+        unsigned char nonce[crypto_aead_chacha20poly1305_IETF_NPUBBYTES] = {};
+        QByteArray decrypted(packet.size(), 0);
+        unsigned long long decryptedLength = 0;
+        const QByteArray key = channel().getReceiveKey(CryptoDtoMode::AEAD_ChaCha20Poly1305);
+        const int result = crypto_aead_chacha20poly1305_ietf_decrypt(reinterpret_cast<unsigned char *>(decrypted.data()), &decryptedLength, nullptr,
+                           reinterpret_cast<const unsigned char *>(packet.constData() + adLength), static_cast<unsigned long long>(packet.size() - adLength),
+                           reinterpret_cast<const unsigned char *>(packet.constData()), static_cast<unsigned long long>(adLength),
+                           nonce, reinterpret_cast<const unsigned char *>(key.constData()));
+        QCOMPARE(result, 0);
+        decrypted.resize(static_cast<int>(decryptedLength));
+
+        msgpack::sbuffer dtoBuffer;
+        msgpack::pack(dtoBuffer, dto);
+        const quint16 nameLength = 2;
+        const quint16 dtoLength = static_cast<quint16>(dtoBuffer.size());
+        QByteArray expected;
+        expected.append(reinterpret_cast<const char *>(&nameLength), sizeof(nameLength));
+        expected.append(AudioTxOnTransceiversDto::getShortDtoName());
+        expected.append(reinterpret_cast<const char *>(&dtoLength), sizeof(dtoLength));
+        expected.append(dtoBuffer.data(), static_cast<int>(dtoBuffer.size()));
+        QCOMPARE(decrypted, expected);
+    }
+
+    void CTestCryptoDtoSerializer::rejectedPackets()
+    {
+        CCryptoDtoChannel sender = channel();
+        CCryptoDtoChannel receiver = channel();
+        const QByteArray packet = CryptoDtoSerializer::serialize(sender, CryptoDtoMode::AEAD_ChaCha20Poly1305, voiceDto(1));
+
+        QByteArray modifiedPayload = packet;
+        modifiedPayload[packet.size() - 20] = static_cast<char>(modifiedPayload.at(packet.size() - 20) ^ 0x01);
+        QVERIFY(!CryptoDtoSerializer::deserialize(receiver, modifiedPayload, false).m_verified);
+
+        QByteArray modifiedMac = packet;
+        modifiedMac[packet.size() - 1] = static_cast<char>(modifiedMac.at(packet.size() - 1) ^ 0x01);
+        QVERIFY(!CryptoDtoSerializer::deserialize(receiver, modifiedMac, false).m_verified);
+
+        for (int size : { 0, 1, 2, 20, packet.size() - 1 })
+        {
+            QByteArray truncated = packet.left(size);
+            QVERIFY(!CryptoDtoSerializer::deserialize(receiver, truncated, false).m_verified);
+        }
+
+        CCryptoDtoChannel foreign("test", QByteArray(32, 'x'), QByteArray(32, 'x'));
+        QByteArray foreignPacket = packet;
+        QVERIFY(!CryptoDtoSerializer::deserialize(foreign, foreignPacket, false).m_verified);
+
+        // no key, not encrypted
+        CCryptoDtoChannel noKey("test", QByteArray(), QByteArray());
+        QByteArray noKeyPacket;
+        QVERIFY(!CryptoDtoSerializer::serialize(noKeyPacket, noKey, CryptoDtoMode::AEAD_ChaCha20Poly1305, voiceDto(1)));
+        QVERIFY(noKeyPacket.isEmpty());
+    }
+
+    void CTestCryptoDtoSerializer::reusedBuffer()
+    {
+        CCryptoDtoChannel sender = channel();
+        QByteArray packet;
+        packet.reserve(CryptoDtoSerializer::MaxPacketSize);
+        const char *data = packet.constData();
+        for (uint sequence = 0; sequence < 10; sequence++)
+        {
+            QVERIFY(CryptoDtoSerializer::serialize(packet, sender, CryptoDtoMode::AEAD_ChaCha20Poly1305, voiceDto(sequence)));
+            QCOMPARE(packet.constData(), data);
+        }
+    }
+
+    void CTestCryptoDtoSerializer::benchmarkSerialize()
+    {
+        CCryptoDtoChannel sender = channel();
+        const AudioTxOnTransceiversDto dto = voiceDto(1);
+        QByteArray packet;
+        packet.reserve(CryptoDtoSerializer::MaxPacketSize);
+
+        bool serialized = false;
+        QBENCHMARK { serialized = CryptoDtoSerializer::serialize(packet, sender, CryptoDtoMode::AEAD_ChaCha20Poly1305, dto); }
+        QVERIFY(serialized);
+        CCryptoDtoChannel receiver = channel();
+        QVERIFY(CryptoDtoSerializer::deserialize(receiver, packet, false).m_verified);
+    }
+
+    void CTestCryptoDtoSerializer::benchmarkDeserialize()
+    {
+        CCryptoDtoChannel sender = channel();
+        CCryptoDtoChannel receiver = channel();
+        const AudioTxOnTransceiversDto dto = voiceDto(1);
+        const QByteArray sent = CryptoDtoSerializer::serialize(sender, CryptoDtoMode::AEAD_ChaCha20Poly1305, dto);
+        QByteArray received;
+        received.reserve(CryptoDtoSerializer::MaxPacketSize);
+
+        bool verified = false;
+        QBENCHMARK
+        {
+            // a received datagram, copied into the reused buffer as from the socket
+            received.resize(sent.size());
+            std::memcpy(received.data(), sent.constData(), static_cast<size_t>(sent.size()));
+            CryptoDtoSerializer::Deserializer deserializer = CryptoDtoSerializer::deserialize(receiver, received, false);
+            verified = deserializer.m_verified && deserializer.getDto<AudioTxOnTransceiversDto>().audio.size() == dto.audio.size();
+        }
+        QVERIFY(verified);
+    }
+
+    AudioTxOnTransceiversDto CTestCryptoDtoSerializer::voiceDto(uint sequence)
+    {
+        AudioTxOnTransceiversDto dto;
+        dto.callsign = "DLH123";
+        dto.sequenceCounter = sequence;
+        dto.audio = std::vector<char>(60, static_cast<char>(sequence));
+        dto.lastPacket = false;
+        dto.transceivers = { TxTransceiverDto(1) };
+        return dto;
+    }
+
+    CCryptoDtoChannel CTestCryptoDtoSerializer::channel()
+    {
+        const QByteArray key(crypto_aead_chacha20poly1305_IETF_KEYBYTES, 'k');
+        return CCryptoDtoChannel("test", key, key);
+    }
+} // ns
+
+//! main
+BLACKTEST_APPLESS_MAIN(BlackCoreTest::CTestCryptoDtoSerializer);
+
+#include "testcryptodtoserializer.moc"
+
+//! \endcond
@@ -0,0 +1,30 @@
+load(common_pre)
+
+QT += core dbus testlib
+
+TARGET = testcryptodtoserializer
+CONFIG   -= app_bundle
+CONFIG   += blackconfig
+CONFIG   += blackmisc
+CONFIG   += blackcore
+CONFIG   += testcase
+CONFIG   += no_testcase_installs
+
+LIBS *= -lsodium
+
+TEMPLATE = app
+
+DEPENDPATH += \
+    . \
+    $$SourceRoot/src \
+    $$SourceRoot/tests \
+
+INCLUDEPATH += \
+    $$SourceRoot/src \
+    $$SourceRoot/tests \
+
+SOURCES += testcryptodtoserializer.cpp
+
+DESTDIR = $$DestRoot/bin
+
+load(common_post)
@@ -0,0 +1,270 @@
+/* Copyright (C) 2020
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \cond PRIVATE_TESTS
+//! \file
+//! \ingroup testblackcore
+
+#include "blackcore/afv/audio/jitterbuffer.h"
+#include "test.h"
+
+#include <QObject>
+#include <QTest>
+#include <QVector>
+
+using namespace BlackCore::Afv::Audio;
+
+namespace BlackCoreTest
+{
+    //! AFV jitter buffer tests
+    class CTestJitterBuffer : public QObject
+    {
+        Q_OBJECT
+
+    private slots:
+        //! Packets in order, played after the target latency
+        void inOrder();
+
+        //! Packets out of order are played in order
+        void reordered();
+
+        //! Missing and late packets
+        void lostAndLate();
+
+        //! Buffer runs empty during a transmission
+        void underflow();
+
+        //! More buffered than needed
+        void tooDeep();
+
+        //! Target latency follows the jitter
+        void adaptiveTarget();
+
+        //! Sequence number wrapping around
+        void sequenceWrap();
+
+    private:
+        //! Packet identified by its sequence
+        static QByteArray packet(uint sequence);
+
+        //! Take up to count frames, packet frames as sequence, concealed ones as -1
+        static QVector<int> takeFrames(CJitterBuffer &buffer, qint64 nowMs, int count);
+    };
+
+    void CTestJitterBuffer::inOrder()
+    {
+        CJitterBuffer buffer;
+        buffer.start(0.0);
+        QCOMPARE(buffer.getTargetLatencyMs(), CJitterBuffer::MinTargetLatencyMs);
+
+        QByteArray audio;
+        buffer.addPacket(100, packet(100), false, 0);
+        QCOMPARE(buffer.takeFrame(0, audio), CJitterBuffer::NoFrame);
+        buffer.addPacket(101, packet(101), false, 20);
+        QCOMPARE(buffer.takeFrame(20, audio), CJitterBuffer::PacketFrame);
+        QCOMPARE(audio, packet(100));
+        QCOMPARE(buffer.takeFrame(40, audio), CJitterBuffer::PacketFrame);
+        QCOMPARE(audio, packet(101));
+        QCOMPARE(buffer.takeFrame(60, audio), CJitterBuffer::ConcealedFrame); // underflow
+
+        // one frame per packet, played one frame later
+        buffer.start(0.0);
+        QVector<int> frames;
+        for (uint s = 0; s < 10; s++)
+        {
+            buffer.addPacket(s, packet(s), s == 9, 1000 + 20 * s);
+            frames += takeFrames(buffer, 1000 + 20 * s, 1);
+        }
+        frames += takeFrames(buffer, 1200, 1);
+        QCOMPARE(frames, QVector<int>({ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 }));
+        QVERIFY(buffer.isEndOfTransmission());
+        QVERIFY(buffer.isEmpty());
+        QCOMPARE(takeFrames(buffer, 1220, 1), QVector<int>());
+
+        const JitterBufferStatistics statistics = buffer.getStatistics();
+        QCOMPARE(statistics.receivedPackets, 12);
+        QCOMPARE(statistics.playedFrames, 12);
+        QCOMPARE(statistics.lostFrames, 0);
+        QCOMPARE(statistics.latencySumMs, qint64(12 * 20));
+    }
+
+    void CTestJitterBuffer::reordered()
+    {
+        CJitterBuffer buffer;
+        buffer.start(0.0);
+        buffer.addPacket(1, packet(1), false, 0);
+        buffer.addPacket(0, packet(0), false, 1); // before playout, moves the start
+        QCOMPARE(takeFrames(buffer, 1, 1), QVector<int>({ 0 }));
+        buffer.addPacket(3, packet(3), false, 40);
+        QCOMPARE(takeFrames(buffer, 40, 1), QVector<int>({ 1 }));
+        buffer.addPacket(2, packet(2), false, 41);
+        QCOMPARE(takeFrames(buffer, 41, 1), QVector<int>({ 2 }));
+        QCOMPARE(takeFrames(buffer, 60, 1), QVector<int>({ 3 }));
+        buffer.addPacket(4, packet(4), true, 80);
+        QCOMPARE(takeFrames(buffer, 80, 1), QVector<int>({ 4 }));
+        QVERIFY(buffer.isEndOfTransmission());
+
+        QCOMPARE(buffer.getStatistics().reorderedPackets, 2);
+        QCOMPARE(buffer.getStatistics().lostFrames, 0);
+        QCOMPARE(buffer.getStatistics().latePackets, 0);
+    }
+
+    void CTestJitterBuffer::lostAndLate()
+    {
+        CJitterBuffer buffer;
+        buffer.start(0.0);
+        buffer.addPacket(0, packet(0), false, 0);
+        buffer.addPacket(1, packet(1), false, 20);
+        QCOMPARE(takeFrames(buffer, 20, 1), QVector<int>({ 0 }));
+        buffer.addPacket(3, packet(3), false, 40);
+        QCOMPARE(takeFrames(buffer, 40, 2), QVector<int>({ 1, -1 }));
+        buffer.addPacket(2, packet(2), false, 61);
+        QCOMPARE(takeFrames(buffer, 61, 1), QVector<int>({ 3 }));
+        buffer.addPacket(4, packet(4), true, 80);
+        QCOMPARE(takeFrames(buffer, 80, 2), QVector<int>({ 4 }));
+        QVERIFY(buffer.isEndOfTransmission());
+
+        const JitterBufferStatistics statistics = buffer.getStatistics();
+        QCOMPARE(statistics.lostFrames, 1);
+        QCOMPARE(statistics.concealedFrames, 1);
+        QCOMPARE(statistics.latePackets, 1);
+        QCOMPARE(statistics.playedFrames, 4);
+        QCOMPARE(statistics.lossRatio(), 0.2);
+    }
+
+    void CTestJitterBuffer::underflow()
+    {
+        CJitterBuffer buffer;
+        buffer.start(0.0);
+        buffer.addPacket(0, packet(0), false, 0);
+        buffer.addPacket(1, packet(1), false, 20);
+
+        // short gaps are concealed, then the buffer waits for the target latency again
+        QCOMPARE(takeFrames(buffer, 20, 5), QVector<int>({ 0, 1, -1, -1 }));
+        QCOMPARE(buffer.getStatistics().underflows, 1);
+        QVERIFY(!buffer.isEndOfTransmission());
+
+        buffer.addPacket(3, packet(3), false, 100); // concealed already
+        buffer.addPacket(4, packet(4), false, 100);
+        QCOMPARE(takeFrames(buffer, 100, 1), QVector<int>());
+        buffer.addPacket(5, packet(5), false, 120);
+        QCOMPARE(takeFrames(buffer, 120, 5), QVector<int>({ 4, 5, -1, -1 }));
+        QCOMPARE(buffer.getStatistics().underflows, 2);
+        QCOMPARE(buffer.getStatistics().concealedFrames, 4);
+        QCOMPARE(buffer.getStatistics().latePackets, 1);
+        QCOMPARE(buffer.getStatistics().lostFrames, 0);
+
+        // a single packet is played after the target latency
+        buffer.addPacket(8, packet(8), false, 200);
+        QCOMPARE(takeFrames(buffer, 220, 1), QVector<int>());
+        QCOMPARE(takeFrames(buffer, 240, 1), QVector<int>({ 8 }));
+    }
+
+    void CTestJitterBuffer::tooDeep()
+    {
+        // a burst, e.g. after a delay spike, the oldest frames are dropped down to the target latency
+        // the burst raises the jitter, the target latency is 60ms then
+        CJitterBuffer buffer;
+        buffer.start(0.0);
+        for (uint s = 0; s < 10; s++) { buffer.addPacket(s, packet(s), s == 9, 0); }
+        QCOMPARE(takeFrames(buffer, 0, 10), QVector<int>({ 1, 3, 4, 5, 6, 7, 8, 9 }));
+        QCOMPARE(buffer.getTargetLatencyMs(), 60);
+        QCOMPARE(buffer.getStatistics().droppedFrames, 2);
+        QVERIFY(buffer.isEndOfTransmission());
+
+        // a gap longer than the buffer starts over
+        buffer.start(0.0);
+        buffer.addPacket(0, packet(0), false, 0);
+        buffer.addPacket(1000, packet(1000), false, 20);
+        buffer.addPacket(1001, packet(1001), false, 40);
+        QCOMPARE(takeFrames(buffer, 40, 2), QVector<int>({ 1000, 1001 }));
+        QCOMPARE(buffer.getStatistics().droppedFrames, 3);
+        QCOMPARE(buffer.getStatistics().lostFrames, 999);
+    }
+
+    void CTestJitterBuffer::adaptiveTarget()
+    {
+        // steady arrivals, the jitter decays and the next transmission starts with the min. latency
+        CJitterBuffer steady;
+        steady.start(CJitterBuffer::DefaultJitterMs);
+        QCOMPARE(steady.getTargetLatencyMs(), 60);
+        for (uint s = 0; s < 100; s++)
+        {
+            steady.addPacket(s, packet(s), false, 20 * s);
+            takeFrames(steady, 20 * s, 1);
+        }
+        QVERIFY(steady.getJitterMs() < 1.0);
+        steady.start(steady.getJitterMs());
+        QCOMPARE(steady.getTargetLatencyMs(), CJitterBuffer::MinTargetLatencyMs);
+
+        // arrivals alternating 30ms late, the next transmission starts with a higher latency
+        CJitterBuffer jittery;
+        jittery.start(0.0);
+        for (uint s = 0; s < 100; s++)
+        {
+            const qint64 nowMs = 20 * s + (s % 2 ? 30 : 0);
+            jittery.addPacket(s, packet(s), false, nowMs);
+            takeFrames(jittery, nowMs, 1);
+        }
+        QVERIFY(jittery.getJitterMs() > 25.0);
+        QCOMPARE(jittery.getStatistics().lostFrames, 0);
+        jittery.start(jittery.getJitterMs());
+        QVERIFY(jittery.getTargetLatencyMs() > 100);
+        QVERIFY(jittery.getTargetLatencyMs() <= CJitterBuffer::MaxTargetLatencyMs);
+        QCOMPARE(jittery.getStatistics().targetLatencyMs, jittery.getTargetLatencyMs());
+
+        // targets
+        QCOMPARE(CJitterBuffer::targetLatencyMs(0.0), CJitterBuffer::MinTargetLatencyMs);
+        QCOMPARE(CJitterBuffer::targetLatencyMs(10.0), 60);
+        QCOMPARE(CJitterBuffer::targetLatencyMs(1000.0), CJitterBuffer::MaxTargetLatencyMs);
+    }
+
+    void CTestJitterBuffer::sequenceWrap()
+    {
+        CJitterBuffer buffer;
+        buffer.start(0.0);
+        const uint first = 0xFFFFFFFEu;
+        buffer.addPacket(first, packet(first), false, 0);
+        buffer.addPacket(first + 2, packet(first + 2), false, 40);
+        buffer.addPacket(first + 1, packet(first + 1), false, 41);
+        buffer.addPacket(first + 3, packet(first + 3), true, 60);
+        QByteArray audio;
+        for (uint s = first; s != first + 4; s++)
+        {
+            QCOMPARE(buffer.takeFrame(60, audio), CJitterBuffer::PacketFrame);
+            QCOMPARE(audio, packet(s));
+        }
+        QVERIFY(buffer.isEndOfTransmission());
+        QCOMPARE(buffer.getStatistics().reorderedPackets, 1);
+    }
+
+    QByteArray CTestJitterBuffer::packet(uint sequence)
+    {
+        return QByteArray::number(sequence);
+    }
+
+    QVector<int> CTestJitterBuffer::takeFrames(CJitterBuffer &buffer, qint64 nowMs, int count)
+    {
+        QVector<int> frames;
+        QByteArray audio;
+        for (int f = 0; f < count; f++)
+        {
+            const CJitterBuffer::FrameType type = buffer.takeFrame(nowMs, audio);
+            if (type == CJitterBuffer::NoFrame) { break; }
+            frames.push_back(type == CJitterBuffer::PacketFrame ? audio.toInt() : -1);
+        }
+        return frames;
+    }
+} // ns
+
+//! main
+BLACKTEST_APPLESS_MAIN(BlackCoreTest::CTestJitterBuffer);
+
+#include "testjitterbuffer.moc"
+
+//! \endcond
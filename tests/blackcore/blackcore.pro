@@ -1,6 +1,7 @@
 TEMPLATE = subdirs
 
 SUBDIRS += \
+    afv \
     context \
     fsd \
     testconnectivity \
@@ -16,18 +16,23 @@
 
 #include "blackconfig/buildconfig.h"
 #include "blackcore/fsd/fsdclient.h"
+#include "blackcore/fsd/pilotdataupdate.h"
+#include "blackcore/fsd/tokenizer.h"
 #include "blackmisc/aviation/flightplan.h"
 #include "blackmisc/network/clientprovider.h"
 #include "blackmisc/network/rawfsdmessage.h"
 #include "blackmisc/network/networkutils.h"
 #include "blackmisc/simulation/ownaircraftproviderdummy.h"
 #include "blackmisc/simulation/remoteaircraftproviderdummy.h"
+#include "blackmisc/range.h"
 #include "blackmisc/registermetadata.h"
 #include "blackmisc/network/user.h"
 #include "test.h"
 
 #include <QObject>
 #include <QSignalSpy>
+#include <QTextCodec>
+#include <QVector>
 #include <QTest>
 
 using namespace BlackMisc;
@@ -63,6 +68,8 @@ namespace BlackFsdTest
         void testTextMessage();
         void testRadioMessage();
         void testPilotDataUpdate();
+        void testPilotDataUpdatesBatched();
+        void testPilotDataUpdatesMixedBatched();
         void testAtcDataUpdate();
         void testPong();
         void testClientResponseEmptyType();
@@ -72,6 +79,7 @@ namespace BlackFsdTest
         void testClientResponseCapabilities();
         void testPlaneInfoRequestFsinn();
         void testPlaneInformationFsinn();
+        void testParserRawTokens();
 
         void testSendPilotLogin();
         void testSendAtcLogin();
@@ -256,6 +264,120 @@ namespace BlackFsdTest
         //        QCOMPARE(arguments.at(12).toBool(), false);
     }
 
+    void CTestFSDClient::testPilotDataUpdatesBatched()
+    {
+        QSignalSpy spySingle(m_client, &CFSDClient::pilotDataUpdateReceived);
+        QSignalSpy spyBatch(m_client, &CFSDClient::pilotDataUpdatesReceived);
+
+        // like readDataFromSocketMaxLines
+        m_client->m_bufferPositionUpdates = true;
+        m_client->sendFsdMessage("@N:ABCD:1200:1:48.353855:11.786155:110:0:4290769188:1\r\n");
+        m_client->sendFsdMessage("@N:EFGH:2000:1:48.353855:11.786155:110:0:4290769188:1\r\n");
+        m_client->sendFsdMessage("@N:ABCD:1200:1:48.353955:11.786255:120:0:4290769188:1\r\n");
+        QCOMPARE(spyBatch.count(), 0);
+
+        // other messages must not overtake the positions
+        m_client->sendFsdMessage("#DPOEHAB:1234567\r\n");
+        QCOMPARE(spyBatch.count(), 1);
+
+        m_client->sendFsdMessage("@N:IJKL:7000:1:48.353855:11.786155:110:0:4290769188:1\r\n");
+        m_client->m_bufferPositionUpdates = false;
+        m_client->emitBufferedPositionUpdates();
+
+        QCOMPARE(spySingle.count(), 0);
+        QCOMPARE(spyBatch.count(), 2);
+
+        QList<QVariant> arguments = spyBatch.takeFirst();
+        CAircraftSituationList situations = arguments.at(0).value<CAircraftSituationList>();
+        QVector<CTransponder> transponders = arguments.at(1).value<QVector<CTransponder>>();
+        QCOMPARE(situations.size(), 3);
+        QCOMPARE(transponders.size(), 3);
+        QCOMPARE(situations[0].getCallsign().asString(), "ABCD");
+        QCOMPARE(situations[1].getCallsign().asString(), "EFGH");
+        QCOMPARE(situations[2].getCallsign().asString(), "ABCD");
+        QCOMPARE(situations[2].getAltitude(), CAltitude(120, CLengthUnit::ft()));
+        QCOMPARE(transponders[1].getTransponderCode(), 2000);
+
+        arguments = spyBatch.takeFirst();
+        situations = arguments.at(0).value<CAircraftSituationList>();
+        transponders = arguments.at(1).value<QVector<CTransponder>>();
+        QCOMPARE(situations.size(), 1);
+        QCOMPARE(transponders.size(), 1);
+        QCOMPARE(situations[0].getCallsign().asString(), "IJKL");
+        QCOMPARE(transponders[0].getTransponderCode(), 7000);
+
+        // nothing left
+        m_client->emitBufferedPositionUpdates();
+        QCOMPARE(spyBatch.count(), 0);
+    }
+
+    void CTestFSDClient::testPilotDataUpdatesMixedBatched()
+    {
+        // batches in the order they are emitted, "F" full and "I" interim positions
+        QStringList batches;
+        connect(m_client, &CFSDClient::pilotDataUpdatesReceived, this, [&batches](const CAircraftSituationList &situations, const QVector<CTransponder> &)
+        {
+            batches.push_back("F:" + situations.getCallsignStrings().join(','));
+        });
+        connect(m_client, &CFSDClient::interimPilotDataUpdatesReceived, this, [&batches](const CAircraftSituationList &situations)
+        {
+            batches.push_back("I:" + situations.getCallsignStrings().join(','));
+        });
+        QSignalSpy spySingle(m_client, &CFSDClient::pilotDataUpdateReceived);
+        QSignalSpy spyInterimSingle(m_client, &CFSDClient::interimPilotDataUpdatedReceived);
+
+        // like readDataFromSocketMaxLines, every switch between full and interim positions starts a new batch
+        m_client->m_bufferPositionUpdates = true;
+        m_client->sendFsdMessage("@N:EFGH:1200:1:48.353855:11.786155:110:0:4290769188:1\r\n");
+        m_client->sendFsdMessage("@N:IJKL:2000:1:48.353855:11.786155:110:0:4290769188:1\r\n");
+        QVERIFY(batches.isEmpty());
+        m_client->sendFsdMessage("#SBEFGH:ABCD:VI:48.35395:11.78625:120:400:25132146\r\n");
+        QCOMPARE(batches, QStringList({ "F:EFGH,IJKL" }));
+        m_client->sendFsdMessage("#SBIJKL:ABCD:VI:48.35395:11.78625:120:400:25132146\r\n");
+        m_client->sendFsdMessage("@N:EFGH:1200:1:48.353955:11.786255:130:0:4290769188:1\r\n");
+        QCOMPARE(batches, QStringList({ "F:EFGH,IJKL", "I:EFGH,IJKL" }));
+        m_client->m_bufferPositionUpdates = false;
+        m_client->emitBufferedPositionUpdates();
+
+        QCOMPARE(batches, QStringList({ "F:EFGH,IJKL", "I:EFGH,IJKL", "F:EFGH" }));
+        QCOMPARE(spySingle.count(), 0);
+        QCOMPARE(spyInterimSingle.count(), 0);
+    }
+
+    void CTestFSDClient::testParserRawTokens()
+    {
+        // stream of a busy event, 90% positions
+        QList<QByteArray> lines;
+        for (int i = 0; i < 1000; i++)
+        {
+            const QByteArray cs = "TST" + QByteArray::number(i);
+            lines.push_back("@N:" + cs + ":1200:1:48." + QByteArray::number(350000 + i) + ":11." + QByteArray::number(780000 + i) + ":" + QByteArray::number(1000 + i) + ":250:4290769188:25\r\n");
+            if (i % 10 == 0) { lines.push_back("#TM" + cs + ":@22800:Hello on frequency\r\n"); }
+        }
+
+        // QString decoding/splitting and raw tokens parse the same values
+        QTextCodec *codec = QTextCodec::codecForName("utf-8");
+        Tokenizer tokenizer;
+        int positions = 0;
+        for (const QByteArray &line : as_const(lines))
+        {
+            if (!line.startsWith('@')) { continue; }
+            const QString decoded = codec->toUnicode(line).trimmed();
+            const PilotDataUpdate fromStrings = PilotDataUpdate::fromTokens(decoded.mid(1).split(':'));
+            tokenizer.tokenize(line.constData() + 1, line.size() - 3);
+            const PilotDataUpdate fromRaw = PilotDataUpdate::fromTokens(tokenizer);
+            QVERIFY2(fromStrings == fromRaw, line.constData());
+            positions++;
+        }
+
+        // full replay through the client, including handlers and signals
+        QSignalSpy spy(m_client, &CFSDClient::pilotDataUpdateReceived);
+        m_client->m_unitTestMode = false; // no raw message signals, as with a real connection
+        for (const QByteArray &line : as_const(lines)) { m_client->parseMessage(line); }
+        m_client->m_unitTestMode = true;
+        QCOMPARE(spy.count(), positions);
+    }
+
     void CTestFSDClient::testAtcDataUpdate()
     {
         QSignalSpy spy(m_client, &CFSDClient::atcDataUpdateReceived);
@@ -29,6 +29,7 @@
 #include "blackcore/fsd/pong.h"
 #include "blackcore/fsd/killrequest.h"
 #include "blackcore/fsd/textmessage.h"
+#include "blackcore/fsd/tokenizer.h"
 #include "blackcore/fsd/clientquery.h"
 #include "blackcore/fsd/clientresponse.h"
 #include "blackcore/fsd/flightplan.h"
@@ -45,6 +46,7 @@
 
 #include <QObject>
 #include <QTest>
+#include <limits>
 
 using namespace BlackMisc::Aviation;
 using namespace BlackMisc::Network;
@@ -90,6 +92,8 @@ namespace BlackMiscTest
         void testPong();
         void testServerError();
         void testTextMessage();
+        void testTokenizer();
+        void testMessageTypeFromPrefix();
     };
 
     void CTestFsdMessages::testAddAtc()
@@ -364,6 +368,21 @@ namespace BlackMiscTest
         QVERIFY(message.m_bank - messageFromTokens.m_bank < 1.0);
         QVERIFY(message.m_heading - messageFromTokens.m_heading < 1.0);
         QCOMPARE(messageFromTokens.m_onGround, true);
+
+        const QByteArray raw("ABCD:XYZ:VI:43.12578:-72.15841:12008:400:25132146");
+        Tokenizer tokenizer;
+        tokenizer.tokenize(raw);
+        const InterimPilotDataUpdate messageFromRaw = InterimPilotDataUpdate::fromTokens(tokenizer);
+        QCOMPARE(messageFromRaw.sender(), messageFromTokens.sender());
+        QCOMPARE(messageFromRaw.receiver(), messageFromTokens.receiver());
+        QCOMPARE(messageFromRaw.m_latitude, messageFromTokens.m_latitude);
+        QCOMPARE(messageFromRaw.m_longitude, messageFromTokens.m_longitude);
+        QCOMPARE(messageFromRaw.m_altitudeTrue, messageFromTokens.m_altitudeTrue);
+        QCOMPARE(messageFromRaw.m_groundSpeed, messageFromTokens.m_groundSpeed);
+        QCOMPARE(messageFromRaw.m_pitch, messageFromTokens.m_pitch);
+        QCOMPARE(messageFromRaw.m_bank, messageFromTokens.m_bank);
+        QCOMPARE(messageFromRaw.m_heading, messageFromTokens.m_heading);
+        QCOMPARE(messageFromRaw.m_onGround, messageFromTokens.m_onGround);
     }
 
     void CTestFsdMessages::testKillRequest()
@@ -455,6 +474,12 @@ namespace BlackMiscTest
         QVERIFY(message.m_bank - messageFromTokens.m_bank < 1.0);
         QVERIFY(message.m_heading - messageFromTokens.m_heading < 1.0);
         QCOMPARE(messageFromTokens.m_onGround, true);
+
+        const QByteArray raw("N:ABCD:7000:1:43.12578:-72.15841:12000:125:25132146:8");
+        Tokenizer tokenizer;
+        tokenizer.tokenize(raw);
+        const PilotDataUpdate messageFromRaw = PilotDataUpdate::fromTokens(tokenizer);
+        QCOMPARE(messageFromRaw, messageFromTokens);
     }
 
     void CTestFsdMessages::testPing()
@@ -601,6 +626,74 @@ namespace BlackMiscTest
     {
 
     }
+
+    void CTestFsdMessages::testTokenizer()
+    {
+        Tokenizer tokenizer;
+        const QByteArray raw("N:ABCD::-72.15841: 12 :4290769188:x1:1e3");
+        tokenizer.tokenize(raw);
+        QCOMPARE(tokenizer.size(), 8);
+        QCOMPARE(tokenizer.toQString(1), QString("ABCD"));
+        QVERIFY(tokenizer.at(2).isEmpty());
+        QCOMPARE(tokenizer.toDouble(3), QString("-72.15841").toDouble());
+        QCOMPARE(tokenizer.toInt(4), 12);
+        QCOMPARE(tokenizer.toUInt(5), 4290769188u);
+        QCOMPARE(tokenizer.toInt(6), 0);
+        QCOMPARE(tokenizer.toDouble(7), 1000.0);
+        QVERIFY(tokenizer.equals(0, QLatin1String("N")));
+        QVERIFY(!tokenizer.equals(8, QLatin1String("N")));
+        QCOMPARE(tokenizer.toQStringList(), QString(raw).split(':'));
+
+        // out of range values are rejected, not wrapped
+        tokenizer.tokenize(QByteArray("2147483647:2147483648:-2147483648:-2147483649:4294967296:-1:99999999999999999999"));
+        QCOMPARE(tokenizer.toInt(0), 2147483647);
+        QCOMPARE(tokenizer.toInt(1), 0);
+        QCOMPARE(tokenizer.toInt(2), -2147483647 - 1);
+        QCOMPARE(tokenizer.toInt(3), 0);
+        QCOMPARE(tokenizer.toUInt(1), 2147483648u);
+        QCOMPARE(tokenizer.toUInt(4), 0u);
+        QCOMPARE(tokenizer.toUInt(5), 0u);
+        QCOMPARE(Tokenizer::toLongLong(QLatin1String("-9223372036854775808")), std::numeric_limits<qlonglong>::min());
+        QCOMPARE(Tokenizer::toLongLong(QLatin1String("9223372036854775808")), 0LL);
+        QCOMPARE(Tokenizer::toULongLong(QLatin1String("18446744073709551615")), std::numeric_limits<qulonglong>::max());
+        QCOMPARE(Tokenizer::toULongLong(QLatin1String("18446744073709551616")), 0ULL);
+        QCOMPARE(tokenizer.toInt(6), 0);
+
+        // same results as QString conversion for the FSD number formats
+        for (const char *number : { "0", "-0.00001", "48.353855", "11.786155", "-179.99999", "123456789.12345", "+5" })
+        {
+            QCOMPARE(Tokenizer::toDouble(QLatin1String(number)), QString(number).toDouble());
+        }
+    }
+
+    void CTestFsdMessages::testMessageTypeFromPrefix()
+    {
+        const QList<QPair<QByteArray, MessageType>> testData =
+        {
+            { "#AA", MessageType::AddAtc }, { "#AP", MessageType::AddPilot }, { "%", MessageType::AtcDataUpdate },
+            { "$ZC", MessageType::AuthChallenge }, { "$ZR", MessageType::AuthResponse }, { "$ID", MessageType::ClientIdentification },
+            { "$CQ", MessageType::ClientQuery }, { "$CR", MessageType::ClientResponse }, { "#DA", MessageType::DeleteATC },
+            { "#DP", MessageType::DeletePilot }, { "$FP", MessageType::FlightPlan }, { "#PC", MessageType::ProController },
+            { "$DI", MessageType::FsdIdentification }, { "$!!", MessageType::KillRequest }, { "@", MessageType::PilotDataUpdate },
+            { "$PI", MessageType::Ping }, { "$PO", MessageType::Pong }, { "$ER", MessageType::ServerError },
+            { "#DL", MessageType::ServerHeartbeat }, { "#TM", MessageType::TextMessage }, { "#SB", MessageType::PilotClientCom },
+            { "!R", MessageType::RegistrationInfo }, { "-MD", MessageType::RevBClientParts }, { "-PD", MessageType::RevBPilotDescription }
+        };
+
+        for (const auto &pair : testData)
+        {
+            const QByteArray line = pair.first + "ABCD:SERVER";
+            int prefixLength = -1;
+            QCOMPARE(messageTypeFromPrefix(line.constData(), line.size(), prefixLength), pair.second);
+            QCOMPARE(prefixLength, pair.first.size());
+        }
+
+        int prefixLength = -1;
+        QCOMPARE(messageTypeFromPrefix("#XY:ABCD", 8, prefixLength), MessageType::Unknown);
+        QCOMPARE(prefixLength, 0);
+        QCOMPARE(messageTypeFromPrefix("$", 1, prefixLength), MessageType::Unknown);
+        QCOMPARE(messageTypeFromPrefix(nullptr, 0, prefixLength), MessageType::Unknown);
+    }
 }
 
 //! main
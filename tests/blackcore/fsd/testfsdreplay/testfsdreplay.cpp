@@ -0,0 +1,536 @@
+/* Copyright (C) 2020
+ * swift Project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution and at http://www.swift-project.org/license.html. No part of swift project,
+ * including this file, may be copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE file.
+ */
+
+//! \cond PRIVATE_TESTS
+
+/*!
+* \file
+* \ingroup testblackfsd
+*/
+
+#include "blackcore/airspacemonitor.h"
+#include "blackcore/application.h"
+#include "blackcore/db/databasereaderconfig.h"
+#include "blackcore/fsd/fsdclient.h"
+#include "blackcore/fsd/interimpilotdataupdate.h"
+#include "blackcore/fsd/pbh.h"
+#include "blackcore/fsd/pilotdataupdate.h"
+#include "blackcore/fsd/tokenizer.h"
+#include "blackmisc/network/clientprovider.h"
+#include "blackmisc/simulation/aircraftmodelsetprovider.h"
+#include "blackmisc/simulation/ownaircraftproviderdummy.h"
+#include "blackmisc/simulation/remoteaircraftproviderdummy.h"
+#include "blackmisc/applicationinfo.h"
+#include "blackmisc/range.h"
+#include "blackmisc/registermetadata.h"
+#include "test.h"
+
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QHash>
+#include <QObject>
+#include <QTest>
+#include <QTextCodec>
+#include <QVector>
+
+using namespace BlackMisc;
+using namespace BlackMisc::Aviation;
+using namespace BlackMisc::Network;
+using namespace BlackMisc::Simulation;
+using namespace BlackCore;
+using namespace BlackCore::Db;
+using namespace BlackCore::Fsd;
+
+namespace BlackFsdTest
+{
+    //! Model set provider with an empty model set
+    class CModelSetProviderDummy : public QObject, public IAircraftModelSetProvider
+    {
+        Q_OBJECT
+        Q_INTERFACES(BlackMisc::Simulation::IAircraftModelSetProvider)
+
+    public:
+        //! \copydoc IAircraftModelSetProvider::getModelSet
+        virtual CAircraftModelList getModelSet() const override { return {}; }
+
+        //! \copydoc IAircraftModelSetProvider::getModelSetCount
+        virtual int getModelSetCount() const override { return 0; }
+
+        //! \copydoc IProvider::asQObject
+        virtual QObject *asQObject() override { return this; }
+    };
+
+    //! Benchmark replaying recorded or generated FSD traffic into a CFSDClient wired to a CAirspaceMonitor, without network.
+    //! Every stage is a QBENCHMARK, so releases can be compared on big events.
+    //! \remark SWIFT_FSD_REPLAY_FILE: raw FSD message log (as written by the FSD client) to be replayed instead of generated traffic
+    //! \remark not a test case, the end to end stages need the web data services
+    class CTestFsdReplay : public QObject
+    {
+        Q_OBJECT
+
+    public:
+        //! Constructor
+        explicit CTestFsdReplay(QObject *parent = nullptr) : QObject(parent) {}
+
+        //! Destructor
+        virtual ~CTestFsdReplay() {}
+
+    private slots:
+        void initTestCase();
+        void cleanupTestCase();
+
+        //! PDU detection, tokenizing and decoding of all lines
+        void decode();
+
+        //! Position messages from QString tokens (before) and from raw tokens
+        //! @{
+        void parse_data();
+        void parse();
+        //! @}
+
+        //! FSD client handlers and signals, one signal per position or one per socket pass
+        //! @{
+        void signalEmission_data();
+        void signalEmission();
+        //! @}
+
+        //! Storing the situations in the provider, one lock per situation or one per socket pass
+        //! @{
+        void storeAircraftSituations_data();
+        void storeAircraftSituations();
+        //! @}
+
+        //! Client wired to the airspace monitor
+        void airspaceMonitor();
+
+        //! Latency from the first position until an aircraft is ready for model matching
+        void matchingReadiness();
+
+    private:
+        //! Generated traffic, N pilots with ICAO and FsInn information
+        static QList<QByteArray> generateTraffic(int pilots, int updatesPerPilot);
+
+        //! Received lines from a raw FSD message log
+        static QList<QByteArray> readRawFsdLog(const QString &fileName);
+
+        //! Position line (pilot data or interim update), payload without PDU and CR/LF
+        static bool isPositionLine(const QByteArray &line, const char *&payload, int &payloadSize, MessageType &type);
+
+        //! Init a client as used in the replay
+        CFSDClient *createClient(IRemoteAircraftProvider *remoteAircraftProvider);
+
+        //! Replay all lines in socket passes like CFSDClient::readDataFromSocketMaxLines, positions are emitted as batch per pass
+        void replayInSocketPasses(CFSDClient *client);
+
+        //! Start/end a pass like CFSDClient::readDataFromSocketMaxLines
+        //! @{
+        static void beginSocketPass(CFSDClient *client);
+        static void endSocketPass(CFSDClient *client);
+        //! @}
+
+        static constexpr int LinesPerSocketPass = 75;    //!< max. lines read in one pass
+        static constexpr int GeneratedPilots    = 1500;  //!< pilots of the generated traffic
+        static constexpr int GeneratedUpdates   = 5;     //!< updates per pilot of the generated traffic
+        static constexpr int MaxReadinessWaitMs = 10000; //!< max. time to wait for all aircraft being ready for matching
+
+        QList<QByteArray> m_lines;
+        int m_positions = 0;
+        CAircraftSituationList m_situations; //!< situations as emitted by the client
+        CModelSetProviderDummy m_modelSetProvider;
+        CFSDClient *m_client = nullptr;
+        CAirspaceMonitor *m_airspace = nullptr;
+        QElapsedTimer m_replayTimer;
+        QHash<CCallsign, qint64> m_firstSeenNs;
+        QHash<CCallsign, qint64> m_readyNs;
+    };
+
+    void CTestFsdReplay::initTestCase()
+    {
+        BlackMisc::registerMetadata();
+        const QString logFile = qEnvironmentVariable("SWIFT_FSD_REPLAY_FILE");
+        m_lines = logFile.isEmpty() ? generateTraffic(GeneratedPilots, GeneratedUpdates) : readRawFsdLog(logFile);
+        QVERIFY2(!m_lines.isEmpty(), "No FSD traffic to replay");
+
+        for (const QByteArray &line : as_const(m_lines))
+        {
+            const char *payload = nullptr;
+            int payloadSize = 0;
+            MessageType type = MessageType::Unknown;
+            if (isPositionLine(line, payload, payloadSize, type)) { m_positions++; }
+        }
+
+        // situations for the storing stage
+        CFSDClient *client = this->createClient(CRemoteAircraftProviderDummy::instance());
+        connect(client, &CFSDClient::pilotDataUpdateReceived, this, [this](const CAircraftSituation &situation, const CTransponder &)
+        {
+            m_situations.push_back(situation);
+        });
+        connect(client, &CFSDClient::interimPilotDataUpdatedReceived, this, [this](const CAircraftSituation &situation)
+        {
+            m_situations.push_back(situation);
+        });
+        for (const QByteArray &line : as_const(m_lines)) { client->parseMessage(line); }
+        delete client;
+        QVERIFY2(m_situations.sizeInt() <= m_positions, "More situations than position messages");
+
+        if (sApp && sApp->hasWebDataServices())
+        {
+            COwnAircraftProviderDummy::instance()->updateOwnCallsign("SWIFT1");
+            m_client = this->createClient(CRemoteAircraftProviderDummy::instance());
+            m_airspace = new CAirspaceMonitor(COwnAircraftProviderDummy::instance(), &m_modelSetProvider, m_client, this);
+            m_client->setRemoteAircraftProvider(m_airspace);
+            m_client->setClientProvider(m_airspace);
+        }
+    }
+
+    void CTestFsdReplay::cleanupTestCase()
+    {
+        if (m_client) { m_client->updateConnectionStatus(CConnectionStatus::Disconnected); }
+        delete m_airspace;
+        delete m_client;
+        m_airspace = nullptr;
+        m_client = nullptr;
+    }
+
+    void CTestFsdReplay::decode()
+    {
+        QTextCodec *codec = QTextCodec::codecForName("utf-8");
+        Tokenizer tokenizer;
+        int positions = 0;
+        int decodedTokens = 0;
+        QBENCHMARK
+        {
+            positions = 0;
+            decodedTokens = 0;
+            for (const QByteArray &line : as_const(m_lines))
+            {
+                const char *payload = nullptr;
+                int payloadSize = 0;
+                MessageType type = MessageType::Unknown;
+                if (isPositionLine(line, payload, payloadSize, type))
+                {
+                    tokenizer.tokenize(payload, payloadSize);
+                    positions++;
+                    continue;
+                }
+
+                // other messages are decoded to strings, as in CFSDClient::parseMessage
+                int prefixLength = 0;
+                messageTypeFromPrefix(line.constData(), line.size(), prefixLength);
+                tokenizer.tokenize(line.constData() + prefixLength, line.size() - prefixLength);
+                decodedTokens += tokenizer.toQStringList(codec).size();
+            }
+        }
+        QCOMPARE(positions, m_positions);
+        QVERIFY(positions == m_lines.size() || decodedTokens > 0);
+    }
+
+    void CTestFsdReplay::parse_data()
+    {
+        QTest::addColumn<bool>("rawTokens");
+        QTest::newRow("QString tokens") << false;
+        QTest::newRow("raw tokens") << true;
+    }
+
+    void CTestFsdReplay::parse()
+    {
+        QFETCH(bool, rawTokens);
+        QTextCodec *codec = QTextCodec::codecForName("utf-8");
+        Tokenizer tokenizer;
+        qint64 checksum = 0;
+        QBENCHMARK
+        {
+            checksum = 0;
+            for (const QByteArray &line : as_const(m_lines))
+            {
+                const char *payload = nullptr;
+                int payloadSize = 0;
+                MessageType type = MessageType::Unknown;
+                if (!isPositionLine(line, payload, payloadSize, type)) { continue; }
+                if (rawTokens)
+                {
+                    tokenizer.tokenize(payload, payloadSize);
+                    if (type == MessageType::PilotDataUpdate) { checksum += PilotDataUpdate::fromTokens(tokenizer).m_altitudeTrue; }
+                    else { checksum += InterimPilotDataUpdate::fromTokens(tokenizer).m_altitudeTrue; }
+                }
+                else
+                {
+                    const QStringList tokens = codec->toUnicode(payload, payloadSize).split(':');
+                    if (type == MessageType::PilotDataUpdate) { checksum += PilotDataUpdate::fromTokens(tokens).m_altitudeTrue; }
+                    else { checksum += InterimPilotDataUpdate::fromTokens(tokens).m_altitudeTrue; }
+                }
+            }
+        }
+        QVERIFY(m_positions < 1 || checksum != 0);
+    }
+
+    void CTestFsdReplay::signalEmission_data()
+    {
+        QTest::addColumn<bool>("batched");
+        QTest::newRow("per position") << false;
+        QTest::newRow("per socket pass") << true;
+    }
+
+    void CTestFsdReplay::signalEmission()
+    {
+        QFETCH(bool, batched);
+        int signalCount = 0;
+        int situations = 0;
+        CFSDClient *client = this->createClient(CRemoteAircraftProviderDummy::instance());
+        connect(client, &CFSDClient::pilotDataUpdateReceived, client, [&](const CAircraftSituation &, const CTransponder &) { signalCount++; situations++; });
+        connect(client, &CFSDClient::interimPilotDataUpdatedReceived, client, [&](const CAircraftSituation &) { signalCount++; situations++; });
+        connect(client, &CFSDClient::pilotDataUpdatesReceived, client, [&](const CAircraftSituationList &batch, const QVector<CTransponder> &)
+        {
+            signalCount++;
+            situations += batch.sizeInt();
+        });
+        connect(client, &CFSDClient::interimPilotDataUpdatesReceived, client, [&](const CAircraftSituationList &batch)
+        {
+            signalCount++;
+            situations += batch.sizeInt();
+        });
+
+        QBENCHMARK
+        {
+            signalCount = 0;
+            situations = 0;
+            if (batched) { this->replayInSocketPasses(client); }
+            else
+            {
+                for (const QByteArray &line : as_const(m_lines)) { client->parseMessage(line); }
+            }
+        }
+        delete client;
+
+        QCOMPARE(situations, m_situations.sizeInt());
+        if (batched) { QVERIFY(signalCount <= situations); }
+        else { QCOMPARE(signalCount, situations); }
+    }
+
+    void CTestFsdReplay::storeAircraftSituations_data()
+    {
+        QTest::addColumn<bool>("batched");
+        QTest::newRow("per situation") << false;
+        QTest::newRow("per socket pass") << true;
+    }
+
+    void CTestFsdReplay::storeAircraftSituations()
+    {
+        QFETCH(bool, batched);
+        QVector<CAircraftSituationList> batches;
+        for (int i = 0; i < m_situations.sizeInt(); i += LinesPerSocketPass)
+        {
+            CAircraftSituationList batch;
+            for (int j = i; j < qMin(i + LinesPerSocketPass, m_situations.sizeInt()); ++j) { batch.push_back(m_situations[j]); }
+            batches.push_back(batch);
+        }
+
+        QBENCHMARK
+        {
+            CRemoteAircraftProviderDummy provider;
+            if (batched)
+            {
+                for (const CAircraftSituationList &batch : as_const(batches)) { provider.insertNewSituations(batch); }
+            }
+            else
+            {
+                for (const CAircraftSituation &situation : as_const(m_situations)) { provider.insertNewSituation(situation); }
+            }
+        }
+    }
+
+    void CTestFsdReplay::airspaceMonitor()
+    {
+        if (!m_airspace) { QSKIP("No web data services, skip airspace monitor"); }
+
+        Tokenizer tokenizer;
+        connect(m_airspace, &CAirspaceMonitor::readyForModelMatching, this, [this](const CSimulatedAircraft &aircraft)
+        {
+            const CCallsign cs = aircraft.getCallsign();
+            if (m_readyNs.contains(cs) || !m_firstSeenNs.contains(cs)) { return; }
+            m_readyNs.insert(cs, m_replayTimer.nsecsElapsed() - m_firstSeenNs.value(cs));
+        });
+
+        m_client->updateConnectionStatus(CConnectionStatus::Connecting); // airspace monitor sets the max.range
+        m_client->updateConnectionStatus(CConnectionStatus::Connected);
+
+        // the airspace keeps its aircraft, so only one run is meaningful
+        QBENCHMARK_ONCE
+        {
+            m_replayTimer.start();
+            int lineNo = 0;
+            for (const QByteArray &line : as_const(m_lines))
+            {
+                if (lineNo % LinesPerSocketPass == 0) { beginSocketPass(m_client); }
+                const char *payload = nullptr;
+                int payloadSize = 0;
+                MessageType type = MessageType::Unknown;
+                if (isPositionLine(line, payload, payloadSize, type))
+                {
+                    // callsign is token 1 of a pilot data update, token 0 of an interim update
+                    tokenizer.tokenize(payload, payloadSize);
+                    const int csIndex = (type == MessageType::PilotDataUpdate) ? 1 : 0;
+                    if (tokenizer.size() > csIndex)
+                    {
+                        const CCallsign cs(tokenizer.toQString(csIndex), CCallsign::Aircraft);
+                        if (!m_firstSeenNs.contains(cs)) { m_firstSeenNs.insert(cs, m_replayTimer.nsecsElapsed()); }
+                    }
+                }
+                m_client->parseMessage(line);
+                if (++lineNo % LinesPerSocketPass == 0) { endSocketPass(m_client); }
+            }
+            endSocketPass(m_client);
+        }
+        QVERIFY2(m_airspace->getAircraftInRangeCount() > 0, "No aircraft in range");
+    }
+
+    void CTestFsdReplay::matchingReadiness()
+    {
+        if (!m_airspace) { QSKIP("No web data services, skip matching readiness"); }
+
+        // readiness can depend on timers (missing FsInn data etc.), so process events for a while
+        const int inRange = m_airspace->getAircraftInRangeCount();
+        const qint64 waitUntilMs = QDateTime::currentMSecsSinceEpoch() + MaxReadinessWaitMs;
+        while (m_readyNs.size() < inRange && QDateTime::currentMSecsSinceEpoch() < waitUntilMs)
+        {
+            QCoreApplication::processEvents(QEventLoop::AllEvents, 100);
+        }
+        m_client->m_queuedFsdMessages.clear(); // queries of the airspace monitor, never sent
+        QVERIFY2(!m_readyNs.isEmpty(), "No aircraft ready for model matching");
+
+        // average latency is the result
+        qint64 sumNs = 0;
+        for (qint64 ns : as_const(m_readyNs)) { sumNs += ns; }
+        QTest::setBenchmarkResult(sumNs / 1.0e6 / m_readyNs.size(), QTest::WalltimeMilliseconds);
+    }
+
+    void CTestFsdReplay::replayInSocketPasses(CFSDClient *client)
+    {
+        int lineNo = 0;
+        for (const QByteArray &line : as_const(m_lines))
+        {
+            if (lineNo % LinesPerSocketPass == 0) { beginSocketPass(client); }
+            client->parseMessage(line);
+            if (++lineNo % LinesPerSocketPass == 0) { endSocketPass(client); }
+        }
+        endSocketPass(client);
+    }
+
+    void CTestFsdReplay::beginSocketPass(CFSDClient *client)
+    {
+        client->m_bufferPositionUpdates = true;
+    }
+
+    void CTestFsdReplay::endSocketPass(CFSDClient *client)
+    {
+        client->m_bufferPositionUpdates = false;
+        client->emitBufferedPositionUpdates();
+    }
+
+    QList<QByteArray> CTestFsdReplay::generateTraffic(int pilots, int updatesPerPilot)
+    {
+        QList<QByteArray> lines;
+        lines.reserve(pilots * (updatesPerPilot + 2));
+        for (int u = 0; u < updatesPerPilot; u++)
+        {
+            for (int p = 0; p < pilots; p++)
+            {
+                const QByteArray cs = "RPL" + QByteArray::number(p).rightJustified(4, '0');
+                const double lat = 48.0 + (p % 100) * 0.02 + u * 0.001;
+                const double lon = 11.0 + (p / 100) * 0.02 + u * 0.001;
+                std::uint32_t pbh = 0;
+                packPBH(2, -5, (p * 7) % 360, false, pbh);
+                lines.push_back("@N:" + cs + ":1200:1:" + QByteArray::number(lat, 'f', 5) + ":" + QByteArray::number(lon, 'f', 5) + ":" +
+                                QByteArray::number(5000 + 10 * p) + ":250:" + QByteArray::number(pbh) + ":25\r\n");
+
+                // ICAO data after the 2nd position, so we have enough situations for the matching
+                if (u == 1)
+                {
+                    lines.push_back("#SB" + cs + ":SWIFT1:PI:GEN:EQUIPMENT=A320:AIRLINE=DLH:LIVERY=DLH\r\n");
+                    lines.push_back("#SB" + cs + ":SWIFT1:FSIPI:0:DLH:A320:0.0:0.0:0.0:0:L2J:Airbus A320 Lufthansa\r\n");
+                }
+            }
+        }
+        return lines;
+    }
+
+    QList<QByteArray> CTestFsdReplay::readRawFsdLog(const QString &fileName)
+    {
+        QList<QByteArray> lines;
+        QFile file(fileName);
+        if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) { return lines; }
+
+        static const QByteArray received("FSD Recv=>");
+        while (!file.atEnd())
+        {
+            const QByteArray line = file.readLine();
+            const int i = line.indexOf(received);
+            if (i < 0) { continue; }
+            lines.push_back(line.mid(i + received.size()).trimmed() + "\r\n");
+        }
+        return lines;
+    }
+
+    bool CTestFsdReplay::isPositionLine(const QByteArray &line, const char *&payload, int &payloadSize, MessageType &type)
+    {
+        int prefixLength = 0;
+        type = messageTypeFromPrefix(line.constData(), line.size(), prefixLength);
+        if (type != MessageType::PilotDataUpdate && type != MessageType::PilotClientCom) { return false; }
+        payload = line.constData() + prefixLength;
+        payloadSize = line.size() - prefixLength;
+        while (payloadSize > 0 && (payload[payloadSize - 1] == '\r' || payload[payloadSize - 1] == '\n')) { payloadSize--; }
+        if (payloadSize < 3) { return false; }
+        if (type == MessageType::PilotClientCom)
+        {
+            // interim positions only
+            if (!QByteArray::fromRawData(payload, payloadSize).contains(":VI:")) { return false; }
+            type = MessageType::Unknown; // interim
+        }
+        return true;
+    }
+
+    CFSDClient *CTestFsdReplay::createClient(IRemoteAircraftProvider *remoteAircraftProvider)
+    {
+        CFSDClient *client = new CFSDClient(CClientProviderDummy::instance(), COwnAircraftProviderDummy::instance(), remoteAircraftProvider, this);
+        client->setServer(CServer::swiftFsdTestServer(true));
+        client->setCallsign("SWIFT1");
+        client->setClientName("Replay Client");
+        client->setVersion(0, 8);
+        client->setLoginMode(CLoginMode::Pilot);
+        client->setSimType(CSimulatorInfo::xplane());
+        client->setPilotRating(PilotRating::Student);
+
+        // as with a real connection: no raw message signals, queries are just queued
+        client->setUnitTestMode(false);
+        return client;
+    }
+} // ns
+
+//! main
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    BLACKTEST_INIT(BlackFsdTest::CTestFsdReplay)
+    CApplication a(CApplicationInfo::UnitTest);
+    a.useWebDataServices(CWebReaderFlags::AllSwiftDbReaders, CDatabaseReaderConfigList::forPilotClient());
+    const bool setup = a.parseAndSynchronizeSetup();
+    if (!setup) { qWarning() << "No setup loaded"; }
+    int r = EXIT_FAILURE;
+    if (a.start())
+    {
+        r = QTest::qExec(&to, args);
+    }
+    a.gracefulShutdown();
+    return r;
+}
+
+#include "testfsdreplay.moc"
+
+//! \endcond
@@ -2,3 +2,5 @@ TEMPLATE = subdirs
 
 SUBDIRS += \
     testguiutility \
+    testlistmodeldiff \
+    testlistmodelsortkeys \
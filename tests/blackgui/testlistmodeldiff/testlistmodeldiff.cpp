@@ -0,0 +1,265 @@
+/* Copyright (C) 2020
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \cond PRIVATE_TESTS
+//! \file
+//! \ingroup testblackgui
+
+#include "blackgui/models/atcstationlistmodel.h"
+#include "blackgui/models/listmodeldiff.h"
+#include "blackgui/models/modelfilter.h"
+#include "blackmisc/aviation/atcstationlist.h"
+#include "blackmisc/pq/frequency.h"
+#include "blackmisc/pq/units.h"
+#include "test.h"
+
+#include <QAbstractItemModelTester>
+#include <QApplication>
+#include <QPersistentModelIndex>
+#include <QSignalSpy>
+#include <QStringList>
+#include <QTest>
+#include <memory>
+
+using namespace BlackGui::Models;
+using namespace BlackMisc::Aviation;
+using namespace BlackMisc::PhysicalQuantities;
+
+namespace BlackGuiTest
+{
+    //! Hides the centers
+    class CTestCenterFilter : public IModelFilter<CAtcStationList>
+    {
+    public:
+        //! Constructor
+        CTestCenterFilter() { m_valid = true; }
+
+        //! \copydoc IModelFilter::filter
+        virtual CAtcStationList filter(const CAtcStationList &stations) const override
+        {
+            CAtcStationList filtered;
+            for (const CAtcStation &station : stations)
+            {
+                if (!station.getCallsign().asString().endsWith("_CTR")) { filtered.push_back(station); }
+            }
+            return filtered;
+        }
+    };
+
+    //! Test the rows diff used for incremental model updates
+    class CTestListModelDiff : public QObject
+    {
+        Q_OBJECT
+
+    private slots:
+        //! Inserted and removed rows as ranges
+        void insertedAndRemoved();
+
+        //! Kept rows in another order
+        void reordered();
+
+        //! Changed rows as ranges
+        void changed();
+
+        //! Rows which can not be matched
+        void invalid();
+
+        //! Model update by the diff
+        void updateByDiff_data();
+
+        //! Model update by the diff, signals and persistent indexes
+        void updateByDiff();
+
+    private:
+        //! Stations with callsigns
+        static CAtcStationList stations(const QStringList &callsigns);
+
+        //! Callsigns of the displayed rows
+        static QStringList displayedCallsigns(const CAtcStationListModel &model);
+    };
+
+    void CTestListModelDiff::insertedAndRemoved()
+    {
+        const QStringList oldKeys { "A", "B", "C", "D", "E", "F" };
+        const QStringList newKeys { "X", "A", "D", "Y", "Z", "E" };
+        const CListModelDiff diff(oldKeys, newKeys);
+        QVERIFY(diff.isValid());
+        QVERIFY(!diff.isReordered());
+        QVERIFY(!diff.isEmpty());
+
+        const QVector<CListModelDiff::RowRange> removed { { 1, 2 }, { 5, 5 } };
+        const QVector<CListModelDiff::RowRange> inserted { { 0, 0 }, { 3, 4 } };
+        QCOMPARE(diff.getRemovedRanges(), removed);
+        QCOMPARE(diff.getInsertedRanges(), inserted);
+        QCOMPARE(diff.getOldRows(), QVector<int>({ -1, 0, 3, -1, -1, 4 }));
+        QCOMPARE(diff.getChangedRowsCount(), 6);
+
+        const CListModelDiff same(oldKeys, oldKeys);
+        QVERIFY(same.isValid());
+        QVERIFY(same.isEmpty());
+        QCOMPARE(same.getChangedRowsCount(), 0);
+    }
+
+    void CTestListModelDiff::reordered()
+    {
+        const CListModelDiff diff({ "A", "B", "C", "D" }, { "D", "A", "E", "C" });
+        QVERIFY(diff.isValid());
+        QVERIFY(diff.isReordered());
+        QCOMPARE(diff.getRemovedRanges(), QVector<CListModelDiff::RowRange>({ { 1, 1 } }));
+        QCOMPARE(diff.getInsertedRanges(), QVector<CListModelDiff::RowRange>({ { 2, 2 } }));
+
+        // after removing B: A, C, D, in new order D, A, C
+        QCOMPARE(diff.getKeptRowsOrder(), QVector<int>({ 1, 2, 0 }));
+    }
+
+    void CTestListModelDiff::changed()
+    {
+        CListModelDiff diff({ "A", "B", "C", "D", "E" }, { "A", "B", "C", "D", "E" });
+        diff.setChangedRows({ 0, 2, 3, 4 });
+        QVERIFY(!diff.isEmpty());
+        QCOMPARE(diff.getChangedRanges(), QVector<CListModelDiff::RowRange>({ { 0, 0 }, { 2, 4 } }));
+        QCOMPARE(diff.getChangedRowsCount(), 4);
+    }
+
+    void CTestListModelDiff::invalid()
+    {
+        QVERIFY(!CListModelDiff().isValid());
+        QVERIFY(!CListModelDiff({}, { "A" }).isValid());
+        QVERIFY(!CListModelDiff({ "A" }, {}).isValid());
+        QVERIFY(!CListModelDiff({ "A", "" }, { "A" }).isValid());
+        QVERIFY(!CListModelDiff({ "A" }, { "A", "" }).isValid());
+        QVERIFY(!CListModelDiff({ "A", "A" }, { "A" }).isValid());
+        QVERIFY(!CListModelDiff({ "A" }, { "A", "A" }).isValid());
+        QVERIFY(!CListModelDiff({ "A" }, { "B", "B" }).isValid());
+
+        // a reset is cheaper than inserting every other row into a large model
+        QStringList oldKeys;
+        QStringList newKeys;
+        for (int i = 0; i < 5000; ++i)
+        {
+            oldKeys.push_back(QString::number(2 * i));
+            newKeys.push_back(QString::number(2 * i));
+            newKeys.push_back(QString::number(2 * i + 1));
+        }
+        QVERIFY(!CListModelDiff(oldKeys, newKeys).isValid());
+        QVERIFY(CListModelDiff(oldKeys.mid(0, 500), newKeys.mid(0, 1000)).isValid());
+    }
+
+    void CTestListModelDiff::updateByDiff_data()
+    {
+        QTest::addColumn<bool>("filtered");
+        QTest::addColumn<QStringList>("oldCallsigns");
+        QTest::addColumn<QStringList>("newCallsigns");
+
+        // displayed rows A, B, C, D become D, A, E, C in both cases
+        QTest::newRow("unfiltered") << false
+                                    << QStringList { "A_TWR", "B_TWR", "C_TWR", "D_TWR" }
+                                    << QStringList { "D_TWR", "A_TWR", "E_TWR", "C_TWR" };
+        QTest::newRow("filtered") << true
+                                  << QStringList { "A_TWR", "X_CTR", "B_TWR", "C_TWR", "D_TWR" }
+                                  << QStringList { "D_TWR", "A_TWR", "Y_CTR", "E_TWR", "C_TWR" };
+    }
+
+    void CTestListModelDiff::updateByDiff()
+    {
+        QFETCH(bool, filtered);
+        QFETCH(QStringList, oldCallsigns);
+        QFETCH(QStringList, newCallsigns);
+
+        CAtcStationListModel model(CAtcStationListModel::StationsOnline);
+        QAbstractItemModelTester tester(&model, QAbstractItemModelTester::FailureReportingMode::QtTest);
+        if (filtered)
+        {
+            std::unique_ptr<IModelFilter<CAtcStationList>> filter(new CTestCenterFilter());
+            model.takeFilterOwnership(filter);
+        }
+        model.update(stations(oldCallsigns), false);
+        QCOMPARE(displayedCallsigns(model), QStringList({ "A_TWR", "B_TWR", "C_TWR", "D_TWR" }));
+
+        const QPersistentModelIndex a = model.index(0, 0);
+        const QPersistentModelIndex b = model.index(1, 0);
+        const QPersistentModelIndex c = model.index(2, 1);
+        const QPersistentModelIndex d = model.index(3, 0);
+
+        QStringList emitted;
+        connect(&model, &QAbstractItemModel::rowsAboutToBeRemoved,  this, [&] { emitted << "aboutToBeRemoved"; });
+        connect(&model, &QAbstractItemModel::rowsRemoved,           this, [&] { emitted << "removed"; });
+        connect(&model, &QAbstractItemModel::layoutAboutToBeChanged, this, [&] { emitted << "layoutAboutToBeChanged"; });
+        connect(&model, &QAbstractItemModel::layoutChanged,         this, [&] { emitted << "layoutChanged"; });
+        connect(&model, &QAbstractItemModel::rowsAboutToBeInserted, this, [&] { emitted << "aboutToBeInserted"; });
+        connect(&model, &QAbstractItemModel::rowsInserted,          this, [&] { emitted << "inserted"; });
+        connect(&model, &QAbstractItemModel::dataChanged,           this, [&] { emitted << "dataChanged"; });
+        connect(&model, &QAbstractItemModel::modelReset,            this, [&] { emitted << "reset"; });
+        QSignalSpy removedSpy(&model, &QAbstractItemModel::rowsRemoved);
+        QSignalSpy insertedSpy(&model, &QAbstractItemModel::rowsInserted);
+        QSignalSpy dataChangedSpy(&model, &QAbstractItemModel::dataChanged);
+
+        // C changed
+        CAtcStationList newStations = stations(newCallsigns);
+        for (CAtcStation &station : newStations)
+        {
+            if (station.getCallsign().asString() == "C_TWR") { station.setFrequency(CFrequency(122.8, CFrequencyUnit::MHz())); }
+        }
+        model.update(newStations, false);
+        model.disconnect(this);
+
+        QCOMPARE(emitted, QStringList({ "aboutToBeRemoved", "removed", "layoutAboutToBeChanged", "layoutChanged", "aboutToBeInserted", "inserted", "dataChanged" }));
+        QCOMPARE(displayedCallsigns(model), QStringList({ "D_TWR", "A_TWR", "E_TWR", "C_TWR" }));
+        QCOMPARE(model.container().size(), newCallsigns.size());
+
+        QCOMPARE(removedSpy.count(), 1);
+        QCOMPARE(removedSpy.first().at(1).toInt(), 1);
+        QCOMPARE(removedSpy.first().at(2).toInt(), 1);
+        QCOMPARE(insertedSpy.count(), 1);
+        QCOMPARE(insertedSpy.first().at(1).toInt(), 2);
+        QCOMPARE(insertedSpy.first().at(2).toInt(), 2);
+        QCOMPARE(dataChangedSpy.count(), 1);
+        const QModelIndex topLeft = dataChangedSpy.first().at(0).value<QModelIndex>();
+        const QModelIndex bottomRight = dataChangedSpy.first().at(1).value<QModelIndex>();
+        QCOMPARE(topLeft.row(), 3);
+        QCOMPARE(topLeft.column(), 0);
+        QCOMPARE(bottomRight.row(), 3);
+        QCOMPARE(bottomRight.column(), model.columnCount() - 1);
+
+        // persistent indexes move with their objects, the removed row is gone
+        QVERIFY(!b.isValid());
+        QCOMPARE(a.row(), 1);
+        QCOMPARE(c.row(), 3);
+        QCOMPARE(c.column(), 1);
+        QCOMPARE(d.row(), 0);
+        QCOMPARE(model.at(a).getCallsign().asString(), QString("A_TWR"));
+        QCOMPARE(model.at(c).getFrequency(), CFrequency(122.8, CFrequencyUnit::MHz()));
+        QCOMPARE(model.at(d).getCallsign().asString(), QString("D_TWR"));
+    }
+
+    CAtcStationList CTestListModelDiff::stations(const QStringList &callsigns)
+    {
+        CAtcStationList stations;
+        for (const QString &callsign : callsigns) { stations.push_back(CAtcStation(callsign)); }
+        return stations;
+    }
+
+    QStringList CTestListModelDiff::displayedCallsigns(const CAtcStationListModel &model)
+    {
+        QStringList callsigns;
+        for (int row = 0; row < model.rowCount(); ++row) { callsigns.push_back(model.at(model.index(row, 0)).getCallsign().asString()); }
+        return callsigns;
+    }
+} // ns
+
+//! main, the model tester reads icons, which requires a QApplication
+int main(int argc, char *argv[])
+{
+    QApplication app(argc, argv);
+    BLACKTEST_INIT(BlackGuiTest::CTestListModelDiff)
+    return QTest::qExec(&to, args);
+}
+
+#include "testlistmodeldiff.moc"
+
+//! \endcond
@@ -0,0 +1,174 @@
+/* Copyright (C) 2020
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \cond PRIVATE_TESTS
+//! \file
+//! \ingroup testblackgui
+
+#include "blackgui/models/listmodelsortkeys.h"
+#include "blackgui/models/statusmessagelistmodel.h"
+#include "blackmisc/propertyindex.h"
+#include "blackmisc/statusmessage.h"
+#include "blackmisc/statusmessagelist.h"
+#include "blackmisc/variant.h"
+#include "test.h"
+
+#include <QDateTime>
+#include <QTest>
+
+using namespace BlackGui::Models;
+using namespace BlackMisc;
+
+namespace BlackGuiTest
+{
+    //! Sorts the messages by a value not like comparePropertyByIndex
+    class CTestUnlikeCompareModel : public CStatusMessageListModel
+    {
+    protected:
+        //! \copydoc CListModelBase::sortValue
+        virtual CVariant sortValue(const CStatusMessage &message, const CPropertyIndex &propertyIndex) const override
+        {
+            Q_UNUSED(propertyIndex)
+            return CVariant::from(message.getMessage().size());
+        }
+    };
+
+    //! Test the precomputed sort keys of list models
+    class CTestListModelSortKeys : public QObject
+    {
+        Q_OBJECT
+
+    private slots:
+        //! Strings compare case sensitive, like as CVariant
+        void strings();
+
+        //! Numbers and timestamps
+        void numbers();
+
+        //! Values without typed keys
+        void variants();
+
+        //! Keys in the order of sorted rows
+        void permuted();
+
+        //! A model using comparePropertyByIndex sorts like comparePropertyByIndex
+        void useCompare();
+
+    private:
+        //! The model sorts the column like comparePropertyByIndex, in both orders
+        static bool isSortedLikeCompare(CStatusMessageListModel &model, const CStatusMessageList &messages, const CPropertyIndex &column);
+    };
+
+    void CTestListModelSortKeys::strings()
+    {
+        const CListModelSortKeys keys({ CVariant::from(QString("b")), CVariant::from(QString("A")), CVariant::from(QString("a")) });
+        QVERIFY(keys.isValid());
+        QCOMPARE(keys.size(), 3);
+        QVERIFY(keys.isLess(1, 0));
+        QVERIFY(keys.isLess(1, 2));
+        QVERIFY(keys.isLess(0, 2));
+        QVERIFY(!keys.isEqual(1, 2));
+        QCOMPARE(keys.isLess(1, 2), CVariant::from(QString("A")) < CVariant::from(QString("a")));
+        QCOMPARE(keys.isLess(0, 2), CVariant::from(QString("b")) < CVariant::from(QString("a")));
+    }
+
+    void CTestListModelSortKeys::numbers()
+    {
+        const CListModelSortKeys integers({ CVariant::from(3), CVariant::from(-1), CVariant::from(3) });
+        QVERIFY(integers.isValid());
+        QVERIFY(integers.isLess(1, 0));
+        QVERIFY(integers.isEqual(0, 2));
+
+        const CListModelSortKeys doubles({ CVariant::from(1.5), CVariant::from(0.5) });
+        QVERIFY(doubles.isValid());
+        QVERIFY(doubles.isLess(1, 0));
+
+        const QDateTime now = QDateTime::currentDateTimeUtc();
+        const CListModelSortKeys timestamps({ CVariant::from(now), CVariant::from(now.addSecs(-10)) });
+        QVERIFY(timestamps.isValid());
+        QVERIFY(timestamps.isLess(1, 0));
+    }
+
+    void CTestListModelSortKeys::variants()
+    {
+        // mixed types have no typed keys, the values are compared as variants
+        const QVector<CVariant> mixed { CVariant::from(QString("1")), CVariant::from(1) };
+        const CListModelSortKeys keys(mixed);
+        QVERIFY(keys.isValid());
+        QCOMPARE(keys.isLess(0, 1), mixed[0] < mixed[1]);
+        QVERIFY(!CListModelSortKeys(QVector<CVariant>()).isValid());
+    }
+
+    void CTestListModelSortKeys::permuted()
+    {
+        const CListModelSortKeys keys({ CVariant::from(30), CVariant::from(10), CVariant::from(20) });
+        const CListModelSortKeys sorted = keys.permuted({ 1, 2, 0 });
+        QVERIFY(sorted.isValid());
+        QVERIFY(sorted.isLess(0, 1));
+        QVERIFY(sorted.isLess(1, 2));
+        QVERIFY(!keys.permuted({ 0, 1 }).isValid());
+    }
+
+    void CTestListModelSortKeys::useCompare()
+    {
+        CStatusMessageList messages;
+        messages.push_back(CStatusMessage(CStatusMessage::SeverityWarning, u"warning"));
+        messages.push_back(CStatusMessage(CStatusMessage::SeverityError, u"error"));
+        messages.push_back(CStatusMessage(CStatusMessage::SeverityInfo, u"info"));
+        messages.push_back(CStatusMessage(CStatusMessage::SeverityDebug, u"debug"));
+
+        // sorted by severity, not by the severity string, for which "error" < "info"
+        CStatusMessageListModel model;
+        QVERIFY(isSortedLikeCompare(model, messages, CStatusMessage::IndexSeverityAsIcon));
+        model.setSortColumnByPropertyIndex(CStatusMessage::IndexSeverityAsIcon);
+        const CStatusMessageList ascending = model.sortContainerByColumn(messages, model.getSortColumn(), Qt::AscendingOrder);
+        QCOMPARE(ascending.front().getSeverity(), CStatusMessage::SeverityDebug);
+        QCOMPARE(ascending.back().getSeverity(), CStatusMessage::SeverityError);
+
+        // the values of the message column sort like comparePropertyByIndex
+        QVERIFY(isSortedLikeCompare(model, messages, CStatusMessage::IndexMessage));
+
+        // values sorting unlike comparePropertyByIndex are detected, and the column is sorted by comparePropertyByIndex
+        const CPropertyIndex severity(CStatusMessage::IndexSeverityAsString);
+        const CStatusMessageList byString = messages.sorted([&](const CStatusMessage &a, const CStatusMessage &b)
+        {
+            return a.getSeverityAsString() < b.getSeverityAsString();
+        });
+        QVector<CVariant> strings;
+        for (const CStatusMessage &message : byString) { strings.push_back(CVariant::from(message.getSeverityAsString())); }
+        QVERIFY(!Private::isSortedLikeCompare(byString, CListModelSortKeys(strings), Qt::AscendingOrder, severity, std::true_type()));
+
+        CTestUnlikeCompareModel unlikeModel;
+        QVERIFY(isSortedLikeCompare(unlikeModel, messages, CStatusMessage::IndexMessage));
+        QVERIFY(isSortedLikeCompare(unlikeModel, messages, CStatusMessage::IndexMessage));
+    }
+
+    bool CTestListModelSortKeys::isSortedLikeCompare(CStatusMessageListModel &model, const CStatusMessageList &messages, const CPropertyIndex &column)
+    {
+        model.setSortColumnByPropertyIndex(column);
+        if (!model.hasValidSortColumn()) { return false; }
+        for (Qt::SortOrder order : { Qt::AscendingOrder, Qt::DescendingOrder })
+        {
+            const CStatusMessageList sorted = model.sortContainerByColumn(messages, model.getSortColumn(), order);
+            const CStatusMessageList expected = messages.sorted([&](const CStatusMessage &a, const CStatusMessage &b)
+            {
+                const int c = a.comparePropertyByIndex(column, b);
+                return (order == Qt::AscendingOrder) ? (c < 0) : (c > 0);
+            });
+            if (!(sorted == expected)) { return false; }
+        }
+        return true;
+    }
+} // ns
+
+//! main
+BLACKTEST_APPLESS_MAIN(BlackGuiTest::CTestListModelSortKeys);
+
+#include "testlistmodelsortkeys.moc"
+
+//! \endcond
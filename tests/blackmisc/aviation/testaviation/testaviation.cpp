@@ -16,6 +16,8 @@
 #include "blackmisc/aviation/altitude.h"
 #include "blackmisc/aviation/atcstation.h"
 #include "blackmisc/aviation/callsign.h"
+#include "blackmisc/aviation/callsignidmap.h"
+#include "blackmisc/aviation/callsigninterner.h"
 #include "blackmisc/aviation/callsignset.h"
 #include "blackmisc/aviation/comsystem.h"
 #include "blackmisc/aviation/heading.h"
@@ -67,6 +69,9 @@ namespace BlackMiscTest
         //! Callsigns and callsign containers
         void callsignWithContainers();
 
+        //! Interned callsign ids and the id based map
+        void callsignInterner();
+
         //! Testing copying and equality of objects
         void copyAndEqual();
 
@@ -212,6 +217,46 @@ namespace BlackMiscTest
         QVERIFY2(set.size() == 0, "Last should be gone");
     }
 
+    void CTestAviation::callsignInterner()
+    {
+        const CCallsign cs1("TESTIDA");
+        const CCallsign cs2("TESTIDB");
+        const CCallsign cs3("TESTIDC");
+        QVERIFY2(CCallsignInterner::findId(CCallsign("TESTIDX")) == CCallsignInterner::InvalidId, "Never interned");
+
+        const int id1 = CCallsignInterner::id(cs1);
+        const int id2 = CCallsignInterner::id(cs2);
+        QVERIFY2(id1 >= 0 && id2 >= 0 && id1 != id2, "Distinct valid ids");
+        QVERIFY2(CCallsignInterner::id(cs1) == id1, "Ids are stable");
+        QVERIFY2(CCallsignInterner::findId(CCallsign("testida")) == id1, "Same id for equal callsigns");
+        QVERIFY2(CCallsignInterner::callsign(id2) == cs2, "Callsign from id");
+        QVERIFY2(CCallsignInterner::callsign(CCallsignInterner::InvalidId).isEmpty(), "Empty callsign for invalid id");
+        QVERIFY2(CCallsignInterner::size() > id2, "Size is upper bound of ids");
+
+        CCallsignIdMap<int> map;
+        QVERIFY2(map.isEmpty(), "Empty map");
+        map.insert(cs1, 1);
+        map.insert(cs2, 2);
+        map[cs3] = 3;
+        QVERIFY2(map.size() == 3, "3 values");
+        QVERIFY2(map.contains(id1) && map.contains(cs3), "Contains by id and callsign");
+        QVERIFY2(map.value(id2) == 2 && map.value(cs3) == 3, "Values by id and callsign");
+        QVERIFY2(map.value(CCallsign("TESTIDX"), -1) == -1, "Default value for unknown callsign");
+
+        // removing the first value moves the last one into the gap
+        QVERIFY2(map.remove(cs1) == 1, "Removed");
+        QVERIFY2(map.remove(cs1) == 0, "Already removed");
+        QVERIFY2(map.size() == 2 && !map.contains(id1), "2 values left");
+        QVERIFY2(map.value(cs2) == 2 && map.value(cs3) == 3, "Remaining values unchanged");
+        QVERIFY2(map.keys().size() == 2 && map.keys().contains(cs3), "Keys");
+
+        int sum = 0;
+        for (int v : map) { sum += v; }
+        QVERIFY2(sum == 5, "Iterate values");
+        map.clear();
+        QVERIFY2(map.isEmpty() && !map.contains(cs2), "Cleared");
+    }
+
     void CTestAviation::copyAndEqual()
     {
         const CFrequency f1(123.45, CFrequencyUnit::MHz());
@@ -9,6 +9,7 @@ SUBDIRS += \
     simulation \
     testcompress \
     testcontainers \
+    testdatacache \
     testdatastream \
     testdbus \
     testicon \
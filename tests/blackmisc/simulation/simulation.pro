@@ -1,5 +1,6 @@
 TEMPLATE = subdirs
 SUBDIRS += \
+    testaircraftmodelsetindex \
     testinterpolatorlinear \
     testinterpolatormisc \
     testinterpolatorparts \
@@ -0,0 +1,229 @@
+/* Copyright (C) 2020
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \cond PRIVATE_TESTS
+//! \file
+//! \ingroup testblackmisc
+
+#include "blackmisc/simulation/aircraftmodelsetindex.h"
+#include "blackmisc/simulation/aircraftmodelscoring.h"
+#include "blackmisc/simulation/aircraftmodellist.h"
+#include "blackmisc/simulation/aircraftmodel.h"
+#include "blackmisc/aviation/aircrafticaocode.h"
+#include "blackmisc/aviation/airlineicaocode.h"
+#include "blackmisc/aviation/livery.h"
+#include "blackmisc/statusmessagelist.h"
+#include "test.h"
+
+#include <QCoreApplication>
+#include <QList>
+#include <QStringList>
+#include <QTest>
+#include <QThreadPool>
+#include <QVector>
+
+using namespace BlackMisc;
+using namespace BlackMisc::Aviation;
+using namespace BlackMisc::Simulation;
+
+namespace BlackMiscTest
+{
+    //! Model set index tests
+    class CTestAircraftModelSetIndex : public QObject
+    {
+        Q_OBJECT
+
+    private slots:
+        //! Index finders yield the same models as the list finders
+        void sameAsListFinders();
+
+        //! Exact model string and alias lookup
+        void modelStringOrAlias();
+
+        //! Index only used for the indexed list
+        void isIndexOf();
+
+        //! Top-K scoring yields the same best models as full scoring
+        void scoring();
+
+    private:
+        //! Test set with overlapping designators, airlines and liveries
+        static CAircraftModelList testModels();
+    };
+
+    void CTestAircraftModelSetIndex::sameAsListFinders()
+    {
+        const CAircraftModelList models = testModels();
+        const CAircraftModelSetIndex index(models);
+        QCOMPARE(index.size(), models.sizeInt());
+
+        const QStringList designators({ "B737", "A320", "H145", "C172", "XXXX", "" });
+        const QStringList airlines({ "DLH", "AFR", "EWG", "" });
+        for (const QString &d : designators)
+        {
+            for (const QString &a : airlines)
+            {
+                const CAircraftIcaoCode aircraft(d);
+                const CAirlineIcaoCode airline(a);
+                QVERIFY2(index.findByIcaoDesignators(aircraft, airline) == models.findByIcaoDesignators(aircraft, airline), qPrintable(d + "/" + a));
+                const QString code = CLivery::getStandardCode(airline);
+                QVERIFY(index.findByAircraftDesignatorAndLiveryCombinedCode(d, code) == models.findByAircraftDesignatorAndLiveryCombinedCode(d, code));
+                QVERIFY(index.findByAircraftDesignatorAndLiveryCombinedCode(d.toLower(), code.toLower()) == models.findByAircraftDesignatorAndLiveryCombinedCode(d.toLower(), code.toLower()));
+            }
+        }
+
+        for (const QString &ct : { "L2J", "H1T", "L1P", "L2*", "L-J", "*1*", "l2j", "XX", "" })
+        {
+            QVERIFY2(index.findByCombinedType(ct) == models.findByCombinedType(ct), qPrintable(ct));
+            QVERIFY2(index.findByCombinedTypeWithColorLivery(ct) == models.findByCombinedTypeWithColorLivery(ct), qPrintable(ct));
+            for (const QString &m : { "Boeing", "AIRBUS", "Cessna", "" })
+            {
+                QVERIFY2(index.findByCombinedAndManufacturer(ct, m) == models.findByCombinedAndManufacturer(ct, m), qPrintable(ct + "/" + m));
+            }
+        }
+
+        for (const QString &f : { "B737", "a320", "H145", "" })
+        {
+            QVERIFY2(index.findByFamily(f) == models.findByFamily(f), qPrintable(f));
+        }
+
+        for (const QString &m : { "Boeing", "AIRBUS", "cessna", "Piper", "" })
+        {
+            QVERIFY2(index.findByManufacturer(m) == models.findByManufacturer(m), qPrintable(m));
+        }
+
+        CAirlineIcaoCode group("DLH");
+        group.setGroupId(1);
+        QVERIFY(index.findByAirlineGroup(group) == models.findByAirlineGroup(group));
+        QVERIFY(!index.findByAirlineGroup(group).isEmpty());
+        QVERIFY(index.findByAirlineGroup(CAirlineIcaoCode("AFR")) == models.findByAirlineGroup(CAirlineIcaoCode("AFR")));
+
+        const CLivery livery(CLivery::getStandardCode(CAirlineIcaoCode("AFR")), CAirlineIcaoCode("AFR"), "Air France");
+        QVERIFY(index.findByLiveryCode(livery) == models.findByLiveryCode(livery));
+        QVERIFY(!index.findByLiveryCode(livery).isEmpty());
+
+        QVERIFY(index.findColorLiveries() == models.findColorLiveries());
+        QVERIFY(index.findByMilitaryFlag(true) == models.findByMilitaryFlag(true));
+        QVERIFY(index.findByMilitaryFlag(false) == models.findByMilitaryFlag(false));
+        QVERIFY(index.findByVtolFlag(true) == models.findByVtolFlag(true));
+        QVERIFY(index.findByVtolFlag(false) == models.findByVtolFlag(false));
+        QCOMPARE(index.containsVtol(), models.containsVtol());
+    }
+
+    void CTestAircraftModelSetIndex::modelStringOrAlias()
+    {
+        const CAircraftModelList models = testModels();
+        const CAircraftModelSetIndex index(models);
+        for (const QString &ms : { "MODEL 3", "model 3", "ALIAS 4", "alias 4", "MODEL 99", "" })
+        {
+            const CAircraftModel fromIndex = index.findFirstByModelStringAliasOrDefault(ms);
+            const CAircraftModel fromList = models.findFirstByModelStringAliasOrDefault(ms);
+            QVERIFY2(fromIndex == fromList, qPrintable(ms));
+        }
+        QCOMPARE(index.findFirstByModelStringAliasOrDefault("alias 4").getModelString(), QString("MODEL 4"));
+    }
+
+    void CTestAircraftModelSetIndex::isIndexOf()
+    {
+        const CAircraftModelList models = testModels();
+        const CAircraftModelSetIndex index(models);
+        const CAircraftModelList copy(models);
+        QVERIFY(index.isIndexOf(models));
+        QVERIFY(index.isIndexOf(copy));
+        QVERIFY(index.isIndexOf(index.getModels()));
+
+        CAircraftModelList modified(models);
+        modified.pop_back();
+        QVERIFY(!index.isIndexOf(modified));
+        QVERIFY(!index.isIndexOf(testModels())); // equal, but not the indexed list
+        QVERIFY(!index.isIndexOf(CAircraftModelList()));
+    }
+
+    void CTestAircraftModelSetIndex::scoring()
+    {
+        const CAircraftModelList models = testModels();
+        const CAircraftModelSetIndex index(models);
+        QThreadPool pool;
+        for (const QString &d : { "B737", "A321", "H145", "XXXX" })
+        {
+            for (const QString &a : { "DLH", "AFR", "" })
+            {
+                const CAirlineIcaoCode airline(a);
+                const CLivery livery(CLivery::getStandardCode(airline), airline, "livery");
+                const CAircraftModel remoteModel("REMOTE", CAircraftModel::TypeQueriedFromNetwork, "", CAircraftIcaoCode(d), livery);
+                for (bool ignoreZeros : { false, true })
+                {
+                    const ScoredModels full = models.scoreFull(remoteModel, true, ignoreZeros);
+                    const int maxScore = full.lastKey();
+                    const CAircraftModelList maxScoreModels(full.values(maxScore));
+                    const QList<int> fullScores = full.keys(); // ascending
+                    QVector<int> expectedTopScores;
+                    for (int i = fullScores.size() - 1; i >= 0 && expectedTopScores.size() < 5; i--) { expectedTopScores.push_back(fullScores.at(i)); }
+
+                    CAircraftModelScoring withIndex;
+                    withIndex.score(models, &index, remoteModel, true, ignoreZeros, &pool, nullptr);
+                    CAircraftModelScoring withoutIndex;
+                    withoutIndex.score(models, nullptr, remoteModel, true, ignoreZeros, nullptr, nullptr);
+                    CStatusMessageList log;
+                    CAircraftModelScoring withLog;
+                    withLog.score(models, &index, remoteModel, true, ignoreZeros, &pool, &log);
+                    QVERIFY(!log.isEmpty());
+                    QCOMPARE(withLog.getScoredCount(), full.size());
+
+                    for (const CAircraftModelScoring *scoring : { &withIndex, &withoutIndex, &withLog })
+                    {
+                        QCOMPARE(scoring->getMaxScore(), maxScore);
+                        QVERIFY2(scoring->getMaxScoreModels() == maxScoreModels, qPrintable(d + "/" + a));
+                        QCOMPARE(scoring->getTopScores().front().score, maxScore);
+
+                        // skipped models do not change the top scores
+                        QVector<int> topScores;
+                        for (const CAircraftModelScoring::ScoredPosition &scored : scoring->getTopScores()) { topScores.push_back(scored.score); }
+                        QCOMPARE(topScores, expectedTopScores);
+                    }
+                }
+            }
+        }
+    }
+
+    CAircraftModelList CTestAircraftModelSetIndex::testModels()
+    {
+        const QStringList designators({ "B737", "B738", "A320", "A321", "H145", "C172" });
+        const QStringList families({ "B737", "B737", "A320", "A320", "", "" });
+        const QStringList combinedTypes({ "L2J", "L2J", "L2J", "L2J", "H1T", "L1P" });
+        const QStringList manufacturers({ "BOEING", "BOEING", "AIRBUS", "AIRBUS", "AIRBUS", "CESSNA" });
+        const QStringList airlines({ "DLH", "AFR", "EWG", "" });
+
+        CAircraftModelList models;
+        for (int i = 0; i < 48; i++)
+        {
+            const int a = i % designators.size();
+            const bool military = (i % 11) == 0;
+            const CAircraftIcaoCode aircraft(designators.at(a), "", families.at(a), combinedTypes.at(a), manufacturers.at(a), "", "", "", "M", true, false, military, 0);
+
+            CAirlineIcaoCode airline(airlines.at((i / 2) % airlines.size()));
+            if (airline.getDesignator() == "DLH" || airline.getDesignator() == "EWG") { airline.setGroupId(1); }
+
+            const bool color = airline.getDesignator().isEmpty() || (i % 5) == 0;
+            const QString liveryCode = color ? CLivery::colorLiveryMarker() + QStringLiteral("FFFFFF") : CLivery::getStandardCode(airline);
+            const CLivery livery(liveryCode, airline, "livery");
+
+            CAircraftModel model(QStringLiteral("MODEL %1").arg(i), CAircraftModel::TypeOwnSimulatorModel, "model", aircraft, livery);
+            if (i % 4 == 0) { model.setModelStringAlias(QStringLiteral("ALIAS %1").arg(i)); }
+            models.push_back(model);
+        }
+        return models;
+    }
+} // namespace
+
+//! main
+BLACKTEST_MAIN(BlackMiscTest::CTestAircraftModelSetIndex);
+
+#include "testaircraftmodelsetindex.moc"
+
+//! \endcond
@@ -30,6 +30,7 @@
 #include "blackmisc/pq/speed.h"
 #include "blackmisc/pq/units.h"
 #include "blackmisc/mixin/mixincompare.h"
+#include "blackmisc/test/testing.h"
 #include "test.h"
 
 #include <QCoreApplication>
@@ -45,6 +46,7 @@ using namespace BlackMisc::Aviation;
 using namespace BlackMisc::Geo;
 using namespace BlackMisc::PhysicalQuantities;
 using namespace BlackMisc::Simulation;
+using namespace BlackMisc::Test;
 
 namespace BlackMiscTest
 {
@@ -61,9 +63,6 @@ namespace BlackMiscTest
         void pbhInterpolatorTest();
 
     private:
-        //! Test situation for testing
-        static BlackMisc::Aviation::CAircraftSituation getTestSituation(const BlackMisc::Aviation::CCallsign &callsign, int number, qint64 ts, qint64 deltaT, qint64 offset);
-
         //! Test parts
         static BlackMisc::Aviation::CAircraftParts getTestParts(int number, qint64 ts, qint64 deltaT);
     };
@@ -81,7 +80,7 @@ namespace BlackMiscTest
         const qint64 offset = 5000; // ms
         for (int i = IRemoteAircraftProvider::MaxSituationsPerCallsign - 1; i >= 0; i--)
         {
-            const CAircraftSituation s(getTestSituation(cs, i, ts, deltaT, offset));
+            const CAircraftSituation s(CTesting::getTestSituation(cs, i, ts, deltaT, offset));
 
             // check height above ground
             CLength hag = (s.getAltitude() - s.getGroundElevation());
@@ -181,8 +180,8 @@ namespace BlackMiscTest
     void CTestInterpolatorLinear::pbhInterpolatorTest()
     {
         const CCallsign cs("SWIFT");
-        CAircraftSituation s1 = getTestSituation(cs, 0, 0, 0, 0);
-        CAircraftSituation s2 = getTestSituation(cs, 5000, 0, 0, 0);
+        CAircraftSituation s1 = CTesting::getTestSituation(cs, 0, 0, 0, 0);
+        CAircraftSituation s2 = CTesting::getTestSituation(cs, 5000, 0, 0, 0);
         const CHeading heading1(0, CHeading::True, CAngleUnit::deg());
         const CHeading heading2(120, CHeading::True, CAngleUnit::deg());
         s1.setHeading(heading1);
@@ -320,24 +319,6 @@ namespace BlackMiscTest
         }
     }
 
-    CAircraftSituation CTestInterpolatorLinear::getTestSituation(const CCallsign &callsign, int number, qint64 ts, qint64 deltaT, qint64 offset)
-    {
-        const CAltitude alt(number, CAltitude::MeanSeaLevel, CLengthUnit::m());
-        const CLatitude lat(number, CAngleUnit::deg());
-        const CLongitude lng(180.0 + number, CAngleUnit::deg());
-        const CHeading heading(number * 10, CHeading::True, CAngleUnit::deg());
-        const CAngle bank(number, CAngleUnit::deg());
-        const CAngle pitch(number, CAngleUnit::deg());
-        const CSpeed gs(number * 10, CSpeedUnit::km_h());
-        const CAltitude gndElev({ 0, CLengthUnit::m() }, CAltitude::MeanSeaLevel);
-        const CCoordinateGeodetic c(lat, lng, alt);
-        CAircraftSituation s(callsign, c, heading, pitch, bank, gs);
-        s.setGroundElevation(gndElev, CAircraftSituation::Test);
-        s.setMSecsSinceEpoch(ts - deltaT * number); // values in past
-        s.setTimeOffsetMs(offset);
-        return s;
-    }
-
     CAircraftParts CTestInterpolatorLinear::getTestParts(int number, qint64 ts, qint64 deltaT)
     {
         CAircraftLights l(true, false, true, false, true, false);
@@ -11,19 +11,35 @@
 //! \ingroup testblackmisc
 
 #include "blackmisc/aviation/aircraftsituation.h"
+#include "blackmisc/aviation/altitude.h"
+#include "blackmisc/aviation/heading.h"
+#include "blackmisc/geo/latitude.h"
+#include "blackmisc/geo/longitude.h"
 #include "blackmisc/simulation/interpolationrenderingsetup.h"
+#include "blackmisc/simulation/aircraftsituationbuffer.h"
+#include "blackmisc/simulation/interpolationbatch.h"
+#include "blackmisc/simulation/interpolatorlinear.h"
+#include "blackmisc/simulation/interpolatorspline.h"
+#include "blackmisc/simulation/remoteaircraftproviderdummy.h"
+#include "blackmisc/simulation/situationsample.h"
+#include "blackmisc/parallelfor.h"
+#include "blackmisc/range.h"
+#include "blackmisc/test/testing.h"
 #include "test.h"
 
-
-
-#include <QDebug>
+#include <QList>
 #include <QTest>
-#include <QtDebug>
+#include <QThread>
+#include <QThreadPool>
+#include <QVector>
+#include <atomic>
 
+using namespace BlackMisc;
 using namespace BlackMisc::Aviation;
 using namespace BlackMisc::Geo;
 using namespace BlackMisc::PhysicalQuantities;
 using namespace BlackMisc::Simulation;
+using namespace BlackMisc::Test;
 
 namespace BlackMiscTest
 {
@@ -38,6 +54,47 @@ namespace BlackMiscTest
 
         //! Equal situations
         void equalSituationTests();
+
+        //! Situation buffer snapshots
+        void situationBufferTests();
+
+        //! Situation samples used by the interpolators
+        void situationSampleTests();
+
+        //! Batched interpolation yields the same situations
+        void interpolationBatchTests();
+
+        //! Benchmark, interpolation of all aircraft in one step
+        void interpolationCostPerAircraft_data();
+
+        //! Benchmark, interpolation of all aircraft in one step
+        void interpolationCostPerAircraft();
+
+        //! Benchmark, PBH, position and altitude of a given linear interpolant
+        void linearKernelCost();
+
+    private:
+        //! Add test situations of the given aircraft to the provider
+        static void addTestAircraft(CRemoteAircraftProviderDummy &provider, int aircraftCount, qint64 ts, qint64 deltaT, qint64 offset);
+
+        //! Benchmark interpolating the given number of aircraft, returns the interpolations of one pass
+        //! \param pool prepare and interpolate in parallel, nullptr sequentially
+        template <class Interpolator>
+        static int benchmarkInterpolation(CRemoteAircraftProviderDummy &provider, int aircraftCount, bool batched, QThreadPool *pool, qint64 from, qint64 to, qint64 step);
+
+        //! Interpolate all aircraft in steps, returns the number of interpolated situations
+        template <class Interpolator>
+        static int interpolateAll(QList<Interpolator *> &interpolators, qint64 from, qint64 to, qint64 step);
+
+        //! Interpolate all aircraft in steps with a CInterpolationBatch, returns the number of interpolated situations
+        //! \param pool prepare and interpolate in parallel, nullptr sequentially
+        template <class Interpolator>
+        static int interpolateAllBatched(QList<Interpolator *> &interpolators, qint64 from, qint64 to, qint64 step, QThreadPool *pool = nullptr);
+
+        //! Same situations interpolated one by one and batched?
+        //! \param pool prepare and interpolate the batched ones in parallel, nullptr sequentially
+        template <class Interpolator>
+        static bool isSameAsBatched(QList<Interpolator *> &interpolators, QList<Interpolator *> &batchedInterpolators, qint64 from, qint64 to, qint64 step, QThreadPool *pool = nullptr);
     };
 
     void CTestInterpolatorMisc::setupTests()
@@ -125,6 +182,323 @@ namespace BlackMiscTest
             QVERIFY2(!s1.equalPbhVectorAltitude(s2), "Heading test, expect same PHB/Vector/Altitude");
         }
     }
+
+    void CTestInterpolatorMisc::situationBufferTests()
+    {
+        CAircraftSituationBuffer buffer(3);
+        QVERIFY2(buffer.epoch() == 0, "Nothing published");
+        QVERIFY2(buffer.situations().isEmpty(), "Empty");
+
+        const CCoordinateGeodetic geoPos = CCoordinateGeodetic::fromWgs84("48° 21′ 13″ N", "11° 47′ 09″ E", { 1487, CLengthUnit::ft() });
+        for (int i = 0; i < 5; i++)
+        {
+            CAircraftSituation situation(CCallsign("DAMBZ"), geoPos);
+            situation.setMSecsSinceEpoch(1000 * (i + 1));
+            const bool published = buffer.modify([&](CAircraftSituationBuffer::Snapshot &snapshot)
+            {
+                snapshot.situations.push_front(situation);
+                snapshot.latest = situation;
+                return true;
+            }, 100 + i);
+            QVERIFY2(published, "Published");
+        }
+
+        const auto snapshot = buffer.read();
+        QVERIFY2(snapshot->epoch == 5, "One epoch per modification");
+        QVERIFY2(snapshot->situations.size() == 3, "Cut off at capacity");
+        QVERIFY2(snapshot->situations.front().getMSecsSinceEpoch() == 5000, "Latest first");
+        QVERIFY2(snapshot->latest.getMSecsSinceEpoch() == 5000, "Latest situation");
+        QVERIFY2(snapshot->lastModified == 104, "Last modified");
+
+        // not published, nothing changes
+        QVERIFY2(!buffer.modify([](CAircraftSituationBuffer::Snapshot &s) { s.situations.clear(); return false; }, 200), "Not published");
+        QVERIFY2(buffer.epoch() == 5 && buffer.situations().size() == 3, "Unchanged");
+
+        // a snapshot taken before stays as it is
+        buffer.clear();
+        QVERIFY2(buffer.situations().isEmpty() && buffer.epoch() == 6, "Cleared");
+        QVERIFY2(snapshot->situations.size() == 3 && snapshot->epoch == 5, "Old snapshot unchanged");
+    }
+
+    void CTestInterpolatorMisc::situationSampleTests()
+    {
+        const CAircraftSituation situation = CTesting::getTestSituation("DAMBZ", 2, 1425000000000, 5000, 3000);
+        const SituationSample sample = SituationSample::fromSituation(situation);
+        QVERIFY2(sample.normalVector == situation.normalVectorDouble(), "Same position");
+        QVERIFY2(qFuzzyCompare(sample.altitudeFt, situation.getCorrectedAltitude().value(CLengthUnit::ft())), "Same corrected altitude");
+        QVERIFY2(qFuzzyCompare(sample.headingDeg, situation.getHeading().value(CAngleUnit::deg())), "Same heading");
+        QVERIFY2(sample.adjustedMsSinceEpoch == situation.getAdjustedMSecsSinceEpoch(), "Same adjusted time");
+
+        QVERIFY2(qFuzzyCompare(SituationSample::interpolateAngleDeg(-30, 30, 0.5) + 1.0, 1.0), "Via 0");
+        QVERIFY2(qFuzzyCompare(SituationSample::interpolateAngleDeg(170, -170, 0.5), 180.0), "Via 180");
+        QVERIFY2(qFuzzyCompare(SituationSample::interpolateAngleDeg(10, 20, 2.0), 20.0), "No extrapolation");
+        QVERIFY2(qFuzzyCompare(SituationSample::interpolateLinear(100, 200, 0.25), 125.0), "Linear");
+    }
+
+    void CTestInterpolatorMisc::interpolationBatchTests()
+    {
+        constexpr int aircraftCount = 5;
+        const qint64 ts = 1425000000000;
+        const qint64 deltaT = 5000;
+        const qint64 offset = 5000;
+
+        CRemoteAircraftProviderDummy provider;
+        addTestAircraft(provider, aircraftCount, ts, deltaT, offset);
+        QList<CInterpolatorLinear *> linearInterpolators, linearBatchedInterpolators;
+        QList<CInterpolatorSpline *> splineInterpolators, splineBatchedInterpolators;
+        for (int a = 0; a < aircraftCount; a++)
+        {
+            const CCallsign cs(QStringLiteral("SWIFT%1").arg(a));
+            linearInterpolators.push_back(new CInterpolatorLinear(cs, nullptr, nullptr, &provider));
+            linearBatchedInterpolators.push_back(new CInterpolatorLinear(cs, nullptr, nullptr, &provider));
+            splineInterpolators.push_back(new CInterpolatorSpline(cs, nullptr, nullptr, &provider));
+            splineBatchedInterpolators.push_back(new CInterpolatorSpline(cs, nullptr, nullptr, &provider));
+        }
+        for (CInterpolatorLinear *i : as_const(linearInterpolators)) { i->markAsUnitTest(); }
+        for (CInterpolatorLinear *i : as_const(linearBatchedInterpolators)) { i->markAsUnitTest(); }
+        for (CInterpolatorSpline *i : as_const(splineInterpolators)) { i->markAsUnitTest(); }
+        for (CInterpolatorSpline *i : as_const(splineBatchedInterpolators)) { i->markAsUnitTest(); }
+
+        const qint64 from = ts - 2 * deltaT + offset;
+        const qint64 step = deltaT / 20;
+        const bool sameLinear = isSameAsBatched(linearInterpolators, linearBatchedInterpolators, from, ts, step);
+        const bool sameSpline = isSameAsBatched(splineInterpolators, splineBatchedInterpolators, from, ts, step);
+
+        // again with the batched ones prepared and interpolated in parallel
+        QThreadPool pool;
+        pool.setMaxThreadCount(3);
+        for (CInterpolatorLinear *i : as_const(linearInterpolators)) { i->resetLastInterpolation(); }
+        for (CInterpolatorLinear *i : as_const(linearBatchedInterpolators)) { i->resetLastInterpolation(); }
+        for (CInterpolatorSpline *i : as_const(splineInterpolators)) { i->resetLastInterpolation(); }
+        for (CInterpolatorSpline *i : as_const(splineBatchedInterpolators)) { i->resetLastInterpolation(); }
+        const bool sameLinearParallel = isSameAsBatched(linearInterpolators, linearBatchedInterpolators, from, ts, step, &pool);
+        const bool sameSplineParallel = isSameAsBatched(splineInterpolators, splineBatchedInterpolators, from, ts, step, &pool);
+
+        qDeleteAll(linearInterpolators);
+        qDeleteAll(linearBatchedInterpolators);
+        qDeleteAll(splineInterpolators);
+        qDeleteAll(splineBatchedInterpolators);
+        QVERIFY2(sameLinear, "Linear batched");
+        QVERIFY2(sameSpline, "Spline batched");
+        QVERIFY2(sameLinearParallel, "Linear batched in parallel");
+        QVERIFY2(sameSplineParallel, "Spline batched in parallel");
+
+        // each index exactly once, also with more helpers than chunks
+        for (int count : { 1, 7, 100 })
+        {
+            QVector<int> calls(count, 0);
+            std::atomic_int sum { 0 };
+            parallelFor(&pool, count, 4, [&](int i) { calls[i]++; sum += i; });
+            QVERIFY2(!calls.contains(0) && !calls.contains(2), "Each index once");
+            QVERIFY2(sum == count * (count - 1) / 2, "All indexes");
+        }
+
+        // angles the shorter way round
+        CInterpolationBatch batch;
+        const int lane = batch.addLane(0.5);
+        QVERIFY2(lane == 0 && batch.size() == 1, "Added lane");
+        batch.setAngleDeg(lane, CInterpolationBatch::HeadingDeg, 170, -170);
+        batch.setLinear(lane, CInterpolationBatch::AltitudeFt, 100, 200);
+        batch.evaluate();
+        QVERIFY2(qFuzzyCompare(batch.value(lane, CInterpolationBatch::HeadingDeg), 180.0), "Via 180");
+        QVERIFY2(qFuzzyCompare(batch.sample(lane).altitudeFt, 150.0), "Linear");
+        batch.clear();
+        QVERIFY2(batch.isEmpty(), "Cleared");
+    }
+
+    void CTestInterpolatorMisc::interpolationCostPerAircraft_data()
+    {
+        QTest::addColumn<bool>("spline");
+        QTest::addColumn<int>("aircraftCount");
+        QTest::addColumn<bool>("batched");
+        QTest::addColumn<bool>("parallel");
+
+        QTest::newRow("linear")                      << false <<  50 << false << false;
+        QTest::newRow("spline")                      << true  <<  50 << false << false;
+        QTest::newRow("linear batched")              << false <<  50 << true  << false;
+        QTest::newRow("spline batched")              << true  <<  50 << true  << false;
+        QTest::newRow("spline batched 10x")          << true  << 500 << true  << false;
+        QTest::newRow("spline batched 10x parallel") << true  << 500 << true  << true;
+    }
+
+    void CTestInterpolatorMisc::interpolationCostPerAircraft()
+    {
+        // the dummy provider is not the real provider, but the interpolator code per aircraft and step is the same
+        // batched, the frame time per aircraft shall not grow with the number of aircraft
+        QFETCH(bool, spline);
+        QFETCH(int, aircraftCount);
+        QFETCH(bool, batched);
+        QFETCH(bool, parallel);
+
+        const qint64 ts = 1425000000000;
+        const qint64 deltaT = 5000;
+        const qint64 offset = 5000;
+        CRemoteAircraftProviderDummy provider;
+        addTestAircraft(provider, aircraftCount, ts, deltaT, offset);
+
+        // batched in parallel, the calling thread works as well
+        QThreadPool pool;
+        pool.setMaxThreadCount(qMax(1, QThread::idealThreadCount() - 1));
+
+        const qint64 from = ts - 2 * deltaT + offset;
+        const qint64 to   = ts;
+        const qint64 step = deltaT / 20;
+        const int steps = static_cast<int>((to - from + step - 1) / step);
+        const int interpolations = spline ?
+                                   benchmarkInterpolation<CInterpolatorSpline>(provider, aircraftCount, batched, parallel ? &pool : nullptr, from, to, step) :
+                                   benchmarkInterpolation<CInterpolatorLinear>(provider, aircraftCount, batched, parallel ? &pool : nullptr, from, to, step);
+        QCOMPARE(interpolations, aircraftCount * steps);
+    }
+
+    void CTestInterpolatorMisc::linearKernelCost()
+    {
+        const qint64 ts = 1425000000000;
+        const qint64 deltaT = 5000;
+        const qint64 offset = 5000;
+        const CAircraftSituation s1 = CTesting::getTestSituation("SWIFT", 1, ts, deltaT, offset);
+        const CAircraftSituation s0 = CTesting::getTestSituation("SWIFT", 0, ts, deltaT, offset);
+        CInterpolatorLinear::CInterpolant interpolant(s1, s0, 0.0, ts);
+
+        // same situation pair, only the time changes
+        constexpr int kernelSteps = 100;
+        double minAltM = 1000;
+        double maxAltM = -1000;
+        QBENCHMARK
+        {
+            for (int i = 0; i < kernelSteps; i++)
+            {
+                interpolant.setTimes(static_cast<double>(i) / kernelSteps, ts - deltaT + i * deltaT / kernelSteps);
+                const CAircraftSituation situation = interpolant.interpolatePositionAndAltitude(s1, false);
+                const double altM = situation.getAltitude().value(CLengthUnit::m());
+                minAltM = qMin(minAltM, altM);
+                maxAltM = qMax(maxAltM, altM);
+            }
+        }
+
+        // altitudes between the ones of the situations, from 1m down to 0m
+        QVERIFY2(minAltM > -0.001 && maxAltM < 1.001, "Altitude within the situations");
+        QVERIFY2(maxAltM - minAltM > 0.9, "Interpolated over the whole segment");
+
+        interpolant.setTimes(0.5, ts - deltaT / 2);
+        const CAircraftSituation halfway = interpolant.interpolatePositionAndAltitude(s1, false);
+        QVERIFY2(qAbs(halfway.getAltitude().value(CLengthUnit::m()) - 0.5) < 0.001, "Halfway altitude");
+        QVERIFY2(qAbs(interpolant.pbh().getHeading().value(CAngleUnit::deg()) - 5.0) < 0.001, "Halfway heading");
+        QCOMPARE(interpolant.getInterpolatedTime(), ts - deltaT / 2);
+    }
+
+    template <class Interpolator>
+    int CTestInterpolatorMisc::benchmarkInterpolation(CRemoteAircraftProviderDummy &provider, int aircraftCount, bool batched, QThreadPool *pool, qint64 from, qint64 to, qint64 step)
+    {
+        QList<Interpolator *> interpolators;
+        for (int a = 0; a < aircraftCount; a++)
+        {
+            const CCallsign cs(QStringLiteral("SWIFT%1").arg(a));
+            interpolators.push_back(new Interpolator(cs, nullptr, nullptr, &provider));
+            interpolators.back()->markAsUnitTest();
+        }
+
+        int interpolations = 0;
+        QBENCHMARK
+        {
+            interpolations = batched ?
+                             interpolateAllBatched(interpolators, from, to, step, pool) :
+                             interpolateAll(interpolators, from, to, step);
+        }
+        qDeleteAll(interpolators);
+        return interpolations;
+    }
+
+    template <class Interpolator>
+    int CTestInterpolatorMisc::interpolateAll(QList<Interpolator *> &interpolators, qint64 from, qint64 to, qint64 step)
+    {
+        const CInterpolationAndRenderingSetupPerCallsign setup;
+        int interpolations = 0;
+        for (Interpolator *interpolator : as_const(interpolators)) { interpolator->resetLastInterpolation(); }
+        for (qint64 currentTime = from; currentTime < to; currentTime += step)
+        {
+            for (Interpolator *interpolator : as_const(interpolators))
+            {
+                const CInterpolationResult result = interpolator->getInterpolation(currentTime, setup);
+                if (result.getInterpolationStatus().isInterpolated()) { interpolations++; }
+            }
+        }
+        return interpolations;
+    }
+
+    template <class Interpolator>
+    int CTestInterpolatorMisc::interpolateAllBatched(QList<Interpolator *> &interpolators, qint64 from, qint64 to, qint64 step, QThreadPool *pool)
+    {
+        const CInterpolationAndRenderingSetupPerCallsign setup;
+        CInterpolationBatch batch;
+        std::atomic_int interpolations { 0 };
+        const int count = interpolators.size();
+        for (Interpolator *interpolator : as_const(interpolators)) { interpolator->resetLastInterpolation(); }
+        for (qint64 currentTime = from; currentTime < to; currentTime += step)
+        {
+            batch.resize(count);
+            parallelFor(pool, count, 8, [&](int i)
+            {
+                interpolators[i]->prepareBatchedInterpolation(currentTime, setup, i, batch, i);
+            });
+            batch.evaluate();
+            parallelFor(pool, count, 8, [&](int i)
+            {
+                const CInterpolationResult result = interpolators[i]->getBatchedInterpolation(batch);
+                if (result.getInterpolationStatus().isInterpolated()) { interpolations++; }
+            });
+        }
+        return interpolations;
+    }
+
+    template <class Interpolator>
+    bool CTestInterpolatorMisc::isSameAsBatched(QList<Interpolator *> &interpolators, QList<Interpolator *> &batchedInterpolators, qint64 from, qint64 to, qint64 step, QThreadPool *pool)
+    {
+        const CInterpolationAndRenderingSetupPerCallsign setup;
+        CInterpolationBatch batch;
+        const int count = batchedInterpolators.size();
+        QVector<CInterpolationResult> batchedResults(count);
+        for (qint64 currentTime = from; currentTime < to; currentTime += step)
+        {
+            batch.resize(count);
+            parallelFor(pool, count, 1, [&](int i)
+            {
+                batchedInterpolators[i]->prepareBatchedInterpolation(currentTime, setup, i, batch, i);
+            });
+            batch.evaluate();
+            parallelFor(pool, count, 1, [&](int i)
+            {
+                batchedResults[i] = batchedInterpolators[i]->getBatchedInterpolation(batch);
+            });
+            for (int i = 0; i < interpolators.size(); i++)
+            {
+                const CInterpolationResult result = interpolators[i]->getInterpolation(currentTime, setup, i);
+                const CInterpolationResult &batchedResult = batchedResults[i];
+                if (result.getInterpolationStatus().isInterpolated() != batchedResult.getInterpolationStatus().isInterpolated()) { return false; }
+                if (!result.getInterpolationStatus().hasValidSituation()) { continue; }
+
+                const CAircraftSituation &s1 = result.getInterpolatedSituation();
+                const CAircraftSituation &s2 = batchedResult.getInterpolatedSituation();
+                if (s1.calculateGreatCircleDistance(s2).value(CLengthUnit::m()) > 0.01) { return false; }
+                if (qAbs(s1.getAltitude().value(CLengthUnit::ft()) - s2.getAltitude().value(CLengthUnit::ft())) > 0.01) { return false; }
+                if (qAbs(s1.getHeading().value(CAngleUnit::deg()) - s2.getHeading().value(CAngleUnit::deg())) > 0.001) { return false; }
+                if (qAbs(s1.getBank().value(CAngleUnit::deg()) - s2.getBank().value(CAngleUnit::deg())) > 0.001) { return false; }
+                if (s1.isOnGround() != s2.isOnGround()) { return false; }
+            }
+        }
+        return true;
+    }
+
+    void CTestInterpolatorMisc::addTestAircraft(CRemoteAircraftProviderDummy &provider, int aircraftCount, qint64 ts, qint64 deltaT, qint64 offset)
+    {
+        for (int a = 0; a < aircraftCount; a++)
+        {
+            const CCallsign cs(QStringLiteral("SWIFT%1").arg(a));
+            for (int i = IRemoteAircraftProvider::MaxSituationsPerCallsign - 1; i >= 0; i--)
+            {
+                provider.insertNewSituation(CTesting::getTestSituation(cs, i, ts, deltaT, offset));
+            }
+        }
+    }
 } // namespace
 
 //! main
@@ -10,19 +10,29 @@
 //! \file
 //! \ingroup testblackmisc
 
+#include "blackmisc/simulation/xplane/owntelemetry.h"
 #include "blackmisc/simulation/xplane/qtfreeutils.h"
+#include "blackmisc/simulation/xplane/terrainprobequeue.h"
+#include "blackmisc/simulation/xplane/trafficchannel.h"
 #include "blackmisc/simulation/settings/xswiftbussettings.h"
 #include "blackmisc/simulation/settings/xswiftbussettingsqtfree.inc"
 #include "blackmisc/swiftdirectories.h"
 #include "blackmisc/directoryutils.h"
 #include "test.h"
 
+#include <QCoreApplication>
+#include <QHash>
 #include <QTest>
+#include <vector>
 
 using namespace BlackMisc;
 using namespace BlackMisc::Simulation::XPlane::QtFreeUtils;
+using namespace BlackMisc::Simulation::XPlane::TrafficChannel;
 using namespace BlackMisc::Simulation::Settings;
 
+namespace OwnTelemetry = BlackMisc::Simulation::XPlane::OwnTelemetry;
+namespace TerrainProbing = BlackMisc::Simulation::XPlane::TerrainProbing;
+
 namespace BlackMiscTest
 {
     //! X-Plane utils test
@@ -38,6 +48,15 @@ namespace BlackMiscTest
         void acfPropertiesTest();
         void xSwiftBusSettingsTest();
         void qtFreeUtils();
+        void trafficChannel();
+        void trafficChannelSharedMemory();
+        void trafficChannelCost();
+        void ownTelemetry();
+        void terrainProbeQueue();
+
+    private:
+        //! Records of the given planes as the driver writes them
+        static std::vector<Record> testRecords(int planes, int update);
     };
 
     void CTestXPlane::getFileNameTest()
@@ -111,6 +130,7 @@ namespace BlackMiscTest
         s.setMaxDrawDistanceNM(11.11);
         s.setDrawingLabels(false);
         s.setFollowAircraftDistanceM(123);
+        s.setTerrainProbeBudgetUs(2500);
         s.setNightTextureModeQt("FOO");
         s.setCurrentUtcTime();
 
@@ -125,6 +145,7 @@ namespace BlackMiscTest
         QCOMPARE(s.isDrawingLabels(), s2.isDrawingLabels());
         QCOMPARE(s.getDBusServerAddressQt(), s2.getDBusServerAddressQt());
         QCOMPARE(s.getFollowAircraftDistanceM(), s2.getFollowAircraftDistanceM());
+        QCOMPARE(s.getTerrainProbeBudgetUs(), s2.getTerrainProbeBudgetUs());
         QCOMPARE(s.getMSecsSinceEpoch(), s2.getMSecsSinceEpoch());
         QVERIFY2(s2.getNightTextureModeQt() == "foo", "Expect lower case foo");
 
@@ -178,6 +199,232 @@ namespace BlackMiscTest
         vOut = normalizeValue(-190, -180.0, 180.0);
         QVERIFY2(qFuzzyCompare(170, vOut), "Wrong normalize +-180");
     }
+
+    void CTestXPlane::trafficChannel()
+    {
+        std::vector<char> memory(CTrafficChannel::requiredSize(8));
+        CTrafficChannel writer;
+        CTrafficChannel reader;
+        QVERIFY(writer.attach(memory.data(), memory.size(), true, 8));
+        QVERIFY(reader.attach(memory.data(), memory.size(), false));
+        QCOMPARE(reader.getCapacity(), 8u);
+        QVERIFY2(!CTrafficChannel().attach(memory.data(), memory.size(), true, 9), "Not enough memory for 16 records");
+
+        // batches are written as a whole, wrap around the ring
+        for (int update = 0; update < 10; update++)
+        {
+            const std::vector<Record> records = testRecords(5, update);
+            QVERIFY(writer.write(records.data(), 5));
+            QVERIFY2(!writer.write(records.data(), 5), "Only 3 records left");
+
+            std::vector<Record> read;
+            QCOMPARE(reader.read([&](const Record &r) { read.push_back(r); }), 5u);
+            QCOMPARE(read.size(), records.size());
+            for (std::size_t i = 0; i < read.size(); i++)
+            {
+                QCOMPARE(read[i].planeId, records[i].planeId);
+                QCOMPARE(read[i].latitudeDeg, records[i].latitudeDeg);
+                QCOMPARE(read[i].flags, records[i].flags);
+            }
+            QCOMPARE(reader.read([](const Record &) {}), 0u);
+        }
+
+        // a reader needs an initialized channel
+        std::vector<char> empty(CTrafficChannel::requiredSize(8));
+        QVERIFY(!CTrafficChannel().attach(empty.data(), empty.size(), false));
+    }
+
+    void CTestXPlane::trafficChannelSharedMemory()
+    {
+        if (!CTrafficChannel::isSupported()) { QSKIP("No shared memory"); }
+        const std::string name = QStringLiteral("/swift-test-traffic-%1").arg(QCoreApplication::applicationPid()).toStdString();
+        CTrafficChannel writer;
+        QVERIFY(writer.create(name, 100));
+        QCOMPARE(writer.getCapacity(), 128u);
+
+        CTrafficChannel reader;
+        QVERIFY(reader.open(name));
+        const std::vector<Record> records = testRecords(100, 1);
+        QVERIFY(writer.write(records.data(), 100));
+        int count = 0;
+        reader.read([&](const Record &r) { if (r.planeId == records[static_cast<std::size_t>(count)].planeId) { count++; } });
+        QCOMPARE(count, 100);
+
+        // creator removes the name
+        writer.close();
+        QVERIFY(!CTrafficChannel().open(name));
+    }
+
+    void CTestXPlane::trafficChannelCost()
+    {
+        // Benchmark of one update, the stub plane table stands for the XPMP planes of CTraffic
+        constexpr int planes = 500;
+        constexpr int updates = 20;
+        std::vector<char> memory(CTrafficChannel::requiredSize(DefaultCapacity));
+        CTrafficChannel writer;
+        CTrafficChannel reader;
+        QVERIFY(writer.attach(memory.data(), memory.size(), true));
+        QVERIFY(reader.attach(memory.data(), memory.size(), false));
+
+        QHash<quint64, Record> stubPlanes;
+        for (const Record &r : testRecords(planes, 0)) { stubPlanes.insert(r.planeId, r); }
+
+        std::vector<std::vector<Record>> batches;
+        for (int u = 0; u < updates; u++) { batches.push_back(testRecords(planes, u)); }
+
+        int update = 0;
+        std::uint32_t read = 0;
+        QBENCHMARK
+        {
+            const std::vector<Record> &batch = batches[static_cast<std::size_t>(update++ % updates)];
+            QVERIFY(writer.write(batch.data(), static_cast<std::uint32_t>(batch.size())));
+            read = reader.read([&](const Record &r)
+            {
+                const auto it = stubPlanes.find(r.planeId);
+                if (it != stubPlanes.end()) { *it = r; }
+            });
+        }
+        QCOMPARE(read, static_cast<std::uint32_t>(planes));
+        const std::vector<Record> &last = batches[static_cast<std::size_t>((update - 1) % updates)];
+        QCOMPARE(stubPlanes.value(planes - 1).latitudeDeg, last.back().latitudeDeg);
+    }
+
+    void CTestXPlane::ownTelemetry()
+    {
+        OwnTelemetry::Telemetry t1;
+        QVERIFY(t1.isValid());
+        t1.setValue(OwnTelemetry::LatitudeDeg, 48.1);
+        t1.setValue(OwnTelemetry::AltitudeM, 500.0);
+        t1.setInteger(OwnTelemetry::Com1ActiveKhz, 122800);
+        t1.setFlag(OwnTelemetry::OnGroundAll, true);
+        t1.setFlag(OwnTelemetry::LandingLights, true);
+        t1.setEngineN1Percentages({ 20.0, 21.0 });
+        QCOMPARE(t1.engineCount(), static_cast<std::size_t>(2));
+        QCOMPARE(t1.engineN1Percentage(1), 21.0);
+        QVERIFY(t1.hasFlag(OwnTelemetry::OnGroundAll));
+        QVERIFY(!t1.hasFlag(OwnTelemetry::TaxiLights));
+
+        // noise below the tolerance is no change
+        OwnTelemetry::Telemetry t2 = t1;
+        QVERIFY(!t2.isSignificantlyDifferent(t1));
+        t2.setValue(OwnTelemetry::LatitudeDeg, 48.1 + 1e-9);
+        t2.setValue(OwnTelemetry::AltitudeM, 500.001);
+        QVERIFY(!t2.isSignificantlyDifferent(t1));
+
+        t2.setValue(OwnTelemetry::LatitudeDeg, 48.1001);
+        QVERIFY2(t2.isSignificantlyDifferent(t1), "Position changed");
+
+        // any cockpit change is a change
+        t2 = t1;
+        t2.setInteger(OwnTelemetry::Com1ActiveKhz, 122805);
+        QVERIFY(t2.isSignificantlyDifferent(t1));
+        t2 = t1;
+        t2.setFlag(OwnTelemetry::LandingLights, false);
+        QVERIFY(t2.isSignificantlyDifferent(t1));
+        t2 = t1;
+        t2.setEngineN1Percentages({ 20.0 });
+        QVERIFY2(t2.isSignificantlyDifferent(t1), "Engine count changed");
+    }
+
+    //! Fake terrain, elevation from the position, no ground south of the equator
+    class CFakeTerrainProber : public TerrainProbing::ITerrainProber
+    {
+    public:
+        int m_probes = 0;
+
+        virtual TerrainProbing::Result probeTerrain(double latitudeDeg, double longitudeDeg, double altitudeM) override
+        {
+            Q_UNUSED(altitudeM);
+            m_probes++;
+            TerrainProbing::Result result;
+            if (latitudeDeg < 0.0) { return result; }
+            result.elevationM = latitudeDeg + longitudeDeg;
+            result.isWater = longitudeDeg > 10.0;
+            return result;
+        }
+    };
+
+    void CTestXPlane::terrainProbeQueue()
+    {
+        using TerrainProbing::CTerrainProbeQueue;
+        using TerrainProbing::Point;
+        using TerrainProbing::Result;
+
+        CFakeTerrainProber prober;
+        CTerrainProbeQueue queue(&prober, 1e-5, 2);
+        QVector<CTerrainProbeQueue::RequestId> completedIds;
+        std::vector<Result> lastResults;
+        const auto completed = [&](CTerrainProbeQueue::RequestId id, const std::vector<Result> &results)
+        {
+            completedIds.push_back(id);
+            lastResults = results;
+        };
+
+        // same cell and a repeated position are probed once
+        const Point p1 { 1.0, 2.0, 0.0 };
+        const Point p1Nearby { 1.000001, 2.0, 0.0 };
+        const Point p2 { 3.0, 11.0, 0.0 };
+        const Point noGround { -1.0, 0.0, 0.0 };
+        const CTerrainProbeQueue::RequestId r1 = queue.enqueue({ p1, p1Nearby, p2, noGround });
+        const CTerrainProbeQueue::RequestId r2 = queue.enqueue({ p2 });
+        QCOMPARE(queue.getPendingProbeCount(), static_cast<std::size_t>(3));
+        QCOMPARE(queue.getMergedCount(), static_cast<std::uint64_t>(2));
+
+        // zero budget, one probe per frame
+        QCOMPARE(queue.process(std::chrono::microseconds(0), completed), 1);
+        QVERIFY(completedIds.isEmpty());
+        QCOMPARE(queue.process(std::chrono::microseconds(0), completed), 1);
+        QCOMPARE(completedIds, QVector<CTerrainProbeQueue::RequestId>({ r2 }));
+        QCOMPARE(lastResults.front().elevationM, 14.0);
+        QVERIFY(lastResults.front().isWater);
+
+        // r1 completes as a whole, in the order of its points
+        QCOMPARE(queue.process(std::chrono::microseconds(0), completed), 1);
+        QCOMPARE(completedIds, QVector<CTerrainProbeQueue::RequestId>({ r2, r1 }));
+        QCOMPARE(lastResults.size(), static_cast<std::size_t>(4));
+        QCOMPARE(lastResults[0].elevationM, 3.0);
+        QCOMPARE(lastResults[1].elevationM, 3.0);
+        QCOMPARE(lastResults[2].elevationM, 14.0);
+        QVERIFY(!lastResults[3].isHit());
+        QCOMPARE(queue.getPendingRequestCount(), static_cast<std::size_t>(0));
+        QCOMPARE(prober.m_probes, 3);
+
+        // recent hits from the cache, misses are probed again
+        const CTerrainProbeQueue::RequestId r3 = queue.enqueue({ p2, p1, noGround });
+        QCOMPARE(queue.getCacheHitCount(), static_cast<std::uint64_t>(2));
+        QCOMPARE(queue.process(std::chrono::microseconds(1000), completed), 1);
+        QCOMPARE(completedIds.back(), r3);
+        QCOMPARE(prober.m_probes, 4);
+
+        // only hits, completed without probing
+        const CTerrainProbeQueue::RequestId r4 = queue.enqueue({ p2 });
+        QCOMPARE(queue.process(std::chrono::microseconds(1000), completed), 0);
+        QCOMPARE(completedIds.back(), r4);
+
+        // a budget processes more than one cell per frame
+        queue.clearCache();
+        queue.enqueue({ p1, p2 });
+        QCOMPARE(queue.process(std::chrono::seconds(10), completed), 2);
+        QCOMPARE(queue.getPendingRequestCount(), static_cast<std::size_t>(0));
+    }
+
+    std::vector<Record> CTestXPlane::testRecords(int planes, int update)
+    {
+        std::vector<Record> records(static_cast<std::size_t>(planes));
+        for (int p = 0; p < planes; p++)
+        {
+            Record &r = records[static_cast<std::size_t>(p)];
+            r.planeId = static_cast<quint64>(0x1000 + p);
+            r.setFlag(HasPosition, true);
+            r.setFlag(HasTransponder, true);
+            r.setFlag(OnGround, (p + update) % 2 == 0);
+            r.latitudeDeg = 48.0 + p * 0.01 + update * 0.0001;
+            r.longitudeDeg = 11.0 + p * 0.01;
+            r.altitudeFt = 1000.0 + update;
+            r.transponderCode = 7000 + p % 100;
+        }
+        return records;
+    }
 }
 
 //! main
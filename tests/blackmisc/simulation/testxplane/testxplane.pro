@@ -22,6 +22,9 @@ INCLUDEPATH += \
 
 SOURCES += testxplane.cpp
 
+# shm_open for the traffic channel
+unix:!macx: LIBS += -lrt
+
 DESTDIR = $$DestRoot/bin
 
 load(common_post)
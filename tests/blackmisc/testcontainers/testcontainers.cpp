@@ -24,6 +24,7 @@
 #include "blackmisc/range.h"
 #include "blackmisc/registermetadata.h"
 #include "blackmisc/sequence.h"
+#include "blackmisc/spscqueue.h"
 #include "blackmisc/math/mathutils.h"
 #include "test.h"
 
@@ -38,6 +39,7 @@
 #include <algorithm>
 #include <iterator>
 #include <set>
+#include <thread>
 #include <vector>
 
 
@@ -70,6 +72,7 @@ namespace BlackMiscTest
         void dictionaryBasics();
         void timestampList();
         void offsetTimestampList();
+        void spscQueue();
     };
 
     void CTestContainers::initTestCase()
@@ -424,6 +427,55 @@ namespace BlackMiscTest
             }
         }
     }
+
+    void CTestContainers::spscQueue()
+    {
+        CSpscQueue<QString> queue(3);
+        QCOMPARE(queue.capacity(), 4);
+        QVERIFY(queue.isEmpty());
+
+        QString value;
+        QVERIFY(!queue.pop(value));
+        for (int i = 0; i < queue.capacity(); ++i) { QVERIFY(queue.push(QString::number(i))); }
+        QVERIFY2(!queue.push(QStringLiteral("full")), "Queue is full");
+        QCOMPARE(queue.size(), 4);
+
+        // FIFO, also after wrapping around
+        QVERIFY(queue.pop(value));
+        QCOMPARE(value, QStringLiteral("0"));
+        QVERIFY(queue.push(QStringLiteral("4")));
+        for (int i = 1; i <= 4; ++i)
+        {
+            QVERIFY(queue.pop(value));
+            QCOMPARE(value, QString::number(i));
+        }
+        QVERIFY(queue.isEmpty());
+
+        // one producer and one consumer thread
+        constexpr int count = 100000;
+        CSpscQueue<int> numbers(64);
+        std::thread producer([&numbers]
+        {
+            for (int i = 0; i < count;)
+            {
+                if (numbers.push(i)) { ++i; }
+                else { std::this_thread::yield(); }
+            }
+        });
+
+        int expected = 0;
+        bool ordered = true;
+        while (expected < count)
+        {
+            int number = -1;
+            if (!numbers.pop(number)) { std::this_thread::yield(); continue; }
+            ordered = ordered && number == expected;
+            ++expected;
+        }
+        producer.join();
+        QVERIFY2(ordered, "Values in order");
+        QVERIFY(numbers.isEmpty());
+    }
 } //namespace
 
 //! main
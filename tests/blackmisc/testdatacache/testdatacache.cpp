@@ -0,0 +1,115 @@
+/* Copyright (C) 2020
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \cond PRIVATE_TESTS
+//! \file
+//! \ingroup testblackmisc
+
+#include "blackmisc/datacache.h"
+#include "blackmisc/registermetadata.h"
+#include "blackmisc/valuecache.h"
+#include "blackmisc/variant.h"
+#include "test.h"
+
+#include <QDateTime>
+#include <QFile>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QString>
+#include <QTemporaryDir>
+#include <QTest>
+#include <QUuid>
+
+namespace BlackMiscTest
+{
+    using namespace BlackMisc;
+
+    //! Deferred value
+    struct TTestDeferred : public TDataTrait<QString>
+    {
+        //! Key in data cache
+        static const char *key() { return "testdatacache/deferred"; }
+
+        //! Defer loading
+        static constexpr bool isDeferred() { return true; }
+    };
+
+    //! Value loaded when used
+    struct TTestUsed : public TDataTrait<QString>
+    {
+        //! Key in data cache
+        static const char *key() { return "testdatacache/used"; }
+    };
+
+    //! Unit tests for the data cache
+    class CTestDataCache : public QObject
+    {
+        Q_OBJECT
+
+    private slots:
+        //! Store with both values on disk, in a temporary directory
+        void initTestCase();
+
+        //! A deferred value is not loaded by reading it, only once admitted
+        void deferredNotLoadedUntilAdmitted();
+
+    private:
+        QTemporaryDir m_dir;
+    };
+
+    void CTestDataCache::initTestCase()
+    {
+        BlackMisc::registerMetadata();
+        QVERIFY(m_dir.isValid());
+        BlackMisc::setMockCacheRootDirectory(m_dir.path());
+
+        // values saved by another process
+        const qint64 timestamp = QDateTime::currentMSecsSinceEpoch();
+        CValueCachePacket values;
+        values.insert(TTestDeferred::key(), CVariant::from(QString("deferred on disk")), timestamp);
+        values.insert(TTestUsed::key(), CVariant::from(QString("used on disk")), timestamp);
+        CValueCache store(0);
+        store.insertValues(values);
+        QVERIFY(store.saveToFiles(CDataCache::persistentStore()).isSuccess());
+
+        QJsonObject timestamps;
+        timestamps.insert(TTestDeferred::key(), timestamp);
+        timestamps.insert(TTestUsed::key(), timestamp);
+        QJsonObject revision;
+        revision.insert("uuid", QUuid::createUuid().toString());
+        revision.insert("timestamps", timestamps);
+        QFile revisionFile(CDataCache::revisionFileName());
+        QVERIFY(revisionFile.open(QFile::WriteOnly | QFile::Text));
+        QVERIFY(revisionFile.write(QJsonDocument(revision).toJson()) > 0);
+    }
+
+    void CTestDataCache::deferredNotLoadedUntilAdmitted()
+    {
+        CData<TTestDeferred> deferred(this);
+        QVERIFY(!deferred.isAdmitted());
+        QVERIFY(deferred.get().isEmpty());
+
+        // the non-deferred value is loaded, because it is used, the deferred value was read, but not loaded
+        CData<TTestUsed> used(this);
+        QVERIFY(used.isAdmitted());
+        QTRY_COMPARE(used.get(), QString("used on disk"));
+        QVERIFY(deferred.get().isEmpty());
+        QVERIFY(!deferred.isAdmitted());
+
+        deferred.admit();
+        QVERIFY(deferred.isAdmitted());
+        QTRY_COMPARE(deferred.get(), QString("deferred on disk"));
+    }
+} // ns
+
+//! main
+BLACKTEST_MAIN(BlackMiscTest::CTestDataCache);
+
+#include "testdatacache.moc"
+
+//! \endcond
@@ -16,6 +16,7 @@
 #include "blackmisc/dictionary.h"
 #include "blackmisc/identifier.h"
 #include "blackmisc/registermetadata.h"
+#include "blackmisc/simulation/aircraftmodellist.h"
 #include "blackmisc/simulation/simulatedaircraft.h"
 #include "blackmisc/simulation/simulatedaircraftlist.h"
 #include "blackmisc/statusmessage.h"
@@ -29,6 +30,7 @@
 #include <QDir>
 #include <QFileInfo>
 #include <QFlags>
+#include <QJsonDocument>
 #include <QJsonObject>
 #include <QJsonValue>
 #include <QList>
@@ -78,6 +80,18 @@ namespace BlackMiscTest
 
         //! Test saving to and loading from files.
         void saveAndLoad();
+
+        //! Test saving to and loading from binary files.
+        void saveAndLoadBinary();
+
+        //! Test changing from one file per namespace to one file per value.
+        void splitDepthChanged();
+
+        //! Saving one small value next to a model list, one file per namespace or per value.
+        void benchmarkSaveOneValue_data();
+
+        //! Saving one small value next to a model list, one file per namespace or per value.
+        void benchmarkSaveOneValue();
     };
 
     //! Simple class which uses CCached, for testing.
@@ -313,6 +327,152 @@ namespace BlackMiscTest
         QCOMPARE(test2Values, testData);
     }
 
+    void CTestValueCache::saveAndLoadBinary()
+    {
+        CSimulatedAircraftList aircraft({ CSimulatedAircraft("BAW001", {}, {}), CSimulatedAircraft("DLH123", {}, {}) });
+        CAtcStationList atcStations({ CAtcStation("EGLL_TWR") });
+        const CVariantMap testData
+        {
+            { "namespace1/value1", CVariant::from(1) },
+            { "namespace2/aircraft", CVariant::from(aircraft) },
+            { "namespace2/atcstations", CVariant::from(atcStations) }
+        };
+
+        QDir dir(QDir::currentPath() + "/testcachebinary");
+        if (dir.exists()) { dir.removeRecursively(); }
+
+        // Json first, then switched to binary
+        CValueCache jsonCache(1);
+        jsonCache.insertValues({ testData, QDateTime::currentMSecsSinceEpoch() });
+        QVERIFY(jsonCache.saveToFiles(dir.absolutePath()).isSuccess());
+
+        CValueCache cache(1);
+        cache.setBinaryFormat("namespace2/aircraft");
+        QVERIFY(cache.isBinaryFormat("namespace2/aircraft"));
+        QCOMPARE(cache.filenameForKey("namespace2/aircraft"), QString("namespace2/aircraft.bin"));
+        cache.insertValues({ testData, QDateTime::currentMSecsSinceEpoch() });
+        QVERIFY(cache.saveToFiles(dir.absolutePath()).isSuccess());
+
+        const auto files = dir.entryInfoList(QDir::Files, QDir::Name);
+        QCOMPARE(files.size(), 2);
+        QCOMPARE(files[0].fileName(), QString("namespace1.json"));
+        QCOMPARE(files[1].fileName(), QString("namespace2.json"));
+        QVERIFY(QFileInfo::exists(dir.absoluteFilePath("namespace2/aircraft.bin")));
+        QFile jsonFile(dir.absoluteFilePath("namespace2.json"));
+        QVERIFY(jsonFile.open(QFile::ReadOnly | QFile::Text));
+        const QJsonObject json = QJsonDocument::fromJson(jsonFile.readAll()).object();
+        QVERIFY(! json.contains("namespace2/aircraft"));
+        QVERIFY(json.contains("namespace2/atcstations"));
+
+        // header only, then value
+        QString key;
+        QVERIFY(CValueCache::loadFromBinaryFile(dir.absoluteFilePath("namespace2/aircraft.bin"), key, nullptr).isSuccess());
+        QCOMPARE(key, QString("namespace2/aircraft"));
+        CVariant value;
+        QVERIFY(CValueCache::loadFromBinaryFile(dir.absoluteFilePath("namespace2/aircraft.bin"), key, &value).isSuccess());
+        QCOMPARE(value, CVariant::from(aircraft));
+
+        // the binary file is used, not the outdated Json value
+        CValueCache cache2(1);
+        QVERIFY(cache2.loadFromFiles(dir.absolutePath()).isSuccess());
+        QCOMPARE(cache2.getAllValues(), testData);
+
+        // back to Json
+        QVERIFY(cache2.saveToFiles(dir.absolutePath()).isSuccess());
+        QVERIFY(! QFileInfo::exists(dir.absoluteFilePath("namespace2/aircraft.bin")));
+        CValueCache cache3(1);
+        QVERIFY(cache3.loadFromFiles(dir.absolutePath()).isSuccess());
+        QCOMPARE(cache3.getAllValues(), testData);
+
+        // incomplete file
+        QVERIFY(cache.saveToFiles(dir.absolutePath()).isSuccess());
+        QFile binaryFile(dir.absoluteFilePath("namespace2/aircraft.bin"));
+        QVERIFY(binaryFile.open(QFile::ReadWrite));
+        QVERIFY(binaryFile.resize(binaryFile.size() - 1));
+        binaryFile.close();
+        QVERIFY(CValueCache::loadFromBinaryFile(binaryFile.fileName(), key, &value).isFailure());
+    }
+
+    void CTestValueCache::splitDepthChanged()
+    {
+        CAtcStationList atcStations({ CAtcStation("EGLL_TWR") });
+        const CVariantMap testData
+        {
+            { "namespace1/value1", CVariant::from(1) },
+            { "namespace1/value2", CVariant::from(2) },
+            { "namespace2/atcstations", CVariant::from(atcStations) }
+        };
+
+        QDir dir(QDir::currentPath() + "/testcachesplit");
+        if (dir.exists()) { dir.removeRecursively(); }
+        CValueCache namespaceCache(1);
+        namespaceCache.insertValues({ testData, QDateTime::currentMSecsSinceEpoch() });
+        QVERIFY(namespaceCache.saveToFiles(dir.absolutePath()).isSuccess());
+
+        // values in the namespace files are loaded
+        CValueCache cache(0);
+        QCOMPARE(cache.filenameForKey("namespace1/value1"), QString("namespace1/value1.json"));
+        QVERIFY(cache.loadFromFiles(dir.absolutePath()).isSuccess());
+        QCOMPARE(cache.getAllValues(), testData);
+
+        // and moved to their own files when saved
+        cache.insertValues({ CVariantMap { { "namespace1/value1", CVariant::from(10) } }, QDateTime::currentMSecsSinceEpoch() });
+        QVERIFY(cache.saveToFiles(dir.absolutePath(), QStringList { "namespace1/value1" }).isSuccess());
+        QVERIFY(QFileInfo::exists(dir.absoluteFilePath("namespace1/value1.json")));
+        QVERIFY(QFileInfo::exists(dir.absoluteFilePath("namespace1.json")));
+        QVERIFY(cache.saveToFiles(dir.absolutePath(), QStringList { "namespace1/value2" }).isSuccess());
+        QVERIFY(! QFileInfo::exists(dir.absoluteFilePath("namespace1.json")));
+
+        CValueCache cache2(0);
+        QVERIFY(cache2.loadFromFiles(dir.absolutePath()).isSuccess());
+        CVariantMap expected = testData;
+        expected.insert("namespace1/value1", CVariant::from(10));
+        QCOMPARE(cache2.getAllValues(), expected);
+    }
+
+    void CTestValueCache::benchmarkSaveOneValue_data()
+    {
+        QTest::addColumn<int>("depth");
+        QTest::newRow("one file per namespace") << 1;
+        QTest::newRow("one file per value") << 0;
+    }
+
+    void CTestValueCache::benchmarkSaveOneValue()
+    {
+        QFETCH(int, depth);
+        constexpr int count = 500;
+        CAircraftModelList models;
+        for (int i = 0; i < count; i++)
+        {
+            models.push_back(CAircraftModel(QStringLiteral("Model %1").arg(i), CAircraftModel::TypeOwnSimulatorModel, CSimulatorInfo::xplane(),
+                                            QStringLiteral("Name %1").arg(i), QStringLiteral("Description of model %1").arg(i)));
+        }
+        const CVariantMap testData
+        {
+            { "namespace/models", CVariant::from(models) },
+            { "namespace/setting", CVariant::from(0) }
+        };
+
+        QDir dir(QDir::currentPath() + "/testcachebenchmark");
+        if (dir.exists()) { dir.removeRecursively(); }
+        CValueCache cache(depth);
+        cache.insertValues({ testData, QDateTime::currentMSecsSinceEpoch() });
+        QVERIFY(cache.saveToFiles(dir.absolutePath()).isSuccess());
+
+        int setting = 0;
+        QBENCHMARK
+        {
+            cache.insertValues({ CVariantMap { { "namespace/setting", CVariant::from(++setting) } }, QDateTime::currentMSecsSinceEpoch() });
+            QVERIFY(cache.saveToFiles(dir.absolutePath(), QStringList { "namespace/setting" }).isSuccess());
+        }
+
+        CValueCache loaded(depth);
+        QVERIFY(loaded.loadFromFiles(dir.absolutePath()).isSuccess());
+        QCOMPARE(loaded.getAllValues().value("namespace/setting"), CVariant::from(setting));
+        QCOMPARE(loaded.getAllValues().value("namespace/models").to<CAircraftModelList>().size(), count);
+        dir.removeRecursively();
+    }
+
     //! Is value between 0 - 100?
     bool validator(int value, QString &)
     {
@@ -0,0 +1,272 @@
+/* Copyright (C) 2020
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \cond PRIVATE_TESTS
+//! \file
+
+#include "blacksound/dsp/biquadfilter.h"
+#include "blacksound/dsp/samplekernels.h"
+#include "blacksound/sampleprovider/equalizersampleprovider.h"
+#include "blacksound/sampleprovider/mixingsampleprovider.h"
+#include "blacksound/sampleprovider/pinknoisegenerator.h"
+#include "blacksound/sampleprovider/sawtoothgenerator.h"
+#include "blacksound/sampleprovider/simplecompressoreffect.h"
+#include "blacksound/sampleprovider/sinusgenerator.h"
+#include "blacksound/sampleprovider/volumesampleprovider.h"
+#include "test.h"
+
+#include <QElapsedTimer>
+#include <QTest>
+#include <QVector>
+#include <random>
+#include <vector>
+
+using namespace BlackSound::Dsp;
+using namespace BlackSound::SampleProvider;
+
+namespace BlackSoundTest
+{
+    //! Samples per audio callback
+    constexpr int BlockCount = 960;
+
+    //! DSP kernel tests, the vector kernels against the scalar reference
+    class CTestDsp : public QObject
+    {
+        Q_OBJECT
+
+    private slots:
+        //! Restore the default instruction set
+        void cleanup();
+
+        //! Cascade against BiQuadFilter::transform
+        void biQuadCascade();
+
+        //! Gain, mix, peak and clip kernels
+        void sampleKernels();
+
+        //! Receive chain, same samples for all instruction sets
+        void receiveChain();
+
+        //! Receive chain, ns per sample and stream for all instruction sets and number of streams
+        void benchmarkReceiveChain_data();
+
+        //! Receive chain, ns per sample and stream for all instruction sets and number of streams
+        void benchmarkReceiveChain();
+
+    private:
+        //! Receiver with the given number of callsign streams, owned by owner
+        static CVolumeSampleProvider *receiveChain(QObject *owner, int streams);
+
+        //! Filters of the VHF equalizer
+        static std::vector<BiQuadFilter> vhfFilters();
+
+        //! Random samples
+        std::vector<float> randomSamples(int count, float range = 1.0f);
+
+        //! Supported instruction sets
+        static QVector<SimdLevel> simdLevels();
+
+        std::mt19937 m_random { 4711 };
+    };
+
+    void CTestDsp::cleanup()
+    {
+        setSimdLevel(supportedSimdLevel());
+    }
+
+    void CTestDsp::biQuadCascade()
+    {
+        for (SimdLevel level : simdLevels())
+        {
+            QCOMPARE(setSimdLevel(level), level);
+            std::vector<BiQuadFilter> reference = vhfFilters();
+            BiQuadCascade cascade;
+            for (const BiQuadFilter &filter : reference) { QVERIFY(cascade.append(filter)); }
+
+            // odd block sizes, the state is carried over
+            for (int count : { 960, 1, 3, 4800, 17 })
+            {
+                std::vector<float> samples = randomSamples(count);
+                std::vector<float> expected = samples;
+                for (float &sample : expected)
+                {
+                    for (BiQuadFilter &filter : reference) { sample = filter.transform(sample); }
+                }
+                cascade.process(samples.data(), count);
+                QVERIFY2(samples == expected, qPrintable(simdLevelToString(level)));
+            }
+        }
+
+        BiQuadCascade full;
+        for (int f = 0; f < BiQuadCascadeData::MaxFilters; f++) { QVERIFY(full.append(BiQuadFilter())); }
+        QVERIFY2(!full.append(BiQuadFilter()), "Max. number of filters");
+    }
+
+    void CTestDsp::sampleKernels()
+    {
+        const int count = 1003;
+        const std::vector<float> source = randomSamples(count, 2.0f);
+        const std::vector<float> other = randomSamples(count);
+        std::vector<qint16> pcm(count);
+        for (qint16 &sample : pcm) { sample = static_cast<qint16>(m_random()); }
+        pcm[0] = -32768;
+        pcm[1] = 32767;
+        pcm[2] = -5; // a half to be rounded with gain 0.5
+
+        setSimdLevel(SimdScalar);
+        std::vector<float> gainExpected = source;
+        applyGain(gainExpected.data(), count, 0.77f);
+        std::vector<float> mixExpected = source;
+        mixSamples(mixExpected.data(), other.data(), count);
+        const float peakExpected = peakAbs(source.data(), count);
+        std::vector<qint16> clipExpected = pcm;
+        const int clipPeakExpected = applyGainAndClip(clipExpected.data(), count, 1.5);
+        std::vector<qint16> halfExpected = pcm;
+        const int halfPeakExpected = applyGainAndClip(halfExpected.data(), count, 0.5);
+        QCOMPARE(clipPeakExpected, 32768);
+        QCOMPARE(halfExpected[2], static_cast<qint16>(-2));
+
+        for (SimdLevel level : simdLevels())
+        {
+            setSimdLevel(level);
+            std::vector<float> gain = source;
+            applyGain(gain.data(), count, 0.77f);
+            QVERIFY(gain == gainExpected);
+
+            std::vector<float> mix = source;
+            mixSamples(mix.data(), other.data(), count);
+            QVERIFY(mix == mixExpected);
+
+            QCOMPARE(peakAbs(source.data(), count), peakExpected);
+
+            std::vector<qint16> clip = pcm;
+            QCOMPARE(applyGainAndClip(clip.data(), count, 1.5), clipPeakExpected);
+            QVERIFY(clip == clipExpected);
+
+            std::vector<qint16> half = pcm;
+            QCOMPARE(applyGainAndClip(half.data(), count, 0.5), halfPeakExpected);
+            QVERIFY(half == halfExpected);
+        }
+    }
+
+    void CTestDsp::receiveChain()
+    {
+        constexpr int streams = 4;
+        constexpr int blocks = 50;
+        std::vector<float> outputs[3];
+        for (SimdLevel level : simdLevels())
+        {
+            setSimdLevel(level);
+            QObject owner;
+            CVolumeSampleProvider *volume = receiveChain(&owner, streams);
+            std::vector<float> &buffer = outputs[level];
+            buffer.resize(BlockCount);
+            for (int b = 0; b < blocks; b++) { QCOMPARE(volume->readSamples(buffer.data(), BlockCount), BlockCount); }
+        }
+
+        // the noise generators are seeded the same way, so all instruction sets produce the same samples
+        QVERIFY2(peakAbs(outputs[SimdScalar].data(), BlockCount) > 0.0f, "Not silent");
+        for (SimdLevel level : simdLevels())
+        {
+            QVERIFY2(outputs[level] == outputs[SimdScalar], qPrintable(simdLevelToString(level)));
+        }
+    }
+
+    void CTestDsp::benchmarkReceiveChain_data()
+    {
+        QTest::addColumn<int>("level");
+        QTest::addColumn<int>("streams");
+        for (SimdLevel level : simdLevels())
+        {
+            for (int streams = 1; streams <= 4; streams *= 2)
+            {
+                QTest::newRow(QStringLiteral("%1, %2 stream(s), ns per sample and stream").arg(simdLevelToString(level)).arg(streams).toLatin1().constData()) << static_cast<int>(level) << streams;
+            }
+        }
+    }
+
+    void CTestDsp::benchmarkReceiveChain()
+    {
+        QFETCH(int, level);
+        QFETCH(int, streams);
+        QCOMPARE(setSimdLevel(static_cast<SimdLevel>(level)), static_cast<SimdLevel>(level));
+
+        QObject owner;
+        CVolumeSampleProvider *volume = receiveChain(&owner, streams);
+        std::vector<float> buffer(BlockCount);
+        QCOMPARE(volume->readSamples(buffer.data(), BlockCount), BlockCount);
+
+        // the chain scales with the streams, so the time is reported per sample of one stream
+        constexpr int blocks = 500;
+        QElapsedTimer timer;
+        timer.start();
+        for (int b = 0; b < blocks; b++) { volume->readSamples(buffer.data(), BlockCount); }
+        const qint64 ns = timer.nsecsElapsed();
+        QTest::setBenchmarkResult(static_cast<qreal>(ns) / (static_cast<qreal>(blocks) * BlockCount * streams), QTest::WalltimeNanoseconds);
+    }
+
+    CVolumeSampleProvider *CTestDsp::receiveChain(QObject *owner, int streams)
+    {
+        // receiver with the effects chain of a callsign provider per stream, voice replaced by a tone
+        auto receiverMixer = new CMixingSampleProvider(owner);
+        for (int s = 0; s < streams; s++)
+        {
+            auto voice = new CSinusGenerator(300 + 100 * s, owner);
+            voice->setGain(0.5);
+            auto compressor = new CSimpleCompressorEffect(voice, owner);
+            auto equalizer = new CEqualizerSampleProvider(compressor, VHFEmulation, owner);
+            auto acBusNoise = new CSawToothGenerator(400, owner);
+            acBusNoise->setGain(0.003);
+            auto whiteNoise = new CPinkNoiseGenerator(owner);
+            whiteNoise->setGain(0.17);
+            auto callsignMixer = new CMixingSampleProvider(owner);
+            callsignMixer->addMixerInput(equalizer);
+            callsignMixer->addMixerInput(acBusNoise);
+            callsignMixer->addMixerInput(whiteNoise);
+            receiverMixer->addMixerInput(callsignMixer);
+        }
+        auto volume = new CVolumeSampleProvider(receiverMixer, owner);
+        volume->setGainRatio(0.8);
+        return volume;
+    }
+
+    std::vector<BiQuadFilter> CTestDsp::vhfFilters()
+    {
+        // as in CEqualizerSampleProvider
+        return
+        {
+            BiQuadFilter::highPassFilter(44100, 310, 0.25),
+            BiQuadFilter::peakingEQ(44100, 450, 0.75, 17.0),
+            BiQuadFilter::peakingEQ(44100, 1450, 1.0, 25.0),
+            BiQuadFilter::peakingEQ(44100, 2000, 1.0, 25.0),
+            BiQuadFilter::lowPassFilter(44100, 2500, 0.25)
+        };
+    }
+
+    std::vector<float> CTestDsp::randomSamples(int count, float range)
+    {
+        std::uniform_real_distribution<float> distribution(-range, range);
+        std::vector<float> samples(static_cast<size_t>(count));
+        for (float &sample : samples) { sample = distribution(m_random); }
+        return samples;
+    }
+
+    QVector<SimdLevel> CTestDsp::simdLevels()
+    {
+        QVector<SimdLevel> levels;
+        for (int level = SimdScalar; level <= supportedSimdLevel(); level++) { levels.push_back(static_cast<SimdLevel>(level)); }
+        return levels;
+    }
+} // ns
+
+//! main
+BLACKTEST_MAIN(BlackSoundTest::CTestDsp);
+
+#include "testdsp.moc"
+
+//! \endcond
@@ -0,0 +1,28 @@
+load(common_pre)
+
+QT += core dbus testlib multimedia
+
+TARGET = testdsp
+CONFIG   -= app_bundle
+CONFIG   += blackconfig
+CONFIG   += blackmisc
+CONFIG   += blacksound
+CONFIG   += testcase
+CONFIG   += no_testcase_installs
+
+TEMPLATE = app
+
+DEPENDPATH += \
+    . \
+    $$SourceRoot/src \
+    $$SourceRoot/tests \
+
+INCLUDEPATH += \
+    $$SourceRoot/src \
+    $$SourceRoot/tests \
+
+SOURCES += testdsp.cpp
+
+DESTDIR = $$DestRoot/bin
+
+load(common_post)
@@ -0,0 +1,345 @@
+/* Copyright (C) 2020
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \cond PRIVATE_TESTS
+//! \file
+
+#include "blackcore/afv/audio/jitterbuffer.h"
+#include "blackcore/afv/audio/soundcardsampleprovider.h"
+#include "blacksound/codecs/opusencoder.h"
+#include "blacksound/sampleprovider/bufferedwaveprovider.h"
+#include "blacksound/sampleprovider/equalizersampleprovider.h"
+#include "blacksound/sampleprovider/mixingsampleprovider.h"
+#include "blacksound/sampleprovider/pinknoisegenerator.h"
+#include "blacksound/sampleprovider/resourcesoundsampleprovider.h"
+#include "blacksound/sampleprovider/samples.h"
+#include "blacksound/sampleprovider/sawtoothgenerator.h"
+#include "blacksound/sampleprovider/simplecompressoreffect.h"
+#include "blacksound/sampleprovider/sinusgenerator.h"
+#include "blacksound/sampleprovider/volumesampleprovider.h"
+#include "blackmisc/fileutils.h"
+#include "blackmisc/swiftdirectories.h"
+#include "test.h"
+
+#include <QAudioFormat>
+#include <QTest>
+#include <QVector>
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+using namespace BlackMisc;
+using namespace BlackCore::Afv;
+using namespace BlackCore::Afv::Audio;
+using namespace BlackSound::Codecs;
+using namespace BlackSound::SampleProvider;
+
+namespace
+{
+    //! Counting is switched on while reading only
+    std::atomic<bool> g_countAllocations { false };
+    std::atomic<int>  g_allocations { 0 };
+
+    void countAllocation()
+    {
+        if (g_countAllocations.load(std::memory_order_relaxed)) { g_allocations++; }
+    }
+
+    //! Counts all allocations of the current scope
+    class CAllocationCounter
+    {
+    public:
+        CAllocationCounter() { g_allocations = 0; g_countAllocations = true; }
+        ~CAllocationCounter() { g_countAllocations = false; }
+        int count() const { return g_allocations.load(); }
+    };
+}
+
+// counting allocator, operator new for std and QObject allocations
+void *operator new(std::size_t size)
+{
+    countAllocation();
+    void *p = std::malloc(size > 0 ? size : 1);
+    if (!p) { throw std::bad_alloc(); }
+    return p;
+}
+void *operator new[](std::size_t size) { return ::operator new(size); }
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete[](void *p) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void *p, std::size_t) noexcept { std::free(p); }
+
+#if defined(__GLIBC__)
+// Qt containers allocate with malloc, glibc allows to wrap it
+extern "C"
+{
+    void *__libc_malloc(std::size_t size);
+    void *__libc_calloc(std::size_t n, std::size_t size);
+    void *__libc_realloc(void *p, std::size_t size);
+
+    void *malloc(std::size_t size) noexcept { countAllocation(); return __libc_malloc(size); }
+    void *calloc(std::size_t n, std::size_t size) noexcept { countAllocation(); return __libc_calloc(n, size); }
+    void *realloc(void *p, std::size_t size) noexcept { countAllocation(); return __libc_realloc(p, size); }
+}
+#endif
+
+namespace BlackSoundTest
+{
+    //! Sample provider tests
+    class CTestSampleProvider : public QObject
+    {
+        Q_OBJECT
+
+    private slots:
+        //! The receive graph reads without any allocation
+        void readWithoutAllocations();
+
+        //! Queued packets are added between two reads, reading neither adds nor allocates
+        void readWithQueuedPackets();
+
+        //! Mixer inputs
+        void mixerInputs();
+
+        //! Silent inputs are not read
+        void silentInputs();
+
+    private:
+        //! Loaded sound, empty if the file does not exist
+        static CResourceSound loadedSound(const QString &fileName);
+    };
+
+    void CTestSampleProvider::readWithoutAllocations()
+    {
+        QAudioFormat format;
+        format.setSampleRate(48000);
+        format.setChannelCount(1);
+        format.setSampleSize(16);
+        format.setSampleType(QAudioFormat::SignedInt);
+
+        // same structure as a callsign provider below a receiver
+        CBufferedWaveProvider voice(format);
+        voice.addSamples(QVector<float>(48000, 0.25f));
+        CSimpleCompressorEffect compressor(&voice);
+        CEqualizerSampleProvider equalizer(&compressor, VHFEmulation);
+        CSawToothGenerator acBusNoise(400);
+        acBusNoise.setGain(0.003);
+        CPinkNoiseGenerator whiteNoise;
+        whiteNoise.setGain(0.17);
+        CMixingSampleProvider callsignMixer;
+        callsignMixer.addMixerInput(&equalizer);
+        callsignMixer.addMixerInput(&acBusNoise);
+        callsignMixer.addMixerInput(&whiteNoise);
+
+        CSinusGenerator blockTone(180);
+        blockTone.setGain(0.1);
+        const CResourceSound clickSound = loadedSound(CFileUtils::appendFilePaths(CSwiftDirectories::soundFilesDirectory(), Samples::fnClick()));
+        QVERIFY2(!clickSound.audioData().isEmpty(), "Click sample loaded");
+        CResourceSoundSampleProvider click(clickSound);
+        CMixingSampleProvider receiverMixer;
+        receiverMixer.addMixerInput(&callsignMixer);
+        receiverMixer.addMixerInput(&blockTone);
+        CVolumeSampleProvider volume(&receiverMixer);
+        volume.setGainRatio(0.8);
+
+        std::vector<float> buffer(2 * ISampleProvider::BlockSize + 10);
+        QCOMPARE(volume.readSamples(buffer.data(), 960), 960);
+
+        CAllocationCounter counter;
+        for (int callback = 0; callback < 50; callback++)
+        {
+            volume.readSamples(buffer.data(), 960);
+            if (callback == 10)
+            {
+                // click as mixed in by the receiver
+                click.restart();
+                receiverMixer.addMixerInput(&click);
+            }
+        }
+
+        // larger than the scratch buffers
+        volume.readSamples(buffer.data(), static_cast<int>(buffer.size()));
+        QCOMPARE(counter.count(), 0);
+    }
+
+    void CTestSampleProvider::readWithQueuedPackets()
+    {
+        constexpr quint32 frequencyHz = 122800000;
+        constexpr int packets = 10;
+        TransceiverDto transceiver;
+        transceiver.id = 0;
+        transceiver.frequencyHz = frequencyHz;
+        CSoundcardSampleProvider soundcard(48000, { 0 });
+        soundcard.updateRadioTransceivers({ transceiver });
+        CReceivedAudioQueue queue(2 * packets);
+        soundcard.setReceivedAudioQueue(&queue);
+
+        std::vector<float> buffer(960);
+        QCOMPARE(soundcard.readSamples(buffer.data(), 960), 960);
+
+        // packets as received from the network, 20ms of a 440Hz tone each
+        CSinusGenerator tone(440);
+        tone.setGain(0.25);
+        std::vector<float> samples(960);
+        tone.readSamples(samples.data(), 960);
+        QVector<qint16> pcm(960);
+        std::transform(samples.begin(), samples.end(), pcm.begin(), [](float sample) { return static_cast<qint16>(sample * 32767); });
+        COpusEncoder encoder(48000, 1);
+        int encodedLength = 0;
+        const QByteArray opus = encoder.encode(pcm, pcm.size(), &encodedLength);
+        QVERIFY(encodedLength > 0);
+
+        RxTransceiverDto rxTransceiver;
+        rxTransceiver.id = 0;
+        rxTransceiver.frequency = frequencyHz;
+        rxTransceiver.distanceRatio = 1.0f;
+        for (int i = 0; i < packets; i++)
+        {
+            ReceivedAudioDto received;
+            received.audio.callsign = QStringLiteral("DLH123");
+            received.audio.sequenceCounter = static_cast<uint>(i);
+            received.audio.audio = opus;
+            received.audio.lastPacket = false;
+            received.audio.receivedMs = CJitterBuffer::currentTimeMs();
+            received.rxTransceivers = { rxTransceiver };
+            QVERIFY(queue.push(std::move(received)));
+        }
+
+        {
+            // the audio callback leaves the packets queued
+            CAllocationCounter counter;
+            for (int callback = 0; callback < packets; callback++) { soundcard.readSamples(buffer.data(), 960); }
+            QCOMPARE(counter.count(), 0);
+        }
+        QCOMPARE(queue.size(), packets);
+
+        // added between two callbacks, the decoding reads do not allocate either
+        QCOMPARE(soundcard.addReceivedAudio(), packets);
+        QCOMPARE(queue.size(), 0);
+        CAllocationCounter counter;
+        for (int callback = 0; callback < packets; callback++) { soundcard.readSamples(buffer.data(), 960); }
+        QCOMPARE(counter.count(), 0);
+    }
+
+    //! Counts the reads, delivers ones unless silent
+    class CCountingSampleProvider : public ISampleProvider
+    {
+    public:
+        //! \copydoc ISampleProvider::readSamples
+        virtual int readSamples(float *samples, int count) override
+        {
+            m_reads++;
+            std::fill(samples, samples + count, m_silent ? 0.0f : 1.0f);
+            return count;
+        }
+
+        //! \copydoc ISampleProvider::isSilent
+        virtual bool isSilent() const override { return m_silent; }
+
+        bool m_silent = false; //!< silent?
+        int  m_reads  = 0;     //!< number of reads
+    };
+
+    void CTestSampleProvider::silentInputs()
+    {
+        CCountingSampleProvider input1;
+        CCountingSampleProvider input2;
+        input2.m_silent = true;
+        CSinusGenerator tone(180);
+        tone.setGain(0.0);
+        QVERIFY(tone.isSilent());
+
+        CMixingSampleProvider mixer;
+        mixer.addMixerInput(&input1);
+        mixer.addMixerInput(&input2);
+        mixer.addMixerInput(&tone);
+        QVERIFY(!mixer.isSilent());
+
+        std::vector<float> buffer(100, 5.0f);
+        QCOMPARE(mixer.readSamples(buffer.data(), 100), 100);
+        QCOMPARE(input1.m_reads, 1);
+        QCOMPARE(input2.m_reads, 0);
+        QVERIFY(buffer == std::vector<float>(100, 1.0f));
+
+        // all silent, zeros without reading any input
+        input1.m_silent = true;
+        QVERIFY(mixer.isSilent());
+        CVolumeSampleProvider volume(&mixer);
+        QVERIFY(volume.isSilent());
+        QCOMPARE(mixer.readSamples(buffer.data(), 100), 100);
+        QCOMPARE(input1.m_reads, 1);
+        QVERIFY(buffer == std::vector<float>(100, 0.0f));
+
+        // a reset equalizer is the same as a new one
+        QAudioFormat format;
+        format.setSampleRate(48000);
+        format.setChannelCount(1);
+        CBufferedWaveProvider voice(format);
+        QVERIFY(voice.isSilent());
+        CEqualizerSampleProvider equalizer(&voice, VHFEmulation);
+        QVERIFY(equalizer.isSilent());
+        voice.addSamples(QVector<float>(100, 0.5f));
+        QVERIFY(!equalizer.isSilent());
+        std::vector<float> first(100);
+        QCOMPARE(equalizer.readSamples(first.data(), 100), 100);
+        equalizer.reset();
+        voice.addSamples(QVector<float>(100, 0.5f));
+        std::vector<float> second(100);
+        QCOMPARE(equalizer.readSamples(second.data(), 100), 100);
+        QVERIFY(first == second);
+    }
+
+    CResourceSound CTestSampleProvider::loadedSound(const QString &fileName)
+    {
+        CResourceSound sound(fileName);
+        sound.load();
+        return sound;
+    }
+
+    void CTestSampleProvider::mixerInputs()
+    {
+        CSinusGenerator sinus1(100);
+        sinus1.setGain(0.5);
+        CSinusGenerator sinus2(200);
+        sinus2.setGain(0.5);
+        CResourceSoundSampleProvider finished(loadedSound(QStringLiteral("no_such_sound.wav")));
+
+        CMixingSampleProvider mixer;
+        QVERIFY(mixer.addMixerInput(&sinus1));
+        QVERIFY2(mixer.addMixerInput(&sinus1), "Already an input");
+        QVERIFY(mixer.addMixerInput(&finished));
+        QVERIFY(mixer.containsMixerInput(&finished));
+
+        std::vector<float> buffer(100, 1.0f);
+        QCOMPARE(mixer.readSamples(buffer.data(), 100), 100);
+        QVERIFY2(!mixer.containsMixerInput(&finished), "Finished inputs are removed");
+
+        // one input mixed once only, same samples as reading the generator
+        CSinusGenerator reference(100);
+        reference.setGain(0.5);
+        std::vector<float> expected(100);
+        reference.readSamples(expected.data(), 100);
+        mixer.readSamples(buffer.data(), 100);
+        reference.readSamples(expected.data(), 100);
+        QCOMPARE(buffer, expected);
+
+        QVERIFY(mixer.addMixerInput(&sinus2));
+        QVERIFY(mixer.removeMixerInput(&sinus1));
+        QVERIFY(!mixer.removeMixerInput(&sinus1));
+        QVERIFY(mixer.containsMixerInput(&sinus2));
+        QVERIFY(!mixer.containsMixerInput(&sinus1));
+    }
+} // ns
+
+//! main
+BLACKTEST_MAIN(BlackSoundTest::CTestSampleProvider);
+
+#include "testsampleprovider.moc"
+
+//! \endcond
@@ -0,0 +1,29 @@
+load(common_pre)
+
+QT += core dbus testlib multimedia
+
+TARGET = testsampleprovider
+CONFIG   -= app_bundle
+CONFIG   += blackconfig
+CONFIG   += blackmisc
+CONFIG   += blacksound
+CONFIG   += blackcore
+CONFIG   += testcase
+CONFIG   += no_testcase_installs
+
+TEMPLATE = app
+
+DEPENDPATH += \
+    . \
+    $$SourceRoot/src \
+    $$SourceRoot/tests \
+
+INCLUDEPATH += \
+    $$SourceRoot/src \
+    $$SourceRoot/tests \
+
+SOURCES += testsampleprovider.cpp
+
+DESTDIR = $$DestRoot/bin
+
+load(common_post)
@@ -5,6 +5,7 @@ CONFIG += ordered
 
 SUBDIRS += blackmisc
 SUBDIRS += blackcore
+SUBDIRS += blacksound
 SUBDIRS += blackgui
 
 # testblackmisc.file = blackmisc/testblackmisc.pro